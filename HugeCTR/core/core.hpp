@@ -21,6 +21,7 @@
 #include <core/macro.hpp>
 #include <core23/kernel_params.hpp>
 #include <memory>
+#include <string>
 
 namespace core {
 class GPUResourceBase {
@@ -29,6 +30,11 @@ class GPUResourceBase {
   virtual void set_stream(const std::string &name) = 0;
   virtual std::string get_current_stream_name() = 0;
   virtual cudaStream_t get_stream() = 0;  // will return current stream
+
+  // Named prioritized streams for latency-critical or background work; backends
+  // without stream pools fall back to the current stream.
+  virtual cudaStream_t get_high_priority_stream(const std::string &) { return get_stream(); }
+  virtual cudaStream_t get_low_priority_stream(const std::string &) { return get_stream(); }
 };
 
 class CoreResourceManager {
@@ -41,6 +41,14 @@ class GPUResource final : public core::GPUResourceBase {
   }
 
   cudaStream_t get_stream() override { return gpu_resource_->get_stream(); }
+
+  cudaStream_t get_high_priority_stream(const std::string &name) override {
+    return gpu_resource_->get_high_priority_stream(name);
+  }
+
+  cudaStream_t get_low_priority_stream(const std::string &name) override {
+    return gpu_resource_->get_low_priority_stream(name);
+  }
 };
 
 class HCTRCoreResourceManager : public core::CoreResourceManager {
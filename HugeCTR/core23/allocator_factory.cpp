@@ -18,9 +18,12 @@
 #include <core23/details/low_level_cuda_allocator.hpp>
 #include <core23/details/managed_cuda_allocator.hpp>
 #include <core23/details/new_delete_allocator.hpp>
+#include <core23/details/pinned_arena_allocator.hpp>
 #include <core23/details/pinned_host_allocator.hpp>
+#include <core23/details/pool_cuda_allocator.hpp>
 #include <core23/details/simple_cuda_allocator.hpp>
 #include <core23/logger.hpp>
+#include <cstdlib>
 #include <memory>
 
 namespace HugeCTR {
@@ -30,7 +33,11 @@ namespace core23 {
 std::unique_ptr<Allocator> GetDefaultGPUAllocator(const AllocatorParams& allocator_params,
                                                   const Device& device) {
   std::unique_ptr<Allocator> ret;
-  if (allocator_params.pinned) {
+  if (allocator_params.stream_ordered) {
+    HCTR_THROW_IF(allocator_params.compressible, HugeCTR::Error_t::IllegalCall,
+                  "A stream-ordered Allocator cannot be compressible");
+    ret.reset(new PoolCUDAAllocator(device));
+  } else if (allocator_params.pinned) {
     if (allocator_params.compressible) {
       ret.reset(new LowLevelCUDAAllocator(device, true));
     } else {
@@ -45,9 +52,19 @@ std::unique_ptr<Allocator> GetDefaultGPUAllocator(const AllocatorParams& allocat
 std::unique_ptr<Allocator> GetDefaultCPUAllocator(const AllocatorParams& allocator_params,
                                                   const Device& device) {
   std::unique_ptr<Allocator> ret;
+  HCTR_THROW_IF(allocator_params.stream_ordered, HugeCTR::Error_t::IllegalCall,
+                "A stream-ordered Allocator is only available for GPU memory");
+  static const bool use_pinned_arena = []() {
+    const char* env = std::getenv("HCTR_PINNED_HOST_ARENA");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
   if (!allocator_params.compressible) {
     if (allocator_params.pinned) {
-      ret.reset(new PinnedHostAllocator());
+      if (use_pinned_arena && allocator_params.numa_node < 0) {
+        ret.reset(new PinnedArenaAllocator());
+      } else {
+        ret.reset(new PinnedHostAllocator(allocator_params.numa_node));
+      }
     } else {
       ret.reset(new NewDeleteAllocator());
     }
@@ -60,6 +77,8 @@ std::unique_ptr<Allocator> GetDefaultCPUAllocator(const AllocatorParams& allocat
 std::unique_ptr<Allocator> GetDefaultUnifiedAllocator(const AllocatorParams& allocator_params,
                                                       const Device& device) {
   std::unique_ptr<Allocator> ret;
+  HCTR_THROW_IF(allocator_params.stream_ordered, HugeCTR::Error_t::IllegalCall,
+                "A stream-ordered Allocator is only available for GPU memory");
   if (!allocator_params.compressible && allocator_params.pinned) {
     ret.reset(new ManagedCUDAAllocator());
   } else {
@@ -29,7 +29,12 @@ struct AllocatorParams {
       std::function<std::unique_ptr<Allocator>(const AllocatorParams&, const Device& device)>;
   static CustomFactory default_allocator_factory;
   bool pinned = true;
-  bool compressible = false;  // TODO: perhaps replace by a Decorator
+  bool compressible = false;    // TODO: perhaps replace by a Decorator
+  bool stream_ordered = false;  // allocate from the device's default memory pool with
+                                // cudaMallocFromPoolAsync/cudaFreeAsync, so that per-iteration
+                                // temporaries allocate and free without device synchronization
+  int numa_node = -1;           // preferred NUMA node of pinned host memory; -1 keeps the
+                                // calling thread's policy
   CustomFactory custom_factory = default_allocator_factory;
 };
 
@@ -62,6 +62,9 @@ class Buffer : public std::enable_shared_from_this<Buffer> {
   using ClientRequirements = std::map<BufferClient*, BufferRequirements>;
 
   const std::unique_ptr<Allocator>& allocator() const { return allocator_; }
+  const Device& device() const { return device_; }
+  //! Transfer the Allocator out of the Buffer, e.g., into a deferred free closure.
+  std::unique_ptr<Allocator> release_allocator() { return std::move(allocator_); }
   virtual size_t do_get_reserved_size(const std::unique_ptr<Allocator>& allocator,
                                       const ClientRequirements& client_requirements) {
     return 0;
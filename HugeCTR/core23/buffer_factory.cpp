@@ -18,6 +18,7 @@
 #include <core23/buffer_factory.hpp>
 #include <core23/buffer_params.hpp>
 #include <core23/details/confederal_buffer.hpp>
+#include <core23/details/lifetime_buffer.hpp>
 #include <core23/details/unitary_buffer.hpp>
 #include <core23/logger.hpp>
 #include <memory>
@@ -52,7 +53,9 @@ std::shared_ptr<Buffer> GetBuffer(const BufferParams& buffer_params, const Devic
       HCTR_THROW_IF(allocator == nullptr, HugeCTR::Error_t::IllegalCall,
                     "A Buffer must be created but no allocator is specified.");
 
-      if (buffer_params.unitary) {
+      if (buffer_params.lifetime_aware) {
+        buffer = std::make_shared<LifetimeBuffer>(device, std::move(allocator));
+      } else if (buffer_params.unitary) {
         buffer = std::make_shared<UnitaryBuffer>(device, std::move(allocator));
       } else {
         buffer = std::make_shared<ConfederalBuffer>(device, std::move(allocator));
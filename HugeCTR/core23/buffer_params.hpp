@@ -35,6 +35,8 @@ struct BufferParams {
 
   BufferChannel channel = GetRandomBufferChannel();
   bool unitary = true;
+  bool lifetime_aware = false;  // pack clients with non-overlapping [first_use, last_use]
+                                // intervals into the same storage; see LifetimeBuffer
   static CustomFactory custom_factory;
 };
 
@@ -27,6 +27,11 @@ struct BufferRequirements {
   int64_t num_bytes;
   int64_t alignment;
   CUDAStream stream;
+  // Logical [first_use, last_use] interval of the client in execution order. A lifetime-aware
+  // Buffer may alias clients whose intervals do not overlap into the same storage. Negative
+  // values mean the lifetime is unknown, so the client conflicts with every other client.
+  int64_t first_use = -1;
+  int64_t last_use = -1;
 };
 
 }  // namespace core23
@@ -17,6 +17,7 @@
 #include <core23/allocator.hpp>
 #include <core23/buffer_client.hpp>
 #include <core23/details/confederal_buffer.hpp>
+#include <core23/details/deferred_free_queue.hpp>
 #include <core23/device.hpp>
 #include <core23/logger.hpp>
 #include <core23/offsetted_buffer.hpp>
@@ -65,7 +66,15 @@ void ConfederalBuffer::post_unsubscribe(const BufferClient* client,
   auto it = offset_to_ptr_.find(offset);
   HCTR_THROW_IF(it == offset_to_ptr_.end(), HugeCTR::Error_t::IllegalCall,
                 "post_unsubscribe() cannot be called without the memory allocation.");
-  allocator()->deallocate(it->second, requirements.stream);
+  if (DeferredFreeQueue::enabled()) {
+    // The closure keeps the Buffer alive so that its Allocator outlives the deferred free.
+    DeferredFreeQueue::instance().enqueue(
+        device(), requirements.stream,
+        [buffer = shared_from_this(), alloc = allocator().get(), ptr = it->second,
+         stream = requirements.stream]() { alloc->deallocate(ptr, stream); });
+  } else {
+    allocator()->deallocate(it->second, requirements.stream);
+  }
   offset_to_ptr_.erase(it);
 }
 
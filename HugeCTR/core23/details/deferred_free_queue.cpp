@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <core23/details/deferred_free_queue.hpp>
+#include <core23/device_guard.hpp>
+#include <core23/logger.hpp>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+bool DeferredFreeQueue::enabled() {
+  static const bool value = []() {
+    const char* env = std::getenv("HCTR_DEFERRED_FREE");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return value;
+}
+
+DeferredFreeQueue& DeferredFreeQueue::instance() {
+  static DeferredFreeQueue queue;
+  return queue;
+}
+
+DeferredFreeQueue::DeferredFreeQueue()
+    : terminate_(false), reclaim_thread_(&DeferredFreeQueue::reclaim_loop, this) {}
+
+DeferredFreeQueue::~DeferredFreeQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    terminate_ = true;
+  }
+  cond_.notify_all();
+  reclaim_thread_.join();
+
+  // Drain whatever is left. At process exit the CUDA runtime may already be unloading, so the
+  // event results are ignored and a failing free must not escape the destructor.
+  for (auto& pending : pending_frees_) {
+    if (pending.event != nullptr) {
+      cudaEventSynchronize(pending.event);
+      cudaEventDestroy(pending.event);
+    }
+    try {
+      pending.free_fn();
+    } catch (...) {
+    }
+  }
+  pending_frees_.clear();
+}
+
+void DeferredFreeQueue::enqueue(const Device& device, CUDAStream stream,
+                                std::function<void()> free_fn) {
+  cudaEvent_t event = nullptr;
+  if (device.type() != DeviceType::CPU) {
+    DeviceGuard device_guard(device);
+    if (cudaEventCreateWithFlags(&event, cudaEventDisableTiming) == cudaSuccess) {
+      if (cudaEventRecord(event, stream()) != cudaSuccess) {
+        cudaGetLastError();  // clear the error state
+        cudaEventDestroy(event);
+        event = nullptr;
+      }
+    } else {
+      cudaGetLastError();
+      event = nullptr;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_frees_.push_back({event, std::move(free_fn)});
+  }
+  cond_.notify_all();
+}
+
+void DeferredFreeQueue::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!pending_frees_.empty()) {
+    cond_.notify_all();
+    lock.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    lock.lock();
+  }
+}
+
+size_t DeferredFreeQueue::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_frees_.size();
+}
+
+void DeferredFreeQueue::reclaim_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!terminate_) {
+    if (pending_frees_.empty()) {
+      cond_.wait(lock, [this]() { return terminate_ || !pending_frees_.empty(); });
+      continue;
+    }
+
+    std::vector<PendingFree> ready;
+    for (auto it = pending_frees_.begin(); it != pending_frees_.end();) {
+      // Every error other than cudaErrorNotReady means the event can never complete, so the
+      // free is executed rather than leaked.
+      if (it->event == nullptr || cudaEventQuery(it->event) != cudaErrorNotReady) {
+        ready.push_back(std::move(*it));
+        it = pending_frees_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    lock.unlock();
+    for (auto& pending : ready) {
+      if (pending.event != nullptr) {
+        cudaEventDestroy(pending.event);
+      }
+      try {
+        pending.free_fn();
+      } catch (const std::exception& e) {
+        HCTR_LOG_S(ERROR, ROOT) << "A deferred free failed: " << e.what() << std::endl;
+      }
+    }
+    if (ready.empty()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace core23
+
+}  // namespace HugeCTR
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <condition_variable>
+#include <core23/cuda_stream.hpp>
+#include <core23/device.hpp>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+/**
+ * Process-wide queue which defers Buffer frees off the destruction path. Instead of calling
+ * the Allocator synchronously (a cudaFree on the default GPU path, which synchronizes the
+ * whole device), a free is enqueued behind a CUDA event recorded on the Buffer's stream and
+ * executed by a background thread once the event has completed, so tensor teardown never
+ * stalls an active stream. The closure owns whatever must outlive the Buffer (typically its
+ * Allocator). The queue is opt-in via HCTR_DEFERRED_FREE=1; when it is off, the Buffers free
+ * synchronously as before.
+ */
+class DeferredFreeQueue final {
+ public:
+  static bool enabled();
+  static DeferredFreeQueue& instance();
+
+  DeferredFreeQueue(const DeferredFreeQueue&) = delete;
+  DeferredFreeQueue& operator=(const DeferredFreeQueue&) = delete;
+
+  void enqueue(const Device& device, CUDAStream stream, std::function<void()> free_fn);
+
+  //! Block until every enqueued free has been executed.
+  void flush();
+
+  size_t pending() const;
+
+ private:
+  struct PendingFree {
+    cudaEvent_t event;  // nullptr means the free is immediately executable
+    std::function<void()> free_fn;
+  };
+
+  DeferredFreeQueue();
+  ~DeferredFreeQueue();
+
+  void reclaim_loop();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<PendingFree> pending_frees_;
+  bool terminate_;
+  std::thread reclaim_thread_;
+};
+
+}  // namespace core23
+
+}  // namespace HugeCTR
@@ -50,6 +50,24 @@ struct TransformParams {
   Op op;
 };
 
+template <typename DstType, typename SrcType>
+struct ConvertPadTransposeParams {
+  ConvertPadTransposeParams(DstType* dst, const SrcType* src, int64_t num_rows, int64_t num_cols,
+                            int64_t dst_leading_dim, bool transpose)
+      : dst(dst),
+        src(src),
+        num_rows(num_rows),
+        num_cols(num_cols),
+        dst_leading_dim(dst_leading_dim),
+        transpose(transpose) {}
+  DstType* dst;
+  const SrcType* src;
+  int64_t num_rows;
+  int64_t num_cols;
+  int64_t dst_leading_dim;
+  bool transpose;
+};
+
 template <typename Type>
 void fill_wrapper(void* user_data) {
   FillParams<Type>* params = static_cast<FillParams<Type>*>(user_data);
@@ -59,6 +77,24 @@ void fill_wrapper(void* user_data) {
 
 void copy_wrapper(void* user_data);
 
+template <typename DstType, typename SrcType>
+void convert_pad_transpose_wrapper(void* user_data) {
+  auto* params = static_cast<ConvertPadTransposeParams<DstType, SrcType>*>(user_data);
+  const auto zero = TypeConverter<DstType, float>::value(0.f);
+  for (int64_t row = 0; row < (params->transpose ? params->num_cols : params->num_rows); row++) {
+    for (int64_t col = 0; col < params->dst_leading_dim; col++) {
+      const int64_t src_row = params->transpose ? col : row;
+      const int64_t src_col = params->transpose ? row : col;
+      params->dst[row * params->dst_leading_dim + col] =
+          (src_row < params->num_rows && src_col < params->num_cols)
+              ? TypeConverter<DstType, SrcType>::value(
+                    params->src[src_row * params->num_cols + src_col])
+              : zero;
+    }
+  }
+  delete params;
+}
+
 template <typename DstType, typename SrcType, typename Op>
 void transform_wrapper(void* user_data) {
   TransformParams<DstType, SrcType, Op>* params =
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <core23/allocator.hpp>
+#include <core23/buffer_client.hpp>
+#include <core23/details/deferred_free_queue.hpp>
+#include <core23/details/lifetime_buffer.hpp>
+#include <core23/device.hpp>
+#include <core23/logger.hpp>
+#include <core23/offsetted_buffer.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+namespace {
+
+struct Placement {
+  BufferClient* client;
+  int64_t num_bytes;
+  int64_t alignment;
+  int64_t first_use;
+  int64_t last_use;
+  int64_t offset;
+};
+
+inline int64_t align_offset(int64_t offset, int64_t alignment) {
+  if (alignment != 0) {
+    int64_t rem = offset % alignment;
+    if (rem != 0) {
+      offset += alignment - rem;
+    }
+  }
+  return offset;
+}
+
+inline bool lifetimes_overlap(const Placement& lhs, const Placement& rhs) {
+  // An unknown lifetime conflicts with everything.
+  if (lhs.first_use < 0 || lhs.last_use < 0 || rhs.first_use < 0 || rhs.last_use < 0) {
+    return true;
+  }
+  return lhs.first_use <= rhs.last_use && rhs.first_use <= lhs.last_use;
+}
+
+}  // namespace
+
+LifetimeBuffer::LifetimeBuffer(const Device& device, std::unique_ptr<Allocator> allocator)
+    : Buffer(device, std::move(allocator)),
+      allocated_(false),
+      ptr_(nullptr),
+      current_offset_(0LL) {}
+
+LifetimeBuffer::~LifetimeBuffer() {
+  if (allocated_ || ptr_ != nullptr) {
+    if (DeferredFreeQueue::enabled()) {
+      DeferredFreeQueue::instance().enqueue(
+          device(), stream_,
+          [allocator = std::shared_ptr<Allocator>(release_allocator()), ptr = ptr_]() {
+            allocator->deallocate(ptr);
+          });
+    } else {
+      allocator()->deallocate(ptr_);
+    }
+  }
+}
+
+int64_t LifetimeBuffer::compute_placements(const std::unique_ptr<Allocator>& allocator,
+                                           const ClientRequirements& client_requirements,
+                                           ClientOffsets& client_offsets) const {
+  std::vector<Placement> placements;
+  placements.reserve(client_requirements.size());
+
+  std::queue<BufferClient*> tmp_order = new_insertion_order_;
+  bool is_first = true;
+  while (!tmp_order.empty()) {
+    auto client = tmp_order.front();
+    auto search = client_requirements.find(client);
+    if (search != client_requirements.end()) {
+      const auto& requirements = search->second;
+      int64_t alignment = requirements.alignment;
+      if (is_first) {
+        alignment = allocator->get_valid_alignment(alignment);
+        is_first = false;
+      }
+      placements.push_back({client, requirements.num_bytes, alignment, requirements.first_use,
+                            requirements.last_use, 0});
+    }
+    tmp_order.pop();
+  }
+
+  // Greedy best-fit coloring: place the largest clients first, and give each client the lowest
+  // aligned offset whose byte range does not collide with an already placed, lifetime-overlapping
+  // client. Insertion order breaks ties so that the result is deterministic.
+  std::vector<size_t> order(placements.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&placements](size_t lhs, size_t rhs) {
+    return placements[lhs].num_bytes > placements[rhs].num_bytes;
+  });
+
+  int64_t total_size = 0;
+  std::vector<size_t> placed;
+  placed.reserve(order.size());
+  for (size_t index : order) {
+    Placement& placement = placements[index];
+    int64_t offset = 0;
+    for (bool retry = true; retry;) {
+      retry = false;
+      offset = align_offset(offset, placement.alignment);
+      for (size_t other_index : placed) {
+        const Placement& other = placements[other_index];
+        if (lifetimes_overlap(placement, other) && offset < other.offset + other.num_bytes &&
+            other.offset < offset + placement.num_bytes) {
+          offset = other.offset + other.num_bytes;
+          retry = true;
+          break;
+        }
+      }
+    }
+    placement.offset = offset;
+    placed.push_back(index);
+    total_size = std::max(total_size, offset + placement.num_bytes);
+  }
+
+  for (const Placement& placement : placements) {
+    client_offsets[placement.client] = placement.offset;
+  }
+  return total_size;
+}
+
+size_t LifetimeBuffer::do_get_reserved_size(const std::unique_ptr<Allocator>& allocator,
+                                            const ClientRequirements& client_requirements) {
+  if (client_requirements.empty()) {
+    return 0;
+  }
+  ClientOffsets client_offsets;
+  return compute_placements(allocator, client_requirements, client_offsets);
+}
+
+Buffer::ClientOffsets LifetimeBuffer::do_allocate(const std::unique_ptr<Allocator>& allocator,
+                                                  const ClientRequirements& client_requirements) {
+  if (client_requirements.empty()) {
+    HCTR_OWN_THROW(
+        HugeCTR::Error_t::IllegalCall,
+        "The buffer doesn't have any subscriber at all. What is the point of allocate()?");
+  }
+
+  if (allocated_) {
+    HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall,
+                   "The LifetimeBuffer doesn't allow the multiple allocation.");
+  }
+
+  const auto& first_stream = client_requirements.begin()->second.stream;
+  for (const auto& [client, requirements] : client_requirements) {
+    if (requirements.stream != first_stream) {
+      HCTR_LOG_S(WARNING, ROOT)
+          << "A BufferClient doesn't have the same CUDAStream with the first BufferClient."
+          << std::endl;
+      break;
+    }
+  }
+
+  ClientOffsets client_offsets;
+  int64_t total_size = compute_placements(allocator, client_requirements, client_offsets);
+  while (!new_insertion_order_.empty()) {
+    new_insertion_order_.pop();
+  }
+
+  stream_ = first_stream;
+  ptr_ = allocator->allocate(total_size, first_stream);
+  if (ptr_ == nullptr && total_size) {
+    HCTR_OWN_THROW(HugeCTR::Error_t::OutOfMemory,
+                   "The LifetimeBuffer failed to allocate the memory");
+  }
+  allocated_ = true;
+  current_offset_ = total_size;
+
+  return client_offsets;
+}
+
+void LifetimeBuffer::post_subscribe(const BufferClient* client, BufferRequirements requirements) {
+  new_insertion_order_.push(const_cast<BufferClient*>(client));
+}
+
+}  // namespace core23
+
+}  // namespace HugeCTR
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <core23/details/pinned_arena_allocator.hpp>
+#include <core23/logger.hpp>
+#include <cstddef>
+#include <cstdlib>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+namespace {
+
+constexpr int64_t kArenaAlignment = 256;
+constexpr int64_t kGiB = 1024LL * 1024LL * 1024LL;
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+int64_t arena_growth_bytes() {
+  static const int64_t bytes = []() {
+    int64_t gigabytes = 1;
+    if (const char* env = std::getenv("HCTR_PINNED_ARENA_GB")) {
+      gigabytes = std::max<int64_t>(1, std::atoll(env));
+    }
+    return gigabytes * kGiB;
+  }();
+  return bytes;
+}
+
+void* map_arena(int64_t num_bytes) {
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  void* base = MAP_FAILED;
+  if (num_bytes % kGiB == 0) {
+    base = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                flags | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT), -1, 0);
+  }
+  if (base == MAP_FAILED) {
+    base = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                flags | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+  }
+  if (base == MAP_FAILED) {
+    // No pre-reserved huge pages; fall back to transparent huge pages.
+    base = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+      madvise(base, num_bytes, MADV_HUGEPAGE);
+#endif
+    }
+  }
+  return base == MAP_FAILED ? nullptr : base;
+}
+
+}  // namespace
+
+std::mutex PinnedArenaAllocator::mutex_;
+std::vector<PinnedArenaAllocator::Arena> PinnedArenaAllocator::arenas_;
+std::unordered_set<void*> PinnedArenaAllocator::fallback_ptrs_;
+
+bool PinnedArenaAllocator::grow(int64_t min_bytes) {
+  int64_t num_bytes = std::max(arena_growth_bytes(), min_bytes);
+  num_bytes = (num_bytes + kGiB - 1) / kGiB * kGiB;
+
+  void* base = map_arena(num_bytes);
+  if (base == nullptr) {
+    return false;
+  }
+  if (cudaHostRegister(base, num_bytes, cudaHostRegisterDefault) != cudaSuccess) {
+    cudaGetLastError();  // clear the error state
+    munmap(base, num_bytes);
+    return false;
+  }
+
+  Arena arena;
+  arena.base = static_cast<char*>(base);
+  arena.size = num_bytes;
+  arena.free_blocks[0] = num_bytes;
+  arenas_.push_back(std::move(arena));
+  HCTR_LOG_S(INFO, ROOT) << "Reserved a " << num_bytes / kGiB
+                         << " GiB pinned host arena (total arenas: " << arenas_.size() << ")"
+                         << std::endl;
+  return true;
+}
+
+void* PinnedArenaAllocator::sub_allocate(Arena& arena, int64_t size) {
+  for (auto it = arena.free_blocks.begin(); it != arena.free_blocks.end(); ++it) {
+    const auto [offset, num_bytes] = *it;
+    if (num_bytes >= size) {
+      arena.free_blocks.erase(it);
+      if (num_bytes > size) {
+        arena.free_blocks[offset + size] = num_bytes - size;
+      }
+      arena.used_blocks[offset] = size;
+      return arena.base + offset;
+    }
+  }
+  return nullptr;
+}
+
+void* PinnedArenaAllocator::allocate(int64_t size, CUDAStream) {
+  size = (size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Arena& arena : arenas_) {
+    if (void* ptr = sub_allocate(arena, size)) {
+      return ptr;
+    }
+  }
+  if (grow(size)) {
+    return sub_allocate(arenas_.back(), size);
+  }
+
+  HCTR_LOG_S(WARNING, ROOT) << "Failed to reserve a pinned host arena; falling back to "
+                               "cudaHostAlloc for this allocation"
+                            << std::endl;
+  void* ptr;
+  HCTR_LIB_THROW(cudaHostAlloc(&ptr, size, cudaHostAllocDefault));
+  fallback_ptrs_.insert(ptr);
+  return ptr;
+}
+
+void PinnedArenaAllocator::deallocate(void* ptr, CUDAStream) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fallback_ptrs_.erase(ptr)) {
+    HCTR_LIB_THROW(cudaFreeHost(ptr));
+    return;
+  }
+  for (Arena& arena : arenas_) {
+    if (ptr < arena.base || ptr >= arena.base + arena.size) {
+      continue;
+    }
+    const int64_t offset = static_cast<char*>(ptr) - arena.base;
+    auto it = arena.used_blocks.find(offset);
+    HCTR_THROW_IF(it == arena.used_blocks.end(), HugeCTR::Error_t::IllegalCall,
+                  "The pointer is not a live arena sub-allocation");
+    int64_t num_bytes = it->second;
+    arena.used_blocks.erase(it);
+
+    // Coalesce with the neighboring free blocks.
+    int64_t free_offset = offset;
+    auto next = arena.free_blocks.lower_bound(offset);
+    if (next != arena.free_blocks.end() && offset + num_bytes == next->first) {
+      num_bytes += next->second;
+      next = arena.free_blocks.erase(next);
+    }
+    if (next != arena.free_blocks.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset) {
+        free_offset = prev->first;
+        num_bytes += prev->second;
+        arena.free_blocks.erase(prev);
+      }
+    }
+    arena.free_blocks[free_offset] = num_bytes;
+    return;
+  }
+  HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall,
+                 "The pointer does not belong to any pinned host arena");
+}
+
+int64_t PinnedArenaAllocator::default_alignment() const { return kArenaAlignment; }
+
+}  // namespace core23
+
+}  // namespace HugeCTR
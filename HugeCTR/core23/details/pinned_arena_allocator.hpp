@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <core23/allocator.hpp>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+/**
+ * Pinned-host arena allocator. Instead of one cudaHostAlloc per buffer, a few large huge-page
+ * backed regions (1 GiB pages when available, 2 MiB or transparent huge pages otherwise) are
+ * mapped and registered once per process, and all requests are first-fit sub-allocated from
+ * them. This makes repeated data-reader construction near-instant, since the expensive mapping
+ * and registration survive the reader, and the huge pages cut TLB misses on the H2D staging
+ * copies. The arenas are process-wide and deliberately never unregistered. The growth step is
+ * HCTR_PINNED_ARENA_GB GiB (default 1) per new arena; requests that exceed it get an arena of
+ * their own size. If huge-page mapping or registration fails, the allocator falls back to plain
+ * cudaHostAlloc for that request.
+ */
+class PinnedArenaAllocator : public Allocator {
+ public:
+  PinnedArenaAllocator() = default;
+  ~PinnedArenaAllocator() override {}
+
+  void* allocate(int64_t size, CUDAStream) override;
+
+  void deallocate(void* ptr, CUDAStream) override;
+
+  int64_t default_alignment() const override;
+
+ private:
+  struct Arena {
+    char* base;
+    int64_t size;
+    std::map<int64_t, int64_t> free_blocks;  // offset -> num_bytes, coalesced
+    std::map<int64_t, int64_t> used_blocks;  // offset -> num_bytes
+  };
+
+  // All instances share the arenas so that the registered memory outlives any single client.
+  static std::mutex mutex_;
+  static std::vector<Arena> arenas_;
+  static std::unordered_set<void*> fallback_ptrs_;  // served by cudaHostAlloc directly
+
+  static bool grow(int64_t min_bytes);
+  static void* sub_allocate(Arena& arena, int64_t size);
+};
+
+}  // namespace core23
+
+}  // namespace HugeCTR
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <numa.h>
+
 #include <core23/details/pinned_host_allocator.hpp>
 #include <core23/logger.hpp>
 #include <cstddef>
@@ -24,11 +26,35 @@ namespace core23 {
 
 void* PinnedHostAllocator::allocate(int64_t size, CUDAStream) {
   void* ptr;
-  HCTR_LIB_THROW(cudaHostAlloc(&ptr, size, cudaHostAllocDefault));
+  if (numa_node_ >= 0) {
+    ptr = numa_alloc_onnode(size, numa_node_);
+    HCTR_THROW_IF(ptr == nullptr, HugeCTR::Error_t::OutOfMemory, "numa_alloc_onnode failed");
+    HCTR_LIB_THROW(cudaHostRegister(ptr, size, cudaHostRegisterDefault));
+    std::lock_guard<std::mutex> lock(mutex_);
+    numa_sizes_[ptr] = size;
+  } else {
+    HCTR_LIB_THROW(cudaHostAlloc(&ptr, size, cudaHostAllocDefault));
+  }
   return ptr;
 }
 
-void PinnedHostAllocator::deallocate(void* ptr, CUDAStream) { HCTR_LIB_THROW(cudaFreeHost(ptr)); }
+void PinnedHostAllocator::deallocate(void* ptr, CUDAStream) {
+  int64_t numa_size = 0;
+  if (numa_node_ >= 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = numa_sizes_.find(ptr);
+    if (it != numa_sizes_.end()) {
+      numa_size = it->second;
+      numa_sizes_.erase(it);
+    }
+  }
+  if (numa_size > 0) {
+    HCTR_LIB_THROW(cudaHostUnregister(ptr));
+    numa_free(ptr, numa_size);
+  } else {
+    HCTR_LIB_THROW(cudaFreeHost(ptr));
+  }
+}
 
 int64_t PinnedHostAllocator::default_alignment() const { return alignof(std::max_align_t); }
 
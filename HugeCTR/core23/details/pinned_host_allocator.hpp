@@ -17,6 +17,8 @@
 #pragma once
 
 #include <core23/allocator.hpp>
+#include <mutex>
+#include <unordered_map>
 
 namespace HugeCTR {
 
@@ -24,6 +26,8 @@ namespace core23 {
 
 class PinnedHostAllocator : public Allocator {
  public:
+  PinnedHostAllocator(int numa_node = -1) : numa_node_(numa_node) {}
+
   ~PinnedHostAllocator() override {}
 
   void* allocate(int64_t size, CUDAStream) override;
@@ -31,6 +35,14 @@ class PinnedHostAllocator : public Allocator {
   void deallocate(void* ptr, CUDAStream) override;
 
   int64_t default_alignment() const override;
+
+ private:
+  // With a non-negative node, memory is placed on that NUMA node with numa_alloc_onnode
+  // and pinned via cudaHostRegister; otherwise cudaHostAlloc follows the calling
+  // thread's memory policy.
+  int numa_node_;
+  std::mutex mutex_;
+  std::unordered_map<void*, int64_t> numa_sizes_;  // numa_free needs the allocation size
 };
 
 }  // namespace core23
@@ -16,6 +16,7 @@
 
 #include <core23/allocator.hpp>
 #include <core23/buffer_client.hpp>
+#include <core23/details/deferred_free_queue.hpp>
 #include <core23/details/unitary_buffer.hpp>
 #include <core23/device.hpp>
 #include <core23/logger.hpp>
@@ -33,7 +34,17 @@ UnitaryBuffer::UnitaryBuffer(const Device& device, std::unique_ptr<Allocator> al
       current_offset_(0LL) {}
 
 UnitaryBuffer::~UnitaryBuffer() {
-  if (allocated_ || ptr_ != nullptr) allocator()->deallocate(ptr_);
+  if (allocated_ || ptr_ != nullptr) {
+    if (DeferredFreeQueue::enabled()) {
+      DeferredFreeQueue::instance().enqueue(
+          device(), stream_,
+          [allocator = std::shared_ptr<Allocator>(release_allocator()), ptr = ptr_]() {
+            allocator->deallocate(ptr);
+          });
+    } else {
+      allocator()->deallocate(ptr_);
+    }
+  }
 }
 
 size_t UnitaryBuffer::do_get_reserved_size(const std::unique_ptr<Allocator>& allocator,
@@ -105,6 +116,7 @@ Buffer::ClientOffsets UnitaryBuffer::do_allocate(const std::unique_ptr<Allocator
     }
     new_insertion_order_.pop();
   }
+  stream_ = first_stream;
   ptr_ = allocator->allocate(current_offset, first_stream);
   if (ptr_ == nullptr && current_offset) {
     HCTR_OWN_THROW(HugeCTR::Error_t::OutOfMemory,
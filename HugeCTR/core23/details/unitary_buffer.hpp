@@ -55,6 +55,7 @@ class UnitaryBuffer final : public Buffer {
   bool allocated_;
   void* ptr_;
   int64_t current_offset_;
+  CUDAStream stream_;
   std::queue<BufferClient*> new_insertion_order_;
 };
 
@@ -19,8 +19,10 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <core23/logger.hpp>
+#include <cstdint>
 #ifdef ENABLE_MPI
 #include <core23/mpi_init_service.hpp>
 #endif
@@ -34,7 +36,85 @@
 
 namespace HugeCTR {
 
+/**
+ * One deposited log message. Timestamp and thread name are captured on the producing thread;
+ * prefix rendering and all file I/O happen on whichever thread eventually sinks the record.
+ */
+struct AsyncLogRecord {
+  struct timeval time;
+  int level;
+  bool with_prefix;
+  uint16_t length;
+  char thread_name[32];
+  char message[448];
+};
+
+/**
+ * Bounded single-producer/single-consumer ring. The owning thread is the only producer, the
+ * background writer the only consumer, so a pair of acquire/release counters suffices — no locks
+ * and no CAS loops on the logging fast path.
+ */
+class AsyncLogRing {
+ public:
+  static constexpr size_t NUM_SLOTS = 1024;  // power of two
+
+  bool try_push(const int level, const bool with_prefix, const struct timeval& time,
+                const char* const thread_name, const char* const message, const size_t length) {
+    if (length >= sizeof(AsyncLogRecord::message)) {
+      return false;
+    }
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= NUM_SLOTS) {
+      return false;
+    }
+    AsyncLogRecord& record = slots_[head % NUM_SLOTS];
+    record.time = time;
+    record.level = level;
+    record.with_prefix = with_prefix;
+    record.length = static_cast<uint16_t>(length);
+    std::snprintf(record.thread_name, sizeof(record.thread_name), "%s", thread_name);
+    std::memcpy(record.message, message, length);
+    record.message[length] = '\0';
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(AsyncLogRecord& record) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    record = slots_[tail % NUM_SLOTS];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::array<AsyncLogRecord, NUM_SLOTS> slots_;
+};
+
+/**
+ * Fixed header of one record in the 'HUGECTR_LOG_BINARY' output; the thread name and message
+ * bytes follow immediately after it.
+ */
+struct BinaryLogRecordHeader {
+  int64_t tv_sec;
+  int32_t tv_usec;
+  int32_t level;
+  uint16_t thread_name_length;
+  uint16_t message_length;
+};
+
 Logger::~Logger() {
+  if (async_writer_.joinable()) {
+    async_stop_.store(true, std::memory_order_release);
+    async_writer_.join();
+  }
+  if (binary_log_) {
+    fclose(binary_log_);
+  }
   // if stdout and stderr are in use, we don't do fclose to prevent the situations where
   //   (1) the fds are taken in opening other files or
   //   (2) writing to the closed fds occurs, which is UB.
@@ -59,31 +139,164 @@ void Logger::print(const std::exception& e, const size_t depth) {
 }
 
 void Logger::printf(const int level, bool with_prefix, const char* format, ...) {
-  char prefix[MAX_PREFIX_LENGTH];
-  write_log_prefix(with_prefix, prefix, level);
+  // Render the message body once, up front. A va_list cannot be stored for off-thread replay, so
+  // in async mode this is the only formatting work left on the calling thread; prefix rendering
+  // and all I/O happen elsewhere.
+  char stack_buffer[sizeof(AsyncLogRecord::message)];
+  std::vector<char> heap_buffer;
+  char* message = stack_buffer;
 
-  if (log_to_std_) {
-    std::va_list args;
+  std::va_list args;
+  va_start(args, format);
+  int length = std::vsnprintf(stack_buffer, sizeof(stack_buffer), format, args);
+  va_end(args);
+  if (length < 0) {
+    return;
+  }
+  if (static_cast<size_t>(length) >= sizeof(stack_buffer)) {
+    heap_buffer.resize(length + 1);
+    message = heap_buffer.data();
     va_start(args, format);
+    length = std::vsnprintf(message, heap_buffer.size(), format, args);
+    va_end(args);
+    if (length < 0) {
+      return;
+    }
+  }
+
+  emit(level, with_prefix, message, length);
+}
+
+void Logger::emit(const int level, const bool with_prefix, const char* const message,
+                  const size_t length) {
+  // ERROR stays synchronous even in async mode: the caller may abort right after, and the
+  // message must reach the sink first.
+  if (async_ && level != LOG_ERROR_LEVEL) {
+    struct timeval now;
+    gettimeofday(&now, nullptr);
 
+    // Assign thread name if not already set.
+    if (!has_thread_name()) {
+      std::ostringstream os;
+      os << "tid #" << std::this_thread::get_id();
+      set_thread_name(os.str());
+    }
+
+    if (thread_ring()->try_push(level, with_prefix, now, get_thread_name(), message, length)) {
+      return;
+    }
+    // Ring full or message oversized; fall through to the synchronous path.
+  }
+
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+
+  char prefix[MAX_PREFIX_LENGTH];
+  write_log_prefix(with_prefix, prefix, level, now,
+                   has_thread_name() ? get_thread_name() : nullptr);
+
+  if (log_to_std_) {
     FILE* const file = log_std_.at(level);
     std::fputs(prefix, file);
-    std::vfprintf(file, format, args);
+    std::fwrite(message, 1, length, file);
     std::fflush(file);
-
-    va_end(args);
   }
 
   if (log_to_file_) {
-    std::va_list args;
-    va_start(args, format);
-
     FILE* const file = log_file_.at(level);
     std::fputs(prefix, file);
-    std::vfprintf(file, format, args);
+    std::fwrite(message, 1, length, file);
     std::fflush(file);
+  }
 
-    va_end(args);
+  if (binary_log_) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    const char* const thread_name = get_thread_name();
+    BinaryLogRecordHeader header;
+    header.tv_sec = now.tv_sec;
+    header.tv_usec = now.tv_usec;
+    header.level = level;
+    header.thread_name_length = static_cast<uint16_t>(std::strlen(thread_name));
+    header.message_length = static_cast<uint16_t>(std::min(length, size_t{UINT16_MAX}));
+    std::fwrite(&header, sizeof(header), 1, binary_log_);
+    std::fwrite(thread_name, 1, header.thread_name_length, binary_log_);
+    std::fwrite(message, 1, header.message_length, binary_log_);
+  }
+}
+
+void Logger::write_record(const AsyncLogRecord& record) {
+  char prefix[MAX_PREFIX_LENGTH];
+  write_log_prefix(record.with_prefix, prefix, record.level, record.time, record.thread_name);
+
+  if (log_to_std_) {
+    FILE* const file = log_std_.at(record.level);
+    std::fputs(prefix, file);
+    std::fwrite(record.message, 1, record.length, file);
+  }
+
+  if (log_to_file_) {
+    FILE* const file = log_file_.at(record.level);
+    std::fputs(prefix, file);
+    std::fwrite(record.message, 1, record.length, file);
+  }
+
+  if (binary_log_) {
+    BinaryLogRecordHeader header;
+    header.tv_sec = record.time.tv_sec;
+    header.tv_usec = record.time.tv_usec;
+    header.level = record.level;
+    header.thread_name_length = static_cast<uint16_t>(std::strlen(record.thread_name));
+    header.message_length = record.length;
+    std::fwrite(&header, sizeof(header), 1, binary_log_);
+    std::fwrite(record.thread_name, 1, header.thread_name_length, binary_log_);
+    std::fwrite(record.message, 1, record.length, binary_log_);
+  }
+}
+
+AsyncLogRing* Logger::thread_ring() {
+  static thread_local std::shared_ptr<AsyncLogRing> ring = [this] {
+    auto new_ring = std::make_shared<AsyncLogRing>();
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    async_rings_.push_back(new_ring);
+    return new_ring;
+  }();
+  return ring.get();
+}
+
+void Logger::async_writer_loop() {
+  set_thread_name("logger");
+
+  AsyncLogRecord record;
+  for (;;) {
+    bool drained_any = false;
+    {
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      for (const std::shared_ptr<AsyncLogRing>& ring : async_rings_) {
+        while (ring->try_pop(record)) {
+          write_record(record);
+          drained_any = true;
+        }
+      }
+    }
+    if (drained_any) {
+      // Flush once per sweep instead of once per record.
+      if (log_to_std_) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+      }
+      if (log_to_file_) {
+        for (const auto& [level, file] : log_file_) {
+          if (file) {
+            std::fflush(file);
+          }
+        }
+      }
+    } else {
+      if (async_stop_.load(std::memory_order_acquire)) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
   }
 }
 
@@ -145,10 +358,27 @@ Logger::Logger() : rank_{0} {
       log_std_[level] = stdout;
     }
   }
+
+  const char* const binary_log_str = std::getenv("HUGECTR_LOG_BINARY");
+  if (binary_log_str != nullptr && binary_log_str[0] != '\0') {
+    binary_log_ = std::fopen(binary_log_str, "wb");
+  }
+
+  const char* const async_str = std::getenv("HUGECTR_LOG_ASYNC");
+  if (async_str != nullptr && async_str[0] != '\0') {
+    int async_val = 0;
+    if (std::sscanf(async_str, "%d", &async_val) == 1) {
+      async_ = async_val != 0;
+    }
+  }
+  if (async_) {
+    async_writer_ = std::thread(&Logger::async_writer_loop, this);
+  }
 }
 
 size_t Logger::write_log_prefix(const bool with_prefix, char (&buffer)[Logger::MAX_PREFIX_LENGTH],
-                                const int level) const {
+                                const int level, const struct timeval& time,
+                                const char* thread_name) const {
   if (!with_prefix) {
     buffer[0] = '\0';
     return 0;
@@ -163,15 +393,13 @@ size_t Logger::write_log_prefix(const bool with_prefix, char (&buffer)[Logger::M
 
   // HCTR prefix + Time.
   {
-    struct timeval now;
-    gettimeofday(&now, nullptr);
-    std::tm now_local;
-    localtime_r(&now.tv_sec, &now_local);
+    std::tm time_local;
+    localtime_r(&time.tv_sec, &time_local);
 
     // %H:%M:%S = [00-23]:[00-59]:[00-60] == e.g., 23:59:60 = 8 bytes + 1 zero terminate.
     // (60 = for second-time-shift years)
-    p += std::strftime(p, sizeof(buffer), "[HCTR][%T", &now_local);
-    p += std::sprintf(p, ".%03ld][", now.tv_usec / 1000);
+    p += std::strftime(p, sizeof(buffer), "[HCTR][%T", &time_local);
+    p += std::sprintf(p, ".%03ld][", time.tv_usec / 1000);
   }
 
   // Level
@@ -187,14 +415,17 @@ size_t Logger::write_log_prefix(const bool with_prefix, char (&buffer)[Logger::M
   }
 
   // Assign thread name if not already set.
-  if (!has_thread_name()) {
-    std::ostringstream os;
-    os << "tid #" << std::this_thread::get_id();
-    set_thread_name(os.str());
+  if (!thread_name) {
+    if (!has_thread_name()) {
+      std::ostringstream os;
+      os << "tid #" << std::this_thread::get_id();
+      set_thread_name(os.str());
+    }
+    thread_name = get_thread_name();
   }
 
   // Thread + Rank + Prompt
-  p += std::sprintf(p, "][RK%d][%s]: ", rank_, get_thread_name());
+  p += std::sprintf(p, "][RK%d][%s]: ", rank_, thread_name);
 
   return p - buffer;
 }
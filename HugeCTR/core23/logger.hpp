@@ -61,6 +61,23 @@
      hctr_3374842_0_warning.log
      hctr_3374842_0_debug.log
 
+ * By default, messages are formatted and flushed on the calling thread. If you set
+ 'HUGECTR_LOG_ASYNC' to 1,
+ * each thread instead deposits its messages into a private lock-free ring buffer, and a background
+ writer
+ * thread renders the prefixes and performs all file I/O. This keeps verbose levels (e.g., INFO
+ during
+ * training) off the critical path. ERROR messages always remain synchronous so that they reach the
+ sink
+ * before a potential abort. If a ring overflows, the affected message falls back to the synchronous
+ path.
+ * Additionally, 'HUGECTR_LOG_BINARY=<path>' mirrors every message into a binary structured log
+ * (per record: a fixed header with timestamp, level and string lengths, followed by the thread name
+ * and message bytes) for post-run analysis.
+ * 1.3. Examples:
+     $ HUGECTR_LOG_LEVEL=3 HUGECTR_LOG_ASYNC=1 python dcn_norm_train.py
+     $ HUGECTR_LOG_ASYNC=1 HUGECTR_LOG_BINARY=/tmp/hctr.binlog python dcn_norm_train.py
+
  * 2. Exception handling:
  * For HugeCTR's own errors, HCTR_OWN_THROW is used.
  * For MPI, use HCTR_MPI_THROW. For the other libraries including CUDA, cuBLAS, NCCL,etc, use
@@ -102,6 +119,7 @@
  * which can be useful in debugging asynchronous kernel launches or cudaMemcpys.
  */
 
+#include <atomic>
 #include <cerrno>
 #include <core/macro.hpp>
 #include <core23/error.hpp>
@@ -111,6 +129,8 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <sys/time.h>
+#include <thread>
 #include <vector>
 
 #ifdef ENABLE_MPI
@@ -256,6 +276,10 @@ namespace HugeCTR {
     }                                                                          \
   } while (0)
 
+// Defined in logger.cpp; per-thread lock-free queue used by the async logging mode.
+class AsyncLogRing;
+struct AsyncLogRecord;
+
 /**
  * The logger class shouldn't be used directly. Instead use the below HCTR_LOG_* and
  * HCTR_*_CHECK_* macros.
@@ -309,8 +333,18 @@ class Logger final {
  private:
   Logger();
 
-  size_t write_log_prefix(bool with_prefix, char (&buffer)[Logger::MAX_PREFIX_LENGTH],
-                          int level) const;
+  size_t write_log_prefix(bool with_prefix, char (&buffer)[Logger::MAX_PREFIX_LENGTH], int level,
+                          const struct timeval& time, const char* thread_name) const;
+
+  // Emits an already rendered message body: enqueues it into the calling thread's ring in async
+  // mode, or writes it straight to the sinks otherwise.
+  void emit(int level, bool with_prefix, const char* message, size_t length);
+
+  // Synchronous sink path; also used by the background writer for drained records.
+  void write_record(const AsyncLogRecord& record);
+
+  AsyncLogRing* thread_ring();
+  void async_writer_loop();
 
  private:
   int rank_;
@@ -322,6 +356,13 @@ class Logger final {
   std::map<int, FILE*> log_file_;
   std::map<int, std::string> level_name_;
 
+  bool async_{false};
+  FILE* binary_log_{nullptr};
+  std::mutex async_mutex_;
+  std::vector<std::shared_ptr<AsyncLogRing>> async_rings_;
+  std::thread async_writer_;
+  std::atomic<bool> async_stop_{false};
+
  public:
   static Logger& get();
 
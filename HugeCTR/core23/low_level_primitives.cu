@@ -32,6 +32,7 @@
 #include <core23/device_guard.hpp>
 #include <core23/logger.hpp>
 #include <core23/low_level_primitives.hpp>
+#include <cstdint>
 
 namespace HugeCTR {
 
@@ -156,6 +157,218 @@ void convert_async(DstType* dst_data, const SrcType* src_data, int64_t num_eleme
                                                 const Device&, CUDAStream);
 ALL_DATA_CONVERSIONS_SUPPORTED(DEFINE_CONVERT_ASYNC_COMMON)
 
+namespace {
+
+template <typename Type, int VecWidth>
+struct alignas(sizeof(Type) * VecWidth) ConvertPadVec {
+  Type val[VecWidth];
+};
+
+constexpr int kTransposeTileDim = 32;
+constexpr int kTransposeBlockRows = 8;
+
+template <typename DstType, typename SrcType, int VecWidth>
+__global__ void convert_pad_kernel(DstType* dst, const SrcType* src, int64_t num_rows,
+                                   int64_t num_cols, int64_t dst_leading_dim) {
+  using DstVec = ConvertPadVec<DstType, VecWidth>;
+  using SrcVec = ConvertPadVec<SrcType, VecWidth>;
+  const int64_t vecs_per_row = dst_leading_dim / VecWidth;
+  const int64_t num_vecs = num_rows * vecs_per_row;
+  for (int64_t vec = blockIdx.x * blockDim.x + threadIdx.x; vec < num_vecs;
+       vec += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    const int64_t row = vec / vecs_per_row;
+    const int64_t col = (vec - row * vecs_per_row) * VecWidth;
+    DstVec out;
+    if (col < num_cols) {
+      const SrcVec in = *reinterpret_cast<const SrcVec*>(src + row * num_cols + col);
+#pragma unroll
+      for (int i = 0; i < VecWidth; i++) {
+        out.val[i] = TypeConverter<DstType, SrcType>::value(in.val[i]);
+      }
+    } else {
+#pragma unroll
+      for (int i = 0; i < VecWidth; i++) {
+        out.val[i] = TypeConverter<DstType, float>::value(0.f);
+      }
+    }
+    *reinterpret_cast<DstVec*>(dst + row * dst_leading_dim + col) = out;
+  }
+}
+
+template <typename DstType, typename SrcType>
+__global__ void convert_transpose_pad_kernel(DstType* dst, const SrcType* src, int64_t num_rows,
+                                             int64_t num_cols, int64_t dst_leading_dim) {
+  __shared__ SrcType tile[kTransposeTileDim][kTransposeTileDim + 1];
+
+  const int64_t col = blockIdx.x * kTransposeTileDim + threadIdx.x;
+#pragma unroll
+  for (int i = 0; i < kTransposeTileDim; i += kTransposeBlockRows) {
+    const int64_t row = blockIdx.y * kTransposeTileDim + threadIdx.y + i;
+    if (row < num_rows && col < num_cols) {
+      tile[threadIdx.y + i][threadIdx.x] = src[row * num_cols + col];
+    }
+  }
+  __syncthreads();
+
+  const int64_t out_col = blockIdx.y * kTransposeTileDim + threadIdx.x;
+#pragma unroll
+  for (int i = 0; i < kTransposeTileDim; i += kTransposeBlockRows) {
+    const int64_t out_row = blockIdx.x * kTransposeTileDim + threadIdx.y + i;
+    if (out_row < num_cols && out_col < dst_leading_dim) {
+      dst[out_row * dst_leading_dim + out_col] =
+          out_col < num_rows
+              ? TypeConverter<DstType, SrcType>::value(tile[threadIdx.x][threadIdx.y + i])
+              : TypeConverter<DstType, float>::value(0.f);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename DstType, typename SrcType>
+void convert_pad_transpose_async(DstType* dst_data, const SrcType* src_data, int64_t num_rows,
+                                 int64_t num_cols, int64_t dst_leading_dim, bool transpose,
+                                 const Device& device, CUDAStream stream) {
+  if (dst_data == nullptr || src_data == nullptr || num_rows <= 0 || num_cols <= 0) return;
+  HCTR_CHECK_HINT(dst_leading_dim >= (transpose ? num_rows : num_cols),
+                  "The destination leading dimension is too small for the source extents");
+
+  DeviceGuard device_guard(device);
+  if (device.type() == DeviceType::CPU) {
+    auto* params = new ConvertPadTransposeParams<DstType, SrcType>(
+        dst_data, src_data, num_rows, num_cols, dst_leading_dim, transpose);
+    HCTR_LIB_THROW(cudaLaunchHostFunc(
+        stream(), static_cast<cudaHostFn_t>(convert_pad_transpose_wrapper<DstType, SrcType>),
+        params));
+    return;
+  }
+
+  if (transpose) {
+    dim3 block(kTransposeTileDim, kTransposeBlockRows);
+    dim3 grid((num_cols + kTransposeTileDim - 1) / kTransposeTileDim,
+              (dst_leading_dim + kTransposeTileDim - 1) / kTransposeTileDim);
+    convert_transpose_pad_kernel<<<grid, block, 0, stream()>>>(dst_data, src_data, num_rows,
+                                                               num_cols, dst_leading_dim);
+  } else {
+    int vec_width =
+        16 / static_cast<int>(sizeof(DstType) > sizeof(SrcType) ? sizeof(DstType)
+                                                                : sizeof(SrcType));
+    while (vec_width > 1 &&
+           (num_cols % vec_width != 0 || dst_leading_dim % vec_width != 0 ||
+            reinterpret_cast<uintptr_t>(src_data) % (vec_width * sizeof(SrcType)) != 0 ||
+            reinterpret_cast<uintptr_t>(dst_data) % (vec_width * sizeof(DstType)) != 0)) {
+      vec_width /= 2;
+    }
+    const int64_t num_vecs = num_rows * dst_leading_dim / vec_width;
+    dim3 block(256);
+    dim3 grid(std::min<int64_t>((num_vecs + block.x - 1) / block.x, 2048));
+    switch (vec_width) {
+      case 8:
+        convert_pad_kernel<DstType, SrcType, 8>
+            <<<grid, block, 0, stream()>>>(dst_data, src_data, num_rows, num_cols, dst_leading_dim);
+        break;
+      case 4:
+        convert_pad_kernel<DstType, SrcType, 4>
+            <<<grid, block, 0, stream()>>>(dst_data, src_data, num_rows, num_cols, dst_leading_dim);
+        break;
+      case 2:
+        convert_pad_kernel<DstType, SrcType, 2>
+            <<<grid, block, 0, stream()>>>(dst_data, src_data, num_rows, num_cols, dst_leading_dim);
+        break;
+      default:
+        convert_pad_kernel<DstType, SrcType, 1>
+            <<<grid, block, 0, stream()>>>(dst_data, src_data, num_rows, num_cols, dst_leading_dim);
+        break;
+    }
+  }
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+#define DEFINE_CONVERT_PAD_TRANSPOSE_ASYNC(DstType, SrcType)                          \
+  template void convert_pad_transpose_async<DstType, SrcType>(                        \
+      DstType*, const SrcType*, int64_t, int64_t, int64_t, bool, const Device&, CUDAStream);
+DEFINE_CONVERT_PAD_TRANSPOSE_ASYNC(float, float)
+DEFINE_CONVERT_PAD_TRANSPOSE_ASYNC(__half, float)
+DEFINE_CONVERT_PAD_TRANSPOSE_ASYNC(float, __half)
+DEFINE_CONVERT_PAD_TRANSPOSE_ASYNC(__half, __half)
+
+namespace {
+
+// The descriptors are passed by value as kernel arguments, so no staging buffer or extra
+// synchronization is needed; the batch size is bounded by the 4 KiB kernel parameter limit.
+constexpr int kBatchedCopyMaxBatch = 128;
+constexpr int kBatchedCopyBlockDim = 256;
+
+struct BatchedCopyArgs {
+  void* dst[kBatchedCopyMaxBatch];
+  const void* src[kBatchedCopyMaxBatch];
+  int64_t num_bytes[kBatchedCopyMaxBatch];
+};
+
+__global__ void batched_copy_kernel(BatchedCopyArgs args) {
+  auto* dst = static_cast<uint8_t*>(args.dst[blockIdx.y]);
+  const auto* src = static_cast<const uint8_t*>(args.src[blockIdx.y]);
+  const int64_t num_bytes = args.num_bytes[blockIdx.y];
+  const int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+
+  if ((reinterpret_cast<uintptr_t>(dst) | reinterpret_cast<uintptr_t>(src) |
+       static_cast<uintptr_t>(num_bytes)) %
+          sizeof(uint4) ==
+      0) {
+    auto* dst4 = reinterpret_cast<uint4*>(dst);
+    const auto* src4 = reinterpret_cast<const uint4*>(src);
+    const int64_t num_vecs = num_bytes / static_cast<int64_t>(sizeof(uint4));
+    for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < num_vecs; i += stride) {
+      dst4[i] = src4[i];
+    }
+  } else {
+    for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < num_bytes; i += stride) {
+      dst[i] = src[i];
+    }
+  }
+}
+
+}  // namespace
+
+void batched_copy_async(void* const* dst_data, const void* const* src_data,
+                        const int64_t* num_bytes, int64_t num_copies, const Device& device,
+                        CUDAStream stream) {
+  if (num_copies <= 0) {
+    return;
+  }
+  if (device.type() == DeviceType::CPU) {
+    for (int64_t i = 0; i < num_copies; i++) {
+      copy_async(dst_data[i], src_data[i], num_bytes[i], device, device, stream);
+    }
+    return;
+  }
+
+  DeviceGuard device_guard(device);
+  for (int64_t start = 0; start < num_copies; start += kBatchedCopyMaxBatch) {
+    const int batch = static_cast<int>(std::min<int64_t>(kBatchedCopyMaxBatch, num_copies - start));
+    BatchedCopyArgs args;
+    int64_t max_bytes = 0;
+    for (int i = 0; i < batch; i++) {
+      args.dst[i] = dst_data[start + i];
+      args.src[i] = src_data[start + i];
+      args.num_bytes[i] = num_bytes[start + i];
+      max_bytes = std::max(max_bytes, num_bytes[start + i]);
+    }
+    if (max_bytes == 0) {
+      continue;
+    }
+    // Scale the blocks per copy with the largest copy in the batch; small copies exit early.
+    const int64_t blocks_per_copy =
+        std::min<int64_t>(32, (max_bytes / static_cast<int64_t>(sizeof(uint4)) +
+                               kBatchedCopyBlockDim - 1) /
+                                  kBatchedCopyBlockDim +
+                              1);
+    dim3 grid(static_cast<unsigned int>(blocks_per_copy), static_cast<unsigned int>(batch));
+    batched_copy_kernel<<<grid, kBatchedCopyBlockDim, 0, stream()>>>(args);
+    HCTR_LIB_THROW(cudaGetLastError());
+  }
+}
+
 template <typename Type>
 void uniform_async(Type* data, int64_t num_elements, const Type a, const Type b,
                    const Device& device, CURANDGenerator generator, CUDAStream stream) {
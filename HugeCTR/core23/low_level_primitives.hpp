@@ -38,10 +38,37 @@ void copy_sync(void* dst_data, const void* src_data, int64_t num_bytes, const De
 void copy_async(void* dst_data, const void* src_data, int64_t num_bytes, const Device& dst_device,
                 const Device& src_device, CUDAStream stream);
 
+/**
+ * Batched variant of copy_async for many small copies. All `num_copies` (dst, src, num_bytes)
+ * triplets are executed by a single fused copy kernel per launch (the descriptors travel as
+ * kernel arguments, chunked if necessary), so thousands of sub-kilobyte copies cost a handful of
+ * launches instead of one cudaMemcpyAsync each. Every pointer must be accessible from `device`:
+ * its own memory, peer-accessible device memory, or pinned host memory. The triplet arrays live
+ * on the host and may be reused as soon as the call returns.
+ */
+void batched_copy_async(void* const* dst_data, const void* const* src_data,
+                        const int64_t* num_bytes, int64_t num_copies, const Device& device,
+                        CUDAStream stream);
+
 template <typename DstType, typename SrcType>
 void convert_async(DstType* dst_data, const SrcType* src_data, int64_t num_elements,
                    const Device& dst_device, const Device& src_device, CUDAStream stream);
 
+/**
+ * Fused elementwise-convert + optional transpose + pad in a single pass, meant for
+ * mixed-precision input staging where a separate convert_async and layout pass would each read
+ * and write the whole batch again. `src_data` is a row-major `num_rows` x `num_cols` matrix on
+ * `device`. Without `transpose`, `dst_data` is `num_rows` x `dst_leading_dim` and the trailing
+ * `dst_leading_dim - num_cols` columns are zero-filled; the copy path uses up to 16-byte
+ * vectorized I/O (float4/half8) when the extents and pointers allow it. With `transpose`,
+ * `dst_data` is `num_cols` x `dst_leading_dim` with `dst_leading_dim >= num_rows` and the
+ * transposition goes through a shared-memory tile.
+ */
+template <typename DstType, typename SrcType>
+void convert_pad_transpose_async(DstType* dst_data, const SrcType* src_data, int64_t num_rows,
+                                 int64_t num_cols, int64_t dst_leading_dim, bool transpose,
+                                 const Device& device, CUDAStream stream);
+
 template <typename Type>
 void uniform_async(Type* data, int64_t num_elements, const Type a, const Type b,
                    const Device& device, CURANDGenerator generator, CUDAStream stream);
@@ -36,6 +36,37 @@
 #define HCTR_DEVICE_INLINE inline
 #endif
 
+// Compile-time-gated NVTX annotation layer. Build with -DHCTR_ENABLE_NVTX (cmake
+// -DENABLE_NVTX=ON) to get named ranges for the major pipeline, embedding and HPS stages in
+// Nsight timelines; without the flag the macro expands to nothing, so production binaries pay
+// no cost. Range names follow "<component>::<phase>", e.g. "embedding::model_forward".
+#ifdef HCTR_ENABLE_NVTX
+#include <nvToolsExt.h>
+
+namespace HugeCTR {
+namespace core23 {
+
+class NvtxRange final {
+ public:
+  explicit NvtxRange(const char* const name) { nvtxRangePushA(name); }
+  NvtxRange(const NvtxRange&) = delete;
+  NvtxRange& operator=(const NvtxRange&) = delete;
+  ~NvtxRange() { nvtxRangePop(); }
+};
+
+}  // namespace core23
+}  // namespace HugeCTR
+
+#define HCTR_NVTX_CONCAT_IMPL_(A, B) A##B
+#define HCTR_NVTX_CONCAT_(A, B) HCTR_NVTX_CONCAT_IMPL_(A, B)
+#define HCTR_NVTX_RANGE(NAME) \
+  const HugeCTR::core23::NvtxRange HCTR_NVTX_CONCAT_(hctr_nvtx_range_, __LINE__) { NAME }
+#else
+#define HCTR_NVTX_RANGE(NAME) \
+  do {                        \
+  } while (0)
+#endif
+
 // TODO: Add the macros for common CUDA for loops
 // TODO: Remove duplicate code and variable
 constexpr int kWarpSize = 32;
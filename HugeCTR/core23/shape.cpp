@@ -24,7 +24,7 @@ namespace core23 {
 
 bool Shape::operator==(const Shape &other) const {
   return dims() == other.dims() && [&] {
-    for (size_t i = 0; i < dims(); ++i) {
+    for (int64_t i = 0; i < dims(); ++i) {
       if (size(i) != other.size(i)) {
         return false;
       }
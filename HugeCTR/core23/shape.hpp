@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -24,18 +26,36 @@ namespace HugeCTR {
 
 namespace core23 {
 
-class Shape : private std::vector<int64_t> {
+/**
+ * The dimension sizes live inline in the object rather than on the heap: Shapes are created,
+ * copied and compared in per-iteration host bookkeeping, and the old std::vector-backed
+ * representation paid one allocation per Shape there. Copies and moves are trivial and
+ * noexcept, and the size arithmetic is constexpr.
+ */
+class Shape {
  public:
-  Shape() {}
-  Shape(int64_t dims) : std::vector<int64_t>(dims, 0) {}
-  Shape(std::initializer_list<int64_t> l) : std::vector<int64_t>(l) {}
-  Shape(const std::vector<int64_t> &l) : std::vector<int64_t>(l) {}
-  int64_t dims() const { return std::vector<int64_t>::size(); }
-  int64_t size(int64_t dim) const { return empty() ? 0 : at(dim); }
-  int64_t &operator[](const int64_t dim) { return at(dim); }
-  const int64_t &operator[](const int64_t dim) const { return at(dim); }
-  int64_t size() const {
-    if (empty()) {
+  static constexpr int64_t MAX_DIMS = 32;
+
+  constexpr Shape() noexcept : dims_(0), sizes_{} {}
+  constexpr Shape(int64_t dims) : dims_(checked_dims(dims)), sizes_{} {}
+  constexpr Shape(std::initializer_list<int64_t> l)
+      : dims_(checked_dims(static_cast<int64_t>(l.size()))), sizes_{} {
+    int64_t dim = 0;
+    for (auto size : l) {
+      sizes_[dim++] = size;
+    }
+  }
+  Shape(const std::vector<int64_t> &l) : dims_(checked_dims(static_cast<int64_t>(l.size()))) {
+    for (int64_t dim = 0; dim < MAX_DIMS; dim++) {
+      sizes_[dim] = dim < dims_ ? l[dim] : 0;
+    }
+  }
+  constexpr int64_t dims() const noexcept { return dims_; }
+  constexpr int64_t size(int64_t dim) const { return dims_ == 0 ? 0 : at(dim); }
+  constexpr int64_t &operator[](const int64_t dim) { return at(dim); }
+  constexpr const int64_t &operator[](const int64_t dim) const { return at(dim); }
+  constexpr int64_t size() const {
+    if (dims_ == 0) {
       return 0;
     }
 
@@ -45,13 +65,36 @@ class Shape : private std::vector<int64_t> {
     }
     return sum;
   }
-  void set(int64_t dim, int64_t size) { at(dim) = size; }
-  const int64_t *data() const { return std::vector<int64_t>::data(); }
+  constexpr void set(int64_t dim, int64_t size) { at(dim) = size; }
+  constexpr const int64_t *data() const noexcept { return sizes_; }
 
   bool operator==(const Shape &other) const;
   bool operator!=(const Shape &other) const { return !(*this == other); }
 
   std::string str() const;
+
+ private:
+  static constexpr int64_t checked_dims(int64_t dims) {
+    if (dims < 0 || dims > MAX_DIMS) {
+      throw std::out_of_range("core23::Shape supports at most MAX_DIMS dimensions");
+    }
+    return dims;
+  }
+  constexpr int64_t &at(int64_t dim) {
+    if (dim < 0 || dim >= dims_) {
+      throw std::out_of_range("core23::Shape dimension index is out of range");
+    }
+    return sizes_[dim];
+  }
+  constexpr const int64_t &at(int64_t dim) const {
+    if (dim < 0 || dim >= dims_) {
+      throw std::out_of_range("core23::Shape dimension index is out of range");
+    }
+    return sizes_[dim];
+  }
+
+  int64_t dims_;
+  int64_t sizes_[MAX_DIMS];
 };
 
 std::ostream &operator<<(std::ostream &os, const Shape &s);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core23/logger.hpp>
+#include <core23/staging_buffer_pool.hpp>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+namespace {
+
+constexpr size_t MIN_SIZE_CLASS = 4096;
+
+}  // namespace
+
+StagingBufferPool& StagingBufferPool::instance() {
+  // Deliberately leaked: the pinned blocks must not be freed during static destruction,
+  // after the CUDA runtime may already have shut down.
+  static StagingBufferPool* pool = new StagingBufferPool();
+  return *pool;
+}
+
+size_t StagingBufferPool::size_class(size_t num_bytes) {
+  size_t klass = MIN_SIZE_CLASS;
+  while (klass < num_bytes) {
+    klass <<= 1;
+  }
+  return klass;
+}
+
+void StagingBufferPool::reclaim_completed_locked() {
+  for (auto it = in_flight_blocks_.begin(); it != in_flight_blocks_.end();) {
+    const cudaError_t status = cudaEventQuery(it->event);
+    if (status == cudaErrorNotReady) {
+      ++it;
+      continue;
+    }
+    HCTR_LIB_THROW(status);
+    free_blocks_[block_size_class_.at(it->ptr)].push_back(it->ptr);
+    event_pool_.push_back(it->event);
+    it = in_flight_blocks_.erase(it);
+  }
+}
+
+void* StagingBufferPool::acquire(size_t num_bytes) {
+  const size_t klass = size_class(num_bytes);
+  std::lock_guard<std::mutex> lock(mutex_);
+  reclaim_completed_locked();
+  auto it = free_blocks_.find(klass);
+  if (it != free_blocks_.end() && !it->second.empty()) {
+    void* ptr = it->second.back();
+    it->second.pop_back();
+    return ptr;
+  }
+  void* ptr = nullptr;
+  HCTR_LIB_THROW(cudaHostAlloc(&ptr, klass, cudaHostAllocPortable));
+  block_size_class_[ptr] = klass;
+  allocated_bytes_ += klass;
+  return ptr;
+}
+
+void StagingBufferPool::release(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_blocks_[block_size_class_.at(ptr)].push_back(ptr);
+}
+
+void StagingBufferPool::release(void* ptr, cudaStream_t stream) {
+  if (ptr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  cudaEvent_t event;
+  if (!event_pool_.empty()) {
+    event = event_pool_.back();
+    event_pool_.pop_back();
+  } else {
+    HCTR_LIB_THROW(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  }
+  HCTR_LIB_THROW(cudaEventRecord(event, stream));
+  in_flight_blocks_.push_back({ptr, event});
+}
+
+size_t StagingBufferPool::allocated_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+}  // namespace core23
+
+}  // namespace HugeCTR
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace core23 {
+
+/**
+ * Process-wide pool of pinned host staging buffers. Checkpoint D2H copies, the HPS model
+ * loader and the embedding-cache refresh space each stage transfers through short-lived
+ * pinned buffers; allocating them with cudaHostAlloc per use both registers the pages again
+ * every time (which takes seconds for multi-GB buffers) and lets the peak pinned footprint
+ * become the sum of all clients. The pool hands out blocks rounded up to power-of-two size
+ * classes and keeps released blocks registered for reuse, so the footprint converges to the
+ * high-water mark of concurrent use instead.
+ *
+ * release(ptr) requires the host to be done with the buffer (e.g. after an event or stream
+ * sync); release(ptr, stream) is stream-ordered: the block is parked behind an event recorded
+ * on the stream and only becomes reusable once that event has completed, checked lazily on
+ * later acquires.
+ */
+class StagingBufferPool final {
+ public:
+  static StagingBufferPool& instance();
+
+  StagingBufferPool(const StagingBufferPool&) = delete;
+  StagingBufferPool& operator=(const StagingBufferPool&) = delete;
+
+  void* acquire(size_t num_bytes);
+  void release(void* ptr);
+  void release(void* ptr, cudaStream_t stream);
+
+  //! Total bytes of pinned memory currently owned by the pool (free, parked or handed out).
+  size_t allocated_bytes() const;
+
+ private:
+  struct InFlightBlock {
+    void* ptr;
+    cudaEvent_t event;
+  };
+
+  StagingBufferPool() = default;
+  ~StagingBufferPool() = default;
+
+  static size_t size_class(size_t num_bytes);
+  void reclaim_completed_locked();
+
+  mutable std::mutex mutex_;
+  std::map<size_t, std::vector<void*>> free_blocks_;   // size class -> reusable blocks
+  std::unordered_map<void*, size_t> block_size_class_;  // every block the pool ever handed out
+  std::vector<InFlightBlock> in_flight_blocks_;
+  std::vector<cudaEvent_t> event_pool_;
+  size_t allocated_bytes_ = 0;
+};
+
+}  // namespace core23
+
+}  // namespace HugeCTR
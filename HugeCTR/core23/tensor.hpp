@@ -102,6 +102,24 @@ class Tensor {
                                          offsets.data());
   }
 
+  // Compile-time-shaped view, e.g. `view<float, 2, DynamicExtent, 128>()`. The static `Extents`
+  // are validated against the Tensor's shape once here, so hot kernels can fold all stride
+  // arithmetic; see TensorView in tensor_view.hpp.
+  template <typename BuiltInType, int64_t Dims, int64_t FirstExtent, int64_t... RestExtents>
+  TensorView<BuiltInType, Dims, FirstExtent, RestExtents...> view() const {
+    static_assert(static_cast<int64_t>(sizeof...(RestExtents)) + 1 == Dims,
+                  "The number of `Extents` must be equal to `Dims`");
+    auto dynamic_view = view<BuiltInType, Dims>();
+    const int64_t extents[] = {FirstExtent, RestExtents...};
+    for (int64_t d = 0; d < Dims; d++) {
+      HCTR_THROW_IF(extents[d] != DynamicExtent && extents[d] != dynamic_view.size(d),
+                    HugeCTR::Error_t::IllegalCall,
+                    "The static `Extents` are inconsistent with the Tensor's shape.");
+    }
+    return TensorView<BuiltInType, Dims, FirstExtent, RestExtents...>(
+        static_cast<BuiltInType*>(data()), dynamic_view.size(0));
+  }
+
  private:
   Tensor(const std::shared_ptr<TensorImpl>& impl);
   void swap(Tensor& rhs);
@@ -118,6 +118,38 @@ void convert_async(Tensor& dst, const Tensor& src, CUDAStream stream) {
   }
 }
 
+#define DEFINE_CONVERT_PAD_TRANSPOSE_ELSE_IF(DstType, SrcType)                                 \
+  else if (dst.data_type() == ToScalarType<DstType>::value &&                                  \
+           src.data_type() == ToScalarType<SrcType>::value) {                                  \
+    convert_pad_transpose_async<DstType, SrcType>(dst.data<DstType>(), src.data<SrcType>(),    \
+                                                  src.size(0), src.size(1), dst.size(1),       \
+                                                  transpose, src.device(), stream);            \
+  }
+
+void convert_pad_transpose_async(Tensor& dst, const Tensor& src, bool transpose,
+                                 CUDAStream stream) {
+  HCTR_THROW_IF(dst.dims() != 2 || src.dims() != 2, HugeCTR::Error_t::IllegalCall,
+                "Destination and Source Tensors must be two-dimensional.");
+  HCTR_THROW_IF(dst.device() != src.device(), HugeCTR::Error_t::IllegalCall,
+                "Destination and Source Tensors must be on the same Device.");
+  const int64_t dst_rows = transpose ? src.size(1) : src.size(0);
+  const int64_t min_dst_cols = transpose ? src.size(0) : src.size(1);
+  HCTR_THROW_IF(dst.size(0) != dst_rows || dst.size(1) < min_dst_cols,
+                HugeCTR::Error_t::IllegalCall,
+                "The Destination Tensor's shape is inconsistent with the Source Tensor's.");
+  if (false) {
+  }
+  DEFINE_CONVERT_PAD_TRANSPOSE_ELSE_IF(float, float)
+  DEFINE_CONVERT_PAD_TRANSPOSE_ELSE_IF(__half, float)
+  DEFINE_CONVERT_PAD_TRANSPOSE_ELSE_IF(float, __half)
+  DEFINE_CONVERT_PAD_TRANSPOSE_ELSE_IF(__half, __half)
+  else {
+    HCTR_THROW_IF(false, HugeCTR::Error_t::IllegalCall,
+                  "Casting from " + src.data_type().name() + " to " + dst.data_type().name() +
+                      " is not implemented");
+  }
+}
+
 void uniform_async(Tensor& data, const float a, const float b, CURANDGenerator generator,
                    CUDAStream stream) {
   if (data.data_type() == ToScalarType<float>::value) {
@@ -42,6 +42,10 @@ template <typename T>
 void copy_async(Tensor& dst, const std::vector<T>& src, CUDAStream stream = CUDAStream());
 
 void convert_async(Tensor& dst, const Tensor& src, CUDAStream stream = CUDAStream());
+//! Fused convert + optional transpose + zero-pad for 2-D float/__half Tensors; the extra columns
+//! of `dst` beyond the (possibly transposed) extents of `src` are zero-filled in the same pass.
+void convert_pad_transpose_async(Tensor& dst, const Tensor& src, bool transpose,
+                                 CUDAStream stream = CUDAStream());
 void uniform_async(Tensor& data, const float a, const float b, CURANDGenerator generator,
                    CUDAStream stream = CUDAStream());
 void normal_async(Tensor& data, const float mean, const float stddev, CURANDGenerator generator,
@@ -92,6 +92,16 @@ class TensorParams final {
     return p;
   }
 
+  // Logical [first_use, last_use] interval of the Tensor in execution order, consumed by a
+  // lifetime-aware Buffer (see BufferParams::lifetime_aware) to alias non-overlapping Tensors
+  // into the same storage. Unset by default, which disables aliasing for this Tensor.
+  TensorParams lifetime(int64_t first_use, int64_t last_use) const noexcept {
+    TensorParams p = *this;
+    p.first_use_ = first_use;
+    p.last_use_ = last_use;
+    return p;
+  }
+
   const Shape& shape() const { return shape_; };
 
   DataType data_type() const { return data_type_; }
@@ -101,6 +111,8 @@ class TensorParams final {
   const BufferParams& buffer_params() const { return buffer_params_; }
   const BufferChannel& buffer_channel() const { return buffer_params_.channel; }
   CUDAStream stream() const { return stream_; }
+  int64_t first_use() const { return first_use_; }
+  int64_t last_use() const { return last_use_; }
 
  private:
   void set_shape(const Shape& shape) { shape_ = shape; }
@@ -113,6 +125,8 @@ class TensorParams final {
   AllocatorParams allocator_params_;
   BufferParams buffer_params_;
   CUDAStream stream_;
+  int64_t first_use_ = -1;
+  int64_t last_use_ = -1;
 };
 
 }  // namespace core23
@@ -24,6 +24,13 @@ namespace HugeCTR {
 
 namespace core23 {
 
+// Placeholder for a dimension whose size is only known at runtime in an otherwise
+// compile-time-shaped TensorView.
+constexpr int64_t DynamicExtent = -1;
+
+template <typename BuiltInType, int64_t Dims, int64_t... Extents>
+class TensorView;
+
 template <typename BuiltInType, int64_t Dims>
 class TensorViewImplBase {
  public:
@@ -98,7 +105,7 @@ class TensorViewBase {
 };
 
 template <typename BuiltInType, int64_t Dims>
-class TensorView : public TensorViewBase<BuiltInType, Dims> {
+class TensorView<BuiltInType, Dims> : public TensorViewBase<BuiltInType, Dims> {
  public:
   HCTR_HOST TensorView(BuiltInType* data, const int64_t* shape, const int64_t* offsets)
       : TensorViewBase<BuiltInType, Dims>(data, shape, offsets) {}
@@ -126,6 +133,108 @@ class TensorView<BuiltInType, 1> : public TensorViewBase<BuiltInType, 1> {
   }
 };
 
+/**
+ * Compile-time-shaped counterpart of TensorViewImpl. All extents below the outermost dimension
+ * are template parameters, so every stride is a compile-time constant and the per-access offset
+ * arithmetic folds into the addressing mode instead of consuming registers.
+ */
+template <typename BuiltInType, int64_t... Extents>
+class StaticTensorViewImpl;
+
+template <typename BuiltInType, int64_t Extent>
+class StaticTensorViewImpl<BuiltInType, Extent> {
+ public:
+  HCTR_HOST_DEVICE StaticTensorViewImpl(BuiltInType* data) : data_(data) {}
+
+  HCTR_INLINE HCTR_HOST_DEVICE BuiltInType& operator[](int64_t index) const {
+    return data_[index];
+  }
+
+ private:
+  BuiltInType* data_;
+};
+
+template <typename BuiltInType, int64_t Extent, int64_t NextExtent, int64_t... RestExtents>
+class StaticTensorViewImpl<BuiltInType, Extent, NextExtent, RestExtents...> {
+  static constexpr int64_t kStride = NextExtent * (RestExtents * ... * int64_t{1});
+
+ public:
+  HCTR_HOST_DEVICE StaticTensorViewImpl(BuiltInType* data) : data_(data) {}
+
+  HCTR_INLINE HCTR_HOST_DEVICE StaticTensorViewImpl<BuiltInType, NextExtent, RestExtents...>
+  operator[](int64_t index) const {
+    return StaticTensorViewImpl<BuiltInType, NextExtent, RestExtents...>(data_ + kStride * index);
+  }
+
+ private:
+  BuiltInType* data_;
+};
+
+/**
+ * Compile-time-shaped TensorView specialization for fixed-dim hot kernels, e.g.
+ * `TensorView<float, 2, DynamicExtent, 128>` for embedding vectors of a fixed width. Only the
+ * outermost extent may be DynamicExtent; all inner extents (and thus all strides) are folded at
+ * compile time. Unlike the runtime-shaped TensorView, it has no offset support and can also be
+ * constructed in device code from a raw pointer.
+ */
+template <typename BuiltInType, int64_t Extent>
+class TensorView<BuiltInType, 1, Extent> {
+ public:
+  HCTR_HOST_DEVICE TensorView(BuiltInType* data, int64_t size0 = Extent)
+      : data_(data), size0_(size0) {}
+
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t dims() const { return 1; }
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t size(int64_t) const { return size0_; }
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t stride(int64_t) const { return 1; }
+  HCTR_INLINE HCTR_HOST_DEVICE BuiltInType* data() const { return data_; }
+
+  HCTR_INLINE HCTR_HOST_DEVICE BuiltInType& operator[](int64_t index) const {
+    return data_[index];
+  }
+
+ private:
+  BuiltInType* data_;
+  int64_t size0_;
+};
+
+template <typename BuiltInType, int64_t Dims, int64_t FirstExtent, int64_t NextExtent,
+          int64_t... RestExtents>
+class TensorView<BuiltInType, Dims, FirstExtent, NextExtent, RestExtents...> {
+  static_assert(static_cast<int64_t>(sizeof...(RestExtents)) + 2 == Dims,
+                "The number of `Extents` must be equal to `Dims`");
+  static_assert(NextExtent != DynamicExtent && ((RestExtents != DynamicExtent) && ...),
+                "Only the outermost extent may be DynamicExtent");
+  static constexpr int64_t kStride0 = NextExtent * (RestExtents * ... * int64_t{1});
+
+ public:
+  HCTR_HOST_DEVICE TensorView(BuiltInType* data, int64_t size0 = FirstExtent)
+      : data_(data), size0_(size0) {}
+
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t dims() const { return Dims; }
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t size(int64_t dim) const {
+    const int64_t extents[] = {FirstExtent, NextExtent, RestExtents...};
+    return dim == 0 ? size0_ : extents[dim];
+  }
+  HCTR_INLINE HCTR_HOST_DEVICE int64_t stride(int64_t dim) const {
+    const int64_t extents[] = {FirstExtent, NextExtent, RestExtents...};
+    int64_t stride = 1;
+    for (int64_t d = Dims - 1; d > dim; d--) {
+      stride *= extents[d];
+    }
+    return stride;
+  }
+  HCTR_INLINE HCTR_HOST_DEVICE BuiltInType* data() const { return data_; }
+
+  HCTR_INLINE HCTR_HOST_DEVICE StaticTensorViewImpl<BuiltInType, NextExtent, RestExtents...>
+  operator[](int64_t index) const {
+    return StaticTensorViewImpl<BuiltInType, NextExtent, RestExtents...>(data_ + kStride0 * index);
+  }
+
+ private:
+  BuiltInType* data_;
+  int64_t size0_;
+};
+
 }  // namespace core23
 
 }  // namespace HugeCTR
@@ -18,6 +18,7 @@
 
 #include <core/hctr_impl/hctr_backend.hpp>
 #include <embedding/common.hpp>
+#include <embedding/operators/workspace_arena.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
@@ -654,9 +655,25 @@ void Wgrad::init_attr(const EmbeddingCollectionParam &ebc_param, WgradAttr wgrad
 }
 
 void Wgrad::init_data(std::shared_ptr<CoreResourceManager> core, uint32_t h_unique_key_num,
-                      int max_ev_size) {
+                      int max_ev_size, WorkspaceArena *arena) {
   HCTR_CHECK_HINT(this->attr_allocated, "Wgrad's attr should be inited before init data");
   HugeCTR::CudaDeviceContext context(core->get_device_id());
+  if (arena != nullptr) {
+    this->unique_keys = arena->allocate(core23::Shape({static_cast<int64_t>(h_unique_key_num)}),
+                                        this->attr.key_type);
+    this->table_ids = arena->allocate(core23::Shape({static_cast<int64_t>(h_unique_key_num)}),
+                                      core23::ScalarType::Int32);
+    this->data = arena->allocate(
+        core23::Shape({static_cast<int64_t>(h_unique_key_num) * max_ev_size}), this->attr.type);
+    this->ev_start_indices = arena->allocate(
+        core23::Shape({static_cast<int64_t>(h_unique_key_num) + 1}), core23::ScalarType::UInt32);
+
+    this->h_unique_keys = h_unique_key_num;
+    this->is_dynamic_allocate = true;
+    this->data_allocated = true;
+    this->indices_allocated = true;
+    return;
+  }
   core23::Device device(core23::DeviceType::GPU, core->get_device_id());
   core23::TensorParams params = core23::TensorParams().device(device);
   this->unique_keys = core23::Tensor(
@@ -678,12 +695,17 @@ void Wgrad::init_data(std::shared_ptr<CoreResourceManager> core, uint32_t h_uniq
 void DynamicWgradInitiazlier::init_indices_and_data(Wgrad &wgrad, size_t h_num_key,
                                                     core23::Tensor key_flag_buffer, int max_ev_size,
                                                     std::shared_ptr<CoreResourceManager> core,
-                                                    cudaStream_t stream) {
+                                                    cudaStream_t stream, WorkspaceArena *arena) {
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
   uint32_t h_unique_key_num = 0;
   HCTR_LIB_THROW(cudaMemcpy(&h_unique_key_num, key_flag_buffer.data<uint32_t>() + h_num_key - 1,
                             sizeof(uint32_t), cudaMemcpyDeviceToHost));
-  wgrad.init_data(core, h_unique_key_num, max_ev_size);
+  if (arena != nullptr) {
+    // The stream was just synchronized, so no sub-tensor of the previous iteration is
+    // still in flight and the arena may recycle (or grow) its backing block.
+    arena->begin_iteration();
+  }
+  wgrad.init_data(core, h_unique_key_num, max_ev_size, arena);
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
   return;
 }
@@ -711,12 +733,19 @@ WgradInitializer &WgradInitializer::init_indices() {
   core23::Device device(core23::DeviceType::GPU, core->get_device_id());
   core23::TensorParams params = core23::TensorParams().device(device);
   wgrad->attr.type = ebc_param.wgrad_type_;
-  wgrad->unique_keys =
-      core23::Tensor(params.shape({batch_size * max_num_keys}).data_type(key_type));
-  wgrad->table_ids = core23::Tensor(
-      params.shape({batch_size * max_num_keys}).data_type(core23::ScalarType::Int32));
-  wgrad->ev_start_indices = core23::Tensor(
-      params.shape({batch_size * max_num_keys + 1}).data_type(core23::ScalarType::UInt32));
+
+  // size the compacted representation (unique keys + CSR-style offsets) with
+  // the same uniqueness ratio as the data buffer, instead of worst-case
+  // batch * hotness; both shrink together or not at all
+  double wgrad_unique_ratio = get_wgrad_unique_ratio();
+  int64_t num_keys = static_cast<int64_t>(
+      wgrad_unique_ratio * static_cast<double>(static_cast<int64_t>(batch_size) * max_num_keys));
+
+  wgrad->unique_keys = core23::Tensor(params.shape({num_keys}).data_type(key_type));
+  wgrad->table_ids =
+      core23::Tensor(params.shape({num_keys}).data_type(core23::ScalarType::Int32));
+  wgrad->ev_start_indices =
+      core23::Tensor(params.shape({num_keys + 1}).data_type(core23::ScalarType::UInt32));
   wgrad->indices_allocated = true;
   return *this;
 }
@@ -869,6 +898,11 @@ double get_wgrad_unique_ratio() {
   const char *const dense_unique_ratio_env = std::getenv("WGRAD_UNIQUE_RATIO");
   if (dense_unique_ratio_env != nullptr) {
     wgrad_unique_ratio = std::atof(dense_unique_ratio_env);
+    if (wgrad_unique_ratio <= 0.0 || wgrad_unique_ratio > 1.0) {
+      HCTR_LOG_S(WARNING, ROOT) << "WGRAD_UNIQUE_RATIO " << wgrad_unique_ratio
+                                << " out of (0, 1], using 1.0" << std::endl;
+      wgrad_unique_ratio = 1.0;
+    }
   }
   return wgrad_unique_ratio;
 }
@@ -349,6 +349,8 @@ struct WgradAttr {
   }
 };
 
+class WorkspaceArena;
+
 struct Wgrad {
   WgradAttr attr;
 
@@ -368,14 +370,16 @@ struct Wgrad {
   // sometimes need allocate attribute and data separate
   void init_attr(const EmbeddingCollectionParam &ebc_param, WgradAttr wgrad_attr,
                  std::shared_ptr<CoreResourceManager> &core);
+  // When an arena is given, the buffers are bump-allocated from its iteration-scoped
+  // backing block instead of the allocator.
   void init_data(std::shared_ptr<CoreResourceManager> core, uint32_t h_unique_key_num,
-                 int max_ev_size);
+                 int max_ev_size, WorkspaceArena *arena = nullptr);
 };
 
 struct DynamicWgradInitiazlier {
   void init_indices_and_data(Wgrad &wgrad, size_t h_num_key, core23::Tensor key_flag_buffer,
                              int max_ev_size, std::shared_ptr<CoreResourceManager> core,
-                             cudaStream_t stream);
+                             cudaStream_t stream, WorkspaceArena *arena = nullptr);
 };
 
 struct WgradInitializer {
@@ -19,6 +19,8 @@
 #include <cub/cub.cuh>
 #include <embedding/data_distributor/data_compression_operators.cuh>
 #include <embedding/view.hpp>
+#include <numeric>
+#include <unordered_map>
 #include <utils.cuh>
 #include <utils.hpp>
 
@@ -40,8 +42,9 @@ __global__ void cal_range_on_selected_lookup_ids_kernel(
 template <typename KeyType, typename BucketRangeType, typename HashTable>
 __global__ void partition_and_unique_kernel(
     const KeyType **keys, const BucketRangeType **bucket_range, const int *lookup_ids,
-    const BucketRangeType *range_on_lookup_ids, int num_local_lookup, int num_sample_per_lookup,
-    HashTable hash_table, CompressedDataView<KeyType, BucketRangeType> compressed_data) {
+    const int *lookup_id_to_canonical_lookup_id, const BucketRangeType *range_on_lookup_ids,
+    int num_local_lookup, int num_sample_per_lookup, HashTable hash_table,
+    CompressedDataView<KeyType, BucketRangeType> compressed_data) {
   CUDA_1D_KERNEL_LOOP(i, num_local_lookup * num_sample_per_lookup) {
     int lookup_id = lookup_ids[i / num_sample_per_lookup];
     int sample_id = i % num_sample_per_lookup;
@@ -50,10 +53,15 @@ __global__ void partition_and_unique_kernel(
     const BucketRangeType *bucket_range_in_lookup = bucket_range[lookup_id];
     auto start = bucket_range_in_lookup[sample_id];
     auto end = bucket_range_in_lookup[sample_id + 1];
+    // unique on (key, canonical lookup id): same-table lookups collapse into one slot, so a key
+    // appearing in several of them crosses the all2all once. The canonical id still maps to the
+    // right local table id on the receiving side.
+    int canonical_lookup_id = lookup_id_to_canonical_lookup_id[lookup_id];
     for (uint32_t l = 0; l < (end - start); ++l) {
       const uint32_t id = start + l;
       const auto key = keys_in_lookup[id];
-      uint32_t r_idx_plus_one = hash_table.find({key, lookup_id}, compressed_data.partitioned_data);
+      uint32_t r_idx_plus_one =
+          hash_table.find({key, canonical_lookup_id}, compressed_data.partitioned_data);
 
       const uint32_t range_start = range_on_lookup_ids[i / num_sample_per_lookup];
       compressed_data.reverse_idx[id + range_start] = r_idx_plus_one - 1;
@@ -333,6 +341,28 @@ PartitionAndUniqueOperator::PartitionAndUniqueOperator(
 
   core23::copy_sync(d_lookup_ids_, grouped_lookup_param.lookup_ids);
 
+  // Lookups on the same table partition identically (the shard matrix is per table), so we can
+  // unique their keys together: canonicalize each lookup id to the lowest lookup id in this
+  // group that reads the same table. A key shared by several same-table lookups is then stored
+  // and transmitted across the all2all once; the per-position reverse idx fans the unique slot
+  // back out to every bucket.
+  std::vector<int> h_lookup_id_to_canonical_lookup_id(ebc_param.num_lookup);
+  std::iota(h_lookup_id_to_canonical_lookup_id.begin(), h_lookup_id_to_canonical_lookup_id.end(),
+            0);
+  std::unordered_map<int, int> table_id_to_canonical_lookup_id;
+  for (int lookup_id : grouped_lookup_param.lookup_ids) {
+    int table_id = ebc_param.lookup_params[lookup_id].table_id;
+    auto iter = table_id_to_canonical_lookup_id.find(table_id);
+    if (iter == table_id_to_canonical_lookup_id.end()) {
+      table_id_to_canonical_lookup_id[table_id] = lookup_id;
+    } else {
+      h_lookup_id_to_canonical_lookup_id[lookup_id] = iter->second;
+    }
+  }
+  d_lookup_id_to_canonical_lookup_id_ =
+      core23::Tensor(params.shape({ebc_param.num_lookup}).data_type(core23::ScalarType::Int32));
+  core23::copy_sync(d_lookup_id_to_canonical_lookup_id_, h_lookup_id_to_canonical_lookup_id);
+
   embedding::WgradAttr wgrad_attr;
   wgrad_attr.init(core, ebc_param, group_id);
 
@@ -475,6 +505,7 @@ void PartitionAndUniqueOperator::partition_and_unique_on_dp_input(
           (TableEntry<KeyType> *)hash_table_storage_.data(), table_capacity_, partitioner_view};
       partition_and_unique_kernel<<<grid_size, block_size, 0, stream>>>(
           dp_keys_ptrs, dp_bucket_range_ptrs, d_lookup_ids_.data<int>(),
+          d_lookup_id_to_canonical_lookup_id_.data<int>(),
           range_on_lookup_ids.data<BucketRangeType>(), num_local_lookup_, batch_size_per_gpu_,
           hash_table, compressed_data_view);
     });
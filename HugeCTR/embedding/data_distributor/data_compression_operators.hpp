@@ -110,6 +110,9 @@ class PartitionAndUniqueOperator {
   core23::Tensor range_on_lookup_ids;
 
   core23::Tensor d_lookup_ids_;  // int
+  // int. Maps each lookup id to the lowest lookup id in this group sharing the same table, so
+  // keys duplicated across same-table lookups dedup into one unique slot before the all2all.
+  core23::Tensor d_lookup_id_to_canonical_lookup_id_;
   int num_local_lookup_;
   int num_local_features_;
   int num_features_;
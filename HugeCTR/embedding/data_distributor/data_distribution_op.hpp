@@ -19,7 +19,6 @@
 #include <embedding/common.hpp>
 #include <embedding/data_distributor/data_compression_operators.hpp>
 #include <embedding/data_distributor/key_filtering_operators.hpp>
-#include <embedding/operators/compress_offset.hpp>
 #include <embedding/operators/keys_to_indices.hpp>
 #include <optional>
 #include <unordered_map>
@@ -57,7 +56,7 @@ class DenseMPDataDistributionOp final : public IDataDistributionOp {
 
   void filter_after_all2all(embedding::EmbeddingInput &output, cudaStream_t stream);
 
-  void convert_indices(embedding::EmbeddingInput &output);
+  void convert_indices(embedding::EmbeddingInput &output, cudaStream_t stream);
 
  private:
   std::shared_ptr<core::CoreResourceManager> core_;
@@ -89,6 +88,15 @@ class DenseMPDataDistributionOp final : public IDataDistributionOp {
 
   std::unique_ptr<embedding::KeysToIndicesConverter> indices_converter_;
   bool do_reduction_;
+
+  // Narrow-lane key exchange: when every table in this group has a vocabulary
+  // that fits in 16 or 32 bits, the all2all sends keys packed into that lane
+  // width instead of the collection's (typically 64-bit) key type. All lookups
+  // in a group share one wire buffer, so the lane is negotiated per group as
+  // the narrowest width that covers every table in it. 0 disables packing.
+  int key_lane_bytes_{0};
+  core23::Tensor packed_keys_send_;  // uint8, lane-packed partitioned keys
+  core23::Tensor packed_keys_recv_;  // uint8, lane-packed gpu-major keys
 };
 
 class SparseMPDataDistributionOp : public IDataDistributionOp {
@@ -110,7 +118,7 @@ class SparseMPDataDistributionOp : public IDataDistributionOp {
 
   void filter_after_all2all(embedding::EmbeddingInput &output, cudaStream_t stream);
 
-  void convert_indices(embedding::EmbeddingInput &output);
+  void convert_indices(embedding::EmbeddingInput &output, cudaStream_t stream);
 
  private:
   std::shared_ptr<core::CoreResourceManager> core_;
@@ -148,7 +156,6 @@ class SparseMPDataDistributionOp : public IDataDistributionOp {
   mp::SwizzleKeysOperator swizzle_keys_operator_;
 
   core23::Tensor d_local_table_ids_;
-  std::unique_ptr<embedding::CompressOffset> compress_offset_;
   std::unique_ptr<embedding::KeysToIndicesConverter> indices_converter_;
 };
 
@@ -162,7 +169,7 @@ class SparseDPDataDistributionOp final : public IDataDistributionOp {
   void distribute(const DataDistributionInput &input, embedding::EmbeddingInput &output,
                   int batch_size, cudaStream_t stream) override;
 
-  void convert_indices(embedding::EmbeddingInput &output);
+  void convert_indices(embedding::EmbeddingInput &output, cudaStream_t stream);
 
  private:
   std::shared_ptr<core::CoreResourceManager> core_;
@@ -173,7 +180,6 @@ class SparseDPDataDistributionOp final : public IDataDistributionOp {
   dp::ConcatKeysAndBucketRangeOperator concat_keys_and_bucket_range_operator_;
 
   core23::Tensor d_local_table_ids_;
-  std::unique_ptr<embedding::CompressOffset> compress_offset_;
   std::unique_ptr<embedding::KeysToIndicesConverter> indices_converter_;
 };
 }  // namespace HugeCTR
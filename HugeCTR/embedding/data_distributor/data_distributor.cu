@@ -15,6 +15,7 @@
  */
 
 #include <HugeCTR/include/utils.cuh>
+#include <core23/low_level_primitives.hpp>
 #include <embedding/data_distributor/data_compression_operators.cuh>
 #include <embedding/data_distributor/data_distributor.hpp>
 #include <embedding/operators/communication.hpp>
@@ -57,6 +58,15 @@ DataDistributor::DataDistributor(
     data_distribution_input_.emplace_back(core_resource_managers_[gpu_id], dr_lookup_ids,
                                           ebc_param.key_type, ebc_param.offset_type);
   }
+
+  const char* const key_freq_sketch_env = std::getenv("HCTR_KEY_FREQ_SKETCH");
+  if (key_freq_sketch_env != nullptr && 1 == std::atoi(key_freq_sketch_env)) {
+    for (size_t gpu_id = 0; gpu_id < num_local_gpus_; ++gpu_id) {
+      CudaDeviceContext context(core_resource_managers_[gpu_id]->get_device_id());
+      key_freq_sketches_.push_back(std::make_unique<KeyFrequencySketch>(
+          core_resource_managers_[gpu_id], static_cast<int>(emb_table_param_list_.size())));
+    }
+  }
 }
 
 void DataDistributor::init_comm_data() {
@@ -89,6 +99,9 @@ void DataDistributor::init_comm_data() {
 
     core23::copy_sync(comm_data.hotness_bucket_range, hotness_bucket_range);
 
+    HCTR_LIB_THROW(cudaEventCreateWithFlags(&comm_data.fork_event, cudaEventDisableTiming));
+    HCTR_LIB_THROW(cudaEventCreateWithFlags(&comm_data.join_event, cudaEventDisableTiming));
+
     gpu_comm_data_.emplace_back(comm_data);
   }
 }
@@ -157,7 +170,16 @@ void DataDistributor::distribute(int gpu_id, const std::vector<core23::Tensor>&
                                  DataDistributor::Result& output, int batch_size) {
   auto core = core_resource_managers_[gpu_id];
   CudaDeviceContext ctx(core->get_device_id());
-  cudaStream_t stream = core->get_local_gpu()->get_stream();
+  auto local_gpu = core->get_local_gpu();
+  cudaStream_t compute_stream = local_gpu->get_stream();
+
+  // Run the whole distribution pipeline (bucket ranges, key filtering, all2all
+  // exchanges, index conversion) on the high-priority pool so its kernels and NCCL
+  // calls preempt compute work already in flight instead of queuing behind it. The
+  // fork/join events keep it ordered with the caller's compute stream.
+  cudaStream_t stream = local_gpu->get_high_priority_stream("data_distributor");
+  HCTR_LIB_THROW(cudaEventRecord(gpu_comm_data_[gpu_id].fork_event, compute_stream));
+  HCTR_LIB_THROW(cudaStreamWaitEvent(stream, gpu_comm_data_[gpu_id].fork_event));
 
   const bool bucket_ranges_outdated = batch_size != gpu_comm_data_[gpu_id].last_batch_size;
   gpu_comm_data_[gpu_id].last_batch_size = batch_size;
@@ -168,21 +190,49 @@ void DataDistributor::distribute(int gpu_id, const std::vector<core23::Tensor>&
     compute_dp_bucket_range_operators_[gpu_id](fixed_dp_bucket_range_[gpu_id],
                                                output[0].num_keys_per_bucket, batch_size, stream);
 
-    // Instead of recomputing for each group, copy computed result
-    for (size_t grouped_id = 1; grouped_id < ebc_param_.grouped_lookup_params.size();
-         ++grouped_id) {
-      HCTR_LIB_THROW(cudaMemcpyAsync(
-          output[grouped_id].num_keys_per_bucket.data(), output[0].num_keys_per_bucket.data(),
-          output[0].num_keys_per_bucket.num_bytes(), cudaMemcpyDeviceToDevice, stream));
+    // Instead of recomputing for each group, fan the computed result out to the other groups
+    // with a single fused copy
+    if (ebc_param_.grouped_lookup_params.size() > 1) {
+      std::vector<void*> dst_ptrs;
+      std::vector<const void*> src_ptrs;
+      std::vector<int64_t> num_bytes;
+      for (size_t grouped_id = 1; grouped_id < ebc_param_.grouped_lookup_params.size();
+           ++grouped_id) {
+        dst_ptrs.push_back(output[grouped_id].num_keys_per_bucket.data());
+        src_ptrs.push_back(output[0].num_keys_per_bucket.data());
+        num_bytes.push_back(output[0].num_keys_per_bucket.num_bytes());
+      }
+      core23::batched_copy_async(dst_ptrs.data(), src_ptrs.data(), num_bytes.data(),
+                                 static_cast<int64_t>(dst_ptrs.size()),
+                                 core23::Device(core23::DeviceType::GPU, core->get_device_id()),
+                                 stream);
     }
   }
 
   data_distribution_input_[gpu_id].copy_tensor_vec(dp_keys, fixed_dp_bucket_range_[gpu_id], stream);
 
+  if (!key_freq_sketches_.empty()) {
+    for (size_t lookup_id = 0; lookup_id < dp_keys.size(); ++lookup_id) {
+      key_freq_sketches_[gpu_id]->accumulate(dp_keys[lookup_id],
+                                             dp_keys[lookup_id].num_elements(),
+                                             feature_id_to_table_id_map_[lookup_id], stream);
+    }
+  }
+
   for (size_t grouped_id = 0; grouped_id < ebc_param_.grouped_lookup_params.size(); grouped_id++) {
     data_distribution_ops_[grouped_id][gpu_id]->distribute(data_distribution_input_[gpu_id],
                                                            output[grouped_id], batch_size, stream);
   }
+
+  HCTR_LIB_THROW(cudaEventRecord(gpu_comm_data_[gpu_id].join_event, stream));
+  HCTR_LIB_THROW(cudaStreamWaitEvent(compute_stream, gpu_comm_data_[gpu_id].join_event));
+}
+
+void DataDistributor::dump_key_frequency(const std::string& prefix) {
+  for (size_t gpu_id = 0; gpu_id < key_freq_sketches_.size(); ++gpu_id) {
+    int global_gpu_id = core_resource_managers_[gpu_id]->get_global_gpu_id();
+    key_freq_sketches_[gpu_id]->dump(prefix + ".gpu" + std::to_string(global_gpu_id));
+  }
 }
 
 DataDistributor::Result allocate_output_for_data_distributor(
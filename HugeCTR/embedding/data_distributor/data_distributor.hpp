@@ -22,6 +22,7 @@
 #include <embedding/data_distributor/data_compression_operators.hpp>
 #include <embedding/data_distributor/data_distribution_op.hpp>
 #include <embedding/data_distributor/key_filtering_operators.hpp>
+#include <embedding/data_distributor/key_frequency_sketch.hpp>
 #include <embedding/operators/compress_offset.hpp>
 #include <embedding/operators/dp_index_calculation.hpp>
 #include <embedding/operators/keys_to_indices.hpp>
@@ -45,12 +46,22 @@ class DataDistributor {
                   const std::vector<core23::Tensor>& dp_bucket_range, Result& output,
                   int batch_size);
 
+  /**
+   * Dump the per-table key-frequency estimates collected during training, one
+   * file per GPU (prefix + ".gpu<global_gpu_id>"). No-op unless the sketch is
+   * enabled via HCTR_KEY_FREQ_SKETCH=1.
+   */
+  void dump_key_frequency(const std::string& prefix);
+
  private:
   struct GpuCommData {
     // This is a performance optimization to prevent us from computing bucket ranges each iteration.
     // If the current_batch_size == last_batch_size then the bucket_ranges are the same.
     int last_batch_size;
     core23::Tensor hotness_bucket_range;
+    // order the high-priority distribution stream against the compute stream
+    cudaEvent_t fork_event;
+    cudaEvent_t join_event;
   };
 
   void init_comm_data();
@@ -70,6 +81,9 @@ class DataDistributor {
   // Key Filtering (MP)
   std::vector<ComputeDPBucketRangeOperator> compute_dp_bucket_range_operators_;
 
+  // optional sampled key-popularity statistics, one sketch per local GPU
+  std::vector<std::unique_ptr<KeyFrequencySketch>> key_freq_sketches_;
+
   std::vector<std::vector<core23::Tensor>> fixed_dp_bucket_range_;
 
   size_t batch_size_;
@@ -17,6 +17,7 @@
 #include <HugeCTR/embedding/common.hpp>
 #include <HugeCTR/include/utils.cuh>
 #include <HugeCTR/include/utils.hpp>
+#include <algorithm>
 #include <embedding/data_distributor/data_compression_operators.cuh>
 #include <embedding/data_distributor/data_distribution_op.hpp>
 #include <embedding/operators/communication.hpp>
@@ -72,6 +73,43 @@ std::vector<int> calc_local_lookup_id_to_global_lookup_ids(
   return local_lookup_id_to_global_lookup_ids;
 }
 
+namespace {
+
+template <typename KeyType, typename LaneType>
+__global__ void pack_keys_kernel(const KeyType* keys, LaneType* packed, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP_T(size_t, i, num_keys) { packed[i] = static_cast<LaneType>(keys[i]); }
+}
+
+template <typename KeyType, typename LaneType>
+__global__ void unpack_keys_kernel(const LaneType* packed, KeyType* keys, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP_T(size_t, i, num_keys) { keys[i] = static_cast<KeyType>(packed[i]); }
+}
+
+// Narrowest lane that can carry every key of every table in this group, derived
+// from the table vocabularies (keys are table-local ids in [0, vocabulary)).
+// Returns 0 when some table is dynamic (-1) or needs the full key type.
+int negotiate_key_lane_bytes(const embedding::EmbeddingCollectionParam& ebc_param, size_t group_id,
+                             const std::vector<embedding::EmbeddingTableParam>& table_params) {
+  int64_t max_vocabulary_size = 0;
+  for (int lookup_id : ebc_param.grouped_lookup_params[group_id].lookup_ids) {
+    int table_id = ebc_param.lookup_params[lookup_id].table_id;
+    auto iter = std::find_if(table_params.begin(), table_params.end(),
+                             [&](const auto& param) { return param.table_id == table_id; });
+    if (iter == table_params.end() || iter->max_vocabulary_size < 0) return 0;
+    max_vocabulary_size = std::max(max_vocabulary_size, iter->max_vocabulary_size);
+  }
+
+  int lane_bytes = 0;
+  if (max_vocabulary_size <= (1l << 16)) {
+    lane_bytes = sizeof(uint16_t);
+  } else if (max_vocabulary_size <= (1l << 32)) {
+    lane_bytes = sizeof(uint32_t);
+  }
+  return lane_bytes < static_cast<int>(ebc_param.key_type.size()) ? lane_bytes : 0;
+}
+
+}  // namespace
+
 DenseMPDataDistributionOp::DenseMPTempStorage::DenseMPTempStorage(
     std::shared_ptr<core::CoreResourceManager> core,
     const embedding::EmbeddingCollectionParam& ebc_param, size_t group_id) {
@@ -145,6 +183,19 @@ DenseMPDataDistributionOp::DenseMPDataDistributionOp(
 
   partition_and_unique_operator_.init_hash_table_for_unique(core, ebc_param_.key_type);
 
+  key_lane_bytes_ = negotiate_key_lane_bytes(ebc_param_, group_id, emb_table_param_list);
+  if (key_lane_bytes_ > 0) {
+    core23::Device device(core23::DeviceType::GPU, core->get_device_id());
+    core23::TensorParams params =
+        core23::TensorParams().device(device).data_type(core23::ScalarType::UInt8);
+    int64_t num_send_elements =
+        dense_temp_storage_.partitioned_data_after_shard_matrix_partition.partitioned_keys
+            .num_elements();
+    int64_t num_recv_elements = dense_temp_storage_.keys_gpu_major.num_elements();
+    packed_keys_send_ = core23::Tensor(params.shape({num_send_elements * key_lane_bytes_}));
+    packed_keys_recv_ = core23::Tensor(params.shape({num_recv_elements * key_lane_bytes_}));
+  }
+
   if (ebc_param_.keys_preprocess_strategy_ == embedding::KeysPreprocessStrategy::AddOffset) {
     indices_converter_ = std::make_unique<embedding::KeysToIndicesConverter>(
         core, emb_table_param_list, ebc_param_, group_id);
@@ -160,7 +211,7 @@ void DenseMPDataDistributionOp::distribute(const DataDistributionInput& input,
   all2all_keys(output, stream);
   // get the final unique lookup keys
   filter_after_all2all(output, stream);
-  convert_indices(output);
+  convert_indices(output, stream);
 }
 
 void DenseMPDataDistributionOp::filter_before_all2all(const DataDistributionInput& input,
@@ -257,7 +308,25 @@ void DenseMPDataDistributionOp::all2all_keys(embedding::EmbeddingInput& output,
 
   size_t max_num_key_per_partition =
       dense_temp_storage_.partitioned_data_after_shard_matrix_partition.max_num_key_per_partition;
+  constexpr int block_size = 256;
   DISPATCH_INTEGRAL_FUNCTION_CORE23(send_keys.data_type().type(), KeyType, [&] {
+    if (key_lane_bytes_ > 0) {
+      // Pack the whole send buffer into narrow lanes; the garbage tails past each
+      // partition's valid count are packed too but never sent.
+      size_t num_send_elements = send_keys.num_elements();
+      int grid_size = (num_send_elements + block_size - 1) / block_size;
+      if (key_lane_bytes_ == static_cast<int>(sizeof(uint16_t))) {
+        pack_keys_kernel<<<grid_size, block_size, 0, stream>>>(
+            send_keys.data<KeyType>(), reinterpret_cast<uint16_t*>(packed_keys_send_.data()),
+            num_send_elements);
+      } else {
+        pack_keys_kernel<<<grid_size, block_size, 0, stream>>>(
+            send_keys.data<KeyType>(), reinterpret_cast<uint32_t*>(packed_keys_send_.data()),
+            num_send_elements);
+      }
+      HCTR_LIB_THROW(cudaPeekAtLastError());
+    }
+
     DISPATCH_INTEGRAL_FUNCTION_CORE23(d_send_k_per_g.data_type().type(), BucketRangeType, [&] {
       ncclGroupStart();
       for (size_t peer = 0; peer < num_global_gpus_; ++peer) {
@@ -267,15 +336,29 @@ void DenseMPDataDistributionOp::all2all_keys(embedding::EmbeddingInput& output,
         //        core->get_global_gpu_id(),
         //               (int)peer, (int)send_num_keys, (int)recv_num_keys);
         if (send_num_keys > 0) {
-          HCTR_LIB_THROW(ncclSend(send_keys.data<KeyType>() + peer * max_num_key_per_partition,
-                                  send_num_keys, key_nccl_type, peer, core_->get_nccl(), stream));
+          if (key_lane_bytes_ > 0) {
+            HCTR_LIB_THROW(ncclSend(packed_keys_send_.data<uint8_t>() +
+                                        peer * max_num_key_per_partition * key_lane_bytes_,
+                                    send_num_keys * key_lane_bytes_, ncclUint8, peer,
+                                    core_->get_nccl(), stream));
+          } else {
+            HCTR_LIB_THROW(ncclSend(send_keys.data<KeyType>() + peer * max_num_key_per_partition,
+                                    send_num_keys, key_nccl_type, peer, core_->get_nccl(), stream));
+          }
           HCTR_LIB_THROW(ncclSend(send_feature_ids.data<int>() + peer * max_num_key_per_partition,
                                   send_num_keys, feature_id_nccl_type, peer, core_->get_nccl(),
                                   stream));
         }
         if (recv_num_keys > 0) {
-          HCTR_LIB_THROW(ncclRecv(recv_keys.data<KeyType>() + recv_offset, recv_num_keys,
-                                  key_nccl_type, peer, core_->get_nccl(), stream));
+          if (key_lane_bytes_ > 0) {
+            HCTR_LIB_THROW(ncclRecv(packed_keys_recv_.data<uint8_t>() +
+                                        recv_offset * key_lane_bytes_,
+                                    recv_num_keys * key_lane_bytes_, ncclUint8, peer,
+                                    core_->get_nccl(), stream));
+          } else {
+            HCTR_LIB_THROW(ncclRecv(recv_keys.data<KeyType>() + recv_offset, recv_num_keys,
+                                    key_nccl_type, peer, core_->get_nccl(), stream));
+          }
           HCTR_LIB_THROW(ncclRecv(recv_feature_ids.data<int>() + recv_offset, recv_num_keys,
                                   feature_id_nccl_type, peer, core_->get_nccl(), stream));
         }
@@ -284,6 +367,21 @@ void DenseMPDataDistributionOp::all2all_keys(embedding::EmbeddingInput& output,
       }
       ncclGroupEnd();
     });
+
+    if (key_lane_bytes_ > 0 && recv_offset > 0) {
+      // Widen the received lanes back to the key type the downstream filtering expects.
+      int grid_size = (recv_offset + block_size - 1) / block_size;
+      if (key_lane_bytes_ == static_cast<int>(sizeof(uint16_t))) {
+        unpack_keys_kernel<<<grid_size, block_size, 0, stream>>>(
+            reinterpret_cast<const uint16_t*>(packed_keys_recv_.data()), recv_keys.data<KeyType>(),
+            recv_offset);
+      } else {
+        unpack_keys_kernel<<<grid_size, block_size, 0, stream>>>(
+            reinterpret_cast<const uint32_t*>(packed_keys_recv_.data()), recv_keys.data<KeyType>(),
+            recv_offset);
+      }
+      HCTR_LIB_THROW(cudaPeekAtLastError());
+    }
   });
 
   output.dense_compression_input.model_parallel_compression_input.num_model_reverse_idx =
@@ -323,11 +421,12 @@ void DenseMPDataDistributionOp::filter_after_all2all(embedding::EmbeddingInput&
   output.h_num_keys = *(output.num_keys.data<uint64_t>());
 }
 
-void DenseMPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output) {
+void DenseMPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output,
+                                                cudaStream_t stream) {
   if (ebc_param_.keys_preprocess_strategy_ == embedding::KeysPreprocessStrategy::None) return;
 
   indices_converter_->convert(output.keys, output.h_num_keys,
                               output.dense_compression_input.num_keys_per_table_offset,
-                              output.dense_compression_input.table_ids);
+                              output.dense_compression_input.table_ids, stream);
 }
 }  // namespace HugeCTR
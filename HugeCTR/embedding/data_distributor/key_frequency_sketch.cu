@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <HugeCTR/include/utils.cuh>
+#include <algorithm>
+#include <core23/registry.hpp>
+#include <cstdlib>
+#include <embedding/data_distributor/key_frequency_sketch.hpp>
+#include <io/filesystem.hpp>
+#include <sstream>
+#include <utils.hpp>
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr int kSketchDepth = 4;
+constexpr int kMaxSlotProbes = 32;
+
+DEVICE_INLINE uint64_t splitmix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+template <typename key_t>
+__global__ void key_frequency_sketch_accumulate_kernel(const key_t* keys, size_t num_keys,
+                                                       int table_id, uint32_t sample_mask,
+                                                       uint32_t width_mask, uint32_t* cm_counters,
+                                                       uint32_t min_count,
+                                                       unsigned long long* slot_keys,
+                                                       uint32_t* slot_counts,
+                                                       int64_t slots_per_table) {
+  CUDA_1D_KERNEL_LOOP(tid, num_keys) {
+    uint64_t key = static_cast<uint64_t>(keys[tid]);
+    uint64_t h = splitmix64(key ^ (static_cast<uint64_t>(table_id) * 0xc2b2ae3d27d4eb4full));
+    if ((h & sample_mask) != 0) continue;
+
+    uint32_t estimate = std::numeric_limits<uint32_t>::max();
+    for (int row = 0; row < kSketchDepth; ++row) {
+      uint32_t idx = static_cast<uint32_t>(splitmix64(h + row)) & width_mask;
+      uint32_t old = atomicAdd(cm_counters + static_cast<size_t>(row) * (width_mask + 1) + idx, 1u);
+      estimate = min(estimate, old + 1);
+    }
+    if (estimate < min_count) continue;
+
+    // open-addressed heavy-hitter candidates; keys are stored +1 so 0 is empty
+    unsigned long long* table_slot_keys = slot_keys + table_id * slots_per_table;
+    uint32_t* table_slot_counts = slot_counts + table_id * slots_per_table;
+    int64_t probe = static_cast<int64_t>(splitmix64(h ^ 0xff51afd7ed558ccdull) % slots_per_table);
+    for (int i = 0; i < kMaxSlotProbes; ++i) {
+      unsigned long long stored =
+          atomicCAS(table_slot_keys + probe, 0ull, static_cast<unsigned long long>(key) + 1);
+      if (stored == 0ull || stored == static_cast<unsigned long long>(key) + 1) {
+        atomicMax(table_slot_counts + probe, estimate);
+        break;
+      }
+      probe = (probe + 1) % slots_per_table;
+    }
+  }
+}
+
+uint32_t env_pow2_or_default(const char* name, uint32_t default_value) {
+  const char* const env = std::getenv(name);
+  if (env == nullptr) return default_value;
+  uint32_t v = static_cast<uint32_t>(std::atoll(env));
+  if (v == 0 || (v & (v - 1)) != 0) {
+    HCTR_LOG_S(WARNING, ROOT) << name << " must be a power of two, using " << default_value
+                              << std::endl;
+    return default_value;
+  }
+  return v;
+}
+
+}  // namespace
+
+KeyFrequencySketch::KeyFrequencySketch(std::shared_ptr<core::CoreResourceManager> core,
+                                       int num_tables)
+    : core_(core), num_tables_(num_tables) {
+  CudaDeviceContext context(core_->get_device_id());
+
+  uint32_t width = env_pow2_or_default("HCTR_KEY_FREQ_SKETCH_WIDTH", 1u << 22);
+  uint32_t sample_rate = env_pow2_or_default("HCTR_KEY_FREQ_SKETCH_SAMPLE", 16);
+  width_mask_ = width - 1;
+  sample_mask_ = sample_rate - 1;
+
+  const char* const min_count_env = std::getenv("HCTR_KEY_FREQ_SKETCH_MIN_COUNT");
+  min_count_ = min_count_env != nullptr ? static_cast<uint32_t>(std::atoll(min_count_env)) : 8;
+
+  const char* const top_k_env = std::getenv("HCTR_KEY_FREQ_SKETCH_TOPK");
+  top_k_ = top_k_env != nullptr ? std::atoll(top_k_env) : 4096;
+  // extra candidate head-room so near-ties are not evicted by probe collisions
+  slots_per_table_ = 4 * top_k_;
+
+  core23::Device device(core23::DeviceType::GPU, core_->get_device_id());
+  core23::TensorParams params = core23::TensorParams().device(device);
+
+  cm_counters_ = core23::Tensor(params.shape({static_cast<int64_t>(kSketchDepth) * width})
+                                    .data_type(core23::ScalarType::UInt32));
+  slot_keys_ = core23::Tensor(params.shape({num_tables_ * slots_per_table_})
+                                  .data_type(core23::ScalarType::UInt64));
+  slot_counts_ = core23::Tensor(params.shape({num_tables_ * slots_per_table_})
+                                    .data_type(core23::ScalarType::UInt32));
+  HCTR_LIB_THROW(cudaMemset(cm_counters_.data(), 0, cm_counters_.num_bytes()));
+  HCTR_LIB_THROW(cudaMemset(slot_keys_.data(), 0, slot_keys_.num_bytes()));
+  HCTR_LIB_THROW(cudaMemset(slot_counts_.data(), 0, slot_counts_.num_bytes()));
+
+  HCTR_LOG_S(INFO, ROOT) << "Key-frequency sketch enabled: width " << width << ", 1/" << sample_rate
+                         << " sampling, top-" << top_k_ << " per table" << std::endl;
+}
+
+void KeyFrequencySketch::accumulate(const core23::Tensor& keys, size_t num_keys, int table_id,
+                                    cudaStream_t stream) {
+  if (num_keys == 0) return;
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(keys.data_type().type(), key_t, [&] {
+    constexpr int block_size = 256;
+    int grid_size = (num_keys - 1) / block_size + 1;
+    key_frequency_sketch_accumulate_kernel<<<grid_size, block_size, 0, stream>>>(
+        keys.data<key_t>(), num_keys, table_id, sample_mask_, width_mask_,
+        cm_counters_.data<uint32_t>(), min_count_,
+        static_cast<unsigned long long*>(slot_keys_.data()), slot_counts_.data<uint32_t>(),
+        slots_per_table_);
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+  });
+}
+
+void KeyFrequencySketch::dump(const std::string& file_path) {
+  CudaDeviceContext context(core_->get_device_id());
+
+  std::vector<uint64_t> h_slot_keys(slot_keys_.num_elements());
+  std::vector<uint32_t> h_slot_counts(slot_counts_.num_elements());
+  HCTR_LIB_THROW(cudaMemcpy(h_slot_keys.data(), slot_keys_.data(), slot_keys_.num_bytes(),
+                            cudaMemcpyDeviceToHost));
+  HCTR_LIB_THROW(cudaMemcpy(h_slot_counts.data(), slot_counts_.data(), slot_counts_.num_bytes(),
+                            cudaMemcpyDeviceToHost));
+
+  std::ostringstream os;
+  for (int table_id = 0; table_id < num_tables_; ++table_id) {
+    std::vector<std::pair<uint32_t, uint64_t>> candidates;
+    for (int64_t i = 0; i < slots_per_table_; ++i) {
+      int64_t slot = table_id * slots_per_table_ + i;
+      if (h_slot_keys[slot] == 0) continue;
+      candidates.emplace_back(h_slot_counts[slot], h_slot_keys[slot] - 1);
+    }
+    int64_t num_report = std::min<int64_t>(top_k_, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + num_report, candidates.end(),
+                      std::greater<>());
+    for (int64_t i = 0; i < num_report; ++i) {
+      os << table_id << "\t" << candidates[i].second << "\t" << candidates[i].first << "\n";
+    }
+  }
+
+  std::string report = os.str();
+  auto fs = FileSystemBuilder::build_unique_by_path(file_path);
+  fs->write(file_path, report.c_str(), report.length(), true);
+  HCTR_LOG_S(INFO, ROOT) << "Dumped key-frequency sketch to " << file_path << std::endl;
+}
+
+}  // namespace HugeCTR
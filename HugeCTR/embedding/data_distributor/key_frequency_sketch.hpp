@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <core/core.hpp>
+#include <core23/tensor.hpp>
+#include <string>
+
+namespace HugeCTR {
+
+/**
+ * @brief Device-side sampled key-frequency sketch for cache capacity planning.
+ *
+ * Accumulates per-table key popularity during training with a count-min sketch
+ * (shared across tables, the table id is folded into the hash) plus a
+ * fixed-size per-table heavy-hitter candidate set. Keys are sampled by hash so
+ * the counters are in units of sampled occurrences; relative ordering is what
+ * cache sizing needs. The candidate set is an open-addressed key/count array
+ * updated with the count-min estimate; the exact top-K is selected on the host
+ * at dump time, which keeps the device path free of a concurrent heap.
+ *
+ * Enabled via HCTR_KEY_FREQ_SKETCH=1. Tuning knobs:
+ *   HCTR_KEY_FREQ_SKETCH_WIDTH      counters per count-min row (default 1<<22)
+ *   HCTR_KEY_FREQ_SKETCH_TOPK       heavy hitters reported per table (default 4096)
+ *   HCTR_KEY_FREQ_SKETCH_SAMPLE     sample 1-in-N keys, power of two (default 16)
+ *   HCTR_KEY_FREQ_SKETCH_MIN_COUNT  estimate needed to enter the candidate set
+ *                                   (default 8)
+ */
+class KeyFrequencySketch {
+ public:
+  KeyFrequencySketch(std::shared_ptr<core::CoreResourceManager> core, int num_tables);
+
+  /**
+   * Fold one lookup's keys for this iteration into the sketch.
+   */
+  void accumulate(const core23::Tensor& keys, size_t num_keys, int table_id, cudaStream_t stream);
+
+  /**
+   * Write the per-table top-K estimates to file_path as
+   * "table_id<tab>key<tab>sampled_count" lines, sorted by count within a table.
+   */
+  void dump(const std::string& file_path);
+
+ private:
+  std::shared_ptr<core::CoreResourceManager> core_;
+  int num_tables_;
+  uint32_t width_mask_;
+  uint32_t sample_mask_;
+  uint32_t min_count_;
+  int64_t top_k_;
+  int64_t slots_per_table_;
+
+  core23::Tensor cm_counters_;   // uint32, depth * width
+  core23::Tensor slot_keys_;     // uint64, num_tables * slots_per_table, 0 == empty
+  core23::Tensor slot_counts_;   // uint32, num_tables * slots_per_table
+};
+
+}  // namespace HugeCTR
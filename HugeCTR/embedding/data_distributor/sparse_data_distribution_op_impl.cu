@@ -35,18 +35,14 @@ SparseDPDataDistributionOp::SparseDPDataDistributionOp(
     indices_converter_ = std::make_unique<embedding::KeysToIndicesConverter>(
         core, emb_table_param_list, ebc_param_, group_id);
 
-    std::vector<int> h_local_lookup_id_list;
     std::vector<int> h_local_table_id_list;
 
     for (int lookup_id = 0; lookup_id < ebc_param_.num_lookup; ++lookup_id) {
       if (!ebc_param_.has_table_shard(core->get_global_gpu_id(), group_id, lookup_id)) continue;
       int table_id = ebc_param_.lookup_params[lookup_id].table_id;
 
-      h_local_lookup_id_list.push_back(lookup_id);
       h_local_table_id_list.push_back(table_id);
     }
-    compress_offset_ = std::make_unique<embedding::CompressOffset>(
-        core, h_local_lookup_id_list.size() + 1, ebc_param_.offset_type);
 
     core23::Device device(core23::DeviceType::GPU, core->get_device_id());
     core23::TensorParams params = core23::TensorParams().device(device);
@@ -74,16 +70,18 @@ void SparseDPDataDistributionOp::distribute(const DataDistributionInput& input,
     output.h_num_keys = num_keys;
   });
 
-  convert_indices(output);
+  convert_indices(output, stream);
 }
 
-void SparseDPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output) {
+void SparseDPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output,
+                                                cudaStream_t stream) {
   if (ebc_param_.keys_preprocess_strategy_ == embedding::KeysPreprocessStrategy::None) return;
-  core23::Tensor num_keys_per_lookup_offset;
-  compress_offset_->compute(output.bucket_range, batch_size_per_gpu_, &num_keys_per_lookup_offset);
-
-  indices_converter_->convert(output.keys, output.h_num_keys, num_keys_per_lookup_offset,
-                              d_local_table_ids_);
+  // the per-lookup offsets are every batch_size_per_gpu_-th bucket_range entry; let the
+  // converter binary-search that strided view instead of gathering a compressed copy first
+  indices_converter_->convert(output.keys, output.h_num_keys, output.bucket_range,
+                              batch_size_per_gpu_,
+                              static_cast<int>(d_local_table_ids_.num_elements()),
+                              d_local_table_ids_, stream);
 }
 
 SparseMPDataDistributionOp::MPTempStorage::MPTempStorage(
@@ -188,18 +186,14 @@ SparseMPDataDistributionOp::SparseMPDataDistributionOp(
     indices_converter_ = std::make_unique<embedding::KeysToIndicesConverter>(
         core, emb_table_param_list, ebc_param_, group_id);
 
-    std::vector<int> h_local_lookup_id_list;
     std::vector<int> h_local_table_id_list;
 
     for (int lookup_id = 0; lookup_id < ebc_param_.num_lookup; ++lookup_id) {
       if (!ebc_param_.has_table_shard(core->get_global_gpu_id(), group_id, lookup_id)) continue;
       int table_id = ebc_param_.lookup_params[lookup_id].table_id;
 
-      h_local_lookup_id_list.push_back(lookup_id);
       h_local_table_id_list.push_back(table_id);
     }
-    compress_offset_ = std::make_unique<embedding::CompressOffset>(
-        core, h_local_lookup_id_list.size() + 1, ebc_param_.offset_type);
 
     core23::Device device(core23::DeviceType::GPU, core->get_device_id());
     core23::TensorParams params = core23::TensorParams().device(device);
@@ -218,7 +212,7 @@ void SparseMPDataDistributionOp::distribute(const DataDistributionInput& input,
   all2all_keys_per_bucket(output, stream);
   all2all_keys(output, stream);
   filter_after_all2all(output, stream);
-  convert_indices(output);
+  convert_indices(output, stream);
 }
 
 void SparseMPDataDistributionOp::filter_before_all2all(const DataDistributionInput& input,
@@ -382,14 +376,15 @@ void SparseMPDataDistributionOp::filter_after_all2all(embedding::EmbeddingInput&
   }
 }
 
-void SparseMPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output) {
+void SparseMPDataDistributionOp::convert_indices(embedding::EmbeddingInput& output,
+                                                cudaStream_t stream) {
   if (ebc_param_.keys_preprocess_strategy_ == embedding::KeysPreprocessStrategy::None) return;
   int batch_size = batch_size_per_gpu_ * num_global_gpus_;
 
-  core23::Tensor num_keys_per_lookup_offset;
-  compress_offset_->compute(output.bucket_range, batch_size, &num_keys_per_lookup_offset);
-
-  indices_converter_->convert(output.keys, output.h_num_keys, num_keys_per_lookup_offset,
-                              d_local_table_ids_);
+  // the per-lookup offsets are every batch_size-th bucket_range entry; let the converter
+  // binary-search that strided view instead of gathering a compressed copy first
+  indices_converter_->convert(output.keys, output.h_num_keys, output.bucket_range, batch_size,
+                              static_cast<int>(d_local_table_ids_.num_elements()),
+                              d_local_table_ids_, stream);
 }
 }  // namespace HugeCTR
@@ -125,7 +125,8 @@ void UniformDataParallelEmbeddingMeta::update_mutable_meta(
 }
 
 UniformDPEmbedding::UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core,
-                                       const EmbeddingCollectionParam& params, size_t grouped_id)
+                                       const EmbeddingCollectionParam& params, size_t grouped_id,
+                                       const std::vector<EmbeddingTableParam>& emb_table_param_list)
     : core_(core), meta_(core, params, grouped_id) {
   HugeCTR::CudaDeviceContext context(core->get_device_id());
 
@@ -137,6 +138,12 @@ UniformDPEmbedding::UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core
 
   // init op
   compress_offset_ = CompressOffset(core_, meta_.num_local_lookup_ + 1, offset_type);
+  if (SortedLookup::enabled()) {
+    sorted_lookup_ = SortedLookup(
+        core_, key_type,
+        static_cast<size_t>(universal_batch_size / num_gpus) * meta_.num_local_hotness_,
+        meta_.num_local_lookup_);
+  }
 
   dp_model_forward_ = DPModelForward(core_);
 
@@ -169,9 +176,10 @@ UniformDPEmbedding::UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core
   SegmentdUnique segmented_unique{core, meta_.num_local_hotness_, universal_batch_size / num_gpus};
   CalDstOffsetMP cal_dst_offset_mp{core, meta_.num_local_hotness_, universal_batch_size / num_gpus};
   SortKeyAndSrcIdOp sort_op;
+  SortBitRange sort_bit_range = cal_sort_bit_range(emb_table_param_list);
   if (params.sort_strategy_ == SortStrategy::Radix) {
     IndicesSort indices_sort{core, meta_.num_local_hotness_, params.universal_batch_size / num_gpus,
-                             key_type};
+                             key_type, sort_bit_range.indices_end_bit};
     sort_op = indices_sort;
   } else if (params.sort_strategy_ == SortStrategy::Segmented) {
     SegmentedSortDevice segmented_sort{core,
@@ -180,7 +188,8 @@ UniformDPEmbedding::UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core
                                        params.universal_batch_size / num_gpus,
                                        meta_.wgrad_attr.num_lookup,
                                        meta_.wgrad_attr.num_table,
-                                       key_type};
+                                       key_type,
+                                       sort_bit_range.key_end_bit};
     sort_op = segmented_sort;
   } else {
     HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall, "sort strategy not supported.");
@@ -188,6 +197,17 @@ UniformDPEmbedding::UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core
 
   local_reduce_index_calculation_ = {core, local_reduce_index_calculation, sort_op, cal_dst_ids,
                                      segmented_unique};
+  const char* const cached_index_env = std::getenv("HCTR_DP_CACHED_INDEX");
+  if (cached_index_env != nullptr && 1 == std::atoi(cached_index_env)) {
+    if (meta_.wgrad_attr.is_same_ev_size) {
+      local_reduce_index_calculation_.cached_index_calculation_ =
+          std::make_shared<CachedIndexCalculation>(core, meta_.num_local_hotness_,
+                                                   universal_batch_size / num_gpus);
+    } else {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_DP_CACHED_INDEX ignored: dp grouped embedding has mixed ev sizes\n");
+    }
+  }
   local_reduce_.init(core, meta_.max_ev_size_,
                      meta_.num_local_hotness_ * (params.universal_batch_size / num_gpus));
 }
@@ -209,9 +229,15 @@ void UniformDPEmbedding::forward(const EmbeddingInput& embedding_input, ILookup*
   compress_offset_.compute(embedding_input.bucket_range, batch_size_per_gpu,
                            &num_key_per_lookup_offset);
 
-  embedding_table->lookup(embedding_input.keys, embedding_input.h_num_keys,
+  if (SortedLookup::enabled()) {
+    sorted_lookup_.lookup(embedding_table, embedding_input.keys, embedding_input.h_num_keys,
                           num_key_per_lookup_offset, meta_.num_local_lookup_ + 1,
                           meta_.d_local_table_id_list_, embedding_vec_);
+  } else {
+    embedding_table->lookup(embedding_input.keys, embedding_input.h_num_keys,
+                            num_key_per_lookup_offset, meta_.num_local_lookup_ + 1,
+                            meta_.d_local_table_id_list_, embedding_vec_);
+  }
   dp_model_forward_.sparse_forward(embedding_vec_, embedding_input.bucket_range,
                                    meta_.d_local_lookup_id_list_, embedding_output,
                                    batch_size_per_gpu);
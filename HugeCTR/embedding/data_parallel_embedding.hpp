@@ -22,6 +22,7 @@
 #include <embedding/operators/dp_index_calculation.hpp>
 #include <embedding/operators/model_backward.hpp>
 #include <embedding/operators/model_forward.hpp>
+#include <embedding/operators/sorted_lookup.hpp>
 
 namespace embedding {
 
@@ -73,6 +74,7 @@ class UniformDPEmbedding : public IGroupedEmbeddingOp {
   Wgrad local_reduce_buffer_;
 
   CompressOffset compress_offset_;
+  SortedLookup sorted_lookup_;
   DPModelForward dp_model_forward_;
   AverageCombiner average_combiner_;
 
@@ -93,7 +95,8 @@ class UniformDPEmbedding : public IGroupedEmbeddingOp {
 
  public:
   UniformDPEmbedding(std::shared_ptr<CoreResourceManager> core,
-                     const EmbeddingCollectionParam &params, size_t grouped_id);
+                     const EmbeddingCollectionParam &params, size_t grouped_id,
+                     const std::vector<EmbeddingTableParam> &emb_table_param_list = {});
 
   void forward_per_gpu(Stage stage, const EmbeddingInput &embedding_input, ILookup *embedding_table,
                        EmbeddingOutput &embedding_output, int batch_size) override;
@@ -22,7 +22,8 @@
 namespace embedding {
 
 std::vector<std::unique_ptr<IGroupedEmbeddingOp>> create_grouped_embeddings(
-    std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &ebc_param) {
+    std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &ebc_param,
+    const std::vector<EmbeddingTableParam> &emb_table_param_list) {
   std::vector<std::unique_ptr<IGroupedEmbeddingOp>> embeddings;
 
   for (size_t emb_id = 0; emb_id < ebc_param.grouped_lookup_params.size(); ++emb_id) {
@@ -34,14 +35,16 @@ std::vector<std::unique_ptr<IGroupedEmbeddingOp>> create_grouped_embeddings(
       embeddings.push_back(
           std::make_unique<DenseUniformModelParallelEmbedding>(core, ebc_param, emb_id));
     } else if (embedding_group_type == EmbeddingGroupType::DataParallel) {
-      embeddings.push_back(std::make_unique<UniformDPEmbedding>(core, ebc_param, emb_id));
+      embeddings.push_back(
+          std::make_unique<UniformDPEmbedding>(core, ebc_param, emb_id, emb_table_param_list));
     } else if (embedding_group_type == EmbeddingGroupType::SparseModelParallel &&
                comm_strategy == CommunicationStrategy::Uniform) {
-      embeddings.push_back(
-          std::make_unique<UniformModelParallelEmbedding>(core, ebc_param, emb_id));
+      embeddings.push_back(std::make_unique<UniformModelParallelEmbedding>(core, ebc_param, emb_id,
+                                                                           emb_table_param_list));
     } else if (embedding_group_type == EmbeddingGroupType::SparseModelParallel &&
                comm_strategy == CommunicationStrategy::Hierarchical) {
-      embeddings.push_back(std::make_unique<HierModelParallelEmbedding>(core, ebc_param, emb_id));
+      embeddings.push_back(std::make_unique<HierModelParallelEmbedding>(core, ebc_param, emb_id,
+                                                                        emb_table_param_list));
     } else {
       HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, "grouped embedding create fail.");
     }
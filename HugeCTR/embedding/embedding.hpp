@@ -16,6 +16,7 @@
 #pragma once
 
 #include <embedding/embedding_table.hpp>
+#include <embedding_storage/common.hpp>
 #include <vector>
 
 namespace embedding {
@@ -43,6 +44,12 @@ enum class Stage {
   MPNetworkBackward,
   MPLocalReduce,
 
+  // HCTR_PREFETCH_EMB_FORWARD=1: MPModelForward for the next batch, issued on the
+  // prefetch stream into a second model comm buffer while the current batch's dense
+  // network trains; the next iteration's MPModelForward swaps that buffer in
+  // instead of recomputing the lookup.
+  MPPrefetchModelForward,
+
   DenseMPModelForward,
   DenseMPNetworkForward,
   DenseMPBackwardIndexCalculation,
@@ -50,6 +57,61 @@ enum class Stage {
   DenseMPLocalReduce,
 };
 
+inline const char *to_string(Stage stage) {
+  switch (stage) {
+    case Stage::DPForward:
+      return "DPForward";
+    case Stage::DPBackwardIndexCalculation:
+      return "DPBackwardIndexCalculation";
+    case Stage::DPLocalReduce:
+      return "DPLocalReduce";
+    case Stage::DPAllreduce:
+      return "DPAllreduce";
+    case Stage::DenseDPForward:
+      return "DenseDPForward";
+    case Stage::DenseDPBackwardIndexCalculation:
+      return "DenseDPBackwardIndexCalculation";
+    case Stage::DenseDPLocalReduce:
+      return "DenseDPLocalReduce";
+    case Stage::DenseDPAllReduce:
+      return "DenseDPAllReduce";
+    case Stage::HierMPModelForward:
+      return "HierMPModelForward";
+    case Stage::HierMPNetworkForward:
+      return "HierMPNetworkForward";
+    case Stage::HierMPBackwardIndexCalculation:
+      return "HierMPBackwardIndexCalculation";
+    case Stage::HierMPNetworkBackward:
+      return "HierMPNetworkBackward";
+    case Stage::HierMPLocalReduce:
+      return "HierMPLocalReduce";
+    case Stage::MPModelForward:
+      return "MPModelForward";
+    case Stage::MPNetworkdForward:
+      return "MPNetworkForward";
+    case Stage::MPBackwardIndexCalculation:
+      return "MPBackwardIndexCalculation";
+    case Stage::MPNetworkBackward:
+      return "MPNetworkBackward";
+    case Stage::MPLocalReduce:
+      return "MPLocalReduce";
+    case Stage::MPPrefetchModelForward:
+      return "MPPrefetchModelForward";
+    case Stage::DenseMPModelForward:
+      return "DenseMPModelForward";
+    case Stage::DenseMPNetworkForward:
+      return "DenseMPNetworkForward";
+    case Stage::DenseMPBackwardIndexCalculation:
+      return "DenseMPBackwardIndexCalculation";
+    case Stage::DenseMPNetworkBackward:
+      return "DenseMPNetworkBackward";
+    case Stage::DenseMPLocalReduce:
+      return "DenseMPLocalReduce";
+    default:
+      return "UnknownStage";
+  }
+}
+
 class IGroupedEmbeddingOp {
  public:
   virtual ~IGroupedEmbeddingOp() = default;
@@ -67,6 +129,7 @@ class IGroupedEmbeddingOp {
 };
 
 std::vector<std::unique_ptr<IGroupedEmbeddingOp>> create_grouped_embeddings(
-    std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &ebc_param);
+    std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &ebc_param,
+    const std::vector<EmbeddingTableParam> &emb_table_param_list = {});
 
 }  // namespace embedding
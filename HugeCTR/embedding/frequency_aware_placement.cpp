@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <embedding/frequency_aware_placement.hpp>
+#include <limits>
+#include <utils.hpp>
+
+namespace embedding {
+
+void plan_frequency_aware_placement(const std::vector<TableFrequencyStats> &table_stats,
+                                    int num_gpus, const FrequencyAwarePlacementParam &param,
+                                    std::vector<GroupedTableParam> *grouped_table_params,
+                                    std::vector<std::vector<int>> *shard_matrix) {
+  HCTR_CHECK(num_gpus > 0);
+  HCTR_CHECK(grouped_table_params != nullptr && shard_matrix != nullptr);
+
+  int num_table = 0;
+  for (auto &stats : table_stats) {
+    HCTR_CHECK_HINT(stats.table_id >= 0, "plan_frequency_aware_placement: negative table_id");
+    num_table = std::max(num_table, stats.table_id + 1);
+  }
+  HCTR_CHECK_HINT(static_cast<size_t>(num_table) == table_stats.size(),
+                  "plan_frequency_aware_placement: table_ids must be dense in [0, num_table)");
+
+  // replicate the densest tables first: traffic removed from the all-to-all per
+  // float of HBM spent on every GPU
+  std::vector<int> order(table_stats.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = static_cast<int>(i);
+  }
+  auto replicated_capacity = [&](const TableFrequencyStats &stats) {
+    return stats.max_vocabulary_size * static_cast<size_t>(stats.ev_size);
+  };
+  std::sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+    const auto &l = table_stats[lhs];
+    const auto &r = table_stats[rhs];
+    return l.access_fraction * replicated_capacity(r) > r.access_fraction * replicated_capacity(l);
+  });
+
+  std::vector<int> dp_table_ids;
+  std::vector<int> mp_table_ids;
+  size_t budget = param.replication_budget_per_gpu;
+  for (int i : order) {
+    const auto &stats = table_stats[i];
+    size_t capacity = replicated_capacity(stats);
+    if (stats.access_fraction >= param.min_access_fraction && capacity <= budget) {
+      dp_table_ids.push_back(stats.table_id);
+      budget -= capacity;
+    } else {
+      mp_table_ids.push_back(stats.table_id);
+    }
+  }
+  std::sort(dp_table_ids.begin(), dp_table_ids.end());
+  std::sort(mp_table_ids.begin(), mp_table_ids.end());
+
+  grouped_table_params->clear();
+  if (!dp_table_ids.empty()) {
+    grouped_table_params->emplace_back(TablePlacementStrategy::DataParallel, dp_table_ids);
+  }
+  if (!mp_table_ids.empty()) {
+    grouped_table_params->emplace_back(TablePlacementStrategy::ModelParallel, mp_table_ids);
+  }
+
+  // replicated tables live on every GPU; the cold tail is sharded across all GPUs
+  shard_matrix->assign(num_gpus, std::vector<int>(num_table, 1));
+}
+
+void balance_shard_placement(const std::vector<TablePlacementStats> &table_stats, int num_gpus,
+                             const std::vector<GroupedTableParam> &grouped_table_params,
+                             std::vector<std::vector<int>> *shard_matrix) {
+  HCTR_CHECK(num_gpus > 0);
+  HCTR_CHECK(shard_matrix != nullptr);
+
+  int num_table = 0;
+  std::vector<const TablePlacementStats *> stats_by_id;
+  for (auto &stats : table_stats) {
+    HCTR_CHECK_HINT(stats.table_id >= 0, "balance_shard_placement: negative table_id");
+    num_table = std::max(num_table, stats.table_id + 1);
+  }
+  stats_by_id.assign(num_table, nullptr);
+  for (auto &stats : table_stats) {
+    stats_by_id[stats.table_id] = &stats;
+  }
+
+  shard_matrix->assign(num_gpus, std::vector<int>(num_table, 0));
+
+  for (auto &group : grouped_table_params) {
+    if (group.table_placement_strategy == TablePlacementStrategy::DataParallel) {
+      for (int table_id : group.table_ids) {
+        for (int gpu = 0; gpu < num_gpus; ++gpu) {
+          (*shard_matrix)[gpu][table_id] = 1;
+        }
+      }
+      continue;
+    }
+
+    auto mem_of = [&](int table_id) {
+      const TablePlacementStats *stats = stats_by_id[table_id];
+      return static_cast<double>(stats->max_vocabulary_size) * stats->ev_size;
+    };
+    auto load_of = [&](int table_id) {
+      const TablePlacementStats *stats = stats_by_id[table_id];
+      return stats->lookup_load * stats->ev_size;
+    };
+
+    double mem_target = 0.;
+    double load_target = 0.;
+    for (int table_id : group.table_ids) {
+      HCTR_CHECK_HINT(table_id >= 0 && table_id < num_table && stats_by_id[table_id] != nullptr,
+                      "balance_shard_placement: no stats for table ", table_id);
+      mem_target += mem_of(table_id);
+      load_target += load_of(table_id);
+    }
+    mem_target = std::max(mem_target / num_gpus, 1.);
+    load_target = std::max(load_target / num_gpus, 1.);
+
+    // Heaviest table first, by the bin dimension it stresses most.
+    std::vector<int> order = group.table_ids;
+    std::sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+      return std::max(mem_of(lhs) / mem_target, load_of(lhs) / load_target) >
+             std::max(mem_of(rhs) / mem_target, load_of(rhs) / load_target);
+    });
+
+    std::vector<double> gpu_mem(num_gpus, 0.);
+    std::vector<double> gpu_load(num_gpus, 0.);
+    for (int table_id : order) {
+      const double mem = mem_of(table_id);
+      const double load = load_of(table_id);
+
+      if (mem > 2. * mem_target && num_gpus > 1) {
+        // One table dominating the memory bin cannot be balanced whole; shard its rows.
+        for (int gpu = 0; gpu < num_gpus; ++gpu) {
+          (*shard_matrix)[gpu][table_id] = 1;
+          gpu_mem[gpu] += mem / num_gpus;
+          gpu_load[gpu] += load / num_gpus;
+        }
+        continue;
+      }
+
+      int best_gpu = 0;
+      double best_cost = std::numeric_limits<double>::max();
+      for (int gpu = 0; gpu < num_gpus; ++gpu) {
+        const double cost = std::max((gpu_mem[gpu] + mem) / mem_target,
+                                     (gpu_load[gpu] + load) / load_target);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_gpu = gpu;
+        }
+      }
+      (*shard_matrix)[best_gpu][table_id] = 1;
+      gpu_mem[best_gpu] += mem;
+      gpu_load[best_gpu] += load;
+    }
+  }
+}
+
+}  // namespace embedding
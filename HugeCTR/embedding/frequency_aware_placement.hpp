@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <embedding/common.hpp>
+#include <vector>
+
+namespace embedding {
+
+// Per-table access statistics, typically collected from a profiling pass over the
+// training data. access_fraction values of all tables are expected to sum to ~1.
+struct TableFrequencyStats {
+  int table_id;
+  size_t max_vocabulary_size;
+  int ev_size;
+  double access_fraction;  // fraction of all lookup traffic that hits this table
+};
+
+struct FrequencyAwarePlacementParam {
+  // Embedding-vector capacity budget (in number of floats) each GPU may spend on
+  // replicated tables. Replication trades HBM for all-to-all volume, so the budget
+  // bounds the HBM cost.
+  size_t replication_budget_per_gpu = 0;
+  // Tables whose traffic share is below this threshold are never replicated;
+  // the all-to-all savings would not pay for the allreduce they join.
+  double min_access_fraction = 0.01;
+};
+
+/**
+ * @brief Frequency-aware table placement for the embedding collection.
+ *
+ * Zipfian datasets concentrate most lookup traffic on a small set of hot tables
+ * (categorical features of low cardinality but high frequency). Such tables are
+ * placed DataParallel -- replicated on every GPU and trained through the existing
+ * allreduce path -- so their lookups leave the all-to-all entirely, while the cold,
+ * high-cardinality tail stays ModelParallel and sharded across all GPUs.
+ *
+ * Tables are replicated greedily by traffic density (access fraction per byte of
+ * replicated capacity) until the per-GPU budget is exhausted. The result is the
+ * grouped_table_params / shard_matrix pair consumed by EmbeddingCollectionParam.
+ */
+void plan_frequency_aware_placement(const std::vector<TableFrequencyStats> &table_stats,
+                                    int num_gpus, const FrequencyAwarePlacementParam &param,
+                                    std::vector<GroupedTableParam> *grouped_table_params,
+                                    std::vector<std::vector<int>> *shard_matrix);
+
+// Static per-table load figures used by balance_shard_placement. lookup_load is a relative
+// traffic weight for the table, e.g. the summed hotness of every lookup that hits it.
+struct TablePlacementStats {
+  int table_id;
+  size_t max_vocabulary_size;
+  int ev_size;
+  double lookup_load;
+};
+
+/**
+ * @brief Balance model-parallel tables across GPUs.
+ *
+ * Hand-made shard matrices routinely leave one GPU much hotter than the rest because lookup
+ * traffic and table size are balanced by eye. This planner re-derives the shard matrix for the
+ * given table grouping: DataParallel groups keep their replicated (all-ones) rows, while each
+ * ModelParallel group is bin-packed greedily, heaviest table first, onto the GPU whose worse of
+ * the two normalized bins (memory, lookup load) stays smallest. A table whose memory exceeds
+ * twice the per-GPU target is sharded row-wise across all GPUs instead of occupying one bin.
+ */
+void balance_shard_placement(const std::vector<TablePlacementStats> &table_stats, int num_gpus,
+                             const std::vector<GroupedTableParam> &grouped_table_params,
+                             std::vector<std::vector<int>> *shard_matrix);
+
+}  // namespace embedding
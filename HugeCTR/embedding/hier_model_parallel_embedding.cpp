@@ -124,9 +124,9 @@ void HierModelParallelEmbeddingMeta::update_mutable_meta(std::shared_ptr<CoreRes
   output_attr.update_mutable_data(core, ebc_param);
 }
 
-HierModelParallelEmbedding::HierModelParallelEmbedding(std::shared_ptr<CoreResourceManager> core,
-                                                       const EmbeddingCollectionParam &params,
-                                                       size_t grouped_id)
+HierModelParallelEmbedding::HierModelParallelEmbedding(
+    std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &params,
+    size_t grouped_id, const std::vector<EmbeddingTableParam> &emb_table_param_list)
     : core_(core),
       meta_(core, params, grouped_id),
       intra_model_comm_buffer_(core, meta_.intra_model_buffer_attr, params.universal_batch_size),
@@ -153,8 +153,10 @@ HierModelParallelEmbedding::HierModelParallelEmbedding(std::shared_ptr<CoreResou
   SegmentdUnique segmentd_unique{core, meta_.num_local_hotness_, params.universal_batch_size};
   CalDstOffsetMP cal_dst_offset_mp{core, meta_.num_local_hotness_, params.universal_batch_size};
   SortKeyAndSrcIdOp sort_op;
+  SortBitRange sort_bit_range = cal_sort_bit_range(emb_table_param_list);
   if (params.sort_strategy_ == SortStrategy::Radix) {
-    sort_op = IndicesSort{core, meta_.num_local_hotness_, params.universal_batch_size, key_type};
+    sort_op = IndicesSort{core, meta_.num_local_hotness_, params.universal_batch_size, key_type,
+                          sort_bit_range.indices_end_bit};
 
   } else if (params.sort_strategy_ == SortStrategy::Segmented) {
     sort_op = SegmentedSortDevice{core,
@@ -163,7 +165,8 @@ HierModelParallelEmbedding::HierModelParallelEmbedding(std::shared_ptr<CoreResou
                                   params.universal_batch_size,
                                   meta_.wgrad_attr.num_lookup,
                                   meta_.wgrad_attr.num_table,
-                                  key_type};
+                                  key_type,
+                                  sort_bit_range.key_end_bit};
   } else {
     HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall, "sort strategy not supported.");
   }
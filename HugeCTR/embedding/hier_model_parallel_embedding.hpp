@@ -95,7 +95,8 @@ class HierModelParallelEmbedding : public IGroupedEmbeddingOp {
 
  public:
   HierModelParallelEmbedding(std::shared_ptr<CoreResourceManager> core,
-                             const EmbeddingCollectionParam &params, size_t grouped_id);
+                             const EmbeddingCollectionParam &params, size_t grouped_id,
+                             const std::vector<EmbeddingTableParam> &emb_table_param_list = {});
 
   void forward_per_gpu(Stage stage, const EmbeddingInput &embedding_input, ILookup *embedding_table,
                        EmbeddingOutput &embedding_output, int batch_size) override;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <embedding/model_parallel_embedding.hpp>
 #include <utils.hpp>
 
@@ -161,12 +162,18 @@ void UniformModelParallelEmbeddingMeta::update_mutable_meta(
 
 UniformModelParallelEmbedding::UniformModelParallelEmbedding(
     std::shared_ptr<CoreResourceManager> core, const EmbeddingCollectionParam &params,
-    size_t grouped_id)
+    size_t grouped_id, const std::vector<EmbeddingTableParam> &emb_table_param_list)
     : core_(core), meta_(core, params, grouped_id) {
   HugeCTR::CudaDeviceContext context(core_->get_device_id());
   auto key_type = params.key_type;
 
   compress_offset_ = CompressOffset(core, meta_.num_local_lookup_ + 1, params.offset_type);
+  if (SortedLookup::enabled()) {
+    sorted_lookup_ =
+        SortedLookup(core, key_type,
+                     static_cast<size_t>(params.universal_batch_size) * meta_.num_local_hotness_,
+                     meta_.num_local_lookup_);
+  }
   model_forward_ = ModelForward{core};
   all2all_comm_ = NcclAll2AllComm(core);
   network_forward_ = NetworkForward(core);
@@ -179,8 +186,10 @@ UniformModelParallelEmbedding::UniformModelParallelEmbedding(
   CalDstIds cal_dst_ids{core, meta_.num_local_hotness_, params.universal_batch_size};
   SegmentdUnique segmented_unique{core, meta_.num_local_hotness_, params.universal_batch_size};
   CalDstOffsetMP cal_dst_offset_mp{core, meta_.num_local_hotness_, params.universal_batch_size};
+  SortBitRange sort_bit_range = cal_sort_bit_range(emb_table_param_list);
   if (params.sort_strategy_ == SortStrategy::Radix) {
-    IndicesSort indices_sort{core, meta_.num_local_hotness_, params.universal_batch_size, key_type};
+    IndicesSort indices_sort{core, meta_.num_local_hotness_, params.universal_batch_size, key_type,
+                             sort_bit_range.indices_end_bit};
     local_reduce_index_calculation_.init(core, local_reduce_index_calculation, indices_sort,
                                          cal_dst_ids, segmented_unique, cal_dst_offset_mp);
   } else if (params.sort_strategy_ == SortStrategy::Segmented) {
@@ -190,7 +199,8 @@ UniformModelParallelEmbedding::UniformModelParallelEmbedding(
                                        params.universal_batch_size,
                                        meta_.wgrad_attr.num_lookup,
                                        meta_.wgrad_attr.num_table,
-                                       key_type};
+                                       key_type,
+                                       sort_bit_range.key_end_bit};
     local_reduce_index_calculation_.init(core, local_reduce_index_calculation, segmented_sort,
                                          cal_dst_ids, segmented_unique, cal_dst_offset_mp);
   } else {
@@ -208,24 +218,56 @@ UniformModelParallelEmbedding::UniformModelParallelEmbedding(
 
   model_comm_buffer_.init(core, meta_.model_buffer_attr, params.universal_batch_size);
   network_buffer_.init(core, meta_.network_buffer_attr, params.universal_batch_size);
+
+  wire_compression_ = wire_compression_enabled(params.emb_type);
+  if (wire_compression_) {
+    model_wire_buffer_ = make_fp16_wire_buffer(core, model_comm_buffer_.data_list);
+    network_wire_buffer_ = make_fp16_wire_buffer(core, network_buffer_.data_list);
+  }
+
+  // opt-in (HCTR_PREFETCH_EMB_FORWARD=1) inter-batch pipelining: keep a second
+  // model comm buffer so the next batch's lookup can run on the prefetch stream
+  // while the current batch's dense network trains
+  static const bool prefetch_double_buffer = [] {
+    const char *env = std::getenv("HCTR_PREFETCH_EMB_FORWARD");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  prefetch_double_buffer_ = prefetch_double_buffer;
+  if (prefetch_double_buffer_) {
+    prefetch_model_comm_buffer_.init(core, meta_.model_buffer_attr, params.universal_batch_size);
+  }
 }
 
 void UniformModelParallelEmbedding::model_forward(const EmbeddingInput &embedding_input,
-                                                  ILookup *embedding_table, int batch_size) {
+                                                  ILookup *embedding_table, int batch_size,
+                                                  ModelCommBuffer &model_comm_buffer) {
   core23::Tensor num_key_per_lookup_offset;
   compress_offset_.compute(embedding_input.bucket_range, batch_size, &num_key_per_lookup_offset);
 
-  embedding_table->lookup(embedding_input.keys, embedding_input.h_num_keys,
+  if (SortedLookup::enabled()) {
+    sorted_lookup_.lookup(embedding_table, embedding_input.keys, embedding_input.h_num_keys,
                           num_key_per_lookup_offset, meta_.num_local_lookup_ + 1,
                           meta_.d_local_table_id_list_, embedding_vec_);
-  model_forward_.sparse_forward(embedding_vec_, embedding_input.bucket_range, model_comm_buffer_,
+  } else {
+    embedding_table->lookup(embedding_input.keys, embedding_input.h_num_keys,
+                            num_key_per_lookup_offset, meta_.num_local_lookup_ + 1,
+                            meta_.d_local_table_id_list_, embedding_vec_);
+  }
+  model_forward_.sparse_forward(embedding_vec_, embedding_input.bucket_range, model_comm_buffer,
                                 batch_size);
 }
 
 void UniformModelParallelEmbedding::network_forward(const EmbeddingInput &embedding_input,
                                                     EmbeddingOutput &embedding_output,
                                                     int batch_size) {
-  all2all_comm_.communicate(model_comm_buffer_.data_list, network_buffer_.data_list);
+  if (wire_compression_) {
+    auto stream = core_->get_local_gpu()->get_stream();
+    compress_fp32_to_fp16(model_comm_buffer_.data_list, model_wire_buffer_, stream);
+    all2all_comm_.communicate(model_wire_buffer_, network_wire_buffer_);
+    decompress_fp16_to_fp32(network_wire_buffer_, network_buffer_.data_list, stream);
+  } else {
+    all2all_comm_.communicate(model_comm_buffer_.data_list, network_buffer_.data_list);
+  }
   network_forward_.sparse_forward(embedding_input.num_keys_per_bucket, network_buffer_,
                                   meta_.network_indices, embedding_output, batch_size);
 }
@@ -236,7 +278,14 @@ void UniformModelParallelEmbedding::network_backward(const EmbeddingOutput &top_
   network_backward_.sparse_backward(embedding_input.num_keys_per_bucket, top_grad,
                                     meta_.network_indices, network_buffer_, batch_size);
 
-  all2all_comm_.communicate(network_buffer_.data_list, model_comm_buffer_.data_list);
+  if (wire_compression_) {
+    auto stream = core_->get_local_gpu()->get_stream();
+    compress_fp32_to_fp16(network_buffer_.data_list, network_wire_buffer_, stream);
+    all2all_comm_.communicate(network_wire_buffer_, model_wire_buffer_);
+    decompress_fp16_to_fp32(model_wire_buffer_, model_comm_buffer_.data_list, stream);
+  } else {
+    all2all_comm_.communicate(network_buffer_.data_list, model_comm_buffer_.data_list);
+  }
 }
 
 void UniformModelParallelEmbedding::backward_index_calculation(
@@ -262,7 +311,17 @@ void UniformModelParallelEmbedding::forward_per_gpu(Stage stage,
 
   switch (stage) {
     case Stage::MPModelForward: {
-      model_forward(embedding_input, embedding_table, batch_size);
+      if (prefetch_pending_) {
+        // this batch was already looked up by MPPrefetchModelForward; publish its buffer
+        std::swap(model_comm_buffer_, prefetch_model_comm_buffer_);
+        prefetch_pending_ = false;
+        break;
+      }
+      model_forward(embedding_input, embedding_table, batch_size, model_comm_buffer_);
+    } break;
+    case Stage::MPPrefetchModelForward: {
+      model_forward(embedding_input, embedding_table, batch_size, prefetch_model_comm_buffer_);
+      prefetch_pending_ = true;
     } break;
     case Stage::MPNetworkdForward: {
       network_forward(embedding_input, embedding_output, batch_size);
@@ -298,7 +357,8 @@ void UniformModelParallelEmbedding::backward_per_gpu(Stage stage,
 bool UniformModelParallelEmbedding::is_valid_stage(Stage stage) const {
   return (stage == Stage::MPModelForward) || (stage == Stage::MPNetworkdForward) ||
          (stage == Stage::MPBackwardIndexCalculation) || (stage == Stage::MPNetworkBackward) ||
-         (stage == Stage::MPLocalReduce);
+         (stage == Stage::MPLocalReduce) ||
+         (prefetch_double_buffer_ && stage == Stage::MPPrefetchModelForward);
 }
 
 }  // namespace embedding
@@ -25,6 +25,8 @@
 #include <embedding/operators/mp_index_calculation.hpp>
 #include <embedding/operators/network_backward.hpp>
 #include <embedding/operators/network_forward.hpp>
+#include <embedding/operators/sorted_lookup.hpp>
+#include <embedding/operators/wire_compression.hpp>
 
 namespace embedding {
 using namespace core;
@@ -90,6 +92,7 @@ class UniformModelParallelEmbedding : public IGroupedEmbeddingOp {
   LocalReduce local_reduce_;
 
   CompressOffset compress_offset_;
+  SortedLookup sorted_lookup_;
   ModelForward model_forward_;
   NcclAll2AllComm all2all_comm_;
   NetworkForward network_forward_;
@@ -101,8 +104,19 @@ class UniformModelParallelEmbedding : public IGroupedEmbeddingOp {
   ModelCommBuffer model_comm_buffer_;
   NetworkBuffer network_buffer_;
 
+  // double-buffered model forward (HCTR_PREFETCH_EMB_FORWARD=1): MPPrefetchModelForward
+  // looks up the next batch into the second buffer; the next MPModelForward swaps it in
+  bool prefetch_double_buffer_ = false;
+  bool prefetch_pending_ = false;
+  ModelCommBuffer prefetch_model_comm_buffer_;
+
+  // fp16 wire compression of the all-to-all (HCTR_EBC_WIRE_FP16=1, fp32 emb_type only)
+  bool wire_compression_ = false;
+  std::vector<core23::Tensor> model_wire_buffer_;
+  std::vector<core23::Tensor> network_wire_buffer_;
+
   void model_forward(const EmbeddingInput &embedding_input, ILookup *embedding_table,
-                     int batch_size);
+                     int batch_size, ModelCommBuffer &model_comm_buffer);
 
   void network_forward(const EmbeddingInput &embedding_input, EmbeddingOutput &embedding_output,
                        int batch_size);
@@ -117,7 +131,8 @@ class UniformModelParallelEmbedding : public IGroupedEmbeddingOp {
 
  public:
   UniformModelParallelEmbedding(std::shared_ptr<CoreResourceManager> core,
-                                const EmbeddingCollectionParam &params, size_t grouped_id);
+                                const EmbeddingCollectionParam &params, size_t grouped_id,
+                                const std::vector<EmbeddingTableParam> &emb_table_param_list = {});
 
   void forward_per_gpu(Stage stage, const EmbeddingInput &embedding_input, ILookup *embedding_table,
                        EmbeddingOutput &embedding_output, int batch_size) override;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <core23/macros.hpp>
 #include <core23/registry.hpp>
 #include <embedding/operators/communication.hpp>
 #include <utils.hpp>
@@ -51,6 +52,7 @@ NcclAll2AllComm::NcclAll2AllComm(std::shared_ptr<CoreResourceManager> core) : co
 
 void NcclAll2AllComm::communicate(const std::vector<core23::Tensor>& send_tensors,
                                   std::vector<core23::Tensor>& recv_tensors) {
+  HCTR_NVTX_RANGE("embedding::all2all");
   const char* const skip_all2all_env = std::getenv("SKIP_ALL2ALL");
   bool skip_all2all = (skip_all2all_env != nullptr && 1 == std::atoi(skip_all2all_env));
   if (skip_all2all) return;
@@ -77,6 +79,7 @@ void NcclAll2AllComm::dense_communicate(const core23::Tensor& send_tensor,
                                         const core23::Tensor& recv_tensor,
                                         const core23::Tensor& h_recv_k_per_gpu,
                                         int length_per_key) {
+  HCTR_NVTX_RANGE("embedding::all2all");
   const char* const skip_all2all_env = std::getenv("SKIP_ALL2ALL");
   bool skip_all2all = (skip_all2all_env != nullptr && 1 == std::atoi(skip_all2all_env));
   if (skip_all2all) return;
@@ -111,6 +114,7 @@ void NcclAll2AllComm::dense_communicate(const core23::Tensor& send_tensor,
 
 void NcclAll2AllComm::hier_communicate(const std::vector<core23::Tensor>& send_tensors,
                                        std::vector<core23::Tensor>& recv_tensors) {
+  HCTR_NVTX_RANGE("embedding::hier_all2all");
   const char* const skip_all2all_env = std::getenv("SKIP_ALL2ALL");
   bool skip_all2all = (skip_all2all_env != nullptr && 1 == std::atoi(skip_all2all_env));
   if (skip_all2all) return;
@@ -143,6 +147,7 @@ NcclAllReduceInplaceComm::NcclAllReduceInplaceComm(std::shared_ptr<CoreResourceM
     : core_(core) {}
 
 void NcclAllReduceInplaceComm::communicate(core23::Tensor& tensor, size_t count) {
+  HCTR_NVTX_RANGE("embedding::allreduce");
   const char* const skip_allreduce_env = std::getenv("SKIP_ALLREDUCE");
   bool skip_allreduce = (skip_allreduce_env != nullptr && 1 == std::atoi(skip_allreduce_env));
   if (skip_allreduce) return;
@@ -42,12 +42,138 @@ __global__ void cal_ev_start_indices_in_allreduce_wgrad_using_indices_kernel(
         ev_start_indices_in_allreduce_buffer[idx_in_allreduce_buffer];
   }
 }
+
+template <typename key_t>
+__global__ void widen_keys_kernel(const key_t* keys, uint64_t* widened_keys, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) { widened_keys[i] = static_cast<uint64_t>(keys[i]); }
+}
+
+__global__ void fill_cached_src_ids_kernel(uint32_t* src_ids, int* ev_sizes, int ev_size,
+                                           size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) {
+    src_ids[i] = i;
+    ev_sizes[i] = ev_size;
+  }
+}
+
+__global__ void narrow_slot_ids_kernel(const uint64_t* slot_ids, uint32_t* narrowed_slot_ids,
+                                       size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) {
+    narrowed_slot_ids[i] = static_cast<uint32_t>(slot_ids[i]);
+  }
+}
+
+template <typename key_t>
+__global__ void narrow_cached_unique_keys_kernel(const uint64_t* cached_unique_keys,
+                                                 const size_t* num_unique_keys,
+                                                 key_t* unique_keys) {
+  size_t num_keys = *num_unique_keys;
+  CUDA_1D_KERNEL_LOOP(i, num_keys) { unique_keys[i] = static_cast<key_t>(cached_unique_keys[i]); }
+}
 }  // namespace
 
+CachedIndexCalculation::CachedIndexCalculation(const std::shared_ptr<CoreResourceManager>& core,
+                                               int max_num_keys, int batch_size)
+    : core_(core) {
+  HugeCTR::CudaDeviceContext ctx(core->get_device_id());
+  core23::Device device(core23::DeviceType::GPU, core->get_device_id());
+  core23::TensorParams params = core23::TensorParams().device(device);
+
+  size_t max_key_num = static_cast<size_t>(max_num_keys) * batch_size;
+  slot_capacity_ = max_key_num;
+
+  size_t map_capacity = static_cast<size_t>(max_key_num / UNIQUE_OP_LOAD_FACTOR);
+  key_to_slot_map_ = std::make_unique<KeyToSlotMap>(core, map_capacity);
+
+  input_keys_u64_ = core23::Tensor(params.shape({static_cast<int64_t>(max_key_num)})
+                                       .data_type(core23::ScalarType::UInt64));
+  slot_ids_u64_ = core23::Tensor(params.shape({static_cast<int64_t>(max_key_num)})
+                                     .data_type(core23::ScalarType::UInt64));
+  slot_ids_ = core23::Tensor(params.shape({static_cast<int64_t>(max_key_num)})
+                                 .data_type(core23::ScalarType::UInt32));
+  src_ids_in_ = core23::Tensor(params.shape({static_cast<int64_t>(max_key_num)})
+                                   .data_type(core23::ScalarType::UInt32));
+  cached_unique_keys_u64_ = core23::Tensor(params.shape({static_cast<int64_t>(max_key_num)})
+                                               .data_type(core23::ScalarType::UInt64));
+
+  cub::DeviceRadixSort::SortPairs(nullptr, cub_sort_temp_bytes_, (uint32_t*)nullptr,
+                                  (uint32_t*)nullptr, (uint32_t*)nullptr, (uint32_t*)nullptr,
+                                  max_key_num);
+  cub_sort_temp_buffer_ = core23::Tensor(params.shape({static_cast<int64_t>(cub_sort_temp_bytes_)})
+                                             .data_type(core23::ScalarType::Void));
+}
+
+void CachedIndexCalculation::cal_for_sparse_indices(
+    const EmbeddingInput& embedding_input,
+    const core23::Tensor& ev_start_indices_in_allreduce_buffer, ReductionIndices& reduction_indices,
+    Wgrad& wgrad) {
+  HCTR_CHECK_HINT(wgrad.attr.is_same_ev_size,
+                  "cached index calculation requires a uniform ev size wgrad");
+  auto stream = core_->get_local_gpu()->get_stream();
+  size_t num_keys = embedding_input.h_num_keys;
+
+  reduction_indices.num_elements = num_keys;
+  if (num_keys == 0) {
+    HCTR_LIB_THROW(
+        cudaMemsetAsync(wgrad.num_unique_keys.data(), 0, wgrad.num_unique_keys.num_bytes(), stream));
+    return;
+  }
+  HCTR_CHECK_HINT(num_keys <= slot_capacity_,
+                  "cached index calculation: num keys exceeds init capacity");
+
+  // rebuild the map once the cumulative unique count could outgrow the per-batch
+  // sized wgrad indices; recurring keys repopulate it within one iteration
+  if (h_num_cached_unique_ + num_keys > slot_capacity_) {
+    key_to_slot_map_->clear(stream);
+  }
+
+  auto key_type = wgrad.unique_keys.data_type();
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
+    widen_keys_kernel<<<144 * 8, 256, 0, stream>>>(embedding_input.keys.data<key_t>(),
+                                                   input_keys_u64_.data<uint64_t>(), num_keys);
+    fill_cached_src_ids_kernel<<<144 * 8, 256, 0, stream>>>(src_ids_in_.data<uint32_t>(),
+                                                            reduction_indices.ev_sizes.data<int>(),
+                                                            wgrad.attr.same_ev_size, num_keys);
+
+    key_to_slot_map_->unique(input_keys_u64_.data<uint64_t>(), num_keys,
+                             slot_ids_u64_.data<uint64_t>(), cached_unique_keys_u64_.data<uint64_t>(),
+                             wgrad.num_unique_keys.data<size_t>(), stream);
+
+    narrow_slot_ids_kernel<<<144 * 8, 256, 0, stream>>>(slot_ids_u64_.data<uint64_t>(),
+                                                        slot_ids_.data<uint32_t>(), num_keys);
+    narrow_cached_unique_keys_kernel<<<144 * 8, 256, 0, stream>>>(
+        cached_unique_keys_u64_.data<uint64_t>(), wgrad.num_unique_keys.data<size_t>(),
+        wgrad.unique_keys.data<key_t>());
+
+    size_t temp_bytes = cub_sort_temp_bytes_;
+    cub::DeviceRadixSort::SortPairs(cub_sort_temp_buffer_.data(), temp_bytes,
+                                    slot_ids_.data<uint32_t>(),
+                                    reduction_indices.dst_ids.data<uint32_t>(),
+                                    src_ids_in_.data<uint32_t>(),
+                                    reduction_indices.src_ids.data<uint32_t>(), num_keys, 0,
+                                    sizeof(uint32_t) * 8, stream);
+
+    cal_ev_start_indices_in_allreduce_wgrad_using_indices_kernel<<<144 * 8, 256, 0, stream>>>(
+        wgrad.unique_keys.data<key_t>(), wgrad.unique_keys.num_elements(),
+        ev_start_indices_in_allreduce_buffer.data<uint32_t>(), wgrad.num_unique_keys.data<size_t>(),
+        wgrad.ev_start_indices.data<uint32_t>());
+  });
+
+  // keep a host-side copy of the cumulative unique count for the rebuild check
+  HCTR_LIB_THROW(cudaMemcpyAsync(&h_num_cached_unique_, wgrad.num_unique_keys.data<size_t>(),
+                                 sizeof(size_t), cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+}
+
 void DPLocalReduceIndexCalculation::cal_for_sparse_indices(
     const EmbeddingInput& embedding_input,
     const core23::Tensor& ev_start_indices_in_allreduce_buffer, ReductionIndices& reduction_indices,
     Wgrad& wgrad, int batch_size_per_gpu) {
+  if (cached_index_calculation_) {
+    cached_index_calculation_->cal_for_sparse_indices(
+        embedding_input, ev_start_indices_in_allreduce_buffer, reduction_indices, wgrad);
+    return;
+  }
   local_reduce_index_calculation_.cal_for_sparse_input(embedding_input, indices_sort_,
                                                        segmented_unique_, reduction_indices, wgrad,
                                                        batch_size_per_gpu);
@@ -17,6 +17,9 @@
 
 #include <core23/registry.hpp>
 #include <embedding/operators/index_calculation.hpp>
+#include <embedding/operators/unique_op.hpp>
+#include <limits>
+#include <memory>
 
 namespace embedding {
 using core::CoreResourceManager;
@@ -35,12 +38,49 @@ struct DPKeySelector {
 
 using DPIndexCalculation = IndexCalculation<DPKeySelector>;
 
+// Delta-based index calculation for the DP local reduce (HCTR_DP_CACHED_INDEX=1).
+// DP keys arrive already converted into flat indices of the grouped allreduce buffer,
+// so the key -> wgrad slot mapping is stable across iterations. A persistent unique_op
+// keeps that mapping device resident: recurring keys resolve with a single hash probe
+// and only first-seen keys insert new entries, replacing the per-batch full-width key
+// sort and segmented unique with a probe plus a 32-bit slot-id sort. The map is rebuilt
+// once the cumulative unique count would overflow the per-batch wgrad capacity. Only
+// usable for grouped-allreduce wgrads with a uniform embedding vector size.
+struct CachedIndexCalculation {
+  using KeyToSlotMap = unique_op<uint64_t, uint64_t, std::numeric_limits<uint64_t>::max(),
+                                 std::numeric_limits<uint64_t>::max()>;
+
+  std::shared_ptr<CoreResourceManager> core_;
+  std::unique_ptr<KeyToSlotMap> key_to_slot_map_;
+  size_t slot_capacity_ = 0;  // max cumulative unique keys before the map is rebuilt
+  size_t h_num_cached_unique_ = 0;
+
+  core23::Tensor input_keys_u64_;
+  core23::Tensor slot_ids_u64_;
+  core23::Tensor slot_ids_;    // uint32_t, per input key
+  core23::Tensor src_ids_in_;  // uint32_t iota
+  core23::Tensor cached_unique_keys_u64_;
+
+  size_t cub_sort_temp_bytes_ = 0;
+  core23::Tensor cub_sort_temp_buffer_;  // Void
+
+  CachedIndexCalculation() = default;
+
+  CachedIndexCalculation(const std::shared_ptr<CoreResourceManager>& core, int max_num_keys,
+                         int batch_size);
+
+  void cal_for_sparse_indices(const EmbeddingInput& embedding_input,
+                              const core23::Tensor& ev_start_indices_in_allreduce_buffer,
+                              ReductionIndices& reduction_indices, Wgrad& wgrad);
+};
+
 struct DPLocalReduceIndexCalculation {
   std::shared_ptr<CoreResourceManager> core_;
   LocalReduceIndexCalculation local_reduce_index_calculation_;
   SortKeyAndSrcIdOp indices_sort_;
   CalDstIds cal_dst_ids_;
   SegmentdUnique segmented_unique_;
+  std::shared_ptr<CachedIndexCalculation> cached_index_calculation_;
 
   void cal_for_sparse_indices(const EmbeddingInput& embedding_input,
                               const core23::Tensor& ev_start_indices_in_allreduce_buffer,
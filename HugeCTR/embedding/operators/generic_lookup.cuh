@@ -17,6 +17,7 @@
 
 #include <embedding/common.hpp>
 #include <embedding/view.hpp>
+#include <type_traits>
 #include <utils.cuh>
 
 #define EV_NUM 32
@@ -26,6 +27,31 @@
 
 namespace embedding {
 
+// Compile-time detection of the optional per-key weight accessors on a copy
+// descriptor. Weighted descriptors expose get_sp_weight() (gather/scatter) or
+// get_weight() (wgrad reduce); the shared kernels fold the multiply in with
+// `if constexpr`, so unweighted instantiations compile to exactly the code
+// they had before the weighted family was merged into them.
+template <typename CopyDesc, typename = void>
+struct has_sp_weight : std::false_type {};
+
+template <typename CopyDesc>
+struct has_sp_weight<CopyDesc, std::void_t<decltype(std::declval<CopyDesc &>().get_sp_weight(0))>>
+    : std::true_type {};
+
+template <typename CopyDesc>
+constexpr bool has_sp_weight_v = has_sp_weight<CopyDesc>::value;
+
+template <typename CopyDesc, typename = void>
+struct has_reduce_weight : std::false_type {};
+
+template <typename CopyDesc>
+struct has_reduce_weight<CopyDesc, std::void_t<decltype(std::declval<CopyDesc &>().get_weight(0))>>
+    : std::true_type {};
+
+template <typename CopyDesc>
+constexpr bool has_reduce_weight_v = has_reduce_weight<CopyDesc>::value;
+
 DEVICE_INLINE void float_half_atomicAdd_lower_cuda(__half *dst, float value) {
   bool uplo = ((unsigned long long)dst) & 2;  // check if the atomic is for the upper or lower
                                               // 16-bit quantity in the aligned 32-bit item
@@ -324,7 +350,7 @@ __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
 
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
@@ -333,10 +359,18 @@ __global__ void multi_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
     float accum[kMaxElemPerThread] = {0.f};
     for (int r = 0; r < (end - start); ++r) {
       const src_type *src_ev = copy_desc.get_src_ptr(r + start);
+      [[maybe_unused]] float weight = 1.f;
+      if constexpr (has_sp_weight_v<CopyDesc>) {
+        weight = copy_desc.get_sp_weight(r + start);
+      }
 #pragma unroll kMaxElemPerThread
       for (int i = 0; i < kMaxElemPerThread && blockDim.x * i + threadIdx.x < vec_length; ++i) {
-        accum[i] += HugeCTR::TypeConvertFunc<float, src_type>::convert(
+        float elem = HugeCTR::TypeConvertFunc<float, src_type>::convert(
             src_ev[blockDim.x * i + threadIdx.x]);
+        if constexpr (has_sp_weight_v<CopyDesc>) {
+          elem *= weight;
+        }
+        accum[i] += elem;
       }
     }
     if (average_pooling_factor > 0) {
@@ -368,7 +402,7 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   int i_ev = blockIdx.x * blockDim.y + warp_id;
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
     int end = copy_desc.get_offset(i_ev + 1);
@@ -383,6 +417,10 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
       for (int j = 0; j < kWarpSize && r + j < L; ++j) {
         int j_ev = __shfl_sync(0xFFFFFFFF, l, j);
         const src_type *src_ev = copy_desc.get_src_ptr(j_ev);
+        [[maybe_unused]] float weight = 1.f;
+        if constexpr (has_sp_weight_v<CopyDesc>) {
+          weight = copy_desc.get_sp_weight(j_ev);
+        }
 
 #pragma unroll kMaxElemPerThread
         for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length;
@@ -391,7 +429,11 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
           int idx4 = 4 * kWarpSize * i + 4 * lane_id;
           int n = min(vec_length - idx4, copy_width);
           src_elem.load(src_ev + idx4, n);
-          accum[i].accumulate(src_elem);
+          if constexpr (has_sp_weight_v<CopyDesc>) {
+            accum[i].accumulate_multiply(src_elem, weight);
+          } else {
+            accum[i].accumulate(src_elem);
+          }
         }
       }
     }
@@ -415,46 +457,6 @@ __global__ void multi_to_one_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void multi_to_one_weight_cta_per_ev_kernel(CopyDesc copy_desc) {
-  using src_type = typename CopyDesc::SrcT;
-  using dst_type = typename CopyDesc::DstT;
-  using vec_length_type = int;
-  int i_ev = blockIdx.x;
-
-  if (i_ev < copy_desc.num_vec_) {
-    vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    float average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
-    dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
-
-    int start = copy_desc.get_offset(i_ev);
-    int end = copy_desc.get_offset(i_ev + 1);
-
-    float accum[kMaxElemPerThread] = {0.f};
-    for (int r = 0; r < (end - start); ++r) {
-      const src_type *src_ev = copy_desc.get_src_ptr(r + start);
-      const float weight = copy_desc.get_sp_weight(r + start);
-#pragma unroll kMaxElemPerThread
-      for (int i = 0; i < kMaxElemPerThread && blockDim.x * i + threadIdx.x < vec_length; ++i) {
-        accum[i] += HugeCTR::TypeConvertFunc<float, src_type>::convert(
-                        src_ev[blockDim.x * i + threadIdx.x]) /
-                    weight;
-      }
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i] /= average_pooling_factor;
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread && blockDim.x * i + threadIdx.x < vec_length; ++i) {
-      dst_ev[blockDim.x * i + threadIdx.x] =
-          HugeCTR::TypeConvertFunc<dst_type, float>::convert(accum[i]);
-    }
-  }
-}
-
 template <typename CopyDesc, int kMaxElemPerThread>
 __global__ void multi_to_one_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
@@ -469,7 +471,7 @@ __global__ void multi_to_one_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_de
   for (int i_ev = blockIdx.x * blockDim.y + warp_id; i_ev < copy_desc.num_vec_;
        i_ev += gridDim.x * blockDim.y) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
     int end = copy_desc.get_offset(i_ev + 1);
@@ -480,13 +482,21 @@ __global__ void multi_to_one_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_de
     int L = end - start;
     for (int r = 0; r < L; ++r) {
       const src_type *src_ev = copy_desc.get_src_ptr(start + r);
+      [[maybe_unused]] float weight = 1.f;
+      if constexpr (has_sp_weight_v<CopyDesc>) {
+        weight = copy_desc.get_sp_weight(start + r);
+      }
 #pragma unroll kMaxElemPerThread
       for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
         Vec4T<src_type> src_elem;
         int idx4 = 4 * kWarpSize * i + 4 * lane_id;
         int n = min(vec_length - idx4, copy_width);
         src_elem.load(src_ev + idx4, n);
-        accum[i].accumulate(src_elem);
+        if constexpr (has_sp_weight_v<CopyDesc>) {
+          accum[i].accumulate_multiply(src_elem, weight);
+        } else {
+          accum[i].accumulate(src_elem);
+        }
       }
     }
     if (average_pooling_factor > 0) {
@@ -508,209 +518,93 @@ __global__ void multi_to_one_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_de
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void one_to_one_atomic_vec4(CopyDesc copy_desc, int ev_length) {
-  using src_type = typename CopyDesc::SrcT;
-  using dst_type = typename CopyDesc::DstT;
-
-  const int lane_id = threadIdx.x & 31;
-  const int warp_id = threadIdx.x >> 5;
-  const int warp_num = blockDim.x >> 5;
-  int local_sample_num = EV_NUM;
-  constexpr int copy_width = 4;
-  constexpr int kWarpSize = 32;
-
-  int global_index = EV_NUM * (blockIdx.x * warp_num + warp_id);
-  {
-    if (global_index >= copy_desc.num_vec()) return;
-    local_sample_num = local_sample_num < copy_desc.num_vec() - global_index
-                           ? local_sample_num
-                           : copy_desc.num_vec() - global_index;
-  }
-  for (int sp = 0; sp < local_sample_num; ++sp) {
-    const src_type *tmp_src = copy_desc.get_src_ptr(global_index);
-    dst_type *tmp_dst = copy_desc.get_dst_ptr(global_index);
-    int vec_length = copy_desc.get_vec_length(global_index);
-    for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
-      Vec4T<float> src_elem;
-      int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-      int n = min(vec_length - idx4, copy_width);
-      src_elem.load(tmp_src + idx4, n);
-      src_elem.atomic_store_accum(tmp_dst + idx4, n);
-    }
-    global_index++;
-  }
-  return;
-}
-
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void multi_to_one_weight_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
+// One sub-warp group of kLanesPerEv lanes per embedding vector. For narrow tables
+// (dim <= 4 * kLanesPerEv) the warp-per-ev kernels leave most lanes of every warp
+// idle; here a warp reduces 32 / kLanesPerEv vectors at once, so dim-16/32/64
+// tables get full lane occupancy with the same vec4 loads.
+template <typename CopyDesc, int kLanesPerEv>
+__global__ void multi_to_one_subwarp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
   using vec_length_type = int;
 
   constexpr int copy_width = 4;
   constexpr int kWarpSize = 32;
+  constexpr int kGroupsPerWarp = kWarpSize / kLanesPerEv;
 
-  int lane_id = threadIdx.x;
-  int warp_id = threadIdx.y;
-  int i_ev = blockIdx.x * blockDim.y + warp_id;
-  if (i_ev < copy_desc.num_vec_) {
+  int lane_id = threadIdx.x % kLanesPerEv;
+  int group_id = (threadIdx.y * kWarpSize + threadIdx.x) / kLanesPerEv;
+  int groups_per_block = blockDim.y * kGroupsPerWarp;
+  for (int i_ev = blockIdx.x * groups_per_block + group_id; i_ev < copy_desc.num_vec_;
+       i_ev += gridDim.x * groups_per_block) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    float average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
 
     int start = copy_desc.get_offset(i_ev);
     int end = copy_desc.get_offset(i_ev + 1);
 
     dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
 
-    Vec4T<float> accum[kMaxElemPerThread];
-    int L = end - start;
-    for (int r = 0; r < L; r += kWarpSize) {
-      int l = r + lane_id < L ? start + r + lane_id : 0;
-
-      for (int j = 0; j < kWarpSize && r + j < L; ++j) {
-        int j_ev = __shfl_sync(0xFFFFFFFF, l, j);
-        const src_type *src_ev = copy_desc.get_src_ptr(j_ev);
-        const float weight = copy_desc.get_sp_weight(j_ev);
-
-#pragma unroll kMaxElemPerThread
-        for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length;
-             ++i) {
-          Vec4T<src_type> src_elem;
-          int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-          int n = min(vec_length - idx4, copy_width);
-          src_elem.load(src_ev + idx4, n);
-          accum[i].accumulate_multiply(src_elem, weight);
+    Vec4T<float> accum;
+    int idx4 = 4 * lane_id;
+    int n = idx4 < vec_length ? min(vec_length - idx4, copy_width) : 0;
+    for (int r = start; r < end; ++r) {
+      const src_type *src_ev = copy_desc.get_src_ptr(r);
+      if (n > 0) {
+        Vec4T<src_type> src_elem;
+        src_elem.load(src_ev + idx4, n);
+        if constexpr (has_sp_weight_v<CopyDesc>) {
+          accum.accumulate_multiply(src_elem, copy_desc.get_sp_weight(r));
+        } else {
+          accum.accumulate(src_elem);
         }
       }
     }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i].val.x /= average_pooling_factor;
-      accum[i].val.y /= average_pooling_factor;
-      accum[i].val.z /= average_pooling_factor;
-      accum[i].val.w /= average_pooling_factor;
+    if (average_pooling_factor > 0) {
+      accum.val.x /= average_pooling_factor;
+      accum.val.y /= average_pooling_factor;
+      accum.val.z /= average_pooling_factor;
+      accum.val.w /= average_pooling_factor;
     }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
-      int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-      int n = min(vec_length - idx4, copy_width);
-      accum[i].store(dst_ev + idx4, n);
+    if (n > 0) {
+      accum.store(dst_ev + idx4, n);
     }
   }
 }
 
 template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void multi_to_one_weight_warp_per_ev_vec4_network_kernel(CopyDesc copy_desc) {
+__global__ void one_to_one_atomic_vec4(CopyDesc copy_desc, int ev_length) {
   using src_type = typename CopyDesc::SrcT;
   using dst_type = typename CopyDesc::DstT;
-  using vec_length_type = int;
 
+  const int lane_id = threadIdx.x & 31;
+  const int warp_id = threadIdx.x >> 5;
+  const int warp_num = blockDim.x >> 5;
+  int local_sample_num = EV_NUM;
   constexpr int copy_width = 4;
   constexpr int kWarpSize = 32;
 
-  int lane_id = threadIdx.x;
-  int warp_id = threadIdx.y;
-  int i_ev = blockIdx.x * blockDim.y + warp_id;
-  if (i_ev < copy_desc.num_vec_) {
-    vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    float average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
-
-    int start = copy_desc.get_offset(i_ev);
-    int end = copy_desc.get_offset(i_ev + 1);
-
-    dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
-
-    Vec4T<float> accum[kMaxElemPerThread];
-    int L = end - start;
-    for (int r = 0; r < L; r += kWarpSize) {
-      int l = r + lane_id < L ? start + r + lane_id : 0;
-
-      for (int j = 0; j < kWarpSize && r + j < L; ++j) {
-        int j_ev = __shfl_sync(0xFFFFFFFF, l, j);
-        const src_type *src_ev = copy_desc.get_src_ptr(j_ev);
-
-#pragma unroll kMaxElemPerThread
-        for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length;
-             ++i) {
-          Vec4T<src_type> src_elem;
-          int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-          int n = min(vec_length - idx4, copy_width);
-          src_elem.load(src_ev + idx4, n);
-          accum[i].accumulate(src_elem);
-        }
-      }
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i].val.x /= average_pooling_factor;
-      accum[i].val.y /= average_pooling_factor;
-      accum[i].val.z /= average_pooling_factor;
-      accum[i].val.w /= average_pooling_factor;
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
-      int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-      int n = min(vec_length - idx4, copy_width);
-      accum[i].store(dst_ev + idx4, n);
-    }
+  int global_index = EV_NUM * (blockIdx.x * warp_num + warp_id);
+  {
+    if (global_index >= copy_desc.num_vec()) return;
+    local_sample_num = local_sample_num < copy_desc.num_vec() - global_index
+                           ? local_sample_num
+                           : copy_desc.num_vec() - global_index;
   }
-}
-
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void multi_to_one_weight_warp_per_ev_vec4_model_kernel(CopyDesc copy_desc) {
-  using src_type = typename CopyDesc::SrcT;
-  using dst_type = typename CopyDesc::DstT;
-  using vec_length_type = int;
-
-  constexpr int copy_width = 4;
-  constexpr int kWarpSize = 32;
-
-  int lane_id = threadIdx.x;
-  int warp_id = threadIdx.y;
-  int i_ev = blockIdx.x * blockDim.y + warp_id;
-  if (i_ev < copy_desc.num_vec_) {
-    vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-
-    int start = copy_desc.get_offset(i_ev);
-    int end = copy_desc.get_offset(i_ev + 1);
-
-    dst_type *dst_ev = copy_desc.get_dst_ptr(i_ev);
-
-    Vec4T<float> accum[kMaxElemPerThread];
-    int L = end - start;
-    for (int r = 0; r < L; r += kWarpSize) {
-      int l = r + lane_id < L ? start + r + lane_id : 0;
-
-      for (int j = 0; j < kWarpSize && r + j < L; ++j) {
-        int j_ev = __shfl_sync(0xFFFFFFFF, l, j);
-        const src_type *src_ev = copy_desc.get_src_ptr(j_ev);
-        const float weight = copy_desc.get_sp_weight(j_ev);
-
-#pragma unroll kMaxElemPerThread
-        for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length;
-             ++i) {
-          Vec4T<src_type> src_elem;
-          int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-          int n = min(vec_length - idx4, copy_width);
-          src_elem.load(src_ev + idx4, n);
-          accum[i].accumulate_multiply(src_elem, weight);
-        }
-      }
-    }
-
-#pragma unroll kMaxElemPerThread
+  for (int sp = 0; sp < local_sample_num; ++sp) {
+    const src_type *tmp_src = copy_desc.get_src_ptr(global_index);
+    dst_type *tmp_dst = copy_desc.get_dst_ptr(global_index);
+    int vec_length = copy_desc.get_vec_length(global_index);
     for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
+      Vec4T<float> src_elem;
       int idx4 = 4 * kWarpSize * i + 4 * lane_id;
       int n = min(vec_length - idx4, copy_width);
-      accum[i].store(dst_ev + idx4, n);
+      src_elem.load(tmp_src + idx4, n);
+      src_elem.atomic_store_accum(tmp_dst + idx4, n);
     }
+    global_index++;
   }
+  return;
 }
 
 template <typename CopyDesc, int kMaxElemPerThread>
@@ -722,7 +616,7 @@ __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
 
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
     float accum[kMaxElemPerThread] = {0.f};
 #pragma unroll kMaxElemPerThread
@@ -750,41 +644,6 @@ __global__ void one_to_multi_cta_per_ev_kernel(CopyDesc copy_desc) {
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void one_to_multi_weight_cta_per_ev_kernel(CopyDesc copy_desc) {
-  using src_type = typename CopyDesc::SrcT;
-  using dst_type = typename CopyDesc::DstT;
-  using vec_length_type = int;
-  int i_ev = blockIdx.x;
-
-  if (i_ev < copy_desc.num_vec_) {
-    vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    float average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
-    const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
-    float accum[kMaxElemPerThread] = {0.f};
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread && blockDim.x * i + threadIdx.x < vec_length; ++i) {
-      accum[i] = src_ev[blockDim.x * i + threadIdx.x];
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i] /= average_pooling_factor;
-    }
-
-    int start = copy_desc.get_offset(i_ev);
-    int end = copy_desc.get_offset(i_ev + 1);
-    for (int r = 0; r < (end - start); ++r) {
-      dst_type *dst_ev = copy_desc.get_dst_ptr(r + start);
-#pragma unroll kMaxElemPerThread
-      for (int i = 0; i < kMaxElemPerThread && blockDim.x * i + threadIdx.x < vec_length; ++i) {
-        dst_ev[blockDim.x * i + threadIdx.x] =
-            HugeCTR::TypeConvertFunc<dst_type, float>::convert(accum[i]);
-      }
-    }
-  }
-}
-
 template <typename CopyDesc, int kMaxElemPerThread>
 __global__ void one_to_multi_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
@@ -799,7 +658,7 @@ __global__ void one_to_multi_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
   int i_ev = blockIdx.x * blockDim.y + warp_id;
   if (i_ev < copy_desc.num_vec_) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
     Vec4T<float> accum[kMaxElemPerThread];
 
@@ -857,7 +716,7 @@ __global__ void one_to_multi_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_de
   for (int i_ev = blockIdx.x * blockDim.y + warp_id; i_ev < copy_desc.num_vec_;
        i_ev += gridDim.x * blockDim.y) {
     vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    int average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
+    auto average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
     const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
     Vec4T<float> accum[kMaxElemPerThread];
 
@@ -894,61 +753,6 @@ __global__ void one_to_multi_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_de
   }
 }
 
-template <typename CopyDesc, int kMaxElemPerThread>
-__global__ void one_to_multi_weight_warp_per_ev_vec4_kernel(CopyDesc copy_desc) {
-  using src_type = typename CopyDesc::SrcT;
-  using dst_type = typename CopyDesc::DstT;
-  using vec_length_type = int;
-
-  constexpr int copy_width = 4;
-  constexpr int kWarpSize = 32;
-
-  int lane_id = threadIdx.x;
-  int warp_id = threadIdx.y;
-  int i_ev = blockIdx.x * blockDim.y + warp_id;
-  if (i_ev < copy_desc.num_vec_) {
-    vec_length_type vec_length = copy_desc.get_vec_length(i_ev);
-    float average_pooling_factor = copy_desc.get_average_pooling_factor(i_ev);
-    const src_type *src_ev = copy_desc.get_src_ptr(i_ev);
-    Vec4T<float> accum[kMaxElemPerThread];
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
-      int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-      int n = min(vec_length - idx4, copy_width);
-      accum[i].load(src_ev + idx4, n);
-    }
-
-#pragma unroll kMaxElemPerThread
-    for (int i = 0; i < kMaxElemPerThread; ++i) {
-      accum[i].val.x /= average_pooling_factor;
-      accum[i].val.y /= average_pooling_factor;
-      accum[i].val.z /= average_pooling_factor;
-      accum[i].val.w /= average_pooling_factor;
-    }
-
-    int start = copy_desc.get_offset(i_ev);
-    int end = copy_desc.get_offset(i_ev + 1);
-    int L = end - start;
-    for (int r = 0; r < L; r += kWarpSize) {
-      int l = r + lane_id < L ? start + r + lane_id : 0;
-
-      for (int j = 0; j < kWarpSize && r + j < L; ++j) {
-        int j_ev = __shfl_sync(0xFFFFFFFF, l, j);
-        dst_type *dst_ev = copy_desc.get_dst_ptr(j_ev);
-
-#pragma unroll kMaxElemPerThread
-        for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length;
-             ++i) {
-          int idx4 = 4 * kWarpSize * i + 4 * lane_id;
-          int n = min(vec_length - idx4, copy_width);
-          accum[i].store(dst_ev + idx4, n);
-        }
-      }
-    }
-  }
-}
-
 template <typename CopyDesc, int kMaxElemPerThread>
 __global__ void one_to_one_cta_per_ev_kernel(CopyDesc copy_desc) {
   using src_type = typename CopyDesc::SrcT;
@@ -1083,6 +887,41 @@ __global__ void one_to_one_warp_per_ev_vec4_less_block_kernel(CopyDesc copy_desc
   }
 }
 
+// Most embedding collections use a single combiner for every lookup, so the per-lookup combiner
+// branch inside a copy descriptor's pooling-factor lambda can usually be resolved when the kernel
+// is instantiated: an all-sum launch returns a non-positive factor so the guarded divide loop in
+// the copy kernels folds away entirely, and an all-average launch drops the combiner-list load.
+// Only launches that genuinely mix combiners keep the runtime branch.
+enum class CombinerSpecialization : char { Sum, Average, Mixed };
+
+inline CombinerSpecialization specialize_combiner(const std::vector<char> &h_id_to_combiner) {
+  bool has_average = false;
+  bool has_other = false;
+  for (char combiner : h_id_to_combiner) {
+    if (combiner == static_cast<char>(Combiner::Average)) {
+      has_average = true;
+    } else {
+      has_other = true;
+    }
+  }
+  if (has_average && has_other) return CombinerSpecialization::Mixed;
+  return has_average ? CombinerSpecialization::Average : CombinerSpecialization::Sum;
+}
+
+#define CASE_COMBINER_USING_HINT(SPEC, HINT, ...)   \
+  case (SPEC): {                                    \
+    constexpr CombinerSpecialization HINT = (SPEC); \
+    __VA_ARGS__();                                  \
+    break;                                          \
+  }
+
+#define DISPATCH_COMBINER_FUNCTION(SPEC, HINT, ...)                              \
+  switch (SPEC) {                                                                \
+    CASE_COMBINER_USING_HINT(CombinerSpecialization::Sum, HINT, __VA_ARGS__)     \
+    CASE_COMBINER_USING_HINT(CombinerSpecialization::Average, HINT, __VA_ARGS__) \
+    CASE_COMBINER_USING_HINT(CombinerSpecialization::Mixed, HINT, __VA_ARGS__)   \
+  }
+
 template <typename SrcType, typename DstType, typename LambdaNeedCopy, typename LambdaVecLength,
           typename LambdaSrcTensor, typename LambdaDstTensor>
 struct OneToOne {
@@ -1201,6 +1040,37 @@ make_MultiToOne_reduce_new(LambdaVecNum num_vec, LambdaSrcVecLength get_src_vec_
   return {num_vec, get_src_vec_length, get_dst_id, get_src_ptr, get_dst_ptr};
 };
 
+template <typename SrcType, typename DstType, typename LambdaVecNum, typename LambdaSrcVecLength,
+          typename LambdaDstId, typename LambdaSrcPtr, typename LambdaDstPtr, typename LambdaWeight>
+struct MultiToOne_reduce_weight_new {
+  using SrcT = SrcType;
+  using DstT = DstType;
+
+  HOST_DEVICE_INLINE size_t num_vec() { return num_vec_(); }
+  HOST_DEVICE_INLINE int get_src_vec_length(int i) { return get_src_vec_length_(i); }
+  HOST_DEVICE_INLINE uint32_t get_dst_id(int i) { return get_dst_id_(i); }
+  HOST_DEVICE_INLINE const SrcType *get_src_ptr(int i) { return get_src_ptr_(i); }
+  HOST_DEVICE_INLINE DstType *get_dst_ptr(int i) { return get_dst_ptr_(i); }
+  HOST_DEVICE_INLINE float get_weight(int i) { return get_weight_(i); }
+
+  LambdaVecNum num_vec_;
+  LambdaSrcVecLength get_src_vec_length_;
+  LambdaDstId get_dst_id_;
+  LambdaSrcPtr get_src_ptr_;
+  LambdaDstPtr get_dst_ptr_;
+  LambdaWeight get_weight_;
+};
+
+template <typename SrcType, typename DstType, typename LambdaVecNum, typename LambdaSrcVecLength,
+          typename LambdaDstId, typename LambdaSrcPtr, typename LambdaDstPtr, typename LambdaWeight>
+MultiToOne_reduce_weight_new<SrcType, DstType, LambdaVecNum, LambdaSrcVecLength, LambdaDstId,
+                             LambdaSrcPtr, LambdaDstPtr, LambdaWeight>
+make_MultiToOne_reduce_weight_new(LambdaVecNum num_vec, LambdaSrcVecLength get_src_vec_length,
+                                  LambdaDstId get_dst_id, LambdaSrcPtr get_src_ptr,
+                                  LambdaDstPtr get_dst_ptr, LambdaWeight get_weight) {
+  return {num_vec, get_src_vec_length, get_dst_id, get_src_ptr, get_dst_ptr, get_weight};
+};
+
 template <typename SrcType, typename DstType, typename LambdaKey, typename LambdaSrcVecLength,
           typename LambdaDstVecLength, typename LambdaDstUniqueId, typename LambdaSrcTensor,
           typename LambdaDstTensor>
@@ -1346,7 +1216,26 @@ void copy_one_to_one(CopyDesc copy_desc, const HugeCTR::core23::KernelParams &ke
 
 template <typename CopyDesc>
 void copy_multi_to_one(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream) {
-  if (max_ev_size <= 128) {
+  // narrow tables take the compile-time sub-warp specializations so every lane works
+  if (max_ev_size <= 16) {
+    dim3 block_size{32, 2};
+    int groups_per_block = block_size.y * (32 / 4);
+    int grid_size = (copy_desc.num_vec_ - 1) / groups_per_block + 1;
+    multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 4>
+        <<<grid_size, block_size, 0, stream>>>(copy_desc);
+  } else if (max_ev_size <= 32) {
+    dim3 block_size{32, 2};
+    int groups_per_block = block_size.y * (32 / 8);
+    int grid_size = (copy_desc.num_vec_ - 1) / groups_per_block + 1;
+    multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 8>
+        <<<grid_size, block_size, 0, stream>>>(copy_desc);
+  } else if (max_ev_size <= 64) {
+    dim3 block_size{32, 2};
+    int groups_per_block = block_size.y * (32 / 16);
+    int grid_size = (copy_desc.num_vec_ - 1) / groups_per_block + 1;
+    multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 16>
+        <<<grid_size, block_size, 0, stream>>>(copy_desc);
+  } else if (max_ev_size <= 128) {
     int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
     dim3 block_size{32, 2};
     multi_to_one_warp_per_ev_vec4_kernel<CopyDesc, 1>
@@ -1368,7 +1257,30 @@ void copy_multi_to_one(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream)
 template <typename CopyDesc>
 void copy_multi_to_one(CopyDesc copy_desc, const HugeCTR::core23::KernelParams &kernel_params,
                        int max_ev_size, cudaStream_t stream) {
-  if (max_ev_size <= 128) {
+  // narrow tables take the compile-time sub-warp specializations so every lane works
+  if (max_ev_size <= 64) {
+    dim3 block_size{32, 8};
+    int max_blocks = kernel_params.num_sms * (kernel_params.max_thread_per_sm / 256);
+    if (max_ev_size <= 16) {
+      int groups_per_block = block_size.y * (32 / 4);
+      int grid_size =
+          std::min((copy_desc.num_vec_ - 1) / groups_per_block + 1, max_blocks);
+      multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 4>
+          <<<grid_size, block_size, 0, stream>>>(copy_desc);
+    } else if (max_ev_size <= 32) {
+      int groups_per_block = block_size.y * (32 / 8);
+      int grid_size =
+          std::min((copy_desc.num_vec_ - 1) / groups_per_block + 1, max_blocks);
+      multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 8>
+          <<<grid_size, block_size, 0, stream>>>(copy_desc);
+    } else {
+      int groups_per_block = block_size.y * (32 / 16);
+      int grid_size =
+          std::min((copy_desc.num_vec_ - 1) / groups_per_block + 1, max_blocks);
+      multi_to_one_subwarp_per_ev_vec4_kernel<CopyDesc, 16>
+          <<<grid_size, block_size, 0, stream>>>(copy_desc);
+    }
+  } else if (max_ev_size <= 128) {
     int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
     dim3 block_size{32, 8};
     int num_vector_per_warp = NUM_VECTOR_PER_WARP;
@@ -1398,26 +1310,6 @@ void copy_multi_to_one(CopyDesc copy_desc, const HugeCTR::core23::KernelParams &
   }
 }
 
-template <typename CopyDesc>
-void copy_multi_to_one_weight(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream) {
-  if (max_ev_size <= 128) {
-    int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
-    dim3 block_size{32, 2};
-    multi_to_one_weight_warp_per_ev_vec4_kernel<CopyDesc, 1>
-        <<<grid_size, block_size, 0, stream>>>(copy_desc);
-  } else if (max_ev_size <= 256) {
-    int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
-    dim3 block_size{32, 2};
-    multi_to_one_weight_warp_per_ev_vec4_kernel<CopyDesc, 2>
-        <<<grid_size, block_size, 0, stream>>>(copy_desc);
-  } else if (max_ev_size <= 1024) {
-    multi_to_one_weight_cta_per_ev_kernel<CopyDesc, 1>
-        <<<copy_desc.num_vec_, max_ev_size, 0, stream>>>(copy_desc);
-  } else {
-    HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall,
-                   "HugeCTR does not support emb vector size >= 4096");
-  }
-}
 
 template <typename CopyDesc>
 void copy_one_to_multi(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream) {
@@ -1474,26 +1366,6 @@ void copy_one_to_multi(CopyDesc copy_desc, const HugeCTR::core23::KernelParams &
   }
 }
 
-template <typename CopyDesc>
-void copy_one_to_multi_weight(CopyDesc copy_desc, int max_ev_size, cudaStream_t stream) {
-  if (max_ev_size <= 128) {
-    int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
-    dim3 block_size{32, 2};
-    one_to_multi_weight_warp_per_ev_vec4_kernel<CopyDesc, 1>
-        <<<grid_size, block_size, 0, stream>>>(copy_desc);
-  } else if (max_ev_size <= 256) {
-    int grid_size = (copy_desc.num_vec_ - 1) / 2 + 1;
-    dim3 block_size{32, 2};
-    one_to_multi_weight_warp_per_ev_vec4_kernel<CopyDesc, 2>
-        <<<grid_size, block_size, 0, stream>>>(copy_desc);
-  } else if (max_ev_size <= 1024) {
-    one_to_multi_weight_cta_per_ev_kernel<CopyDesc, 1>
-        <<<copy_desc.num_vec_, max_ev_size, 0, stream>>>(copy_desc);
-  } else {
-    HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall,
-                   "HugeCTR does not support emb vector size >= 4096");
-  }
-}
 
 template <typename CopyDesc, int kWarpSize = 32>
 void one_to_one_atomic(CopyDesc desc, const HugeCTR::core23::KernelParams &kernel_params,
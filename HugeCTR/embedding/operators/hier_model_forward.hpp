@@ -48,6 +48,9 @@ struct IntraModelCommBufferAttr {
 struct IntraModelCommBuffer {
   std::vector<core23::Tensor> local_datas;  // num of local gpus
   core23::Tensor local_datas_device_view;
+  // P2P-mapped pointers to every local GPU's local_datas, filled by
+  // collective_init_peer_buffer. The forward kernel dereferences these to store
+  // shard outputs directly into remote HBM (GPU-initiated, no host staging).
   core23::Tensor peer_data;
 
   const IntraModelCommBufferAttr &attr;
@@ -92,6 +95,11 @@ void collective_init_peer_buffer(const std::vector<std::shared_ptr<CoreResourceM
 struct IntraModelForward {
   std::shared_ptr<CoreResourceManager> core_;
 
+  // Scatters the lookup results of this GPU's shards into every local GPU's
+  // comm buffer in one kernel: each store goes through the peer pointer of the
+  // destination GPU, so producing and "sending" an embedding vector is a single
+  // GPU-initiated write. Only the inter-node phase needs a collective
+  // (NCCL all2all over the rail-aligned reduction buffers).
   void intra_forward(const core23::Tensor &evs, const core23::Tensor &bucket_range,
                      IntraModelCommBuffer &intra_model_comm_buffer, int batch_size);
 
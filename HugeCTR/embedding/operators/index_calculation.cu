@@ -15,11 +15,13 @@
  */
 
 #include <cub/cub.cuh>
+#include <core23/macros.hpp>
 #include <embedding/common.hpp>
 #include <embedding/operators/dp_index_calculation.hpp>
 #include <embedding/operators/index_calculation.hpp>
 #include <embedding/operators/mp_index_calculation.hpp>
 #include <embedding/view.hpp>
+#include <type_traits>
 #include <utils.cuh>
 #include <utils.hpp>
 
@@ -438,8 +440,30 @@ void partition_by_table_id(const core23::Tensor &keys, const core23::Tensor &buc
                          reduction_indices.num_key, core);
 }
 
+int num_bits_for(int64_t n) {
+  int bits = 1;
+  while ((int64_t{1} << bits) < n) ++bits;
+  return bits;
+}
+
 }  // namespace
 
+SortBitRange cal_sort_bit_range(const std::vector<EmbeddingTableParam> &table_params) {
+  SortBitRange bit_range;
+  if (table_params.empty()) return bit_range;
+
+  int64_t max_vocabulary_size = 0;
+  int64_t total_vocabulary_size = 0;
+  for (const auto &table_param : table_params) {
+    if (table_param.max_vocabulary_size < 0) return bit_range;
+    max_vocabulary_size = std::max(max_vocabulary_size, table_param.max_vocabulary_size);
+    total_vocabulary_size += table_param.max_vocabulary_size;
+  }
+  bit_range.key_end_bit = num_bits_for(max_vocabulary_size);
+  bit_range.indices_end_bit = num_bits_for(total_vocabulary_size);
+  return bit_range;
+}
+
 template <typename offset_t>
 void LocalReduceIndexCalculationTempStorage::init(const std::shared_ptr<CoreResourceManager> &core,
                                                   int num_lookup, int batch_size) {
@@ -506,10 +530,32 @@ __global__ void decompose_tid_key_kernel(const struct ComposeTidKey<key_t> *comp
 
 #endif
 
+// Fused (table id, key) layout for vocabulary-bounded tables: the table id is
+// packed directly above the key's occupied bits, so a plain radix sort over
+// key_end_bit + table-id bits orders by (table, key) while sweeping a fraction
+// of the digit passes the full-width sort needs.
+template <typename key_t>
+__global__ void compose_fused_tid_key_kernel(const key_t *keys, const int *table_range,
+                                             const size_t num_keys, const int num_table_range,
+                                             const int key_end_bit, key_t *fused_keys) {
+  CUDA_1D_KERNEL_LOOP(idx, num_keys) {
+    int table_id = bs_upper_bound_sub_one(table_range, num_table_range, idx);
+    fused_keys[idx] = keys[idx] | (static_cast<key_t>(table_id) << key_end_bit);
+  }
+}
+
+template <typename key_t>
+__global__ void decompose_fused_tid_key_kernel(const key_t *fused_keys, const size_t num_keys,
+                                               const int key_end_bit, key_t *keys) {
+  CUDA_1D_KERNEL_LOOP(idx, num_keys) {
+    keys[idx] = fused_keys[idx] & ((static_cast<key_t>(1) << key_end_bit) - 1);
+  }
+}
+
 SegmentedSortDevice::SegmentedSortDevice(const std::shared_ptr<CoreResourceManager> &core,
                                          core23::Tensor sorted_table_ids, int max_num_keys,
                                          int batch_size, int num_lookup, int num_table,
-                                         core23::DataType key_type)
+                                         core23::DataType key_type, int key_end_bit)
     : sorted_table_ids_(sorted_table_ids),
       num_lookup_(num_lookup),
       num_table_(num_table),
@@ -520,6 +566,33 @@ SegmentedSortDevice::SegmentedSortDevice(const std::shared_ptr<CoreResourceManag
   core23::TensorParams params = core23::TensorParams().device(device);
 
   max_key_num_ = ((size_t)max_num_keys) * ((size_t)batch_size);
+
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
+    // signed key types lose their top bit to the sign twiddling of the radix sort
+    int usable_bits = sizeof(key_t) * 8 - (std::is_signed_v<key_t> ? 1 : 0);
+    if (key_end_bit > 0 && key_end_bit + num_bits_for(num_table) <= usable_bits) {
+      this->use_fused_tid_key_ = true;
+      this->key_end_bit_ = key_end_bit;
+      this->fused_end_bit_ = key_end_bit + num_bits_for(num_table);
+    }
+  });
+
+  if (use_fused_tid_key_) {
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
+      this->compose_tid_keys_input =
+          core23::Tensor(params.shape({static_cast<int64_t>(max_key_num_ * sizeof(key_t))})
+                             .data_type(core23::ScalarType::Char));
+      this->compose_tid_keys_output =
+          core23::Tensor(params.shape({static_cast<int64_t>(max_key_num_ * sizeof(key_t))})
+                             .data_type(core23::ScalarType::Char));
+      cub::DeviceRadixSort::SortPairs(nullptr, cub_sort_temp_bytes_, (key_t *)nullptr,
+                                      (key_t *)nullptr, (uint32_t *)nullptr, (uint32_t *)nullptr,
+                                      max_key_num_, 0, fused_end_bit_);
+      cub_sort_temp_buffer_ =
+          core23::Tensor(params.shape({static_cast<int64_t>(cub_sort_temp_bytes_)})
+                             .data_type(core23::ScalarType::Char));
+    });
+  } else {
 #if CUB_VERSION >= 200200
   DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
     this->compose_tid_keys_input = core23::Tensor(
@@ -546,6 +619,7 @@ SegmentedSortDevice::SegmentedSortDevice(const std::shared_ptr<CoreResourceManag
                            .data_type(core23::ScalarType::Char));
   });
 #endif
+  }
 
   this->partitioned_table_range =
       core23::Tensor(params.shape({num_table + 1}).data_type(core23::ScalarType::Int32));
@@ -585,6 +659,22 @@ void SegmentedSortDevice::operator()(embedding::SortInput &input, embedding::Sor
                         select_op, stream);
 
   // sort
+  if (use_fused_tid_key_) {
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(input.keys.data_type().type(), key_t, [&] {
+      compose_fused_tid_key_kernel<<<grid_size, block_size, 0, stream>>>(
+          input.keys.data<key_t>(), partitioned_table_range.data<int>(), input.h_num_key,
+          num_table_ + 1, key_end_bit_, static_cast<key_t *>(compose_tid_keys_input.data()));
+      cub::DeviceRadixSort::SortPairs(
+          cub_sort_temp_buffer_.data(), cub_sort_temp_bytes_,
+          static_cast<key_t *>(compose_tid_keys_input.data()),
+          static_cast<key_t *>(compose_tid_keys_output.data()), input.src_ids.data<uint32_t>(),
+          output.sorted_src_ids.data<uint32_t>(), input.h_num_key, 0, fused_end_bit_, stream);
+      decompose_fused_tid_key_kernel<<<grid_size, block_size, 0, stream>>>(
+          static_cast<key_t *>(compose_tid_keys_output.data()), input.h_num_key, key_end_bit_,
+          output.sorted_keys.data<key_t>());
+    });
+    return;
+  }
 #if CUB_VERSION >= 200200
   DISPATCH_INTEGRAL_FUNCTION_CORE23(input.keys.data_type().type(), key_t, [&] {
     compose_tid_key_kernel<<<grid_size, block_size, 0, stream>>>(
@@ -613,7 +703,8 @@ void SegmentedSortDevice::operator()(embedding::SortInput &input, embedding::Sor
 }
 
 IndicesSort::IndicesSort(const std::shared_ptr<CoreResourceManager> &core, int max_num_keys,
-                         int batch_size, core23::DataType key_type) {
+                         int batch_size, core23::DataType key_type, int sort_end_bit)
+    : sort_end_bit_(sort_end_bit) {
   core23::Device device(core23::DeviceType::GPU, core->get_device_id());
   core23::TensorParams params = core23::TensorParams().device(device);
 
@@ -636,11 +727,14 @@ void IndicesSort::operator()(embedding::SortInput &input, embedding::SortOutput
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
     size_t temp_bytes = d_temp_sort_storage.num_bytes();
+    int end_bit = sort_end_bit_ > 0 && sort_end_bit_ < static_cast<int>(sizeof(key_t) * 8)
+                      ? sort_end_bit_
+                      : static_cast<int>(sizeof(key_t) * 8);
     cub::DeviceRadixSort::SortPairs(
         d_temp_sort_storage.data(), temp_bytes, input.keys.data<key_t>(),
         output.sorted_keys.data<key_t>(), input.src_ids.data<uint32_t>(),
-        output.sorted_src_ids.data<uint32_t>(), static_cast<int64_t>(input.h_num_key), 0,
-        sizeof(key_t) * 8, stream);
+        output.sorted_src_ids.data<uint32_t>(), static_cast<int64_t>(input.h_num_key), 0, end_bit,
+        stream);
   });
 }
 
@@ -706,6 +800,124 @@ __global__ void get_unique_key_same_ev_size(
   }
 }
 
+namespace {
+
+constexpr int kFusedUniqueBlockSize = 256;
+constexpr int kFusedUniqueItemsPerThread = 4;
+constexpr int kFusedUniqueTileSize = kFusedUniqueBlockSize * kFusedUniqueItemsPerThread;
+
+// per-tile scan state for the decoupled-lookback scan: 2 status bits + 62 value bits
+constexpr unsigned long long kTileStatusInvalid = 0ull;
+constexpr unsigned long long kTileStatusPartial = 1ull << 62;
+constexpr unsigned long long kTileStatusInclusive = 2ull << 62;
+constexpr unsigned long long kTileValueMask = (1ull << 62) - 1;
+
+}  // namespace
+
+// Fused replacement for get_keys_flag + cub::DeviceScan::InclusiveSum + get_unique_key:
+// every tile computes its run-boundary flags in registers, scans them block-wide, resolves
+// its global prefix through decoupled lookback and scatters the compacted unique
+// keys/table ids/dst ids in the same sweep, so the flag buffer never round-trips through
+// global memory. ev_start_indices may be nullptr when the ev sizes differ per table.
+template <typename key_t>
+__global__ void fused_segmented_unique_kernel(
+    const key_t *__restrict__ sorted_keys, const int *__restrict__ table_ids,
+    const uint64_t *__restrict__ num_key, unsigned long long *tile_status,
+    unsigned int *tile_counter, const int ev_size, key_t *__restrict__ unique_keys,
+    int *__restrict__ unique_table_ids, uint32_t *__restrict__ ev_start_indices,
+    uint64_t *__restrict__ unique_key_num, uint32_t *__restrict__ dst_ids) {
+  typedef cub::BlockScan<uint32_t, kFusedUniqueBlockSize> BlockScan;
+  __shared__ typename BlockScan::TempStorage scan_storage;
+  __shared__ unsigned int tile_idx_shared;
+  __shared__ unsigned long long exclusive_prefix_shared;
+
+  // tiles have to be assigned in launch order for the lookback to make progress, so
+  // take tile ids from a global counter instead of relying on blockIdx.x scheduling
+  if (threadIdx.x == 0) {
+    tile_idx_shared = atomicAdd(tile_counter, 1);
+  }
+  __syncthreads();
+  const unsigned int tile_idx = tile_idx_shared;
+
+  const uint64_t key_num = *num_key;
+  const uint64_t tile_start = static_cast<uint64_t>(tile_idx) * kFusedUniqueTileSize;
+  const uint64_t item_start = tile_start + static_cast<uint64_t>(threadIdx.x) * kFusedUniqueItemsPerThread;
+
+  uint32_t flags[kFusedUniqueItemsPerThread];
+  uint32_t thread_sum = 0;
+#pragma unroll
+  for (int i = 0; i < kFusedUniqueItemsPerThread; ++i) {
+    uint64_t idx = item_start + i;
+    uint32_t is_first = 0;
+    if (idx < key_num) {
+      if (idx == 0) {
+        is_first = 1;
+      } else {
+        is_first = (sorted_keys[idx - 1] != sorted_keys[idx]) || (table_ids[idx - 1] != table_ids[idx]);
+      }
+    }
+    flags[i] = is_first;
+    thread_sum += is_first;
+  }
+
+  uint32_t thread_exclusive = 0;
+  uint32_t tile_aggregate = 0;
+  BlockScan(scan_storage).ExclusiveSum(thread_sum, thread_exclusive, tile_aggregate);
+
+  if (threadIdx.x == 0) {
+    unsigned long long payload =
+        (tile_idx == 0 ? kTileStatusInclusive : kTileStatusPartial) | tile_aggregate;
+    __threadfence();
+    atomicExch(&tile_status[tile_idx], payload);
+  }
+
+  if (tile_idx > 0) {
+    if (threadIdx.x == 0) {
+      unsigned long long exclusive = 0;
+      int look = static_cast<int>(tile_idx) - 1;
+      while (look >= 0) {
+        unsigned long long state = atomicAdd(&tile_status[look], 0ull);
+        unsigned long long status = state & ~kTileValueMask;
+        if (status == kTileStatusInvalid) {
+          continue;  // predecessor has not published yet
+        }
+        exclusive += state & kTileValueMask;
+        if (status == kTileStatusInclusive) {
+          break;
+        }
+        --look;
+      }
+      exclusive_prefix_shared = exclusive;
+      __threadfence();
+      atomicExch(&tile_status[tile_idx],
+                 kTileStatusInclusive | (exclusive + tile_aggregate));
+    }
+    __syncthreads();
+  }
+  const uint64_t tile_exclusive = (tile_idx == 0) ? 0 : exclusive_prefix_shared;
+
+  uint64_t running = tile_exclusive + thread_exclusive;
+#pragma unroll
+  for (int i = 0; i < kFusedUniqueItemsPerThread; ++i) {
+    uint64_t idx = item_start + i;
+    if (idx >= key_num) {
+      break;
+    }
+    running += flags[i];  // inclusive scan value of the boundary flags
+    dst_ids[idx] = static_cast<uint32_t>(running) - 1;
+    if (flags[i]) {
+      unique_keys[running - 1] = sorted_keys[idx];
+      unique_table_ids[running - 1] = table_ids[idx];
+      if (ev_start_indices != nullptr) {
+        ev_start_indices[running - 1] = (static_cast<uint32_t>(running) - 1) * ev_size;
+      }
+    }
+    if (idx == key_num - 1) {
+      *unique_key_num = running;
+    }
+  }
+}
+
 SegmentdUnique::SegmentdUnique(const std::shared_ptr<CoreResourceManager> &core, int max_num_keys,
                                int batch_size, bool need_allocate_wgrad_buffer, int max_ev_size) {
   need_allocate_wgrad_buffer_ = need_allocate_wgrad_buffer;
@@ -721,6 +933,17 @@ SegmentdUnique::SegmentdUnique(const std::shared_ptr<CoreResourceManager> &core,
                                 (uint32_t *)nullptr, max_key_num_);
   cub_scan_temp_buffer_ = core23::Tensor(params.shape({static_cast<int64_t>(cub_scan_temp_bytes_)})
                                              .data_type(core23::ScalarType::Char));
+
+  const char *const fused_unique_env = std::getenv("HCTR_FUSED_SEGMENTED_UNIQUE");
+  use_fused_kernel_ = (fused_unique_env == nullptr || 1 == std::atoi(fused_unique_env));
+  if (need_allocate_wgrad_buffer_) {
+    wgrad_arena_ = std::make_shared<WorkspaceArena>(core);
+  }
+  size_t max_num_tiles = (max_key_num_ + kFusedUniqueTileSize - 1) / kFusedUniqueTileSize;
+  tile_status_buffer_ =
+      core23::Tensor(params.shape({static_cast<int64_t>(std::max<size_t>(max_num_tiles, 1))})
+                         .data_type(core23::ScalarType::UInt64));
+  tile_counter_ = core23::Tensor(params.shape({1}).data_type(core23::ScalarType::UInt32));
 }
 
 void SegmentdUnique::operator()(const core23::Tensor &sorted_keys, const core23::Tensor &table_ids,
@@ -729,6 +952,30 @@ void SegmentdUnique::operator()(const core23::Tensor &sorted_keys, const core23:
                                 int ev_size, std::shared_ptr<CoreResourceManager> core) {
   auto stream = core->get_local_gpu()->get_stream();
   auto key_type = sorted_keys.data_type();
+
+  // the dynamic-wgrad (SOK) path sizes its buffers from the scanned flag buffer, so it
+  // still needs the intermediate scan result; everything else takes the fused sweep
+  if (use_fused_kernel_ && !need_allocate_wgrad_buffer_) {
+    size_t num_tiles = (h_num_key + kFusedUniqueTileSize - 1) / kFusedUniqueTileSize;
+    if (num_tiles == 0) {
+      HCTR_LIB_THROW(cudaMemsetAsync(wgrad.num_unique_keys.data(),
+                                     0, wgrad.num_unique_keys.num_bytes(), stream));
+      return;
+    }
+    HCTR_LIB_THROW(cudaMemsetAsync(tile_status_buffer_.data(), 0,
+                                   num_tiles * sizeof(unsigned long long), stream));
+    HCTR_LIB_THROW(cudaMemsetAsync(tile_counter_.data(), 0, sizeof(unsigned int), stream));
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
+      fused_segmented_unique_kernel<<<num_tiles, kFusedUniqueBlockSize, 0, stream>>>(
+          sorted_keys.data<key_t>(), table_ids.data<int>(), key_num.data<uint64_t>(),
+          tile_status_buffer_.data<unsigned long long>(), tile_counter_.data<unsigned int>(),
+          ev_size, wgrad.unique_keys.data<key_t>(), wgrad.table_ids.data<int>(),
+          is_same_ev_size ? wgrad.ev_start_indices.data<uint32_t>() : nullptr,
+          wgrad.num_unique_keys.data<uint64_t>(), dst_ids.data<uint32_t>());
+    });
+    return;
+  }
+
   const int block_size = 256;
   const int grid_size =
       core->get_kernel_param().num_sms * core->get_kernel_param().max_thread_per_block / block_size;
@@ -749,7 +996,8 @@ void SegmentdUnique::operator()(const core23::Tensor &sorted_keys, const core23:
     HCTR_CHECK_HINT((!wgrad.data_allocated && !wgrad.indices_allocated),
                     "Wgrad should not be allocate before");
     DynamicWgradInitiazlier{}.init_indices_and_data(wgrad, h_num_key, key_flag_buffer_,
-                                                    max_ev_size_, core, stream);
+                                                    max_ev_size_, core, stream,
+                                                    wgrad_arena_.get());
   }
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
@@ -879,6 +1127,7 @@ void LocalReduceIndexCalculation::cal_for_sparse_input(const EmbeddingInput &emb
                                                        SegmentdUnique &segmented_unique,
                                                        ReductionIndices &reduction_indices,
                                                        Wgrad &wgrad, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::index_calculation");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   HCTR_LIB_THROW(cudaGetLastError());
   reduction_indices.num_elements = embedding_input.h_num_keys;
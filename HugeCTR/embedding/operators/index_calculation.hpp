@@ -16,6 +16,8 @@
 #pragma once
 
 #include <embedding/common.hpp>
+#include <embedding/operators/workspace_arena.hpp>
+#include <embedding_storage/common.hpp>
 
 namespace embedding {
 using core::CoreResourceManager;
@@ -101,13 +103,25 @@ struct SortOutput {
 using SortKeyAndSrcIdOp =
     std::function<void(SortInput &, SortOutput &, std::shared_ptr<CoreResourceManager> core)>;
 
+// Radix-sort bit ranges derived from the table vocabularies, so the device
+// sorts only sweep the bits a key can actually occupy instead of the full
+// 64-bit key type. Both fields stay -1 (sort the full key width) when the
+// table list is unavailable or some table is dynamic.
+struct SortBitRange {
+  int key_end_bit{-1};      // bits of the largest table-local key (max vocabulary)
+  int indices_end_bit{-1};  // bits of the largest global index (vocabulary sum)
+};
+
+SortBitRange cal_sort_bit_range(const std::vector<EmbeddingTableParam> &table_params);
+
 struct SegmentedSortDevice {
  public:
   SegmentedSortDevice() = default;
 
   SegmentedSortDevice(const std::shared_ptr<CoreResourceManager> &core,
                       core23::Tensor sorted_table_ids, int max_num_keys, int batch_size,
-                      int num_lookup, int num_table, core23::DataType key_type);
+                      int num_lookup, int num_table, core23::DataType key_type,
+                      int key_end_bit = -1);
 
   void operator()(SortInput &input, SortOutput &output, std::shared_ptr<CoreResourceManager> core);
 
@@ -131,15 +145,23 @@ struct SegmentedSortDevice {
   int num_lookup_;
   int num_table_;
   int batch_size_;
+
+  // When the table vocabularies bound the keys tightly enough, the table id is
+  // packed directly above the key's occupied bits and one plain radix sort over
+  // fused_end_bit_ bits replaces the full-width ComposeTidKey struct sort.
+  bool use_fused_tid_key_{false};
+  int key_end_bit_{-1};
+  int fused_end_bit_{0};
 };
 
 struct IndicesSort {
   core23::Tensor d_temp_sort_storage;
+  int sort_end_bit_{-1};  // -1 sorts the full key width
 
   IndicesSort() = default;
 
   IndicesSort(const std::shared_ptr<CoreResourceManager> &core, int max_num_keys, int batch_size,
-              core23::DataType key_type);
+              core23::DataType key_type, int sort_end_bit = -1);
 
   void operator()(SortInput &input, SortOutput &output, std::shared_ptr<CoreResourceManager> core);
 };
@@ -157,9 +179,19 @@ struct SegmentdUnique {
   core23::Tensor cub_scan_temp_buffer_;  // Void
   core23::Tensor key_flag_buffer_;       // size_t
 
+  // fused single-pass path: flag + decoupled-lookback scan + compaction in one kernel
+  // sweep instead of the flag/cub-scan/compact kernel trio. HCTR_FUSED_SEGMENTED_UNIQUE=0
+  // falls back to the multi-kernel path.
+  bool use_fused_kernel_ = false;
+  core23::Tensor tile_status_buffer_;  // unsigned long long, one entry per scan tile
+  core23::Tensor tile_counter_;        // unsigned int
+
   // for SOK
   bool need_allocate_wgrad_buffer_;
   int max_ev_size_;
+  // iteration-scoped arena backing the dynamically sized wgrad buffers, so the
+  // steady-state step stops allocating once the unique-key high-watermark settles
+  std::shared_ptr<WorkspaceArena> wgrad_arena_;
   SegmentdUnique() = default;
 
   SegmentdUnique(const std::shared_ptr<CoreResourceManager> &core, int max_num_keys, int batch_size,
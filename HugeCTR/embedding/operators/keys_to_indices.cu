@@ -15,6 +15,7 @@
  */
 #include <HugeCTR/embedding/view.hpp>
 #include <HugeCTR/include/utils.cuh>
+#include <cstring>
 
 #include "keys_to_indices.hpp"
 using namespace core;
@@ -22,13 +23,16 @@ using namespace core;
 namespace embedding {
 template <typename key_t, typename offset_t>
 __global__ void keys_to_indices_kernel(key_t* keys, size_t num_keys,
-                                       const offset_t* num_keys_per_lookup_offset, int num_lookups,
+                                       const offset_t* num_keys_per_lookup_offset,
+                                       int64_t offset_stride, int num_lookups,
                                        const int* table_id_list, const int* local_table_ids,
                                        int num_local_table_ids,
                                        const uint64_t* num_keys_per_table_offset,
                                        const int* num_shards) {
   CUDA_1D_KERNEL_LOOP_T(offset_t, tid, num_keys) {
-    int table_id_idx = bs_upper_bound_sub_one(num_keys_per_lookup_offset, num_lookups + 1, tid);
+    int table_id_idx =
+        bs_upper_bound_sub_one_strided(num_keys_per_lookup_offset, offset_stride, num_lookups + 1,
+                                       static_cast<offset_t>(tid));
 
     int table_id = table_id_list[table_id_idx];
     int local_table_id_idx = bs_upper_bound_sub_one(local_table_ids, num_local_table_ids, table_id);
@@ -117,11 +121,22 @@ KeysToIndicesConverter::KeysToIndicesConverter(std::shared_ptr<CoreResourceManag
   }
 }
 
+KeysToIndicesConverter::~KeysToIndicesConverter() {
+  for (auto& slot : staging_slots_) {
+    if (slot.upload_done != nullptr) {
+      cudaEventSynchronize(slot.upload_done);
+      cudaEventDestroy(slot.upload_done);
+    }
+    if (slot.h_keys != nullptr) {
+      cudaFreeHost(slot.h_keys);
+    }
+  }
+}
+
 void KeysToIndicesConverter::convert(core23::Tensor& keys, size_t num_keys,
                                      const core23::Tensor& num_keys_per_lookup_offset,
-                                     const core23::Tensor& table_id_list) {
+                                     const core23::Tensor& table_id_list, cudaStream_t stream) {
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
-  cudaStream_t stream = core_->get_local_gpu()->get_stream();
   if (num_keys == 0) return;
 
   size_t num_lookups = num_keys_per_lookup_offset.num_elements() - 1;
@@ -131,11 +146,69 @@ void KeysToIndicesConverter::convert(core23::Tensor& keys, size_t num_keys,
       constexpr int block_size = 256;
       int grid_size = (num_keys - 1) / block_size + 1;
       keys_to_indices_kernel<<<grid_size, block_size, 0, stream>>>(
-          keys.data<key_t>(), num_keys, num_keys_per_lookup_offset.data<offset_t>(), num_lookups,
+          keys.data<key_t>(), num_keys, num_keys_per_lookup_offset.data<offset_t>(), 1, num_lookups,
           table_id_list.data<int>(), local_table_ids_.data<int>(), local_table_ids_.num_elements(),
           num_keys_per_table_offset_.data<uint64_t>(),
           !h_num_shards_.empty() ? num_shards_.data<int>() : nullptr);
     });
   });
 }
+
+void KeysToIndicesConverter::convert(core23::Tensor& keys, size_t num_keys,
+                                     const core23::Tensor& bucket_range,
+                                     int64_t bucket_range_stride, int num_lookups,
+                                     const core23::Tensor& table_id_list, cudaStream_t stream) {
+  HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
+  if (num_keys == 0) return;
+
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(keys.data_type().type(), key_t, [&] {
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(bucket_range.data_type().type(), offset_t, [&] {
+      constexpr int block_size = 256;
+      int grid_size = (num_keys - 1) / block_size + 1;
+      keys_to_indices_kernel<<<grid_size, block_size, 0, stream>>>(
+          keys.data<key_t>(), num_keys, bucket_range.data<offset_t>(), bucket_range_stride,
+          num_lookups, table_id_list.data<int>(), local_table_ids_.data<int>(),
+          local_table_ids_.num_elements(), num_keys_per_table_offset_.data<uint64_t>(),
+          !h_num_shards_.empty() ? num_shards_.data<int>() : nullptr);
+    });
+  });
+}
+
+void KeysToIndicesConverter::convert_from_host(const void* h_keys, core23::Tensor& keys,
+                                               size_t num_keys,
+                                               const core23::Tensor& num_keys_per_lookup_offset,
+                                               const core23::Tensor& table_id_list,
+                                               cudaStream_t stream) {
+  HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
+  if (num_keys == 0) return;
+
+  size_t num_bytes = num_keys * keys.data_type().size();
+  HCTR_CHECK_HINT(static_cast<int64_t>(num_keys) <= keys.num_elements(),
+                  "convert_from_host: num_keys exceeds the device keys tensor");
+
+  StagingSlot& slot = staging_slots_[next_staging_slot_];
+  next_staging_slot_ = (next_staging_slot_ + 1) % kNumStagingSlots;
+  if (slot.upload_done == nullptr) {
+    HCTR_LIB_THROW(cudaEventCreateWithFlags(&slot.upload_done, cudaEventDisableTiming));
+  } else {
+    // the slot's previous upload must have left the pinned pages before the
+    // host copy may overwrite them; with the other slot in between, this has
+    // typically completed long ago and the sync is free
+    HCTR_LIB_THROW(cudaEventSynchronize(slot.upload_done));
+  }
+  if (slot.capacity_bytes < num_bytes) {
+    if (slot.h_keys != nullptr) {
+      HCTR_LIB_THROW(cudaFreeHost(slot.h_keys));
+    }
+    HCTR_LIB_THROW(cudaHostAlloc(&slot.h_keys, num_bytes, cudaHostAllocDefault));
+    slot.capacity_bytes = num_bytes;
+  }
+
+  std::memcpy(slot.h_keys, h_keys, num_bytes);
+  HCTR_LIB_THROW(
+      cudaMemcpyAsync(keys.data(), slot.h_keys, num_bytes, cudaMemcpyHostToDevice, stream));
+  HCTR_LIB_THROW(cudaEventRecord(slot.upload_done, stream));
+
+  convert(keys, num_keys, num_keys_per_lookup_offset, table_id_list, stream);
+}
 }  // namespace embedding
\ No newline at end of file
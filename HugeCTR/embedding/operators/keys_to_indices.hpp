@@ -16,6 +16,7 @@
 #pragma once
 #include <HugeCTR/embedding/common.hpp>
 #include <HugeCTR/embedding_storage/common.hpp>
+#include <array>
 namespace embedding {
 class KeysToIndicesConverter {
  private:
@@ -28,12 +29,42 @@ class KeysToIndicesConverter {
   core23::Tensor local_table_ids_;
   core23::Tensor num_shards_;
 
+  // Persistent pinned ring buffer for convert_from_host: each request stages
+  // its keys into the next slot, so the pinned pages are registered once and
+  // grow to the high-water request size instead of being allocated per call.
+  // A slot is only recycled after its upload event has completed, which lets
+  // the copy-in of request N+1 overlap the in-place conversion of request N.
+  static constexpr int kNumStagingSlots = 2;
+  struct StagingSlot {
+    void* h_keys = nullptr;
+    size_t capacity_bytes = 0;
+    cudaEvent_t upload_done = nullptr;
+  };
+  std::array<StagingSlot, kNumStagingSlots> staging_slots_;
+  size_t next_staging_slot_ = 0;
+
  public:
   KeysToIndicesConverter(std::shared_ptr<CoreResourceManager> core,
                          const std::vector<EmbeddingTableParam>& table_params,
                          const EmbeddingCollectionParam& ebc_param, size_t grouped_id);
+  ~KeysToIndicesConverter();
+
   void convert(core23::Tensor& keys, size_t num_keys,
                const core23::Tensor& num_keys_per_lookup_offset,
-               const core23::Tensor& table_id_list);
+               const core23::Tensor& table_id_list, cudaStream_t stream);
+
+  // Same conversion, but probing the uncompressed bucket_range directly: the
+  // per-lookup offset of lookup i sits at bucket_range[i * bucket_range_stride],
+  // so callers do not need to gather a compressed offset tensor first.
+  void convert(core23::Tensor& keys, size_t num_keys, const core23::Tensor& bucket_range,
+               int64_t bucket_range_stride, int num_lookups, const core23::Tensor& table_id_list,
+               cudaStream_t stream);
+
+  // Request-serving entry point: uploads `num_keys` host-resident keys of
+  // `keys`' dtype into the device tensor through the pinned ring buffer, then
+  // converts them in place. All device work is stream-ordered on `stream`.
+  void convert_from_host(const void* h_keys, core23::Tensor& keys, size_t num_keys,
+                         const core23::Tensor& num_keys_per_lookup_offset,
+                         const core23::Tensor& table_id_list, cudaStream_t stream);
 };
 }  // namespace embedding
\ No newline at end of file
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <cub/cub.cuh>
+
+#include <core23/macros.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/operators/index_calculation.hpp>
 #include <embedding/operators/model_backward.hpp>
@@ -63,6 +66,10 @@ __global__ void mp_cal_src_ptrs_same_ev_size(const T** src_ptr, const uint32_t*
   return;
 }
 
+__global__ void fill_src_positions(uint32_t* src_positions, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) { src_positions[i] = i; }
+}
+
 void LocalReduce::init(std::shared_ptr<CoreResourceManager> core, int max_ev_size,
                        size_t max_input_num) {
   HugeCTR::CudaDeviceContext ctx(core->get_device_id());
@@ -115,10 +122,38 @@ void LocalReduce::init(std::shared_ptr<CoreResourceManager> core, int max_ev_siz
                          .device(device));
 
   this->partial_reduce_result_.max_input_num = max_input_num;
+
+  const char* const deterministic_env = std::getenv("HCTR_DETERMINISTIC_WGRAD");
+  this->deterministic_local_reduce_ =
+      (deterministic_env != nullptr && 1 == std::atoi(deterministic_env));
+  if (this->deterministic_local_reduce_) {
+    this->src_positions_ = core23::Tensor(core23::TensorParams()
+                                              .shape({static_cast<int64_t>(max_input_num)})
+                                              .data_type(core23::ScalarType::UInt32)
+                                              .device(device));
+    this->sorted_src_positions_ = core23::Tensor(core23::TensorParams()
+                                                     .shape({static_cast<int64_t>(max_input_num)})
+                                                     .data_type(core23::ScalarType::UInt32)
+                                                     .device(device));
+    // holds the sorted reverse indices; sized for the widest bucket range type
+    this->sorted_dst_ids_ =
+        core23::Tensor(core23::TensorParams()
+                           .shape({static_cast<int64_t>(max_input_num * sizeof(uint64_t))})
+                           .data_type(core23::ScalarType::Char)
+                           .device(device));
+    size_t temp_bytes = 0;
+    cub::DeviceRadixSort::SortPairs(nullptr, temp_bytes, (uint64_t*)nullptr, (uint64_t*)nullptr,
+                                    (uint32_t*)nullptr, (uint32_t*)nullptr, max_input_num);
+    this->sort_temp_storage_ = core23::Tensor(core23::TensorParams()
+                                                  .shape({static_cast<int64_t>(temp_bytes)})
+                                                  .data_type(core23::ScalarType::Char)
+                                                  .device(device));
+  }
 }
 
 void LocalReduce::local_reduce(const ReductionIndices& reduction_indices,
                                const ModelCommBuffer& src_buffer, Wgrad& wgrad, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::local_reduce");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
 
@@ -338,6 +373,7 @@ void LocalReduce::local_reduce(const ReductionIndices& reduction_indices,
                                const EmbeddingOutput& src_buffer, Wgrad& wgrad,
                                const core23::Tensor& local_lookup_ids, int num_lookup,
                                int num_global_lookup, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::local_reduce");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
   int batch_size_per_gpu = batch_size / core_->get_global_gpu_count();
@@ -377,6 +413,7 @@ struct DenseModelBackwardOneToOneAtomicDesc {
 // for dense mp
 void LocalReduce::local_reduce(const DenseReductionIndices& reduction_indices,
                                const DenseModelCommBuffer& src_buffer, Wgrad& wgrad) {
+  HCTR_NVTX_RANGE("embedding::local_reduce");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   // int batch_size_per_gpu = batch_size / model_comm_buffer.attr.num_gpus;
   auto stream = core_->get_local_gpu()->get_stream();
@@ -390,15 +427,65 @@ void LocalReduce::local_reduce(const DenseReductionIndices& reduction_indices,
             offset_t* reverse_idx_ptr = reduction_indices.model_reverse_idx->data<offset_t>();
             src_emb_t* src_ptr = (src_emb_t*)src_buffer.data.data();
             dst_emb_t* dst_ptr = (dst_emb_t*)wgrad.data.data();
-            using CopyDesc = DenseModelBackwardOneToOneAtomicDesc<src_emb_t, dst_emb_t, offset_t>;
-            CopyDesc one_to_one_atomic_desc = {num_keys, ev_size, reverse_idx_ptr, src_ptr,
-                                               dst_ptr};
             HCTR_LIB_THROW(cudaMemsetAsync(
                 wgrad.data.data(), 0,
                 reduction_indices.num_valid_dst_tensor * ev_size * wgrad.data.data_type().size(),
                 stream));
-            one_to_one_atomic(one_to_one_atomic_desc, core_->get_kernel_param(), ev_size, num_keys,
-                              stream);
+            if (deterministic_local_reduce_ && num_keys > 0) {
+              // sort the (reverse idx, src position) pairs so duplicates of a key are
+              // contiguous, then accumulate them with the two-stage segmented reduce:
+              // each key's gradients are summed in a fixed order by a single warp per
+              // run, so hot keys no longer serialize on atomics
+              HCTR_CHECK_HINT(num_keys <= partial_reduce_result_.max_input_num,
+                              "dense local reduce: reverse key num exceeds init capacity");
+              uint32_t* src_pos_ptr = src_positions_.data<uint32_t>();
+              uint32_t* sorted_src_pos_ptr = sorted_src_positions_.data<uint32_t>();
+              offset_t* sorted_dst_ids_ptr = (offset_t*)sorted_dst_ids_.data();
+
+              fill_src_positions<<<core_->get_kernel_param().num_sms * 8, 256, 0, stream>>>(
+                  src_pos_ptr, num_keys);
+              size_t temp_bytes = sort_temp_storage_.num_bytes();
+              cub::DeviceRadixSort::SortPairs(sort_temp_storage_.data(), temp_bytes,
+                                              reverse_idx_ptr, sorted_dst_ids_ptr, src_pos_ptr,
+                                              sorted_src_pos_ptr, num_keys, 0,
+                                              sizeof(offset_t) * 8, stream);
+
+              float* partial_grad_ev_ptr = partial_reduce_result_.partial_wgrad_new.data<float>();
+              int32_t* partial_ev_length_ptr =
+                  partial_reduce_result_.partial_ev_length_new.data<int32_t>();
+              uint32_t* partial_dst_id_ptr =
+                  partial_reduce_result_.partial_dst_id_array_new.data<uint32_t>();
+              size_t second_num = (num_keys - 1) / EV_NUM + 1;
+
+              auto multi_to_one_desc_first_stage = make_MultiToOne_reduce_new<src_emb_t, dst_emb_t>(
+                  [=] __device__() { return num_keys; },
+                  [=] __device__(int i) { return ev_size; },
+                  [=] __device__(int i) { return static_cast<uint32_t>(sorted_dst_ids_ptr[i]); },
+                  [=] __device__(int i) {
+                    return src_ptr + static_cast<size_t>(sorted_src_pos_ptr[i]) * ev_size;
+                  },
+                  [=] __device__(int i) {
+                    return dst_ptr + static_cast<size_t>(sorted_dst_ids_ptr[i]) * ev_size;
+                  });
+              auto multi_to_one_desc_second_stage = make_MultiToOne_reduce_new<float, dst_emb_t>(
+                  [=] __device__() { return second_num; },
+                  [=] __device__(int i) { return partial_ev_length_ptr[i]; },
+                  [=] __device__(int i) { return partial_dst_id_ptr[i]; },
+                  [=] __device__(int i) { return partial_grad_ev_ptr + i * ev_size; },
+                  [=] __device__(int i) {
+                    return dst_ptr + static_cast<size_t>(partial_dst_id_ptr[i]) * ev_size;
+                  });
+              multi_to_one_reduce_v2(multi_to_one_desc_first_stage, multi_to_one_desc_second_stage,
+                                     core_->get_kernel_param(), partial_grad_ev_ptr,
+                                     partial_dst_id_ptr, partial_ev_length_ptr, ev_size, num_keys,
+                                     second_num, stream);
+            } else {
+              using CopyDesc = DenseModelBackwardOneToOneAtomicDesc<src_emb_t, dst_emb_t, offset_t>;
+              CopyDesc one_to_one_atomic_desc = {num_keys, ev_size, reverse_idx_ptr, src_ptr,
+                                                 dst_ptr};
+              one_to_one_atomic(one_to_one_atomic_desc, core_->get_kernel_param(), ev_size,
+                                num_keys, stream);
+            }
           });
     });
   });
@@ -46,6 +46,15 @@ class LocalReduce {
   std::shared_ptr<CoreResourceManager> core_;
   PartialReduceResult partial_reduce_result_;
 
+  // HCTR_DETERMINISTIC_WGRAD=1: the dense local reduce sorts (reverse idx, src position)
+  // pairs so duplicate keys become contiguous and are accumulated with the segmented
+  // reduce instead of atomic scatter, removing hot-key contention
+  bool deterministic_local_reduce_ = false;
+  core23::Tensor src_positions_;
+  core23::Tensor sorted_src_positions_;
+  core23::Tensor sorted_dst_ids_;
+  core23::Tensor sort_temp_storage_;
+
  public:
   void init(std::shared_ptr<CoreResourceManager> core, int max_ev_size, size_t max_input_num);
 
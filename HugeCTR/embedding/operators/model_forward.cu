@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <core23/macros.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/operators/model_forward.hpp>
 #include <utils.cuh>
@@ -166,6 +167,7 @@ void DPModelForward::sparse_forward(const core23::Tensor &lookup_res,
 
 void ModelForward::sparse_forward(const core23::Tensor &mp_ev, const core23::Tensor &bucket_range,
                                   ModelCommBuffer &model_comm_buffer, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::model_forward");
   CudaDeviceContext ctx(core_->get_device_id());
   int batch_size_per_gpu = batch_size / model_comm_buffer.attr.num_gpus;
   auto stream = core_->get_local_gpu()->get_stream();
@@ -228,6 +230,7 @@ struct DenseModelForwardOneToOneDesc {
 void ModelForward::dense_forward(const core23::Tensor &mp_ev, const core23::Tensor &reverse_idx,
                                  DenseModelCommBuffer &model_comm_buffer, int batch_size,
                                  size_t num_key) {
+  HCTR_NVTX_RANGE("embedding::model_forward");
   CudaDeviceContext ctx(core_->get_device_id());
   // int batch_size_per_gpu = batch_size / model_comm_buffer.attr.num_gpus;
   auto stream = core_->get_local_gpu()->get_stream();
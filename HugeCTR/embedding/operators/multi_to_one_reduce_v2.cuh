@@ -49,12 +49,20 @@ __global__ void multi_to_one_reduce_vec4_v2(CopyDesc copy_desc, float* partial_b
       tmp_dst_id = copy_desc.get_dst_id(global_index);
       const src_type* tmp_src = copy_desc.get_src_ptr(global_index);
       vec_length = copy_desc.get_src_vec_length(global_index);
+      [[maybe_unused]] float weight = 1.f;
+      if constexpr (has_reduce_weight_v<CopyDesc>) {
+        weight = copy_desc.get_weight(global_index);
+      }
       for (int i = 0; i < kMaxElemPerThread && 4 * kWarpSize * i + 4 * lane_id < vec_length; ++i) {
         Vec4T<src_type> src_elem;
         int idx4 = 4 * kWarpSize * i + 4 * lane_id;
         int n = min(vec_length - idx4, copy_width);
         src_elem.load(tmp_src + idx4, n);
-        accum[i].accumulate(src_elem);
+        if constexpr (has_reduce_weight_v<CopyDesc>) {
+          accum[i].accumulate_multiply(src_elem, weight);
+        } else {
+          accum[i].accumulate(src_elem);
+        }
       }
     }
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <core23/macros.hpp>
 #include <embedding/common.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/operators/network_backward.hpp>
@@ -35,6 +36,7 @@ void network_backward_from_feature_major_top_grad(const core23::Tensor& dp_num_k
   auto& network_attr = network_buffer.attr;
   int batch_size_per_gpu = batch_size / num_gpus;
   int max_ev_size = top_grad_attr.max_ev_size;
+  CombinerSpecialization combiner_spec = specialize_combiner(top_grad_attr.h_id_to_combiner);
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(dp_num_keys_per_bucket.data_type().type(), offset_t, [&] {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(top_grad.data.data_type().type(), emb_t, [&] {
@@ -52,50 +54,60 @@ void network_backward_from_feature_major_top_grad(const core23::Tensor& dp_num_k
         const char* combiner_ptr = top_grad_attr.id_to_combiner.data<char>();
         int num_network_dst_lookup_ids = network_indices.network_dst_lookup_ids.num_elements();
 
-        auto one_to_multi_desc = make_MultiToOne<emb_t, dst_emb_t>(
-            num_network_dst_lookup_ids * batch_size_per_gpu,
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = i % num_network_dst_lookup_ids;
-              return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
-                     network_offsets_ptr[lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              if (combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
-                int idx = batch_size_per_gpu * lookup_id + +bid;
-                return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
-              } else {
-                return 1;
-              }
-            },
-            [=] __device__(int i) {
-              int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-              return d_ev_size_offset_ptr[dst_lookup_id + 1] - d_ev_size_offset_ptr[dst_lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              int ev_offset = d_ev_size_offset_ptr[lookup_id] * batch_size_per_gpu;
-              int ev_size = d_ev_size_offset_ptr[lookup_id + 1] - d_ev_size_offset_ptr[lookup_id];
-              return top_grad_ptr + ev_offset + bid * ev_size;
-            },
-            [=] __device__(int i) {
-              int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
-              int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
-
-              int network_gpu_id = network_gpu_ids_ptr[id];
-              int network_id = network_ids_ptr[id];
-              int ev_offset =
-                  network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
-              int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
-
-              return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
-            });
-        copy_one_to_multi(one_to_multi_desc, kernel_params, max_ev_size, stream);
+        DISPATCH_COMBINER_FUNCTION(combiner_spec, kCombiner, [&] {
+          auto one_to_multi_desc = make_MultiToOne<emb_t, dst_emb_t>(
+              num_network_dst_lookup_ids * batch_size_per_gpu,
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = i % num_network_dst_lookup_ids;
+                return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
+                       network_offsets_ptr[lookup_id];
+              },
+              [=] __device__(int i) {
+                if constexpr (kCombiner == CombinerSpecialization::Sum) {
+                  return 0;
+                } else {
+                  int bid = i / num_network_dst_lookup_ids;
+                  int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                  if constexpr (kCombiner == CombinerSpecialization::Average) {
+                    int idx = batch_size_per_gpu * lookup_id + bid;
+                    return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                  } else {
+                    if (combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
+                      int idx = batch_size_per_gpu * lookup_id + bid;
+                      return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                    }
+                    return 1;
+                  }
+                }
+              },
+              [=] __device__(int i) {
+                int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+                return d_ev_size_offset_ptr[dst_lookup_id + 1] - d_ev_size_offset_ptr[dst_lookup_id];
+              },
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                int ev_offset = d_ev_size_offset_ptr[lookup_id] * batch_size_per_gpu;
+                int ev_size = d_ev_size_offset_ptr[lookup_id + 1] - d_ev_size_offset_ptr[lookup_id];
+                return top_grad_ptr + ev_offset + bid * ev_size;
+              },
+              [=] __device__(int i) {
+                int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
+                int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
+
+                int network_gpu_id = network_gpu_ids_ptr[id];
+                int network_id = network_ids_ptr[id];
+                int ev_offset =
+                    network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
+                int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
+
+                return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
+              });
+          copy_one_to_multi(one_to_multi_desc, kernel_params, max_ev_size, stream);
+        });
       });
     });
   });
@@ -112,6 +124,7 @@ void network_backward_from_batch_major_top_grad(const core23::Tensor& dp_num_key
   int batch_size_per_gpu = batch_size / num_gpus;
   int max_ev_size = top_grad_attr.max_ev_size;
   int num_lookup = top_grad_attr.id_to_ev_size.num_elements();
+  CombinerSpecialization combiner_spec = specialize_combiner(top_grad_attr.h_id_to_combiner);
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(dp_num_keys_per_bucket.data_type().type(), offset_t, [&] {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(top_grad.data.data_type().type(), emb_t, [&] {
@@ -129,49 +142,59 @@ void network_backward_from_batch_major_top_grad(const core23::Tensor& dp_num_key
         const char* combiner_ptr = top_grad_attr.id_to_combiner.data<char>();
         int num_network_dst_lookup_ids = network_indices.network_dst_lookup_ids.num_elements();
 
-        auto one_to_multi_desc = make_MultiToOne<emb_t, dst_emb_t>(
-            num_network_dst_lookup_ids * batch_size_per_gpu,
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = i % num_network_dst_lookup_ids;
-              return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
-                     network_offsets_ptr[lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              if (combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
-                int idx = batch_size_per_gpu * lookup_id + bid;
-                return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
-              } else {
-                return 1;
-              }
-            },
-            [=] __device__(int i) {
-              int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-              return d_ev_size_offset_ptr[dst_lookup_id + 1] - d_ev_size_offset_ptr[dst_lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              int ev_offset = d_ev_size_offset_ptr[num_lookup] * bid;
-              return top_grad_ptr + ev_offset + d_ev_size_offset_ptr[lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
-              int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
-
-              int network_gpu_id = network_gpu_ids_ptr[id];
-              int network_id = network_ids_ptr[id];
-              int ev_offset =
-                  network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
-              int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
-
-              return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
-            });
-        copy_one_to_multi(one_to_multi_desc, kernel_params, max_ev_size, stream);
+        DISPATCH_COMBINER_FUNCTION(combiner_spec, kCombiner, [&] {
+          auto one_to_multi_desc = make_MultiToOne<emb_t, dst_emb_t>(
+              num_network_dst_lookup_ids * batch_size_per_gpu,
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = i % num_network_dst_lookup_ids;
+                return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
+                       network_offsets_ptr[lookup_id];
+              },
+              [=] __device__(int i) {
+                if constexpr (kCombiner == CombinerSpecialization::Sum) {
+                  return 0;
+                } else {
+                  int bid = i / num_network_dst_lookup_ids;
+                  int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                  if constexpr (kCombiner == CombinerSpecialization::Average) {
+                    int idx = batch_size_per_gpu * lookup_id + bid;
+                    return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                  } else {
+                    if (combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
+                      int idx = batch_size_per_gpu * lookup_id + bid;
+                      return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                    }
+                    return 1;
+                  }
+                }
+              },
+              [=] __device__(int i) {
+                int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+                return d_ev_size_offset_ptr[dst_lookup_id + 1] - d_ev_size_offset_ptr[dst_lookup_id];
+              },
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                int ev_offset = d_ev_size_offset_ptr[num_lookup] * bid;
+                return top_grad_ptr + ev_offset + d_ev_size_offset_ptr[lookup_id];
+              },
+              [=] __device__(int i) {
+                int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
+                int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
+
+                int network_gpu_id = network_gpu_ids_ptr[id];
+                int network_id = network_ids_ptr[id];
+                int ev_offset =
+                    network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
+                int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
+
+                return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
+              });
+          copy_one_to_multi(one_to_multi_desc, kernel_params, max_ev_size, stream);
+        });
       });
     });
   });
@@ -369,6 +392,7 @@ void NetworkBackward::sparse_backward(const core23::Tensor& dp_num_keys_per_buck
                                       const EmbeddingOutput& top_grad,
                                       const NetworkIndices& network_indices,
                                       NetworkBuffer& network_buffer, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::network_backward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
   int gpu_id = core_->get_global_gpu_id();
@@ -390,6 +414,7 @@ void NetworkBackward::dense_backward(const EmbeddingInput& embedding_input,
                                      const EmbeddingOutput& top_grad,
                                      const DenseNetworkIndices& network_indices,
                                      DenseNetworkBuffer& network_buffer, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::network_backward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
   int gpu_id = core_->get_global_gpu_id();
@@ -414,6 +439,7 @@ void NetworkBackward::compute(
     const core23::Tensor& network_dst_lookup_ids, const core23::Tensor& network_ev_sizes,
     const core23::Tensor& network_ev_offsets, core23::Tensor& network_comm_buffer,
     const core23::Tensor& d_ev_size_offset, int batch_size, int max_ev_size) {
+  HCTR_NVTX_RANGE("embedding::network_backward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   int batch_size_per_gpu = batch_size / core_->get_global_gpu_count();
   auto stream = core_->get_local_gpu()->get_stream();
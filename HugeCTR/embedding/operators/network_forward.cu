@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <core23/macros.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/operators/network_forward.hpp>
 #include <utils.hpp>
@@ -257,6 +258,7 @@ void network_forward_to_batch_major_output(const core23::Tensor& dp_num_keys_per
   auto& output_attr = embedding_output.attr;
   int max_ev_size = output_attr.max_ev_size;
   int num_lookup = output_attr.id_to_ev_size.num_elements();
+  CombinerSpecialization combiner_spec = specialize_combiner(output_attr.h_id_to_combiner);
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(dp_num_keys_per_bucket.data_type().type(), offset_t, [&] {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(network_comm_buffer.data_type().type(), emb_t, [&] {
@@ -275,50 +277,60 @@ void network_forward_to_batch_major_output(const core23::Tensor& dp_num_keys_per
         dst_emb_t* output_buffer_ptr = output_buffer.data<dst_emb_t>();
         int num_network_dst_lookup_ids = network_indices.network_dst_lookup_ids.num_elements();
 
-        auto multi_to_one_desc = make_MultiToOne<emb_t, dst_emb_t>(
-            num_network_dst_lookup_ids * batch_size_per_gpu,
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = i % num_network_dst_lookup_ids;
-              return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
-                     network_offsets_ptr[lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              if (dst_combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
-                int idx = batch_size_per_gpu * lookup_id + bid;
-                return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
-              } else {
-                return 1;
-              }
-            },
-            [=] __device__(int i) {
-              int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-              return dst_ev_start_indices_ptr[dst_lookup_id + 1] -
-                     dst_ev_start_indices_ptr[dst_lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
-              int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
-
-              int network_gpu_id = network_gpu_ids_ptr[id];
-              int network_id = network_ids_ptr[id];
-              int ev_offset =
-                  network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
-              int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
-
-              return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-              int ev_offset = dst_ev_start_indices_ptr[num_lookup] * bid;
-
-              return output_buffer_ptr + ev_offset + dst_ev_start_indices_ptr[lookup_id];
-            });
-        copy_multi_to_one(multi_to_one_desc, kernel_params, max_ev_size, stream);
+        DISPATCH_COMBINER_FUNCTION(combiner_spec, kCombiner, [&] {
+          auto multi_to_one_desc = make_MultiToOne<emb_t, dst_emb_t>(
+              num_network_dst_lookup_ids * batch_size_per_gpu,
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = i % num_network_dst_lookup_ids;
+                return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
+                       network_offsets_ptr[lookup_id];
+              },
+              [=] __device__(int i) {
+                if constexpr (kCombiner == CombinerSpecialization::Sum) {
+                  return 0;
+                } else {
+                  int bid = i / num_network_dst_lookup_ids;
+                  int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                  if constexpr (kCombiner == CombinerSpecialization::Average) {
+                    int idx = batch_size_per_gpu * lookup_id + bid;
+                    return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                  } else {
+                    if (dst_combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
+                      int idx = batch_size_per_gpu * lookup_id + bid;
+                      return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                    }
+                    return 1;
+                  }
+                }
+              },
+              [=] __device__(int i) {
+                int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+                return dst_ev_start_indices_ptr[dst_lookup_id + 1] -
+                       dst_ev_start_indices_ptr[dst_lookup_id];
+              },
+              [=] __device__(int i) {
+                int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
+                int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
+
+                int network_gpu_id = network_gpu_ids_ptr[id];
+                int network_id = network_ids_ptr[id];
+                int ev_offset =
+                    network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
+                int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
+
+                return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
+              },
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+                int ev_offset = dst_ev_start_indices_ptr[num_lookup] * bid;
+
+                return output_buffer_ptr + ev_offset + dst_ev_start_indices_ptr[lookup_id];
+              });
+          copy_multi_to_one(multi_to_one_desc, kernel_params, max_ev_size, stream);
+        });
       });
     });
   });
@@ -337,6 +349,7 @@ void network_forward_to_feature_major_output(const core23::Tensor& dp_num_keys_p
   auto& network_attr = network_buffer.attr;
   auto& output_attr = embedding_output.attr;
   int max_ev_size = output_attr.max_ev_size;
+  CombinerSpecialization combiner_spec = specialize_combiner(output_attr.h_id_to_combiner);
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(dp_num_keys_per_bucket.data_type().type(), offset_t, [&] {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(network_comm_buffer.data_type().type(), emb_t, [&] {
@@ -355,52 +368,62 @@ void network_forward_to_feature_major_output(const core23::Tensor& dp_num_keys_p
         dst_emb_t* output_buffer_ptr = output_buffer.data<dst_emb_t>();
         int num_network_dst_lookup_ids = network_indices.network_dst_lookup_ids.num_elements();
 
-        auto multi_to_one_desc = make_MultiToOne<emb_t, dst_emb_t>(
-            num_network_dst_lookup_ids * batch_size_per_gpu,
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = i % num_network_dst_lookup_ids;
-              return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
-                     network_offsets_ptr[lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              if (dst_combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
-                int idx = batch_size_per_gpu * lookup_id + bid;
-                return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
-              } else {
-                return 1;
-              }
-            },
-            [=] __device__(int i) {
-              int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-              return dst_ev_start_indices_ptr[dst_lookup_id + 1] -
-                     dst_ev_start_indices_ptr[dst_lookup_id];
-            },
-            [=] __device__(int i) {
-              int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
-              int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
-
-              int network_gpu_id = network_gpu_ids_ptr[id];
-              int network_id = network_ids_ptr[id];
-              int ev_offset =
-                  network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
-              int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
-
-              return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
-            },
-            [=] __device__(int i) {
-              int bid = i / num_network_dst_lookup_ids;
-              int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
-
-              int ev_offset = dst_ev_start_indices_ptr[lookup_id] * batch_size_per_gpu;
-              int ev_size =
-                  dst_ev_start_indices_ptr[lookup_id + 1] - dst_ev_start_indices_ptr[lookup_id];
-              return output_buffer_ptr + ev_offset + bid * ev_size;
-            });
-        copy_multi_to_one(multi_to_one_desc, kernel_params, max_ev_size, stream);
+        DISPATCH_COMBINER_FUNCTION(combiner_spec, kCombiner, [&] {
+          auto multi_to_one_desc = make_MultiToOne<emb_t, dst_emb_t>(
+              num_network_dst_lookup_ids * batch_size_per_gpu,
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = i % num_network_dst_lookup_ids;
+                return bid * network_offsets_ptr[num_network_dst_lookup_ids] +
+                       network_offsets_ptr[lookup_id];
+              },
+              [=] __device__(int i) {
+                if constexpr (kCombiner == CombinerSpecialization::Sum) {
+                  return 0;
+                } else {
+                  int bid = i / num_network_dst_lookup_ids;
+                  int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                  if constexpr (kCombiner == CombinerSpecialization::Average) {
+                    int idx = batch_size_per_gpu * lookup_id + bid;
+                    return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                  } else {
+                    if (dst_combiner_ptr[lookup_id] == static_cast<char>(Combiner::Average)) {
+                      int idx = batch_size_per_gpu * lookup_id + bid;
+                      return static_cast<int>(dp_num_keys_per_bucket_ptr[idx]);
+                    }
+                    return 1;
+                  }
+                }
+              },
+              [=] __device__(int i) {
+                int dst_lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+                return dst_ev_start_indices_ptr[dst_lookup_id + 1] -
+                       dst_ev_start_indices_ptr[dst_lookup_id];
+              },
+              [=] __device__(int i) {
+                int bid = i / network_offsets_ptr[num_network_dst_lookup_ids];
+                int id = i % network_offsets_ptr[num_network_dst_lookup_ids];
+
+                int network_gpu_id = network_gpu_ids_ptr[id];
+                int network_id = network_ids_ptr[id];
+                int ev_offset =
+                    network_ev_offsets_ptr[network_gpu_id][network_id] * batch_size_per_gpu;
+                int ev_size = network_ev_sizes_ptr[network_gpu_id][network_id];
+
+                return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
+              },
+              [=] __device__(int i) {
+                int bid = i / num_network_dst_lookup_ids;
+                int lookup_id = network_dst_lookup_ids_ptr[i % num_network_dst_lookup_ids];
+
+                int ev_offset = dst_ev_start_indices_ptr[lookup_id] * batch_size_per_gpu;
+                int ev_size =
+                    dst_ev_start_indices_ptr[lookup_id + 1] - dst_ev_start_indices_ptr[lookup_id];
+                return output_buffer_ptr + ev_offset + bid * ev_size;
+              });
+          copy_multi_to_one(multi_to_one_desc, kernel_params, max_ev_size, stream);
+        });
       });
     });
   });
@@ -599,6 +622,7 @@ void NetworkForward::sparse_forward(const core23::Tensor& dp_num_keys_per_bucket
                                     const NetworkBuffer& network_buffer,
                                     const NetworkIndices& network_indices,
                                     EmbeddingOutput& embedding_output, int batch_size) {
+  HCTR_NVTX_RANGE("embedding::network_forward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
   int gpu_id = core_->get_global_gpu_id();
@@ -621,6 +645,7 @@ void NetworkForward::dense_forward(const EmbeddingInput& embedding_input,
                                    const DenseNetworkIndices& network_indices,
                                    EmbeddingOutput& embedding_output, int batch_size,
                                    bool do_reduction) {
+  HCTR_NVTX_RANGE("embedding::network_forward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   auto stream = core_->get_local_gpu()->get_stream();
   int gpu_id = core_->get_global_gpu_id();
@@ -645,6 +670,7 @@ void NetworkForward::compute(
     const core23::Tensor& network_dst_lookup_ids, const core23::Tensor& network_ev_sizes,
     const core23::Tensor& network_ev_offsets, core23::Tensor& output_buffer,
     const core23::Tensor& d_ev_size_offset, int batch_size, int max_ev_size) {
+  HCTR_NVTX_RANGE("embedding::network_forward");
   HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
   int batch_size_per_gpu = batch_size / core_->get_global_gpu_count();
   DISPATCH_INTEGRAL_FUNCTION_CORE23(row_lengths.data_type().type(), offset_t, [&] {
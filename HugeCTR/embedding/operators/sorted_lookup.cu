@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cub/cub.cuh>
+#include <embedding/operators/sorted_lookup.hpp>
+#include <utils.cuh>
+
+namespace embedding {
+namespace {
+
+__global__ void iota_kernel(uint32_t *src_ids, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) { src_ids[i] = static_cast<uint32_t>(i); }
+}
+
+__global__ void scatter_lookup_res_kernel(const float **sorted_res, const uint32_t *src_ids,
+                                          const float **res, size_t num_keys) {
+  CUDA_1D_KERNEL_LOOP(i, num_keys) { res[src_ids[i]] = sorted_res[i]; }
+}
+
+}  // namespace
+
+SortedLookup::SortedLookup(std::shared_ptr<CoreResourceManager> core, core23::DataType key_type,
+                           size_t max_num_keys, int num_lookup)
+    : core_(core) {
+  HugeCTR::CudaDeviceContext ctx(core->get_device_id());
+  core23::Device device(core23::DeviceType::GPU, core->get_device_id());
+  core23::TensorParams params = core23::TensorParams().device(device);
+
+  sorted_keys_ =
+      core23::Tensor(params.shape({static_cast<int64_t>(max_num_keys)}).data_type(key_type));
+  src_ids_in_ = core23::Tensor(params.shape({static_cast<int64_t>(max_num_keys)})
+                                   .data_type(core23::ScalarType::UInt32));
+  src_ids_out_ = core23::Tensor(params.shape({static_cast<int64_t>(max_num_keys)})
+                                    .data_type(core23::ScalarType::UInt32));
+  sorted_embedding_vec_ = core23::init_tensor_list<float>(max_num_keys, core->get_device_id());
+
+  // the uint64_t query upper-bounds the temp storage of every supported key type
+  cub::DeviceSegmentedRadixSort::SortPairs(nullptr, cub_sort_temp_bytes_, (uint64_t *)nullptr,
+                                           (uint64_t *)nullptr, (uint32_t *)nullptr,
+                                           (uint32_t *)nullptr, max_num_keys, num_lookup,
+                                           (uint64_t *)nullptr, (uint64_t *)nullptr);
+  cub_sort_temp_buffer_ = core23::Tensor(params.shape({static_cast<int64_t>(cub_sort_temp_bytes_)})
+                                             .data_type(core23::ScalarType::Void));
+}
+
+bool SortedLookup::enabled() {
+  static const bool enabled = [] {
+    const char *env = std::getenv("HCTR_SORTED_LOOKUP");
+    return env != nullptr && 1 == std::atoi(env);
+  }();
+  return enabled;
+}
+
+void SortedLookup::lookup(ILookup *embedding_table, const core23::Tensor &keys, size_t num_keys,
+                          const core23::Tensor &num_keys_per_lookup_offset,
+                          size_t num_lookup_offset, const core23::Tensor &table_id_list,
+                          core23::Tensor &embedding_vec) {
+  HugeCTR::CudaDeviceContext ctx(core_->get_device_id());
+  if (num_keys == 0 || num_lookup_offset < 2) {
+    embedding_table->lookup(keys, num_keys, num_keys_per_lookup_offset, num_lookup_offset,
+                            table_id_list, embedding_vec);
+    return;
+  }
+  auto stream = core_->get_local_gpu()->get_stream();
+
+  iota_kernel<<<144 * 8, 256, 0, stream>>>(src_ids_in_.data<uint32_t>(), num_keys);
+
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(keys.data_type().type(), key_t, [&] {
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(
+        num_keys_per_lookup_offset.data_type().type(), offset_t, [&] {
+          const offset_t *offsets_ptr = num_keys_per_lookup_offset.data<offset_t>();
+          size_t temp_bytes = cub_sort_temp_bytes_;
+          cub::DeviceSegmentedRadixSort::SortPairs(
+              cub_sort_temp_buffer_.data(), temp_bytes, keys.data<key_t>(),
+              sorted_keys_.data<key_t>(), src_ids_in_.data<uint32_t>(),
+              src_ids_out_.data<uint32_t>(), static_cast<int>(num_keys),
+              static_cast<int>(num_lookup_offset - 1), offsets_ptr, offsets_ptr + 1, 0,
+              sizeof(key_t) * 8, stream);
+        });
+  });
+
+  embedding_table->lookup(sorted_keys_, num_keys, num_keys_per_lookup_offset, num_lookup_offset,
+                          table_id_list, sorted_embedding_vec_);
+
+  scatter_lookup_res_kernel<<<144 * 8, 256, 0, stream>>>(
+      (const float **)sorted_embedding_vec_.data(), src_ids_out_.data<uint32_t>(),
+      (const float **)embedding_vec.data(), num_keys);
+}
+
+}  // namespace embedding
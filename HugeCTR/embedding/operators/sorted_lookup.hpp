@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <core/core.hpp>
+#include <embedding/common.hpp>
+#include <embedding/embedding_table.hpp>
+
+namespace embedding {
+
+/**
+ * Optional sort stage in front of the embedding table lookup. The batch's keys are sorted
+ * within each lookup segment (so the per-lookup offsets stay valid), the table is probed in
+ * sorted order — turning its random hash probes and binary searches into quasi-sequential
+ * memory accesses — and the resulting embedding-vector pointer array is scattered back to
+ * the original key order, so everything downstream of the lookup is untouched. Opt-in via
+ * HCTR_SORTED_LOOKUP=1.
+ */
+class SortedLookup {
+ public:
+  SortedLookup() = default;
+
+  SortedLookup(std::shared_ptr<CoreResourceManager> core, core23::DataType key_type,
+               size_t max_num_keys, int num_lookup);
+
+  static bool enabled();
+
+  //! Drop-in replacement for ILookup::lookup with the sort/scatter wrapped around it.
+  void lookup(ILookup *embedding_table, const core23::Tensor &keys, size_t num_keys,
+              const core23::Tensor &num_keys_per_lookup_offset, size_t num_lookup_offset,
+              const core23::Tensor &table_id_list, core23::Tensor &embedding_vec);
+
+ private:
+  std::shared_ptr<CoreResourceManager> core_;
+  core23::Tensor sorted_keys_;
+  core23::Tensor src_ids_in_;          // 0 .. num_keys - 1
+  core23::Tensor src_ids_out_;         // sorted position -> original position
+  core23::Tensor sorted_embedding_vec_;
+  core23::Tensor cub_sort_temp_buffer_;
+  size_t cub_sort_temp_bytes_ = 0;
+};
+
+}  // namespace embedding
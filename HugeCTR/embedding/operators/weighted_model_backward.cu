@@ -17,7 +17,7 @@
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/operators/index_calculation.hpp>  // FIXME: to introduce ReductionIndices
 #include <embedding/operators/model_backward.hpp>     // FIXME: to introduce PartialReduceResult
-#include <embedding/operators/multi_to_one_reduce.cuh>
+#include <embedding/operators/multi_to_one_reduce_v2.cuh>
 #include <embedding/operators/weighted_model_backward.hpp>
 #include <utils.cuh>
 #include <utils.hpp>
@@ -35,8 +35,10 @@ WeightedModelBackward::WeightedModelBackward(std::shared_ptr<CoreResourceManager
       max_ev_size_(max_ev_size),
       num_sms_(num_sms) {
   std::vector<int> num_unique_key_list;
+  int max_hotness_sum = 0;
   for (int i = 0; i < num_local_embedding; ++i) {
     num_unique_key_list.push_back(h_local_hotness_list[i] * h_local_ev_size_list[i]);
+    max_hotness_sum += h_local_hotness_list[i];
   }
 
   int max_unique_key_ev_buffer_size =
@@ -51,18 +53,18 @@ WeightedModelBackward::WeightedModelBackward(std::shared_ptr<CoreResourceManager
                                 .device(device)
                                 .data_type(core23::ScalarType::Float));
 
-  partial_grad_ev_ = core23::Tensor(params.shape({num_sms_ * 4 * max_ev_size_})
+  // one partial entry per EV_NUM-key warp window of the first reduce stage
+  int max_partial_num = (universal_batch_size * max_hotness_sum - 1) / EV_NUM + 1;
+
+  partial_grad_ev_ = core23::Tensor(params.shape({max_partial_num * max_ev_size_})
                                         .device(device)
                                         .data_type(core23::ScalarType::Float));
 
   partial_key_ = core23::Tensor(
-      params.shape({num_sms_ * 4}).device(device).data_type(core23::ScalarType::UInt32));
+      params.shape({max_partial_num}).device(device).data_type(core23::ScalarType::UInt32));
 
   partial_ev_length_ = core23::Tensor(
-      params.shape({num_sms_ * 4}).device(device).data_type(core23::ScalarType::Int32));
-
-  partial_dst_offset_array_ = core23::Tensor(
-      params.shape({num_sms_ * 4}).device(device).data_type(core23::ScalarType::UInt32));
+      params.shape({max_partial_num}).device(device).data_type(core23::ScalarType::Int32));
 }
 
 void WeightedModelBackward::compute(const core23::Tensor& model_comm_buffer,
@@ -83,28 +85,24 @@ void WeightedModelBackward::compute(const core23::Tensor& model_comm_buffer,
     const uint32_t* unique_dst_idx_ptr = unique_dst_idx.data<uint32_t>();
     const emb_t** model_comm_buffer_ptr = static_cast<const emb_t**>(model_comm_buffer.data());
     const int* local_ev_offset_list_ptr = d_local_ev_size_offset.data<int>();
-    const uint32_t* corrdinate_key_ptr = corrdinate_key.data<uint32_t>();
     const float* corrdinate_sp_weight_ptr = coordinate_sp_weight.data<float>();
     const uint32_t* sorted_bucket_id_list_ptr = sorted_bucket_id_list.data<uint32_t>();
     const uint32_t* coordinate_wgrad_dst_idx_ptr = coordinate_wgrad_dst_idx.data<uint32_t>();
     auto partial_grad_ev_ptr = partial_grad_ev_.data<float>();
     auto partial_key_ptr = partial_key_.data<uint32_t>();
     auto partial_ev_length_ptr = partial_ev_length_.data<int32_t>();
-    auto partial_dst_offset_array_ptr = partial_dst_offset_array_.data<uint32_t>();
     float* grad_ev_ptr = grad_ev_.data<float>();
 
-    auto multi_to_one_desc_first_stage = make_MultiToOne_reduce_weight<emb_t, float>(
-        num_model_key, [=] __device__(int i) { return corrdinate_key_ptr[i]; },
+    size_t second_num = (num_model_key - 1) / EV_NUM + 1;
+
+    auto multi_to_one_desc_first_stage = make_MultiToOne_reduce_weight_new<emb_t, float>(
+        [=] __device__() { return num_model_key; },
         [=] __device__(int i) {
           uint32_t src_index = sorted_bucket_id_list_ptr[i];
           int embedding_id = src_index / batch_size;
           return local_ev_offset_list_ptr[embedding_id + 1] -
                  local_ev_offset_list_ptr[embedding_id];
         },
-        [=] __device__(int i) {
-          auto tmp_index = coordinate_wgrad_dst_idx_ptr[i];
-          return unique_dst_idx_ptr[tmp_index + 1] - unique_dst_idx_ptr[tmp_index];
-        },
         [=] __device__(int i) { return coordinate_wgrad_dst_idx_ptr[i]; },
 
         [=] __device__(int i) {
@@ -126,28 +124,20 @@ void WeightedModelBackward::compute(const core23::Tensor& model_comm_buffer,
         },
         [=] __device__(int i) { return corrdinate_sp_weight_ptr[i]; });
 
-    auto multi_to_one_desc_second_stage = make_MultiToOne_reduce_weight<float, float>(
-        num_model_key, [=] __device__(int i) { return partial_key_ptr[i]; },
+    auto multi_to_one_desc_second_stage = make_MultiToOne_reduce_new<float, float>(
+        [=] __device__() { return second_num; },
         [=] __device__(int i) { return partial_ev_length_ptr[i]; },
-        [=] __device__(int i) {
-          auto tmp_index = partial_dst_offset_array_ptr[i];
-          return unique_dst_idx_ptr[tmp_index + 1] - unique_dst_idx_ptr[tmp_index];
-        },
-        [=] __device__(int i) { return 1; },
-
+        [=] __device__(int i) { return partial_key_ptr[i]; },
         [=] __device__(int i) { return partial_grad_ev_ptr + i * max_ev_size; },
 
         [=] __device__(int i) {
-          auto tmp_index = partial_dst_offset_array_ptr[i];
+          auto tmp_index = partial_key_ptr[i];
           return grad_ev_ptr + unique_dst_idx_ptr[tmp_index];
-        },
-        [=] __device__(int i) { return 1.0; });
+        });
 
-    multi_to_one_reduce_weight(multi_to_one_desc_first_stage, multi_to_one_desc_second_stage,
-                               (float*)partial_grad_ev_.data(), (uint32_t*)partial_key_.data(),
-                               (int*)partial_ev_length_.data(),
-                               (uint32_t*)partial_dst_offset_array_.data(), num_sms_, max_ev_size,
-                               stream);
+    multi_to_one_reduce_v2(multi_to_one_desc_first_stage, multi_to_one_desc_second_stage,
+                           core_->get_kernel_param(), partial_grad_ev_ptr, partial_key_ptr,
+                           partial_ev_length_ptr, max_ev_size, num_model_key, second_num, stream);
   });
 
   *grad_ev = grad_ev_;
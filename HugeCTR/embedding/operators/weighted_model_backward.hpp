@@ -31,7 +31,6 @@ class WeightedModelBackward {
   core23::Tensor partial_grad_ev_;
   core23::Tensor partial_key_;
   core23::Tensor partial_ev_length_;
-  core23::Tensor partial_dst_offset_array_;
 
  public:
   WeightedModelBackward() = default;
@@ -66,7 +66,7 @@ void WeightedModelForward::compute(const core23::Tensor &mp_ev, const core23::Te
                      local_batch_id * ev_size;
             },
             [=] __device__(int i) { return sp_weight_ptr[i]; });
-        copy_multi_to_one_weight(multi_to_one_desc, max_ev_size, stream);
+        copy_multi_to_one(multi_to_one_desc, core_->get_kernel_param(), max_ev_size, stream);
       });
     });
   }
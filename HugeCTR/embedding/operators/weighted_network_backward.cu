@@ -99,7 +99,7 @@ void WeightedNetworkBackward::compute(
                   return network_comm_buffer_ptr[network_gpu_id] + ev_offset + bid * ev_size;
                 },
                 [=] __device__(int i) { return 1.0; });
-            copy_one_to_multi_weight(one_to_multi_desc, max_ev_size, stream);
+            copy_one_to_multi(one_to_multi_desc, core_->get_kernel_param(), max_ev_size, stream);
           });
     });
   });
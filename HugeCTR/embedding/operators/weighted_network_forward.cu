@@ -97,7 +97,7 @@ void WeightedNetworkForward::compute(
               return output_buffer_ptr[lookup_id] + bid * ev_size;
             },
             [=] __device__(int i) { return 1.0f; });
-        copy_multi_to_one_weight(multi_to_one_desc, max_ev_size, stream);
+        copy_multi_to_one(multi_to_one_desc, core_->get_kernel_param(), max_ev_size, stream);
       });
     });
   });
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cub/cub.cuh>
+#include <core23/registry.hpp>
+#include <embedding/operators/wgrad_accumulator.hpp>
+#include <utils.cuh>
+#include <utils.hpp>
+
+namespace embedding {
+
+namespace {
+
+constexpr int kMaxAccumProbes = 1024;
+
+DEVICE_INLINE uint64_t accum_slot_signature(uint64_t key, int table_id) {
+  uint64_t x = key ^ (static_cast<uint64_t>(table_id) * 0xc2b2ae3d27d4eb4full);
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x | 1ull;  // 0 marks an empty slot
+}
+
+// Keys are unique within one micro-batch, so at most one thread per launch
+// touches a given (table_id, key) row and the fp32 accumulation needs no
+// atomics; only the slot claim does. Distinct rows whose 64-bit signatures
+// collide would merge, which is negligible at sketchable batch sizes.
+template <typename key_t, typename wgrad_t>
+__global__ void wgrad_accumulate_kernel(const key_t *unique_keys, const uint64_t *num_keys_ptr,
+                                        const int *table_ids, const uint32_t *ev_start_indices,
+                                        const wgrad_t *data, const int *table_id_to_ev_size,
+                                        unsigned long long *slot_signatures,
+                                        unsigned long long *slot_keys, int *slot_table_ids,
+                                        float *slot_data, int64_t num_slots, int max_ev_size,
+                                        unsigned long long *num_dropped) {
+  CUDA_1D_KERNEL_LOOP(i, *num_keys_ptr) {
+    uint64_t key = static_cast<uint64_t>(unique_keys[i]);
+    int table_id = table_ids[i];
+    uint64_t sig = accum_slot_signature(key, table_id);
+
+    int64_t slot = static_cast<int64_t>(sig % num_slots);
+    bool placed = false;
+    for (int probe = 0; probe < kMaxAccumProbes; ++probe) {
+      unsigned long long stored = atomicCAS(slot_signatures + slot, 0ull, sig);
+      if (stored == 0ull) {
+        slot_keys[slot] = key;
+        slot_table_ids[slot] = table_id;
+      }
+      if (stored == 0ull || stored == sig) {
+        int ev_size = table_id_to_ev_size[table_id];
+        const wgrad_t *src = data + ev_start_indices[i];
+        float *dst = slot_data + slot * max_ev_size;
+        for (int j = 0; j < ev_size; ++j) {
+          dst[j] += HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(src[j]);
+        }
+        placed = true;
+        break;
+      }
+      slot = (slot + 1) % num_slots;
+    }
+    if (!placed) {
+      atomicAdd(num_dropped, 1ull);
+    }
+  }
+}
+
+__global__ void wgrad_accum_flag_kernel(const unsigned long long *slot_signatures,
+                                        const int *slot_table_ids, const int *table_id_to_ev_size,
+                                        int64_t num_slots, uint32_t *slot_flags,
+                                        uint32_t *slot_ev_sizes) {
+  CUDA_1D_KERNEL_LOOP(slot, num_slots) {
+    bool occupied = slot_signatures[slot] != 0ull;
+    slot_flags[slot] = occupied ? 1 : 0;
+    slot_ev_sizes[slot] = occupied ? table_id_to_ev_size[slot_table_ids[slot]] : 0;
+  }
+}
+
+template <typename key_t>
+__global__ void wgrad_accum_compact_kernel(const unsigned long long *slot_signatures,
+                                           const unsigned long long *slot_keys,
+                                           const int *slot_table_ids, const float *slot_data,
+                                           const uint32_t *slot_flags, const uint32_t *slot_out_idx,
+                                           const uint32_t *slot_ev_sizes,
+                                           const uint32_t *slot_ev_starts, int64_t num_slots,
+                                           int max_ev_size, key_t *out_unique_keys,
+                                           int *out_table_ids, uint32_t *out_ev_start_indices,
+                                           float *out_data, uint64_t *out_num_unique_keys) {
+  CUDA_1D_KERNEL_LOOP(slot, num_slots) {
+    if (slot == num_slots - 1) {
+      *out_num_unique_keys = slot_out_idx[slot] + slot_flags[slot];
+    }
+    if (slot_signatures[slot] == 0ull) continue;
+
+    uint32_t o = slot_out_idx[slot];
+    out_unique_keys[o] = static_cast<key_t>(slot_keys[slot]);
+    out_table_ids[o] = slot_table_ids[slot];
+    uint32_t ev_start = slot_ev_starts[slot];
+    out_ev_start_indices[o] = ev_start;
+    const float *src = slot_data + slot * max_ev_size;
+    float *dst = out_data + ev_start;
+    for (uint32_t j = 0; j < slot_ev_sizes[slot]; ++j) {
+      dst[j] = src[j];
+    }
+  }
+}
+
+}  // namespace
+
+WgradAccumulator::WgradAccumulator(std::shared_ptr<CoreResourceManager> core, const Wgrad &wgrad,
+                                   int64_t num_slots, int max_ev_size)
+    : core_(core),
+      num_slots_(num_slots),
+      max_ev_size_(max_ev_size),
+      table_id_to_ev_size_(wgrad.attr.table_id_to_ev_size) {
+  HugeCTR::CudaDeviceContext context(core_->get_device_id());
+  core23::Device device(core23::DeviceType::GPU, core_->get_device_id());
+  core23::TensorParams params = core23::TensorParams().device(device);
+
+  slot_signatures_ =
+      core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt64));
+  slot_keys_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt64));
+  slot_table_ids_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::Int32));
+  slot_data_ = core23::Tensor(
+      params.shape({num_slots_ * max_ev_size_}).data_type(core23::ScalarType::Float));
+  num_dropped_ = core23::Tensor(params.shape({1}).data_type(core23::ScalarType::UInt64));
+  h_num_dropped_ = core23::Tensor(params.shape({1})
+                                      .data_type(core23::ScalarType::UInt64)
+                                      .device(core23::DeviceType::CPU));
+
+  slot_flags_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt32));
+  slot_out_idx_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt32));
+  slot_ev_sizes_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt32));
+  slot_ev_starts_ =
+      core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt32));
+
+  size_t temp_bytes = 0;
+  cub::DeviceScan::ExclusiveSum(nullptr, temp_bytes, (uint32_t *)nullptr, (uint32_t *)nullptr,
+                                num_slots_);
+  temp_scan_storage_ = core23::Tensor(
+      params.shape({static_cast<int64_t>(temp_bytes)}).data_type(core23::ScalarType::Char));
+
+  out_unique_keys_ =
+      core23::Tensor(params.shape({num_slots_}).data_type(wgrad.unique_keys.data_type()));
+  out_num_unique_keys_ =
+      core23::Tensor(params.shape({1}).data_type(core23::ScalarType::UInt64));
+  out_table_ids_ = core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::Int32));
+  out_ev_start_indices_ =
+      core23::Tensor(params.shape({num_slots_}).data_type(core23::ScalarType::UInt32));
+  out_data_ = core23::Tensor(
+      params.shape({num_slots_ * max_ev_size_}).data_type(core23::ScalarType::Float));
+
+  HCTR_LIB_THROW(cudaMemset(slot_signatures_.data(), 0, slot_signatures_.num_bytes()));
+  HCTR_LIB_THROW(cudaMemset(slot_data_.data(), 0, slot_data_.num_bytes()));
+  HCTR_LIB_THROW(cudaMemset(num_dropped_.data(), 0, num_dropped_.num_bytes()));
+  *h_num_dropped_.data<uint64_t>() = 0;
+}
+
+void WgradAccumulator::accumulate(const Wgrad &wgrad, cudaStream_t stream) {
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(wgrad.unique_keys.data_type().type(), key_t, [&] {
+    DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(wgrad.data.data_type().type(), wgrad_t, [&] {
+      constexpr int block_size = 256;
+      int grid_size = (wgrad.unique_keys.num_elements() - 1) / block_size + 1;
+      wgrad_accumulate_kernel<<<grid_size, block_size, 0, stream>>>(
+          wgrad.unique_keys.data<key_t>(), wgrad.num_unique_keys.data<uint64_t>(),
+          wgrad.table_ids.data<int>(), wgrad.ev_start_indices.data<uint32_t>(),
+          wgrad.data.data<wgrad_t>(), table_id_to_ev_size_.data<int>(),
+          static_cast<unsigned long long *>(slot_signatures_.data()),
+          static_cast<unsigned long long *>(slot_keys_.data()), slot_table_ids_.data<int>(),
+          slot_data_.data<float>(), num_slots_, max_ev_size_,
+          static_cast<unsigned long long *>(num_dropped_.data()));
+      HCTR_LIB_THROW(cudaPeekAtLastError());
+    });
+  });
+}
+
+void WgradAccumulator::compact_and_reset(cudaStream_t stream) {
+  // the pinned counter holds the value copied at the previous fire; checking it
+  // here avoids a stream sync on the update path
+  if (*h_num_dropped_.data<uint64_t>() != 0) {
+    HCTR_LOG_S(WARNING, ROOT) << *h_num_dropped_.data<uint64_t>()
+                              << " wgrad rows dropped by the gradient accumulator; increase "
+                                 "HCTR_EBC_GRAD_ACCUM_CAPACITY"
+                              << std::endl;
+  }
+
+  constexpr int block_size = 256;
+  int grid_size = (num_slots_ - 1) / block_size + 1;
+  wgrad_accum_flag_kernel<<<grid_size, block_size, 0, stream>>>(
+      static_cast<unsigned long long *>(slot_signatures_.data()), slot_table_ids_.data<int>(),
+      table_id_to_ev_size_.data<int>(), num_slots_, slot_flags_.data<uint32_t>(),
+      slot_ev_sizes_.data<uint32_t>());
+
+  size_t temp_bytes = temp_scan_storage_.num_bytes();
+  cub::DeviceScan::ExclusiveSum(temp_scan_storage_.data(), temp_bytes,
+                                slot_flags_.data<uint32_t>(), slot_out_idx_.data<uint32_t>(),
+                                num_slots_, stream);
+  cub::DeviceScan::ExclusiveSum(temp_scan_storage_.data(), temp_bytes,
+                                slot_ev_sizes_.data<uint32_t>(), slot_ev_starts_.data<uint32_t>(),
+                                num_slots_, stream);
+
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(out_unique_keys_.data_type().type(), key_t, [&] {
+    wgrad_accum_compact_kernel<<<grid_size, block_size, 0, stream>>>(
+        static_cast<unsigned long long *>(slot_signatures_.data()),
+        static_cast<unsigned long long *>(slot_keys_.data()), slot_table_ids_.data<int>(),
+        slot_data_.data<float>(), slot_flags_.data<uint32_t>(), slot_out_idx_.data<uint32_t>(),
+        slot_ev_sizes_.data<uint32_t>(), slot_ev_starts_.data<uint32_t>(), num_slots_, max_ev_size_,
+        out_unique_keys_.data<key_t>(), out_table_ids_.data<int>(),
+        out_ev_start_indices_.data<uint32_t>(), out_data_.data<float>(),
+        out_num_unique_keys_.data<uint64_t>());
+    HCTR_LIB_THROW(cudaPeekAtLastError());
+  });
+
+  HCTR_LIB_THROW(cudaMemcpyAsync(h_num_dropped_.data(), num_dropped_.data(),
+                                 num_dropped_.num_bytes(), cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(slot_signatures_.data(), 0, slot_signatures_.num_bytes(), stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(slot_data_.data(), 0, slot_data_.num_bytes(), stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(num_dropped_.data(), 0, num_dropped_.num_bytes(), stream));
+}
+
+}  // namespace embedding
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <core/core.hpp>
+#include <core23/tensor.hpp>
+#include <embedding/common.hpp>
+#include <memory>
+
+namespace embedding {
+
+/**
+ * @brief Deduplicated micro-batch gradient accumulation for grouped embeddings.
+ *
+ * Folds the per-micro-batch reduced Wgrad into an open-addressed slot table
+ * keyed by (table_id, key), so a key that recurs across micro-batches
+ * accumulates into one fp32 row instead of growing the buffer. When the
+ * effective batch is complete, compact_and_reset() turns the occupied slots
+ * into the flat unique_keys/table_ids/ev_start_indices/data layout that
+ * IGroupedEmbeddingTable::update consumes, and clears the slot table for the
+ * next accumulation window.
+ *
+ * The slot table is bounded: keys that cannot be placed within the probe limit
+ * are dropped and counted, and a warning names the capacity knob
+ * (HCTR_EBC_GRAD_ACCUM_CAPACITY) when that happens.
+ */
+class WgradAccumulator {
+ public:
+  WgradAccumulator(std::shared_ptr<CoreResourceManager> core, const Wgrad &wgrad,
+                   int64_t num_slots, int max_ev_size);
+
+  /**
+   * Fold one micro-batch's reduced wgrad into the slot table.
+   */
+  void accumulate(const Wgrad &wgrad, cudaStream_t stream);
+
+  /**
+   * Compact occupied slots into apply-order arrays and clear the slot table.
+   */
+  void compact_and_reset(cudaStream_t stream);
+
+  const core23::Tensor &unique_keys() const { return out_unique_keys_; }
+  const core23::Tensor &num_unique_keys() const { return out_num_unique_keys_; }
+  const core23::Tensor &table_ids() const { return out_table_ids_; }
+  const core23::Tensor &ev_start_indices() const { return out_ev_start_indices_; }
+  const core23::Tensor &data() const { return out_data_; }
+
+ private:
+  std::shared_ptr<CoreResourceManager> core_;
+  int64_t num_slots_;
+  int max_ev_size_;
+
+  core23::Tensor table_id_to_ev_size_;  // int, shared with the wgrad attr
+
+  core23::Tensor slot_signatures_;  // uint64, hashed (table_id, key), 0 == empty
+  core23::Tensor slot_keys_;        // uint64, exact key of the claiming thread
+  core23::Tensor slot_table_ids_;   // int
+  core23::Tensor slot_data_;        // float, num_slots * max_ev_size
+  core23::Tensor num_dropped_;      // uint64 device counter
+  core23::Tensor h_num_dropped_;    // uint64, pinned copy checked one fire later
+
+  // compaction scratch
+  core23::Tensor slot_flags_;       // uint32, 1 if occupied
+  core23::Tensor slot_out_idx_;     // uint32, exclusive scan of flags
+  core23::Tensor slot_ev_sizes_;    // uint32, ev_size if occupied else 0
+  core23::Tensor slot_ev_starts_;   // uint32, exclusive scan of ev sizes
+  core23::Tensor temp_scan_storage_;
+
+  core23::Tensor out_unique_keys_;
+  core23::Tensor out_num_unique_keys_;
+  core23::Tensor out_table_ids_;
+  core23::Tensor out_ev_start_indices_;
+  core23::Tensor out_data_;
+};
+
+}  // namespace embedding
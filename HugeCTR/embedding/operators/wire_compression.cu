@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_fp16.h>
+
+#include <embedding/operators/wire_compression.hpp>
+#include <utils.cuh>
+#include <utils.hpp>
+
+namespace embedding {
+
+namespace {
+
+__global__ void float_to_half_kernel(const float *__restrict__ src, __half *__restrict__ dst,
+                                     int64_t num_elements) {
+  CUDA_1D_KERNEL_LOOP_T(int64_t, i, num_elements) { dst[i] = __float2half(src[i]); }
+}
+
+__global__ void half_to_float_kernel(const __half *__restrict__ src, float *__restrict__ dst,
+                                     int64_t num_elements) {
+  CUDA_1D_KERNEL_LOOP_T(int64_t, i, num_elements) { dst[i] = __half2float(src[i]); }
+}
+
+constexpr int kWireBlockSize = 256;
+
+inline int wire_grid_size(int64_t num_elements) {
+  return static_cast<int>(
+      std::min<int64_t>((num_elements + kWireBlockSize - 1) / kWireBlockSize, 1024));
+}
+
+}  // namespace
+
+bool wire_compression_enabled(core23::DataType comm_dtype) {
+  const char *const wire_fp16_env = std::getenv("HCTR_EBC_WIRE_FP16");
+  return wire_fp16_env != nullptr && 1 == std::atoi(wire_fp16_env) &&
+         comm_dtype == core23::ScalarType::Float;
+}
+
+std::vector<core23::Tensor> make_fp16_wire_buffer(std::shared_ptr<CoreResourceManager> core,
+                                                  const std::vector<core23::Tensor> &data_list) {
+  HugeCTR::CudaDeviceContext context(core->get_device_id());
+  core23::Device device(core23::DeviceType::GPU, core->get_device_id());
+  core23::TensorParams params = core23::TensorParams().device(device);
+
+  std::vector<core23::Tensor> wire_buffer;
+  for (auto &data : data_list) {
+    wire_buffer.emplace_back(
+        params.shape(data.shape()).data_type(core23::ScalarType::Half));
+  }
+  return wire_buffer;
+}
+
+void compress_fp32_to_fp16(const std::vector<core23::Tensor> &src,
+                           std::vector<core23::Tensor> &dst, cudaStream_t stream) {
+  HCTR_CHECK(src.size() == dst.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    int64_t num_elements = src[i].num_elements();
+    if (num_elements == 0) continue;
+    float_to_half_kernel<<<wire_grid_size(num_elements), kWireBlockSize, 0, stream>>>(
+        src[i].data<float>(), dst[i].data<__half>(), num_elements);
+  }
+}
+
+void decompress_fp16_to_fp32(const std::vector<core23::Tensor> &src,
+                             std::vector<core23::Tensor> &dst, cudaStream_t stream) {
+  HCTR_CHECK(src.size() == dst.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    int64_t num_elements = dst[i].num_elements();
+    if (num_elements == 0) continue;
+    half_to_float_kernel<<<wire_grid_size(num_elements), kWireBlockSize, 0, stream>>>(
+        src[i].data<__half>(), dst[i].data<float>(), num_elements);
+  }
+}
+
+}  // namespace embedding
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <core/core.hpp>
+#include <core23/tensor.hpp>
+#include <vector>
+
+namespace embedding {
+namespace core23 = HugeCTR::core23;
+using core::CoreResourceManager;
+
+// Optional fp16 compression of the model-parallel all-to-all payload
+// (HCTR_EBC_WIRE_FP16=1): fp32 embedding vectors are quantized into half mirrors of
+// the comm buffers right before the exchange and expanded again on the receive side,
+// halving the bytes on the wire. Only meaningful when the collection's emb_type is
+// fp32 -- with mixed precision the wire already carries half.
+
+// true when the env toggle is set and the comm buffers carry fp32
+bool wire_compression_enabled(core23::DataType comm_dtype);
+
+// allocates half-typed mirrors matching the shapes of the given comm buffer list
+std::vector<core23::Tensor> make_fp16_wire_buffer(std::shared_ptr<CoreResourceManager> core,
+                                                  const std::vector<core23::Tensor> &data_list);
+
+void compress_fp32_to_fp16(const std::vector<core23::Tensor> &src,
+                           std::vector<core23::Tensor> &dst, cudaStream_t stream);
+
+void decompress_fp16_to_fp32(const std::vector<core23::Tensor> &src,
+                             std::vector<core23::Tensor> &dst, cudaStream_t stream);
+
+}  // namespace embedding
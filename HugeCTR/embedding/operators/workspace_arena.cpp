@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core23/macros.hpp>
+#include <embedding/operators/workspace_arena.hpp>
+#include <utils.hpp>
+
+namespace embedding {
+
+namespace {
+
+size_t align_up(size_t nbytes) {
+  constexpr size_t alignment = kcudaAllocationAlignment;
+  return (nbytes + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+WorkspaceArena::WorkspaceArena(std::shared_ptr<CoreResourceManager> core)
+    : device_id_(core->get_device_id()) {}
+
+void WorkspaceArena::begin_iteration() {
+  HCTR_CHECK_HINT(device_id_ >= 0, "WorkspaceArena used before initialization");
+  overflow_.clear();
+  offset_ = 0;
+  if (watermark_ <= capacity_) return;
+
+  // Grow to the high-watermark. This is the only place the arena touches the
+  // allocator, and it stops firing once the watermark settles.
+  HugeCTR::CudaDeviceContext context(device_id_);
+  core23::Device device(core23::DeviceType::GPU, device_id_);
+  core23::TensorParams params = core23::TensorParams().device(device);
+  backing_ = core23::Tensor(params.shape({static_cast<int64_t>(watermark_)})
+                                .data_type(core23::ScalarType::Char));
+  // core23 allocates lazily on first data() access; fault the block in here so the
+  // steady-state step never sees the allocation.
+  backing_.data();
+  capacity_ = watermark_;
+}
+
+core23::Tensor WorkspaceArena::allocate(const core23::Shape &shape, core23::DataType data_type) {
+  HCTR_CHECK_HINT(device_id_ >= 0, "WorkspaceArena used before initialization");
+  core23::Device device(core23::DeviceType::GPU, device_id_);
+  size_t nbytes = align_up(static_cast<size_t>(shape.size()) * data_type.size());
+
+  if (offset_ + nbytes <= capacity_) {
+    void *ptr = static_cast<char *>(backing_.data()) + offset_;
+    offset_ += nbytes;
+    watermark_ = std::max(watermark_, offset_);
+    return core23::Tensor::bind(ptr, shape, data_type, device);
+  }
+
+  // The block is too small (first iterations, or a new watermark). Serve the request
+  // from the allocator and record the demand so the next begin_iteration() grows the
+  // block past it.
+  offset_ += nbytes;
+  watermark_ = std::max(watermark_, offset_);
+  HugeCTR::CudaDeviceContext context(device_id_);
+  core23::TensorParams params = core23::TensorParams().device(device);
+  overflow_.emplace_back(params.shape(shape).data_type(data_type));
+  overflow_.back().data();
+  return overflow_.back();
+}
+
+}  // namespace embedding
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <HugeCTR/embedding/common.hpp>
+#include <core23/registry.hpp>
+
+namespace embedding {
+using core::CoreResourceManager;
+
+/**
+ * @brief Iteration-scoped device workspace arena.
+ *
+ * Operators whose workspace size depends on runtime key counts used to create fresh
+ * core23::Tensors every iteration, paying allocator traffic (and the synchronization it
+ * implies) on the steady-state step. The arena instead keeps one backing allocation per
+ * device and hands out 256-byte-aligned sub-tensors with pointer bumps: the backing
+ * block is grown to the observed high-watermark at iteration boundaries, so after the
+ * watermark settles the steady-state step performs no allocations at all.
+ *
+ * Sub-tensors are views into the backing block (core23::Tensor::bind) and are only
+ * valid until the next begin_iteration() call, which may reallocate the block. Callers
+ * must therefore finish all work on an iteration's sub-tensors before starting the
+ * next one; requests that do not fit the current block fall back to a plain allocation
+ * that is kept alive until the next begin_iteration() and folded into the watermark.
+ */
+class WorkspaceArena {
+ public:
+  WorkspaceArena() = default;
+
+  explicit WorkspaceArena(std::shared_ptr<CoreResourceManager> core);
+
+  // Resets the bump pointer and grows the backing block to the high-watermark of the
+  // previous iterations. Must not be called while sub-tensors are still in use.
+  void begin_iteration();
+
+  // Bump-allocates a sub-tensor from the backing block.
+  core23::Tensor allocate(const core23::Shape &shape, core23::DataType data_type);
+
+  size_t watermark_bytes() const { return watermark_; }
+
+ private:
+  int device_id_{-1};
+  core23::Tensor backing_;
+  size_t capacity_{0};
+  size_t offset_{0};
+  size_t watermark_{0};
+  // overflow allocations from iterations whose demand exceeded the current block;
+  // released at the next begin_iteration() once the block has grown to cover them
+  std::vector<core23::Tensor> overflow_;
+};
+
+}  // namespace embedding
@@ -37,4 +37,24 @@ HOST_DEVICE_INLINE int64_t bs_upper_bound_sub_one(const T *const arr, int64_t nu
   }
   return (start == num && arr[start - 1] != target) ? num : start - 1;
 }
+
+// Variant over a strided view: logical element i is arr[i * stride]. Lets consumers
+// binary-search a compressed offset sequence (e.g. every batch_size-th entry of a
+// bucket range) without materializing it with a separate gather kernel first.
+template <typename T>
+HOST_DEVICE_INLINE int64_t bs_upper_bound_sub_one_strided(const T *const arr, int64_t stride,
+                                                          int64_t num, T target) {
+  int64_t start = 0;
+  int64_t end = num;
+  while (start < end) {
+    int64_t middle = start + (end - start) / 2;
+    T value = arr[middle * stride];
+    if (value <= target) {
+      start = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return (start == num && arr[(start - 1) * stride] != target) ? num : start - 1;
+}
 }  // namespace embedding
@@ -78,16 +78,31 @@ struct EmbeddingTableParam {
   int64_t max_vocabulary_size;  // -1 means dynamic
   int ev_size;
 
+  // Optional pre-sizing hint for dynamic tables: number of keys the table is
+  // expected to hold. Dynamic storage reserves capacity for this many keys up
+  // front so it does not have to grow in the middle of a training step.
+  // -1 means unknown.
+  int64_t expected_vocabulary_size = -1;
+
+  // Per-table storage precision: store this table's embedding vectors as fp16,
+  // halving its footprint. Meant for cold long-tail tables; hot tables should
+  // stay in fp32. Only honored by RaggedStaticEmbeddingTable, which requires an
+  // even ev_size for fp16 tables. Lookups still hand fp32 rows to the embedding
+  // ops by dequantizing into a staging buffer; updates write back in fp16.
+  bool half_precision_storage = false;
+
   HugeCTR::OptParams opt_param;
   InitParams init_param;
 
   EmbeddingTableParam() = default;
 
   EmbeddingTableParam(int table_id, int64_t max_vocabulary_size, int ev_size,
-                      HugeCTR::OptParams opt_param, InitParams init_param = InitParams()) {
+                      HugeCTR::OptParams opt_param, InitParams init_param = InitParams(),
+                      int64_t expected_vocabulary_size = -1) {
     this->table_id = table_id;
     this->max_vocabulary_size = max_vocabulary_size;
     this->ev_size = ev_size;
+    this->expected_vocabulary_size = expected_vocabulary_size;
     this->opt_param = opt_param;
     this->init_param = init_param;
   }
@@ -17,6 +17,9 @@
 #include <cuda_runtime_api.h>
 #include <curand_kernel.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <cub/cub.cuh>
 #include <dynamic_embedding_table/dynamic_embedding_table.hpp>
 #include <embedding_storage/dynamic_embedding.hpp>
@@ -44,6 +47,11 @@ DynamicEmbeddingTable::DynamicEmbeddingTable(const HugeCTR::GPUResource &gpu_res
   CudaDeviceContext ctx(core_->get_device_id());
   cudaStream_t stream = core_->get_local_gpu()->get_stream();
 
+  if (const char *const wd_env = std::getenv("HCTR_EMB_WEIGHT_DECAY");
+      wd_env != nullptr && opt_param_.weight_decay == 0.f) {
+    opt_param_.weight_decay = std::atof(wd_env);
+  }
+
   const auto &grouped_table_params = ebc_param.grouped_table_params[grouped_table_id];
   const auto &table_ids = grouped_table_params.table_ids;
 
@@ -77,6 +85,22 @@ DynamicEmbeddingTable::DynamicEmbeddingTable(const HugeCTR::GPUResource &gpu_res
                                                                      dim_per_class.data(), "zeros");
     cast_table<key_t, float>(table_opt_states_)->initialize(stream);
 
+    // Pre-size dynamic storage from the per-table expected vocabulary hints so
+    // capacity growth never happens in the middle of a training step.
+    std::vector<size_t> expected_keys_per_class(table_ids.size(), 0);
+    bool has_capacity_hint = false;
+    for (size_t i = 0; i < table_ids.size(); ++i) {
+      int64_t expected_vocabulary_size = table_params[table_ids[i]].expected_vocabulary_size;
+      if (expected_vocabulary_size > 0) {
+        expected_keys_per_class[i] = static_cast<size_t>(expected_vocabulary_size);
+        has_capacity_hint = true;
+      }
+    }
+    if (has_capacity_hint) {
+      cast_table<key_t, float>(table_)->reserve(expected_keys_per_class.data(), stream);
+      cast_table<key_t, float>(table_opt_states_)->reserve(expected_keys_per_class.data(), stream);
+    }
+
     // Allocate tensor lists to grab information as we run advanced optimzers.
     size_t max_total_hotness = 0;
     for (const LookupParam &lookup_params : ebc_param.lookup_params) {
@@ -90,10 +114,384 @@ DynamicEmbeddingTable::DynamicEmbeddingTable(const HugeCTR::GPUResource &gpu_res
         ebc_param.universal_batch_size * max_total_hotness, core_->get_device_id()));
   });
 
+  const char *const device_tier_env = std::getenv("HCTR_DET_DEVICE_TIER_GB");
+  if (device_tier_env != nullptr && std::atof(device_tier_env) > 0.) {
+    host_tier_enabled_ = true;
+    device_tier_budget_bytes_ =
+        static_cast<size_t>(std::atof(device_tier_env) * (1ul << 30));
+    host_tier_.resize(dim_per_class_.size());
+    HCTR_LOG_S(INFO, ROOT) << "DynamicEmbeddingTable two-tier mode enabled, device tier budget: "
+                           << device_tier_budget_bytes_ << " bytes" << std::endl;
+  }
+
+  const char *const ttl_env = std::getenv("HCTR_DET_TTL_ITERATIONS");
+  if (ttl_env != nullptr && std::atoll(ttl_env) > 0) {
+    ttl_enabled_ = true;
+    ttl_iterations_ = static_cast<uint64_t>(std::atoll(ttl_env));
+    const char *const interval_env = std::getenv("HCTR_DET_TTL_CHECK_INTERVAL");
+    if (interval_env != nullptr && std::atoll(interval_env) > 0) {
+      ttl_check_interval_ = static_cast<uint64_t>(std::atoll(interval_env));
+    }
+    ttl_last_touch_.resize(dim_per_class_.size());
+    HCTR_LOG_S(INFO, ROOT) << "DynamicEmbeddingTable TTL eviction enabled, expiring keys "
+                           << "untouched for " << ttl_iterations_ << " iterations" << std::endl;
+  }
+
+  if (host_tier_enabled_ || ttl_enabled_) {
+    size_t max_total_hotness = 0;
+    for (const LookupParam &lookup_params : ebc_param.lookup_params) {
+      max_total_hotness += lookup_params.max_hotness;
+    }
+    batch_keys_capacity_ =
+        static_cast<size_t>(ebc_param.universal_batch_size) * max_total_hotness;
+    for (size_t i = 0; i < dim_per_class_.size(); ++i) {
+      max_slot_floats_ = std::max(max_slot_floats_, host_tier_slot_floats(i));
+    }
+
+    HCTR_LIB_THROW(cudaHostAlloc(&h_batch_keys_, batch_keys_capacity_ * sizeof(uint64_t),
+                                 cudaHostAllocDefault));
+    HCTR_LIB_THROW(cudaHostAlloc(&h_chunk_keys_, kHostTierChunkKeys * sizeof(uint64_t),
+                                 cudaHostAllocDefault));
+    HCTR_LIB_THROW(cudaMalloc(&d_chunk_keys_, kHostTierChunkKeys * sizeof(uint64_t)));
+    HCTR_LIB_THROW(cudaHostAlloc(&h_chunk_vals_,
+                                 kHostTierChunkKeys * max_slot_floats_ * sizeof(float),
+                                 cudaHostAllocDefault));
+    // one extra chunk-sized region: lookup_by_index scratch while force-inserting keys
+    HCTR_LIB_THROW(
+        cudaMalloc(&d_chunk_vals_, 2 * kHostTierChunkKeys * max_slot_floats_ * sizeof(float)));
+  }
+
   // Await GPU.
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
 }
 
+DynamicEmbeddingTable::~DynamicEmbeddingTable() {
+  if (!host_tier_enabled_ && !ttl_enabled_) {
+    return;
+  }
+  cudaFreeHost(h_batch_keys_);
+  cudaFreeHost(h_chunk_keys_);
+  cudaFree(d_chunk_keys_);
+  cudaFreeHost(h_chunk_vals_);
+  cudaFree(d_chunk_vals_);
+  for (auto &host_tier_table : host_tier_) {
+    for (float *block : host_tier_table.blocks) {
+      cudaFreeHost(block);
+    }
+  }
+}
+
+float *DynamicEmbeddingTable::host_tier_slot_ptr(size_t local_table, size_t slot) {
+  auto &host_tier_table = host_tier_[local_table];
+  return host_tier_table.blocks[slot / kHostTierSlotsPerBlock] +
+         (slot % kHostTierSlotsPerBlock) * host_tier_slot_floats(local_table);
+}
+
+size_t DynamicEmbeddingTable::host_tier_acquire_slot(size_t local_table) {
+  auto &host_tier_table = host_tier_[local_table];
+  if (host_tier_table.free_slots.empty()) {
+    float *block;
+    HCTR_LIB_THROW(cudaHostAlloc(
+        &block, kHostTierSlotsPerBlock * host_tier_slot_floats(local_table) * sizeof(float),
+        cudaHostAllocDefault));
+    host_tier_table.blocks.push_back(block);
+    host_tier_table.free_slots.reserve(kHostTierSlotsPerBlock);
+    for (size_t i = 0; i < kHostTierSlotsPerBlock; ++i) {
+      host_tier_table.free_slots.push_back(host_tier_table.num_slots + i);
+    }
+    host_tier_table.num_slots += kHostTierSlotsPerBlock;
+  }
+  size_t slot = host_tier_table.free_slots.back();
+  host_tier_table.free_slots.pop_back();
+  return slot;
+}
+
+void DynamicEmbeddingTable::host_tier_clear() {
+  for (auto &host_tier_table : host_tier_) {
+    host_tier_table.slot_of_key.clear();
+    host_tier_table.last_seen.clear();
+    host_tier_table.free_slots.clear();
+    for (size_t i = 0; i < host_tier_table.num_slots; ++i) {
+      host_tier_table.free_slots.push_back(i);
+    }
+  }
+}
+
+template <typename key_t>
+void DynamicEmbeddingTable::stage_batch_keys(const core23::Tensor &keys, size_t num_keys,
+                                             cudaStream_t stream) {
+  HCTR_CHECK_HINT(num_keys <= batch_keys_capacity_,
+                  "DynamicEmbeddingTable: batch exceeds staging capacity");
+  HCTR_LIB_THROW(cudaMemcpyAsync(h_batch_keys_, keys.data<key_t>(), num_keys * sizeof(key_t),
+                                 cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  ++current_iteration_;
+}
+
+// reads the batch keys staged into h_batch_keys_ by stage_batch_keys
+template <typename key_t>
+void DynamicEmbeddingTable::fetch_from_host_tier(const std::vector<size_t> &id_space_list,
+                                                 const std::vector<size_t> &id_space_offset,
+                                                 cudaStream_t stream) {
+  key_t *h_keys = static_cast<key_t *>(h_batch_keys_);
+  auto table = cast_table<key_t, float>(table_);
+  auto table_opt_states = cast_table<key_t, float>(table_opt_states_);
+
+  for (size_t i = 0; i < id_space_list.size(); ++i) {
+    size_t local_table = id_space_list[i];
+    auto &host_tier_table = host_tier_[local_table];
+
+    std::vector<std::pair<uint64_t, size_t>> fetch_list;
+    for (size_t k = id_space_offset[i]; k < id_space_offset[i + 1]; ++k) {
+      uint64_t key = static_cast<uint64_t>(h_keys[k]);
+      host_tier_table.last_seen[key] = current_iteration_;
+      auto it = host_tier_table.slot_of_key.find(key);
+      if (it != host_tier_table.slot_of_key.end()) {
+        fetch_list.emplace_back(it->first, it->second);
+        // erase immediately so duplicate keys within the batch fetch once
+        host_tier_table.slot_of_key.erase(it);
+      }
+    }
+    if (fetch_list.empty()) {
+      continue;
+    }
+
+    size_t ev_size = dim_per_class_[local_table];
+    size_t opt_floats = ev_size * opt_param_.num_parameters_per_weight();
+    for (size_t begin = 0; begin < fetch_list.size(); begin += kHostTierChunkKeys) {
+      size_t chunk = std::min(kHostTierChunkKeys, fetch_list.size() - begin);
+
+      key_t *h_chunk_keys = static_cast<key_t *>(h_chunk_keys_);
+      float *h_weights = h_chunk_vals_;
+      float *h_opt_states = h_chunk_vals_ + chunk * ev_size;
+      for (size_t j = 0; j < chunk; ++j) {
+        auto [key, slot] = fetch_list[begin + j];
+        h_chunk_keys[j] = static_cast<key_t>(key);
+        const float *slot_ptr = host_tier_slot_ptr(local_table, slot);
+        memcpy(h_weights + j * ev_size, slot_ptr, ev_size * sizeof(float));
+        if (opt_floats > 0) {
+          memcpy(h_opt_states + j * opt_floats, slot_ptr + ev_size, opt_floats * sizeof(float));
+        }
+        host_tier_[local_table].free_slots.push_back(slot);
+      }
+
+      key_t *d_keys = static_cast<key_t *>(d_chunk_keys_);
+      float *d_weights = d_chunk_vals_;
+      float *d_opt_states = d_chunk_vals_ + chunk * ev_size;
+      float *d_scratch = d_chunk_vals_ + kHostTierChunkKeys * max_slot_floats_;
+      HCTR_LIB_THROW(cudaMemcpyAsync(d_keys, h_chunk_keys, chunk * sizeof(key_t),
+                                     cudaMemcpyHostToDevice, stream));
+      HCTR_LIB_THROW(cudaMemcpyAsync(d_weights, h_weights,
+                                     chunk * (ev_size + opt_floats) * sizeof(float),
+                                     cudaMemcpyHostToDevice, stream));
+
+      // Same pattern as load_by_id: lookup_by_index force-inserts the keys,
+      // scatter_update_by_index then overwrites them with the spilled values.
+      table->lookup_by_index(local_table, d_keys, d_scratch, chunk, stream);
+      table->scatter_update_by_index(local_table, d_keys, d_weights, chunk, stream);
+      if (opt_floats > 0) {
+        table_opt_states->lookup_by_index(local_table, d_keys, d_scratch, chunk, stream);
+        table_opt_states->scatter_update_by_index(local_table, d_keys, d_opt_states, chunk,
+                                                  stream);
+      }
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    }
+  }
+}
+
+template <typename key_t>
+void DynamicEmbeddingTable::evict_to_host_tier(cudaStream_t stream) {
+  auto table = cast_table<key_t, float>(table_);
+  auto table_opt_states = cast_table<key_t, float>(table_opt_states_);
+
+  auto weight_sizes = table->size_per_class();
+  auto opt_state_sizes = table_opt_states->size_per_class();
+  size_t device_bytes = 0;
+  for (size_t i = 0; i < weight_sizes.size(); ++i) {
+    device_bytes += (weight_sizes[i] + opt_state_sizes[i]) * sizeof(float);
+  }
+  if (device_bytes <= device_tier_budget_bytes_) {
+    return;
+  }
+  // evict 10% below the budget at once so eviction stays amortized
+  size_t target_bytes = device_tier_budget_bytes_ - device_tier_budget_bytes_ / 10;
+
+  struct Candidate {
+    uint64_t last_seen;
+    uint64_t key;
+    uint32_t local_table;
+  };
+  std::vector<Candidate> candidates;
+  for (size_t i = 0; i < host_tier_.size(); ++i) {
+    for (const auto &[key, last_seen] : host_tier_[i].last_seen) {
+      candidates.push_back({last_seen, key, static_cast<uint32_t>(i)});
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &lhs, const Candidate &rhs) { return lhs.last_seen < rhs.last_seen; });
+
+  std::vector<std::vector<uint64_t>> evict_keys(host_tier_.size());
+  for (const auto &candidate : candidates) {
+    if (device_bytes <= target_bytes) {
+      break;
+    }
+    evict_keys[candidate.local_table].push_back(candidate.key);
+    device_bytes -= host_tier_slot_floats(candidate.local_table) * sizeof(float);
+  }
+
+  for (size_t local_table = 0; local_table < host_tier_.size(); ++local_table) {
+    auto &host_tier_table = host_tier_[local_table];
+    const auto &keys_to_evict = evict_keys[local_table];
+    size_t ev_size = dim_per_class_[local_table];
+    size_t opt_floats = ev_size * opt_param_.num_parameters_per_weight();
+
+    for (size_t begin = 0; begin < keys_to_evict.size(); begin += kHostTierChunkKeys) {
+      size_t chunk = std::min(kHostTierChunkKeys, keys_to_evict.size() - begin);
+
+      key_t *h_chunk_keys = static_cast<key_t *>(h_chunk_keys_);
+      for (size_t j = 0; j < chunk; ++j) {
+        h_chunk_keys[j] = static_cast<key_t>(keys_to_evict[begin + j]);
+      }
+      key_t *d_keys = static_cast<key_t *>(d_chunk_keys_);
+      float *d_weights = d_chunk_vals_;
+      float *d_opt_states = d_chunk_vals_ + chunk * ev_size;
+      float *h_weights = h_chunk_vals_;
+      float *h_opt_states = h_chunk_vals_ + chunk * ev_size;
+      HCTR_LIB_THROW(cudaMemcpyAsync(d_keys, h_chunk_keys, chunk * sizeof(key_t),
+                                     cudaMemcpyHostToDevice, stream));
+      table->lookup_by_index(local_table, d_keys, d_weights, chunk, stream);
+      if (opt_floats > 0) {
+        table_opt_states->lookup_by_index(local_table, d_keys, d_opt_states, chunk, stream);
+      }
+      HCTR_LIB_THROW(cudaMemcpyAsync(h_weights, d_weights,
+                                     chunk * (ev_size + opt_floats) * sizeof(float),
+                                     cudaMemcpyDeviceToHost, stream));
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+      for (size_t j = 0; j < chunk; ++j) {
+        uint64_t key = keys_to_evict[begin + j];
+        size_t slot = host_tier_acquire_slot(local_table);
+        float *slot_ptr = host_tier_slot_ptr(local_table, slot);
+        memcpy(slot_ptr, h_weights + j * ev_size, ev_size * sizeof(float));
+        if (opt_floats > 0) {
+          memcpy(slot_ptr + ev_size, h_opt_states + j * opt_floats, opt_floats * sizeof(float));
+        }
+        host_tier_table.slot_of_key[key] = slot;
+        host_tier_table.last_seen.erase(key);
+      }
+
+      size_t id_spaces[] = {local_table};
+      size_t id_space_offsets[] = {0, chunk};
+      table->remove(d_keys, chunk, id_spaces, id_space_offsets, 1, stream);
+      if (opt_floats > 0) {
+        table_opt_states->remove(d_keys, chunk, id_spaces, id_space_offsets, 1, stream);
+      }
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    }
+  }
+}
+
+// reads the batch keys staged into h_batch_keys_ by stage_batch_keys
+template <typename key_t>
+void DynamicEmbeddingTable::touch_batch_keys(const std::vector<size_t> &id_space_list,
+                                             const std::vector<size_t> &id_space_offset) {
+  const key_t *h_keys = static_cast<const key_t *>(h_batch_keys_);
+  for (size_t i = 0; i < id_space_list.size(); ++i) {
+    auto &last_touch = ttl_last_touch_[id_space_list[i]];
+    for (size_t k = id_space_offset[i]; k < id_space_offset[i + 1]; ++k) {
+      last_touch[static_cast<uint64_t>(h_keys[k])] = current_iteration_;
+    }
+  }
+}
+
+template <typename key_t>
+void DynamicEmbeddingTable::compact_expired_keys(cudaStream_t stream) {
+  auto table = cast_table<key_t, float>(table_);
+  auto table_opt_states = cast_table<key_t, float>(table_opt_states_);
+
+  for (size_t local_table = 0; local_table < ttl_last_touch_.size(); ++local_table) {
+    auto &last_touch = ttl_last_touch_[local_table];
+    std::vector<uint64_t> expired;
+    for (auto it = last_touch.begin(); it != last_touch.end();) {
+      if (current_iteration_ - it->second >= ttl_iterations_) {
+        expired.push_back(it->first);
+        it = last_touch.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (expired.empty()) {
+      continue;
+    }
+
+    size_t ev_size = dim_per_class_[local_table];
+    size_t opt_floats = ev_size * opt_param_.num_parameters_per_weight();
+    int table_id = h_table_ids_[local_table];
+    key_t *h_chunk_keys = static_cast<key_t *>(h_chunk_keys_);
+
+    // expired keys that were spilled to the host tier never touch the device:
+    // archive them straight from their pinned slots and free the slots
+    std::vector<uint64_t> device_expired;
+    if (host_tier_enabled_) {
+      auto &host_tier_table = host_tier_[local_table];
+      size_t num_spilled = 0;
+      auto flush_spilled = [&] {
+        if (num_spilled > 0 && evict_callback_) {
+          evict_callback_(table_id, h_chunk_keys, num_spilled, h_chunk_vals_,
+                          static_cast<int>(ev_size));
+        }
+        num_spilled = 0;
+      };
+      for (uint64_t key : expired) {
+        auto it = host_tier_table.slot_of_key.find(key);
+        if (it == host_tier_table.slot_of_key.end()) {
+          host_tier_table.last_seen.erase(key);
+          device_expired.push_back(key);
+          continue;
+        }
+        h_chunk_keys[num_spilled] = static_cast<key_t>(key);
+        memcpy(h_chunk_vals_ + num_spilled * ev_size, host_tier_slot_ptr(local_table, it->second),
+               ev_size * sizeof(float));
+        host_tier_table.free_slots.push_back(it->second);
+        host_tier_table.slot_of_key.erase(it);
+        if (++num_spilled == kHostTierChunkKeys) {
+          flush_spilled();
+        }
+      }
+      flush_spilled();
+    } else {
+      device_expired = std::move(expired);
+    }
+
+    for (size_t begin = 0; begin < device_expired.size(); begin += kHostTierChunkKeys) {
+      size_t chunk = std::min(kHostTierChunkKeys, device_expired.size() - begin);
+
+      for (size_t j = 0; j < chunk; ++j) {
+        h_chunk_keys[j] = static_cast<key_t>(device_expired[begin + j]);
+      }
+      key_t *d_keys = static_cast<key_t *>(d_chunk_keys_);
+      HCTR_LIB_THROW(cudaMemcpyAsync(d_keys, h_chunk_keys, chunk * sizeof(key_t),
+                                     cudaMemcpyHostToDevice, stream));
+      if (evict_callback_) {
+        float *d_weights = d_chunk_vals_;
+        table->lookup_by_index(local_table, d_keys, d_weights, chunk, stream);
+        HCTR_LIB_THROW(cudaMemcpyAsync(h_chunk_vals_, d_weights, chunk * ev_size * sizeof(float),
+                                       cudaMemcpyDeviceToHost, stream));
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+        evict_callback_(table_id, h_chunk_keys, chunk, h_chunk_vals_, static_cast<int>(ev_size));
+      }
+
+      size_t id_spaces[] = {local_table};
+      size_t id_space_offsets[] = {0, chunk};
+      table->remove(d_keys, chunk, id_spaces, id_space_offsets, 1, stream);
+      if (opt_floats > 0) {
+        table_opt_states->remove(d_keys, chunk, id_spaces, id_space_offsets, 1, stream);
+      }
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    }
+  }
+}
+
 std::vector<size_t> DynamicEmbeddingTable::remap_id_space(const std::vector<int> &idsl_cpu) {
   std::vector<size_t> local_idsl_cpu;
   for (size_t i = 0; i < idsl_cpu.size(); ++i) {
@@ -149,12 +547,27 @@ void DynamicEmbeddingTable::lookup(const core23::Tensor &keys, size_t num_keys,
   });
   if (num_keys > 0) {
     DISPATCH_INTEGRAL_FUNCTION_CORE23(keys.data_type().type(), key_t, [&] {
+      if (host_tier_enabled_ || ttl_enabled_) {
+        stage_batch_keys<key_t>(keys, num_keys, stream);
+      }
+      if (host_tier_enabled_) {
+        // bring host-resident keys of this batch back into the hot tier first, so
+        // lookup_unsafe resolves them instead of re-initializing fresh vectors
+        fetch_from_host_tier<key_t>(mapped_id_space_list, id_space_offset_cpu, stream);
+      }
+      if (ttl_enabled_) {
+        touch_batch_keys<key_t>(mapped_id_space_list, id_space_offset_cpu);
+      }
       auto table = cast_table<key_t, float>(table_);
 
       table->lookup_unsafe(keys.data<key_t>(), (float **)emb_vec.data(), num_keys,
                            mapped_id_space_list.data(), id_space_offset_cpu.data(),
                            num_id_space_offset - 1, stream);
       HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+      if (ttl_enabled_ && current_iteration_ % ttl_check_interval_ == 0) {
+        compact_expired_keys<key_t>(stream);
+      }
     });
   }
 }
@@ -206,6 +619,20 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
       DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(wgrad.data_type().type(), wgrad_t, [&] {
         wgrad_t *wgrad_ptr = const_cast<wgrad_t *>(wgrad.data<wgrad_t>());
 
+        // Decoupled weight decay folds `-lr * wd * w` into the update delta, so
+        // the kernels need the current rows of this batch; resolve them once the
+        // same way the FTRL path does. FTRL itself is exempt because it carries
+        // its own lambda1/lambda2 regularization.
+        const float wd_mul_lr = opt_param_.lr * opt_param_.weight_decay;
+        float **decay_weight_ptrs = nullptr;
+        if (wd_mul_lr != 0.f && opt_param_.optimizer != HugeCTR::Optimizer_t::Ftrl) {
+          auto table = cast_table<key_t, float>(table_);
+          table->lookup_unsafe(unique_keys.data<key_t>(), (float **)weight_view_->data(),
+                               num_unique_keys_cpu, mapped_unique_table_ids.data(),
+                               table_range_cpu.data(), num_table, stream);
+          decay_weight_ptrs = (float **)weight_view_->data();
+        }
+
         switch (opt_param_.optimizer) {
           case HugeCTR::Optimizer_t::Ftrl: {
             auto table_opt_states = cast_table<key_t, float>(table_opt_states_);
@@ -241,13 +668,14 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
             const float lr_scaled_bias = opt_param_.lr * opt_param_.hyperparams.adam.bias();
 
             constexpr int block_size = 256;
-            const int grid_size = (static_cast<int64_t>(num_unique_keys_cpu) - 1) / block_size + 1;
+            const int grid_size =
+                (static_cast<int64_t>(num_unique_keys_cpu) * 32 - 1) / block_size + 1;
 
-            adam_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
+            adam_update_grad_kernel4<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, lr_scaled_bias,
                 opt_param_.hyperparams.adam.beta1, opt_param_.hyperparams.adam.beta2,
-                (float **)opt_state_view_->data(), opt_param_.hyperparams.adam.epsilon,
-                opt_param_.scaler, wgrad_ptr);
+                (float **)opt_state_view_->data(), decay_weight_ptrs, wd_mul_lr,
+                opt_param_.hyperparams.adam.epsilon, opt_param_.scaler, wgrad_ptr);
           } break;
 
           case HugeCTR::Optimizer_t::RMSProp: {
@@ -262,7 +690,8 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
             rms_prop_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, opt_param_.lr,
                 opt_param_.hyperparams.rmsprop.beta, (float **)opt_state_view_->data(),
-                opt_param_.hyperparams.rmsprop.epsilon, opt_param_.scaler, wgrad_ptr);
+                decay_weight_ptrs, wd_mul_lr, opt_param_.hyperparams.rmsprop.epsilon,
+                opt_param_.scaler, wgrad_ptr);
           } break;
 
           case HugeCTR::Optimizer_t::AdaGrad: {
@@ -272,12 +701,13 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
                 mapped_unique_table_ids.data(), table_range_cpu.data(), num_table, stream);
 
             constexpr int block_size = 256;
-            const int grid_size = (static_cast<int64_t>(num_unique_keys_cpu) - 1) / block_size + 1;
+            const int grid_size =
+                (static_cast<int64_t>(num_unique_keys_cpu) * 32 - 1) / block_size + 1;
 
-            ada_grad_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
+            ada_grad_update_grad_kernel4<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, opt_param_.lr,
-                (float **)opt_state_view_->data(), opt_param_.hyperparams.adagrad.epsilon,
-                opt_param_.scaler, wgrad_ptr);
+                (float **)opt_state_view_->data(), decay_weight_ptrs, wd_mul_lr,
+                opt_param_.hyperparams.adagrad.epsilon, opt_param_.scaler, wgrad_ptr);
           } break;
 
           case HugeCTR::Optimizer_t::MomentumSGD: {
@@ -292,7 +722,7 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
             momentum_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, opt_param_.lr,
                 opt_param_.hyperparams.momentum.factor, (float **)opt_state_view_->data(),
-                opt_param_.scaler, wgrad_ptr);
+                decay_weight_ptrs, wd_mul_lr, opt_param_.scaler, wgrad_ptr);
           } break;
 
           case HugeCTR::Optimizer_t::Nesterov: {
@@ -307,16 +737,17 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
             nesterov_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, opt_param_.lr,
                 opt_param_.hyperparams.nesterov.mu, (float **)opt_state_view_->data(),
-                opt_param_.scaler, wgrad_ptr);
+                decay_weight_ptrs, wd_mul_lr, opt_param_.scaler, wgrad_ptr);
           } break;
 
           case HugeCTR::Optimizer_t::SGD: {
             constexpr int block_size = 256;
-            const int grid_size = (static_cast<int64_t>(num_unique_keys_cpu) - 1) / block_size + 1;
+            const int grid_size =
+                (static_cast<int64_t>(num_unique_keys_cpu) * 32 - 1) / block_size + 1;
 
-            sgd_update_grad_kernel<<<grid_size, block_size, 0, stream>>>(
+            sgd_update_grad_kernel4<<<grid_size, block_size, 0, stream>>>(
                 ev_start_indices.data<uint32_t>(), num_unique_keys_cpu, opt_param_.lr,
-                opt_param_.scaler, wgrad_ptr);
+                decay_weight_ptrs, wd_mul_lr, opt_param_.scaler, wgrad_ptr);
           } break;
 
           default:
@@ -331,6 +762,10 @@ void DynamicEmbeddingTable::update(const core23::Tensor &unique_keys,
                            mapped_unique_table_ids.data(), table_range_cpu.data(), num_table,
                            stream);
         HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+        if (host_tier_enabled_) {
+          evict_to_host_tier<key_t>(stream);
+        }
       });
     });
   }
@@ -406,10 +841,11 @@ void DynamicEmbeddingTable::dump_by_id(core23::Tensor *h_keys_tensor,
     key_t *d_keys;
     float *d_values;
     auto values_sizes = table->size_per_class();
-    auto key_nums = this->key_num_per_table();
 
-    auto key_num = key_nums[table_index];
+    // size_per_class only covers the device tier; host-resident vectors are
+    // appended behind the exported ones below
     auto values_size = values_sizes[table_index];
+    auto key_num = values_size / dim_per_class_[table_index];
 
     HCTR_LIB_THROW(cudaMalloc(&d_keys, sizeof(key_t) * key_num));
     HCTR_LIB_THROW(cudaMalloc(&d_values, sizeof(float) * values_size));
@@ -426,6 +862,17 @@ void DynamicEmbeddingTable::dump_by_id(core23::Tensor *h_keys_tensor,
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
     HCTR_LIB_THROW(cudaFree(d_keys));
     HCTR_LIB_THROW(cudaFree(d_values));
+
+    if (host_tier_enabled_) {
+      size_t ev_size = dim_per_class_[table_index];
+      size_t i = 0;
+      for (const auto &[key, slot] : host_tier_[table_index].slot_of_key) {
+        h_keys[key_num + i] = static_cast<key_t>(key);
+        memcpy(h_values + values_size + i * ev_size, host_tier_slot_ptr(table_index, slot),
+               ev_size * sizeof(float));
+        ++i;
+      }
+    }
   });
 }
 
@@ -478,6 +925,9 @@ size_t DynamicEmbeddingTable::size() const {
     auto table = cast_table<key_t, float>(table_);
     sz = table->size();
   });
+  for (size_t i = 0; i < host_tier_.size(); ++i) {
+    sz += host_tier_[i].slot_of_key.size() * dim_per_class_[i];
+  }
   return sz;
 }
 
@@ -500,6 +950,9 @@ size_t DynamicEmbeddingTable::key_num() const {
       kn += sizes[i] / dim_per_class_[i];
     }
   });
+  for (const auto &host_tier_table : host_tier_) {
+    kn += host_tier_table.slot_of_key.size();
+  }
   return kn;
 }
 
@@ -509,6 +962,9 @@ std::vector<size_t> DynamicEmbeddingTable::size_per_table() const {
     auto table = cast_table<key_t, float>(table_);
     sizes = table->size_per_class();
   });
+  for (size_t i = 0; i < host_tier_.size(); ++i) {
+    sizes[i] += host_tier_[i].slot_of_key.size() * dim_per_class_[i];
+  }
   return sizes;
 }
 
@@ -531,6 +987,9 @@ std::vector<size_t> DynamicEmbeddingTable::key_num_per_table() const {
       key_nums.push_back(sizes[i] / dim_per_class_[i]);
     }
   });
+  for (size_t i = 0; i < host_tier_.size(); ++i) {
+    key_nums[i] += host_tier_[i].slot_of_key.size();
+  }
   return key_nums;
 }
 
@@ -553,6 +1012,12 @@ void DynamicEmbeddingTable::clear() {
     table->clear(stream);
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
   });
+  if (host_tier_enabled_) {
+    host_tier_clear();
+  }
+  for (auto &last_touch : ttl_last_touch_) {
+    last_touch.clear();
+  }
 }
 
 void DynamicEmbeddingTable::evict(const core23::Tensor &keys, size_t num_keys,
@@ -582,6 +1047,31 @@ void DynamicEmbeddingTable::evict(const core23::Tensor &keys, size_t num_keys,
     table->remove(keys.data<key_t>(), num_keys, mapped_id_space_list.data(),
                   id_space_offset_cpu.data(), num_id_space_offset, stream);
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    if ((host_tier_enabled_ || ttl_enabled_) && num_keys > 0) {
+      // evicted keys must disappear from the host tier and TTL tracking as well
+      std::vector<key_t> h_keys(num_keys);
+      HCTR_LIB_THROW(cudaMemcpyAsync(h_keys.data(), keys.data<key_t>(), num_keys * sizeof(key_t),
+                                     cudaMemcpyDeviceToHost, stream));
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      for (size_t i = 0; i < mapped_id_space_list.size(); ++i) {
+        for (size_t k = id_space_offset_cpu[i]; k < id_space_offset_cpu[i + 1]; ++k) {
+          uint64_t key = static_cast<uint64_t>(h_keys[k]);
+          if (host_tier_enabled_) {
+            auto &host_tier_table = host_tier_[mapped_id_space_list[i]];
+            auto it = host_tier_table.slot_of_key.find(key);
+            if (it != host_tier_table.slot_of_key.end()) {
+              host_tier_table.free_slots.push_back(it->second);
+              host_tier_table.slot_of_key.erase(it);
+            }
+            host_tier_table.last_seen.erase(key);
+          }
+          if (ttl_enabled_) {
+            ttl_last_touch_[mapped_id_space_list[i]].erase(key);
+          }
+        }
+      }
+    }
   });
 }
 
@@ -16,8 +16,10 @@
 #pragma once
 
 #include <embedding_storage/embedding_table.hpp>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace embedding {
 
@@ -40,13 +42,88 @@ class DynamicEmbeddingTable final : public IDynamicEmbeddingTable {
   std::unique_ptr<core23::Tensor> opt_state_view_;
   std::unique_ptr<core23::Tensor> weight_view_;
 
+  // Two-tier mode (HCTR_DET_DEVICE_TIER_GB=<budget>): the DET pair above becomes a
+  // GPU-resident hot tier with a byte budget. Vectors evicted from it live in pinned
+  // host slots together with their optimizer state; when their keys reappear in a
+  // batch they are fetched back with chunked H2D copies and scatter updates before
+  // the regular lookup runs. Eviction picks the least-recently-seen device-resident
+  // keys and frees 10% below the budget at once so it stays amortized.
+  struct HostTierTable {
+    std::vector<float *> blocks;  // pinned, kHostTierSlotsPerBlock slots each
+    std::vector<size_t> free_slots;
+    size_t num_slots = 0;
+    std::unordered_map<uint64_t, size_t> slot_of_key;  // host-resident keys -> slot
+    std::unordered_map<uint64_t, uint64_t> last_seen;  // device-resident keys -> iteration
+  };
+  static constexpr size_t kHostTierSlotsPerBlock = 65536;
+  static constexpr size_t kHostTierChunkKeys = 65536;
+
+  bool host_tier_enabled_ = false;
+  size_t device_tier_budget_bytes_ = 0;
+  uint64_t current_iteration_ = 0;
+  size_t batch_keys_capacity_ = 0;
+  size_t max_slot_floats_ = 0;
+  std::vector<HostTierTable> host_tier_;
+
+  void *h_batch_keys_ = nullptr;  // pinned, sized for the widest key type
+  void *h_chunk_keys_ = nullptr;  // pinned
+  void *d_chunk_keys_ = nullptr;
+  float *h_chunk_vals_ = nullptr;  // pinned, weights + optimizer state regions
+  float *d_chunk_vals_ = nullptr;  // extra chunk-sized scratch region appended
+
+  // TTL feature expiry (HCTR_DET_TTL_ITERATIONS=<n>): every key remembers the last
+  // iteration a batch looked it up; keys untouched for n iterations are removed by a
+  // chunked compaction pass that runs every HCTR_DET_TTL_CHECK_INTERVAL iterations
+  // (default 100) so dead keys (e.g. expired campaigns) stop inflating the load
+  // factor. An optional callback observes evicted keys and vectors before removal.
+  bool ttl_enabled_ = false;
+  uint64_t ttl_iterations_ = 0;
+  uint64_t ttl_check_interval_ = 100;
+  std::vector<std::unordered_map<uint64_t, uint64_t>> ttl_last_touch_;  // per local table
+
+  size_t host_tier_slot_floats(size_t local_table) const {
+    return dim_per_class_[local_table] * (1 + opt_param_.num_parameters_per_weight());
+  }
+  float *host_tier_slot_ptr(size_t local_table, size_t slot);
+  size_t host_tier_acquire_slot(size_t local_table);
+  void host_tier_clear();
+
+  template <typename key_t>
+  void stage_batch_keys(const core23::Tensor &keys, size_t num_keys, cudaStream_t stream);
+
+  template <typename key_t>
+  void fetch_from_host_tier(const std::vector<size_t> &id_space_list,
+                            const std::vector<size_t> &id_space_offset, cudaStream_t stream);
+
+  template <typename key_t>
+  void evict_to_host_tier(cudaStream_t stream);
+
+  template <typename key_t>
+  void touch_batch_keys(const std::vector<size_t> &id_space_list,
+                        const std::vector<size_t> &id_space_offset);
+
+  template <typename key_t>
+  void compact_expired_keys(cudaStream_t stream);
+
  public:
+  // Invoked during TTL compaction before expired vectors are removed. keys points at
+  // num_keys entries of the table's key type and embedding_vectors at num_keys
+  // contiguous vectors of ev_size floats; both live in reused pinned staging buffers,
+  // so a callback that archives them (e.g. through an EmbeddingParameterIO-backed
+  // writer) must copy the data out before returning.
+  using EvictCallback = std::function<void(int table_id, const void *keys, size_t num_keys,
+                                           const float *embedding_vectors, int ev_size)>;
+
+  void set_evict_callback(EvictCallback callback) { evict_callback_ = std::move(callback); }
+
   DynamicEmbeddingTable(const HugeCTR::GPUResource &gpu_resource,
                         std::shared_ptr<CoreResourceManager> core,
                         const std::vector<EmbeddingTableParam> &table_params,
                         const EmbeddingCollectionParam &ebc_param, size_t grouped_table_id,
                         const HugeCTR::OptParams &opt_param);
 
+  ~DynamicEmbeddingTable();
+
   std::vector<size_t> remap_id_space(const core23::Tensor &id_space_list, cudaStream_t stream);
 
   std::vector<size_t> remap_id_space(const std::vector<int> &idsl_cpu);
@@ -98,6 +175,9 @@ class DynamicEmbeddingTable final : public IDynamicEmbeddingTable {
              size_t num_id_space_offset, const core23::Tensor &id_space_list) override;
 
   void set_learning_rate(float lr) override { opt_param_.lr = lr; }
+
+ private:
+  EvictCallback evict_callback_;
 };
 
 }  // namespace embedding
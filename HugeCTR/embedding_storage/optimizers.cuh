@@ -21,24 +21,40 @@
 namespace embedding {
 namespace {
 
+/**
+ * Every kernel here turns the gradient buffer into an update delta that the
+ * caller scatter-adds onto the weights afterwards. When decoupled weight decay
+ * is enabled the caller also resolves the current weight rows (`weight_tensors`,
+ * same layout as the FTRL weights) and the kernels fold `-eta * wd * w_i` into
+ * the delta during the one pass they already make, so only the rows touched
+ * this step are regularized and no extra sweep over the table is needed.
+ * `wd_mul_lr` is the precomputed `eta * wd`; `weight_tensors == nullptr`
+ * disables the term. FTRL is exempt: it regularizes through lambda1/lambda2.
+ */
+
 /**
  * SGD (Stateless)
  * ---------------
- * g_i = -eta * g_i / s
+ * g_i = -eta * g_i / s - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void sgd_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
-                                       float scaler, wgrad_t* g) {
+                                       float** weight_tensors, float wd_mul_lr, float scaler,
+                                       wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
 
   uint32_t start = ev_offsets[tid];
   uint32_t end = ev_offsets[tid + 1];
 
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
+
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
+    float delta = -lr * gi;
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] = core23::TypeConverter<wgrad_t, float>::value(-lr * gi);
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -46,12 +62,13 @@ __global__ void sgd_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_
  * Momentum SGD
  * ------------
  * v_i = beta * v_i + g_i / s
- * g_i = -eta * v_i
+ * g_i = -eta * v_i - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void momentum_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
                                             float momentum_decay, float** state_tensors,
-                                            float scaler, wgrad_t* g) {
+                                            float** weight_tensors, float wd_mul_lr, float scaler,
+                                            wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
 
@@ -59,12 +76,15 @@ __global__ void momentum_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
   uint32_t end = ev_offsets[tid + 1];
 
   float* m = state_tensors[tid] - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
 
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
     float mi = m[i] = momentum_decay * m[i] - lr * gi;
+    float delta = mi;
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] = core23::TypeConverter<wgrad_t, float>::value(mi);
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -74,12 +94,13 @@ __global__ void momentum_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
  * w*_i = w_i + beta * v_i
  * g = f(w*)
  * v_i = beta * v_i + g_i / s
- * g_i = -eta * v_i
+ * g_i = -eta * v_i - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void nesterov_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
                                             float momentum_decay, float** state_tensors,
-                                            float scaler, wgrad_t* g) {
+                                            float** weight_tensors, float wd_mul_lr, float scaler,
+                                            wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
 
@@ -87,14 +108,16 @@ __global__ void nesterov_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
   uint32_t end = ev_offsets[tid + 1];
 
   float* m = state_tensors[tid] - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
 
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
     float mi_prev = m[i];
     float mi = m[i] = momentum_decay * mi_prev - lr * gi;
+    float delta = mi + momentum_decay * mi - momentum_decay * mi_prev;
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] = core23::TypeConverter<wgrad_t, float>::value(mi + momentum_decay * mi -
-                                                        momentum_decay * mi_prev);
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -103,11 +126,12 @@ __global__ void nesterov_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
  * -------
  * g_i = g_i / s
  * v_i = v_i + g_i^2
- * g_i = -eta * g_i / (sqrt(v_i) + epsilon)
+ * g_i = -eta * g_i / (sqrt(v_i) + epsilon) - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void ada_grad_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
-                                            float** state_tensors, float epsilon, float scaler,
+                                            float** state_tensors, float** weight_tensors,
+                                            float wd_mul_lr, float epsilon, float scaler,
                                             wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
@@ -116,12 +140,15 @@ __global__ void ada_grad_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
   uint32_t end = ev_offsets[tid + 1];
 
   float* v = state_tensors[tid] - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
 
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
     float vi = v[i] = v[i] + gi * gi;
+    float delta = -lr * gi / (sqrtf(vi) + epsilon);
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] = core23::TypeConverter<wgrad_t, float>::value(-lr * gi / (sqrtf(vi) + epsilon));
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -130,11 +157,12 @@ __global__ void ada_grad_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
  * -------
  * g_i = g_i / s
  * v_i = beta * v_i + (1 - beta) * g_i^2
- * g_i = -eta * g_i / (sqrt(v_i) + epsilon)
+ * g_i = -eta * g_i / (sqrt(v_i) + epsilon) - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void rms_prop_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
-                                            float beta, float** state_tensors, float epsilon,
+                                            float beta, float** state_tensors,
+                                            float** weight_tensors, float wd_mul_lr, float epsilon,
                                             float scaler, wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
@@ -143,12 +171,15 @@ __global__ void rms_prop_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
   uint32_t end = ev_offsets[tid + 1];
 
   float* v = state_tensors[tid] - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
 
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
     float vi = v[i] = beta * v[i] + (1.f - beta) * gi * gi;
+    float delta = -lr * gi / (sqrtf(vi) + epsilon);
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] = core23::TypeConverter<wgrad_t, float>::value(-lr * gi / (sqrtf(vi) + epsilon));
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -162,13 +193,13 @@ __global__ void rms_prop_update_grad_kernel(const uint32_t* ev_offsets, uint32_t
  * m_i_debiased = m_i / (1 - beta_1^t)
  * v_i_debiased = v_i / (1 - beta_2^t)
  *
- * g_i = -eta * m_i_debiased / (sqrt(v_i_debiased) + epsilon)
+ * g_i = -eta * m_i_debiased / (sqrt(v_i_debiased) + epsilon) - eta * wd * w_i
  */
 template <typename wgrad_t>
 __global__ void adam_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num_ev,
                                         float lr_scaled_bias, float beta1, float beta2,
-                                        float** state_tensors, float epsilon, float scaler,
-                                        wgrad_t* g) {
+                                        float** state_tensors, float** weight_tensors,
+                                        float wd_mul_lr, float epsilon, float scaler, wgrad_t* g) {
   uint32_t tid = blockIdx.x * blockDim.x + threadIdx.x;
   if (tid >= num_ev) return;
 
@@ -177,14 +208,99 @@ __global__ void adam_update_grad_kernel(const uint32_t* ev_offsets, uint32_t num
 
   float* m = state_tensors[tid] - start;
   float* v = m + end - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[tid] - start : nullptr;
 
   for (uint32_t i = start; i < end; ++i) {
     float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
     float mi = m[i] = beta1 * m[i] + (1.f - beta1) * gi;
     float vi = v[i] = beta2 * v[i] + (1.f - beta2) * gi * gi;
+    float delta = -lr_scaled_bias * mi / (sqrtf(vi) + epsilon);
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
+
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
+  }
+}
+
+/**
+ * Warp-per-vector variants of the most common optimizers. The thread-per-vector
+ * kernels above make every thread walk a whole embedding vector, so consecutive
+ * elements of the gradient and the optimizer state are read by the same thread
+ * instead of neighboring lanes and the accesses do not coalesce. Here one warp
+ * owns one vector with its lanes on consecutive elements, so the single
+ * gradient+state pass of each optimizer also runs at full memory bandwidth.
+ * Launch with one warp per ev (num_ev * 32 threads).
+ */
+template <typename wgrad_t>
+__global__ void sgd_update_grad_kernel4(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
+                                        float** weight_tensors, float wd_mul_lr, float scaler,
+                                        wgrad_t* g) {
+  uint32_t warp_id = (blockIdx.x * blockDim.x + threadIdx.x) / 32;
+  uint32_t lane_id = threadIdx.x % 32;
+  if (warp_id >= num_ev) return;
+
+  uint32_t start = ev_offsets[warp_id];
+  uint32_t end = ev_offsets[warp_id + 1];
+
+  const float* w = weight_tensors != nullptr ? weight_tensors[warp_id] - start : nullptr;
+
+  for (uint32_t i = start + lane_id; i < end; i += 32) {
+    float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
+    float delta = -lr * gi;
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
+
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
+  }
+}
+
+template <typename wgrad_t>
+__global__ void ada_grad_update_grad_kernel4(const uint32_t* ev_offsets, uint32_t num_ev, float lr,
+                                             float** state_tensors, float** weight_tensors,
+                                             float wd_mul_lr, float epsilon, float scaler,
+                                             wgrad_t* g) {
+  uint32_t warp_id = (blockIdx.x * blockDim.x + threadIdx.x) / 32;
+  uint32_t lane_id = threadIdx.x % 32;
+  if (warp_id >= num_ev) return;
+
+  uint32_t start = ev_offsets[warp_id];
+  uint32_t end = ev_offsets[warp_id + 1];
+
+  float* v = state_tensors[warp_id] - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[warp_id] - start : nullptr;
+
+  for (uint32_t i = start + lane_id; i < end; i += 32) {
+    float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
+    float vi = v[i] = v[i] + gi * gi;
+    float delta = -lr * gi / (sqrtf(vi) + epsilon);
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
+
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
+  }
+}
+
+template <typename wgrad_t>
+__global__ void adam_update_grad_kernel4(const uint32_t* ev_offsets, uint32_t num_ev,
+                                         float lr_scaled_bias, float beta1, float beta2,
+                                         float** state_tensors, float** weight_tensors,
+                                         float wd_mul_lr, float epsilon, float scaler, wgrad_t* g) {
+  uint32_t warp_id = (blockIdx.x * blockDim.x + threadIdx.x) / 32;
+  uint32_t lane_id = threadIdx.x % 32;
+  if (warp_id >= num_ev) return;
+
+  uint32_t start = ev_offsets[warp_id];
+  uint32_t end = ev_offsets[warp_id + 1];
+
+  float* m = state_tensors[warp_id] - start;
+  float* v = m + end - start;
+  const float* w = weight_tensors != nullptr ? weight_tensors[warp_id] - start : nullptr;
+
+  for (uint32_t i = start + lane_id; i < end; i += 32) {
+    float gi = core23::TypeConverter<float, wgrad_t>::value(g[i]) / scaler;
+    float mi = m[i] = beta1 * m[i] + (1.f - beta1) * gi;
+    float vi = v[i] = beta2 * v[i] + (1.f - beta2) * gi * gi;
+    float delta = -lr_scaled_bias * mi / (sqrtf(vi) + epsilon);
+    if (w != nullptr) delta -= wd_mul_lr * w[i];
 
-    g[i] =
-        core23::TypeConverter<wgrad_t, float>::value(-lr_scaled_bias * mi / (sqrtf(vi) + epsilon));
+    g[i] = core23::TypeConverter<wgrad_t, float>::value(delta);
   }
 }
 
@@ -17,6 +17,7 @@
 #include <curand_kernel.h>
 #include <float.h>
 
+#include <cstdlib>
 #include <data_simulator.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/view.hpp>
@@ -33,8 +34,9 @@ template <typename key_t, typename offset_t, typename index_t>
 __global__ void ragged_static_embedding_table_lookup_kernel(
     const key_t *keys, size_t num_keys, const offset_t *id_space_offset, size_t num_id_space_offset,
     const int *id_space_list, const int *local_id_space_list, size_t num_local_id_space_list,
-    const index_t *emb_table_id_space_offset, float *emb_table, const uint64_t *emb_table_ev_offset,
-    const int *local_ev_size_list, float **emb_vec) {
+    const index_t *emb_table_id_space_offset, float *emb_table, const __half *emb_table_half,
+    const int *table_half_flags, float *half_staging, int half_staging_stride,
+    const uint64_t *emb_table_ev_offset, const int *local_ev_size_list, float **emb_vec) {
   CUDA_1D_KERNEL_LOOP_T(offset_t, tid, num_keys) {
     int64_t id_space_idx = bs_upper_bound_sub_one(id_space_offset, num_id_space_offset, tid);
     int id_space = id_space_list[id_space_idx];
@@ -46,7 +48,77 @@ __global__ void ragged_static_embedding_table_lookup_kernel(
     int ev_size = local_ev_size_list[local_id_space_idx];
     // printf("lookup key is %llu, ev_offset %llu, start %llu, dst ptr %p\n", (uint64_t)keys[tid],
     //        ev_offset, start, emb_vec + tid);
-    emb_vec[tid] = &emb_table[ev_offset + ((uint64_t)keys[tid] - start) * ev_size];
+    if (table_half_flags[local_id_space_idx]) {
+      // fp16-stored table: dequantize the row into the staging buffer so the
+      // embedding ops downstream keep consuming fp32 row pointers
+      const __half *src = &emb_table_half[ev_offset + ((uint64_t)keys[tid] - start) * ev_size];
+      float *dst = half_staging + (uint64_t)tid * half_staging_stride;
+      for (int i = 0; i < ev_size; ++i) {
+        dst[i] = __half2float(src[i]);
+      }
+      emb_vec[tid] = dst;
+    } else {
+      emb_vec[tid] = &emb_table[ev_offset + ((uint64_t)keys[tid] - start) * ev_size];
+    }
+  }
+}
+
+// Variant of the lookup kernel that stages the table-descriptor arrays in shared
+// memory first. With O(100) tables in one group, every key's two binary searches
+// otherwise re-read the descriptors from global memory; one cooperative copy per
+// block turns those into shared-memory probes. Descriptors are widened to 64 bit
+// so a single buffer holds all of them without per-type alignment bookkeeping.
+template <typename key_t, typename offset_t, typename index_t>
+__global__ void ragged_static_embedding_table_lookup_smem_kernel(
+    const key_t *keys, size_t num_keys, const offset_t *id_space_offset, size_t num_id_space_offset,
+    const int *id_space_list, const int *local_id_space_list, size_t num_local_id_space_list,
+    const index_t *emb_table_id_space_offset, float *emb_table, const __half *emb_table_half,
+    const int *table_half_flags, float *half_staging, int half_staging_stride,
+    const uint64_t *emb_table_ev_offset, const int *local_ev_size_list, float **emb_vec) {
+  extern __shared__ uint64_t s_desc[];
+  uint64_t *s_id_space_offset = s_desc;
+  uint64_t *s_id_space_list = s_id_space_offset + num_id_space_offset;
+  uint64_t *s_local_id_space_list = s_id_space_list + (num_id_space_offset - 1);
+  uint64_t *s_table_start = s_local_id_space_list + num_local_id_space_list;
+  uint64_t *s_ev_offset = s_table_start + num_local_id_space_list;
+  uint64_t *s_ev_size = s_ev_offset + num_local_id_space_list;
+  uint64_t *s_half_flag = s_ev_size + num_local_id_space_list;
+
+  for (size_t i = threadIdx.x; i < num_id_space_offset; i += blockDim.x) {
+    s_id_space_offset[i] = static_cast<uint64_t>(id_space_offset[i]);
+  }
+  for (size_t i = threadIdx.x; i + 1 < num_id_space_offset; i += blockDim.x) {
+    s_id_space_list[i] = static_cast<uint64_t>(id_space_list[i]);
+  }
+  for (size_t i = threadIdx.x; i < num_local_id_space_list; i += blockDim.x) {
+    s_local_id_space_list[i] = static_cast<uint64_t>(local_id_space_list[i]);
+    s_table_start[i] = static_cast<uint64_t>(emb_table_id_space_offset[i]);
+    s_ev_offset[i] = emb_table_ev_offset[i];
+    s_ev_size[i] = static_cast<uint64_t>(local_ev_size_list[i]);
+    s_half_flag[i] = static_cast<uint64_t>(table_half_flags[i]);
+  }
+  __syncthreads();
+
+  CUDA_1D_KERNEL_LOOP_T(offset_t, tid, num_keys) {
+    int64_t id_space_idx = bs_upper_bound_sub_one(s_id_space_offset, num_id_space_offset,
+                                                  static_cast<uint64_t>(tid));
+    uint64_t id_space = s_id_space_list[id_space_idx];
+    int64_t local_id_space_idx =
+        bs_upper_bound_sub_one(s_local_id_space_list, num_local_id_space_list, id_space);
+
+    uint64_t start = s_table_start[local_id_space_idx];
+    uint64_t ev_offset = s_ev_offset[local_id_space_idx];
+    uint64_t ev_size = s_ev_size[local_id_space_idx];
+    if (s_half_flag[local_id_space_idx]) {
+      const __half *src = &emb_table_half[ev_offset + ((uint64_t)keys[tid] - start) * ev_size];
+      float *dst = half_staging + (uint64_t)tid * half_staging_stride;
+      for (uint64_t i = 0; i < ev_size; ++i) {
+        dst[i] = __half2float(src[i]);
+      }
+      emb_vec[tid] = dst;
+    } else {
+      emb_vec[tid] = &emb_table[ev_offset + ((uint64_t)keys[tid] - start) * ev_size];
+    }
   }
 }
 
@@ -58,9 +130,13 @@ struct RaggedKeyToIndicesFunc {
 
   index_t *emb_table_id_space_offset;
   uint64_t *emb_table_ev_start_indices;
+  const int *table_half_flags;
 
+  // For fp16-stored tables the start index is relative to the __half buffer and
+  // is_half is set; the optimizer state of those rows lives past the fp32 rows.
   DEVICE_INLINE void operator()(const key_t &key, const int &table_id,
-                                uint64_t *ev_start_indices_ptr, int *ev_size_ptr) {
+                                uint64_t *ev_start_indices_ptr, int *ev_size_ptr,
+                                int *is_half_ptr) {
     int local_id_space_idx = bs_upper_bound_sub_one(local_table_ids, num_local_table_ids, table_id);
     assert(local_id_space_idx >= 0);
     assert(local_id_space_idx < num_local_table_ids);
@@ -68,6 +144,7 @@ struct RaggedKeyToIndicesFunc {
 
     uint64_t ev_offset = emb_table_ev_start_indices[local_id_space_idx];
     int ev_size = local_ev_sizes[local_id_space_idx];
+    *is_half_ptr = table_half_flags[local_id_space_idx];
 
     *ev_start_indices_ptr = ev_offset + static_cast<uint64_t>(key - start) * ev_size;
     *ev_size_ptr = ev_size;
@@ -81,6 +158,11 @@ struct OptimizierInput {
   int ev_id;
   float lr;
   float scaler;
+  // Precomputed `lr * weight_decay` for decoupled weight decay; the optimizers
+  // subtract `wd_mul_lr * w` alongside their regular update so only the rows of
+  // this step pay for regularization. 0 disables the term. FTRL ignores it and
+  // relies on its own lambda1/lambda2 instead.
+  float wd_mul_lr;
 };
 
 constexpr int num_load_floats = 4;
@@ -92,10 +174,10 @@ struct SGDOptimizer {
     Vec4T<float> ev_plus_gi;
     ev_plus_gi.load(ev + input.ev_id, 4);
     Vec4T<float> ret;
-    ret.val.x = -input.lr * gi.val.x / input.scaler;
-    ret.val.y = -input.lr * gi.val.y / input.scaler;
-    ret.val.z = -input.lr * gi.val.z / input.scaler;
-    ret.val.w = -input.lr * gi.val.w / input.scaler;
+    ret.val.x = -input.lr * gi.val.x / input.scaler - input.wd_mul_lr * ev_plus_gi.val.x;
+    ret.val.y = -input.lr * gi.val.y / input.scaler - input.wd_mul_lr * ev_plus_gi.val.y;
+    ret.val.z = -input.lr * gi.val.z / input.scaler - input.wd_mul_lr * ev_plus_gi.val.z;
+    ret.val.w = -input.lr * gi.val.w / input.scaler - input.wd_mul_lr * ev_plus_gi.val.w;
     ev_plus_gi.accumulate(ret);
     ev_plus_gi.store(ev + input.ev_id, 4);
   }
@@ -104,7 +186,17 @@ struct SGDOptimizer {
     ev[input.ev_id] =
         ev[input.ev_id] -
         input.lr * (HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(input.wgrad[input.ev_id]) /
-                    input.scaler);
+                    input.scaler) -
+        input.wd_mul_lr * ev[input.ev_id];
+  }
+
+  DEVICE_INLINE void update(const OptimizierInput<wgrad_t> &input, __half *ev) {
+    float wi = __half2float(ev[input.ev_id]);
+    wi = wi -
+         input.lr * (HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(input.wgrad[input.ev_id]) /
+                     input.scaler) -
+         input.wd_mul_lr * wi;
+    ev[input.ev_id] = __float2half(wi);
   }
 };
 
@@ -130,10 +222,14 @@ struct AdaGradOptimizer {
     vi.val.z = vi.val.z + gi.val.z * gi.val.z;
     vi.val.w = vi.val.w + gi.val.w * gi.val.w;
 
-    gi.val.x = -input.lr * gi.val.x / (sqrtf(vi.val.x) + epsilon);
-    gi.val.y = -input.lr * gi.val.y / (sqrtf(vi.val.y) + epsilon);
-    gi.val.z = -input.lr * gi.val.z / (sqrtf(vi.val.z) + epsilon);
-    gi.val.w = -input.lr * gi.val.w / (sqrtf(vi.val.w) + epsilon);
+    gi.val.x = -input.lr * gi.val.x / (sqrtf(vi.val.x) + epsilon) -
+               input.wd_mul_lr * ev_plus_gi.val.x;
+    gi.val.y = -input.lr * gi.val.y / (sqrtf(vi.val.y) + epsilon) -
+               input.wd_mul_lr * ev_plus_gi.val.y;
+    gi.val.z = -input.lr * gi.val.z / (sqrtf(vi.val.z) + epsilon) -
+               input.wd_mul_lr * ev_plus_gi.val.z;
+    gi.val.w = -input.lr * gi.val.w / (sqrtf(vi.val.w) + epsilon) -
+               input.wd_mul_lr * ev_plus_gi.val.w;
 
     vi.store(v + input.ev_start_indices + input.ev_id, 4);
 
@@ -149,10 +245,23 @@ struct AdaGradOptimizer {
     gi = gi / input.scaler;
     vi = vi + gi * gi;
 
-    gi = -input.lr * gi / (sqrtf(vi) + epsilon);
+    gi = -input.lr * gi / (sqrtf(vi) + epsilon) - input.wd_mul_lr * ev[input.ev_id];
     v[input.ev_start_indices + input.ev_id] = HugeCTR::TypeConvertFunc<acc_t, float>::convert(vi);
     ev[input.ev_id] += gi;
   }
+
+  DEVICE_INLINE void update(const OptimizierInput<wgrad_t> &input, __half *ev) {
+    float vi =
+        HugeCTR::TypeConvertFunc<float, acc_t>::convert(v[input.ev_start_indices + input.ev_id]);
+    float gi = HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(input.wgrad[input.ev_id]);
+    float wi = __half2float(ev[input.ev_id]);
+    gi = gi / input.scaler;
+    vi = vi + gi * gi;
+
+    gi = -input.lr * gi / (sqrtf(vi) + epsilon) - input.wd_mul_lr * wi;
+    v[input.ev_start_indices + input.ev_id] = HugeCTR::TypeConvertFunc<acc_t, float>::convert(vi);
+    ev[input.ev_id] = __float2half(wi + gi);
+  }
 };
 
 template <typename wgrad_t, typename opt_t>
@@ -270,6 +379,30 @@ struct FtrlOptimizer {
     z[input.ev_start_indices + input.ev_id] = HugeCTR::TypeConvertFunc<opt_t, float>::convert(zi);
     ev[input.ev_id] = p / q * signbit(lambda1 - abs(zi));
   }
+
+  DEVICE_INLINE void update(const OptimizierInput<wgrad_t> &input, __half *ev) {
+    float lambda2_plus_beta_div_lr = lambda2 + beta / input.lr;
+    float ni =
+        HugeCTR::TypeConvertFunc<float, opt_t>::convert(n[input.ev_start_indices + input.ev_id]);
+    float zi =
+        HugeCTR::TypeConvertFunc<float, opt_t>::convert(z[input.ev_start_indices + input.ev_id]);
+    float gi = HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(input.wgrad[input.ev_id]);
+
+    gi = gi / input.scaler;
+    float sqrt_ni = sqrtf(ni + FLT_EPSILON);
+    ni = ni + gi * gi;
+    float sqrt_ni_new = sqrtf(ni + FLT_EPSILON);
+
+    float sigma = (sqrt_ni_new - sqrt_ni) / input.lr;
+    zi = zi + gi - sigma * __half2float(ev[input.ev_id]);
+
+    float p = (1.f - 2.f * signbit(zi)) * lambda1 - zi;
+    float q = sqrt_ni_new / input.lr + lambda2_plus_beta_div_lr;
+
+    n[input.ev_start_indices + input.ev_id] = HugeCTR::TypeConvertFunc<opt_t, float>::convert(ni);
+    z[input.ev_start_indices + input.ev_id] = HugeCTR::TypeConvertFunc<opt_t, float>::convert(zi);
+    ev[input.ev_id] = __float2half(p / q * signbit(lambda1 - abs(zi)));
+  }
 };
 
 template <typename key_t, typename index_t, typename wgrad_t, typename OptimizerFunc,
@@ -277,7 +410,10 @@ template <typename key_t, typename index_t, typename wgrad_t, typename Optimizer
 __global__ void update4_kernel(const key_t *keys, const size_t *num_keys_ptr, const int *table_ids,
                                const wgrad_t *grad_ev, const uint32_t *ev_start_indices,
                                KeyToIndicesFunc key_to_indices_func, float *emb_table,
-                               OptimizerFunc optimizer, float lr, float scaler) {
+                               __half *emb_table_half, uint64_t half_state_base,
+                               OptimizerFunc optimizer, float lr, float wd_mul_lr, float scaler) {
+  // groups with fp16-stored tables never take the vectorized path, so is_half
+  // is only consumed here to satisfy the indices functor
   if (*num_keys_ptr == 0) return;
   size_t num_steps = (*num_keys_ptr - 1) / (blockDim.x * gridDim.x) + 1;
   for (size_t step = 0; step < num_steps; step++) {
@@ -285,10 +421,12 @@ __global__ void update4_kernel(const key_t *keys, const size_t *num_keys_ptr, co
     uint64_t emb_table_ev_start_indices_frag;
     int ev_size_frag = std::numeric_limits<int>::max();
     uint32_t grad_ev_offset_frag;
+    int is_half_frag = 0;
     if (tid < *num_keys_ptr) {
       key_t key = keys[tid];
       int table_id = table_ids[tid];
-      key_to_indices_func(key, table_id, &emb_table_ev_start_indices_frag, &ev_size_frag);
+      key_to_indices_func(key, table_id, &emb_table_ev_start_indices_frag, &ev_size_frag,
+                          &is_half_frag);
       grad_ev_offset_frag = ev_start_indices[tid];
     }
 
@@ -305,7 +443,7 @@ __global__ void update4_kernel(const key_t *keys, const size_t *num_keys_ptr, co
 
       for (int i = threadIdx.x % warpSize; i < ev_size / num_load_floats; i += warpSize) {
         OptimizierInput<wgrad_t> input{grad_ev_for_update, ev_start_indices_v, i * num_load_floats,
-                                       lr, scaler};
+                                       lr, scaler, wd_mul_lr};
         optimizer.update4(input, ev);
         // float4 gi = optimizer.update4(input, ev);
       }
@@ -313,12 +451,87 @@ __global__ void update4_kernel(const key_t *keys, const size_t *num_keys_ptr, co
   }
 }
 
+// AdaGrad update against the 8-bit quantized accumulator. One warp owns one
+// embedding row, so the row-wise requantization scale can be produced with a
+// warp max-reduction without any cross-thread races: pass one dequantizes the
+// old state, folds in g^2, applies the weight update at full fp32 precision and
+// tracks the row max; pass two recomputes the same state values (the quantized
+// buffer is untouched until then) and stores them against the new scale. The
+// scale array is indexed by the globally unique key, which for this table is
+// exactly the global row index.
+template <typename key_t, typename index_t, typename wgrad_t, typename KeyToIndicesFunc>
+__global__ void adagrad_q8_update_kernel(const key_t *keys, const uint64_t *num_keys_ptr,
+                                         const int *table_ids, const wgrad_t *grad_ev,
+                                         const uint32_t *ev_start_indices,
+                                         KeyToIndicesFunc key_to_indices_func, float *emb_table,
+                                         uint8_t *accum_q, float *accum_scale, float epsilon,
+                                         float lr, float wd_mul_lr, float scaler) {
+  if (*num_keys_ptr == 0) return;
+  uint64_t num_steps = (*num_keys_ptr - 1) / (blockDim.x * gridDim.x) + 1;
+  for (size_t step = 0; step < num_steps; step++) {
+    uint64_t tid = step * blockDim.x * gridDim.x + (size_t)blockIdx.x * blockDim.x + threadIdx.x;
+    uint64_t emb_table_ev_start_indices_frag;
+    int ev_size_frag = std::numeric_limits<int>::max();
+    uint32_t grad_ev_offset_frag;
+    uint64_t row_frag = 0;
+    int is_half_frag = 0;
+    if (tid < *num_keys_ptr) {
+      key_t key = keys[tid];
+      int table_id = table_ids[tid];
+      key_to_indices_func(key, table_id, &emb_table_ev_start_indices_frag, &ev_size_frag,
+                          &is_half_frag);
+      grad_ev_offset_frag = ev_start_indices[tid];
+      row_frag = static_cast<uint64_t>(key);
+    }
+
+    for (int lane_id = 0; lane_id < warpSize; lane_id++) {
+      int ev_size = __shfl_sync(0xffffffff, ev_size_frag, lane_id);
+      if (ev_size == std::numeric_limits<int>::max()) {
+        break;
+      }
+      const wgrad_t *grad_ev_for_update =
+          grad_ev + __shfl_sync(0xffffffff, grad_ev_offset_frag, lane_id);
+      uint64_t ev_start_indices_v =
+          __shfl_sync(0xffffffff, emb_table_ev_start_indices_frag, lane_id);
+      uint64_t row = __shfl_sync(0xffffffff, row_frag, lane_id);
+      float *ev = emb_table + ev_start_indices_v;
+      uint8_t *vq = accum_q + ev_start_indices_v;
+      float old_scale = accum_scale[row];
+
+      float local_max = 0.f;
+      for (int i = threadIdx.x % warpSize; i < ev_size; i += warpSize) {
+        float gi = HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(grad_ev_for_update[i]);
+        gi = gi / scaler;
+        float vi = old_scale * vq[i] + gi * gi;
+        ev[i] -= lr * gi / (sqrtf(vi) + epsilon) + wd_mul_lr * ev[i];
+        local_max = fmaxf(local_max, vi);
+      }
+      for (int offset = warpSize / 2; offset > 0; offset >>= 1) {
+        local_max = fmaxf(local_max, __shfl_xor_sync(0xffffffff, local_max, offset));
+      }
+      float new_scale = local_max / 255.f;
+      if (threadIdx.x % warpSize == 0) {
+        accum_scale[row] = new_scale;
+      }
+      float inv_scale = new_scale > 0.f ? 1.f / new_scale : 0.f;
+      for (int i = threadIdx.x % warpSize; i < ev_size; i += warpSize) {
+        float gi = HugeCTR::TypeConvertFunc<float, wgrad_t>::convert(grad_ev_for_update[i]);
+        gi = gi / scaler;
+        float vi = old_scale * vq[i] + gi * gi;
+        int q = __float2int_rn(vi * inv_scale);
+        vq[i] = static_cast<uint8_t>(q < 255 ? q : 255);
+      }
+    }
+  }
+}
+
 template <typename key_t, typename index_t, typename emb_t, typename OptimizerFunc,
           typename KeyToIndicesFunc>
 __global__ void update_kernel(const key_t *keys, const uint64_t *num_keys_ptr, const int *table_ids,
                               const emb_t *grad_ev, const uint32_t *ev_start_indices,
                               KeyToIndicesFunc key_to_indices_func, float *emb_table,
-                              OptimizerFunc optimizer, float lr, float scaler) {
+                              __half *emb_table_half, uint64_t half_state_base,
+                              OptimizerFunc optimizer, float lr, float wd_mul_lr, float scaler) {
   if (*num_keys_ptr == 0) return;
   uint64_t num_steps = (*num_keys_ptr - 1) / (blockDim.x * gridDim.x) + 1;
   for (size_t step = 0; step < num_steps; step++) {
@@ -326,10 +539,12 @@ __global__ void update_kernel(const key_t *keys, const uint64_t *num_keys_ptr, c
     uint64_t emb_table_ev_start_indices_frag;
     int ev_size_frag = std::numeric_limits<int>::max();
     uint32_t grad_ev_offset_frag;
+    int is_half_frag = 0;
     if (tid < *num_keys_ptr) {
       key_t key = keys[tid];
       int table_id = table_ids[tid];
-      key_to_indices_func(key, table_id, &emb_table_ev_start_indices_frag, &ev_size_frag);
+      key_to_indices_func(key, table_id, &emb_table_ev_start_indices_frag, &ev_size_frag,
+                          &is_half_frag);
       grad_ev_offset_frag = ev_start_indices[tid];
     }
 
@@ -342,16 +557,35 @@ __global__ void update_kernel(const key_t *keys, const uint64_t *num_keys_ptr, c
           grad_ev + __shfl_sync(0xffffffff, grad_ev_offset_frag, lane_id);
       uint64_t ev_start_indices_v =
           __shfl_sync(0xffffffff, emb_table_ev_start_indices_frag, lane_id);
-      float *ev = emb_table + ev_start_indices_v;
-
-      for (int i = threadIdx.x % warpSize; i < ev_size; i += warpSize) {
-        OptimizierInput<emb_t> input{grad_ev_for_update, ev_start_indices_v, i, lr, scaler};
-        optimizer.update(input, ev);
+      int is_half = __shfl_sync(0xffffffff, is_half_frag, lane_id);
+
+      if (is_half) {
+        // fp16-stored row: the weights live in the __half buffer while its
+        // optimizer state is laid out past the fp32 rows' state
+        __half *ev = emb_table_half + ev_start_indices_v;
+        uint64_t state_start = half_state_base + ev_start_indices_v;
+        for (int i = threadIdx.x % warpSize; i < ev_size; i += warpSize) {
+          OptimizierInput<emb_t> input{grad_ev_for_update, state_start, i, lr, scaler, wd_mul_lr};
+          optimizer.update(input, ev);
+        }
+      } else {
+        float *ev = emb_table + ev_start_indices_v;
+        for (int i = threadIdx.x % warpSize; i < ev_size; i += warpSize) {
+          OptimizierInput<emb_t> input{grad_ev_for_update, ev_start_indices_v, i, lr, scaler,
+                                       wd_mul_lr};
+          optimizer.update(input, ev);
+        }
       }
     }
   }
 }
 
+// Promote a segment of fp32 values to the fp16 table storage and back; used for
+// initialization and checkpoint IO of fp16-stored tables.
+__global__ void float_to_half_segment_kernel(const float *src, size_t num_elements, __half *dst) {
+  CUDA_1D_KERNEL_LOOP(i, num_elements) { dst[i] = __float2half(src[i]); }
+}
+
 }  // namespace
 
 RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
@@ -360,6 +594,10 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
     size_t grouped_id, const HugeCTR::OptParams &opt_param)
     : core_(core), emb_table_size_(0), use_vectorized_kernel_{true}, opt_param_(opt_param) {
   CudaDeviceContext ctx(core_->get_device_id());
+  if (const char *const wd_env = std::getenv("HCTR_EMB_WEIGHT_DECAY");
+      wd_env != nullptr && opt_param_.weight_decay == 0.f) {
+    opt_param_.weight_decay = std::atof(wd_env);
+  }
   int global_gpu_id = core_->get_global_gpu_id();
   int num_gpus = core_->get_global_gpu_count();
   HCTR_CHECK_HINT(num_gpus == static_cast<int>(ebc_param.shard_matrix.size()),
@@ -371,6 +609,12 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
   const auto &grouped_table_param = ebc_param.grouped_table_params[grouped_id];
   for (const auto &table_param : table_params) {
     use_vectorized_kernel_ &= (table_param.ev_size % num_load_floats == 0);
+    // the vectorized update loads float4 rows, which fp16-stored tables don't have
+    use_vectorized_kernel_ &= !table_param.half_precision_storage;
+    if (table_param.half_precision_storage) {
+      HCTR_CHECK_HINT(table_param.ev_size % 2 == 0,
+                      "fp16-stored embedding tables require an even ev_size");
+    }
   }
 
   DISPATCH_INTEGRAL_FUNCTION_CORE23(key_type.type(), key_t, [&] {
@@ -395,7 +639,12 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           h_size_per_table_.push_back(segment_emb_table_size);
           h_emb_table_ev_offset_.push_back(segment_emb_table_size);
           h_local_ev_sizes_.push_back(table_params[table_id].ev_size);
-          emb_table_size_ += segment_emb_table_size;
+          h_table_half_storage_.push_back(table_params[table_id].half_precision_storage ? 1 : 0);
+          if (table_params[table_id].half_precision_storage) {
+            emb_table_half_size_ += segment_emb_table_size;
+          } else {
+            emb_table_size_ += segment_emb_table_size;
+          }
         }
       } else if (grouped_table_param.table_placement_strategy ==
                  TablePlacementStrategy::ModelParallel) {
@@ -432,13 +681,29 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
           h_size_per_table_.push_back(segment_emb_table_size);
           h_emb_table_ev_offset_.push_back(segment_emb_table_size);
           h_local_ev_sizes_.push_back(table_params[table_id].ev_size);
-          emb_table_size_ += segment_emb_table_size;
+          h_table_half_storage_.push_back(table_params[table_id].half_precision_storage ? 1 : 0);
+          if (table_params[table_id].half_precision_storage) {
+            emb_table_half_size_ += segment_emb_table_size;
+          } else {
+            emb_table_size_ += segment_emb_table_size;
+          }
         }
       }
       std::partial_sum(h_num_key_per_table_offset.begin(), h_num_key_per_table_offset.end(),
                        h_num_key_per_table_offset.begin());
-      std::partial_sum(h_emb_table_ev_offset_.begin(), h_emb_table_ev_offset_.end(),
-                       h_emb_table_ev_offset_.begin());
+      {
+        // turn the per-table sizes into offsets; fp32 and fp16 tables each index
+        // their own buffer, so they keep separate running offsets
+        uint64_t float_offset = 0;
+        uint64_t half_offset = 0;
+        for (size_t i = 0; i + 1 < h_emb_table_ev_offset_.size(); ++i) {
+          uint64_t segment = h_emb_table_ev_offset_[i + 1];
+          uint64_t &offset = h_table_half_storage_[i] ? half_offset : float_offset;
+          h_emb_table_ev_offset_[i] = offset;
+          offset += segment;
+        }
+        h_emb_table_ev_offset_.back() = float_offset;
+      }
       for (auto tmp_offset : h_num_key_per_table_offset) {
         h_num_key_per_table_offset_.push_back(static_cast<size_t>(tmp_offset));
       }
@@ -461,34 +726,69 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
       local_ev_size_list_ =
           core23::Tensor(params.shape({static_cast<int64_t>(h_local_ev_sizes_.size())})
                              .data_type(core23::ScalarType::Int32));
+      table_half_storage_ =
+          core23::Tensor(params.shape({static_cast<int64_t>(h_table_half_storage_.size())})
+                             .data_type(core23::ScalarType::Int32));
+      if (emb_table_half_size_ > 0) {
+        emb_table_half_ = core23::Tensor(params.shape({static_cast<int64_t>(emb_table_half_size_)})
+                                             .data_type(core23::ScalarType::Half));
+      }
 
       core23::copy_sync(table_ids_, h_table_ids_);
       core23::copy_sync(keys_, h_key_list);
       core23::copy_sync(num_key_per_table_offset_, h_num_key_per_table_offset);
       core23::copy_sync(emb_table_ev_offset_, h_emb_table_ev_offset_);
       core23::copy_sync(local_ev_size_list_, h_local_ev_sizes_);
+      core23::copy_sync(table_half_storage_, h_table_half_storage_);
     });
   });
+  has_half_tables_ = emb_table_half_size_ > 0;
+  for (size_t i = 0; i < h_table_half_storage_.size(); i++) {
+    if (h_table_half_storage_[i]) {
+      max_half_ev_size_ = std::max(max_half_ev_size_, h_local_ev_sizes_[i]);
+    }
+  }
 
   if (opt_param.optimizer == HugeCTR::Optimizer_t::AdaGrad) {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(emb_type.type(), emb_t, [&] {
       core23::Device device(core23::DeviceType::GPU, core->get_device_id());
       core23::TensorParams params = core23::TensorParams().device(device);
-      auto accum_tensor = core23::Tensor(params.shape({static_cast<int64_t>(emb_table_size_)})
-                                             .data_type(core23::ScalarType::Float));
-
-      HCTR_LIB_THROW(cudaMemset(accum_tensor.data(), 0, accum_tensor.num_bytes()));
-      opt_buffer_ = AdaGradOptBuffer{accum_tensor};
+      if (opt_param.hyperparams.adagrad.quantized_state) {
+        if (has_half_tables_) {
+          HCTR_OWN_THROW(HugeCTR::Error_t::WrongInput,
+                         "quantized AdaGrad state is not supported together with fp16-stored "
+                         "tables");
+        }
+        auto accum_q_tensor = core23::Tensor(params.shape({static_cast<int64_t>(emb_table_size_)})
+                                                 .data_type(core23::ScalarType::UInt8));
+        auto accum_scale_tensor = core23::Tensor(
+            params.shape({static_cast<int64_t>(h_num_key_per_table_offset_.back())})
+                .data_type(core23::ScalarType::Float));
+
+        HCTR_LIB_THROW(cudaMemset(accum_q_tensor.data(), 0, accum_q_tensor.num_bytes()));
+        HCTR_LIB_THROW(cudaMemset(accum_scale_tensor.data(), 0, accum_scale_tensor.num_bytes()));
+        opt_buffer_ = AdaGradQ8OptBuffer{accum_q_tensor, accum_scale_tensor};
+      } else {
+        // fp16-stored rows keep fp32 state, laid out past the fp32 rows' state
+        auto accum_tensor = core23::Tensor(
+            params.shape({static_cast<int64_t>(emb_table_size_ + emb_table_half_size_)})
+                .data_type(core23::ScalarType::Float));
+
+        HCTR_LIB_THROW(cudaMemset(accum_tensor.data(), 0, accum_tensor.num_bytes()));
+        opt_buffer_ = AdaGradOptBuffer{accum_tensor};
+      }
     });
   }
   if (opt_param.optimizer == HugeCTR::Optimizer_t::Ftrl) {
     DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(emb_type.type(), emb_t, [&] {
       core23::Device device(core23::DeviceType::GPU, core->get_device_id());
       core23::TensorParams params = core23::TensorParams().device(device);
-      auto z_tensor = core23::Tensor(params.shape({static_cast<int64_t>(emb_table_size_)})
-                                         .data_type(core23::ScalarType::Float));
-      auto n_tensor = core23::Tensor(params.shape({static_cast<int64_t>(emb_table_size_)})
-                                         .data_type(core23::ScalarType::Float));
+      auto z_tensor = core23::Tensor(
+          params.shape({static_cast<int64_t>(emb_table_size_ + emb_table_half_size_)})
+              .data_type(core23::ScalarType::Float));
+      auto n_tensor = core23::Tensor(
+          params.shape({static_cast<int64_t>(emb_table_size_ + emb_table_half_size_)})
+              .data_type(core23::ScalarType::Float));
 
       HCTR_LIB_THROW(cudaMemset(z_tensor.data(), 0, z_tensor.num_bytes()));
       HCTR_LIB_THROW(cudaMemset(n_tensor.data(), 0, n_tensor.num_bytes()));
@@ -498,27 +798,41 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
 
   for (size_t i = 0; i < h_table_ids_.size(); i++) {
     int table_id = h_table_ids_[i];
+    size_t offset = h_emb_table_ev_offset_[i];
+    size_t num_elements = h_size_per_table_[i];
+
+    // fp16-stored tables are initialized through a fp32 staging tensor so the
+    // generators stay unchanged, then narrowed into the __half buffer
+    core23::Tensor init_staging;
+    float *fill_ptr;
+    if (h_table_half_storage_[i]) {
+      core23::Device device(core23::DeviceType::GPU, core->get_device_id());
+      init_staging = core23::Tensor(core23::TensorParams()
+                                        .device(device)
+                                        .shape({static_cast<int64_t>(num_elements)})
+                                        .data_type(core23::ScalarType::Float));
+      fill_ptr = init_staging.data<float>();
+    } else {
+      fill_ptr = emb_table_.data<float>() + offset;
+    }
+
     std::function<void(const curandGenerator_t &)> init_table_functor;
 
     if (table_params[table_id].init_param.initializer_type == HugeCTR::Initializer_t::Default) {
       init_table_functor = [&](const curandGenerator_t &generator) {
         float up_bound = sqrt(1.f / h_table_max_vocabulary_size_[i]);
-        size_t offset = h_emb_table_ev_offset_[i];
-        size_t num_elements = h_emb_table_ev_offset_[i + 1] - h_emb_table_ev_offset_[i];
 
-        HugeCTR::UniformGenerator::fill(emb_table_.data<float>() + offset, num_elements, -up_bound,
-                                        up_bound, gpu_resource.get_sm_count(), generator,
+        HugeCTR::UniformGenerator::fill(fill_ptr, num_elements, -up_bound, up_bound,
+                                        gpu_resource.get_sm_count(), generator,
                                         gpu_resource.get_stream());
       };
     } else if (table_params[table_id].init_param.initializer_type ==
                HugeCTR::Initializer_t::Uniform) {
       init_table_functor = [&](const curandGenerator_t &generator) {
         float up_bound = table_params[table_id].init_param.uniform_params.up_bound;
-        size_t offset = h_emb_table_ev_offset_[i];
-        size_t num_elements = h_emb_table_ev_offset_[i + 1] - h_emb_table_ev_offset_[i];
 
-        HugeCTR::UniformGenerator::fill(emb_table_.data<float>() + offset, num_elements, -up_bound,
-                                        up_bound, gpu_resource.get_sm_count(), generator,
+        HugeCTR::UniformGenerator::fill(fill_ptr, num_elements, -up_bound, up_bound,
+                                        gpu_resource.get_sm_count(), generator,
                                         gpu_resource.get_stream());
       };
     } else if (table_params[table_id].init_param.initializer_type ==
@@ -527,15 +841,12 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
         const SinusoidalParams &sinus_params = table_params[table_id].init_param.sinusoidal_params;
         int max_sequence_len = sinus_params.max_sequence_len;
         int ev_size = sinus_params.ev_size;
-        size_t offset = h_emb_table_ev_offset_[i];
-        size_t num_elements = h_emb_table_ev_offset_[i + 1] - h_emb_table_ev_offset_[i];
 
         HCTR_CHECK_HINT(max_sequence_len * ev_size == static_cast<int>(num_elements),
                         "max_sequent_len * ev_size ", max_sequence_len * ev_size,
                         " should equal to num_elements ", num_elements);
-        HugeCTR::SinusoidalGenerator::fill(emb_table_.data<float>() + offset, num_elements, ev_size,
-                                           max_sequence_len, gpu_resource.get_sm_count(),
-                                           gpu_resource.get_stream());
+        HugeCTR::SinusoidalGenerator::fill(fill_ptr, num_elements, ev_size, max_sequence_len,
+                                           gpu_resource.get_sm_count(), gpu_resource.get_stream());
       };
     } else {
       HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall, "initializer not implemented");
@@ -547,6 +858,15 @@ RaggedStaticEmbeddingTable::RaggedStaticEmbeddingTable(
     } else {
       init_table_functor(gpu_resource.get_replica_variant_curand_generator());
     }
+
+    if (h_table_half_storage_[i]) {
+      constexpr int block_size = 256;
+      int grid_size = (static_cast<int64_t>(num_elements) - 1) / block_size + 1;
+      float_to_half_segment_kernel<<<grid_size, block_size, 0, gpu_resource.get_stream()>>>(
+          fill_ptr, num_elements, emb_table_half_.data<__half>() + offset);
+      // the staging tensor dies at the end of this iteration
+      HCTR_LIB_THROW(cudaStreamSynchronize(gpu_resource.get_stream()));
+    }
   }
 }
 
@@ -558,17 +878,47 @@ void RaggedStaticEmbeddingTable::lookup(const core23::Tensor &keys, size_t num_k
   CudaDeviceContext ctx(core_->get_device_id());
   cudaStream_t stream = core_->get_local_gpu()->get_stream();
   if (num_keys == 0) return;
+  if (has_half_tables_ &&
+      static_cast<int64_t>(num_keys) * max_half_ev_size_ > lookup_staging_capacity_) {
+    // high-water sizing: every looked-up key gets a staging row so fp16 rows
+    // can be dequantized without a per-table pass
+    lookup_staging_capacity_ = static_cast<int64_t>(num_keys) * max_half_ev_size_;
+    core23::Device device(core23::DeviceType::GPU, core_->get_device_id());
+    lookup_staging_ = core23::Tensor(core23::TensorParams()
+                                         .device(device)
+                                         .shape({lookup_staging_capacity_})
+                                         .data_type(core23::ScalarType::Float));
+  }
   DISPATCH_INTEGRAL_FUNCTION_CORE23(keys.data_type().type(), key_t, [&] {
     DISPATCH_INTEGRAL_FUNCTION_CORE23(id_space_offset.data_type().type(), offset_t, [&] {
       DISPATCH_INTEGRAL_FUNCTION_CORE23(num_key_per_table_offset_.data_type().type(), index_t, [&] {
         constexpr int block_size = 256;
         int grid_size = (num_keys - 1) / block_size + 1;
-        ragged_static_embedding_table_lookup_kernel<<<grid_size, block_size, 0, stream>>>(
-            keys.data<key_t>(), num_keys, id_space_offset.data<offset_t>(), num_id_space_offset,
-            id_space_list.data<int>(), table_ids_.data<int>(), table_ids_.num_elements(),
-            num_key_per_table_offset_.data<index_t>(), emb_table_.data<float>(),
-            emb_table_ev_offset_.data<uint64_t>(), local_ev_size_list_.data<int>(),
-            static_cast<float **>(emb_vec.data()));
+        size_t num_local_id_space = table_ids_.num_elements();
+        size_t smem_bytes =
+            sizeof(uint64_t) * (2 * num_id_space_offset - 1 + 5 * num_local_id_space);
+        if (smem_bytes <= 48 * 1024) {
+          ragged_static_embedding_table_lookup_smem_kernel<<<grid_size, block_size, smem_bytes,
+                                                             stream>>>(
+              keys.data<key_t>(), num_keys, id_space_offset.data<offset_t>(), num_id_space_offset,
+              id_space_list.data<int>(), table_ids_.data<int>(), num_local_id_space,
+              num_key_per_table_offset_.data<index_t>(), emb_table_.data<float>(),
+              has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+              table_half_storage_.data<int>(),
+              has_half_tables_ ? lookup_staging_.data<float>() : nullptr, max_half_ev_size_,
+              emb_table_ev_offset_.data<uint64_t>(), local_ev_size_list_.data<int>(),
+              static_cast<float **>(emb_vec.data()));
+        } else {
+          ragged_static_embedding_table_lookup_kernel<<<grid_size, block_size, 0, stream>>>(
+              keys.data<key_t>(), num_keys, id_space_offset.data<offset_t>(), num_id_space_offset,
+              id_space_list.data<int>(), table_ids_.data<int>(), num_local_id_space,
+              num_key_per_table_offset_.data<index_t>(), emb_table_.data<float>(),
+              has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+              table_half_storage_.data<int>(),
+              has_half_tables_ ? lookup_staging_.data<float>() : nullptr, max_half_ev_size_,
+              emb_table_ev_offset_.data<uint64_t>(), local_ev_size_list_.data<int>(),
+              static_cast<float **>(emb_vec.data()));
+        }
 
         HCTR_LIB_THROW(cudaPeekAtLastError());
       });
@@ -591,6 +941,8 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
   HCTR_CHECK(table_ids.data_type() == core23::ScalarType::Int32);
   HCTR_CHECK(ev_start_indices.data_type() == core23::ScalarType::UInt32);
 
+  const float wd_mul_lr = opt_param_.lr * opt_param_.weight_decay;
+
   if (opt_param_.optimizer == HugeCTR::Optimizer_t::SGD) {
     DISPATCH_INTEGRAL_FUNCTION_CORE23(unique_keys.data_type().type(), key_t, [&] {
       DISPATCH_INTEGRAL_FUNCTION_CORE23(num_key_per_table_offset_.data_type().type(), index_t, [&] {
@@ -601,6 +953,7 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
               table_ids_.num_elements(),
               num_key_per_table_offset_.data<index_t>(),
               emb_table_ev_offset_.data<uint64_t>(),
+              table_half_storage_.data<int>(),
           };
           SGDOptimizer<wgrad_t> optimizer;
 
@@ -616,7 +969,43 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
           kernel<<<grid_size, block_size, 0, stream>>>(
               unique_keys.data<key_t>(), num_unique_keys.data<size_t>(), table_ids.data<int>(),
               wgrad.data<wgrad_t>(), ev_start_indices.data<uint32_t>(), key_to_indices_func,
-              emb_table_.data<float>(), optimizer, opt_param_.lr, opt_param_.scaler);
+              emb_table_.data<float>(),
+              has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+              static_cast<uint64_t>(emb_table_size_), optimizer, opt_param_.lr, wd_mul_lr,
+              opt_param_.scaler);
+        });
+      });
+    });
+  } else if (opt_param_.optimizer == HugeCTR::Optimizer_t::AdaGrad &&
+             opt_param_.hyperparams.adagrad.quantized_state) {
+    DISPATCH_INTEGRAL_FUNCTION_CORE23(unique_keys.data_type().type(), key_t, [&] {
+      DISPATCH_INTEGRAL_FUNCTION_CORE23(num_key_per_table_offset_.data_type().type(), index_t, [&] {
+        DISPATCH_FLOAT_AND_HALF_FUNCTION_CORE23(wgrad.data_type().type(), wgrad_t, [&] {
+          auto q8_opt_buffer = std::get_if<AdaGradQ8OptBuffer>(&opt_buffer_);
+          HCTR_CHECK_HINT(q8_opt_buffer != nullptr, "Adagrad Q8 Opt Buffer not initialized.");
+          RaggedKeyToIndicesFunc<key_t, index_t> key_to_indices_func{
+              table_ids_.data<int>(),
+              local_ev_size_list_.data<int>(),
+              table_ids_.num_elements(),
+              num_key_per_table_offset_.data<index_t>(),
+              emb_table_ev_offset_.data<uint64_t>(),
+              table_half_storage_.data<int>(),
+          };
+
+          constexpr int block_size = 256;
+          const auto &kernel_param = core_->get_kernel_param();
+          const int grid_size =
+              HugeCTR::ceildiv(kernel_param.num_sms * kernel_param.max_thread_per_sm, block_size);
+          // The quantized path needs the warp-cooperative scalar layout for the
+          // row-wise requantization reduction, so there is no vec4 variant.
+          adagrad_q8_update_kernel<key_t, index_t, wgrad_t, decltype(key_to_indices_func)>
+              <<<grid_size, block_size, 0, stream>>>(
+                  unique_keys.data<key_t>(), num_unique_keys.data<size_t>(), table_ids.data<int>(),
+                  wgrad.data<wgrad_t>(), ev_start_indices.data<uint32_t>(), key_to_indices_func,
+                  emb_table_.data<float>(), q8_opt_buffer->opt_accum_q_tensor.data<uint8_t>(),
+                  q8_opt_buffer->opt_accum_scale_tensor.data<float>(),
+                  opt_param_.hyperparams.adagrad.epsilon, opt_param_.lr, wd_mul_lr,
+                  opt_param_.scaler);
         });
       });
     });
@@ -634,6 +1023,7 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
                     table_ids_.num_elements(),
                     num_key_per_table_offset_.data<index_t>(),
                     emb_table_ev_offset_.data<uint64_t>(),
+                    table_half_storage_.data<int>(),
                 };
                 AdaGradOptimizer<wgrad_t, acc_t> optimizer{
                     adagrad_opt_buffer->opt_accum_tensor.data<acc_t>(),
@@ -651,7 +1041,9 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
                 kernel<<<grid_size, block_size, 0, stream>>>(
                     unique_keys.data<key_t>(), num_unique_keys.data<size_t>(),
                     table_ids.data<int>(), wgrad.data<wgrad_t>(), ev_start_indices.data<uint32_t>(),
-                    key_to_indices_func, emb_table_.data<float>(), optimizer, opt_param_.lr,
+                    key_to_indices_func, emb_table_.data<float>(),
+                    has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+                    static_cast<uint64_t>(emb_table_size_), optimizer, opt_param_.lr, wd_mul_lr,
                     opt_param_.scaler);
               });
         });
@@ -671,6 +1063,7 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
                     table_ids_.num_elements(),
                     num_key_per_table_offset_.data<index_t>(),
                     emb_table_ev_offset_.data<uint64_t>(),
+                    table_half_storage_.data<int>(),
                 };
                 FtrlOptimizer<wgrad_t, opt_t> optimizer{
                     ftrl_opt_buffer->opt_z_tensor.data<opt_t>(),
@@ -686,10 +1079,13 @@ void RaggedStaticEmbeddingTable::update(const core23::Tensor &unique_keys,
                                                    decltype(key_to_indices_func)>
                                   : update_kernel<key_t, index_t, wgrad_t, decltype(optimizer),
                                                   decltype(key_to_indices_func)>;
+                // FTRL regularizes through lambda1/lambda2, so no decay term here.
                 kernel<<<grid_size, block_size, 0, stream>>>(
                     unique_keys.data<key_t>(), num_unique_keys.data<size_t>(),
                     table_ids.data<int>(), wgrad.data<wgrad_t>(), ev_start_indices.data<uint32_t>(),
-                    key_to_indices_func, emb_table_.data<float>(), optimizer, opt_param_.lr,
+                    key_to_indices_func, emb_table_.data<float>(),
+                    has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+                    static_cast<uint64_t>(emb_table_size_), optimizer, opt_param_.lr, 0.f,
                     opt_param_.scaler);
               });
         });
@@ -31,7 +31,15 @@ struct FtrlOptBuffer {
   core23::Tensor opt_n_tensor;
 };
 
-using OptBuffer = std::variant<AdaGradOptBuffer, FtrlOptBuffer>;
+// Block-wise 8-bit quantized AdaGrad accumulator: one uint8 per weight plus one
+// float scale per embedding row, dequantized/requantized on the fly in the
+// update kernel. Cuts the optimizer state to ~1/4 of the fp32 buffer.
+struct AdaGradQ8OptBuffer {
+  core23::Tensor opt_accum_q_tensor;      // uint8, emb_table_size_
+  core23::Tensor opt_accum_scale_tensor;  // float, one per embedding row
+};
+
+using OptBuffer = std::variant<AdaGradOptBuffer, FtrlOptBuffer, AdaGradQ8OptBuffer>;
 
 class RaggedStaticEmbeddingTable final : public IGroupedEmbeddingTable {
   std::shared_ptr<CoreResourceManager> core_;
@@ -54,6 +62,20 @@ class RaggedStaticEmbeddingTable final : public IGroupedEmbeddingTable {
   core23::Tensor local_ev_size_list_;   // num_local_id_space
   bool use_vectorized_kernel_;
 
+  // Slot-wise mixed precision (EmbeddingTableParam::half_precision_storage):
+  // tables flagged fp16 keep their vectors as __half in emb_table_half_ and
+  // their h_emb_table_ev_offset_ entry indexes that buffer instead of
+  // emb_table_. Lookups dequantize fp16 rows into lookup_staging_ so the
+  // embedding ops keep consuming fp32 row pointers; updates write back fp16.
+  std::vector<int> h_table_half_storage_;
+  bool has_half_tables_ = false;
+  size_t emb_table_half_size_ = 0;
+  core23::Tensor table_half_storage_;  // int per local table, 1 = fp16 storage
+  core23::Tensor emb_table_half_;
+  core23::Tensor lookup_staging_;  // fp32 rows of fp16 tables, sized on demand
+  int64_t lookup_staging_capacity_ = 0;
+  int max_half_ev_size_ = 0;
+
   HugeCTR::OptParams opt_param_;
   OptBuffer opt_buffer_;
 
@@ -89,6 +111,20 @@ class RaggedStaticEmbeddingTable final : public IGroupedEmbeddingTable {
   void load_by_id(core23::Tensor *h_keys_tensor, core23::Tensor *h_embedding_table,
                   int table_id) override;
 
+  // Sharded checkpoint IO: every GPU streams its own shard file directly through
+  // the FileSystem abstraction, D2H chunked and double buffered against the
+  // writes, instead of funneling all shards through rank-0 host memory. All GPUs
+  // call these concurrently with the same directory; a shard only loads back into
+  // an identically sharded table.
+  void dump_shard_to_file(const std::string &shard_dir);
+  void load_shard_from_file(const std::string &shard_dir);
+
+  // Same-host model push: writes a CUDA IPC descriptor (hps/embedding_ipc_snapshot.hpp)
+  // exposing this shard's key and embedding buffers, which a co-located HPS process maps
+  // and ingests peer-to-peer via ingest_ipc_snapshot(). The buffers stay owned by this
+  // table; the descriptor is only valid while this process is alive.
+  void export_ipc_shard(const std::string &descriptor_path);
+
   size_t size() const override;
 
   size_t capacity() const override;
@@ -14,24 +14,60 @@
  * limitations under the License.
  */
 
+#include <cuda.h>
 #include <curand_kernel.h>
 
+#include <core23/staging_buffer_pool.hpp>
 #include <data_simulator.hpp>
 #include <embedding/operators/generic_lookup.cuh>
 #include <embedding/view.hpp>
 #include <embedding_storage/ragged_static_embedding.hpp>
+#include <fstream>
+#include <hps/embedding_ipc_snapshot.hpp>
+#include <io/filesystem.hpp>
 #include <numeric>
 #include <utils.cuh>
 
 namespace embedding {
 
+namespace {
+
+// Binary header at the start of every shard file, validated on load so a shard
+// is only restored into an identically sharded table.
+struct RaggedShardHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t key_type_size;
+  uint64_t num_keys;
+  uint64_t num_emb_floats;
+  // v2: number of __half elements of the fp16-stored tables; 0 when every
+  // table is fp32
+  uint64_t num_emb_halfs;
+  uint64_t num_tables;
+};
+constexpr uint64_t kRaggedShardMagic = 0x5241474753484431ul;  // "RAGGSHD1"
+constexpr uint64_t kRaggedShardVersion = 2;
+constexpr size_t kShardIOChunkBytes = 64ul << 20;
+
+std::string shard_file_path(const std::string &shard_dir, int global_gpu_id) {
+  return shard_dir + "/ragged_static_embedding.shard." + std::to_string(global_gpu_id) + ".bin";
+}
+
+// Widen a segment of the fp16 table storage back to fp32 for checkpoint IO.
+__global__ void half_to_float_segment_kernel(const __half *src, size_t num_elements, float *dst) {
+  CUDA_1D_KERNEL_LOOP(i, num_elements) { dst[i] = __half2float(src[i]); }
+}
+
+}  // namespace
+
 template <typename key_t, typename index_t, typename emb_t>
 __global__ void embedding_insert_kernel(
     const key_t *keys, size_t num_keys, const uint32_t *id_space_offset, size_t num_id_space_offset,
     const emb_t *embedding_vector, const uint32_t *embedding_vector_offset,
     const int *id_space_list, const int *local_id_space_list, size_t num_local_id_space_list,
     const key_t *key_location, const index_t *emb_table_id_space_offset, float *emb_table,
-    const uint64_t *emb_table_ev_offset, const int *local_ev_size_list) {
+    __half *emb_table_half, const int *table_half_flags, const uint64_t *emb_table_ev_offset,
+    const int *local_ev_size_list) {
   uint32_t tid = threadIdx.x + blockIdx.x * blockDim.x;
   if (tid >= num_keys) return;
 
@@ -53,9 +89,16 @@ __global__ void embedding_insert_kernel(
   int ev_size = local_ev_size_list[local_id_space_idx];
 
   const emb_t *ev_for_insert = embedding_vector + embedding_vector_offset[tid];
-  for (int i = 0; i < ev_size; ++i) {
-    float ei = HugeCTR::TypeConvertFunc<float, emb_t>::convert(ev_for_insert[i]);
-    emb_table[ev_offset + idx * ev_size + i] = ei;
+  if (table_half_flags[local_id_space_idx]) {
+    for (int i = 0; i < ev_size; ++i) {
+      float ei = HugeCTR::TypeConvertFunc<float, emb_t>::convert(ev_for_insert[i]);
+      emb_table_half[ev_offset + idx * ev_size + i] = __float2half(ei);
+    }
+  } else {
+    for (int i = 0; i < ev_size; ++i) {
+      float ei = HugeCTR::TypeConvertFunc<float, emb_t>::convert(ev_for_insert[i]);
+      emb_table[ev_offset + idx * ev_size + i] = ei;
+    }
   }
 }
 
@@ -63,8 +106,9 @@ template <typename key_t, typename index_t, typename emb_t>
 __global__ void embedding_insert_by_tableindex_kernel(
     const key_t *insert_keys, size_t num_keys, const key_t *keys_table,
     const index_t *num_key_per_table_offset, const emb_t *insert_embedding_values,
-    float *embedding_table, int table_index, size_t max_vocabulary_size,
-    const uint64_t *embedding_table_offsets, const int *table_ev_size_list) {
+    float *embedding_table, __half *embedding_table_half, const int *table_half_flags,
+    int table_index, size_t max_vocabulary_size, const uint64_t *embedding_table_offsets,
+    const int *table_ev_size_list) {
   uint32_t tid = threadIdx.x + blockIdx.x * blockDim.x;
   if (tid >= num_keys) return;
 
@@ -76,14 +120,23 @@ __global__ void embedding_insert_by_tableindex_kernel(
   uint64_t idx =
       static_cast<uint64_t>(bs_upper_bound_sub_one(keys_table + key_offset, num_keys, insert_key));
   uint64_t embedding_value_offset = embedding_table_offsets[table_index];
-  float *tmp_embedding_table = embedding_table + embedding_value_offset;
   uint64_t input_offset = (uint64_t)tid * (uint64_t)embedding_vector_size;
   uint64_t output_offset = (uint64_t)idx * (uint64_t)embedding_vector_size;
 
-  for (uint64_t i = 0; i < embedding_vector_size; ++i) {
-    float ei =
-        HugeCTR::TypeConvertFunc<float, emb_t>::convert(insert_embedding_values[input_offset + i]);
-    tmp_embedding_table[output_offset + i] = ei;
+  if (table_half_flags[table_index]) {
+    __half *tmp_embedding_table = embedding_table_half + embedding_value_offset;
+    for (uint64_t i = 0; i < embedding_vector_size; ++i) {
+      float ei = HugeCTR::TypeConvertFunc<float, emb_t>::convert(
+          insert_embedding_values[input_offset + i]);
+      tmp_embedding_table[output_offset + i] = __float2half(ei);
+    }
+  } else {
+    float *tmp_embedding_table = embedding_table + embedding_value_offset;
+    for (uint64_t i = 0; i < embedding_vector_size; ++i) {
+      float ei = HugeCTR::TypeConvertFunc<float, emb_t>::convert(
+          insert_embedding_values[input_offset + i]);
+      tmp_embedding_table[output_offset + i] = ei;
+    }
   }
 }
 
@@ -109,7 +162,9 @@ void RaggedStaticEmbeddingTable::assign(const core23::Tensor &keys, size_t num_k
                 embedding_vector_offset.data<uint32_t>(), table_id_list.data<int>(),
                 table_ids_.data<int>(), table_ids_.num_elements(), keys_.data<key_t>(),
                 num_key_per_table_offset_.data<index_t>(), emb_table_.data<float>(),
-                emb_table_ev_offset_.data<uint64_t>(), local_ev_size_list_.data<int>());
+                has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+                table_half_storage_.data<int>(), emb_table_ev_offset_.data<uint64_t>(),
+                local_ev_size_list_.data<int>());
           }
         });
   });
@@ -130,8 +185,9 @@ void RaggedStaticEmbeddingTable::dump(core23::Tensor *keys, core23::Tensor *id_s
   *id_space_offset = core23::Tensor(params.shape({num_key_per_table_offset_.num_elements()})
                                         .data_type(num_key_per_table_offset_.data_type()));
 
-  *embedding_table =
-      core23::Tensor(params.shape({emb_table_.num_elements()}).data_type(emb_table_.data_type()));
+  *embedding_table = core23::Tensor(
+      params.shape({static_cast<int64_t>(emb_table_size_ + emb_table_half_size_)})
+          .data_type(emb_table_.data_type()));
 
   *ev_size_list = core23::Tensor(params.shape({local_ev_size_list_.num_elements()})
                                      .data_type(local_ev_size_list_.data_type()));
@@ -141,7 +197,39 @@ void RaggedStaticEmbeddingTable::dump(core23::Tensor *keys, core23::Tensor *id_s
 
   core23::copy_sync(*keys, keys_);
   core23::copy_sync(*id_space_offset, num_key_per_table_offset_);
-  core23::copy_sync(*embedding_table, emb_table_);
+  if (!has_half_tables_) {
+    core23::copy_sync(*embedding_table, emb_table_);
+  } else {
+    // assemble one logical fp32 table in table order: fp32 segments are copied
+    // as-is, fp16 segments are widened; the dumped layout is independent of the
+    // per-precision buffer split
+    CudaDeviceContext context(core_->get_device_id());
+    cudaStream_t stream = core_->get_local_gpu()->get_stream();
+    core23::Device device(core23::DeviceType::GPU, core_->get_device_id());
+    auto d_logical_table = core23::Tensor(
+        core23::TensorParams()
+            .device(device)
+            .shape({static_cast<int64_t>(emb_table_size_ + emb_table_half_size_)})
+            .data_type(core23::ScalarType::Float));
+
+    uint64_t logical_offset = 0;
+    for (size_t i = 0; i < h_size_per_table_.size(); ++i) {
+      float *dst = d_logical_table.data<float>() + logical_offset;
+      if (h_table_half_storage_[i]) {
+        constexpr int block_size = 256;
+        int grid_size = (static_cast<int64_t>(h_size_per_table_[i]) - 1) / block_size + 1;
+        half_to_float_segment_kernel<<<grid_size, block_size, 0, stream>>>(
+            emb_table_half_.data<__half>() + h_emb_table_ev_offset_[i], h_size_per_table_[i], dst);
+      } else {
+        HCTR_LIB_THROW(cudaMemcpyAsync(dst, emb_table_.data<float>() + h_emb_table_ev_offset_[i],
+                                       h_size_per_table_[i] * sizeof(float),
+                                       cudaMemcpyDeviceToDevice, stream));
+      }
+      logical_offset += h_size_per_table_[i];
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    core23::copy_sync(*embedding_table, d_logical_table);
+  }
   core23::copy_sync(*ev_size_list, local_ev_size_list_);
   core23::copy_sync(*id_space, table_ids_);
 }
@@ -164,12 +252,34 @@ void RaggedStaticEmbeddingTable::dump_by_id(core23::Tensor *h_keys_tensor,
     HCTR_LIB_THROW(cudaMemcpy(h_keys, d_keys, sizeof(key_t) * h_num_key_per_table_[table_index],
                               cudaMemcpyDeviceToHost));
 
-    float *d_embedding_vector = (float *)emb_table_.data();
-    d_embedding_vector += h_emb_table_ev_offset_[table_index];
     float *h_embedding_vector = (float *)h_embedding_table->data();
-    HCTR_LIB_THROW(cudaMemcpy(h_embedding_vector, d_embedding_vector,
-                              sizeof(float) * h_size_per_table_[table_index],
-                              cudaMemcpyDeviceToHost));
+    if (h_table_half_storage_[table_index]) {
+      // widen the fp16-stored table into a device staging tensor first; the
+      // dumped host tensor is always fp32
+      CudaDeviceContext context(core_->get_device_id());
+      cudaStream_t stream = core_->get_local_gpu()->get_stream();
+      core23::Device device(core23::DeviceType::GPU, core_->get_device_id());
+      auto d_staging = core23::Tensor(
+          core23::TensorParams()
+              .device(device)
+              .shape({static_cast<int64_t>(h_size_per_table_[table_index])})
+              .data_type(core23::ScalarType::Float));
+      constexpr int block_size = 256;
+      int grid_size = (static_cast<int64_t>(h_size_per_table_[table_index]) - 1) / block_size + 1;
+      half_to_float_segment_kernel<<<grid_size, block_size, 0, stream>>>(
+          emb_table_half_.data<__half>() + h_emb_table_ev_offset_[table_index],
+          h_size_per_table_[table_index], d_staging.data<float>());
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+      HCTR_LIB_THROW(cudaMemcpy(h_embedding_vector, d_staging.data<float>(),
+                                sizeof(float) * h_size_per_table_[table_index],
+                                cudaMemcpyDeviceToHost));
+    } else {
+      float *d_embedding_vector = (float *)emb_table_.data();
+      d_embedding_vector += h_emb_table_ev_offset_[table_index];
+      HCTR_LIB_THROW(cudaMemcpy(h_embedding_vector, d_embedding_vector,
+                                sizeof(float) * h_size_per_table_[table_index],
+                                cudaMemcpyDeviceToHost));
+    }
   });
 }
 
@@ -209,16 +319,209 @@ void RaggedStaticEmbeddingTable::load_by_id(core23::Tensor *h_keys_tensor,
             embedding_insert_by_tableindex_kernel<<<grid_size, block_size>>>(
                 (key_t *)d_keys.data(), num_keys, keys_.data<key_t>(),
                 num_key_per_table_offset_.data<index_t>(), (float *)d_embedding_vector.data(),
-                emb_table_.data<float>(), table_index, max_vocabulary_size,
+                emb_table_.data<float>(),
+                has_half_tables_ ? emb_table_half_.data<__half>() : nullptr,
+                table_half_storage_.data<int>(), table_index, max_vocabulary_size,
                 emb_table_ev_offset_.data<uint64_t>(), local_ev_size_list_.data<int>());
           }
         });
   });
 }
 
-size_t RaggedStaticEmbeddingTable::size() const { return emb_table_size_; }
+void RaggedStaticEmbeddingTable::dump_shard_to_file(const std::string &shard_dir) {
+  CudaDeviceContext context(core_->get_device_id());
+  cudaStream_t stream = core_->get_local_gpu()->get_stream();
+  std::string path = shard_file_path(shard_dir, core_->get_global_gpu_id());
+  auto fs = HugeCTR::FileSystemBuilder::build_unique_by_path(path);
+
+  RaggedShardHeader header;
+  header.magic = kRaggedShardMagic;
+  header.version = kRaggedShardVersion;
+  header.key_type_size = keys_.data_type().size();
+  header.num_keys = keys_.num_elements();
+  header.num_emb_floats = emb_table_size_;
+  header.num_emb_halfs = emb_table_half_size_;
+  header.num_tables = h_table_ids_.size();
+
+  fs->write(path, &header, sizeof(header), true);
+  fs->write(path, h_table_ids_.data(), h_table_ids_.size() * sizeof(int), false);
+  std::vector<uint64_t> num_key_per_table(h_num_key_per_table_.begin(),
+                                          h_num_key_per_table_.end());
+  fs->write(path, num_key_per_table.data(), num_key_per_table.size() * sizeof(uint64_t), false);
+
+  char *h_chunks[2];
+  cudaEvent_t chunk_events[2];
+  for (int b = 0; b < 2; ++b) {
+    h_chunks[b] =
+        static_cast<char *>(core23::StagingBufferPool::instance().acquire(kShardIOChunkBytes));
+    HCTR_LIB_THROW(cudaEventCreate(&chunk_events[b]));
+  }
+
+  // chunked D2H double buffered against the filesystem writes: while chunk i is
+  // written out, chunk i+1 is already copying into the other pinned buffer
+  auto stream_out = [&](const void *device_data, size_t total_bytes) {
+    size_t num_chunks = total_bytes == 0 ? 0 : (total_bytes - 1) / kShardIOChunkBytes + 1;
+    auto chunk_size = [&](size_t i) {
+      return std::min(kShardIOChunkBytes, total_bytes - i * kShardIOChunkBytes);
+    };
+    if (num_chunks > 0) {
+      HCTR_LIB_THROW(cudaMemcpyAsync(h_chunks[0], device_data, chunk_size(0),
+                                     cudaMemcpyDeviceToHost, stream));
+      HCTR_LIB_THROW(cudaEventRecord(chunk_events[0], stream));
+    }
+    for (size_t i = 0; i < num_chunks; ++i) {
+      if (i + 1 < num_chunks) {
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            h_chunks[(i + 1) % 2],
+            static_cast<const char *>(device_data) + (i + 1) * kShardIOChunkBytes, chunk_size(i + 1),
+            cudaMemcpyDeviceToHost, stream));
+        HCTR_LIB_THROW(cudaEventRecord(chunk_events[(i + 1) % 2], stream));
+      }
+      HCTR_LIB_THROW(cudaEventSynchronize(chunk_events[i % 2]));
+      fs->write(path, h_chunks[i % 2], chunk_size(i), false);
+    }
+  };
+
+  stream_out(keys_.data(), keys_.num_bytes());
+  stream_out(emb_table_.data(), emb_table_size_ * sizeof(float));
+  if (has_half_tables_) {
+    stream_out(emb_table_half_.data(), emb_table_half_size_ * sizeof(__half));
+  }
+
+  for (int b = 0; b < 2; ++b) {
+    HCTR_LIB_THROW(cudaEventDestroy(chunk_events[b]));
+    core23::StagingBufferPool::instance().release(h_chunks[b]);
+  }
+}
+
+void RaggedStaticEmbeddingTable::load_shard_from_file(const std::string &shard_dir) {
+  CudaDeviceContext context(core_->get_device_id());
+  cudaStream_t stream = core_->get_local_gpu()->get_stream();
+  std::string path = shard_file_path(shard_dir, core_->get_global_gpu_id());
+  auto fs = HugeCTR::FileSystemBuilder::build_unique_by_path(path);
+
+  RaggedShardHeader header;
+  size_t offset = 0;
+  fs->read(path, &header, sizeof(header), offset);
+  offset += sizeof(header);
+  HCTR_CHECK_HINT(header.magic == kRaggedShardMagic && header.version == kRaggedShardVersion,
+                  "not a ragged static embedding shard file: %s", path.c_str());
+  HCTR_CHECK_HINT(header.key_type_size == static_cast<uint64_t>(keys_.data_type().size()) &&
+                      header.num_keys == static_cast<uint64_t>(keys_.num_elements()) &&
+                      header.num_emb_floats == emb_table_size_ &&
+                      header.num_emb_halfs == emb_table_half_size_ &&
+                      header.num_tables == h_table_ids_.size(),
+                  "shard file %s does not match the sharding of this table", path.c_str());
+
+  std::vector<int> table_ids(header.num_tables);
+  fs->read(path, table_ids.data(), table_ids.size() * sizeof(int), offset);
+  offset += table_ids.size() * sizeof(int);
+  std::vector<uint64_t> num_key_per_table(header.num_tables);
+  fs->read(path, num_key_per_table.data(), num_key_per_table.size() * sizeof(uint64_t), offset);
+  offset += num_key_per_table.size() * sizeof(uint64_t);
+  for (size_t i = 0; i < header.num_tables; ++i) {
+    HCTR_CHECK_HINT(table_ids[i] == h_table_ids_[i] &&
+                        num_key_per_table[i] == static_cast<uint64_t>(h_num_key_per_table_[i]),
+                    "shard file %s does not match the sharding of this table", path.c_str());
+  }
+
+  char *h_chunks[2];
+  cudaEvent_t chunk_events[2];
+  for (int b = 0; b < 2; ++b) {
+    h_chunks[b] =
+        static_cast<char *>(core23::StagingBufferPool::instance().acquire(kShardIOChunkBytes));
+    HCTR_LIB_THROW(cudaEventCreate(&chunk_events[b]));
+    HCTR_LIB_THROW(cudaEventRecord(chunk_events[b], stream));
+  }
+
+  // chunked reads double buffered against H2D: while chunk i uploads, chunk i+1
+  // is already being read into the other pinned buffer
+  auto stream_in = [&](void *device_data, size_t total_bytes) {
+    size_t num_chunks = total_bytes == 0 ? 0 : (total_bytes - 1) / kShardIOChunkBytes + 1;
+    auto chunk_size = [&](size_t i) {
+      return std::min(kShardIOChunkBytes, total_bytes - i * kShardIOChunkBytes);
+    };
+    for (size_t i = 0; i < num_chunks; ++i) {
+      // the buffer is reused every other chunk; its previous upload must be done
+      HCTR_LIB_THROW(cudaEventSynchronize(chunk_events[i % 2]));
+      fs->read(path, h_chunks[i % 2], chunk_size(i), offset);
+      offset += chunk_size(i);
+      HCTR_LIB_THROW(cudaMemcpyAsync(static_cast<char *>(device_data) + i * kShardIOChunkBytes,
+                                     h_chunks[i % 2], chunk_size(i), cudaMemcpyHostToDevice,
+                                     stream));
+      HCTR_LIB_THROW(cudaEventRecord(chunk_events[i % 2], stream));
+    }
+  };
+
+  stream_in(keys_.data(), keys_.num_bytes());
+  stream_in(emb_table_.data(), emb_table_size_ * sizeof(float));
+  if (has_half_tables_) {
+    stream_in(emb_table_half_.data(), emb_table_half_size_ * sizeof(__half));
+  }
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
 
-size_t RaggedStaticEmbeddingTable::capacity() const { return emb_table_size_; }
+  for (int b = 0; b < 2; ++b) {
+    HCTR_LIB_THROW(cudaEventDestroy(chunk_events[b]));
+    core23::StagingBufferPool::instance().release(h_chunks[b]);
+  }
+}
+
+void RaggedStaticEmbeddingTable::export_ipc_shard(const std::string &descriptor_path) {
+  CudaDeviceContext context(core_->get_device_id());
+
+  // the IPC descriptor only carries one fp32 vector buffer; a consumer has no
+  // way to tell fp16 rows apart, so mixed-precision shards cannot be exported
+  if (has_half_tables_) {
+    HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall,
+                   "export_ipc_shard does not support fp16-stored embedding tables");
+  }
+
+  // IPC handles always map whole allocations, and the tensors may sit at an
+  // offset inside a pooled allocation, so resolve each buffer's allocation base
+  // and record the offset explicitly.
+  auto allocation_offset = [](const void *ptr, CUdeviceptr *base) {
+    HCTR_LIB_THROW(cuMemGetAddressRange(base, nullptr, reinterpret_cast<CUdeviceptr>(ptr)));
+    return static_cast<uint64_t>(reinterpret_cast<CUdeviceptr>(ptr) - *base);
+  };
+
+  HugeCTR::EmbeddingIpcShardHeader header{};
+  header.magic = HugeCTR::EMBEDDING_IPC_MAGIC;
+  header.version = HugeCTR::EMBEDDING_IPC_VERSION;
+  header.key_size_bytes = static_cast<uint32_t>(keys_.data_type().size());
+  header.num_tables = static_cast<uint32_t>(h_table_ids_.size());
+  header.device_id = core_->get_device_id();
+
+  CUdeviceptr keys_base, vectors_base;
+  header.keys_base_offset_bytes = allocation_offset(keys_.data(), &keys_base);
+  header.vectors_base_offset_bytes = allocation_offset(emb_table_.data(), &vectors_base);
+  HCTR_LIB_THROW(cudaIpcGetMemHandle(&header.keys_handle, reinterpret_cast<void *>(keys_base)));
+  HCTR_LIB_THROW(
+      cudaIpcGetMemHandle(&header.vectors_handle, reinterpret_cast<void *>(vectors_base)));
+
+  std::vector<HugeCTR::EmbeddingIpcTableRecord> records(h_table_ids_.size());
+  for (size_t i = 0; i < h_table_ids_.size(); ++i) {
+    records[i].table_id = h_table_ids_[i];
+    records[i].ev_size = h_local_ev_sizes_[i];
+    records[i].num_keys = h_num_key_per_table_[i];
+    records[i].key_offset = h_num_key_per_table_offset_[i];
+    records[i].vector_offset = h_emb_table_ev_offset_[i];
+  }
+
+  // IPC only works between processes on the same host, so unlike the shard
+  // checkpoints the descriptor goes through plain local file IO.
+  std::ofstream file(descriptor_path, std::ios::binary | std::ios::trunc);
+  HCTR_CHECK_HINT(file.is_open(), "Cannot write IPC snapshot descriptor %s",
+                  descriptor_path.c_str());
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(records.data()),
+             static_cast<std::streamsize>(records.size() * sizeof(HugeCTR::EmbeddingIpcTableRecord)));
+}
+
+size_t RaggedStaticEmbeddingTable::size() const { return emb_table_size_ + emb_table_half_size_; }
+
+size_t RaggedStaticEmbeddingTable::capacity() const {
+  return emb_table_size_ + emb_table_half_size_;
+}
 
 size_t RaggedStaticEmbeddingTable::key_num() const {
   return accumulate(h_num_key_per_table_.begin(), h_num_key_per_table_.end(), 0);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_fp16.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <embedding_storage/weight_io/compression.hpp>
+
+#ifdef ENABLE_ZSTD_CHECKPOINT
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace embedding {
+
+namespace {
+
+// Chunk size of the raw payload; small enough that a handful of chunks keeps the whole
+// thread pool busy even for mid-sized tables, large enough to amortize per-chunk overhead.
+constexpr size_t kChunkNbytes = 4 * 1024 * 1024;
+// Cap on the bytes sampled for dictionary training; beyond this the dictionary stops
+// improving while the training cost keeps growing.
+constexpr size_t kDictSampleLimit = 64 * 1024 * 1024;
+constexpr size_t kDictNbytes = 64 * 1024;
+
+int compression_level() {
+  const char* env = std::getenv("HCTR_EBC_COMPRESS_LEVEL");
+  return env ? std::atoi(env) : 3;
+}
+
+bool store_fp16() {
+  const char* env = std::getenv("HCTR_EBC_COMPRESS_FP16");
+  return env && std::atoi(env) != 0;
+}
+
+}  // namespace
+
+bool compressed_weight_dump_enabled() {
+  const char* env = std::getenv("HCTR_EBC_COMPRESSED_DUMP");
+  return env && std::atoi(env) != 0;
+}
+
+bool is_compressed_weight_blob(const void* payload_head, size_t nbytes) {
+  if (nbytes < sizeof(CompressedWeightHead)) {
+    return false;
+  }
+  CompressedWeightHead head;
+  std::memcpy(&head, payload_head, sizeof(head));
+  return head.magic == CompressedWeightMagic;
+}
+
+#ifdef ENABLE_ZSTD_CHECKPOINT
+
+std::vector<char> compress_weight_blob(const float* data, size_t num_floats, size_t ev_length,
+                                       HugeCTR::ThreadPool& thread_pool) {
+  const bool fp16 = store_fp16();
+  const int level = compression_level();
+
+  // Build the storage representation of the payload (fp32 pass-through or fp16).
+  const char* storage_ptr = reinterpret_cast<const char*>(data);
+  size_t storage_nbytes = num_floats * sizeof(float);
+  std::vector<__half> fp16_buffer;
+  if (fp16) {
+    fp16_buffer.resize(num_floats);
+    // Each worker converts a contiguous slice.
+    std::vector<std::future<void>> futures;
+    const size_t num_shards = thread_pool.size();
+    const size_t slice = (num_floats + num_shards - 1) / num_shards;
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+      futures.push_back(thread_pool.submit([&, shard]() {
+        const size_t begin = shard * slice;
+        const size_t end = std::min(num_floats, begin + slice);
+        for (size_t i = begin; i < end; ++i) {
+          fp16_buffer[i] = __float2half(data[i]);
+        }
+      }));
+    }
+    HugeCTR::ThreadPool::await(futures.begin(), futures.end());
+    storage_ptr = reinterpret_cast<const char*>(fp16_buffer.data());
+    storage_nbytes = num_floats * sizeof(__half);
+  }
+
+  // Train a dictionary on embedding-vector-sized samples. Training can legitimately fail
+  // for small or incompressible tables; fall back to dictionary-less compression then.
+  const size_t ev_nbytes = ev_length * (fp16 ? sizeof(__half) : sizeof(float));
+  std::vector<char> dict(kDictNbytes);
+  size_t dict_nbytes = 0;
+  if (ev_nbytes > 0 && storage_nbytes / ev_nbytes >= 16) {
+    const size_t num_samples = std::min(storage_nbytes, kDictSampleLimit) / ev_nbytes;
+    std::vector<size_t> sample_sizes(num_samples, ev_nbytes);
+    size_t trained = ZDICT_trainFromBuffer(dict.data(), dict.size(), storage_ptr,
+                                           sample_sizes.data(), num_samples);
+    if (!ZDICT_isError(trained)) {
+      dict_nbytes = trained;
+    }
+  }
+
+  const size_t num_chunks = (storage_nbytes + kChunkNbytes - 1) / kChunkNbytes;
+  std::vector<std::vector<char>> compressed_chunks(num_chunks);
+  std::vector<std::future<void>> futures;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    futures.push_back(thread_pool.submit([&, chunk]() {
+      const size_t begin = chunk * kChunkNbytes;
+      const size_t raw_size = std::min(kChunkNbytes, storage_nbytes - begin);
+      std::vector<char>& dst = compressed_chunks[chunk];
+      dst.resize(ZSTD_compressBound(raw_size));
+      ZSTD_CCtx* cctx = ZSTD_createCCtx();
+      const size_t written =
+          dict_nbytes > 0
+              ? ZSTD_compress_usingDict(cctx, dst.data(), dst.size(), storage_ptr + begin, raw_size,
+                                        dict.data(), dict_nbytes, level)
+              : ZSTD_compressCCtx(cctx, dst.data(), dst.size(), storage_ptr + begin, raw_size,
+                                  level);
+      ZSTD_freeCCtx(cctx);
+      if (ZSTD_isError(written)) {
+        HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, ZSTD_getErrorName(written));
+      }
+      dst.resize(written);
+    }));
+  }
+  HugeCTR::ThreadPool::await(futures.begin(), futures.end());
+
+  // Assemble head | dict | chunk size table | chunks.
+  CompressedWeightHead head{};
+  head.magic = CompressedWeightMagic;
+  head.version = 1;
+  head.storage_value_type = fp16 ? 1 : 0;
+  head.num_chunks = static_cast<uint32_t>(num_chunks);
+  head.raw_nbytes = num_floats * sizeof(float);
+  head.dict_nbytes = dict_nbytes;
+
+  size_t blob_nbytes = sizeof(head) + dict_nbytes + num_chunks * sizeof(uint64_t);
+  for (auto& chunk : compressed_chunks) {
+    blob_nbytes += chunk.size();
+  }
+  std::vector<char> blob(blob_nbytes);
+  char* write_ptr = blob.data();
+  std::memcpy(write_ptr, &head, sizeof(head));
+  write_ptr += sizeof(head);
+  std::memcpy(write_ptr, dict.data(), dict_nbytes);
+  write_ptr += dict_nbytes;
+  for (auto& chunk : compressed_chunks) {
+    const uint64_t chunk_nbytes = chunk.size();
+    std::memcpy(write_ptr, &chunk_nbytes, sizeof(uint64_t));
+    write_ptr += sizeof(uint64_t);
+  }
+  for (auto& chunk : compressed_chunks) {
+    std::memcpy(write_ptr, chunk.data(), chunk.size());
+    write_ptr += chunk.size();
+  }
+  return blob;
+}
+
+void decompress_weight_blob(const void* blob, size_t blob_nbytes, float* dst,
+                            size_t dst_num_floats, HugeCTR::ThreadPool& thread_pool) {
+  const char* read_ptr = static_cast<const char*>(blob);
+  CompressedWeightHead head;
+  HCTR_CHECK_HINT(blob_nbytes >= sizeof(head), "compressed weight blob is truncated");
+  std::memcpy(&head, read_ptr, sizeof(head));
+  read_ptr += sizeof(head);
+  HCTR_CHECK_HINT(head.magic == CompressedWeightMagic && head.version == 1,
+                  "not a supported compressed weight blob");
+  HCTR_CHECK_HINT(head.raw_nbytes == dst_num_floats * sizeof(float),
+                  "compressed weight blob does not match the expected table size");
+
+  const char* dict_ptr = read_ptr;
+  read_ptr += head.dict_nbytes;
+  const uint64_t* chunk_nbytes = reinterpret_cast<const uint64_t*>(read_ptr);
+  read_ptr += head.num_chunks * sizeof(uint64_t);
+
+  const bool fp16 = (head.storage_value_type == 1);
+  std::vector<__half> fp16_buffer;
+  char* storage_ptr = reinterpret_cast<char*>(dst);
+  size_t storage_nbytes = head.raw_nbytes;
+  if (fp16) {
+    fp16_buffer.resize(dst_num_floats);
+    storage_ptr = reinterpret_cast<char*>(fp16_buffer.data());
+    storage_nbytes = dst_num_floats * sizeof(__half);
+  }
+
+  std::vector<size_t> chunk_offsets(head.num_chunks, 0);
+  for (uint32_t chunk = 1; chunk < head.num_chunks; ++chunk) {
+    chunk_offsets[chunk] = chunk_offsets[chunk - 1] + chunk_nbytes[chunk - 1];
+  }
+
+  std::vector<std::future<void>> futures;
+  for (uint32_t chunk = 0; chunk < head.num_chunks; ++chunk) {
+    futures.push_back(thread_pool.submit([&, chunk]() {
+      const size_t begin = static_cast<size_t>(chunk) * kChunkNbytes;
+      const size_t raw_size = std::min(kChunkNbytes, storage_nbytes - begin);
+      ZSTD_DCtx* dctx = ZSTD_createDCtx();
+      const size_t written =
+          head.dict_nbytes > 0
+              ? ZSTD_decompress_usingDict(dctx, storage_ptr + begin, raw_size,
+                                          read_ptr + chunk_offsets[chunk], chunk_nbytes[chunk],
+                                          dict_ptr, head.dict_nbytes)
+              : ZSTD_decompressDCtx(dctx, storage_ptr + begin, raw_size,
+                                    read_ptr + chunk_offsets[chunk], chunk_nbytes[chunk]);
+      ZSTD_freeDCtx(dctx);
+      if (ZSTD_isError(written) || written != raw_size) {
+        HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, "corrupt compressed weight chunk");
+      }
+      if (fp16) {
+        // Convert this chunk back to fp32 in place of waiting for all chunks, so the
+        // conversion overlaps the remaining decompression work.
+        const size_t first = begin / sizeof(__half);
+        const size_t last = (begin + raw_size) / sizeof(__half);
+        for (size_t i = first; i < last; ++i) {
+          dst[i] = __half2float(fp16_buffer[i]);
+        }
+      }
+    }));
+  }
+  HugeCTR::ThreadPool::await(futures.begin(), futures.end());
+}
+
+#else  // !ENABLE_ZSTD_CHECKPOINT
+
+std::vector<char> compress_weight_blob(const float*, size_t, size_t, HugeCTR::ThreadPool&) {
+  HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError,
+                 "compressed checkpoints require building with ENABLE_ZSTD_CHECKPOINT=ON");
+  return {};
+}
+
+void decompress_weight_blob(const void*, size_t, float*, size_t, HugeCTR::ThreadPool&) {
+  HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError,
+                 "compressed checkpoints require building with ENABLE_ZSTD_CHECKPOINT=ON");
+}
+
+#endif  // ENABLE_ZSTD_CHECKPOINT
+
+}  // namespace embedding
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <embedding_storage/weight_io/data_info.hpp>
+#include <thread_pool.hpp>
+#include <vector>
+
+namespace embedding {
+
+/**
+ * Compressed weight-file payload written after the regular 128-byte file head.
+ *
+ * Layout: CompressedWeightHead | dictionary | uint64_t chunk_nbytes[num_chunks] | chunks.
+ * The payload is chunked so compression and decompression parallelize across the thread
+ * pool; a zstd dictionary trained on the table's embedding vectors is shared by all
+ * chunks. Vectors can optionally be stored as fp16 (storage_value_type == 1), which is
+ * converted back to fp32 on load.
+ */
+struct CompressedWeightHead {
+  uint32_t magic;               // CompressedWeightMagic
+  uint32_t version;             // layout version, currently 1
+  uint32_t storage_value_type;  // 0 = fp32, 1 = fp16
+  uint32_t num_chunks;
+  uint64_t raw_nbytes;   // size of the decompressed fp32 payload
+  uint64_t dict_nbytes;  // 0 when no dictionary could be trained
+};
+
+constexpr uint32_t CompressedWeightMagic = 0x575a4348;  // "HCZW"
+
+/** Whether HCTR_EBC_COMPRESSED_DUMP requests compressed weight files. */
+bool compressed_weight_dump_enabled();
+
+/** Whether the bytes following the file head carry a compressed weight payload. */
+bool is_compressed_weight_blob(const void* payload_head, size_t nbytes);
+
+/**
+ * Compress a table's fp32 weight payload. The zstd level is taken from
+ * HCTR_EBC_COMPRESS_LEVEL (default 3) and fp16 storage conversion from
+ * HCTR_EBC_COMPRESS_FP16. ev_length is used to cut dictionary training samples on
+ * embedding-vector boundaries.
+ */
+std::vector<char> compress_weight_blob(const float* data, size_t num_floats, size_t ev_length,
+                                       HugeCTR::ThreadPool& thread_pool = HugeCTR::ThreadPool::get());
+
+/**
+ * Decompress a blob produced by compress_weight_blob into dst, which must hold
+ * head.raw_nbytes bytes. Chunks decompress in parallel on the thread pool.
+ */
+void decompress_weight_blob(const void* blob, size_t blob_nbytes, float* dst, size_t dst_num_floats,
+                            HugeCTR::ThreadPool& thread_pool = HugeCTR::ThreadPool::get());
+
+}  // namespace embedding
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <embedding_storage/weight_io/compression.hpp>
 #include <embedding_storage/weight_io/parameter_IO.hpp>
 
 using namespace HugeCTR;
@@ -332,19 +333,30 @@ void EmbeddingParameterIO::dump_embedding_weight(const std::string& parameters_f
                                                            table_id);
         char* table_key_ptr = (char*)key_tensor_tmp.data();
         char* table_weight_ptr = (char*)weight_tensor_tmp.data();
+
+        // Only the key payload stays raw: keys barely compress while the vectors dominate
+        // the file size.
+        const char* weight_write_ptr = table_weight_ptr;
+        size_t weight_write_nbytes = weight_length * sizeof(float);
+        std::vector<char> compressed_blob;
+        if (compressed_weight_dump_enabled()) {
+          compressed_blob =
+              compress_weight_blob((const float*)table_weight_ptr, weight_length, table_ev_length);
+          weight_write_ptr = compressed_blob.data();
+          weight_write_nbytes = compressed_blob.size();
+        }
 #ifdef ENABLE_MPI
         if (resource_manager_->get_process_id() == 0) {
           file_system->write_to(ebc_key_path, table_key_ptr, 0, table_key_num * sizeof(key_t),
                                 false);
-          file_system->write_to(ebc_weight_path, table_weight_ptr, 0, weight_length * sizeof(float),
-                                false);
+          file_system->write_to(ebc_weight_path, weight_write_ptr, 0, weight_write_nbytes, false);
         } else {
           file_system->write_to(ebc_key_path, table_key_ptr, FileHeadNbytes, 0, false);
-          file_system->write_to(ebc_weight_path, table_weight_ptr, FileHeadNbytes, 0, false);
+          file_system->write_to(ebc_weight_path, weight_write_ptr, FileHeadNbytes, 0, false);
         }
 #else
           file_system->write_to(ebc_key_path,table_key_ptr,0,table_key_num*sizeof(key_t),false);
-          file_system->write_to(ebc_weight_path,table_weight_ptr,0,weight_length*sizeof(float),false);
+          file_system->write_to(ebc_weight_path,weight_write_ptr,0,weight_write_nbytes,false);
 #endif
       }
       // model parallel
@@ -433,8 +445,18 @@ void EmbeddingParameterIO::dump_embedding_weight(const std::string& parameters_f
         }
         file_system->write_to(ebc_key_path, table_key_ptr, key_offset,
                               table_key_num_local * sizeof(key_t), false);
-        file_system->write_to(ebc_weight_path, table_weight_ptr, weight_offset,
-                              weight_length_local * sizeof(float), false);
+        // Model-parallel shards of a multi-process run are written concurrently at
+        // precomputed offsets, which compression would invalidate; compress only when this
+        // process holds the whole table.
+        if (compressed_weight_dump_enabled() && nrank == 1) {
+          std::vector<char> compressed_blob =
+              compress_weight_blob(table_weight_ptr, weight_length_local, table_ev_length);
+          file_system->write_to(ebc_weight_path, compressed_blob.data(), weight_offset,
+                                compressed_blob.size(), false);
+        } else {
+          file_system->write_to(ebc_weight_path, table_weight_ptr, weight_offset,
+                                weight_length_local * sizeof(float), false);
+        }
         free(table_key_ptr);
         free(table_weight_ptr);
       } else {
@@ -445,6 +467,148 @@ void EmbeddingParameterIO::dump_embedding_weight(const std::string& parameters_f
   });
 }
 
+void EmbeddingParameterIO::dump_for_hps(const std::string& hps_model_folder_path,
+                                        struct EmbeddingParameterInfo& epi,
+                                        const std::vector<int>& table_ids,
+                                        const std::vector<std::string>& table_folder_names) {
+  HCTR_CHECK_HINT(table_ids.size() == table_folder_names.size(),
+                  "One folder name per dumped table is required.");
+
+  int num_local_gpus = resource_manager_->get_local_gpu_count();
+  int nrank = resource_manager_->get_num_process();
+  int myrank = resource_manager_->get_process_id();
+
+  auto file_system = get_fs_object(hps_model_folder_path);
+  file_system->make_dir(hps_model_folder_path);
+  EmbeddingCollection* tmp_ebc = embedding_collections_[epi.embedding_collection_id];
+  auto& group_embedding_tables = tmp_ebc->embedding_tables_;
+
+  DISPATCH_INTEGRAL_FUNCTION_CORE23(epi.key_type.type(), key_t, [&] {
+    for (int i = 0; i < static_cast<int>(table_ids.size()); ++i) {
+      const int table_id = table_ids[i];
+      if (table_id < 0 || table_id >= epi.table_nums) {
+        HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError, "Input table id is out of range");
+      }
+      const std::string table_folder = hps_model_folder_path + "/" + table_folder_names[i];
+      file_system->make_dir(table_folder);
+      // The HPS raw layout: headless key and vector payloads, keys always stored as long long.
+      const std::string hps_key_path = table_folder + "/key";
+      const std::string hps_vec_path = table_folder + "/emb_vector";
+      const size_t table_ev_length = epi.table_embedding_vector_lengths.at(table_id);
+
+      int group_nums = group_embedding_tables.size();
+      int group_index = -1;
+      for (int group_id = 0; group_id < group_nums; ++group_id) {
+        std::vector<int>& group_table_ids =
+            tmp_ebc->ebc_param_.grouped_table_params[group_id].table_ids;
+        auto find_iter = std::find(group_table_ids.begin(), group_table_ids.end(), table_id);
+        if (find_iter != group_table_ids.end()) {
+          group_index = group_id;
+          break;
+        }
+      }
+      if (group_index == -1) {
+        HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError,
+                       "can't find table id in any grouped tables");
+      }
+
+      int parallel_mode = epi.gemb_distribution->get_parallel(table_id);
+      // data parallel: the first GPU of rank 0 holds a full copy of the table.
+      if (parallel_mode == 1) {
+        HugeCTR::CudaDeviceContext context(core_list_[0]->get_device_id());
+        int global_gpu_id = core_list_[0]->get_global_gpu_id();
+        size_t table_key_num = epi.gemb_distribution->get(global_gpu_id, table_id);
+
+        core23::Device device(core23::DeviceType::CPU);
+        core23::TensorParams params = core23::TensorParams().device(device);
+        core23::Tensor key_tensor_tmp{
+            params.shape({static_cast<int64_t>(table_key_num)}).data_type(epi.key_type)};
+        core23::Tensor weight_tensor_tmp{
+            params.shape({static_cast<int64_t>(table_key_num * table_ev_length)})
+                .data_type(epi.embedding_value_type)};
+        group_embedding_tables[0][group_index]->dump_by_id(&key_tensor_tmp, &weight_tensor_tmp,
+                                                           table_id);
+
+        std::vector<long long> wide_keys(table_key_num);
+        const key_t* table_key_ptr = key_tensor_tmp.data<key_t>();
+        for (size_t k = 0; k < table_key_num; ++k) {
+          wide_keys[k] = static_cast<long long>(table_key_ptr[k]);
+        }
+        if (myrank == 0) {
+          file_system->write_to(hps_key_path, wide_keys.data(), 0,
+                                table_key_num * sizeof(long long), false);
+          file_system->write_to(hps_vec_path, weight_tensor_tmp.data(), 0,
+                                table_key_num * table_ev_length * sizeof(float), false);
+        } else {
+          file_system->write_to(hps_key_path, wide_keys.data(), 0, 0, false);
+          file_system->write_to(hps_vec_path, weight_tensor_tmp.data(), 0, 0, false);
+        }
+      }
+      // model parallel: every rank writes its shards at precomputed offsets.
+      else if (parallel_mode == 2) {
+        size_t table_key_num_local = 0;
+        std::vector<int> local_gpu_id_hit;
+        std::vector<size_t> table_key_num_hit;
+        for (int local_gpu_id = 0; local_gpu_id < num_local_gpus; ++local_gpu_id) {
+          HugeCTR::CudaDeviceContext context(core_list_[local_gpu_id]->get_device_id());
+          int global_gpu_id = core_list_[local_gpu_id]->get_global_gpu_id();
+          size_t tmp_key_num_gpu = epi.gemb_distribution->get(global_gpu_id, table_id);
+          if (tmp_key_num_gpu > 0) {
+            table_key_num_local += tmp_key_num_gpu;
+            local_gpu_id_hit.push_back(local_gpu_id);
+            table_key_num_hit.push_back(tmp_key_num_gpu);
+          }
+        }
+        std::vector<size_t> offset_per_rank(nrank, 0);
+        offset_per_rank[myrank] = table_key_num_local;
+#ifdef ENABLE_MPI
+        HCTR_MPI_THROW(MPI_Allgather(&table_key_num_local, 1, MPI_SIZE_T, offset_per_rank.data(),
+                                     1, MPI_SIZE_T, MPI_COMM_WORLD));
+#endif
+        std::exclusive_scan(offset_per_rank.begin(), offset_per_rank.end(), offset_per_rank.begin(),
+                            0);
+        const size_t key_offset = offset_per_rank[myrank] * sizeof(long long);
+        const size_t weight_offset = offset_per_rank[myrank] * table_ev_length * sizeof(float);
+
+        std::vector<long long> wide_keys(table_key_num_local);
+        std::vector<float> table_weights(table_key_num_local * table_ev_length);
+        size_t tmp_offset = 0;
+        for (int hit_index = 0; hit_index < static_cast<int>(local_gpu_id_hit.size());
+             ++hit_index) {
+          int hit_gpu_id = local_gpu_id_hit[hit_index];
+          size_t tmp_local_key_num = table_key_num_hit[hit_index];
+
+          core23::Device device(core23::DeviceType::CPU);
+          core23::TensorParams params = core23::TensorParams().device(device);
+          core23::Tensor key_tensor_tmp{
+              params.shape({static_cast<int64_t>(tmp_local_key_num)}).data_type(epi.key_type)};
+          core23::Tensor weight_tensor_tmp{
+              params.shape({static_cast<int64_t>(tmp_local_key_num * table_ev_length)})
+                  .data_type(epi.embedding_value_type)};
+
+          HugeCTR::CudaDeviceContext context(core_list_[hit_gpu_id]->get_device_id());
+          group_embedding_tables[hit_gpu_id][group_index]->dump_by_id(&key_tensor_tmp,
+                                                                      &weight_tensor_tmp, table_id);
+          const key_t* tmp_table_key_ptr = key_tensor_tmp.data<key_t>();
+          for (size_t k = 0; k < tmp_local_key_num; ++k) {
+            wide_keys[tmp_offset + k] = static_cast<long long>(tmp_table_key_ptr[k]);
+          }
+          memcpy(table_weights.data() + tmp_offset * table_ev_length, weight_tensor_tmp.data(),
+                 tmp_local_key_num * table_ev_length * sizeof(float));
+          tmp_offset += tmp_local_key_num;
+        }
+        file_system->write_to(hps_key_path, wide_keys.data(), key_offset,
+                              table_key_num_local * sizeof(long long), false);
+        file_system->write_to(hps_vec_path, table_weights.data(), weight_offset,
+                              table_key_num_local * table_ev_length * sizeof(float), false);
+      } else {
+        HCTR_OWN_THROW(HugeCTR::Error_t::UnspecificError,
+                       "For now , 3G embedding don't support this parallel model");
+      }
+    }
+  });
+}
+
 void EmbeddingParameterIO::dump_opt_state(const std::string& parameters_folder_path,
                                           struct EmbeddingParameterInfo& epi,
                                           const std::vector<int>& table_ids) {
@@ -486,7 +650,19 @@ void EmbeddingParameterIO::load_embedding_weight(
     size_t key_file_length = file_system->get_file_size(ebc_key_path);
     size_t weight_file_length = file_system->get_file_size(ebc_weight_path);
     size_t key_num = (key_file_length - FileHeadNbytes) / sizeof(key_t);
-    size_t weight_num = (weight_file_length - FileHeadNbytes) / sizeof(float) / ev_length;
+
+    // Probe the weight payload: compressed dumps carry their own head after the file head,
+    // and the uncompressed table size comes from that head instead of the file length.
+    CompressedWeightHead compressed_head{};
+    bool weight_compressed = false;
+    if (weight_file_length >= FileHeadNbytes + sizeof(compressed_head)) {
+      file_system->read_from(ebc_weight_path, &compressed_head, sizeof(compressed_head),
+                             FileHeadNbytes);
+      weight_compressed = is_compressed_weight_blob(&compressed_head, sizeof(compressed_head));
+    }
+    size_t weight_num =
+        weight_compressed ? compressed_head.raw_nbytes / sizeof(float) / ev_length
+                          : (weight_file_length - FileHeadNbytes) / sizeof(float) / ev_length;
     if (key_num != weight_num)
       HCTR_OWN_THROW(HugeCTR::Error_t::WrongInput,
                      "Error: key num is not equal with embedding vector num");
@@ -521,8 +697,16 @@ void EmbeddingParameterIO::load_embedding_weight(
     float* weight_tensor_ptr = weight_tensor_tmp.data<float>();
     float* embedding_weights_ptr = embedding_weights.data<float>();
 
-    file_system->read_from(ebc_weight_path, weight_tensor_ptr, key_num * ev_length * sizeof(key_t),
-                           FileHeadNbytes);
+    if (weight_compressed) {
+      std::vector<char> compressed_blob(weight_file_length - FileHeadNbytes);
+      file_system->read_from(ebc_weight_path, compressed_blob.data(), compressed_blob.size(),
+                             FileHeadNbytes);
+      decompress_weight_blob(compressed_blob.data(), compressed_blob.size(), weight_tensor_ptr,
+                             weight_num * ev_length);
+    } else {
+      file_system->read_from(ebc_weight_path, weight_tensor_ptr,
+                             key_num * ev_length * sizeof(key_t), FileHeadNbytes);
+    }
     size_t tmp_target_key_offset = 0;
     // TODO::need use openmp optimize
     for (size_t i = 0; i < key_num; ++i) {
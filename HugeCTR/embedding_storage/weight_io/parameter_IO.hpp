@@ -67,6 +67,22 @@ class EmbeddingParameterIO {
   void dump_opt_state(const std::string& parameters_folder_path, struct EmbeddingParameterInfo& epi,
                       const std::vector<int>& table_ids = std::vector<int>());
 
+  /**
+   * Dump embedding tables straight into the raw format the HPS model loader consumes: one
+   * folder per table containing a headless "key" file (keys widened to long long) and a
+   * headless "emb_vector" file (float vectors). The resulting folders can be passed to HPS
+   * as sparse model files or staged with HierParameterServer::load_model_version() without
+   * any conversion step in between.
+   *
+   * @param hps_model_folder_path The folder under which the table folders should be created.
+   * @param epi The parameter info of the embedding collection to dump.
+   * @param table_ids The ids of the tables to dump.
+   * @param table_folder_names The folder name for each entry of \p table_ids .
+   */
+  void dump_for_hps(const std::string& hps_model_folder_path, struct EmbeddingParameterInfo& epi,
+                    const std::vector<int>& table_ids,
+                    const std::vector<std::string>& table_folder_names);
+
   static std::shared_ptr<EmbeddingWeightIO> get_fs_object(
       const std::string& file_name, SparseFSType fs_type = SparseFSType::AUTO);
 
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace HugeCTR {
+
+/**
+ * Process-wide recorder for Chrome tracing / Perfetto "complete" events.
+ *
+ * Collection is gated by HCTR_PIPELINE_TRACE=1, the same toggle as the per-stage
+ * pipeline timing it feeds from: the Pipeline emits its CUDA-event stage windows
+ * here (placed on the wall clock via a host anchor taken when the iteration is
+ * launched), and the data-reader worker threads emit their host-side batch
+ * events. Model::export_chrome_trace() writes everything collected so far as a
+ * JSON file that chrome://tracing and ui.perfetto.dev open directly.
+ *
+ * Recording a sample is a mutex-guarded ring append, cheap enough to leave on
+ * for a production window; the ring keeps the most recent events and drops the
+ * oldest once full.
+ */
+class ChromeTraceRecorder {
+ public:
+  static ChromeTraceRecorder& instance();
+
+  static bool enabled();
+
+  // Microseconds on the steady clock shared by every emitter.
+  static uint64_t now_us();
+
+  // One "X" (complete) slice: pid groups by device, tid is the lane label shown
+  // in the UI (stream or worker-thread name).
+  void record(const std::string& name, const std::string& category, int device_id,
+              const std::string& lane, uint64_t begin_us, uint64_t dur_us);
+
+  // Write all collected events as Chrome trace JSON and clear the ring.
+  void export_json(const std::string& path);
+
+ private:
+  ChromeTraceRecorder() = default;
+
+  struct Event {
+    std::string name;
+    std::string category;
+    std::string lane;
+    int device_id;
+    uint64_t begin_us;
+    uint64_t dur_us;
+  };
+
+  std::mutex mutex_;
+  std::deque<Event> events_;
+};
+
+}  // namespace HugeCTR
@@ -54,6 +54,8 @@ class AllReduceInPlaceComm {
   static std::shared_ptr<AllReduceInPlaceComm> create_nccl(
       size_t num_process, bool use_mixed_precision,
       const std::vector<std::shared_ptr<GPUResource>>& gpu_resources);
+  static std::shared_ptr<AllReduceInPlaceComm> create_hybrid(
+      bool use_mixed_precision, const std::vector<std::shared_ptr<GPUResource>>& gpu_resources);
   static std::shared_ptr<AllReduceInPlaceComm> create_oneshot(
       size_t num_process, bool use_mixed_precision,
       const std::vector<std::shared_ptr<GPUResource>>& gpu_resources);
@@ -153,4 +155,40 @@ class NCCLARInplaceComm : public AllReduceInPlaceComm {
   size_t num_procs_ = 1;
   size_t num_gpus_ = 1;
 };
+
+/**
+ * Size-aware algorithm selection (HCTR_AR_AUTO_SELECT=1, single node). Registered
+ * collective sizes differ by orders of magnitude, and the crossover between the
+ * latency-bound oneshot kernel and NCCL's bandwidth-optimized rings depends on both
+ * size and topology, so instead of a static config choice every collective is
+ * registered with both backends and timed once its buffers are in place; all_reduce
+ * then dispatches each collective to its measured winner. Collectives the oneshot
+ * kernel cannot serve (no P2P access, unsupported rank count, unaligned size) go
+ * straight to NCCL.
+ */
+template <typename T>
+class HybridARInplaceComm : public AllReduceInPlaceComm {
+ public:
+  virtual Handle register_coll() final;
+  virtual void set_coll_buf(Handle coll, void* ar_ptr, size_t ar_size, size_t device_id) final;
+  virtual void register_coll_buf(Handle coll) final;
+  virtual void update_size(Handle coll, const size_t ar_size) final;
+  virtual void all_reduce(Handle coll, cudaStream_t stream, size_t device_id) final;
+
+  HybridARInplaceComm(const std::vector<std::shared_ptr<GPUResource>>& gpu_resources);
+
+ private:
+  bool oneshot_eligible(size_t ar_size) const;
+  float time_all_reduce(AllReduceInPlaceComm& comm, Handle coll);
+
+  const std::vector<std::shared_ptr<GPUResource>>& gpu_resources_;
+  size_t num_gpus_ = 1;
+  bool p2p_ok_ = false;
+
+  OneshotSingleARInplaceComm<T> oneshot_;
+  NCCLARInplaceComm<T> nccl_;
+
+  std::vector<size_t> coll_sizes_;
+  std::vector<bool> coll_uses_oneshot_;
+};
 }  // namespace HugeCTR
@@ -419,6 +419,13 @@ struct IbvProxy {
 
   int destroy_ = 0;
   IbvProxyState state_ = INIT;
+  // Progress accounting for the adaptive proxy loop: the contexts bump the
+  // counter whenever they observe forward progress (a new command, a posted
+  // send, a harvested completion), and the owning thread compares snapshots
+  // to decide when it may back off from busy-polling. Only ever written from
+  // the proxy thread itself.
+  unsigned long progress_events_ = 0;
+  void note_progress() { progress_events_++; }
   int active_ctx_ = 0;  // TODO: support for multiple active contexts
   InitConfig cfg_;
   std::unique_ptr<HierA2AIbvContext> hier_a2a_ibv_ctx_ = NULL;
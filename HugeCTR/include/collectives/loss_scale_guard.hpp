@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <gpu_resource.hpp>
+#include <memory>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Initial scale requested via HCTR_DYNAMIC_LOSS_SCALE, or 0 when unset.
+ * A value of 1 selects the default initial scale.
+ */
+float dynamic_loss_scale_init();
+
+/**
+ * @brief Dynamic mixed-precision loss scaling with device-side overflow detection.
+ *
+ * A static loss scale has to be picked conservatively or training aborts on the
+ * first overflow. When HCTR_DYNAMIC_LOSS_SCALE is set, ExchangeWgrad appends an
+ * inf/nan scan of the fused wgrad buffer to the gradient exchange and a
+ * single-thread kernel advances the usual dynamic-scaling state machine on the
+ * device: on overflow the scale is halved and the step is flagged to be skipped,
+ * after growth_interval clean steps the scale is doubled again. Losses read the
+ * current scale and optimizers read the skip flag through device pointers, so
+ * the common no-overflow path never synchronizes with the host and remains
+ * CUDA-graph capturable. All local GPUs see the same wgrad after the allreduce,
+ * so every GPU reaches the same scaling decision without extra communication.
+ */
+template <typename T>
+class LossScaleGuard {
+ public:
+  LossScaleGuard(const std::vector<std::shared_ptr<GPUResource>>& gpu_resources,
+                 float initial_scale);
+  ~LossScaleGuard();
+
+  /**
+   * Bind the fused wgrad buffer of each local GPU. ptr holds the buffer of each
+   * local GPU (identical layout on every GPU), size_in_bytes its size.
+   */
+  void init_buf(const std::vector<void*>& ptr, size_t size_in_bytes);
+
+  /**
+   * Scan the wgrad of one local GPU for inf/nan and advance the scaling state.
+   * Called from the per-device worker threads after the gradient exchange.
+   */
+  void check_and_update(size_t device_id, cudaStream_t stream);
+
+  /** Device float holding the current loss scale of one local GPU. */
+  float* loss_scale_ptr(size_t device_id) const;
+
+  /**
+   * Device float holding the scale that produced the pending gradients. The
+   * optimizer unscales with this one, since check_and_update may already have
+   * moved the current scale on for the next iteration.
+   */
+  const float* unscale_ptr(size_t device_id) const;
+
+  /** Device flag set to 1 when the pending optimizer update must be skipped. */
+  const int* skip_step_ptr(size_t device_id) const;
+
+ private:
+  struct GuardPerGPU {
+    T* wgrad_ptr = nullptr;
+    size_t num_elements = 0;
+    float* scale = nullptr;  // device [2]: {current loss scale, unscale of the pending step}
+    int* state = nullptr;    // device [3]: {overflow flag, skip flag, clean steps}
+  };
+
+  std::vector<GuardPerGPU> per_gpu_;
+  std::vector<std::shared_ptr<GPUResource>> gpu_resources_;
+  const float initial_scale_;
+};
+
+}  // namespace HugeCTR
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <general_buffer2.hpp>
+#include <gpu_resource.hpp>
+#include <memory>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Ratio requested via HCTR_WGRAD_TOPK_RATIO, or 0 when unset / out of (0, 1).
+ */
+float wgrad_topk_ratio();
+
+/**
+ * @brief Top-k sparsification with error feedback for the dense wgrad exchange.
+ *
+ * On bandwidth-starved interconnects the dense wgrad allreduce dominates the
+ * iteration, and most of the exchanged gradients are near zero. When
+ * HCTR_WGRAD_TOPK_RATIO is set, ExchangeWgrad replaces the in-place allreduce
+ * with a compressed exchange: a fused kernel adds the local residual into the
+ * wgrad buffer, packs entries whose magnitude exceeds an adaptive threshold
+ * into (index, value) pairs and banks everything else in the residual (error
+ * feedback), the packed pairs are allgathered over NCCL, and a scatter-add
+ * rebuilds the summed wgrad. The threshold is adjusted on the device each
+ * iteration to track the requested ratio, so the exchange needs no host
+ * synchronization and stays CUDA-graph capturable. Selection is approximate
+ * top-k; gradients dropped by the threshold or by capacity overflow are never
+ * lost, only delayed to a later iteration by the residual.
+ */
+template <typename T>
+class WgradCompressor {
+ public:
+  WgradCompressor(const std::vector<std::shared_ptr<GPUResource>>& gpu_resources, float ratio);
+
+  /**
+   * Allocate residual and packing buffers. ptr holds the fused wgrad buffer of
+   * each local GPU (identical layout on every GPU), size_in_bytes its size.
+   */
+  void init_buf(const std::vector<void*>& ptr, size_t size_in_bytes);
+
+  /**
+   * Compress, allgather and scatter-add the wgrad of one local GPU. Called from
+   * the per-device worker threads like AllReduceInPlaceComm::all_reduce.
+   */
+  void compress_exchange(size_t device_id, cudaStream_t stream);
+
+ private:
+  struct CompressorPerGPU {
+    T* wgrad_ptr = nullptr;
+    Tensor2<T> residual_;
+    Tensor2<uint32_t> send_indices_;
+    Tensor2<T> send_values_;
+    Tensor2<int> send_count_;
+    Tensor2<float> threshold_;  // [2]: {selection threshold, max |g| of last pass}
+    Tensor2<uint32_t> recv_indices_;
+    Tensor2<T> recv_values_;
+    Tensor2<int> recv_counts_;
+    std::shared_ptr<GeneralBuffer2<CudaAllocator>> buf_;
+  };
+
+  std::vector<std::shared_ptr<GPUResource>> gpu_resources_;
+  size_t num_gpus_ = 1;
+  int num_ranks_ = 1;
+  float ratio_;
+  size_t num_elems_ = 0;
+  size_t capacity_ = 0;  // packed pairs per rank, 2x the top-k target
+  std::vector<CompressorPerGPU> ctx_;
+};
+
+}  // namespace HugeCTR
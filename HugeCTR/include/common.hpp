@@ -64,11 +64,11 @@ namespace HugeCTR {
 
 #define WARP_SIZE 32
 
-enum class Check_t { Sum, None, Unknown };
+enum class Check_t { Sum, Crc32, None, Unknown };
 
 enum class DataReaderType_t { Norm, Raw, Parquet, RawAsync };
 
-enum class SourceType_t { FileList, Mmap, Parquet };
+enum class SourceType_t { FileList, Mmap, Parquet, Kafka };
 
 enum class TrainPSType_t { Staged, Cached };
 
@@ -115,6 +115,11 @@ class Network final {
    */
   void download_params_to_host(float* weight);
 
+  /**
+   * Writing opt states to cpu buffer.
+   */
+  void download_opt_states_to_host(char* h_opt_states);
+
   /**
    * Read parameters from cpu buffer.
    */
@@ -135,6 +140,14 @@ class Network final {
    */
   void exchange_wgrad();
 
+  /**
+   * Lowest wgrad address owned by the top layers, used to split the fused wgrad
+   * buffer for bucketed exchange. Returns nullptr when the network has no
+   * top/bottom split or when bottom-layer wgrads extend past that address
+   * (an interleaved layout cannot be bucketed).
+   */
+  void* get_top_wgrad_boundary() const;
+
   /**
    * Update parameters.
    */
@@ -153,6 +166,18 @@ class Network final {
     lr_sched_ = lr_sched;
   }
 
+  /**
+   * Dynamic loss scaling (HCTR_DYNAMIC_LOSS_SCALE): hand the loss-scale guard's
+   * device pointers to the train losses and the optimizer of this network.
+   */
+  void set_dynamic_loss_scale_ptrs(const float* scale_ptr, const float* unscale_ptr,
+                                   const int* skip_step_ptr) {
+    for (auto& loss : train_losses_) {
+      loss.second->set_scaler_ptr(scale_ptr);
+    }
+    optimizer_->set_dynamic_loss_scale_ptrs(unscale_ptr, skip_step_ptr);
+  }
+
   /**
    * initialize layer by layer
    */
@@ -191,12 +216,21 @@ class Network final {
 
   void conv_weight_(std::optional<core23::TensorContainer<__half, 1, 1>>& target_opt,
                     const std::optional<core23::TensorContainer<float, 1, 1>>& source_opt);
-  void prop_layers(const std::vector<Layer*>& layers, bool fprop, bool train);
+  // When need_input_grads is false, the bprop of a leading frozen run of the span is
+  // pruned (frozen-subgraph elimination); pass false only when no consumer below the
+  // span (raw input, not an embedding output) needs the gradients it would produce.
+  void prop_layers(const std::vector<Layer*>& layers, bool fprop, bool train,
+                   bool need_input_grads = true);
 
   void set_losses_common(const std::map<std::string, std::unique_ptr<ILoss>>& losses,
                          const std::map<std::string, float>& label_weights,
                          std::map<std::string, core23::Tensor>& loss_tensors);
 
+  // Branch-parallel execution schedules (HCTR_MULTI_STREAM_BRANCHES=1): per direction, layers
+  // grouped into dependency levels derived from activation-buffer overlap, computed lazily on
+  // the first pass once all buffers are bound.
+  std::map<std::pair<const Layer*, bool>, std::vector<std::vector<int>>> branch_schedules_;
+
   std::vector<std::unique_ptr<Layer>> train_layers_;    /**< vector of layers */
   std::vector<std::unique_ptr<Layer>> evaluate_layers_; /**< vector of layers */
 
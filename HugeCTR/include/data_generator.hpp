@@ -129,6 +129,23 @@ class IntPowerLawDataSimulator : public IDataSimulator<T> {
   double min_, max_, offset_;
 };
 
+/**
+ * Build the key simulator of one slot. A non-empty alpha_array overrides the global
+ * distribution slot by slot: a positive entry selects a power-law of that skew, a zero or
+ * negative entry falls back to uniform. This lets generated sets match measured per-feature
+ * production skew instead of one shared alpha.
+ */
+template <typename T>
+inline std::shared_ptr<IDataSimulator<T>> make_slot_key_simulator(
+    T min, T max, bool long_tail, float alpha, const std::vector<float>& alpha_array, size_t slot) {
+  const float slot_alpha = alpha_array.empty() ? alpha : alpha_array[slot];
+  const bool slot_long_tail = alpha_array.empty() ? long_tail : (slot_alpha > 0.f);
+  if (slot_long_tail) {
+    return std::make_shared<IntPowerLawDataSimulator<T>>(min, max, slot_alpha);
+  }
+  return std::make_shared<IntUniformDataSimulator<T>>(min, max);
+}
+
 /**
  * Generate random dataset for HugeCTR test.
  */
@@ -381,7 +398,8 @@ void data_generation_for_test2(std::string file_list_name, std::string data_pref
                                int num_records_per_file, int slot_num,
                                std::vector<size_t> voc_size_array, int label_dim, int dense_dim,
                                std::vector<int> nnz_array, int num_threads = 1,
-                               bool long_tail = false, float alpha = 0.0) {
+                               bool long_tail = false, float alpha = 0.0,
+                               const std::vector<float>& alpha_array = {}) {
   HCTR_LOG(WARNING, WORLD,
            "Norm format will be deprecated in a future release, please use Parquet for an "
            "alternative\n");
@@ -417,7 +435,6 @@ void data_generation_for_test2(std::string file_list_name, std::string data_pref
 #pragma omp parallel for num_threads(num_threads)
   for (int k = 0; k < num_files; k++) {
     std::string tmp_file_name(data_prefix + std::to_string(k) + ".data");
-    file_list_stream << (tmp_file_name + "\n");
     HCTR_LOG_S(INFO, WORLD) << tmp_file_name << std::endl;
     // data generation;
     std::ofstream out_stream(tmp_file_name, std::ofstream::binary);
@@ -434,13 +451,10 @@ void data_generation_for_test2(std::string file_list_name, std::string data_pref
     std::vector<std::shared_ptr<IDataSimulator<T>>> ldata_sim_vec;
     size_t accum = 0;
     // todo risk of type Int
-    for (auto& voc : voc_size_array) {
-      size_t accum_next = accum + voc;
-      if (long_tail) {
-        ldata_sim_vec.emplace_back(new IntPowerLawDataSimulator<T>(accum, accum_next - 1, alpha));
-      } else {
-        ldata_sim_vec.emplace_back(new IntUniformDataSimulator<T>(accum, accum_next - 1));
-      }
+    for (size_t s = 0; s < voc_size_array.size(); s++) {
+      size_t accum_next = accum + voc_size_array[s];
+      ldata_sim_vec.emplace_back(make_slot_key_simulator<T>(accum, accum_next - 1, long_tail, alpha,
+                                                            alpha_array, s));
       accum = accum_next;
     }
 
@@ -501,7 +515,8 @@ void data_generation_for_parquet(std::string file_list_name, std::string data_pr
                                  int num_records_per_file, int slot_num, int label_dim,
                                  int dense_dim, const std::vector<size_t> slot_size_array,
                                  std::vector<int> nnz_array, bool long_tail = false,
-                                 float alpha = 0.0) {
+                                 float alpha = 0.0, int num_threads = 1,
+                                 const std::vector<float>& alpha_array = {}) {
   if (slot_num != (int)slot_size_array.size() || slot_num != (int)nnz_array.size()) {
     HCTR_LOG(ERROR, WORLD, "slot_num != slot_size_array.size() || slot_num != nnz_array.size()\n");
     exit(-1);
@@ -516,97 +531,102 @@ void data_generation_for_parquet(std::string file_list_name, std::string data_pr
 
   std::ofstream file_list_stream(file_list_name, std::ofstream::out);
   file_list_stream << (std::to_string(num_files) + "\n");
+  // Write the file list sequentially so shard order is stable regardless of thread count.
+  for (int k = 0; k < num_files; k++) {
+    file_list_stream << (data_prefix + std::to_string(k) + ".parquet\n");
+  }
 
   using CVector = std::vector<std::unique_ptr<cudf::column>>;
+// Shards are generated concurrently: the host-side simulation (the dominant cost for skewed
+// distributions) runs fully parallel, while cudf column assembly and the Parquet write of each
+// shard funnel through one thread at a time.
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
   for (int k = 0; k < num_files; k++) {
-    // cudf columns
-    CVector cols;
     std::string tmp_file_name(data_prefix + std::to_string(k) + ".parquet");
-    file_list_stream << (tmp_file_name + "\n");
     HCTR_LOG_S(INFO, WORLD) << tmp_file_name << std::endl;
-    // Initialize Simulators
+    // Initialize Simulators. Each file has its own so no state is shared across threads.
     FloatUniformDataSimulator<float> fdata_sim(0, 1);  // for label and dense
     std::vector<std::shared_ptr<IDataSimulator<T>>> ldata_sim_vec;
+    std::vector<std::shared_ptr<IDataSimulator<int>>> nnz_sim_vec;
     // todo risk of type Int
-    for (auto& voc : slot_size_array) {
-      size_t accum_next = voc;
-      if (long_tail) {
-        ldata_sim_vec.emplace_back(new IntPowerLawDataSimulator<T>(0, accum_next - 1, alpha));
-      } else {
-        ldata_sim_vec.emplace_back(new IntUniformDataSimulator<T>(0, accum_next - 1));
-      }
+    for (size_t s = 0; s < slot_size_array.size(); s++) {
+      ldata_sim_vec.emplace_back(make_slot_key_simulator<T>(0, slot_size_array[s] - 1, long_tail,
+                                                            alpha, alpha_array, s));
+      nnz_sim_vec.emplace_back(new IntUniformDataSimulator<int>(1, nnz_array[s]));
     }
 
-    // for label columns
-    for (int j = 0; j < label_dim; j++) {
-      std::vector<float> label_vector(num_records_per_file);
-      for (int i = 0; i < num_records_per_file; i++) {
-        float label_ = fdata_sim.get_num();
-        label_vector[i] = label_;
-      }
-      rmm::device_buffer dev_buffer(label_vector.data(), sizeof(float) * num_records_per_file,
-                                    rmm::cuda_stream_default);
-      cols.emplace_back(std::make_unique<cudf::column>(
-          cudf::data_type{cudf::type_to_id<float>()}, cudf::size_type(num_records_per_file),
-          std::move(dev_buffer), rmm::device_buffer{}, 0));
-    }
-    // for dense columns
-    for (int j = 0; j < dense_dim; j++) {
-      std::vector<float> dense_vector(num_records_per_file);
+    // for label and dense columns
+    std::vector<std::vector<float>> label_dense_vectors(label_dim + dense_dim);
+    for (int j = 0; j < label_dim + dense_dim; j++) {
+      label_dense_vectors[j].resize(num_records_per_file);
       for (int i = 0; i < num_records_per_file; i++) {
-        float _dense = fdata_sim.get_num();
-        dense_vector[i] = _dense;
+        label_dense_vectors[j][i] = fdata_sim.get_num();
       }
-      rmm::device_buffer dev_buffer(dense_vector.data(), sizeof(float) * num_records_per_file,
-                                    rmm::cuda_stream_default);
-      cols.emplace_back(std::make_unique<cudf::column>(
-          cudf::data_type{cudf::type_to_id<float>()}, cudf::size_type(num_records_per_file),
-          std::move(dev_buffer), rmm::device_buffer{}, 0));
     }
     // for sparse columns
-    // size_t offset = 0;
-    for (int k = 0; k < slot_num; k++) {
-      std::vector<T> slot_vector;
-      std::vector<int32_t> row_offset_vector(num_records_per_file + 1);
+    std::vector<std::vector<T>> slot_vectors(slot_num);
+    std::vector<std::vector<int32_t>> row_offset_vectors(slot_num);
+    for (int s = 0; s < slot_num; s++) {
+      std::vector<T>& slot_vector = slot_vectors[s];
+      std::vector<int32_t>& row_offset_vector = row_offset_vectors[s];
+      row_offset_vector.resize(num_records_per_file + 1);
       int32_t offset = 0;
       for (int i = 0; i < num_records_per_file; i++) {
-        int nnz = 1 + rand() % nnz_array[k];
+        int nnz = nnz_sim_vec[s]->get_num();
         row_offset_vector[i] = offset;
         offset += nnz;
         for (int j = 0; j < nnz; j++) {
-          T key = ldata_sim_vec[k]->get_num();
+          T key = ldata_sim_vec[s]->get_num();
           slot_vector.push_back(key);
         }
       }
       row_offset_vector[num_records_per_file] = offset;
-      if (nnz_array[k] == 1) {
-        rmm::device_buffer dev_buffer(slot_vector.data(), sizeof(T) * slot_vector.size(),
+    }
+
+#pragma omp critical
+    {
+      CVector cols;
+      for (int j = 0; j < label_dim + dense_dim; j++) {
+        rmm::device_buffer dev_buffer(label_dense_vectors[j].data(),
+                                      sizeof(float) * num_records_per_file,
                                       rmm::cuda_stream_default);
         cols.emplace_back(std::make_unique<cudf::column>(
-            cudf::data_type{cudf::type_to_id<T>()}, cudf::size_type(slot_vector.size()),
+            cudf::data_type{cudf::type_to_id<float>()}, cudf::size_type(num_records_per_file),
             std::move(dev_buffer), rmm::device_buffer{}, 0));
-
-      } else {
-        rmm::device_buffer dev_buffer_0(slot_vector.data(), sizeof(T) * slot_vector.size(),
-                                        rmm::cuda_stream_default);
-        auto child = std::make_unique<cudf::column>(
-            cudf::data_type{cudf::type_to_id<T>()}, cudf::size_type(slot_vector.size()),
-            std::move(dev_buffer_0), rmm::device_buffer{}, 0);
-        rmm::device_buffer dev_buffer_1(row_offset_vector.data(),
-                                        sizeof(int32_t) * row_offset_vector.size(),
+      }
+      for (int s = 0; s < slot_num; s++) {
+        const std::vector<T>& slot_vector = slot_vectors[s];
+        const std::vector<int32_t>& row_offset_vector = row_offset_vectors[s];
+        if (nnz_array[s] == 1) {
+          rmm::device_buffer dev_buffer(slot_vector.data(), sizeof(T) * slot_vector.size(),
                                         rmm::cuda_stream_default);
-        auto row_off = std::make_unique<cudf::column>(
-            cudf::data_type{cudf::type_to_id<int32_t>()}, cudf::size_type(row_offset_vector.size()),
-            std::move(dev_buffer_1), rmm::device_buffer{}, 0);
-        cols.emplace_back(cudf::make_lists_column(
-            num_records_per_file, std::move(row_off), std::move(child), 0,
-            cudf::create_null_mask(num_records_per_file, cudf::mask_state::ALL_VALID)));
+          cols.emplace_back(std::make_unique<cudf::column>(
+              cudf::data_type{cudf::type_to_id<T>()}, cudf::size_type(slot_vector.size()),
+              std::move(dev_buffer), rmm::device_buffer{}, 0));
+
+        } else {
+          rmm::device_buffer dev_buffer_0(slot_vector.data(), sizeof(T) * slot_vector.size(),
+                                          rmm::cuda_stream_default);
+          auto child = std::make_unique<cudf::column>(
+              cudf::data_type{cudf::type_to_id<T>()}, cudf::size_type(slot_vector.size()),
+              std::move(dev_buffer_0), rmm::device_buffer{}, 0);
+          rmm::device_buffer dev_buffer_1(row_offset_vector.data(),
+                                          sizeof(int32_t) * row_offset_vector.size(),
+                                          rmm::cuda_stream_default);
+          auto row_off = std::make_unique<cudf::column>(cudf::data_type{cudf::type_to_id<int32_t>()},
+                                                        cudf::size_type(row_offset_vector.size()),
+                                                        std::move(dev_buffer_1),
+                                                        rmm::device_buffer{}, 0);
+          cols.emplace_back(cudf::make_lists_column(
+              num_records_per_file, std::move(row_off), std::move(child), 0,
+              cudf::create_null_mask(num_records_per_file, cudf::mask_state::ALL_VALID)));
+        }
       }
+      cudf::table input_table(std::move(cols));
+      cudf::io::parquet_writer_options writer_args = cudf::io::parquet_writer_options::builder(
+          cudf::io::sink_info{tmp_file_name}, input_table.view());
+      cudf::io::write_parquet(writer_args);
     }
-    cudf::table input_table(std::move(cols));
-    cudf::io::parquet_writer_options writer_args = cudf::io::parquet_writer_options::builder(
-        cudf::io::sink_info{tmp_file_name}, input_table.view());
-    cudf::io::write_parquet(writer_args);
   }
   file_list_stream.close();
   HCTR_LOG_S(INFO, WORLD) << file_list_name << " done!" << std::endl;
@@ -1083,6 +1103,9 @@ struct DataGeneratorParams {
   Distribution_t dist_type;
   PowerLaw_t power_law_type;
   float alpha;
+  // Optional per-slot skew. When non-empty (size == num_slot), slot s draws its keys from a
+  // power-law with alpha_array[s] (<= 0 means uniform), overriding dist_type/alpha.
+  std::vector<float> alpha_array;
   int num_files;
   int eval_num_files;
   int num_samples_per_file;
@@ -1096,7 +1119,7 @@ struct DataGeneratorParams {
                       Check_t check_type, Distribution_t dist_type, PowerLaw_t power_law_type,
                       float alpha, int num_files, int eval_num_files, int num_samples_per_file,
                       int num_samples, int eval_num_samples, bool float_label_dense,
-                      int num_threads);
+                      int num_threads, const std::vector<float>& alpha_array = {});
 };
 
 class DataGenerator {
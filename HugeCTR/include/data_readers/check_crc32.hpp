@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+#include <common.hpp>
+#include <cstring>
+#include <data_readers/checker.hpp>
+#include <data_readers/source.hpp>
+
+namespace HugeCTR {
+
+/**
+ * @brief CRC32C (Castagnoli) record validation for the Norm format.
+ *
+ * Same record framing as CheckSum, but the trailing check value is a 4-byte CRC32C
+ * instead of a 1-byte sum. On x86 the CRC is computed with the SSE4.2 crc32
+ * instruction, 8 bytes per cycle, so validation is a single instruction-accelerated
+ * pass over each record.
+ */
+class CheckCRC32 : public Checker {
+ private:
+  const int MAX_TRY_{10};
+  int counter_;    /**< once counter_==0 will do the CRC compare */
+  uint32_t accum_; /**< running (pre-final-xor) CRC state */
+
+  static uint32_t crc32c(uint32_t crc, const char* data, size_t n) {
+    crc = ~crc;
+    size_t i = 0;
+#ifdef __SSE4_2__
+    for (; i + 8 <= n; i += 8) {
+      uint64_t chunk;
+      memcpy(&chunk, data + i, sizeof(chunk));
+      crc = static_cast<uint32_t>(_mm_crc32_u64(crc, chunk));
+    }
+    for (; i < n; i++) {
+      crc = _mm_crc32_u8(crc, static_cast<unsigned char>(data[i]));
+    }
+#else
+    for (; i < n; i++) {
+      crc ^= static_cast<unsigned char>(data[i]);
+      for (int k = 0; k < 8; k++) {
+        crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1u)));
+      }
+    }
+#endif
+    return ~crc;
+  }
+
+ public:
+  CheckCRC32(Source& src) : Checker(src), counter_(0), accum_(0) {}
+
+  /**
+   * Read "bytes_to_read" byte to the memory associated to ptr.
+   * Users don't need to manually maintain the check bit offset, just specify
+   * number of bytes you really want to see in ptr.
+   * @param ptr pointer to user located buffer
+   * @param bytes_to_read bytes to read
+   * @return `DataCheckError` `OutOfBound` `Success` `UnspecificError`
+   */
+  Error_t read(char* ptr, size_t bytes_to_read) noexcept {
+    try {
+      // if counter == 0 read int length and reset the CRC state
+      if (counter_ == 0) {
+        Checker::src_.read(reinterpret_cast<char*>(&counter_), sizeof(int));
+      }
+      counter_ -= bytes_to_read;
+      // if user read more data than expected, return `BrokenFile`.
+      // User should check this error and call next_source to new a source.
+      if (counter_ < 0) {
+        std::ostringstream os;
+        os << "counter_ " << counter_ << "< 0";
+        HCTR_OWN_THROW(Error_t::BrokenFile, os.str());
+      } else {
+        Checker::src_.read(ptr, bytes_to_read);
+        accum_ = crc32c(accum_, ptr, bytes_to_read);
+        // do the CRC compare when counter_ == 0.
+        if (counter_ == 0) {
+          uint32_t crc = 0;
+          Checker::src_.read(reinterpret_cast<char*>(&crc), sizeof(uint32_t));
+          if (accum_ == crc) {
+            accum_ = 0;
+            return Error_t::Success;
+          } else {
+            accum_ = 0;
+            return Error_t::DataCheckError;
+          }
+        } else {
+          return Error_t::Success;
+        }
+      }
+      return Error_t::UnspecificError;
+    } catch (const std::runtime_error& rt_err) {
+      HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      return Error_t::BrokenFile;
+    }
+  }
+
+  /**
+   * Start a new file to read.
+   * @return `FileCannotOpen` or `UnspecificError`
+   */
+  Error_t next_source(long long expected_next_source_items) {
+    // initialize
+    counter_ = 0;
+    accum_ = 0;
+    for (int i = MAX_TRY_; i > 0; i--) {
+      Error_t flag_eof = Checker::src_.next_source(expected_next_source_items);
+      if (flag_eof == Error_t::Success || flag_eof == Error_t::EndOfFile) {
+        return flag_eof;
+      }
+    }
+    HCTR_OWN_THROW(Error_t::FileCannotOpen,
+                   "Checker::src_.next_source() == Error_t::Success failed");
+    return Error_t::FileCannotOpen;  // to elimate compile error
+  }
+};
+
+}  // namespace HugeCTR
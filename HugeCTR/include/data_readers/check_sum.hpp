@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include <common.hpp>
 #include <data_readers/checker.hpp>
 #include <data_readers/source.hpp>
@@ -26,6 +30,32 @@ class CheckSum : public Checker {
   const int MAX_TRY_{10};
   int counter_; /**< once counter_==0 will do checksum */
   char accum_;  /**< sum of bytes */
+
+  /**
+   * Sum of all bytes modulo 256 (the on-disk checksum is a plain char sum, so the
+   * wide accumulation below is bit-exact with the byte-by-byte loop).
+   */
+  static char sum_bytes(const char* data, size_t n) {
+    size_t i = 0;
+    unsigned long long accum = 0;
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vsum = zero;
+    for (; i + 32 <= n; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      // per-64-bit-lane sums of absolute byte differences against 0 == byte sums
+      vsum = _mm256_add_epi64(vsum, _mm256_sad_epu8(v, zero));
+    }
+    alignas(32) unsigned long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vsum);
+    accum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) {
+      accum += static_cast<unsigned char>(data[i]);
+    }
+    return static_cast<char>(accum);
+  }
+
  public:
   CheckSum(Source& src) : Checker(src), counter_(0), accum_(0) {}
   /**
@@ -51,9 +81,7 @@ class CheckSum : public Checker {
         HCTR_OWN_THROW(Error_t::BrokenFile, os.str());
       } else {
         Checker::src_.read(ptr, bytes_to_read);
-        for (unsigned int i = 0; i < bytes_to_read; i++) {
-          accum_ += ptr[i];
-        }
+        accum_ += sum_bytes(ptr, bytes_to_read);
         // do checksum when counter_ == 0.
         if (counter_ == 0) {
           char check_sum = 0;
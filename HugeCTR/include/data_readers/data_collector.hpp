@@ -70,6 +70,8 @@ class DataCollector {
 
   std::atomic<bool> loop_flag_;
   std::vector<size_t> last_batch_nnz_;
+  bool zero_copy_sparse_; /**< sparse output tensors alias the broadcast buffers; the staging
+                             D2D copy in read_a_batch_to_device is skipped */
 
   std::shared_ptr<ResourceManager> resource_manager_;
 
@@ -111,7 +111,7 @@ class DataReader : public IDataReader {
                            const std::vector<long long> slot_offset,
                            bool start_reading_from_beginning = true,
                            long long max_samples_per_group = 0, int label_dense_num = 0,
-                           int label_dense_dim = 0) override;
+                           int label_dense_dim = 0, bool shard_files_across_ranks = false) override;
 #endif
   void set_source(std::string file_name = std::string()) override;
 };
@@ -18,6 +18,7 @@
 #include <numa.h>
 
 #include <atomic>
+#include <chrome_trace.hpp>
 #include <common.hpp>
 #include <condition_variable>
 #include <data_readers/data_container_interface.hpp>
@@ -48,7 +49,16 @@ static void producer_thread_func_(const std::shared_ptr<IDataReaderWorker>& data
     }
     // parquet reader will hangs over here until end_flag is set true
     // others will return right away
-    data_reader->do_h2d();
+    if (ChromeTraceRecorder::enabled()) {
+      // one long slice covering the producer's whole H2D loop
+      const uint64_t begin_us = ChromeTraceRecorder::now_us();
+      data_reader->do_h2d();
+      ChromeTraceRecorder::instance().record("do_h2d", "data_reader", device_id,
+                                             "reader_producer", begin_us,
+                                             ChromeTraceRecorder::now_us() - begin_us);
+    } else {
+      data_reader->do_h2d();
+    }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
   }
@@ -58,12 +68,22 @@ static void consumer_thread_func_(const std::shared_ptr<IDataReaderWorker>& data
                                   const std::shared_ptr<std::atomic<bool>>& p_loop_flag,
                                   int device_id, volatile bool* end_flag = nullptr) {
   try {
-    CudaDeviceContext context(device_id);
+    // bind the worker to the socket closest to its GPU; batches staged by this thread
+    // (pinned or pageable) then come out of node-local memory
+    CudaCPUDeviceContext context(device_id);
     while (!p_loop_flag->load() && !*end_flag) {
       usleep(2);
     }
     while (p_loop_flag->load() && !*end_flag) {
-      data_reader->read_a_batch();
+      if (ChromeTraceRecorder::enabled()) {
+        const uint64_t begin_us = ChromeTraceRecorder::now_us();
+        data_reader->read_a_batch();
+        ChromeTraceRecorder::instance().record("read_a_batch", "data_reader", device_id,
+                                               "reader_consumer", begin_us,
+                                               ChromeTraceRecorder::now_us() - begin_us);
+      } else {
+        data_reader->read_a_batch();
+      }
     }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
@@ -23,11 +23,19 @@ namespace HugeCTR {
 
 template <typename TypeKey>
 class DataReaderWorkerGroupParquet : public DataReaderWorkerGroup {
+  // File-list shard of this process. By default every process walks the whole
+  // list (shard 0 of 1); with rank sharding enabled, worker w of process r
+  // starts at file r * num_workers + w and strides by num_process * num_workers
+  // so the ranks together cover the list exactly once.
+  unsigned int file_shard_id_{0};
+  unsigned int file_shard_count_{1};
+
   std::shared_ptr<Source> create_source(size_t worker_id, size_t num_worker,
                                         const std::string& file_name, bool repeat,
                                         const DataSourceParams& data_source_params) override {
     return std::make_shared<ParquetFileSource>(
-        worker_id, num_worker, file_name, strict_order_of_batches_, repeat, data_source_params);
+        file_shard_id_ * num_worker + worker_id, file_shard_count_ * num_worker, file_name,
+        strict_order_of_batches_, repeat, data_source_params);
   }
 
  public:
@@ -38,7 +46,8 @@ class DataReaderWorkerGroupParquet : public DataReaderWorkerGroup {
                                const DataSourceParams data_source_params,
                                const std::shared_ptr<ResourceManager>& resource_manager_,
                                bool start_reading_from_beginning = true, int label_dense_num = 0,
-                               int label_dense_dim = 0, long long max_samples_per_group = 0)
+                               int label_dense_dim = 0, long long max_samples_per_group = 0,
+                               bool shard_files_across_ranks = false)
       : DataReaderWorkerGroup(start_reading_from_beginning, DataReaderType_t::Parquet,
                               strict_order_of_batches, std::make_shared<std::vector<size_t>>(),
                               output_buffers.size()) {
@@ -80,6 +89,17 @@ class DataReaderWorkerGroupParquet : public DataReaderWorkerGroup {
     HCTR_CHECK_HINT(num_slots == fixed_slot_dims.size() + variadic_slots_id.size(),
                     " cat columns (fixed + variable) mismatch\n");
     this->set_resource_manager(resource_manager_);
+    if (shard_files_across_ranks) {
+      if (strict_order_of_batches) {
+        // sequential consumption walks the list by a plain counter, so there is
+        // no per-worker stride the shard could be folded into
+        HCTR_LOG(WARNING, ROOT,
+                 "File-list sharding across ranks is ignored in sequential mode\n");
+      } else {
+        file_shard_id_ = static_cast<unsigned int>(resource_manager_->get_process_id());
+        file_shard_count_ = static_cast<unsigned int>(resource_manager_->get_num_process());
+      }
+    }
     auto local_device_list = resource_manager_->get_local_gpu_device_id_list();
     size_t dense_bytes_per_sample = sizeof(float) * label_dense_dim;
     // each buffer allocate 2 row_group + batchsize
@@ -119,7 +139,7 @@ class DataReaderWorkerGroupParquet : public DataReaderWorkerGroup {
           local_device_list[i], df_container_consumer[i], df_container_producer,
           df_container_producer_stats_, workers_has_read_, accomplished_workers_, resource_manager_,
           dense_width_dim_, this->go_next_epoch_.data() + i, this->epoch_mtx_[i],
-          this->epoch_cv_[i]));
+          this->epoch_cv_[i], file_shard_id_, file_shard_count_));
       data_readers_.push_back(data_reader);
     }
     this->create_data_reader_threads();
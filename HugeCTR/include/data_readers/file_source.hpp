@@ -16,15 +16,26 @@
 #pragma once
 
 #include <common.hpp>
+#include <condition_variable>
 #include <data_readers/file_list.hpp>
 #include <data_readers/source.hpp>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace HugeCTR {
 
 class FileSource : public Source {
  private:
+  struct PrefetchedFile {
+    unsigned int counter;  // value of counter_ this file belongs to
+    std::string name;
+    std::vector<char> data;
+    bool failed = false;
+  };
+
   FileList file_list_;           /**< file list of data set */
   std::ifstream in_file_stream_; /**< file stream of data set file */
   std::string file_name_;        /**< file name of current file */
@@ -33,15 +44,85 @@ class FileSource : public Source {
   bool repeat_;
   unsigned int counter_{0};
 
+  // Prefetch window: a background thread opens and reads the next files of this worker
+  // ahead of time so file transitions do not stall on open+first-read latency
+  // (milliseconds on networked file systems). 0 disables prefetching.
+  size_t prefetch_window_{0};
+  std::thread prefetch_thread_;
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cv_;
+  std::deque<PrefetchedFile> prefetched_;  // ring of at most prefetch_window_ entries
+  unsigned int prefetch_counter_{0};       // next counter value to prefetch
+  bool prefetch_stop_{false};
+  // current file when served from memory instead of in_file_stream_
+  std::vector<char> cur_buffer_;
+  size_t cur_pos_{0};
+  bool reading_from_buffer_{false};
+
+  void prefetch_loop() {
+    while (true) {
+      PrefetchedFile file;
+      {
+        std::unique_lock<std::mutex> lock(prefetch_mutex_);
+        prefetch_cv_.wait(
+            lock, [this] { return prefetch_stop_ || prefetched_.size() < prefetch_window_; });
+        if (prefetch_stop_) {
+          return;
+        }
+        file.counter = prefetch_counter_++;
+      }
+      file.name = file_list_.get_a_file_with_id(offset_ + file.counter * stride_, repeat_);
+      if (!file.name.empty()) {
+        std::ifstream stream(file.name, std::ifstream::binary | std::ifstream::ate);
+        if (stream.is_open()) {
+          file.data.resize(stream.tellg());
+          stream.seekg(0);
+          stream.read(file.data.data(), file.data.size());
+          file.failed = !stream.good();
+        } else {
+          file.failed = true;
+        }
+      }
+      bool end_of_list = file.name.empty();
+      {
+        std::unique_lock<std::mutex> lock(prefetch_mutex_);
+        prefetched_.push_back(std::move(file));
+      }
+      prefetch_cv_.notify_all();
+      if (end_of_list) {
+        return;  // end of the non-repeating list; nothing more to prefetch
+      }
+    }
+  }
+
  public:
   std::string get_current_file_name() { return file_name_; }
-  FileSource(long long offset, long long stride, const std::string& file_list, bool repeat)
+  FileSource(long long offset, long long stride, const std::string& file_list, bool repeat,
+             size_t prefetch_window = 0)
       : file_list_(file_list), offset_(offset), stride_(stride), repeat_(repeat) {
     file_name_ = "__empty.bin";
     HCTR_CHECK_HINT(
         file_list_.get_num_of_files() >= stride_,
         "The number of data reader workers should be no greater than the number of files in the "
         "file list. Please re-configure num_workers within DataReaderParams.");
+    prefetch_window_ = prefetch_window;
+    if (const char* env = std::getenv("HCTR_FILE_PREFETCH_WINDOW")) {
+      prefetch_window_ = std::atoi(env);
+    }
+    if (prefetch_window_ > 0) {
+      prefetch_thread_ = std::thread([this] { prefetch_loop(); });
+    }
+  }
+
+  ~FileSource() {
+    if (prefetch_thread_.joinable()) {
+      {
+        std::unique_lock<std::mutex> lock(prefetch_mutex_);
+        prefetch_stop_ = true;
+      }
+      prefetch_cv_.notify_all();
+      prefetch_thread_.join();
+    }
   }
 
   /**
@@ -52,6 +133,16 @@ class FileSource : public Source {
    */
   Error_t read(char* ptr, size_t bytes_to_read) noexcept {
     try {
+      if (reading_from_buffer_) {
+        if (cur_pos_ + bytes_to_read > cur_buffer_.size()) {
+          return Error_t::OutOfBound;
+        }
+        if (bytes_to_read > 0) {
+          memcpy(ptr, cur_buffer_.data() + cur_pos_, bytes_to_read);
+          cur_pos_ += bytes_to_read;
+        }
+        return Error_t::Success;
+      }
       if (!in_file_stream_.is_open()) {
         return Error_t::FileCannotOpen;
       }
@@ -69,7 +160,8 @@ class FileSource : public Source {
   }
 
   /**
-   * Start a new file to read.
+   * Start a new file to read. Served from the prefetch ring when the upcoming file has
+   * already been loaded by the background thread.
    * @return `Success`, `FileCannotOpen` or `UnspecificError`
    */
   Error_t next_source(long long expected_next_source_items) noexcept {
@@ -77,6 +169,35 @@ class FileSource : public Source {
       if (in_file_stream_.is_open()) {
         in_file_stream_.close();
       }
+      reading_from_buffer_ = false;
+
+      if (prefetch_window_ > 0) {
+        PrefetchedFile file;
+        {
+          std::unique_lock<std::mutex> lock(prefetch_mutex_);
+          prefetch_cv_.wait(lock, [this] {
+            return !prefetched_.empty() && prefetched_.front().counter == counter_;
+          });
+          file = std::move(prefetched_.front());
+          prefetched_.pop_front();
+        }
+        prefetch_cv_.notify_all();
+        counter_++;
+        file_name_ = file.name;
+        if (file.name.empty()) {
+          return Error_t::EndOfFile;
+        }
+        if (file.failed) {
+          HCTR_LOG_S(ERROR, WORLD) << "prefetch of file failed: " << file.name << ' '
+                                   << HCTR_LOCATION() << std::endl;
+          return Error_t::FileCannotOpen;
+        }
+        cur_buffer_ = std::move(file.data);
+        cur_pos_ = 0;
+        reading_from_buffer_ = true;
+        return Error_t::Success;
+      }
+
       std::string file_name = file_list_.get_a_file_with_id(offset_ + counter_ * stride_, repeat_);
       file_name_ = file_name;
       counter_++;  // counter_ should be accum for every source.
@@ -96,7 +217,7 @@ class FileSource : public Source {
     }
   }
 
-  bool is_open() noexcept { return in_file_stream_.is_open(); }
+  bool is_open() noexcept { return reading_from_buffer_ || in_file_stream_.is_open(); }
 };
 
 }  // namespace HugeCTR
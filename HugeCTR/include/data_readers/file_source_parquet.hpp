@@ -57,6 +57,8 @@ class ParquetFileSource : public Source {
 
   const bool repeat_;
   const bool sequential_file_consumption_;
+  bool use_gds_; /**< read row groups via cuFile/GDS directly into device memory, skipping the
+                    host bounce buffer; local file system only */
   /**
    * Private Helper function to get metadata file address
    */
@@ -106,7 +108,18 @@ class ParquetFileSource : public Source {
   // counter_ always points to next file name
   Error_t next_source(long long expected_num_row_group) noexcept;
   bool is_open() noexcept;
+  /**
+   * Restrict cudf decoding to the columns the model actually references:
+   * label/dense columns plus the first num_used_slots cat columns. The
+   * resolution is cached in the Metadata object and reused for every file.
+   */
+  void set_column_projection(size_t num_used_slots);
   cudf_io::table_with_metadata read_group(size_t row_group_id, rmm::mr::device_memory_resource* mr);
+  /**
+   * Advance the row-group cursors exactly as read_group() would, without decoding.
+   * Used when the decoded buffers are served from the row-group cache.
+   */
+  void skip_group(size_t row_group_id);
   /*
     jump to specific parquet file calculated through global_record_id;
     if dst == cur, dont need to load again
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <common.hpp>
+#include <condition_variable>
+#include <cstring>
+#include <data_readers/source.hpp>
+#include <deque>
+#include <hps/kafka_message.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Streaming Source that feeds the data reader worker group directly from a Kafka
+ * topic instead of files materialized on disk, for online/incremental training.
+ *
+ * Each Kafka message payload carries a micro-batch of records in the dataset's
+ * native binary layout; a micro-batch plays the role a file plays for FileSource:
+ * read() streams through the current micro-batch and returns `OutOfBound` at its
+ * end, and next_source() blocks until the next micro-batch has arrived. Received
+ * micro-batches are kept in a bounded in-memory ring; when the ring is full the
+ * consumer thread blocks before committing (backpressure), so unread data stays
+ * in the broker instead of growing our footprint.
+ */
+class KafkaSource : public Source {
+ private:
+  struct MicroBatch {
+    std::vector<char> data;
+    long long num_items;
+  };
+
+  std::unique_ptr<KafkaMessageSource<long long>> consumer_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<MicroBatch> micro_batches_;
+  size_t buffered_bytes_{0};
+  const size_t max_buffered_bytes_;
+  bool stop_{false};
+
+  // micro-batch currently being consumed
+  MicroBatch cur_batch_;
+  size_t cur_pos_{0};
+  bool batch_open_{false};
+
+  void on_message(size_t num_pairs, const char* values, size_t value_size) {
+    MicroBatch batch;
+    batch.num_items = num_pairs;
+    batch.data.assign(values, values + num_pairs * value_size);
+    std::unique_lock<std::mutex> lock(mutex_);
+    // block the consumer thread until the reader drains; the broker retains the lag
+    cv_.wait(lock, [this] { return stop_ || buffered_bytes_ < max_buffered_bytes_; });
+    if (stop_) {
+      return;
+    }
+    buffered_bytes_ += batch.data.size();
+    micro_batches_.push_back(std::move(batch));
+    cv_.notify_all();
+  }
+
+ public:
+  /**
+   * Subscribe to the given topic and start buffering micro-batches.
+   * @param brokers host-address of the Kafka brokers to use
+   * @param topic topic the training records are published to
+   * @param consumer_group_id consumer group; workers of one reader share a group so
+   *                          the topic's partitions are distributed among them
+   * @param max_buffered_bytes bound of the in-memory ring per worker
+   */
+  KafkaSource(const std::string& brokers, const std::string& topic,
+              const std::string& consumer_group_id,
+              size_t max_buffered_bytes = 256 * 1024 * 1024)
+      : max_buffered_bytes_(max_buffered_bytes) {
+    consumer_ = std::make_unique<KafkaMessageSource<long long>>(
+        brokers, consumer_group_id, std::vector<std::string>{"^" + topic + "$"});
+    consumer_->engage([this](const std::string& tag, const size_t num_pairs,
+                             const long long* keys, const char* values, const size_t value_size) {
+      on_message(num_pairs, values, value_size);
+    });
+  }
+
+  ~KafkaSource() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    consumer_.reset();  // joins the consumer thread; callback can no longer block
+  }
+
+  /**
+   * Read "bytes_to_read" byte to the memory associated to ptr.
+   * @param ptr pointer to user located buffer
+   * @param bytes_to_read bytes to read
+   * @return `OutOfBound` `Success` `UnspecificError`
+   */
+  Error_t read(char* ptr, size_t bytes_to_read) noexcept {
+    try {
+      if (!batch_open_) {
+        return Error_t::BrokenFile;
+      }
+      if (cur_pos_ + bytes_to_read > cur_batch_.data.size()) {
+        return Error_t::OutOfBound;
+      }
+      if (bytes_to_read > 0) {
+        memcpy(ptr, cur_batch_.data.data() + cur_pos_, bytes_to_read);
+        cur_pos_ += bytes_to_read;
+      }
+      return Error_t::Success;
+    } catch (const std::runtime_error& rt_err) {
+      HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      return Error_t::UnspecificError;
+    }
+  }
+
+  /**
+   * Start the next micro-batch; blocks until one has been received from the topic.
+   * @return `Success` or `UnspecificError`
+   */
+  Error_t next_source(long long expected_next_source_items) noexcept {
+    try {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !micro_batches_.empty(); });
+      if (stop_) {
+        return Error_t::EndOfFile;
+      }
+      cur_batch_ = std::move(micro_batches_.front());
+      micro_batches_.pop_front();
+      buffered_bytes_ -= cur_batch_.data.size();
+      cur_pos_ = 0;
+      batch_open_ = true;
+      lock.unlock();
+      cv_.notify_all();
+      return Error_t::Success;
+    } catch (const std::runtime_error& rt_err) {
+      HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+      return Error_t::UnspecificError;
+    }
+  }
+
+  long long get_num_of_items_in_source() override {
+    return batch_open_ ? cur_batch_.num_items : 0;
+  }
+
+  bool is_open() noexcept { return batch_open_; }
+};
+
+}  // namespace HugeCTR
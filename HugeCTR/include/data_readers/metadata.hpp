@@ -59,6 +59,12 @@ class Metadata {
   std::vector<long long> rows_file_offset_;
   // std::vector<long long> dense_dim_array_;  // read one sample and get it
   long long max_row_group_;
+  // column projection: model-referenced columns in decoded-table order, plus the
+  // raw-parquet-index -> projected-position remap. Resolved once and reused for
+  // every file of the list (all files share the schema recorded in _metadata.json)
+  std::vector<std::string> projected_col_names_;
+  std::unordered_map<int, int> projected_col_index_;
+  size_t projected_num_slots_;
 
  public:
   // ctor
@@ -70,12 +76,38 @@ class Metadata {
         loaded_(false),
         num_rows_total_files_(0),
         rows_file_offset_(),
-        max_row_group_(0){};
+        max_row_group_(0),
+        projected_col_names_(),
+        projected_col_index_(),
+        projected_num_slots_(0){};
 
   // initialize everything
   void get_parquet_metadata(std::string file_name);
   void reset_metadata(std::string file_name);
 
+  /**
+   * Resolve the column projection for a model that consumes num_used_slots
+   * categorical slots: all label and dense columns plus the first
+   * num_used_slots cat columns (in parquet-index order). cudf then only
+   * decodes the projected columns, so the raw parquet indices from
+   * _metadata.json have to be remapped through get_projected_index() before
+   * indexing the decoded table.
+   */
+  void resolve_column_projection(size_t num_used_slots);
+  bool has_column_projection() const { return !projected_col_names_.empty(); }
+  const std::vector<std::string>& get_projected_column_names() const {
+    return projected_col_names_;
+  }
+  // position of a raw parquet column index within the projected (decoded)
+  // table; -1 for a pruned column (cat slots beyond what the model consumes)
+  int get_projected_index(int raw_index) const {
+    if (projected_col_index_.empty()) {
+      return raw_index;
+    }
+    auto it = projected_col_index_.find(raw_index);
+    return it == projected_col_index_.end() ? -1 : it->second;
+  }
+
   std::vector<Cols> get_cat_names() { return this->cat_names_; }
   std::vector<Cols> get_cont_names() { return this->cont_names_; }
   std::vector<Cols> get_label_names() { return this->label_names_; }
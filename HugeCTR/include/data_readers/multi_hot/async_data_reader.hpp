@@ -57,6 +57,15 @@ class AsyncDataReader : public SchedulableDataReader {
    */
   void set_tensor_buffering(size_t num_batches_to_buffer);
 
+  /**
+   * @brief Declare which sparse features are consumed downstream (reader bucket ids, i.e.
+   * the dr_lookup_ids of an embedding collection). May be called once per consumer before
+   * start(); the union is kept. When some features stay unreferenced, start() installs a
+   * filtered upload that stages only the surviving sample columns host-side and skips the
+   * rest of the H2D transfer. Labels and dense features always survive.
+   */
+  void set_required_sparse_features(const std::vector<int>& feature_ids);
+
   bool current_batch_incomplete() const override;
   void ready_to_collect() override;
   long long read_a_batch_to_device() override;
@@ -96,7 +105,7 @@ class AsyncDataReader : public SchedulableDataReader {
                            const std::vector<long long> slot_offset,
                            bool start_reading_from_beginning = true,
                            long long max_samples_per_group = 0, int label_dense_num = 0,
-                           int label_dense_dim = 0) override;
+                           int label_dense_dim = 0, bool shard_files_across_ranks = false) override;
 #endif
   void set_source(std::string file_list = std::string()) override;
 
@@ -117,6 +126,8 @@ class AsyncDataReader : public SchedulableDataReader {
 
   void init_batch_tensors(size_t num_inflight);
 
+  void install_upload_filter_();
+
   const std::shared_ptr<ResourceManager> resource_manager_;
   std::unique_ptr<DataReaderImpl> reader_impl_;
   size_t sample_size_items_, current_batch_size_;  // current global batch size
@@ -125,6 +136,9 @@ class AsyncDataReader : public SchedulableDataReader {
   size_t label_dim_, dense_dim_, sparse_dim_;
   std::vector<int> nnz_per_slot_;
   size_t total_nnz_;
+  // union of the sparse features declared via set_required_sparse_features(); empty means
+  // no consumer registered and the whole batch is uploaded
+  std::vector<bool> required_sparse_features_;
 
   size_t inflight_id_ = 0;
   std::vector<BatchTensors> inflight_batch_tensors_;  // in-flight batches
@@ -151,6 +165,11 @@ class AsyncDataReader : public SchedulableDataReader {
   std::vector<core23::Tensor> bucket_id_tensors_;
   std::vector<core23::Tensor> bucket_position_tensors_;
   std::vector<core23::Tensor> max_hotness_tensors_;
+  // sample-level shuffle: per-GPU permutation applied by split_3_way so sorted datasets
+  // are emitted in random sample order (in addition to the batch-order shuffle)
+  bool shuffle_samples_ = false;
+  std::vector<core23::Tensor> sample_perm_tensors_;    // device
+  std::vector<core23::Tensor> h_sample_perm_tensors_;  // pinned host staging
   bool is_dense_float_;
   std::vector<core23::Tensor> temp_tensors_;
 };
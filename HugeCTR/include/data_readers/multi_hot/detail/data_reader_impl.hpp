@@ -141,6 +141,15 @@ class DataReaderImpl {
 
   void upload_notify(int device_id);
 
+  /**
+   * Restrict uploads to the given per-sample byte ranges (ascending, non-overlapping).
+   * Must be called before start(). Shards whose size is not a multiple of
+   * raw_sample_size_bytes keep the unfiltered path; the skipped device regions retain
+   * their zero-initialized contents. A range set covering the whole sample is a no-op.
+   */
+  void set_sample_filter(const std::vector<std::pair<size_t, size_t>>& keep_ranges,
+                         size_t raw_sample_size_bytes, size_t max_samples_per_shard);
+
   size_t get_total_inflight_batches() const;
 
  private:
@@ -175,6 +184,11 @@ class DataReaderImpl {
   std::unordered_map<int, std::vector<std::unique_ptr<BatchFileReader>>> file_readers_;
   std::vector<std::thread> file_reader_threads_;
 
+  // one filter per local GPU when filtered uploads are enabled; the staging buffers are
+  // safe to reuse across batches because each upload thread synchronizes its stream
+  // before moving to the next batch
+  std::vector<UploadSampleFilter> sample_filters_;
+
   std::vector<std::thread> placement_threads_;
   std::vector<AtomicWrapper<size_t>> pending_transfers_;
   std::vector<cudaStream_t> placement_streams_;
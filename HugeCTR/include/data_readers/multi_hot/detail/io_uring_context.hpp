@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#ifdef ENABLE_IO_URING
+
+#include <liburing.h>
+
+#include <data_readers/multi_hot/detail/io_context.hpp>
+
+namespace HugeCTR {
+
+// io_uring backed IOContext. Compared to AIOContext, submissions are batched through a
+// shared ring so each reader thread can keep many reads in-flight without one syscall
+// per request; completions are reaped from the completion queue without entering the kernel
+// at all when events are already available.
+class IOUringContext : public IOContext {
+ public:
+  IOUringContext(size_t io_depth);
+  ~IOUringContext();
+
+  void submit(const IORequest& request);
+  const std::vector<IOEvent>& collect(size_t min_reqs, size_t timeout_us);
+  size_t get_alignment() const;
+
+ private:
+  static IOError errno_to_enum(int err);
+
+  size_t io_depth_ = 0;
+  size_t num_inflight_ = 0;
+  size_t num_unsubmitted_ = 0;  // prepared SQEs not yet pushed to the kernel
+  io_uring ring_;
+  std::vector<IOEvent> tmp_events_;  // prevent dynamic memory allocation
+};
+
+}  // namespace HugeCTR
+
+#endif  // ENABLE_IO_URING
@@ -111,6 +111,9 @@ class ParquetDataReaderWorker : public IDataReaderWorker,
       }
     }
     this->source_ = source;
+    // the replacement source carries a fresh Metadata object, so the column
+    // projection has to be re-resolved for it
+    parquet_file_source()->set_column_projection(slots_);
     auto& consumer = row_group_reader_->get_df_container_consumer();
     auto& producer = row_group_reader_->get_df_container_producer(worker_id_);
 
@@ -147,7 +150,8 @@ class ParquetDataReaderWorker : public IDataReaderWorker,
       std::vector<std::shared_ptr<std::atomic<int>>>& accomplished_workers,
       const std::shared_ptr<ResourceManager>& resource_manager,
       std::shared_ptr<std::vector<size_t>> dense_width_dim_, char* go_next_epoch_,
-      std::mutex& epoch_mtx_, std::condition_variable& epoch_cv_);
+      std::mutex& epoch_mtx_, std::condition_variable& epoch_cv_,
+      unsigned int file_shard_id = 0, unsigned int file_shard_count = 1);
 
   ~ParquetDataReaderWorker();
   /**
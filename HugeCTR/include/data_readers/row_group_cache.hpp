@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <data_readers/dataframe_container.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * @brief Pinned-host cache of decoded Parquet row groups for epoch-mode training.
+ *
+ * The first time a row group is decoded, the post-decode columnar buffers of the
+ * producer DFContainer are copied into pinned host memory, keyed by file + row group.
+ * On subsequent epochs the cached buffers are copied straight back to the device and
+ * the cudf decode is skipped entirely. Enabled via HCTR_ROW_GROUP_CACHE; each
+ * RowGroupReadingThread owns its own cache since row groups are statically
+ * partitioned across workers.
+ */
+template <typename T>
+class RowGroupCache {
+  struct Entry {
+    char* pinned_data = nullptr;  // one pinned blob: dense columns, sparse columns, offsets
+    size_t pinned_bytes = 0;
+    std::vector<size_t> dense_offsets;   // byte offset of each dense column in pinned_data
+    std::vector<size_t> sparse_offsets;  // byte offset of each sparse column in pinned_data
+    std::vector<size_t> sparse_row_offsets;  // byte offset of each CSR offset column; SIZE_MAX
+                                             // for one-hot columns without offsets
+    std::vector<size_t> dense_size_;
+    std::vector<size_t> dense_size_bytes_;
+    std::vector<size_t> sparse_size_;
+    std::vector<size_t> sparse_size_bytes_;
+    size_t num_rows = 0;
+    std::vector<size_t> dense_dim_array;
+    std::vector<int> one_hot_slot_id;
+    std::vector<int> sparse_nnz_array;
+  };
+
+ public:
+  RowGroupCache(int device_id, size_t max_bytes);
+  ~RowGroupCache();
+
+  static std::string make_key(const std::string& file_name, long long row_group_id) {
+    return file_name + "#" + std::to_string(row_group_id);
+  }
+
+  /**
+   * Copy a cached row group back into dst and restore the decode-time metadata.
+   * @return false on cache miss
+   */
+  bool lookup(const std::string& key, std::shared_ptr<DFContainer<T>>& dst,
+              std::vector<size_t>& dense_dim_array, std::vector<int>& one_hot_slot_id,
+              std::vector<int>& sparse_nnz_array);
+
+  /**
+   * Snapshot the freshly decoded buffers of src into pinned host memory.
+   * No-op if the cache byte budget would be exceeded or the key already exists.
+   */
+  void insert(const std::string& key, const std::shared_ptr<DFContainer<T>>& src,
+              const std::vector<size_t>& dense_dim_array, const std::vector<int>& one_hot_slot_id,
+              const std::vector<int>& sparse_nnz_array);
+
+ private:
+  int device_id_;
+  size_t max_bytes_;
+  size_t used_bytes_ = 0;
+  bool budget_warned_ = false;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace HugeCTR
@@ -17,6 +17,7 @@
 #include <condition_variable>
 #include <data_readers/dataframe_container.hpp>
 #include <data_readers/file_source_parquet.hpp>
+#include <data_readers/row_group_cache.hpp>
 #include <resource_managers/resource_manager_core.hpp>
 #include <rmm/mr/device/cuda_memory_resource.hpp>
 #include <rmm/mr/device/device_memory_resource.hpp>
@@ -46,6 +47,8 @@ class RowGroupReadingThread {
   long long local_row_group_id_;  // reset for new file
 
   std::unique_ptr<cudf::table> cached_df_;
+  // decoded row-group reuse across epochs; null unless HCTR_ROW_GROUP_CACHE is set
+  std::unique_ptr<RowGroupCache<T>> row_group_cache_;
 
   std::map<int, int>& dense_idx_to_parquet_col_;
   std::map<int, int>& categorical_idx_parquet_col_;
@@ -20,6 +20,7 @@
 #include <embedding_training_cache/parameter_server_manager.hpp>
 #include <embeddings/distributed_slot_sparse_embedding_hash.hpp>
 #include <embeddings/localized_slot_sparse_embedding_hash.hpp>
+#include <future>
 #include <iterator>
 
 namespace HugeCTR {
@@ -29,6 +30,8 @@ class EmbeddingTrainingCacheImplBase {
   virtual void dump() = 0;
   virtual void update(std::vector<std::string>&) = 0;
   virtual void update(std::string&) = 0;
+  virtual void prefetch(std::vector<std::string>&) = 0;
+  virtual void prefetch(std::string&) = 0;
   virtual void update_sparse_model_file() = 0;
   virtual std::vector<std::pair<std::vector<long long>, std::vector<float>>> get_incremental_model(
       const std::vector<long long>&) = 0;
@@ -56,6 +59,22 @@ class EmbeddingTrainingCacheImpl : public EmbeddingTrainingCacheImplBase {
    */
   void load_(std::vector<std::string>& keyset_file_list);
 
+  /**
+   * @brief Background loader behind prefetch: parses the given keyset files,
+   *        diffs them against the keysets of the pass currently in device
+   *        memory, and stages the blocks of the missing keys through
+   *        HMemCache::prefetch.
+   */
+  void prefetch_(std::vector<std::string>& keyset_file_list);
+
+  // Keyset files of the pass being speculatively staged and the completion
+  // handle of the background loader. update() consumes the staged pass when
+  // the requested files match the outstanding prefetch; otherwise it waits
+  // the loader out and falls back to the on-demand load.
+  std::vector<std::string> prefetch_keyset_files_;
+  std::vector<std::vector<TypeKey>> keysets_in_device_;
+  std::future<void> prefetch_done_;
+
  public:
   EmbeddingTrainingCacheImpl(std::vector<TrainPSType_t>& ps_types,
                              std::vector<std::shared_ptr<IEmbedding>>& embeddings,
@@ -89,6 +108,21 @@ class EmbeddingTrainingCacheImpl : public EmbeddingTrainingCacheImplBase {
    */
   void update(std::string& keyset_file) override;
 
+  /**
+   * @brief Speculatively stage the next pass's keyset while the current pass
+   *        is still training. Keysets of consecutive passes produced from
+   *        time-ordered data share most of their keys, so only the diff
+   *        against the currently loaded keyset is read through HMemCache,
+   *        making the following update() nearly free.
+   * @param keyset_file_list The keyset files of the upcoming pass.
+   */
+  void prefetch(std::vector<std::string>& keyset_file_list) override;
+
+  /**
+   * @brief Same as above, with a single keyset file for all embeddings.
+   */
+  void prefetch(std::string& keyset_file) override;
+
   std::vector<std::pair<std::vector<long long>, std::vector<float>>> get_incremental_model(
       const std::vector<long long>& keys_to_load) override;
 
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <embedding_training_cache/hmem_cache/sparse_model_file_ts.hpp>
+#include <future>
+#include <thread_pool.hpp>
 
 namespace HugeCTR {
 
@@ -24,6 +26,12 @@ struct HMemCacheConfig {
   double target_hit_rate;
   size_t max_num_evict;
   size_t block_capacity;
+  // Number of worker threads used to parallelize the per-block gather/scatter and the
+  // SSD load/dump batches; 0 falls back to the serial path.
+  size_t num_io_threads{16};
+  // Read ahead the blocks of the next pass's keyset from SparseModelFileTS while the
+  // current pass is still training (see HMemCache::prefetch).
+  bool enable_prefetch{true};
 
   HMemCacheConfig() {}
   HMemCacheConfig(size_t _num_cached_pass, double _target_hit_rate, size_t _max_num_evict)
@@ -58,6 +66,15 @@ class HMemCache {
 
   std::shared_ptr<SparseModelFileTS<TypeKey>> sparse_model_file_ptr_;
 
+  // Workers for block-parallel gather/scatter and for the background read-ahead.
+  ThreadPool io_thread_pool_;
+
+  // Staged blocks of the upcoming pass, produced by prefetch and consumed by the next read.
+  std::vector<TypeKey> prefetch_keys_;
+  std::vector<size_t> prefetch_slot_ids_;
+  std::vector<std::vector<float>> prefetch_datas_;
+  std::future<void> prefetch_done_;
+
   size_t find_(TypeKey key);
   std::pair<int, size_t> cascade_find_(TypeKey key);
 
@@ -74,6 +91,18 @@ class HMemCache {
 
   void sync_to_ssd();
 
+  /**
+   * @brief Load the SSD-resident blocks of the next pass's keyset into the staging buffers
+   *        on the I/O thread pool, overlapping the read with the current pass's training.
+   *        The following read consumes the staged blocks instead of going to SSD.
+   * @param key_ptr The keyset of the next pass.
+   * @param len Number of keys in the keyset.
+   */
+  void prefetch(TypeKey const *key_ptr, size_t len);
+
+  /** @brief Block until an outstanding prefetch has finished staging its blocks. */
+  void await_prefetch();
+
   auto get_sparse_model_file() { return sparse_model_file_ptr_; }
 };
 
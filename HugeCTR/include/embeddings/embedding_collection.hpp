@@ -21,10 +21,14 @@
 #include <embedding/embedding.hpp>
 #include <embedding/gpu_barrier/gpu_barrier.hpp>
 #include <embedding/operators/transpose_input.hpp>
+#include <embedding/operators/wgrad_accumulator.hpp>
 #include <embedding_storage/embedding_table.hpp>
 #include <embedding_storage/ragged_static_embedding.hpp>
+#include <graph_wrapper.hpp>
 #include <include/exchange_wgrad.hpp>
 #include <include/network_buffer_channels.hpp>
+#include <functional>
+#include <map>
 #include <optimizer.hpp>
 #include <tensor2.hpp>
 
@@ -39,7 +43,8 @@ class EmbeddingTableConfig {
 
   EmbeddingTableConfig(const std::string &name, int64_t max_vocabulary_size, int ev_size,
                        std::optional<HugeCTR::OptParams> opt_param_or_empty,
-                       std::optional<::embedding::InitParams> init_param_or_empty)
+                       std::optional<::embedding::InitParams> init_param_or_empty,
+                       bool half_precision_storage = false)
       : name(name) {
     HugeCTR::OptParams opt_param;
     if (opt_param_or_empty.has_value()) {
@@ -55,6 +60,7 @@ class EmbeddingTableConfig {
 
     this->table_param =
         ::embedding::EmbeddingTableParam{-1, max_vocabulary_size, ev_size, opt_param, init_param};
+    this->table_param.half_precision_storage = half_precision_storage;
   }
 };
 
@@ -330,6 +336,14 @@ inline ::embedding::CompressionParam create_compression_param_from_ebc_config(
 
 namespace embedding {
 
+// rolling per-(group, stage) GPU timing aggregated by the built-in profiler
+struct StageProfileStat {
+  uint64_t count = 0;
+  double total_ms = 0.0;
+  double ewma_ms = 0.0;
+  float last_ms = 0.f;
+};
+
 class EmbeddingCollection {
  private:
   std::shared_ptr<HugeCTR::ResourceManager> resource_manager_;
@@ -340,6 +354,32 @@ class EmbeddingCollection {
   std::vector<std::vector<Wgrad>> wgrad_list_;
   std::unique_ptr<HugeCTR::GPUBarrier> gpu_barrier_;
 
+  // opt-in (HCTR_EBC_CUDA_GRAPH=1) CUDA-graph capture of the whole forward/backward
+  // stage sweep to hide the launch overhead of the many small operator kernels.
+  // Graphs are keyed by batch size, so a different batch shape (e.g. the incomplete
+  // last batch) captures its own graph instead of re-instantiating the cached one.
+  bool use_cuda_graph_ = false;
+  std::vector<std::map<std::pair<bool, int>, HugeCTR::GraphWrapper>> forward_graphs_;
+  std::vector<std::map<int, HugeCTR::GraphWrapper>> backward_graphs_;
+
+  // opt-in (HCTR_EBC_GRAD_ACCUM_STEPS=N) micro-batch gradient accumulation:
+  // update_per_gpu folds the wgrad into a deduplicated accumulator and the
+  // optimizer fires once every N micro-batches. Groups with dynamically
+  // allocated wgrad keep per-step updates (their accumulator stays null).
+  int grad_accum_steps_ = 1;
+  std::vector<std::vector<int>> grad_accum_counters_;
+  std::vector<std::vector<std::unique_ptr<WgradAccumulator>>> wgrad_accumulators_;
+
+  // opt-in (HCTR_EBC_PROFILE=1) per-group, per-stage GPU timing with CUDA
+  // events pooled in GPUResource. Each profiled stage syncs on its stop event,
+  // so enable only when diagnosing a regression. Mutually exclusive with
+  // HCTR_EBC_CUDA_GRAPH: events cannot be harvested during graph capture.
+  bool use_profiler_ = false;
+  std::vector<std::map<std::string, StageProfileStat>> profile_stats_;
+
+  void profile_stage_timing(int gpu_id, size_t grouped_id, Stage stage, const char *direction,
+                            const std::function<void()> &stage_fn);
+
   void init_embedding_output_attrs(std::vector<std::shared_ptr<CoreResourceManager>> core);
 
   void init_wgrad(std::vector<std::shared_ptr<CoreResourceManager>> core,
@@ -391,6 +431,15 @@ class EmbeddingCollection {
 
   void set_learning_rate(float lr);
 
+  /**
+   * Switch the layout the forward pass writes (and the backward pass reads)
+   * the embedding output buffer in. The per-lookup ev-start-index metadata in
+   * EmbeddingOutputAttr is layout-invariant, so flipping the layout only
+   * changes kernel addressing; it must still happen before the first
+   * iteration, while no output produced under the old layout is in flight.
+   */
+  void set_output_layout(EmbeddingLayout layout);
+
   std::vector<std::vector<IGroupedEmbeddingTable *>> get_grouped_embedding_tables() {
     std::vector<std::vector<IGroupedEmbeddingTable *>> grouped_embedding_tables;
     grouped_embedding_tables.resize(embedding_tables_.size());
@@ -403,6 +452,12 @@ class EmbeddingCollection {
   }
 
   const std::vector<Wgrad> &get_wgrad(int gpu_id) const { return wgrad_list_[gpu_id]; }
+
+  /**
+   * Rolling per-group, per-stage GPU timing report. Empty string unless the
+   * profiler is enabled via HCTR_EBC_PROFILE=1.
+   */
+  std::string profile_report() const;
 };
 
 }  // namespace embedding
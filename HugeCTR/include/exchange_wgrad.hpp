@@ -16,6 +16,8 @@
 #pragma once
 
 #include <collectives/collective.hpp>
+#include <collectives/loss_scale_guard.hpp>
+#include <collectives/wgrad_compressor.hpp>
 #include <general_buffer2.hpp>
 #include <resource_manager.hpp>
 
@@ -33,6 +35,20 @@ class ExchangeWgrad {
   virtual void init_ar_comm(const std::vector<void*>& ptr, size_t sizes) = 0;
   virtual void update_embed_wgrad_size(size_t size) = 0;
   virtual void allreduce(size_t device_id, cudaStream_t stream) = 0;
+  // Gradient bucketing (HCTR_WGRAD_AR_BUCKETS=1): the fused wgrad buffer is split at a
+  // byte offset into a bottom bucket [0, offset) and a top bucket [offset, size), so the
+  // top-MLP bucket can start its allreduce while the bottom MLP is still in backward.
+  // The split must be set before init_ar_comm; allreduce still reduces both buckets.
+  virtual void set_bucket_split(size_t offset_in_bytes) = 0;
+  virtual bool bucketed() const = 0;
+  virtual void allreduce_bucket(size_t device_id, size_t bucket, cudaStream_t stream) = 0;
+  // Dynamic loss scaling (HCTR_DYNAMIC_LOSS_SCALE): device pointers of one local GPU
+  // to the current loss scale (read by the losses), the scale that produced the
+  // pending gradients (read by the optimizer to unscale) and the skip-step flag.
+  // All three are nullptr when dynamic scaling is disabled.
+  virtual float* dynamic_loss_scale_ptr(size_t device_id) const = 0;
+  virtual const float* dynamic_unscale_ptr(size_t device_id) const = 0;
+  virtual const int* skip_step_ptr(size_t device_id) const = 0;
 };
 
 template <typename TypeFP>
@@ -44,6 +60,12 @@ class NetworkExchangeWgrad : public ExchangeWgrad {
   void init_ar_comm(const std::vector<void*>& ptr, size_t size) final;
   void update_embed_wgrad_size(size_t size) final;
   void allreduce(size_t device_id, cudaStream_t stream);
+  void set_bucket_split(size_t offset_in_bytes) final;
+  bool bucketed() const final;
+  void allreduce_bucket(size_t device_id, size_t bucket, cudaStream_t stream) final;
+  float* dynamic_loss_scale_ptr(size_t device_id) const final;
+  const float* dynamic_unscale_ptr(size_t device_id) const final;
+  const int* skip_step_ptr(size_t device_id) const final;
   NetworkExchangeWgrad(const std::shared_ptr<ResourceManager>& resource_manager,
                        const std::shared_ptr<CollectiveManager>& collective_manager);
   ~NetworkExchangeWgrad() = default;
@@ -55,9 +77,14 @@ class NetworkExchangeWgrad : public ExchangeWgrad {
   std::shared_ptr<CollectiveManager> collective_manager_;
 
   AllReduceInPlaceComm::Handle ar_handle_;
+  AllReduceInPlaceComm::Handle ar_handle_top_;
+  std::unique_ptr<WgradCompressor<TypeFP>> compressor_;
+  std::unique_ptr<LossScaleGuard<TypeFP>> loss_scale_guard_;
 
   size_t network_wgrad_size_ = 0;
   size_t num_gpus_ = 0;
+  size_t bucket_split_ = 0;
+  bool bucketing_requested_ = false;
 };
 
 template <typename TypeFP>
@@ -69,6 +96,12 @@ class GroupedExchangeWgrad : public ExchangeWgrad {
   void init_ar_comm(const std::vector<void*>& ptr, size_t size) final;
   void update_embed_wgrad_size(size_t size) final;
   void allreduce(size_t device_id, cudaStream_t stream);
+  void set_bucket_split(size_t offset_in_bytes) final;
+  bool bucketed() const final;
+  void allreduce_bucket(size_t device_id, size_t bucket, cudaStream_t stream) final;
+  float* dynamic_loss_scale_ptr(size_t device_id) const final;
+  const float* dynamic_unscale_ptr(size_t device_id) const final;
+  const int* skip_step_ptr(size_t device_id) const final;
   GroupedExchangeWgrad(const std::shared_ptr<ResourceManager>& resource_manager,
                        const std::shared_ptr<CollectiveManager>& collective_manager);
   ~GroupedExchangeWgrad() = default;
@@ -81,9 +114,14 @@ class GroupedExchangeWgrad : public ExchangeWgrad {
   std::shared_ptr<CollectiveManager> collective_manager_;
 
   AllReduceInPlaceComm::Handle ar_handle_;
+  AllReduceInPlaceComm::Handle ar_handle_top_;
+  std::unique_ptr<WgradCompressor<TypeFP>> compressor_;
+  std::unique_ptr<LossScaleGuard<TypeFP>> loss_scale_guard_;
 
   size_t network_wgrad_size_ = 0;
   size_t embed_wgrad_size_ = 0;
   size_t num_gpus_ = 0;
+  size_t bucket_split_ = 0;
+  bool bucketing_requested_ = false;
 };
 }  // namespace HugeCTR
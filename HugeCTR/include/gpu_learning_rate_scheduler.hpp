@@ -32,6 +32,16 @@ class GpuLearningRateScheduler {
   size_t* step_;
   float* current_lr_;
   float* last_lr_;
+  // Other per-iteration schedule scalars live next to the learning rate so the whole
+  // schedule state is refreshed by the same single-thread kernel: host-side scalar
+  // updates between iterations would otherwise break whole-step CUDA-graph capture.
+  float wd_start_{0.f};
+  float wd_end_{0.f};
+  size_t wd_ramp_start_{0};
+  size_t wd_ramp_steps_{0};
+  float loss_scale_{1.f};
+  float* current_wd_;
+  float* current_scale_;
   std::shared_ptr<GPUResource> gpu_resource_;
 
  public:
@@ -40,9 +50,19 @@ class GpuLearningRateScheduler {
                            const std::shared_ptr<GPUResource>& gpu_resource);
   ~GpuLearningRateScheduler();
 
+  // Linearly ramp the decoupled weight decay from wd_start to wd_end over ramp_steps
+  // iterations, starting at ramp_start. Must be configured before the first update().
+  void set_weight_decay_ramp(float wd_start, float wd_end, size_t ramp_start, size_t ramp_steps);
+
+  // Constant mixed-precision loss scale, kept device-resident so consumers can read it
+  // through a pointer inside a captured graph instead of a per-iteration host constant.
+  void set_loss_scale(float loss_scale);
+
   void update();
 
   float* get_learning_rate() const;
+  float* get_weight_decay() const;
+  float* get_loss_scale() const;
 };
 
 using GpuLearningRateSchedulers = std::vector<std::shared_ptr<GpuLearningRateScheduler>>;
@@ -49,6 +49,8 @@ class GPUResource {
   int max_thread_per_sm_;
   int cc_major_;
   int cc_minor_;
+  int least_stream_priority_;
+  int greatest_stream_priority_;
   cudaStream_t computation_stream_2_;
 
   cudaEvent_t wait_wgrad_event_;
@@ -64,6 +66,14 @@ class GPUResource {
   ~GPUResource();
 
   const cudaStream_t& get_stream(const std::string& name, int priority = 0);
+  // Named prioritized stream pools. CUDA clamps priorities to a device-specific range,
+  // so callers state intent instead of hard-coding priority values: "high" streams
+  // (inter-GPU exchange, barriers, batch placement) are created at the device's
+  // greatest priority and preempt default-priority compute; "low" streams
+  // (prefetch, eval-time side work) at its least priority. The pools use separate
+  // key namespaces, so the same name can exist in both.
+  const cudaStream_t& get_high_priority_stream(const std::string& name);
+  const cudaStream_t& get_low_priority_stream(const std::string& name);
   const cudaEvent_t& get_event(const std::string& name);
 
   int get_device_id() const { return device_id_; }
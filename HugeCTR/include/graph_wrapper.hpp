@@ -17,7 +17,9 @@
 
 #include <cuda_runtime.h>
 
+#include <cstddef>
 #include <functional>
+#include <map>
 
 namespace HugeCTR {
 
@@ -26,8 +28,23 @@ struct GraphWrapper {
   cudaGraph_t graph;
   cudaGraphExec_t graph_exec;
 
+  // one captured graph per key (e.g. per batch size), alongside the unkeyed
+  // single-graph API above
+  std::map<size_t, std::pair<cudaGraph_t, cudaGraphExec_t>> keyed_graphs;
+
+  // Round batch_size up to the next power of two. Callers that pad their inputs can
+  // use this to fold arbitrary request sizes onto a small set of capture keys.
+  static size_t bucket_batch_size(size_t batch_size);
+
   void capture(std::function<void(cudaStream_t)> workload, cudaStream_t stream);
   void exec(cudaStream_t stream);
+
+  // Keyed variants: capture once per key and replay the graph belonging to that key,
+  // so workloads whose launch parameters depend on the key (batch size) each get a
+  // faithful pre-captured graph instead of falling back to a non-graph path.
+  bool captured(size_t key) const;
+  void capture(size_t key, std::function<void(cudaStream_t)> workload, cudaStream_t stream);
+  void exec(size_t key, cudaStream_t stream);
 };
 
 }  // namespace HugeCTR
\ No newline at end of file
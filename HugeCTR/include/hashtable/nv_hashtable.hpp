@@ -172,6 +172,47 @@ class HashTable {
    */
   void clear(cudaStream_t stream);
 
+  /**
+   * The bulk_build function for hash table. "bulk_build" means constructing the whole
+   * table at once from arrays of unique <key,value> pairs, such as the ones produced
+   * by dump(). The pairs are sorted by their home bucket and scattered straight into
+   * the final linear-probing layout, so no per-key CAS retries are needed. The hash
+   * table must be empty, and the keys must be unique; use insert() for incremental
+   * or possibly-duplicated insertions.
+   * @param d_keys the device pointers for the unique keys.
+   * @param d_vals the device pointers for the values.
+   * @param len the number of <key,value> pairs to build the hash table from.
+   * @param stream the cuda stream for this operation.
+   */
+  void bulk_build(const KeyType* d_keys, const ValType* d_vals, size_t len, cudaStream_t stream);
+
+  /**
+   * Get the number of bytes of the raw bucket image of the hash table. This is the
+   * buffer size which dump_image() fills and restore_image() consumes.
+   */
+  size_t image_size_in_bytes() const;
+
+  /**
+   * The dump_image function for hash table. "dump_image" means copying the raw bucket
+   * array (including the empty buckets) to the given device buffer, so that the table
+   * can later be restored by restore_image() without any rebuild.
+   * @param d_image the device pointer for the image buffer of image_size_in_bytes() bytes.
+   * @param stream the cuda stream for this operation.
+   */
+  void dump_image(void* d_image, cudaStream_t stream) const;
+
+  /**
+   * The restore_image function for hash table. "restore_image" means overwriting the
+   * raw bucket array with an image dumped from a hash table of the same capacity and
+   * key/value types, which skips the rebuild entirely. The value head is not part of
+   * the image and must be restored by the caller via set_value_head().
+   * @param d_image the device pointer for the image buffer.
+   * @param image_size_in_bytes the size of the image buffer in bytes. It must be equal
+   * to image_size_in_bytes() of this hash table.
+   * @param stream the cuda stream for this operation.
+   */
+  void restore_image(const void* d_image, size_t image_size_in_bytes, cudaStream_t stream);
+
  private:
   static const int BLOCK_SIZE_ =
       256; /**< The block size of the CUDA kernels. The default value is 256. */
@@ -17,6 +17,7 @@
 
 #include <cuda_runtime_api.h>
 
+#include <atomic>
 #include <hps/embedding_cache_base.hpp>
 #include <hps/embedding_cache_gpu.hpp>
 #include <hps/inference_utils.hpp>
@@ -71,6 +72,12 @@ class EmbeddingCache : public EmbeddingCacheBase,
   virtual const std::vector<cudaStream_t>& get_insert_streams() { return insert_streams_; }
   virtual int get_device_id() { return cache_config_.cuda_dev_id_; }
   virtual bool use_gpu_embedding_cache() { return cache_config_.use_gpu_embedding_cache_; }
+  virtual double get_tracked_hit_rate(size_t table_id) const {
+    return tracked_hit_rate_[table_id].load(std::memory_order_relaxed);
+  }
+  virtual void set_sibling_caches(const std::vector<std::shared_ptr<EmbeddingCacheBase>>& siblings);
+  virtual size_t peer_query(size_t table_id, const void* d_keys, size_t num_keys, float* d_vectors,
+                            uint64_t* d_missing_index, void* d_missing_keys);
   virtual void set_profiler(int iteration, int warmup, bool enable_bench) {
     ec_profiler_->set_config(iteration, warmup, enable_bench);
   };
@@ -110,6 +117,29 @@ class EmbeddingCache : public EmbeddingCacheBase,
   // mutex for insert_streams_
   std::mutex stream_mutex_;
 
+  // Caches of the sibling devices for the peer-sharded cache mode, in chaining order. Held as
+  // weak_ptr: the siblings hold us the same way and all caches of a model are destroyed together,
+  // so shared_ptr here would form a cycle.
+  std::vector<std::weak_ptr<EmbeddingCacheBase>> sibling_caches_;
+
+  // Whether this cache participates in a peer-sharded deployment (set by set_sibling_caches).
+  bool peer_sharding_ = false;
+
+  // Per-table streams on which peer queries from sibling devices are served
+  std::vector<cudaStream_t> peer_streams_;
+
+  // Missing length scratch for peer queries, one entry per table, device buffer + host mirror
+  size_t* d_peer_missing_length_ = nullptr;
+  size_t* h_peer_missing_length_ = nullptr;
+
+  // mutex serializing peer queries from sibling devices
+  std::mutex peer_mutex_;
+
+  // Exponential moving average of the per-table lookup hit rate (negative = no lookup yet).
+  // Updated with relaxed atomics; concurrent lookups may drop an update, which is fine for
+  // telemetry purposes.
+  std::unique_ptr<std::atomic<double>[]> tracked_hit_rate_;
+
   // benchmark profiler
   std::unique_ptr<profiler> ec_profiler_;
 };
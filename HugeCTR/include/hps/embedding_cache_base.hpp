@@ -17,7 +17,11 @@
 
 #include <cuda_runtime_api.h>
 
+#include <common.hpp>
 #include <hps/inference_utils.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -41,6 +45,19 @@ class EmbeddingCacheBase {
                                   size_t num_keys, float hit_rate_threshold,
                                   cudaStream_t stream) = 0;
 
+  /**
+   * Stream-ordered lookup suitable for CUDA graph capture: no workspace pool access, host
+   * locking or synchronous miss handling may happen on this path. Only cache implementations
+   * whose device-side lookups are miss-free (e.g. the static table, which serves the default
+   * vector for unknown keys) support it; the default implementation throws.
+   */
+  virtual void lookup_from_device_graph_safe(size_t table_id, float* d_vectors, const void* d_keys,
+                                             size_t num_keys, cudaStream_t stream) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "This embedding cache does not support graph-capturable lookup; deploy the "
+                   "model with use_static_table=true.");
+  }
+
   virtual void insert(size_t table_id, EmbeddingCacheWorkspace& workspace_handler,
                       cudaStream_t stream) = 0;
   virtual void init(const size_t table_id, EmbeddingCacheRefreshspace& refreshspace_handler,
@@ -66,6 +83,32 @@ class EmbeddingCacheBase {
   virtual const std::vector<cudaStream_t>& get_insert_streams() = 0;
   virtual int get_device_id() = 0;
   virtual bool use_gpu_embedding_cache() = 0;
+
+  /**
+   * Smoothed hit rate observed by recent lookups on the given table, or a negative value if the
+   * cache implementation does not track this telemetry (or no lookup happened yet). Consumed by
+   * the adaptive cache refresher of the parameter server.
+   */
+  virtual double get_tracked_hit_rate(size_t) const { return -1.0; }
+
+  /**
+   * Wire the caches of the sibling devices of the same model for the peer-sharded cache mode, in
+   * the order this cache should chain its missing keys through them. No-op for cache
+   * implementations that do not support peer lookups.
+   */
+  virtual void set_sibling_caches(const std::vector<std::shared_ptr<EmbeddingCacheBase>>&) {}
+
+  /**
+   * Query this cache on behalf of a sibling device. All buffers live on the caller's device and
+   * are accessed through CUDA peer access; the caller must have materialized \p d_keys before the
+   * call. Hit vectors are written compacted to \p d_vectors (position i for input key i), missed
+   * keys and their positions relative to \p d_keys go to \p d_missing_keys / \p d_missing_index.
+   * Returns the number of missed keys, or SIZE_MAX if the implementation does not support peer
+   * queries.
+   */
+  virtual size_t peer_query(size_t, const void*, size_t, float*, uint64_t*, void*) {
+    return std::numeric_limits<size_t>::max();
+  }
   virtual void set_profiler(int iteration, int warmup, bool enable_bench) = 0;
   virtual void profiler_print() = 0;
 };
@@ -31,8 +31,12 @@ class EmbeddingCacheWrapper : public gpu_cache::gpu_cache_api<key_type> {
  public:
   using ModifyOp = typename EmbedCache<key_type, key_type>::ModifyOpType;
 
-  // Ctor
-  EmbeddingCacheWrapper(const size_t capacity_in_set, const size_t embedding_vec_size);
+  // Ctor. With \p fp8_quant the cache stores rows as fp8 elements followed by a per-row float
+  // scale; Query dequantizes into the caller's fp32 buffer and Replace/Update quantize on the
+  // fly, so callers keep exchanging fp32 rows. \p max_query_len bounds the per-stream scratch
+  // that holds the quantized rows between lookup and dequantization.
+  EmbeddingCacheWrapper(const size_t capacity_in_set, const size_t embedding_vec_size,
+                        const bool fp8_quant = false, const size_t max_query_len = 0);
 
   // Dtor
   ~EmbeddingCacheWrapper() noexcept(false);
@@ -60,12 +64,14 @@ class EmbeddingCacheWrapper : public gpu_cache::gpu_cache_api<key_type> {
   struct PerStreamLookupData {
     LookupContextHandle hLookup;
     cudaEvent_t event;
+    int8_t* dQuantValues;  // quantized lookup scratch, only allocated with fp8_quant
   };
 
   struct PerStreamModifyData {
     ModifyContextHandle hUpdate;
     key_type* hIndices;
     cudaEvent_t wait_token;
+    int8_t* dQuantValues;  // quantized modify scratch, only allocated with fp8_quant
   };
 
   PerStreamModifyData GetModifyData(cudaStream_t stream);
@@ -90,6 +96,9 @@ class EmbeddingCacheWrapper : public gpu_cache::gpu_cache_api<key_type> {
   PerStreamLookupData m_gLData;
   typename EmbedCache<key_type, key_type>::CacheConfig config_;
   uint32_t maxUpdateSampleSz = 0;
+  bool fp8_quant_ = false;
+  size_t embedding_vec_size_ = 0;
+  size_t max_query_len_ = 0;
   // Record the lookup event for update/insert sync
   ECEvent ecevent_;
   using WriteLock = std::unique_lock<std::shared_mutex>;
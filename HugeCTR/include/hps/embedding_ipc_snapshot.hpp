@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace HugeCTR {
+
+class EmbeddingCacheBase;
+
+/**
+ * Same-host device-to-device model push over CUDA IPC.
+ *
+ * The trainer (RaggedStaticEmbeddingTable::export_ipc_shard) writes one small descriptor
+ * file per GPU shard exposing its key and embedding buffers through cudaIpcGetMemHandle;
+ * a co-located HPS process ingests the descriptor with ingest_ipc_snapshot(), refreshing
+ * its cache tables with peer-to-peer copies instead of a round trip through checkpoint
+ * files on disk.
+ *
+ * File layout: one EmbeddingIpcShardHeader followed by header.num_tables
+ * EmbeddingIpcTableRecord entries. IPC handles always map whole allocations, so the
+ * buffers' offsets within their allocations are recorded explicitly.
+ */
+struct EmbeddingIpcShardHeader {
+  uint32_t magic;  // EMBEDDING_IPC_MAGIC
+  uint32_t version;
+  uint32_t key_size_bytes;  // size of the trainer's key type
+  uint32_t num_tables;
+  int32_t device_id;  // trainer device owning the buffers
+  cudaIpcMemHandle_t keys_handle;
+  cudaIpcMemHandle_t vectors_handle;
+  uint64_t keys_base_offset_bytes;     // shard keys within the mapped allocation
+  uint64_t vectors_base_offset_bytes;  // shard vectors within the mapped allocation
+};
+
+struct EmbeddingIpcTableRecord {
+  int32_t table_id;
+  int32_t ev_size;
+  uint64_t num_keys;
+  uint64_t key_offset;     // element offset of this table within the shard keys
+  uint64_t vector_offset;  // float offset of this table within the shard vectors
+};
+
+constexpr uint32_t EMBEDDING_IPC_MAGIC = 0x48495043u;  // "HIPC"
+constexpr uint32_t EMBEDDING_IPC_VERSION = 1;
+
+/**
+ * Open the descriptor written by the trainer, map the peer buffers, and refresh the
+ * embedding cache table by table. Table ids in the descriptor index the cache's tables,
+ * i.e. both processes must enumerate the model's sparse tables in the same order. The
+ * peer mappings are closed before returning.
+ */
+void ingest_ipc_snapshot(const std::string& descriptor_path,
+                         std::shared_ptr<EmbeddingCacheBase> embedding_cache);
+
+}  // namespace HugeCTR
@@ -22,6 +22,8 @@
 #include <deque>
 #include <functional>
 #include <hps/database_backend.hpp>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <thread_pool.hpp>
@@ -129,18 +131,27 @@ class HashMapBackend final : public VolatileBackend<Key, HashMapBackendParams> {
     // Key -> Payload map.
     phmap::flat_hash_map<Key, Payload> entries;
 
+    // Entry-level access guard. Structural table changes are published through
+    // atomically swapped table-map snapshots, so this guard only arbitrates access
+    // within one partition and writers never stall readers of other partitions.
+    std::unique_ptr<std::shared_mutex> guard{std::make_unique<std::shared_mutex>()};
+
     Partition() = delete;
 
     Partition(const uint32_t value_size, const HashMapBackendParams& params)
         : value_size{value_size}, allocation_rate{params.allocation_rate} {}
   };
 
-  // Actual data.
+  using TableMap = std::unordered_map<std::string, std::shared_ptr<std::vector<Partition>>>;
+
+  // Actual data. Readers obtain the table map through an atomically swapped snapshot
+  // (RCU-style; a superseded map is reclaimed when the last reader drops its
+  // reference), then synchronize on the per-partition guards only.
   CharAllocator char_allocator_;
-  std::unordered_map<std::string, std::vector<Partition>> tables_;
+  std::shared_ptr<TableMap> tables_{std::make_shared<TableMap>()};
 
-  // Access control.
-  mutable std::shared_mutex read_write_guard_;
+  // Serializes structural writers (insert/evict) with respect to each other.
+  std::mutex write_guard_;
 
   // Overflow resolution.
   size_t resolve_overflow_(const std::string& table_name, size_t part_index, Partition& part);
@@ -15,6 +15,13 @@
  */
 #pragma once
 
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
 #include <hps/database_backend_detail.hpp>
 #include <hps/inference_utils.hpp>
 #include <thread_pool.hpp>
@@ -26,6 +33,36 @@ namespace HugeCTR {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic error "-Wconversion"
 
+/**
+ * HashMap Backend / Value copy
+ *
+ * Embedding payloads are small (typically 64-512 bytes) and their size is loop-invariant within a
+ * partition, but unknown at compile time, so `std::copy_n` falls back to a generic `memcpy` that
+ * redoes its size dispatch for every key. Move whole vector registers instead (AVX-512 / AVX2 /
+ * NEON, depending on the build target) and finish with a scalar tail. The surrounding fetch logic
+ * already walks the keys of one partition back-to-back, so the source reads stay sequential within
+ * each value page.
+ */
+inline void hps_value_copy(const char* const src, const size_t size, char* const dst) {
+  size_t i{0};
+#if defined(__AVX512F__)
+  for (; i + 64 <= size; i += 64) {
+    _mm512_storeu_si512(dst + i, _mm512_loadu_si512(src + i));
+  }
+#elif defined(__AVX2__)
+  for (; i + 32 <= size; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+  }
+#elif defined(__ARM_NEON)
+  for (; i + 16 <= size; i += 16) {
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + i),
+             vld1q_u8(reinterpret_cast<const uint8_t*>(src + i)));
+  }
+#endif
+  std::copy_n(src + i, size - i, dst + i);
+}
+
 /**
  * HashMap Backend / Contains
  */
@@ -91,7 +128,8 @@ namespace HugeCTR {
                                                                                              \
       /* Race-conditions here are deliberately ignored because insignificant in practice. */ \
       __VA_ARGS__;                                                                           \
-      std::copy_n(payload.value, part.value_size, &values[(k - keys) * value_stride]);       \
+      /* `&*` unwraps both raw and interprocess offset pointers. */                          \
+      hps_value_copy(&*payload.value, part.value_size, &values[(k - keys) * value_stride]);  \
     } else {                                                                                 \
       on_miss(k - keys);                                                                     \
       ++miss_count;                                                                          \
@@ -167,7 +205,7 @@ namespace HugeCTR {
       ++num_inserts;                                                                         \
     }                                                                                        \
                                                                                              \
-    std::copy_n(&values[(k - keys) * value_stride], value_size, payload.value);              \
+    hps_value_copy(&values[(k - keys) * value_stride], value_size, &*payload.value);         \
   } while (0)
 
 /**
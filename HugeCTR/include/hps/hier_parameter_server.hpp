@@ -16,6 +16,7 @@
 #pragma once
 
 #include <common.hpp>
+#include <condition_variable>
 #include <hps/database_backend.hpp>
 #include <hps/embedding_cache_base.hpp>
 #include <hps/hier_parameter_server_base.hpp>
@@ -24,6 +25,8 @@
 #include <hps/message.hpp>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -56,6 +59,9 @@ class HierParameterServer : public HierParameterServerBase {
   virtual void lookup(const void* h_keys, size_t length, float* h_vectors,
                       const std::string& model_name, size_t table_id);
   virtual void refresh_embedding_cache(const std::string& model_name, int device_id);
+  virtual void load_model_version(const std::string& model_name, const std::string& version,
+                                  const std::vector<std::string>& sparse_model_files);
+  virtual void activate_model_version(const std::string& model_name, const std::string& version);
   virtual void insert_embedding_cache(size_t table_id,
                                       std::shared_ptr<EmbeddingCacheBase> embedding_cache,
                                       EmbeddingCacheWorkspace& workspace_handler,
@@ -71,6 +77,80 @@ class HierParameterServer : public HierParameterServerBase {
   // Parameter server configuration
   parameter_server_config ps_config_;
 
+  // Multi-tier lookup of one key set; shared by direct and coalesced lookups.
+  void lookup_database(const TypeHashKey* h_keys, size_t length, float* h_vectors,
+                       const std::string& model_name, size_t table_id);
+
+  // Optional micro-batching of concurrent lookups on the same embedding table
+  // (HCTR_HPS_COALESCE_WINDOW_US). The first request per table becomes the batch
+  // leader, keeps the batch open for the configured window, issues one deduplicated
+  // backend query and demultiplexes the results to all joined requests.
+  struct LookupBatch {
+    struct Request {
+      const TypeHashKey* keys;
+      size_t length;
+      float* vectors;
+    };
+    std::vector<Request> requests;
+    bool done = false;
+  };
+  struct CoalescingState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::shared_ptr<LookupBatch> open_batch;
+  };
+  long coalesce_window_us_ = 0;
+  std::mutex coalescing_mutex_;
+  std::map<std::string, std::unique_ptr<CoalescingState>> coalescing_states_;
+
+  // Optional adaptive cache refresher (HCTR_HPS_ADAPTIVE_REFRESH). Monitors the smoothed
+  // per-cache hit rates and, whenever a cache degrades below the configured threshold,
+  // schedules a partial refresh of one refresh-workspace-sized window per table, rotating
+  // through the cache sets so consecutive triggers revisit the stalest segment first.
+  void adaptive_refresh_loop_();
+  void refresh_embedding_cache_partial_(const std::string& model_name, int device_id);
+  double adaptive_refresh_threshold_ = 0.0;
+  long adaptive_refresh_interval_ms_ = 1000;
+  std::map<std::string, std::vector<size_t>> refresh_set_cursors_;
+  std::thread adaptive_refresher_;
+  std::mutex refresher_mutex_;
+  std::condition_variable refresher_cv_;
+  bool refresher_stop_signal_ = false;
+
+  // Optional GPU-side delta updates (HCTR_EC_DELTA_UPDATE). Update batches consumed from the
+  // online update source are upserted into the embedding caches right after they land in the
+  // CPU backends, instead of waiting for the next periodic refresh. Batches are version-fenced
+  // per table tag so a delayed batch can never overwrite a newer one.
+  void update_embedding_cache_deltas_(const std::string& tag, size_t num_pairs,
+                                      const TypeHashKey* keys, const char* values,
+                                      size_t value_size);
+  bool ec_delta_update_enabled_ = false;
+  std::mutex ec_delta_version_mutex_;
+  std::mutex ec_delta_apply_mutex_;
+  std::map<std::string, uint64_t> ec_delta_enqueue_versions_;
+  std::map<std::string, uint64_t> ec_delta_applied_versions_;
+
+  // Optional cache-invalidation bus subscriber (HCTR_HPS_INVALIDATION_BUS = number of key
+  // partitions per table; 0 or unset = disabled). The online updater publishes per-partition
+  // version vectors next to its update batches; this node tracks them and periodically
+  // re-pulls only the cached keys of the partitions whose version moved, instead of cycling
+  // through whole tables on a timer. The partition count must match the publisher.
+  void invalidation_refresh_loop_();
+  void refresh_invalidated_partitions_(const std::string& model_name, int device_id,
+                                       size_t table_id, const std::vector<bool>& dirty_partitions);
+  std::unique_ptr<CacheInvalidationTracker<TypeHashKey>> invalidation_tracker_;
+  long invalidation_refresh_interval_ms_ = 1000;
+  std::thread invalidation_refresher_;
+
+  // Shadow-namespace model versions. A staged version keeps its tables under the tag of
+  // "<model>__<version>" until activate_model_version() flips the active entry; lookups
+  // resolve the tag through this map, so the cutover is one map update under the lock.
+  std::string versioned_model_name_(const std::string& model_name, const std::string& version) {
+    return model_name + "__" + version;
+  }
+  mutable std::shared_mutex model_version_mutex_;
+  std::map<std::string, std::string> active_model_versions_;
+
   // Database layers for multi-tier cache/lookup.
   std::unique_ptr<DatabaseBackendBase<TypeHashKey>> volatile_db_;
   bool volatile_db_initialize_after_startup_;
@@ -84,6 +164,7 @@ class HierParameterServer : public HierParameterServerBase {
   // Realtime data ingestion.
   std::unique_ptr<MessageSource<TypeHashKey>> volatile_db_source_;
   std::unique_ptr<MessageSource<TypeHashKey>> persistent_db_source_;
+  std::unique_ptr<MessageSource<TypeHashKey>> invalidation_source_;
 
   // Buffer pool that manages workspace and refreshspace of embedding caches
   std::shared_ptr<ManagerPool> buffer_pool_;
@@ -62,6 +62,31 @@ class HierParameterServerBase {
   virtual void lookup(const void* h_keys, size_t length, float* h_vectors,
                       const std::string& model_name, size_t table_id) = 0;
   virtual void refresh_embedding_cache(const std::string& model_name, int device_id) = 0;
+
+  /**
+   * Load a new version of the embedding tables of an already deployed model into a shadow
+   * namespace of the database backends, without touching the version which is being served.
+   * The tables must be in the raw dump format (a folder per table containing a "key" and an
+   * "emb_vector" file), one folder per embedding table of the model, in table order.
+   *
+   * @param model_name The name of the deployed model.
+   * @param version The version label under which the tables should be staged.
+   * @param sparse_model_files File system paths of the raw embedding table folders.
+   */
+  virtual void load_model_version(const std::string& model_name, const std::string& version,
+                                  const std::vector<std::string>& sparse_model_files) = 0;
+
+  /**
+   * Atomically cut the lookups of a model over to a version previously staged with
+   * load_model_version(). The GPU embedding caches are re-pulled from the new namespace and
+   * the tables of the version served before are evicted from the database backends. Passing
+   * an empty version switches back to the unversioned namespace.
+   *
+   * @param model_name The name of the deployed model.
+   * @param version The version label to activate.
+   */
+  virtual void activate_model_version(const std::string& model_name,
+                                      const std::string& version) = 0;
   virtual void insert_embedding_cache(size_t table_id,
                                       std::shared_ptr<EmbeddingCacheBase> embedding_cache,
                                       EmbeddingCacheWorkspace& workspace_handler,
@@ -70,6 +95,13 @@ class HierParameterServerBase {
   virtual std::map<std::string, InferenceParams> get_hps_model_configuration_map() = 0;
   virtual void set_profiler(int iteration, int warmup, bool enable_bench) = 0;
   virtual void profiler_print() = 0;
+
+  /**
+   * Pull API for the always-on serving metrics (lookup latency, cache hit ratio, miss-fetch
+   * latency, refresh duration), rendered in the Prometheus text exposition format. Intended to be
+   * scraped periodically by the serving frontend.
+   */
+  virtual std::string export_metrics() const;
 };
 
 }  // namespace HugeCTR
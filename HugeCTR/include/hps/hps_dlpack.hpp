@@ -18,6 +18,7 @@
 #include <hps/dlpack.h>
 
 #include <core23/logger.hpp>
+#include <vector>
 
 // this converter will:
 // 1) take a Tensor object and wrap it in the DLPack tensor
@@ -99,4 +100,14 @@ typedef struct {
 
 HPSTensor fromDLPack(const DLManagedTensor* src);
 
+/*!
+ * \brief Wrap an existing buffer in a DLPack tensor without copying it.
+ *
+ * The returned tensor aliases `data`; ownership stays with the caller, and the tensor's
+ * deleter only releases the DLManagedTensor bookkeeping. The buffer must stay valid until
+ * the consumer is done with the capsule.
+ */
+DLManagedTensor* toDLPack(void* data, DeviceType device, int32_t device_id, DataType type,
+                          const std::vector<int64_t>& shape);
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -51,6 +51,7 @@ enum class DatabaseType_t {
   MultiProcessHashMap,
   RedisCluster,
   RocksDB,
+  ValueLog,
 };
 enum class DatabaseOverflowPolicy_t {
   EvictRandom,
@@ -83,6 +84,8 @@ constexpr const char* hctr_enum_to_c_str(const DatabaseType_t value) {
       return "redis_cluster";
     case DatabaseType_t::RocksDB:
       return "rocks_db";
+    case DatabaseType_t::ValueLog:
+      return "value_log";
     default:
       return "<unknown DatabaseType_t value>";
   }
@@ -166,7 +169,8 @@ struct VolatileDatabaseParams {
   std::string shared_memory_name{
       "hctr_mp_hash_map_database"};  // Name of the shared memory (only for Multi-Process hashmap).
   bool shared_memory_auto_remove{true};
-  size_t num_node_connections{5};  // Only used with Redis backend.
+  bool shared_memory_read_only{false};  // Lock-free read-only attach (only for MP hashmap).
+  size_t num_node_connections{5};       // Only used with Redis backend.
   size_t max_batch_size{64L * 1024};
 
   bool enable_tls{false};
@@ -195,7 +199,8 @@ struct VolatileDatabaseParams {
       const std::string& address, const std::string& user_name, const std::string& password,
       size_t num_partitions, size_t allocation_rate, size_t shared_memory_size,
       const std::string& shared_memory_name, bool shared_memory_auto_remove,
-      size_t num_node_connections, size_t max_batch_size, bool enable_tls,
+      bool shared_memory_read_only, size_t num_node_connections, size_t max_batch_size,
+      bool enable_tls,
       const std::string& tls_ca_certificate, const std::string& tls_client_certificate,
       const std::string& tls_client_key, const std::string& tls_server_name_identification,
       // Overflow handling related.
@@ -438,6 +443,16 @@ struct EmbeddingCacheWorkspace {
                                             // on device, same size as h_embeddingcolumns
   std::vector<float*> d_missing_emb_vec_;   // The buffer to hold retrieved missing emb_vec on
                                             // device, same size as d_shuffled_embeddingoutputvector
+  std::vector<char*> d_missing_flag_;  // Per-unique-key flag marking late-arriving missing keys on
+                                       // device, same size as h_embeddingcolumns
+  std::vector<void*>
+      d_peer_missing_embeddingcolumns_;  // The buffer to hold emb_id missed by a sibling cache
+                                         // during a chained peer lookup, only allocated in
+                                         // peer-sharded mode, same size as h_embeddingcolumns
+  std::vector<uint64_t*>
+      d_peer_missing_index_;  // The miss index returned by a sibling cache (relative to the stage
+                              // input), only allocated in peer-sharded mode, same size as
+                              // h_embeddingcolumns
   std::vector<void*> unique_op_obj_;  // The unique op object for to de-duplicate queried emb_id to
                                       // each emb_table, size = # of emb_table
   size_t* d_missing_length_;  // The buffer to hold missing length for each emb_table on device,
@@ -476,4 +491,17 @@ void decompress_emb_vec_async(const float* d_unique_src_ptr, const uint64_t* d_u
                               const size_t emb_vec_size, const size_t block_size,
                               cudaStream_t stream);
 
+void mark_missing_flag_async(char* d_missing_flag_ptr, const uint64_t* d_missing_index_ptr,
+                             const size_t missing_len, const size_t block_size, cudaStream_t stream);
+
+void compose_missing_index_async(uint64_t* d_rel_index_ptr, const uint64_t* d_missing_index_ptr,
+                                 const size_t missing_len, const size_t block_size,
+                                 cudaStream_t stream);
+
+void scatter_missing_emb_vec_async(const float* d_unique_src_ptr,
+                                   const uint64_t* d_unique_index_ptr,
+                                   const char* d_missing_flag_ptr, float* d_scatter_dst_ptr,
+                                   const size_t scatter_len, const size_t emb_vec_size,
+                                   const size_t block_size, cudaStream_t stream);
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -45,6 +45,9 @@ class LookupSession : public LookupSessionBase {
   virtual void lookup(const std::vector<const void*>& h_keys_per_table,
                       const std::vector<float*>& d_vectors_per_table,
                       const std::vector<size_t>& num_keys_per_table) override final;
+  virtual void lookup_batched(const std::vector<const void*>& h_keys_per_table,
+                              const std::vector<float*>& d_vectors_per_table,
+                              const std::vector<size_t>& num_keys_per_table) override final;
   virtual void lookup_from_device(const void* d_keys, float* d_vectors, size_t num_keys,
                                   size_t table_id) override final;
   virtual void lookup_from_device(const void* d_keys, float* d_vectors, size_t num_keys,
@@ -52,6 +55,9 @@ class LookupSession : public LookupSessionBase {
   virtual void lookup_from_device(const std::vector<const void*>& d_keys_per_table,
                                   const std::vector<float*>& d_vectors_per_table,
                                   const std::vector<size_t>& num_keys_per_table) override final;
+  virtual void lookup_from_device_graph_safe(const void* d_keys, float* d_vectors, size_t num_keys,
+                                             size_t table_id, cudaStream_t stream) override final;
+  virtual void warmup() override final;
 
   virtual const InferenceParams get_inference_params() const override { return inference_params_; }
   virtual void set_profiler(int iteration, int warmup, bool enable_bench) {
@@ -61,6 +67,8 @@ class LookupSession : public LookupSessionBase {
 
  private:
   std::vector<cudaStream_t> lookup_streams_;
+  std::vector<cudaEvent_t> lookup_done_events_;
+  cudaStream_t batched_join_stream_;
   std::shared_ptr<EmbeddingCacheBase> embedding_cache_;
   InferenceParams inference_params_;
   std::unique_ptr<profiler> ls_profiler_;
@@ -43,6 +43,9 @@ class LookupSessionBase {
   virtual void lookup(const std::vector<const void*>& h_keys_per_table,
                       const std::vector<float*>& d_vectors_per_table,
                       const std::vector<size_t>& num_keys_per_table) = 0;
+  virtual void lookup_batched(const std::vector<const void*>& h_keys_per_table,
+                              const std::vector<float*>& d_vectors_per_table,
+                              const std::vector<size_t>& num_keys_per_table) = 0;
   virtual void lookup_from_device(const void* d_keys, float* d_vectors, size_t num_keys,
                                   size_t table_id) = 0;
   virtual void lookup_from_device(const void* d_keys, float* d_vectors, size_t num_keys,
@@ -50,8 +53,17 @@ class LookupSessionBase {
   virtual void lookup_from_device(const std::vector<const void*>& d_keys_per_table,
                                   const std::vector<float*>& d_vectors_per_table,
                                   const std::vector<size_t>& num_keys_per_table) = 0;
+  virtual void lookup_from_device_graph_safe(const void* d_keys, float* d_vectors, size_t num_keys,
+                                             size_t table_id, cudaStream_t stream) = 0;
   virtual const InferenceParams get_inference_params() const = 0;
 
+  /**
+   * Run one maximum-sized dummy lookup per table so every workspace buffer is allocated,
+   * pinned and faulted in before the first production request. Runs automatically at session
+   * creation unless HCTR_LOOKUP_SESSION_WARMUP=0.
+   */
+  virtual void warmup() = 0;
+
   static std::shared_ptr<LookupSessionBase> create(
       const InferenceParams& inference_params,
       const std::shared_ptr<EmbeddingCacheBase>& embedding_cache);
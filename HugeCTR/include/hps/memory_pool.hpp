@@ -17,7 +17,9 @@
 
 #include <cuda_runtime_api.h>
 
+#include <atomic>
 #include <core23/logger.hpp>
+#include <cstdint>
 #include <hps/embedding_cache.hpp>
 #include <iostream>
 #include <map>
@@ -37,14 +39,20 @@ class MemoryBlock {
   MemoryBlock* pNext;  // next mem block
   EmbeddingCacheWorkspace worker_buffer;
   EmbeddingCacheRefreshspace refresh_buffer;
-  bool bUsed;        // occupied
-  bool bBelong;      // belong to current pool
-  MemoryPool* pMem;  // belong to which pool
+  bool bUsed;           // occupied
+  bool bBelong;         // belong to current pool
+  MemoryPool* pMem;     // belong to which pool
+  uint32_t blockIndex;  // index of this block within the pool
+  // Index of the next free block in the lock-free free list. Relaxed-atomic because a concurrent
+  // pop may read it while the owner pushes; such stale reads are rejected by the head tag CAS.
+  std::atomic<uint32_t> freeNext;
   MemoryBlock() {
     this->bBelong = false;
     this->bUsed = false;
     this->pMem = nullptr;
     this->pNext = nullptr;
+    this->blockIndex = 0;
+    this->freeNext = 0;
   };
 };
 class MemoryPool {
@@ -70,17 +78,25 @@ class MemoryPool {
       }
     }
   }
+  // Lock-free pop from the free list. The lookup sessions of all worker streams allocate from
+  // the same pool, so a mutex here serializes them; a CAS loop on the list head does not.
   void* AllocMemory() {
-    std::lock_guard<std::mutex> lock(_mutex);
-    MemoryBlock* pRes = nullptr;
-    if (_pHeader == nullptr) {
-      HCTR_LOG(WARNING, WORLD, "memory pool is empty\n");
-    } else {
-      pRes = _pHeader;
-      _pHeader = _pHeader->pNext;
-      pRes->bUsed = true;
+    uint64_t head = _freeHead.load(std::memory_order_acquire);
+    for (;;) {
+      const uint32_t index = _head_index(head);
+      if (index == _free_list_end) {
+        HCTR_LOG(WARNING, WORLD, "memory pool is empty\n");
+        return nullptr;
+      }
+      MemoryBlock* pRes = _Alloc[index];
+      const uint64_t next =
+          _pack_head(_head_tag(head) + 1, pRes->freeNext.load(std::memory_order_relaxed));
+      if (_freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+        pRes->bUsed = true;
+        return (void*)(pRes);
+      }
     }
-    return (void*)(pRes);
   }
 
   void InitMemory(CACHE_SPACE_TYPE space_type = CACHE_SPACE_TYPE::WORKER) {
@@ -100,6 +116,8 @@ class MemoryPool {
       _pHeader->refresh_buffer = (refresh_buffer);
     }
     _pHeader->pMem = this;
+    _pHeader->blockIndex = 0;
+    _pHeader->freeNext = _nBlock > 1 ? 1 : _free_list_end;
     MemoryBlock* tmp1 = _pHeader;
     for (size_t i = 1; i < _nBlock; i++) {
       _Alloc[i] = (MemoryBlock*)(new MemoryBlock());
@@ -115,18 +133,28 @@ class MemoryPool {
       }
       _Alloc[i]->bBelong = true;
       _Alloc[i]->pMem = this;
+      _Alloc[i]->blockIndex = (uint32_t)i;
+      _Alloc[i]->freeNext = i + 1 < _nBlock ? (uint32_t)(i + 1) : _free_list_end;
       tmp1->pNext = _Alloc[i];
       tmp1 = _Alloc[i];
     }
+    _freeHead.store(_pack_head(0, _nBlock > 0 ? 0 : _free_list_end), std::memory_order_release);
   }
 
+  // Lock-free push onto the free list, the counterpart of AllocMemory
   void FreeMemory(void* p) {
-    std::lock_guard<std::mutex> lock(_mutex);
     MemoryBlock* pBlock = (MemoryBlock*)p;
     if (pBlock->bBelong) {
       pBlock->bUsed = false;
-      pBlock->pNext = _pHeader;
-      _pHeader = pBlock;
+      uint64_t head = _freeHead.load(std::memory_order_acquire);
+      for (;;) {
+        pBlock->freeNext.store(_head_index(head), std::memory_order_relaxed);
+        const uint64_t next = _pack_head(_head_tag(head) + 1, pBlock->blockIndex);
+        if (_freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+          break;
+        }
+      }
     }
     return;
   }
@@ -155,6 +183,18 @@ class MemoryPool {
   std::mutex _mutex;
   MemoryBlock* _Alloc[MAX_MEMORY_SIZE];
   CACHE_SPACE_TYPE _cache_type;
+
+ private:
+  // Terminator index of the lock-free free list (blocks are addressed by their _Alloc index).
+  static constexpr uint32_t _free_list_end = 0xFFFFFFFFu;
+
+  // The list head packs {generation tag, head block index} into one 64-bit word, so a stale head
+  // observed by a concurrent pop/push is detected via the tag (ABA) with a plain 64-bit CAS.
+  static uint64_t _pack_head(uint64_t tag, uint32_t index) { return (tag << 32) | index; }
+  static uint32_t _head_index(uint64_t head) { return (uint32_t)(head & 0xFFFFFFFFu); }
+  static uint64_t _head_tag(uint64_t head) { return head >> 32; }
+
+  std::atomic<uint64_t> _freeHead{_pack_head(0, _free_list_end)};
 };
 
 class ManagerPool {
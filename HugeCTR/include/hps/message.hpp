@@ -16,7 +16,12 @@
 #pragma once
 
 #include <common.hpp>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -104,4 +109,117 @@ class MessageSource {
   virtual void engage(std::function<Callback> callback) = 0;
 };
 
+/**
+ * Tag prefix under which cache-invalidation version vectors travel on the message queue.
+ */
+inline constexpr const char PS_CACHE_INVALIDATION_TAG_PREFIX[] = "hps_inval";
+
+/**
+ * The tag under which the version vector belonging to \p tag travels on the message queue.
+ */
+std::string make_invalidation_tag(const std::string& tag);
+
+/**
+ * Check whether \p tag is a cache-invalidation tag. If so, the tag of the table it belongs
+ * to is stored to \p table_tag .
+ */
+bool parse_invalidation_tag(const std::string& tag, std::string& table_tag);
+
+/**
+ * The key partition a key belongs to for cache-invalidation purposes. Publisher and
+ * subscribers must agree on \p num_partitions , or version vectors become meaningless.
+ */
+inline size_t invalidation_partition_of(const uint64_t key, const size_t num_partitions) {
+  return static_cast<size_t>((key * UINT64_C(0x9e3779b97f4a7c15)) >> 32) % num_partitions;
+}
+
+/**
+ * Publisher half of the cache-invalidation bus. The online updater owns one instance next to
+ * its update message sink and calls on_update() for every update batch it posts. The publisher
+ * maintains a per-tag version vector over a fixed number of key partitions, bumps the versions
+ * of the partitions the batch touches, and emits only the changed entries of the vector through
+ * the supplied message sink under make_invalidation_tag(tag). Partition indices travel as keys
+ * and versions as values, so any MessageSinkBase transport can carry them unchanged.
+ *
+ * @tparam Key Data-type to be used for keys in this message queue.
+ */
+template <typename Key>
+class CacheInvalidationPublisher {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(CacheInvalidationPublisher);
+
+  CacheInvalidationPublisher() = delete;
+
+  /**
+   * Construct a new publisher.
+   *
+   * @param sink The message sink through which version vectors should be emitted.
+   * @param num_partitions The number of key partitions per table; must match the subscribers.
+   */
+  CacheInvalidationPublisher(MessageSinkBase<Key>* sink, size_t num_partitions);
+
+  /**
+   * Account one posted update batch and emit the changed version-vector entries.
+   *
+   * @param tag The tag under which the update batch itself was filed.
+   * @param num_pairs The number of \p keys .
+   * @param keys Pointer to the keys of the update batch.
+   */
+  void on_update(const std::string& tag, size_t num_pairs, const Key* keys);
+
+ private:
+  MessageSinkBase<Key>* const sink_;
+  const size_t num_partitions_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<uint64_t>> versions_;
+};
+
+/**
+ * Subscriber half of the cache-invalidation bus. Each inference node owns one instance, feeds
+ * every received message to observe(), and periodically collects the partitions whose published
+ * version moved past the last version this node has seen via fetch_dirty_partitions(). However
+ * many update batches touched a partition in between, it shows up dirty exactly once, so the
+ * node refreshes it exactly once.
+ *
+ * @tparam Key Data-type to be used for keys in this message queue.
+ */
+template <typename Key>
+class CacheInvalidationTracker {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(CacheInvalidationTracker);
+
+  CacheInvalidationTracker() = delete;
+
+  /**
+   * Construct a new tracker.
+   *
+   * @param num_partitions The number of key partitions per table; must match the publisher.
+   */
+  CacheInvalidationTracker(size_t num_partitions);
+
+  /**
+   * Feed one received message to the tracker.
+   *
+   * @return True if the message was a version-vector message and has been consumed; false if it
+   * is a regular update batch which the caller should process as usual.
+   */
+  bool observe(const std::string& tag, size_t num_pairs, const Key* keys, const char* values,
+               size_t value_size);
+
+  /**
+   * Hand out the dirty-partition bitmaps accumulated since the previous call and reset them.
+   * The result maps table tags to per-partition flags; a set flag means the partition has
+   * changed upstream and should be re-pulled.
+   */
+  std::unordered_map<std::string, std::vector<bool>> fetch_dirty_partitions();
+
+  size_t num_partitions() const { return num_partitions_; }
+
+ private:
+  const size_t num_partitions_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<uint64_t>> seen_versions_;
+  std::unordered_map<std::string, std::vector<bool>> dirty_;
+};
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace HugeCTR {
+
+/**
+ * Process-wide serving metrics for HPS, always on. Recording is a few relaxed atomic increments
+ * on a per-thread shard (no locks, shards are cache-line sized), which keeps the overhead far
+ * below 1% of a lookup. Snapshots aggregate the shards and are rendered in the Prometheus text
+ * exposition format through HierParameterServerBase::export_metrics().
+ */
+namespace metrics {
+
+constexpr int NUM_SHARDS = 16;
+
+inline int shard_index() {
+  static thread_local const int index =
+      static_cast<int>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_SHARDS);
+  return index;
+}
+
+class Counter {
+ public:
+  void add(uint64_t value) {
+    shards_[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+  }
+  uint64_t value() const {
+    uint64_t sum = 0;
+    for (const Shard& shard : shards_) {
+      sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value{0};
+  };
+  Shard shards_[NUM_SHARDS];
+};
+
+/**
+ * Log2-bucketed latency histogram in microseconds; bucket i holds observations up to 2^i us,
+ * the last bucket is the overflow (+Inf) bucket.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int NUM_BUCKETS = 28;
+
+  void observe(uint64_t latency_us) {
+    int bucket = 0;
+    while (bucket < NUM_BUCKETS - 1 && latency_us > (1ull << bucket)) {
+      bucket++;
+    }
+    Shard& shard = shards_[shard_index()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(latency_us, std::memory_order_relaxed);
+  }
+
+  void snapshot(uint64_t (&buckets)[NUM_BUCKETS], uint64_t& sum, uint64_t& count) const {
+    sum = 0;
+    count = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+      buckets[i] = 0;
+    }
+    for (const Shard& shard : shards_) {
+      for (int i = 0; i < NUM_BUCKETS; i++) {
+        const uint64_t bucket_count = shard.buckets[i].load(std::memory_order_relaxed);
+        buckets[i] += bucket_count;
+        count += bucket_count;
+      }
+      sum += shard.sum.load(std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> buckets[NUM_BUCKETS]{};
+    std::atomic<uint64_t> sum{0};
+  };
+  Shard shards_[NUM_SHARDS];
+};
+
+struct Registry {
+  Counter lookup_requests;        // synchronous LookupSession lookups served
+  Counter lookup_keys;            // unique keys queried against the GPU embedding caches
+  Counter lookup_hit_keys;        // unique keys served from the GPU embedding caches
+  LatencyHistogram lookup_latency_us;      // end-to-end LookupSession latency
+  LatencyHistogram miss_fetch_latency_us;  // database backend fetch of cache-missed keys
+  LatencyHistogram refresh_duration_us;    // full or partial embedding cache refresh
+
+  static Registry& instance();
+
+  /**
+   * Render all metrics in the Prometheus text exposition format. The overall cache hit ratio is
+   * exported as a gauge derived from the key counters.
+   */
+  std::string export_prometheus() const;
+};
+
+}  // namespace metrics
+
+}  // namespace HugeCTR
@@ -32,6 +32,37 @@
 
 namespace HugeCTR {
 
+/**
+ * @brief Read-only memory mapping of a local file.
+ *
+ * Used by the raw model loader to serve embedding keys and vectors directly from the page cache
+ * during startup, so populating the database backends does not stage the whole model in heap
+ * buffers. The mapping holds its own reference to the file and is released on reset().
+ */
+class MemoryMappedFile {
+ public:
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  /**
+   * Map the file at the given path. Returns false (leaving the object unmapped) if the file
+   * cannot be opened or mapped, so callers can fall back to FileSystem::read.
+   */
+  bool map(const std::string& path);
+
+  void reset();
+
+  const void* data() const { return data_; }
+  size_t size() const { return nbytes_; }
+
+ private:
+  void* data_ = nullptr;
+  size_t nbytes_ = 0;
+};
+
 // This is a draft for a unified embedding format and needs to keep consistency with 3g embedding
 // or merlinkv
 template <typename TypeHashKey, typename TypeHashValue>
@@ -100,6 +131,25 @@ class IModelLoader {
   virtual void load_fused_emb(const std::string& table_name,
                               const std::vector<std::string>& path_list) = 0;
 
+  /**
+   * Warm-up mode: load only the most popular keys of a table into the
+   * UnifiedEmbeddingTable, so the embedding cache can be pre-filled with the hot set before the
+   * endpoint goes live instead of filling through misses.
+   *
+   * @param table_name The embedding table the warm-up applies to.
+   * @param path File system path of the embedding folder of the table.
+   * @param popularity_file Key-popularity snapshot produced by training; plain text lines of
+   * "table_id<tab>key<tab>count", sorted by count within a table.
+   * @param table_id Entries of the popularity file to consider.
+   * @param max_keys Upper bound on the number of keys to load, typically the cache capacity.
+   * @param emb_size The embedding vector size of the table.
+   * @return The number of keys loaded; their keys and vectors are available through getkeys() and
+   * getvectors().
+   */
+  virtual size_t load_warmup_keys(const std::string& table_name, const std::string& path,
+                                  const std::string& popularity_file, size_t table_id,
+                                  size_t max_keys, size_t emb_size) = 0;
+
   /**
    * free the UnifiedEmbeddingTable(data member) of an inherited class.
    *
@@ -174,6 +224,11 @@ class RawModelLoader : public IModelLoader {
   size_t key_num_iteration = 0;
   std::shared_ptr<HugeCTR::Quantize<float, __nv_fp8_e4m3>> quantizer_;
   cudaStream_t stream;
+  // Zero-copy path for local files: the key/vector files are mapped once in load() and the
+  // per-iteration accessors return pointers into the mapping.
+  MemoryMappedFile key_map_;
+  MemoryMappedFile vec_map_;
+  bool use_mmap_ = false;
   virtual void load_emb(const std::string& table_name, const std::string& path);
 
  public:
@@ -183,6 +238,9 @@ class RawModelLoader : public IModelLoader {
 
   virtual void load_fused_emb(const std::string& table_name,
                               const std::vector<std::string>& path_list);
+  virtual size_t load_warmup_keys(const std::string& table_name, const std::string& path,
+                                  const std::string& popularity_file, size_t table_id,
+                                  size_t max_keys, size_t emb_size);
   virtual void delete_table();
   virtual void* getkeys();
   virtual void* getvectors();
@@ -21,6 +21,7 @@
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
 #include <boost/unordered_map.hpp>
 #include <core/macro.hpp>
 #include <hps/database_backend.hpp>
@@ -41,6 +42,10 @@ struct MultiProcessHashMapBackendParams final : public VolatileBackendParams {
   std::chrono::nanoseconds heart_beat_frequency{std::chrono::milliseconds{
       100}};               // Frequency at which we tick up the heart-beat frequency counter.
   bool auto_remove{true};  // Remove SHM if this is the last process to detach from the SHM.
+  bool read_only{false};   // Attach to an existing SHM in read-only mode. Such processes never
+                           // lock, never write (not even access metadata) and never remove the
+                           // SHM, which permits lock-free sharing of one owner-managed cache
+                           // between many co-located inference processes.
 };
 
 template <typename Key>
@@ -175,6 +180,18 @@ class MultiProcessHashMapBackend final
           tables(segment.get_allocator<std::pair<const SharedString, SharedVector<Partition>>>()) {}
   };
 
+  using SharableLock =
+      boost::interprocess::sharable_lock<boost::interprocess::interprocess_sharable_mutex>;
+
+  /**
+   * Acquires the sharable access lock, unless this process is attached in read-only mode. The
+   * mapping of read-only processes is write-protected, so they cannot even lock the interprocess
+   * mutex and instead read lock-free (the owner guarantees a settled table layout).
+   */
+  SharableLock lock_shared_() const {
+    return this->params_.read_only ? SharableLock{} : SharableLock{sm_->read_write_guard};
+  }
+
   Segment sm_segment_;
   SegmentAllocator<char> char_allocator_;
   SegmentAllocator<ValuePage> value_page_allocator_;
@@ -44,6 +44,13 @@ class Facade final {
   void forward(const char* model_name, const int32_t table_id, const int32_t global_replica_id,
                const size_t num_keys, const size_t emb_vec_size, const void* d_keys,
                void* d_vectors, bool i64_input_tensor, cudaStream_t context_stream);
+
+  // Variant of forward that only issues stream-ordered work on context_stream, for use inside
+  // CUDA graph capture; requires the model to be deployed with use_static_table=true
+  void forward_graph_safe(const char* model_name, const int32_t table_id,
+                          const int32_t global_replica_id, const size_t num_keys,
+                          const size_t emb_vec_size, const void* d_keys, void* d_vectors,
+                          bool i64_input_tensor, cudaStream_t context_stream);
 };
 
 }  // namespace HierarchicalParameterServer
\ No newline at end of file
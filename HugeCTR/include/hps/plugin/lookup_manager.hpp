@@ -46,6 +46,12 @@ class LookupManager final {
                const void* values_ptr, void* emb_vector_ptr, bool i64_input_tensor,
                cudaStream_t context_stream);
 
+  // Stream-ordered lookup that can be recorded into a CUDA graph; always runs on context_stream
+  void forward_graph_safe(const std::string& model_name, const int32_t table_id,
+                          const int32_t global_replica_id, const size_t num_keys,
+                          const size_t emb_vec_size, const void* values_ptr, void* emb_vector_ptr,
+                          bool i64_input_tensor, cudaStream_t context_stream);
+
   bool init_check(parameter_server_config& ps_config, const int32_t global_batch_size,
                   const int32_t num_replicas_in_sync, pluginType_t plugin_type) const;
 
@@ -29,6 +29,9 @@ namespace HugeCTR {
 struct RedisClusterBackendParams final : public VolatileBackendParams {
   std::string address{"127.0.0.1:7000"};  // The host or IP address(es) of the Redis cluster.
                                           // Multiple addresses should be comma-separated.
+                                          // `unix://<path>` connects through a unix domain
+                                          // socket instead (single-node in-host deployments
+                                          // only; cluster redirects carry TCP addresses).
 
   std::string user_name{"default"};  // Redis username.
   std::string password;              // Plaintext password of the user.
@@ -148,9 +151,31 @@ class RedisClusterBackend final : public VolatileBackend<Key, RedisClusterBacken
   void queue_metadata_refresh_(const std::string& table_name, size_t part_index,
                                std::shared_ptr<std::vector<Key>>&& keys);
 
+  /**
+   * Fetches one batch through the packed server-side script: the script returns a single blob
+   * (per-key hit flags followed by the concatenated values of the hits) instead of one bulk
+   * string per key, which is unpacked into the strided destination with the vectorized value
+   * copy. Values of one table are uniformly sized, so the value size is recovered from the
+   * blob itself.
+   */
+  void fetch_packed_batch_(const std::string& hkey_v,
+                           const std::vector<sw::redis::StringView>& k_views, const Key* keys,
+                           char* values, size_t value_stride, const DatabaseMissCallback& on_miss,
+                           size_t& miss_count, std::shared_ptr<std::vector<Key>>& touched_keys);
+
  protected:
   std::unique_ptr<sw::redis::RedisCluster> redis_;
 
+  // Number of `HMGET` batches to queue per pipeline round-trip during `fetch`
+  // (`HCTR_HPS_REDIS_PIPELINE_DEPTH` environment variable; 1 = no pipelining).
+  size_t pipeline_depth_{1};
+
+  // Collapse each fetch batch into one packed reply blob via a server-side script
+  // (`HCTR_HPS_REDIS_PACKED_FETCH` environment variable). Cuts the reply to one bulk string
+  // per batch instead of one per key. Only applies when pipelining is off; with
+  // `pipeline_depth_ > 1` the pipelined `HMGET` path takes precedence.
+  bool packed_fetch_{false};
+
   // Worker used to update timestamps and carry out overflow handling.
   mutable ThreadPool background_worker_{"redis bg worker", 1};
 };
@@ -404,14 +404,98 @@ class RedisBinFileInserter final
     k_views.clear();                                                                               \
     HCTR_HPS_DB_APPLY_(MODE, k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
                                                                                                    \
-    redis_->hmget(                                                                                 \
-        hkey_v, k_views.begin(), k_views.end(),                                                    \
-        RedisDirectValueInserter<Key>(keys, k_views, values, value_stride, on_miss, miss_count,    \
-                                      this->params_.overflow_policy, touched_keys));               \
+    if (packed_fetch_) {                                                                           \
+      fetch_packed_batch_(hkey_v, k_views, keys, values, value_stride, on_miss, miss_count,        \
+                          touched_keys);                                                           \
+    } else {                                                                                       \
+      redis_->hmget(                                                                               \
+          hkey_v, k_views.begin(), k_views.end(),                                                  \
+          RedisDirectValueInserter<Key>(keys, k_views, values, value_stride, on_miss, miss_count,  \
+                                        this->params_.overflow_policy, touched_keys));             \
+    }                                                                                              \
     return true;                                                                                   \
   }()
 #endif
 
+/**
+ * Redis Backend / Pipelined fetch
+ *
+ * Queues up to `pipeline_depth` consecutive `HMGET` batches into a single pipeline and parses all
+ * replies after one `exec`. This collapses the per-batch network round-trips that otherwise
+ * serialize large fetches within a partition (see `HCTR_HPS_REDIS_PIPELINE_DEPTH`).
+ */
+#ifdef HCTR_HPS_REDIS_FETCH_PIPELINED_
+#error HCTR_HPS_REDIS_FETCH_PIPELINED_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_MORE_SEQUENTIAL_DIRECT_() (k != keys_end)
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_MORE_PARALLEL_DIRECT_() (k != keys_end)
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_MORE_SEQUENTIAL_INDIRECT_() (i != indices_end)
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_MORE_PARALLEL_INDIRECT_() (i != indices_end)
+
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_BUILD_SEQUENTIAL_DIRECT_()                            \
+  do {                                                                                       \
+    const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};                 \
+    k_views.reserve(batch_size);                                                             \
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT,                                                    \
+                       k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
+  } while (0)
+
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_BUILD_PARALLEL_DIRECT_()                              \
+  do {                                                                                       \
+    size_t batch_size{0};                                                                    \
+    HCTR_HPS_DB_APPLY_(PARALLEL_DIRECT,                                                      \
+                       k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
+  } while (0)
+
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_BUILD_SEQUENTIAL_INDIRECT_()                          \
+  do {                                                                                       \
+    const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};              \
+    k_views.reserve(batch_size);                                                             \
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_INDIRECT,                                                  \
+                       k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
+  } while (0)
+
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_BUILD_PARALLEL_INDIRECT_()                            \
+  do {                                                                                       \
+    size_t batch_size{0};                                                                    \
+    HCTR_HPS_DB_APPLY_(PARALLEL_INDIRECT,                                                    \
+                       k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
+  } while (0)
+
+#define HCTR_HPS_REDIS_FETCH_PIPELINED_(MODE)                                                    \
+  [&]() {                                                                                        \
+    static_assert(std::is_same_v<decltype(batch_k_views),                                        \
+                                 std::vector<std::vector<sw::redis::StringView>>>);              \
+                                                                                                 \
+    sw::redis::Pipeline pipe{redis_->pipeline(hkey_v, false)};                                   \
+    batch_k_views.clear();                                                                       \
+    while (batch_k_views.size() < pipeline_depth &&                                              \
+           HCTR_HPS_REDIS_FETCH_PIPELINED_MORE_##MODE##_()) {                                    \
+      std::vector<sw::redis::StringView>& k_views{batch_k_views.emplace_back()};                 \
+      const bool batch_formed{[&]() {                                                            \
+        HCTR_HPS_REDIS_FETCH_PIPELINED_BUILD_##MODE##_();                                        \
+        return true;                                                                             \
+      }()};                                                                                      \
+      if (!batch_formed || k_views.empty()) {                                                    \
+        batch_k_views.pop_back();                                                                \
+        break;                                                                                   \
+      }                                                                                          \
+      pipe.hmget(hkey_v, k_views.begin(), k_views.end());                                        \
+    }                                                                                            \
+    if (batch_k_views.empty()) {                                                                 \
+      return false;                                                                              \
+    }                                                                                            \
+                                                                                                 \
+    sw::redis::QueuedReplies replies{pipe.exec()};                                               \
+    for (size_t batch_index{0}; batch_index < batch_k_views.size(); ++batch_index) {             \
+      replies.get(batch_index, RedisDirectValueInserter<Key>(                                    \
+                                   keys, batch_k_views[batch_index], values, value_stride,       \
+                                   on_miss, miss_count, this->params_.overflow_policy,           \
+                                   touched_keys));                                               \
+    }                                                                                            \
+    return true;                                                                                 \
+  }()
+
 #ifdef HCTR_HPS_REDIS_INSERT_
 #error HCTR_HPS_REDIS_INSERT_ already defined. Potential naming conflict!
 #endif
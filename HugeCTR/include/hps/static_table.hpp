@@ -17,6 +17,7 @@
 
 #include <cuda_runtime_api.h>
 
+#include <atomic>
 #include <hps/embedding_cache_base.hpp>
 #include <hps/inference_utils.hpp>
 #include <hps/memory_pool.hpp>
@@ -44,6 +45,8 @@ class StaticTable : public EmbeddingCacheBase,
   virtual void lookup_from_device(size_t table_id, float* d_vectors, const void* d_keys,
                                   size_t num_keys, float hit_rate_threshold,
                                   cudaStream_t stream) override;
+  virtual void lookup_from_device_graph_safe(size_t table_id, float* d_vectors, const void* d_keys,
+                                             size_t num_keys, cudaStream_t stream) override;
   virtual void init(const size_t table_id, EmbeddingCacheRefreshspace& refreshspace_handler,
                     cudaStream_t stream) override;
   virtual void init(const size_t table_id, void* h_refresh_embeddingcolumns_,
@@ -93,6 +96,19 @@ class StaticTable : public EmbeddingCacheBase,
   // embedding tables
   std::vector<std::unique_ptr<Cache>> static_tables_;
 
+  // Double-buffered refresh (HCTR_STATIC_TABLE_DOUBLE_BUFFER). When enabled, a refresh builds the
+  // new model version in the shadow instance and publishes it with an atomic pointer swap, so
+  // in-flight lookups never observe a cleared or partially initialized table. Costs a second
+  // device-memory copy of every table.
+  bool double_buffer_{false};
+  std::vector<std::unique_ptr<Cache>> shadow_tables_;
+  std::unique_ptr<std::atomic<Cache*>[]> active_tables_;
+
+  inline Cache* active_table_(size_t table_id) const {
+    return double_buffer_ ? active_tables_[table_id].load(std::memory_order_acquire)
+                          : static_tables_[table_id].get();
+  }
+
   // The cache configuration
   embedding_cache_config cache_config_;
 
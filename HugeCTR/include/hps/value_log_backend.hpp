@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <filesystem>
+#include <hps/database_backend.hpp>
+#include <hps/database_backend_detail.hpp>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+struct ValueLogBackendParams final : public PersistentBackendParams {
+  std::string path{"/tmp/hps_value_log"};  // File-system directory holding the log files.
+  bool read_only{false};  // If \p true will open the logs in \p read-only mode. This allows
+                          // simultaneously querying the same logs from multiple clients.
+  size_t io_depth{128};   // Maximum number of disk reads kept in flight per fetch (io_uring only).
+};
+
+/**
+ * \p DatabaseBackend implementation that stores values in per-table append-only log files (i.e.,
+ * harddisk / NVMe storage), with a fully in-memory key -> offset index. In contrast to \p
+ * RocksDBBackend, which suffers read amplification from LSM compaction, every fetch from this
+ * backend costs at most one disk read, which suits the write-once/read-many access pattern of
+ * embedding table snapshots. Reads bypass the page cache via \p O_DIRECT where the file-system
+ * supports it, and are batched through io_uring if HugeCTR was built with \p ENABLE_IO_URING .
+ *
+ * @tparam Key The data-type that is used for keys in this database.
+ */
+template <typename Key>
+class ValueLogBackend final : public PersistentBackend<Key, ValueLogBackendParams> {
+ public:
+  using Base = PersistentBackend<Key, ValueLogBackendParams>;
+
+  HCTR_DISALLOW_COPY_AND_MOVE(ValueLogBackend);
+
+  ValueLogBackend() = delete;
+
+  /**
+   * @brief Construct a new ValueLogBackend object.
+   */
+  ValueLogBackend(const ValueLogBackendParams& params);
+
+  virtual ~ValueLogBackend();
+
+  const char* get_name() const override { return "ValueLog"; }
+
+  bool is_shared() const override { return false; }
+
+  size_t size(const std::string& table_name) const override;
+
+  size_t contains(const std::string& table_name, size_t num_keys, const Key* keys,
+                  const std::chrono::nanoseconds& time_budget) const override;
+
+  size_t insert(const std::string& table_name, size_t num_pairs, const Key* keys,
+                const char* values, uint32_t value_size, size_t value_stride) override;
+
+  size_t fetch(const std::string& table_name, size_t num_keys, const Key* keys, char* values,
+               size_t value_stride, const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t fetch(const std::string& table_name, size_t num_indices, const size_t* indices,
+               const Key* keys, char* values, size_t value_stride,
+               const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t evict(const std::string& table_name) override;
+
+  size_t evict(const std::string& table_name, size_t num_keys, const Key* keys) override;
+
+  std::vector<std::string> find_tables(const std::string& model_name) override;
+
+  size_t dump_bin(const std::string& table_name, std::ofstream& file) override;
+
+#ifdef HCTR_USE_ROCKS_DB
+  size_t dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override;
+#endif  // HCTR_USE_ROCKS_DB
+
+ protected:
+  // Offset value in the index log that marks a key as deleted.
+  static constexpr uint64_t tombstone_offset_{std::numeric_limits<uint64_t>::max()};
+
+  // Record format of the index log (appended after a `uint32_t value_size` file header).
+  struct IndexRecord {
+    Key key;
+    uint64_t offset;
+  };
+
+  struct Table {
+    mutable std::shared_mutex guard;
+
+    uint32_t value_size{0};  // Size of each value in the value log.
+    uint64_t log_size{0};    // Append position; also the size of the value log.
+    phmap::flat_hash_map<Key, uint64_t> index;  // Key -> offset of the value in the value log.
+
+    int log_write_fd{-1};    // O_APPEND handle for value log writes.
+    int log_direct_fd{-1};   // O_DIRECT handle for value log reads (-1 = not supported by fs).
+    int log_cached_fd{-1};   // Buffered handle for value log reads (dumps, O_DIRECT fallback).
+    int index_write_fd{-1};  // O_APPEND handle for index log writes.
+
+    ~Table();
+  };
+
+  std::filesystem::path value_log_path_(const std::string& table_name) const {
+    return std::filesystem::path{this->params_.path} / (table_name + ".val");
+  }
+  std::filesystem::path index_log_path_(const std::string& table_name) const {
+    return std::filesystem::path{this->params_.path} / (table_name + ".keys");
+  }
+
+  /**
+   * Open the log file handles of a table and, if the logs already exist on disk, replay the index
+   * log into the in-memory index.
+   */
+  std::unique_ptr<Table> open_table_(const std::string& table_name, uint32_t value_size);
+
+  inline Table* get_table_(const std::string& table_name) const {
+    const std::shared_lock lock(tables_guard_);
+    const auto& it{tables_.find(table_name)};
+    return it != tables_.end() ? it->second.get() : nullptr;
+  }
+
+  Table& get_or_create_table_(const std::string& table_name, uint32_t value_size);
+
+  mutable std::shared_mutex tables_guard_;
+  std::unordered_map<std::string, std::unique_ptr<Table>> tables_;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Process-wide background upload service for checkpoint files. enqueue() copies (or, when the
+ * spool directory lives on the same device, hard-links) the source file into a bounded local
+ * spool and returns, so the caller may delete or overwrite its checkpoint directory
+ * immediately; worker threads then push the spooled files to the remote file system, verify
+ * the remote object's size, and release the spool space. enqueue() blocks while the spool is
+ * at capacity, which bounds the local disk footprint when uploads are slower than dumps.
+ *
+ * Knobs: HCTR_UPLOAD_SPOOL_DIR (default /tmp/hugectr_upload_spool), HCTR_UPLOAD_SPOOL_GB
+ * (default 64), HCTR_UPLOAD_THREADS (default 4).
+ */
+class AsyncFileUploader final {
+ public:
+  static AsyncFileUploader& instance();
+
+  AsyncFileUploader(const AsyncFileUploader&) = delete;
+  AsyncFileUploader& operator=(const AsyncFileUploader&) = delete;
+
+  //! Spool source_path locally and schedule its upload to target_path. Blocks on a full spool.
+  void enqueue(const std::string& source_path, const std::string& target_path);
+
+  //! Block until every scheduled upload has finished.
+  void drain();
+
+  size_t pending() const;
+
+ private:
+  struct UploadJob {
+    std::string spool_path;
+    std::string target_path;
+    uint32_t crc32;
+    size_t num_bytes;
+  };
+
+  AsyncFileUploader();
+  ~AsyncFileUploader();
+
+  void upload_loop();
+
+  std::string spool_dir_;
+  size_t spool_capacity_;
+  size_t spooled_bytes_ = 0;
+  size_t next_spool_id_ = 0;
+  size_t num_in_flight_ = 0;
+  bool terminate_ = false;
+
+  mutable std::mutex mutex_;
+  std::condition_variable job_cond_;
+  std::condition_variable space_cond_;
+  std::deque<UploadJob> jobs_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace HugeCTR
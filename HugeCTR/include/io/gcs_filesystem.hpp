@@ -19,6 +19,7 @@
 #include <google/cloud/storage/client.h>
 
 #include <io/filesystem.hpp>
+#include <io/ranged_reader.hpp>
 #endif
 
 #include <memory>
@@ -100,7 +101,12 @@ class GCSFileSystem final : public FileSystem {
   void batch_upload(const std::string& source_dir, const std::string& target_dir) override;
 
  private:
+  int read_range(const std::string& path, void* buffer, size_t nbytes, size_t offset);
+
   std::unique_ptr<google::cloud::storage::Client> client_;
+  // Declared after client_ so its destructor drains outstanding readaheads while the
+  // client is still alive.
+  RangedReader ranged_reader_;
 };
 #endif
 
@@ -16,6 +16,11 @@
 #pragma once
 
 #include <io/filesystem.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #ifdef ENABLE_HDFS
 #include <hdfs.h>
@@ -91,6 +96,43 @@ class HadoopFileSystem final : public FileSystem {
   hdfsFS fs_;
   hdfsFS local_fs_;
 
+  struct ReadAheadBuffer {
+    std::string path;
+    size_t offset = 0;
+    std::vector<char> data;
+  };
+
+  /**
+   * @brief Look up the size of a file, filling the metadata cache from a single directory
+   * listing RPC on the first miss so that the sizes of all sibling files come for free.
+   * Requires cache_mutex_ to be held.
+   */
+  size_t file_size_locked(const std::string& path) const;
+
+  /**
+   * @brief Get an open read handle for a file, reusing a cached one when possible.
+   * Requires cache_mutex_ to be held.
+   */
+  hdfsFile acquire_read_file_locked(const std::string& path) const;
+
+  /**
+   * @brief Serve a small read from the read-ahead buffer, refilling it with one larger RPC
+   * on a miss.
+   */
+  int read_aggregated(const std::string& path, void* buffer, size_t buffer_size, size_t offset);
+
+  /**
+   * @brief Drop cached metadata and read handles for a path after it has been modified.
+   */
+  void invalidate_cache(const std::string& path);
+
+  mutable std::mutex cache_mutex_;
+  mutable std::unordered_map<std::string, size_t> file_size_cache_;
+  mutable std::list<std::pair<std::string, hdfsFile>> read_files_;
+  mutable std::unordered_map<std::string, std::list<std::pair<std::string, hdfsFile>>::iterator>
+      read_file_index_;
+  ReadAheadBuffer read_ahead_;
+
   /**
    * @brief Connect to HDFS server
    */
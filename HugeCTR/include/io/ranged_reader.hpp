@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+/** Concurrency window for ranged object-store reads (HCTR_OBJECT_STORE_INFLIGHT_PARTS). */
+size_t object_store_inflight_parts();
+
+/**
+ * Splits large object-store reads into ranged parts fetched concurrently and keeps a
+ * one-slot readahead buffer for sequential access patterns such as ModelLoader scanning
+ * a sparse file front to back. The backend supplies a fetch callback that reads one
+ * byte range of one object; the client held by the backend must be thread-safe, which
+ * both the AWS and Google Cloud clients are (they pool connections internally).
+ *
+ * Tunables: HCTR_OBJECT_STORE_PART_NBYTES (part size, default 16 MiB),
+ * HCTR_OBJECT_STORE_INFLIGHT_PARTS (in-flight window, default 16) and
+ * HCTR_OBJECT_STORE_READAHEAD (0 disables the readahead, default on). The readahead
+ * only triggers once two consecutive reads turn out to be adjacent, so random access
+ * never fetches wasted bytes.
+ */
+class RangedReader {
+ public:
+  using FetchRangeFn =
+      std::function<int(const std::string& path, void* buffer, size_t nbytes, size_t offset)>;
+
+  RangedReader();
+  ~RangedReader();
+
+  /**
+   * Serve one FileSystem::read call. file_size must be the object's total size; the
+   * requested range is clamped against it.
+   */
+  int read(const std::string& path, void* buffer, size_t buffer_size, size_t offset,
+           size_t file_size, const FetchRangeFn& fetch_range);
+
+ private:
+  int parallel_fetch_(const std::string& path, void* buffer, size_t nbytes, size_t offset,
+                      const FetchRangeFn& fetch_range);
+  void start_readahead_(const std::string& path, size_t offset, size_t nbytes,
+                        const FetchRangeFn& fetch_range);
+
+  size_t part_nbytes_;
+  size_t num_inflight_;
+  bool readahead_enabled_;
+
+  std::mutex mutex_;
+  std::string last_path_;
+  size_t last_end_{0};
+
+  std::string ra_path_;
+  size_t ra_offset_{0};
+  size_t ra_valid_nbytes_{0};
+  std::vector<char> ra_buffer_;
+  std::future<void> ra_future_;
+};
+
+}  // namespace HugeCTR
@@ -22,6 +22,7 @@
 #include <aws/s3/S3Client.h>
 
 #include <io/filesystem.hpp>
+#include <io/ranged_reader.hpp>
 #include <io/s3_utils.hpp>
 #include <memory>
 #include <string>
@@ -115,7 +116,12 @@ class S3FileSystem final : public FileSystem {
   void batch_upload(const std::string& source_dir, const std::string& target_dir) override;
 
  private:
+  int read_range(const std::string& path, void* buffer, size_t nbytes, size_t offset);
+
   std::unique_ptr<Aws::S3::S3Client> client_;
+  // Declared after client_ so its destructor drains outstanding readaheads while the
+  // client is still alive.
+  RangedReader ranged_reader_;
 };
 #endif
 }  // namespace HugeCTR
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Benchmark-once launch-configuration cache for hand-written kernels
+ * (HCTR_KERNEL_AUTOTUNE=1). A call site offers a small set of candidate configurations and a
+ * launch functor; the first call per (tag, shape, SM arch) times every candidate on the given
+ * stream and all later calls return the cached winner. Pointing HCTR_AUTOTUNE_CACHE at a
+ * writable file persists the winners across runs -- Model::compile preloads it, so a deployed
+ * model never pays the benchmark cost again. With the toggle off, tune() returns the call
+ * site's first candidate, i.e. its built-in heuristic.
+ */
+class KernelAutotuner {
+ public:
+  static KernelAutotuner& get();
+
+  bool enabled() const { return enabled_; }
+
+  /**
+   * Returns the fastest of the candidate configurations for this (tag, shape, arch). The
+   * launch functor must be idempotent: it is invoked several times per candidate while
+   * benchmarking, and the call site still has to launch with the returned winner afterwards.
+   */
+  int tune(const std::string& tag, const std::vector<int64_t>& shape,
+           const std::vector<int>& candidates, const std::function<void(int)>& launch,
+           cudaStream_t stream);
+
+  /**
+   * Loads the on-disk cache if HCTR_AUTOTUNE_CACHE is set. Idempotent; called from
+   * Model::compile and lazily from the first tune().
+   */
+  void load_cache();
+
+ private:
+  KernelAutotuner();
+  std::string make_key(const std::string& tag, const std::vector<int64_t>& shape) const;
+  void save_cache();
+
+  bool enabled_ = false;
+  bool loaded_ = false;
+  std::string cache_path_;
+  std::mutex mutex_;
+  std::map<std::string, int> winners_;
+};
+
+}  // namespace HugeCTR
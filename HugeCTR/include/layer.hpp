@@ -41,6 +41,11 @@ class Layer {
    */
   std::shared_ptr<GPUResource> gpu_resource_;
 
+  /*
+   * Whether the parameters of this layer are still being trained; see set_trainable().
+   */
+  bool trainable_ = true;
+
  protected:
   /*
    * stores the initializer types of this layer.
@@ -64,6 +69,22 @@ class Layer {
 
   virtual std::string get_no_trained_params_in_string() { return std::string(); }
 
+  /*
+   * Frozen layers keep their forward pass, but Network::prop_layers drops the bprop of a
+   * leading frozen run of the graph when the caller states that nothing below the span
+   * consumes its input gradients. Frozen layers above the first trainable layer still run
+   * bprop, since their dgrads carry the chain rule down to it.
+   */
+  void set_trainable(bool trainable) { trainable_ = trainable; }
+  bool is_trainable() const { return trainable_; }
+
+  /*
+   * Activation tensors as wired into the graph; Network::prop_layers derives buffer-level
+   * dependencies from them for branch-parallel execution.
+   */
+  const std::vector<core23::Tensor>& get_input_tensors() const { return input_tensors_; }
+  const std::vector<core23::Tensor>& get_output_tensors() const { return output_tensors_; }
+
   virtual std::vector<core23::Tensor> get_non_trainable_params_as_tensors() {
     return std::vector<core23::Tensor>();
   }
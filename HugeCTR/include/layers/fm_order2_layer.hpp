@@ -47,6 +47,9 @@ class FmOrder2Layer : public Layer {
   int batch_size_;
   int slot_num_;
   int embedding_vec_size_;
+  // Batch rows covered per block, chosen by KernelAutotuner in fprop (0 until tuned); bprop
+  // reuses it because the in-place dgrad kernel cannot be benchmarked.
+  int tuned_rows_per_block_ = 0;
 };
 
 }  // namespace HugeCTR
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cublasLt.h>
+#include <cublas_v2.h>
+#include <cuda.h>
+#include <cuda_fp16.h>
+#include <cuda_fp8.h>
+
+#include <common.hpp>
+#include <core23/tensor.hpp>
+
+namespace HugeCTR {
+
+/**
+ * FP8 (E4M3) forward GEMM path for SM 9.0+ devices.
+ *
+ * cublasLt FP8 matmuls require the TN layout in column-major terms, so the half-precision
+ * kernel is requantized with a transpose into a column-major E4M3 copy and the activation
+ * is quantized in place of its natural row-major layout. Quantization scales follow the
+ * delayed-scaling recipe: every quantization kernel records the absolute maximum it saw,
+ * and Fp8ScalingState::update() folds that amax into a device-side history window and
+ * derives the next iteration's scale from the window maximum, so no host synchronization
+ * is needed on the critical path.
+ */
+class Fp8ScalingState {
+ public:
+  static constexpr int kHistoryLength = 64;
+
+  //! Allocate and reset the device-side state. scale and scale_inv start at 1.
+  void init(const core23::Device& device, cudaStream_t stream);
+  //! Fold the amax recorded since the last call into the history and refresh the scales.
+  void update(cudaStream_t stream);
+
+  const float* scale() const;
+  const float* scale_inv() const;
+  float* amax();
+
+ private:
+  // [0] amax, [1] scale, [2] scale_inv, [3, 3 + kHistoryLength) amax history
+  core23::Tensor state_;
+};
+
+//! Quantize a half tensor to E4M3, recording the absolute maximum into amax.
+void quantize_e4m3_async(const __half* in, __nv_fp8_e4m3* out, int64_t num_elements,
+                         const float* scale, float* amax, cudaStream_t stream);
+
+//! Quantize a row-major [num_rows x num_cols] half matrix to a column-major E4M3 copy.
+void quantize_transpose_e4m3_async(const __half* in, __nv_fp8_e4m3* out, int64_t num_rows,
+                                   int64_t num_cols, const float* scale, float* amax,
+                                   cudaStream_t stream);
+
+struct CublasFp8Desc {
+  cublasLtMatmulDesc_t cublas_op_desc = NULL;
+  cublasLtMatrixLayout_t cublas_mat_a_desc = NULL;
+  cublasLtMatrixLayout_t cublas_mat_b_desc = NULL;
+  cublasLtMatrixLayout_t cublas_mat_c_desc = NULL;
+  cublasLtEpilogue_t epilogue;
+
+  //! cublasLt FP8 matmuls require every dimension to be a multiple of 16.
+  static bool supported(size_t batch_size, size_t bottom_size, size_t top_size);
+
+  void set_fprop_attr(const __half* bias_ptr, Activation_t act, size_t batch_size,
+                      size_t bottom_size, size_t top_size, const float* kernel_scale_inv,
+                      const float* bottom_scale_inv);
+
+  ~CublasFp8Desc();
+};
+
+struct CublasFp8Algo {
+  size_t cublaslt_workspace_size = 1024 * 1024 * 8;
+  void* cublaslt_workspace;
+  cublasLtMatmulAlgo_t algo;
+  cublasLtMatmulPreference_t cublas_preference = NULL;
+  bool initialized = false;
+
+  void init_algorithm(const CublasFp8Desc& cublas_desc, cublasLtHandle_t cublaslt_handle);
+  ~CublasFp8Algo();
+};
+
+struct Fp8GemmFunctor {
+  // top = act(bottom * kernel + bias) with E4M3 operands and a half output.
+  void operator()(const __nv_fp8_e4m3* kernel, const __nv_fp8_e4m3* bottom, __half* top,
+                  const CublasFp8Desc& cublas_desc, const CublasFp8Algo& cublas_algo,
+                  cublasLtHandle_t cublaslt_handle, cudaStream_t stream);
+};
+
+}  // namespace HugeCTR
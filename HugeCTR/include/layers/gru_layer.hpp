@@ -85,6 +85,17 @@ class GRULayer : public TrainableLayer<T> {
   size_t seqLength_, miniBatch, embedding_vec_size_, m = 512;
   int hiddenSize_;  // = 512; //half of the seqLength
   int numLinearLayers;
+
+  // Persistent fused GRU fprop (HCTR_PERSISTENT_GRU=1): the per-gate input projections run
+  // as three sequence-parallel GEMMs and a single kernel then keeps the recurrent weights
+  // resident in shared memory across all timesteps, so short sequences are no longer
+  // dominated by per-timestep launches. Inference only: bprop consumes the reserve space
+  // that only the cudnn forward call populates.
+  bool enable_persistent_gru_ = false;
+  bool persistent_ready_ = false;
+  T* w_mat_[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+  T* w_bias_[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+  T* gate_proj_ = nullptr;
 };
 
 }  // namespace HugeCTR
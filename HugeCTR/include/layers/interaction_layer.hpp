@@ -33,10 +33,21 @@ class InteractionLayer : public Layer {
 
   std::vector<core23::Tensor> intermediate_tensors_;
 
+  // Int8 inference fprop (HCTR_INT8_INTERACTION=1): the pairwise dot products run as an int8
+  // tensor-core batched GEMM with per-batch dynamic symmetric quantization; quantization is
+  // fused into the concat pass and dequantization into the gather pass. Inference only, and
+  // requires the input width to be a multiple of 4 (cublas int8 GEMM constraint).
+  bool enable_int8_inference_ = false;
+  bool int8_buffers_ready_ = false;
+  core23::Tensor int8_concat_tensor_;
+  core23::Tensor int32_mat_tensor_;
+  core23::Tensor int8_scale_tensor_;
+
  private:
   void init(const core23::Tensor& input_bottom_mlp_tensor, const core23::Tensor& input_embeddings,
             core23::Tensor& output_tensor, core23::Tensor& grad_tensor,
             const std::shared_ptr<GPUResource>& gpu_resource);
+  void fprop_int8();
 
  public:
   InteractionLayer(const core23::Tensor& input_bottom_mlp_tensor,
@@ -20,6 +20,7 @@
 
 #include <functional>
 #include <layer.hpp>
+#include <layers/functors/fp8_gemm_functors.hpp>
 #include <layers/functors/fused_fc_layer_functors.hpp>
 #include <trainable_layer.hpp>
 #include <vector>
@@ -40,6 +41,12 @@ class MLPLayer : public TrainableLayer<T> {
   std::vector<bool> output_mask_;
   std::vector<bool> use_bias_;
 
+  // Per-GEMM dropout rates (0 = no dropout after that GEMM). The mask is never materialized:
+  // fprop applies it in place with a counter-based Philox generator and bprop replays the
+  // same sequence to fold the dropout gradient into the dgrad output.
+  std::vector<float> dropout_rates_;
+  std::vector<unsigned long long> dropout_offsets_;
+
   bool async_wgrad_;
   bool fuse_wb_;
   bool enable_tf32_compute_;
@@ -51,6 +58,18 @@ class MLPLayer : public TrainableLayer<T> {
   std::vector<CublasFusedFCLayerAlgo<T>> layer_algo_;
   FusedFCLayerFunctors<T> layer_functors_;
 
+  // FP8 (E4M3) inference fprop path, enabled with HCTR_FP8_MLP=1 on SM 9.0+ devices when
+  // T is __half. See layers/functors/fp8_gemm_functors.hpp for the delayed-scaling recipe.
+  bool enable_fp8_fprop_ = false;
+  std::vector<bool> fp8_layer_;
+  std::vector<core23::Tensor> fp8_kernels_, fp8_bottoms_;
+  std::vector<Fp8ScalingState> fp8_kernel_scales_, fp8_bottom_scales_;
+  std::vector<CublasFp8Desc> fp8_desc_;
+  std::vector<CublasFp8Algo> fp8_algo_;
+  Fp8GemmFunctor fp8_gemm_functor_;
+
+  void fprop_fp8_layer(int index);
+
   std::unique_ptr<DataSimulator> get_uniform_initializer(const int index) override;
   std::unique_ptr<DataSimulator> get_xavier_uniform_initializer(const int index) override;
   std::unique_ptr<DataSimulator> get_xavier_norm_initializer(const int index) override;
@@ -63,7 +82,8 @@ class MLPLayer : public TrainableLayer<T> {
            const std::vector<bool>& use_bias,
            std::vector<Initializer_t> initializer_types = std::vector<Initializer_t>(),
            bool skip_head_dgrad = false, bool async_wgrad = false, bool fuse_wb = false,
-           bool enable_tf32_compute = false);
+           bool enable_tf32_compute = false,
+           const std::vector<float>& dropout_rates = std::vector<float>());
 
   MLPLayer(const MLPLayer& C) = delete;
   MLPLayer& operator=(const MLPLayer&);
@@ -49,6 +49,10 @@ class MultiHeadAttentionLayer : public Layer {
  private:
   bool enable_tf32_compute_;
   bool use_mixed_precision_;
+  // Tiled online-softmax fprop (HCTR_FLASH_ATTENTION=1) that never materializes the
+  // [seq_from x seq_to] score matrix. Inference only: bprop consumes the softmax saved by
+  // the materialized path.
+  bool enable_flash_attention_;
   int64_t num_;
   int64_t dims_;
   bool transpose_b_;
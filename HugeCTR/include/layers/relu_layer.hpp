@@ -25,8 +25,14 @@ namespace HugeCTR {
 template <typename T>
 class ReluLayer : public Layer {
  public:
+  /**
+   * With in_place == true the output tensor is expected to alias the input tensor: fprop keeps
+   * only a 1-bit-per-element sign mask of the pre-activation so the shared buffer can hold the
+   * activation, and bprop re-applies the mask to the gradient the upper layer wrote into that
+   * same buffer (HCTR_INPLACE_ACTIVATIONS=1).
+   */
   ReluLayer(const core23::Tensor& input_tensor, const core23::Tensor& output_tensor,
-            const std::shared_ptr<GPUResource>& gpu_resource);
+            const std::shared_ptr<GPUResource>& gpu_resource, bool in_place = false);
   /**
    * A method of implementing the forward pass of Relu
    * @param stream CUDA stream where the forward propagation is executed
@@ -37,6 +43,10 @@ class ReluLayer : public Layer {
    * @param stream CUDA stream where the backward propagation is executed
    */
   void bprop() override;
+
+ private:
+  bool in_place_;
+  core23::Tensor mask_tensor_;
 };
 
 /**
@@ -45,8 +55,12 @@ class ReluLayer : public Layer {
 template <>
 class ReluLayer<__half> : public Layer {
  public:
+  /**
+   * See the primary template: in_place trades the separate activation buffer for a
+   * 1-bit-per-element sign mask.
+   */
   ReluLayer(const core23::Tensor& input_tensor, const core23::Tensor& output_tensor,
-            const std::shared_ptr<GPUResource>& gpu_resource);
+            const std::shared_ptr<GPUResource>& gpu_resource, bool in_place = false);
   /**
    * A method of implementing the forward pass of Relu
    * @param stream CUDA stream where the forward propagation is executed
@@ -57,6 +71,10 @@ class ReluLayer<__half> : public Layer {
    * @param stream CUDA stream where the backward propagation is executed
    */
   void bprop() override;
+
+ private:
+  bool in_place_;
+  core23::Tensor mask_tensor_;
 };
 
 }  // namespace HugeCTR
@@ -48,6 +48,12 @@ class ReshapeLayerV2 : public Layer {
    * @param stream CUDA stream where the forward propagation is executed
    */
   void bprop() override;
+
+ private:
+  // With HCTR_INPLACE_ACTIVATIONS=1 the output tensor is a zero-copy view of the input buffer:
+  // fprop and bprop become no-ops and no separate activation is allocated. Gradients alias the
+  // same way, so the upper layer writes straight into the lower layer's output buffer.
+  bool is_view_ = false;
 };
 
 }  // namespace HugeCTR
@@ -34,6 +34,13 @@ class ILoss {
   virtual float get_label_weight() const = 0;
   virtual void set_label_weight(float new_weight) = 0;
 
+  /**
+   * Use a device-resident loss scale instead of the constant scaler. Set when
+   * dynamic loss scaling (HCTR_DYNAMIC_LOSS_SCALE) is enabled; the pointer is
+   * owned by ExchangeWgrad's LossScaleGuard.
+   */
+  virtual void set_scaler_ptr(const float* scaler_ptr) = 0;
+
   virtual const std::vector<core23::Tensor>& get_loss_tensors() const = 0;
 };
 
@@ -54,6 +61,7 @@ class Loss : public ILoss {
   std::shared_ptr<GPUResource> gpu_resource_;
   int total_gpu_count_;
   float scaler_;
+  const float* scaler_ptr_ = nullptr;
 
   /**
    * label_tensors_(type: float): stores the label information during the training process.
@@ -77,8 +85,8 @@ class Loss : public ILoss {
   float label_weight;
 
   virtual void do_compute(T* input, const float* label, float* loss, int batch_size,
-                          int feature_dim, float scaler, float rterm, float label_weight,
-                          bool is_train, cudaStream_t stream) = 0;
+                          int feature_dim, float scaler, const float* scaler_ptr, float rterm,
+                          float label_weight, bool is_train, cudaStream_t stream) = 0;
 
   const std::vector<core23::Tensor>& get_label_tensors(bool is_train) const {
     return label_tensors_;
@@ -120,6 +128,8 @@ class Loss : public ILoss {
   float get_label_weight() const override { return label_weight; }
   void set_label_weight(float new_weight) override { label_weight = new_weight; }
 
+  void set_scaler_ptr(const float* scaler_ptr) override { scaler_ptr_ = scaler_ptr; }
+
   const std::vector<core23::Tensor>& get_loss_tensors() const override { return loss_tensors_; }
 };
 
@@ -127,8 +137,8 @@ template <typename T>
 class CrossEntropyLoss : public Loss<T> {
  public:
   void do_compute(T* input, const float* label, float* loss, int batch_size, int feature_dim,
-                  float scaler, float rterm, float label_weight, bool is_train,
-                  cudaStream_t stream) override final;
+                  float scaler, const float* scaler_ptr, float rterm, float label_weight,
+                  bool is_train, cudaStream_t stream) override final;
 
   CrossEntropyLoss(const core23::Tensor& label_tensor, const core23::Tensor& input_tensor,
                    const core23::Tensor& loss_tensor,
@@ -141,8 +151,8 @@ template <typename T>
 class BinaryCrossEntropyLoss : public Loss<T> {
  public:
   void do_compute(T* input, const float* label, float* loss, int batch_size, int feature_dim,
-                  float scaler, float rterm, float label_weight, bool is_train,
-                  cudaStream_t stream) override final;
+                  float scaler, const float* scaler_ptr, float rterm, float label_weight,
+                  bool is_train, cudaStream_t stream) override final;
   BinaryCrossEntropyLoss(const core23::Tensor& label_tensor, const core23::Tensor& input_tensor,
                          const core23::Tensor& loss_tensor,
                          const std::shared_ptr<Regularizer<T>>& regularizer,
@@ -157,8 +167,8 @@ class MultiCrossEntropyLoss : public Loss<T> {
 
  public:
   void do_compute(T* input, const float* label, float* loss, int batch_size, int feature_dim,
-                  float scaler, float rterm, float label_weight, bool is_train,
-                  cudaStream_t stream) override final;
+                  float scaler, const float* scaler_ptr, float rterm, float label_weight,
+                  bool is_train, cudaStream_t stream) override final;
   MultiCrossEntropyLoss(const core23::Tensor& label_tensor, const core23::Tensor& input_tensor,
                         const core23::Tensor& loss_tensor,
                         const std::shared_ptr<Regularizer<T>>& regularizer,
@@ -33,7 +33,7 @@ namespace metrics {
 
 using CountType = u_int32_t;
 enum class RawType { Loss, Pred, Label };
-enum class Type { AUC, AverageLoss, HitRate, NDCG, SMAPE };
+enum class Type { AUC, AverageLoss, HitRate, NDCG, SMAPE, MRR };
 
 using Core23RawMetricMap = std::map<RawType, core23::Tensor>;
 using Core23MultiLossMetricMap = std::map<std::string, Core23RawMetricMap>;
@@ -331,6 +331,89 @@ class AUC : public Metric {
   std::vector<float> per_class_aucs_;
 };
 
+/**
+ * Streaming binned approximation of AUC (HCTR_STREAMING_AUC=1). Instead of gathering
+ * every score for the exact sort-based computation, local_reduce accumulates per-class
+ * positive/negative histograms over [0, 1] on the evaluation stream, and
+ * finalize_metric allreduces the bins over NCCL and integrates the ROC curve with the
+ * trapezoid rule on the host. The approximation error is bounded by the bin width
+ * (HCTR_STREAMING_AUC_BINS, default 8192), and the end-of-eval barrier no longer
+ * scales with the number of evaluated samples.
+ */
+template <typename T>
+class StreamingAUC : public Metric {
+ public:
+  using PredType = T;
+  using LabelType = float;
+  StreamingAUC(int batch_size_per_gpu, int label_dim,
+               const std::shared_ptr<ResourceManager>& resource_manager);
+  ~StreamingAUC() override;
+
+  void local_reduce(int local_gpu_id, Core23RawMetricMap raw_metrics) override;
+  void global_reduce(int n_nets) override;
+  float finalize_metric() override;
+  std::string name() const override { return "AUC"; };
+  std::vector<float> get_per_class_metric() const override { return per_class_aucs_; }
+
+  static bool enabled();
+
+ private:
+  const float pred_min_ = 0.0f;
+  const float pred_max_ = 1.0f;
+  const size_t num_classes_;
+
+  std::shared_ptr<ResourceManager> resource_manager_;
+
+  int num_local_gpus_;
+  int batch_size_per_gpu_;
+  int num_bins_;
+
+  // Per local GPU, [num_classes x num_bins] counts of positive / negative samples
+  std::vector<core23::Tensor> pos_bins_;
+  std::vector<core23::Tensor> neg_bins_;
+  std::vector<float> per_class_aucs_;
+};
+
+/**
+ * Streaming per-query ranking metrics (NDCG@K and MRR) for models whose eval batches are
+ * fixed-length candidate lists. HCTR_RANKING_QUERY_SIZE gives the number of consecutive
+ * samples that form one query and enables the metrics; HCTR_NDCG_K selects the NDCG cutoff
+ * (default 10). Every batch, one thread block per query ranks the query's scores in shared
+ * memory and accumulates the metric into a per-GPU device counter, so nothing is copied back
+ * per iteration; the per-GPU sums are merged with a single NCCL all-reduce when the metric
+ * is finalized at the end of the evaluation. Queries without a positive label are skipped.
+ */
+template <typename T>
+class PerQueryRanking : public Metric {
+ public:
+  using PredType = T;
+  using LabelType = float;
+  enum class Kind { NDCG, MRR };
+  PerQueryRanking(Kind kind, int batch_size_per_gpu,
+                  const std::shared_ptr<ResourceManager>& resource_manager);
+  ~PerQueryRanking() override;
+
+  void local_reduce(int local_gpu_id, Core23RawMetricMap raw_metrics) override;
+  void global_reduce(int n_nets) override;
+  float finalize_metric() override;
+  std::string name() const override { return kind_ == Kind::NDCG ? "NDCG" : "MRR"; }
+
+  static bool enabled();
+
+ private:
+  Kind kind_;
+  int query_size_;
+  int top_k_;
+
+  std::shared_ptr<ResourceManager> resource_manager_;
+  int num_local_gpus_;
+  int batch_size_per_gpu_;
+  int n_batches_;
+
+  // Per local GPU: [metric sum, number of scored queries]
+  std::vector<core23::Tensor> accum_;
+};
+
 class NDCGStorage {
  public:
   void alloc_main(size_t num_local_samples, size_t num_bins, size_t num_partitions,
@@ -25,6 +25,7 @@
 #include <network_buffer_channels.hpp>
 #include <network_helpers.hpp>
 #include <optional>
+#include <utility>
 
 namespace HugeCTR {
 
@@ -85,9 +86,14 @@ struct AdaGradOptHyperParams {
 
   float initial_accu_value = 0.f;
   float epsilon = 1e-7f;
+  // Store the accumulator as 8-bit values with one float scale per embedding
+  // row instead of one float per weight. Only honored by embedding tables that
+  // implement the quantized state path; dense optimizers ignore it.
+  bool quantized_state = false;
 
   bool operator==(const AdaGradOptHyperParams& other) const {
-    return (initial_accu_value == other.initial_accu_value) && (epsilon == other.epsilon);
+    return (initial_accu_value == other.initial_accu_value) && (epsilon == other.epsilon) &&
+           (quantized_state == other.quantized_state);
   }
 
   bool operator!=(const AdaGradOptHyperParams& other) const { return !(*this == other); }
@@ -152,6 +158,12 @@ struct OptParams {
   OptHyperParams hyperparams;
   Update_t update_type{Update_t::Local};
   float scaler{};
+  // Decoupled weight decay for the embedding tables: the sparse optimizers fold
+  // `-lr * weight_decay * w` into the update of the rows touched this step
+  // (lazy regularization), so no separate pass over the table is needed. Dense
+  // optimizers and FTRL (which carries its own lambda1/lambda2 regularization)
+  // ignore it. Can also be set through HCTR_EMB_WEIGHT_DECAY.
+  float weight_decay{};
 
   inline static size_t num_parameters_per_weight(Optimizer_t opt_type) {
     switch (opt_type) {
@@ -180,7 +192,7 @@ struct OptParams {
   bool operator==(const OptParams& other) const {
     return (optimizer == other.optimizer) && (lr == other.lr) &&
            (hyperparams == other.hyperparams) && (update_type == other.update_type) &&
-           (scaler == other.scaler);
+           (scaler == other.scaler) && (weight_decay == other.weight_decay);
   }
 
   bool operator!=(const OptParams& other) const { return !(*this == other); }
@@ -265,13 +277,46 @@ class Optimizer {
     gpu_learning_rate_scheduler_ = sched;
   }
 
+  /**
+   * Dynamic loss scaling (HCTR_DYNAMIC_LOSS_SCALE): device pointers owned by
+   * ExchangeWgrad's LossScaleGuard. unscale_ptr holds the scale that produced
+   * the pending gradients; skip_step_ptr flags steps whose post-allreduce wgrad
+   * contained inf/nan and whose update must be dropped.
+   */
+  void set_dynamic_loss_scale_ptrs(const float* unscale_ptr, const int* skip_step_ptr) {
+    dynamic_unscale_ptr_ = unscale_ptr;
+    skip_step_ptr_ = skip_step_ptr;
+  }
+
   const Optimizer_t& get_optimizer_type() { return optimizer_type_; }
 
+  /**
+   * ZeRO-1 style dense optimizer state sharding (HCTR_ZERO1_DENSE=1). When enabled,
+   * a stateful optimizer keeps state for and updates only this rank's contiguous
+   * 1/N shard of the flattened parameters; Network::update_params gathers the full
+   * weights across the data-parallel ranks after the update.
+   */
+  static bool zero1_dense_enabled();
+
+  /**
+   * True when this optimizer instance updates only its shard of the weights, so the
+   * caller must gather the full weights after update().
+   */
+  virtual bool weights_sharded() const { return false; }
+
  protected:
+  /**
+   * (start, count) of this rank's shard of a flattened buffer of num_elements;
+   * every rank owns ceil(num_elements / num_ranks) elements except a shorter tail.
+   */
+  std::pair<int64_t, int64_t> zero1_shard_range(int64_t num_elements) const;
+
   std::optional<WeightTensors> weight_tensors_;
   std::shared_ptr<GPUResource> gpu_resource_;
   float lr_;  // learning rate
   const float scaler_;
+  const float* dynamic_unscale_ptr_ = nullptr;
+  const int* skip_step_ptr_ = nullptr;
   Optimizer_t optimizer_type_;
 
   std::shared_ptr<GpuLearningRateScheduler> gpu_learning_rate_scheduler_;
@@ -52,6 +52,8 @@ class AdamOptimizer : public Optimizer {
 
   std::vector<core23::Tensor> get_opt_state_tensors() override { return {m_tensor_, v_tensor_}; }
 
+  bool weights_sharded() const override { return zero1_dense_enabled(); }
+
  private:
   // named as in Algorithm 1 of Adam paper (arXiv:1412.6980)
   // except that alpha is lr_ in class Optimizer
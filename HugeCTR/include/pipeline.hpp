@@ -33,7 +33,9 @@ class Scheduleable {
 
   virtual void init(std::shared_ptr<GPUResource> gpu){};
 
-  virtual void run(std::shared_ptr<GPUResource> gpu, bool use_graph) = 0;
+  // graph_key selects which cached CUDA graph a graph-mode run captures/replays
+  // (see GraphWrapper's keyed API); non-graph runs ignore it.
+  virtual void run(std::shared_ptr<GPUResource> gpu, bool use_graph, size_t graph_key = 0) = 0;
 };
 
 class StreamContextScheduleable : public Scheduleable {
@@ -48,6 +50,12 @@ class StreamContextScheduleable : public Scheduleable {
 
   std::function<void()> workload_;
 
+  // iteration tracing (HCTR_PIPELINE_TRACE=1): timing events recorded around the workload
+  bool trace_enabled_ = false;
+  bool trace_recorded_ = false;
+  cudaEvent_t trace_start_ = nullptr;
+  cudaEvent_t trace_stop_ = nullptr;
+
  public:
   HCTR_DISALLOW_COPY_AND_MOVE(StreamContextScheduleable);
 
@@ -61,13 +69,33 @@ class StreamContextScheduleable : public Scheduleable {
 
   std::tuple<std::string, int> get_stream_name(std::shared_ptr<GPUResource> gpu);
 
+  // wait_event/record_done order the distributor->embedding->network handoffs entirely on
+  // the device (cudaStreamWaitEvent against a recorded event): no host round-trip and no SM
+  // spinning, and the dependency is baked into the CUDA graph when capture is on. wait_event
+  // may be called at most once per scheduleable; merge all dependencies into one call.
   void wait_event(const std::vector<cudaEvent_t> &schedule_event, bool external = false);
 
   cudaEvent_t record_done(bool external = false, unsigned int flags = cudaEventDisableTiming);
 
   void init(std::shared_ptr<GPUResource> gpu) override;
 
-  void run(std::shared_ptr<GPUResource> gpu, bool use_graph) override;
+  void run(std::shared_ptr<GPUResource> gpu, bool use_graph, size_t graph_key) override;
+
+  // Create the timing events; the stage then records them around its workload on every
+  // non-graph run. Samples are harvested one iteration later by Pipeline::run.
+  void enable_trace();
+
+  // Elapsed GPU time of the last traced run. Returns false when nothing was recorded yet
+  // or the stop event has not completed (the sample is then dropped, not waited for).
+  bool trace_elapsed_ms(float &ms);
+
+  // Begin/end of the last traced run relative to `origin` (another trace event of the
+  // same iteration); lets the Chrome trace export place stages on one timeline.
+  bool trace_window_ms(cudaEvent_t origin, float &begin_ms, float &end_ms);
+
+  cudaEvent_t trace_start_event() const { return trace_start_; }
+
+  std::string trace_label() const { return stream_name_.value_or("default"); }
 };
 
 class GraphScheduleable : public Scheduleable {
@@ -87,7 +115,11 @@ class GraphScheduleable : public Scheduleable {
   GraphScheduleable(std::vector<std::shared_ptr<Scheduleable>> scheduleable_list)
       : scheduleable_list_(scheduleable_list) {}
 
-  void run(std::shared_ptr<GPUResource> gpu, bool use_graph) override;
+  const std::vector<std::shared_ptr<Scheduleable>> &get_scheduleable_list() const {
+    return scheduleable_list_;
+  }
+
+  void run(std::shared_ptr<GPUResource> gpu, bool use_graph, size_t graph_key) override;
 };
 
 class Pipeline {
@@ -96,6 +128,20 @@ class Pipeline {
   std::shared_ptr<GPUResource> gpu_resource_;
   std::vector<std::shared_ptr<Scheduleable>> scheduleable_list_;
 
+  // iteration tracing (HCTR_PIPELINE_TRACE=1): per-stage durations of recent iterations in a
+  // ring buffer, harvested one iteration behind so the host never waits on the events.
+  // Tracing covers the non-graph run() path only; stages inside a captured CUDA graph
+  // cannot be timed per iteration.
+  std::vector<StreamContextScheduleable *> traced_stages_;
+  std::vector<std::vector<float>> trace_ring_;
+  std::vector<size_t> trace_ring_iters_;
+  size_t trace_count_ = 0;
+  // wall-clock anchor of the iteration whose events harvest_trace reads next; used to
+  // place the stage windows on the shared ChromeTraceRecorder timeline
+  uint64_t trace_anchor_us_ = 0;
+
+  void harvest_trace();
+
  public:
   Pipeline() = default;
 
@@ -106,6 +152,10 @@ class Pipeline {
 
   void run();
 
-  void run_graph();
+  void run_graph(size_t graph_key = 0);
+
+  // Log the worst 1% of traced iterations with their per-stage breakdown. No-op when
+  // tracing is off or nothing was collected.
+  void dump_trace() const;
 };
 }  // namespace HugeCTR
\ No newline at end of file
@@ -37,6 +37,19 @@ struct InputTensorsAndOutputNames {
   std::vector<std::string> output_names;
 };
 
+/**
+ * Optional dense-graph peephole pass (enabled with HCTR_DENSE_FUSION=1). Maximal
+ * InnerProduct[+ReLU] chains whose intermediate tensors have a single consumer are collapsed
+ * into one MLP DenseLayer so they run through MLPLayer's fused cublasLt epilogues, and at a
+ * DCNv2 MultiCross <-> MLP boundary, both sides are switched to asynchronous weight gradients
+ * with the fused weight/bias epilogue on the MLP side. Data-movement glue is rewritten as
+ * well: back-to-back Reshape layers collapse into the final one (each is a full-tensor copy),
+ * and a fan-in of flattening Reshape layers feeding one Concat becomes a single
+ * FusedReshapeConcatGeneral gather over the 3D inputs (float graphs only; that layer has no
+ * half-precision instantiation).
+ */
+void fuse_dense_layer_patterns(std::vector<DenseLayer>& dense_layers, bool use_mixed_precision);
+
 InputTensorsAndOutputNames get_input_tensors_and_output_names(
     const std::vector<std::string>& bottom_names, const std::vector<std::string>& top_names,
     const std::vector<TensorEntity>& tensor_entities);
@@ -56,6 +56,7 @@ void CommonPybind(pybind11::module& m) {
       .export_values();
   pybind11::enum_<HugeCTR::Check_t>(m, "Check_t")
       .value("Sum", HugeCTR::Check_t::Sum)
+      .value("Crc32", HugeCTR::Check_t::Crc32)
       .value("Non", HugeCTR::Check_t::None)
       .export_values();
   pybind11::enum_<HugeCTR::DataReaderType_t>(m, "DataReaderType_t")
@@ -75,6 +76,7 @@ void CommonPybind(pybind11::module& m) {
       .value("FileList", HugeCTR::SourceType_t::FileList)
       .value("Mmap", HugeCTR::SourceType_t::Mmap)
       .value("Parquet", HugeCTR::SourceType_t::Parquet)
+      .value("Kafka", HugeCTR::SourceType_t::Kafka)
       .export_values();
   pybind11::enum_<HugeCTR::TrainPSType_t>(m, "TrainPSType_t")
       .value("Staged", HugeCTR::TrainPSType_t::Staged)
@@ -192,6 +194,7 @@ void CommonPybind(pybind11::module& m) {
       .value("HitRate", HugeCTR::metrics::Type::HitRate)
       .value("NDCG", HugeCTR::metrics::Type::NDCG)
       .value("SMAPE", HugeCTR::metrics::Type::SMAPE)
+      .value("MRR", HugeCTR::metrics::Type::MRR)
       .export_values();
   pybind11::enum_<HugeCTR::DeviceMap::Layout>(m, "DeviceLayout")
       .value("LocalFirst", HugeCTR::DeviceMap::Layout::LOCAL_FIRST)
@@ -230,6 +233,8 @@ void CommonPybind(pybind11::module& m) {
              HugeCTR::DatabaseType_t::RedisCluster)
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseType_t::RocksDB),
              HugeCTR::DatabaseType_t::RocksDB)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseType_t::ValueLog),
+             HugeCTR::DatabaseType_t::ValueLog)
       .export_values();
   pybind11::enum_<HugeCTR::DatabaseOverflowPolicy_t>(m, "DatabaseOverflowPolicy_t")
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseOverflowPolicy_t::EvictRandom),
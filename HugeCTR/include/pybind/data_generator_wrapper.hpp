@@ -31,7 +31,7 @@ void DataGeneratorPybind(pybind11::module &m) {
       .def(pybind11::init<DataReaderType_t, int, int, int, bool, const std::string &,
                           const std::string &, const std::vector<size_t> &,
                           const std::vector<int> &, Check_t, Distribution_t, PowerLaw_t, float, int,
-                          int, int, int, int, bool, int>(),
+                          int, int, int, int, bool, int, const std::vector<float> &>(),
            pybind11::arg("format"), pybind11::arg("label_dim"), pybind11::arg("dense_dim"),
            pybind11::arg("num_slot"), pybind11::arg("i64_input_key"), pybind11::arg("source"),
            pybind11::arg("eval_source"), pybind11::arg("slot_size_array"),
@@ -42,7 +42,8 @@ void DataGeneratorPybind(pybind11::module &m) {
            pybind11::arg("num_files") = 128, pybind11::arg("eval_num_files") = 32,
            pybind11::arg("num_samples_per_file") = 40960, pybind11::arg("num_samples") = 5242880,
            pybind11::arg("eval_num_samples") = 1310720, pybind11::arg("float_label_dense") = false,
-           pybind11::arg("num_threads") = 1)
+           pybind11::arg("num_threads") = 1,
+           pybind11::arg("alpha_array") = std::vector<float>())
       .def_readwrite("format", &HugeCTR::DataGeneratorParams::format)
       .def_readwrite("label_dim", &HugeCTR::DataGeneratorParams::label_dim)
       .def_readwrite("dense_dim", &HugeCTR::DataGeneratorParams::dense_dim)
@@ -56,6 +57,7 @@ void DataGeneratorPybind(pybind11::module &m) {
       .def_readwrite("dist_type", &HugeCTR::DataGeneratorParams::dist_type)
       .def_readwrite("power_law_type", &HugeCTR::DataGeneratorParams::power_law_type)
       .def_readwrite("alpha", &HugeCTR::DataGeneratorParams::alpha)
+      .def_readwrite("alpha_array", &HugeCTR::DataGeneratorParams::alpha_array)
       .def_readwrite("num_files", &HugeCTR::DataGeneratorParams::num_files)
       .def_readwrite("eval_num_files", &HugeCTR::DataGeneratorParams::eval_num_files)
       .def_readwrite("num_samples_per_file", &HugeCTR::DataGeneratorParams::num_samples_per_file)
@@ -29,10 +29,11 @@ void EmbeddingCollectionPybind(pybind11::module &m) {
   pybind11::class_<EmbeddingTableConfig, std::shared_ptr<EmbeddingTableConfig>>(
       m, "EmbeddingTableConfig")
       .def(pybind11::init<const std::string &, int64_t, int, std::optional<OptParams>,
-                          std::optional<embedding::InitParams>>(),
+                          std::optional<embedding::InitParams>, bool>(),
            pybind11::arg("name"), pybind11::arg("max_vocabulary_size"), pybind11::arg("ev_size"),
            pybind11::arg("opt_params_or_empty") = std::nullopt,
-           pybind11::arg("init_param_or_empty") = std::nullopt);
+           pybind11::arg("init_param_or_empty") = std::nullopt,
+           pybind11::arg("half_precision_storage") = false);
   pybind11::enum_<::embedding::CommunicationStrategy>(m, "CommunicationStrategy")
       .value("Uniform", ::embedding::CommunicationStrategy::Uniform)
       .value("Hierarchical", ::embedding::CommunicationStrategy::Hierarchical)
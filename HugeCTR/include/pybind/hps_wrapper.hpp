@@ -50,6 +50,8 @@ class HPS {
                                   size_t table_id, int64_t device_id);
   void lookup_fromdlpack(pybind11::capsule& keys, pybind11::capsule& out_tensor,
                          const std::string& model_name, size_t table_id, int64_t device_id);
+  pybind11::capsule lookup_todlpack(pybind11::capsule& keys, const std::string& model_name,
+                                    size_t table_id, int64_t device_id);
 
  private:
   void initialize();
@@ -223,6 +225,77 @@ void HPS::lookup_fromdlpack(pybind11::capsule& keys, pybind11::capsule& vectors,
                               cudaMemcpyDeviceToDevice));
   }
 }
+pybind11::capsule HPS::lookup_todlpack(pybind11::capsule& keys, const std::string& model_name,
+                                       size_t table_id, int64_t device_id) {
+  HPSTensor hps_key = fromDLPack(keys);
+  size_t num_keys = 1;
+  for (int i = 0; i < hps_key.ndim; i++) {
+    num_keys *= *(reinterpret_cast<size_t*>(hps_key.shape + i));
+  }
+
+  if (lookup_session_map_.find(model_name) == lookup_session_map_.end()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "The model name does not exist in HPS.");
+  }
+  const auto& max_keys_per_sample_per_table =
+      ps_config_.max_feature_num_per_sample_per_emb_table_.at(model_name);
+  const auto& embedding_size_per_table = ps_config_.embedding_vec_size_.at(model_name);
+  const auto& inference_params =
+      parameter_server_->get_hps_model_configuration_map().at(model_name);
+
+  HCTR_THROW_IF(num_keys > max_keys_per_sample_per_table[table_id] * inference_params.max_batchsize,
+                HugeCTR::Error_t::DataCheckError,
+                "The number of keys to be queried should be no large than "
+                "max_keys_per_sample_per_table[table_id] * inference_params.max_batchsize.");
+
+  // Handle both keys of both long long and unsigned int
+  void* key_ptr;
+  if (inference_params.i64_input_key) {
+    key_ptr = static_cast<void*>(hps_key.data);
+  } else {
+    unsigned int* keys;
+    if (hps_key.device == DeviceType::CPU) {
+      keys = h_keys_per_table_map_.find(model_name)->second[table_id];
+    } else {
+      keys = d_keys_per_table_map_.find(model_name)->second[table_id];
+    }
+    auto transform = [](unsigned int* out, long long* in, size_t count) {
+      for (size_t i{0}; i < count; ++i) {
+        out[i] = static_cast<unsigned int>(in[i]);
+      }
+    };
+    transform(keys, static_cast<long long*>(hps_key.data), num_keys);
+    key_ptr = static_cast<void*>(keys);
+  }
+
+  // TODO: batching or scheduling for lookup sessions on multiple GPUs
+  const auto& lookup_session = lookup_session_map_.find(model_name)->second.find(device_id)->second;
+  auto& d_vectors_per_table =
+      d_vectors_per_table_map_.find(model_name)->second.find(device_id)->second;
+
+  if (hps_key.device == DeviceType::CPU) {
+    lookup_session->lookup(key_ptr, d_vectors_per_table[table_id], num_keys, table_id);
+  } else {
+    lookup_session->lookup_from_device(key_ptr, d_vectors_per_table[table_id], num_keys, table_id);
+  }
+
+  // Zero-copy: the capsule aliases the lookup session's own result buffer on the device, so no
+  // device-to-host or device-to-device copy happens here. The buffer stays owned by this HPS
+  // object and is overwritten by the next lookup for the same model/table/device, so the
+  // consumer must read or copy the tensor before issuing another lookup.
+  std::vector<int64_t> vector_shape{static_cast<int64_t>(num_keys),
+                                    static_cast<int64_t>(embedding_size_per_table[table_id])};
+  DLManagedTensor* dlmt =
+      toDLPack(static_cast<void*>(d_vectors_per_table[table_id]), DeviceType::CUDA,
+               static_cast<int32_t>(device_id), DataType::Float, vector_shape);
+  return pybind11::capsule(dlmt, "dltensor", [](PyObject* capsule) {
+    if (PyCapsule_IsValid(capsule, "dltensor")) {
+      DLManagedTensor* dlmt =
+          static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+      dlmt->deleter(dlmt);
+    }
+  });
+}
+
 pybind11::array_t<float> HPS::lookup(pybind11::array_t<size_t>& h_keys,
                                      const std::string& model_name, size_t table_id,
                                      int64_t device_id) {
@@ -283,8 +356,9 @@ void HPSPybind(pybind11::module& m) {
           pybind11::init<DatabaseType_t,
                          // Backend specific.
                          const std::string&, const std::string&, const std::string&, size_t, size_t,
-                         size_t, const std::string&, bool, size_t, size_t, bool, const std::string&,
+                         size_t, const std::string&, bool, bool, size_t, size_t, bool,
                          const std::string&, const std::string&, const std::string&,
+                         const std::string&,
                          // Overflow handling related.
                          size_t, DatabaseOverflowPolicy_t, double,
                          // Caching behavior related.
@@ -300,6 +374,7 @@ void HPSPybind(pybind11::module& m) {
           pybind11::arg("shared_memory_size") = 16L * 1024L * 1024L * 1024L,
           pybind11::arg("shared_memory_name") = "hctr_mp_hash_map_database",
           pybind11::arg("shared_memory_auto_remove") = true,
+          pybind11::arg("shared_memory_read_only") = false,
           pybind11::arg("num_node_connections") = 5, pybind11::arg("max_batch_size") = 64L * 1024L,
           pybind11::arg("enable_tls") = false,
           pybind11::arg("tls_ca_certificate") = "cacertbundle.crt",
@@ -427,7 +502,9 @@ void HPSPybind(pybind11::module& m) {
            pybind11::arg("model_name"), pybind11::arg("table_id"), pybind11::arg("device_id") = 0)
       .def("lookup_fromdlpack", &HugeCTR::python_lib::HPS::lookup_fromdlpack, pybind11::arg("keys"),
            pybind11::arg("out_tensor"), pybind11::arg("model_name"), pybind11::arg("table_id"),
-           pybind11::arg("device_id") = 0);
+           pybind11::arg("device_id") = 0)
+      .def("lookup_todlpack", &HugeCTR::python_lib::HPS::lookup_todlpack, pybind11::arg("keys"),
+           pybind11::arg("model_name"), pybind11::arg("table_id"), pybind11::arg("device_id") = 0);
 }
 
 }  // namespace python_lib
@@ -250,6 +250,10 @@ struct DenseLayer {
   bool use_bias;
   std::vector<Activation_t> acts;
   std::vector<bool> biases;
+  // Per-GEMM dropout rates inside a fused MLP block (0 = no dropout after that GEMM).
+  // Populated by fuse_dense_layer_patterns() when it absorbs standalone Dropout layers;
+  // there is no Python-level knob for it.
+  std::vector<float> mlp_dropout_rates;
   DenseLayerComputeConfig compute_config;
 
   // reshape layer param
@@ -407,6 +411,18 @@ class Model final {
   void fit(int num_epochs, int max_iter, int display, int eval_interval, int snapshot,
            std::string snapshot_prefix);
 
+  /**
+   * Log the per-stage breakdown of the slowest traced iterations (HCTR_PIPELINE_TRACE=1).
+   * Called automatically at the end of fit; also exposed to Python for on-demand dumps.
+   */
+  void dump_pipeline_trace();
+
+  /**
+   * Write everything the unified trace recorder collected (pipeline stage windows plus
+   * data-reader thread events, HCTR_PIPELINE_TRACE=1) as Chrome tracing / Perfetto JSON.
+   */
+  void export_chrome_trace(const std::string& path);
+
   void set_source(std::string source, std::string eval_source);
 
   bool train();
@@ -415,6 +431,18 @@ class Model final {
 
   std::vector<std::pair<std::string, float>> get_eval_metrics();
 
+  /**
+   * Rolling per-group, per-stage GPU timing of the embedding collections.
+   * Empty string unless the profiler is enabled via HCTR_EBC_PROFILE=1.
+   */
+  std::string get_embedding_profile_report() const {
+    std::string report;
+    for (auto& ebc : ebc_list_) {
+      report += ebc->profile_report();
+    }
+    return report;
+  }
+
   Error_t get_current_loss(float* loss);
 
   Error_t download_params_to_files(std::string prefix, int iter);
@@ -490,6 +518,7 @@ class Model final {
   void load_sparse_optimizer_states(const std::vector<std::string>& sparse_opt_states_files);
   void embedding_load(const std::string& path, const std::vector<std::string>& table_names);
   void embedding_dump(const std::string& path, const std::vector<std::string>& table_names);
+  void embedding_dump_for_hps(const std::string& path, const std::vector<std::string>& table_names);
   void load_sparse_optimizer_states(
       const std::map<std::string, std::string>& sparse_opt_states_files_map);
   void freeze_embedding() {
@@ -518,6 +547,16 @@ class Model final {
     it->second->unfreeze();
   }
   void unfreeze_dense() { is_dense_trainable_ = true; };
+  /**
+   * Freeze / unfreeze the bottom dense subnetwork, i.e. the layers that are not embedding
+   * dependent. Unlike freeze_dense(), which zeroes the dense learning rate but still runs
+   * every backward kernel, this marks the bottom layers as non-trainable so that their
+   * bprop and their share of the wgrad allreduce are pruned from the training pipeline.
+   * Note that pruned layers keep their regularizer-initialized wgrads, so an L2
+   * regularizer still decays frozen weights. Must be called after compile().
+   */
+  void freeze_dense_bottom() { set_bottom_dense_trainable_(false); }
+  void unfreeze_dense_bottom() { set_bottom_dense_trainable_(true); }
 
   std::tuple<size_t, size_t, std::vector<size_t>, int> get_tensor_info_by_name(
       const std::string& tensor_name, Tensor_t tensor_type);
@@ -587,6 +626,8 @@ class Model final {
 
   std::vector<core23::Tensor> train_ebc_outptut_;
   std::vector<core23::Tensor> evaluate_ebc_outptut_;
+  // per-EBC ordered per-lookup top names; empty for a batch-major EBC
+  std::vector<std::vector<std::string>> ebc_top_name_lists_;
 
   std::shared_ptr<IDataReader>
       train_data_reader_; /**< data reader to reading data from data set to embedding. */
@@ -612,17 +653,27 @@ class Model final {
   Error_t download_dense_params_to_files_(std::string weights_file,
                                           std::string dense_opt_states_file);
 
+  // HCTR_ASYNC_SNAPSHOT=1: snapshot the dense weights and optimizer states into
+  // host staging with one D2H pass and let a background thread do the writes,
+  // so training resumes while the previous snapshot is still being serialized
+  Error_t snapshot_dense_params_to_files_(std::string weights_file,
+                                          std::string dense_opt_states_file);
+  std::thread snapshot_writer_thread_;
+
   Error_t download_sparse_params_to_files_(const std::vector<std::string>& embedding_files,
                                            const std::vector<std::string>& sparse_opt_state_files);
 
   void init_params_for_dense_();
   void init_params_for_sparse_();
+  void set_bottom_dense_trainable_(bool trainable);
   Error_t load_params_for_dense_(const std::string& model_file);
   Error_t load_params_for_sparse_(const std::vector<std::string>& embedding_file);
   Error_t load_opt_states_for_dense_(const std::string& dense_opt_states_file);
   Error_t load_opt_states_for_sparse_(const std::vector<std::string>& sparse_opt_states_files);
   void exchange_wgrad(size_t device_id);
+  void exchange_wgrad_bucket(size_t device_id, size_t bucket);
   void pre_add_dense_layer(DenseLayer& dense_layer);
+  void negotiate_ebc_output_layout(std::vector<DenseLayer>& dense_layers);
   void add_dense_layers(std::vector<DenseLayer>& dense_layers);
 
   void create_networks();
@@ -134,6 +134,8 @@ void ModelPybind(pybind11::module &m) {
            pybind11::arg("max_iter") = 2000, pybind11::arg("display") = 200,
            pybind11::arg("eval_interval") = 1000, pybind11::arg("snapshot") = 10000,
            pybind11::arg("snapshot_prefix") = "")
+      .def("dump_pipeline_trace", &HugeCTR::Model::dump_pipeline_trace)
+      .def("export_chrome_trace", &HugeCTR::Model::export_chrome_trace, pybind11::arg("path"))
       .def("set_source",
            pybind11::overload_cast<std::string, std::string>(&HugeCTR::Model::set_source),
            pybind11::arg("source"), pybind11::arg("eval_source"))
@@ -149,11 +151,13 @@ void ModelPybind(pybind11::module &m) {
            pybind11::overload_cast<const std::string &>(&HugeCTR::Model::freeze_embedding),
            pybind11::arg("embedding_name"))
       .def("freeze_dense", &HugeCTR::Model::freeze_dense)
+      .def("freeze_dense_bottom", &HugeCTR::Model::freeze_dense_bottom)
       .def("unfreeze_embedding", pybind11::overload_cast<>(&HugeCTR::Model::unfreeze_embedding))
       .def("unfreeze_embedding",
            pybind11::overload_cast<const std::string &>(&HugeCTR::Model::unfreeze_embedding),
            pybind11::arg("embedding_name"))
       .def("unfreeze_dense", &HugeCTR::Model::unfreeze_dense)
+      .def("unfreeze_dense_bottom", &HugeCTR::Model::unfreeze_dense_bottom)
       .def("load_dense_weights", &HugeCTR::Model::load_dense_weights,
            pybind11::arg("dense_model_file"))
       .def("load_sparse_weights",
@@ -172,6 +176,8 @@ void ModelPybind(pybind11::module &m) {
            pybind11::overload_cast<const std::string &, const std::vector<std::string> &>(
                &HugeCTR::Model::embedding_dump),
            pybind11::arg("path"), pybind11::arg("table_names") = std::vector<std::string>())
+      .def("embedding_dump_for_hps", &HugeCTR::Model::embedding_dump_for_hps,
+           pybind11::arg("path"), pybind11::arg("table_names") = std::vector<std::string>())
       .def("load_dense_optimizer_states", &HugeCTR::Model::load_dense_optimizer_states,
            pybind11::arg("dense_opt_states_file"))
       .def("load_sparse_optimizer_states",
@@ -200,6 +206,7 @@ void ModelPybind(pybind11::module &m) {
              return loss;
            })
       .def("get_eval_metrics", &HugeCTR::Model::get_eval_metrics)
+      .def("get_embedding_profile_report", &HugeCTR::Model::get_embedding_profile_report)
       .def("save_params_to_files", &HugeCTR::Model::download_params_to_files,
            pybind11::arg("prefix"), pybind11::arg("iter") = 0)
       .def("get_data_reader_train", &HugeCTR::Model::get_train_data_reader)
@@ -48,6 +48,12 @@ class ResourceManager : public ResourceManagerBase {
 
   virtual DeviceMap::Layout get_device_layout() const = 0;
 
+  // Straggler simulation hook for performance testing: when enabled, implementations stall this
+  // rank's GPU streams by a configured delay each time the hook fires, so pipeline sensitivity
+  // to slow ranks can be measured. The default implementation injects nothing.
+  virtual bool straggler_simulation_enabled() const { return false; }
+  virtual void inject_straggler_delay(size_t local_gpu_id) const {}
+
 #ifndef DISABLE_CUDF
   virtual const std::shared_ptr<rmm::mr::device_memory_resource>&
   get_device_rmm_device_memory_resource(int local_gpu_id) const = 0;
@@ -33,8 +33,13 @@ class ResourceManagerCore : public ResourceManager {
   std::vector<std::shared_ptr<GPUResource>> gpu_resources_; /**< GPU resource vector */
   std::vector<std::vector<bool>> p2p_matrix_;
 
+  bool straggler_sim_enabled_{false};
+  long straggler_delay_us_{0};
+  long straggler_jitter_us_{0};
+
   void all2all_warmup();
   void enable_all_peer_accesses();
+  void init_straggler_simulation();
 
 #ifndef DISABLE_CUDF
   std::vector<std::shared_ptr<rmm::mr::device_memory_resource>> base_cuda_mr_;
@@ -115,6 +120,11 @@ class ResourceManagerCore : public ResourceManager {
 
   DeviceMap::Layout get_device_layout() const override { return device_map_.get_device_layout(); }
 
+  // Straggler simulation for performance testing; configured through HCTR_STRAGGLER_RANKS,
+  // HCTR_STRAGGLER_DELAY_US and HCTR_STRAGGLER_JITTER_US (see resource_manager_core.cpp).
+  bool straggler_simulation_enabled() const override { return straggler_sim_enabled_; }
+  void inject_straggler_delay(size_t local_gpu_id) const override;
+
 #ifndef DISABLE_CUDF
   const std::shared_ptr<rmm::mr::device_memory_resource>& get_device_rmm_device_memory_resource(
       int local_gpu_id) const override;
@@ -29,6 +29,14 @@
 
 namespace HugeCTR {
 
+/**
+ * Work-stealing thread pool. Each worker owns a deque: external submissions are spread
+ * round-robin and consumed FIFO, submissions made from a worker of the same pool go to the
+ * front of its own deque (LIFO slot, keeps subtask data hot), and a worker whose deque runs
+ * dry steals from the back of its siblings before sleeping. Tasks of wildly varying cost
+ * (e.g. Parquet string vs. numeric column decodes) therefore cannot strand queued work
+ * behind one slow worker.
+ */
 class ThreadPool final {
  public:
   HCTR_DISALLOW_COPY_AND_MOVE(ThreadPool);
@@ -62,15 +70,25 @@ class ThreadPool final {
   const std::string name_;
   std::vector<std::thread> workers_;
 
-  mutable std::mutex barrier_;  // Must be obtained to ensure exclusive access.
+  // One deque per worker, each with its own lock so submit and steal contend per queue
+  // rather than on one global mutex.
+  struct WorkerQueue {
+    mutable std::mutex mutex;
+    std::deque<std::packaged_task<void()>> packages;
+  };
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::atomic<size_t> submit_counter_{0};  // round-robin target for external submissions
+  std::atomic<size_t> num_queued_{0};      // tasks pushed but not yet popped
+
+  mutable std::mutex barrier_;  // Guards the sleep/wake and idle bookkeeping below.
   mutable std::condition_variable
       submit_sempahore_;  // Triggered on submission. Workers wait for this.
   mutable std::condition_variable idle_semaphore_;  // Trigger
 
   bool terminate_ = false;  // Used to signal to the workers that termination is imminent.
   size_t num_idle_workers_ = 0;
-  std::deque<std::packaged_task<void()>>
-      packages_;  // Work packages that have not been processed yet.
+
+  bool try_pop_(size_t thread_index, std::packaged_task<void()>& package);
 
   void run_(const size_t thread_index);
 };
@@ -299,6 +299,12 @@ class CudaCPUDeviceContext {
 
   ~CudaCPUDeviceContext() { HCTR_LIB_CHECK_(cudaSetDevice(original_device_)); }
 
+  /** NUMA node closest to the given device, or -1 when unknown. */
+  static int get_numa_node(int device_id) {
+    auto node_it = device_id_to_numa_node_.find(device_id);
+    return node_it != device_id_to_numa_node_.end() ? node_it->second : -1;
+  }
+
  public:
   static std::unordered_map<int, int> device_id_to_numa_node_;
   static std::unordered_map<int, std::vector<int>> numa_node_to_device_ids_;
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrome_trace.hpp>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cstdlib>
+#include <fstream>
+
+namespace HugeCTR {
+
+namespace {
+
+// ~100 iterations of a deep pipeline plus reader events fit comfortably
+constexpr size_t CHROME_TRACE_RING_CAPACITY = 1 << 20;
+
+}  // namespace
+
+ChromeTraceRecorder& ChromeTraceRecorder::instance() {
+  static ChromeTraceRecorder recorder;
+  return recorder;
+}
+
+bool ChromeTraceRecorder::enabled() {
+  static const bool enabled = [] {
+    const char* const env = std::getenv("HCTR_PIPELINE_TRACE");
+    return env != nullptr && 1 == std::atoi(env);
+  }();
+  return enabled;
+}
+
+uint64_t ChromeTraceRecorder::now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void ChromeTraceRecorder::record(const std::string& name, const std::string& category,
+                                 int device_id, const std::string& lane, uint64_t begin_us,
+                                 uint64_t dur_us) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (events_.size() >= CHROME_TRACE_RING_CAPACITY) {
+    events_.pop_front();
+  }
+  events_.push_back(Event{name, category, lane, device_id, begin_us, dur_us});
+}
+
+void ChromeTraceRecorder::export_json(const std::string& path) {
+  std::deque<Event> events;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    events.swap(events_);
+  }
+  if (events.empty()) {
+    HCTR_LOG(WARNING, ROOT,
+             "Chrome trace export: nothing collected (is HCTR_PIPELINE_TRACE=1 set?)\n");
+    return;
+  }
+
+  std::ofstream file(path, std::ios::trunc);
+  HCTR_CHECK_HINT(file.is_open(), "Cannot write chrome trace to %s", path.c_str());
+
+  // string tids are accepted by both chrome://tracing and the Perfetto importer
+  file << "{\"traceEvents\":[\n";
+  bool first = true;
+  for (const Event& event : events) {
+    if (!first) file << ",\n";
+    first = false;
+    file << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+         << "\",\"ph\":\"X\",\"pid\":" << event.device_id << ",\"tid\":\"" << event.lane
+         << "\",\"ts\":" << event.begin_us << ",\"dur\":" << event.dur_us << "}";
+  }
+  file << "\n]}\n";
+
+  HCTR_LOG_S(INFO, ROOT) << "Chrome trace: wrote " << events.size() << " events to " << path
+                         << std::endl;
+}
+
+}  // namespace HugeCTR
@@ -18,8 +18,12 @@
 #include <infiniband/verbs.h>
 #include <linux/mempolicy.h>
 #include <numaif.h>
+#include <sched.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <collectives/ib_comm.hpp>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <utils.cuh>
@@ -35,8 +39,41 @@ static void* proxy_thread_func(void* cfg) {
   CudaCPUDeviceContext context(ibv_config->device_id_);
 
   IbvProxy* proxy = new IbvProxy(ibv_config);
+
+  // Adaptive progress engine (HCTR_IBV_PROXY_ADAPTIVE_POLL): each proxy keeps
+  // hard busy-polling while traffic flows, but once it has seen no progress for
+  // a while it backs off in exponentially growing sleeps, capped by
+  // HCTR_IBV_PROXY_MAX_IDLE_US (default 200us). The first sign of traffic snaps
+  // it back to a hard poll, so bursty phases free the polling cores for other
+  // work at a bounded worst-case wake-up cost of one sleep cap.
+  const char* adaptive_env = std::getenv("HCTR_IBV_PROXY_ADAPTIVE_POLL");
+  const bool adaptive = adaptive_env && std::atoi(adaptive_env) != 0;
+  const char* max_idle_env = std::getenv("HCTR_IBV_PROXY_MAX_IDLE_US");
+  const useconds_t max_idle_us =
+      max_idle_env ? static_cast<useconds_t>(std::atoi(max_idle_env)) : 200;
+  constexpr size_t idle_iters_before_backoff = 2048;
+
+  unsigned long last_progress = proxy->progress_events_;
+  size_t idle_iters = 0;
+  useconds_t idle_us = 0;
   while (*(volatile int*)&proxy->destroy_ != 1) {
     proxy->stm();
+    if (!adaptive) {
+      continue;
+    }
+    if (proxy->progress_events_ != last_progress) {
+      last_progress = proxy->progress_events_;
+      idle_iters = 0;
+      idle_us = 0;
+    } else if (++idle_iters >= idle_iters_before_backoff) {
+      if (idle_us == 0) {
+        sched_yield();
+        idle_us = 1;
+      } else {
+        usleep(idle_us);
+        idle_us = std::min<useconds_t>(idle_us * 2, max_idle_us);
+      }
+    }
   }
   delete (proxy);
   return NULL;
@@ -542,6 +542,9 @@ bool IbvProxy::HierA2ACollContext::wait_send_completion() {
     struct ibv_wc wcs[4];
     int done = ibv_poll_cq(ibv_ctx_->cq_[n], 4, wcs);
     PROXY_ASSERT(done >= 0);
+    if (done > 0) {
+      proxy_ctx_->note_progress();
+    }
     for (int d = 0; d < done; d++) {
       struct ibv_wc* wc = wcs + d;
       if (wc->opcode == IBV_WC_RDMA_WRITE) {
@@ -572,6 +575,7 @@ void IbvProxy::HierA2ACollContext::stm() {
     }
     case WAIT_RECV_CMD: {
       if (check_recv()) {
+        proxy_ctx_->note_progress();
         process_recv();
         process_send();
         state_ = WAIT_COMPLETION;
@@ -790,6 +794,9 @@ bool IbvProxy::HierA2AvCollContext::wait_send_completion() {
     struct ibv_wc wcs[4];
     int done = ibv_poll_cq(ibv_ctx_->cq_[n], 4, wcs);
     PROXY_ASSERT(done >= 0);
+    if (done > 0) {
+      proxy_ctx_->note_progress();
+    }
     for (int d = 0; d < done; d++) {
       struct ibv_wc* wc = wcs + d;
       if (wc->opcode == IBV_WC_RDMA_WRITE) {
@@ -822,6 +829,7 @@ void IbvProxy::HierA2AvCollContext::stm() {
     }
     case WAIT_RECV_CMD: {
       if (check_recv()) {
+        proxy_ctx_->note_progress();
         process_recv();
         process_send();
         state_ = WAIT_COMPLETION;
@@ -938,6 +946,7 @@ void IbvProxy::stm_init() {
   auto& cmd = cfg_.proxy_cmd_->cmd_[cfg_.proxy_id_];
   boost::apply_visitor(ProxyCommandVisitor(this), cmd);
   cfg_.proxy_cmd_->post_completion(cfg_.proxy_id_);
+  note_progress();
 }
 
 void IbvProxy::stm() {
@@ -1270,6 +1279,7 @@ void IbvProxy::ARCollContext::do_pcie_flush() {
 void IbvProxy::ARCollContext::process_sharp_completions() {
   if (sharp_req_counter_ > sharp_cmpl_counter_) {
     if (sharp_coll_req_test(handle[sharp_cmpl_counter_ % MAX_SHARP_BLOCKS])) {
+      proxy_ctx_->note_progress();
 #ifdef AR_DISABLE_PCIE_FLUSH
       *h_gdr_ag_cmd_ = (sharp_cmpl_counter_ + 1);
       _mm_mfence();
@@ -1286,6 +1296,7 @@ void IbvProxy::ARCollContext::process_sharp_completions() {
 void IbvProxy::ARCollContext::process_new_command() {
   bool max_inflight_limit = ((sharp_req_counter_ - sharp_cmpl_counter_) < MAX_SHARP_BLOCKS);
   if (max_inflight_limit && (*(volatile size_t*)h_rs_cmd_ > sharp_req_counter_)) {
+    proxy_ctx_->note_progress();
     reduce_spec_.sbuf_desc.buffer.ptr = (char*)(d_ar_ptr_) + next_offset_;
     reduce_spec_.rbuf_desc.buffer.ptr = (char*)(d_ar_ptr_) + next_offset_;
     reduce_spec_.sbuf_desc.buffer.length = next_length_;
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <collectives/loss_scale_guard.hpp>
+#include <cstdlib>
+#include <utils.cuh>
+#include <utils.hpp>
+
+namespace HugeCTR {
+
+float dynamic_loss_scale_init() {
+  static const float init = [] {
+    const char* const env = std::getenv("HCTR_DYNAMIC_LOSS_SCALE");
+    if (env == nullptr) {
+      return 0.f;
+    }
+    const float s = static_cast<float>(std::atof(env));
+    if (s <= 0.f) {
+      return 0.f;
+    }
+    return s > 1.f ? s : 32768.f;
+  }();
+  return init;
+}
+
+namespace {
+
+constexpr int SCAN_BLOCK_SIZE = 256;
+
+// state[] layout
+constexpr int OVERFLOW_FLAG = 0;
+constexpr int SKIP_FLAG = 1;
+constexpr int CLEAN_STEPS = 2;
+
+// scale[] layout
+constexpr int CURRENT_SCALE = 0;
+constexpr int UNSCALE = 1;
+
+// Standard dynamic-scaling parameters: halve on overflow, double after this
+// many clean steps, and keep the scale inside a sane range.
+constexpr int GROWTH_INTERVAL = 2000;
+constexpr float MIN_SCALE = 1.f;
+constexpr float MAX_SCALE = 16777216.f;  // 2^24
+
+__device__ __forceinline__ bool is_finite(float v) { return isfinite(v); }
+__device__ __forceinline__ bool is_finite(__half v) { return isfinite(__half2float(v)); }
+
+template <typename T>
+__global__ void overflow_scan_kernel(const T* wgrad, size_t len, int* state) {
+  bool overflow = false;
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < len; i += blockDim.x * gridDim.x) {
+    overflow = overflow || !is_finite(wgrad[i]);
+  }
+  if (__syncthreads_or(overflow)) {
+    if (threadIdx.x == 0) {
+      atomicOr(state + OVERFLOW_FLAG, 1);
+    }
+  }
+}
+
+__global__ void scale_update_kernel(float* scale, int* state) {
+  // The pending optimizer update must unscale with the scale that produced this
+  // step's gradients; only the next forward pass sees the updated one.
+  scale[UNSCALE] = scale[CURRENT_SCALE];
+  if (state[OVERFLOW_FLAG]) {
+    float next = scale[CURRENT_SCALE] * 0.5f;
+    scale[CURRENT_SCALE] = next < MIN_SCALE ? MIN_SCALE : next;
+    state[SKIP_FLAG] = 1;
+    state[CLEAN_STEPS] = 0;
+  } else {
+    state[SKIP_FLAG] = 0;
+    if (++state[CLEAN_STEPS] >= GROWTH_INTERVAL) {
+      float next = scale[CURRENT_SCALE] * 2.f;
+      scale[CURRENT_SCALE] = next > MAX_SCALE ? MAX_SCALE : next;
+      state[CLEAN_STEPS] = 0;
+    }
+  }
+  state[OVERFLOW_FLAG] = 0;
+}
+
+}  // namespace
+
+template <typename T>
+LossScaleGuard<T>::LossScaleGuard(const std::vector<std::shared_ptr<GPUResource>>& gpu_resources,
+                                  float initial_scale)
+    : gpu_resources_(gpu_resources), initial_scale_(initial_scale) {
+  per_gpu_.resize(gpu_resources_.size());
+  for (size_t g = 0; g < gpu_resources_.size(); g++) {
+    CudaDeviceContext context(gpu_resources_[g]->get_device_id());
+    HCTR_LIB_THROW(cudaMalloc(&per_gpu_[g].scale, 2 * sizeof(float)));
+    HCTR_LIB_THROW(cudaMalloc(&per_gpu_[g].state, 3 * sizeof(int)));
+    const float init[2] = {initial_scale_, initial_scale_};
+    HCTR_LIB_THROW(
+        cudaMemcpy(per_gpu_[g].scale, init, 2 * sizeof(float), cudaMemcpyHostToDevice));
+    HCTR_LIB_THROW(cudaMemset(per_gpu_[g].state, 0, 3 * sizeof(int)));
+  }
+}
+
+template <typename T>
+LossScaleGuard<T>::~LossScaleGuard() {
+  for (auto& guard : per_gpu_) {
+    HCTR_LIB_CHECK_(cudaFree(guard.scale));
+    HCTR_LIB_CHECK_(cudaFree(guard.state));
+  }
+}
+
+template <typename T>
+void LossScaleGuard<T>::init_buf(const std::vector<void*>& ptr, size_t size_in_bytes) {
+  HCTR_CHECK_HINT(ptr.size() == per_gpu_.size(), "wgrad buffer count mismatch");
+  for (size_t g = 0; g < per_gpu_.size(); g++) {
+    per_gpu_[g].wgrad_ptr = static_cast<T*>(ptr[g]);
+    per_gpu_[g].num_elements = size_in_bytes / sizeof(T);
+  }
+}
+
+template <typename T>
+void LossScaleGuard<T>::check_and_update(size_t device_id, cudaStream_t stream) {
+  GuardPerGPU& guard = per_gpu_[device_id];
+  HCTR_CHECK_HINT(guard.wgrad_ptr, "LossScaleGuard used before init_buf");
+  const int num_blocks = static_cast<int>(
+      std::min<size_t>((guard.num_elements + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE, 1024));
+  overflow_scan_kernel<<<num_blocks, SCAN_BLOCK_SIZE, 0, stream>>>(
+      guard.wgrad_ptr, guard.num_elements, guard.state);
+  scale_update_kernel<<<1, 1, 0, stream>>>(guard.scale, guard.state);
+}
+
+template <typename T>
+float* LossScaleGuard<T>::loss_scale_ptr(size_t device_id) const {
+  return per_gpu_[device_id].scale + CURRENT_SCALE;
+}
+
+template <typename T>
+const float* LossScaleGuard<T>::unscale_ptr(size_t device_id) const {
+  return per_gpu_[device_id].scale + UNSCALE;
+}
+
+template <typename T>
+const int* LossScaleGuard<T>::skip_step_ptr(size_t device_id) const {
+  return per_gpu_[device_id].state + SKIP_FLAG;
+}
+
+template class LossScaleGuard<float>;
+template class LossScaleGuard<__half>;
+
+}  // namespace HugeCTR
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <collectives/wgrad_compressor.hpp>
+#include <cstdlib>
+#include <utils.cuh>
+#include <utils.hpp>
+
+/** Overload of built-in atomicAdd for support on Pascal architectures */
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 600 && __CUDA_ARCH__ < 700
+
+__inline__ __device__ __half atomicAdd(__half* address, __half val) {
+  size_t base_offset = ((size_t)address & 2);
+  uint32_t* base_address = (uint32_t*)((char*)(address)-base_offset);
+
+  uint32_t old = *base_address, assumed;
+  do {
+    assumed = old;
+    {
+      __half assumed_f16 = __ushort_as_half((uint16_t)(assumed >> (base_offset << 3)));
+      uint32_t new_val = assumed;
+      ((uint16_t*)(&new_val))[base_offset >> 1] = __half_as_ushort(__hadd(assumed_f16, val));
+      old = atomicCAS(base_address, assumed, new_val);
+    }
+  } while (assumed != old);
+  return __ushort_as_half((uint16_t)(old >> (base_offset << 3)));
+}
+
+#endif  // defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 600 && __CUDA_ARCH__ < 700
+
+namespace HugeCTR {
+
+float wgrad_topk_ratio() {
+  static const float ratio = [] {
+    const char* const env = std::getenv("HCTR_WGRAD_TOPK_RATIO");
+    if (env == nullptr) {
+      return 0.f;
+    }
+    const float r = static_cast<float>(std::atof(env));
+    return (r > 0.f && r < 1.f) ? r : 0.f;
+  }();
+  return ratio;
+}
+
+namespace {
+
+constexpr int COMPRESS_BLOCK_SIZE = 256;
+constexpr int COMPRESS_MAX_GRID = 2048;
+
+// Adds the residual into the gradient, packs entries above the threshold into
+// (index, value) pairs and banks the rest (or capacity overflow) back in the
+// residual. The wgrad buffer is zeroed so the scatter-add can rebuild the sum.
+template <typename T>
+__global__ void select_and_pack_kernel(T* wgrad, T* residual, size_t num_elems,
+                                       const float* threshold, int* count, float* max_abs,
+                                       uint32_t* indices, T* values, int capacity) {
+  __shared__ float s_max[COMPRESS_BLOCK_SIZE];
+  const float thr = *threshold;
+  float local_max = 0.f;
+
+  for (size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < num_elems;
+       i += static_cast<size_t>(gridDim.x) * blockDim.x) {
+    const float g = static_cast<float>(wgrad[i]) + static_cast<float>(residual[i]);
+    const float mag = fabsf(g);
+    local_max = fmaxf(local_max, mag);
+    wgrad[i] = TypeConvertFunc<T, float>::convert(0.f);
+
+    bool packed = false;
+    if (mag >= thr && mag > 0.f) {
+      const int slot = atomicAdd(count, 1);
+      if (slot < capacity) {
+        indices[slot] = static_cast<uint32_t>(i);
+        values[slot] = TypeConvertFunc<T, float>::convert(g);
+        packed = true;
+      }
+    }
+    residual[i] = TypeConvertFunc<T, float>::convert(packed ? 0.f : g);
+  }
+
+  s_max[threadIdx.x] = local_max;
+  __syncthreads();
+  for (int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+    if (threadIdx.x < stride) {
+      s_max[threadIdx.x] = fmaxf(s_max[threadIdx.x], s_max[threadIdx.x + stride]);
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    // fabsf results are non-negative, so their bit patterns order like the floats
+    atomicMax(reinterpret_cast<unsigned int*>(max_abs), __float_as_uint(s_max[0]));
+  }
+}
+
+// Single-thread feedback controller: doubles the threshold on capacity overflow
+// (seeding from the observed max on the first pass), halves it when fewer than
+// half the top-k target was selected, and clamps the count for the allgather.
+__global__ void adapt_threshold_kernel(float* threshold, float* max_abs, int* count, int capacity,
+                                       int target) {
+  const int selected = *count;
+  float thr = *threshold;
+  if (selected > capacity) {
+    thr = (thr > 0.f) ? thr * 2.f : *max_abs * 0.5f;
+  } else if (selected < target / 2) {
+    thr *= 0.5f;
+  }
+  *threshold = thr;
+  *max_abs = 0.f;
+  *count = selected < capacity ? selected : capacity;
+}
+
+template <typename T>
+__global__ void scatter_add_kernel(T* wgrad, const uint32_t* indices, const T* values,
+                                   const int* counts, int capacity, int num_ranks) {
+  const size_t num_slots = static_cast<size_t>(num_ranks) * capacity;
+  for (size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < num_slots;
+       i += static_cast<size_t>(gridDim.x) * blockDim.x) {
+    const int rank = static_cast<int>(i / capacity);
+    const int slot = static_cast<int>(i % capacity);
+    if (slot < counts[rank]) {
+      atomicAdd(wgrad + indices[i], values[i]);
+    }
+  }
+}
+
+int compress_grid_size(size_t num_work_items) {
+  const size_t blocks = (num_work_items + COMPRESS_BLOCK_SIZE - 1) / COMPRESS_BLOCK_SIZE;
+  return static_cast<int>(std::min<size_t>(blocks, COMPRESS_MAX_GRID));
+}
+
+}  // namespace
+
+template <typename T>
+WgradCompressor<T>::WgradCompressor(const std::vector<std::shared_ptr<GPUResource>>& gpu_resources,
+                                    float ratio)
+    : gpu_resources_(gpu_resources), num_gpus_(gpu_resources.size()), ratio_(ratio) {
+  ctx_.resize(num_gpus_);
+}
+
+template <typename T>
+void WgradCompressor<T>::init_buf(const std::vector<void*>& ptr, size_t size_in_bytes) {
+  num_elems_ = size_in_bytes / sizeof(T);
+  const size_t target = std::max<size_t>(1, static_cast<size_t>(num_elems_ * ratio_));
+  capacity_ = 2 * target;
+
+  HCTR_LIB_THROW(ncclCommCount(gpu_resources_[0]->get_nccl(), &num_ranks_));
+
+  for (size_t g = 0; g < num_gpus_; g++) {
+    HCTR_LIB_THROW(cudaSetDevice(gpu_resources_[g]->get_device_id()));
+    auto& ctx = ctx_[g];
+    HCTR_CHECK_HINT(ptr[g], "buffer does not exist");
+    ctx.wgrad_ptr = static_cast<T*>(ptr[g]);
+    ctx.buf_ = GeneralBuffer2<CudaAllocator>::create();
+    ctx.buf_->reserve({num_elems_}, &ctx.residual_);
+    ctx.buf_->reserve({capacity_}, &ctx.send_indices_);
+    ctx.buf_->reserve({capacity_}, &ctx.send_values_);
+    ctx.buf_->reserve({1}, &ctx.send_count_);
+    ctx.buf_->reserve({2}, &ctx.threshold_);
+    ctx.buf_->reserve({static_cast<size_t>(num_ranks_) * capacity_}, &ctx.recv_indices_);
+    ctx.buf_->reserve({static_cast<size_t>(num_ranks_) * capacity_}, &ctx.recv_values_);
+    ctx.buf_->reserve({static_cast<size_t>(num_ranks_)}, &ctx.recv_counts_);
+    ctx.buf_->allocate();
+    HCTR_LIB_THROW(cudaMemset(ctx.buf_->get_ptr(), 0, ctx.buf_->get_size_in_bytes()));
+  }
+
+  HCTR_LOG_S(INFO, ROOT) << "Wgrad top-k compression enabled: ratio " << ratio_ << ", "
+                         << capacity_ << " of " << num_elems_
+                         << " gradients exchanged per rank at most" << std::endl;
+}
+
+template <typename T>
+void WgradCompressor<T>::compress_exchange(size_t device_id, cudaStream_t stream) {
+  auto& ctx = ctx_[device_id];
+  const int target = static_cast<int>(capacity_ / 2);
+
+  HCTR_LIB_THROW(cudaMemsetAsync(ctx.send_count_.get_ptr(), 0, sizeof(int), stream));
+  select_and_pack_kernel<T><<<compress_grid_size(num_elems_), COMPRESS_BLOCK_SIZE, 0, stream>>>(
+      ctx.wgrad_ptr, ctx.residual_.get_ptr(), num_elems_, ctx.threshold_.get_ptr(),
+      ctx.send_count_.get_ptr(), ctx.threshold_.get_ptr() + 1, ctx.send_indices_.get_ptr(),
+      ctx.send_values_.get_ptr(), static_cast<int>(capacity_));
+  adapt_threshold_kernel<<<1, 1, 0, stream>>>(ctx.threshold_.get_ptr(),
+                                              ctx.threshold_.get_ptr() + 1,
+                                              ctx.send_count_.get_ptr(),
+                                              static_cast<int>(capacity_), target);
+
+  auto& comm = gpu_resources_[device_id]->get_nccl();
+  HCTR_LIB_THROW(ncclGroupStart());
+  HCTR_LIB_THROW(ncclAllGather(ctx.send_count_.get_ptr(), ctx.recv_counts_.get_ptr(), 1, ncclInt,
+                               comm, stream));
+  HCTR_LIB_THROW(ncclAllGather(ctx.send_indices_.get_ptr(), ctx.recv_indices_.get_ptr(), capacity_,
+                               ncclUint32, comm, stream));
+  HCTR_LIB_THROW(ncclAllGather(ctx.send_values_.get_ptr(), ctx.recv_values_.get_ptr(), capacity_,
+                               NcclDataType<T>::getType(), comm, stream));
+  HCTR_LIB_THROW(ncclGroupEnd());
+
+  scatter_add_kernel<T>
+      <<<compress_grid_size(num_ranks_ * capacity_), COMPRESS_BLOCK_SIZE, 0, stream>>>(
+          ctx.wgrad_ptr, ctx.recv_indices_.get_ptr(), ctx.recv_values_.get_ptr(),
+          ctx.recv_counts_.get_ptr(), static_cast<int>(capacity_), num_ranks_);
+}
+
+template class WgradCompressor<__half>;
+template class WgradCompressor<float>;
+
+}  // namespace HugeCTR
@@ -16,7 +16,10 @@
 
 #include <omp.h>
 
+#include <algorithm>
+#include <core23/macros.hpp>
 #include <core23_network.hpp>
+#include <cstdlib>
 #include <io/filesystem.hpp>
 #include <network_helpers.hpp>
 #include <nlohmann/json.hpp>
@@ -39,6 +42,7 @@ Network::Network(const std::shared_ptr<CPUResource>& cpu_resource,
 // conditional weighted sum for each layer.  Then similarly compute the weighted sum of losses
 // associated with each layer
 void Network::train(int64_t current_batchsize) {
+  HCTR_NVTX_RANGE("network::train");
   // forward
   if (use_mixed_precision_) {
     conv_weight_(train_weight_tensor_half_, train_weight_tensor_);
@@ -64,6 +68,7 @@ void Network::train(int64_t current_batchsize) {
 }
 
 void Network::eval(int64_t current_batchsize) {
+  HCTR_NVTX_RANGE("network::eval");
   std::vector<Layer*> evaluate_layers_ptr;
   std::transform(evaluate_layers_.begin(), evaluate_layers_.end(),
                  std::back_inserter(evaluate_layers_ptr),
@@ -185,6 +190,16 @@ void Network::download_params_to_host(float* weight) {
   return;
 }
 
+void Network::download_opt_states_to_host(char* h_opt_states) {
+  CudaDeviceContext context(get_device_id());
+
+  if (opt_tensor_->empty()) {
+    return;
+  }
+  HCTR_LIB_THROW(cudaMemcpy(h_opt_states, opt_tensor_->data(), opt_tensor_->num_bytes(),
+                            cudaMemcpyDeviceToHost));
+}
+
 void Network::upload_params_to_device(float* params) {
   CudaDeviceContext context(get_device_id());
 
@@ -227,8 +242,74 @@ void Network::exchange_wgrad() {
   }
 }
 
+void* Network::get_top_wgrad_boundary() const {
+  if (top_layers_.empty() || bottom_layers_.empty()) {
+    return nullptr;
+  }
+  auto wgrad_span = [this](Layer* layer, const char*& lo, const char*& hi) {
+    std::vector<core23::Tensor> wgrads;
+    if (use_mixed_precision_) {
+      if (auto trainable = dynamic_cast<TrainableLayer<__half>*>(layer)) {
+        wgrads = trainable->get_wgrads();
+      } else if (auto trainable = dynamic_cast<TrainableLayer<__half, true>*>(layer)) {
+        wgrads = trainable->get_wgrads();
+      }
+    } else {
+      if (auto trainable = dynamic_cast<TrainableLayer<float>*>(layer)) {
+        wgrads = trainable->get_wgrads();
+      }
+    }
+    for (const auto& wgrad : wgrads) {
+      const char* base = static_cast<const char*>(wgrad.data());
+      lo = (lo == nullptr) ? base : std::min(lo, base);
+      hi = std::max(hi, base + wgrad.num_bytes());
+    }
+  };
+
+  const char* top_lo = nullptr;
+  const char* top_hi = nullptr;
+  for (auto* layer : top_layers_) {
+    wgrad_span(layer, top_lo, top_hi);
+  }
+  const char* bottom_lo = nullptr;
+  const char* bottom_hi = nullptr;
+  for (auto* layer : bottom_layers_) {
+    wgrad_span(layer, bottom_lo, bottom_hi);
+  }
+  if (top_lo == nullptr || bottom_hi == nullptr || bottom_hi > top_lo) {
+    return nullptr;
+  }
+  return const_cast<char*>(top_lo);
+}
+
 void Network::update_params() {
   optimizer_->update();
+
+  if (optimizer_->weights_sharded()) {
+    // ZeRO-1 sharding: each rank updated only its shard of the master weights, so
+    // gather the full weights before the next iteration reads them. A group of
+    // per-shard broadcasts handles the shorter tail shard without padding.
+    CudaDeviceContext context(get_device_id());
+    auto flat_weight_tensor = train_weight_tensor_->flatten();
+    float* weight = flat_weight_tensor.data();
+    const int64_t len = flat_weight_tensor.size(0);
+
+    int num_ranks = 1;
+    HCTR_LIB_THROW(ncclCommCount(gpu_resource_->get_nccl(), &num_ranks));
+    const int64_t shard_len = (len + num_ranks - 1) / num_ranks;
+
+    HCTR_LIB_THROW(ncclGroupStart());
+    for (int rank = 0; rank < num_ranks; ++rank) {
+      const int64_t start = std::min(static_cast<int64_t>(rank) * shard_len, len);
+      const int64_t count = std::min(shard_len, len - start);
+      if (count <= 0) {
+        continue;
+      }
+      HCTR_LIB_THROW(ncclBroadcast(weight + start, weight + start, count, ncclFloat, rank,
+                                   gpu_resource_->get_nccl(), gpu_resource_->get_stream()));
+    }
+    HCTR_LIB_THROW(ncclGroupEnd());
+  }
   return;
 }
 
@@ -372,14 +453,139 @@ void Network::conv_weight_(std::optional<core23::TensorContainer<__half, 1, 1>>&
                   gpu_resource_->get_stream());
 }
 
-void Network::prop_layers(const std::vector<Layer*>& layers, bool fprop, bool train) {
-  if (fprop) {
-    for (auto& layer : layers) {
+namespace {
+
+// Two layers conflict when any of their activation buffers overlap. Reads and writes are not
+// distinguished: gradients flow backwards through the same tensors in bprop, so any overlap
+// serializes the pair in graph order. A layer that registers no tensors with the base class
+// (some fused layers keep them privately) is treated as a full barrier.
+bool layers_conflict(const Layer* a, const Layer* b) {
+  auto spans_of = [](const Layer* layer) {
+    std::vector<std::pair<const char*, const char*>> spans;
+    for (const auto* tensors : {&layer->get_input_tensors(), &layer->get_output_tensors()}) {
+      for (const auto& tensor : *tensors) {
+        const char* base = static_cast<const char*>(tensor.data());
+        spans.emplace_back(base, base + tensor.num_bytes());
+      }
+    }
+    return spans;
+  };
+  auto spans_a = spans_of(a);
+  auto spans_b = spans_of(b);
+  if (spans_a.empty() || spans_b.empty()) {
+    return true;
+  }
+  for (const auto& sa : spans_a) {
+    for (const auto& sb : spans_b) {
+      if (sa.first < sb.second && sb.first < sa.second) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Longest-path levels over the conflict relation: layers within one level have disjoint
+// buffers and may run concurrently.
+std::vector<std::vector<int>> build_branch_levels(const std::vector<Layer*>& layers) {
+  std::vector<int> level(layers.size(), 0);
+  int num_levels = 0;
+  for (size_t i = 0; i < layers.size(); i++) {
+    for (size_t j = 0; j < i; j++) {
+      if (layers_conflict(layers[j], layers[i])) {
+        level[i] = std::max(level[i], level[j] + 1);
+      }
+    }
+    num_levels = std::max(num_levels, level[i] + 1);
+  }
+  std::vector<std::vector<int>> levels(num_levels);
+  for (size_t i = 0; i < layers.size(); i++) {
+    levels[level[i]].push_back(i);
+  }
+  return levels;
+}
+
+}  // namespace
+
+void Network::prop_layers(const std::vector<Layer*>& layers, bool fprop, bool train,
+                          bool need_input_grads) {
+  static const bool multi_stream_branches = [] {
+    const char* env = std::getenv("HCTR_MULTI_STREAM_BRANCHES");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  // Frozen-subgraph pruning: with the layers in topological order, the bprop of a leading
+  // frozen run only produces gradients for even lower layers and for the span input. When
+  // the caller guarantees nobody needs the latter (need_input_grads == false), that run
+  // can be dropped from the backward pass entirely. Frozen layers above the first
+  // trainable layer still run bprop to carry the chain rule down to it.
+  size_t bprop_begin = 0;
+  if (!fprop && !need_input_grads) {
+    while (bprop_begin < layers.size() && !layers[bprop_begin]->is_trainable()) {
+      bprop_begin++;
+    }
+  }
+  // The branch-parallel schedules are cached per span and would go stale if the pruned
+  // prefix changed between iterations, so a pruned backward pass always runs sequentially.
+  if (!multi_stream_branches || layers.empty() || bprop_begin > 0) {
+    if (fprop) {
+      for (auto& layer : layers) {
+        layer->fprop(train);
+      }
+    } else {
+      for (auto it = layers.rbegin(); it != layers.rend() - bprop_begin; it++) {
+        (*it)->bprop();
+      }
+    }
+    return;
+  }
+
+  std::vector<Layer*> ordered(layers);
+  if (!fprop) {
+    std::reverse(ordered.begin(), ordered.end());
+  }
+  auto key = std::make_pair(static_cast<const Layer*>(ordered.front()), fprop);
+  auto it = branch_schedules_.find(key);
+  if (it == branch_schedules_.end()) {
+    auto levels = build_branch_levels(ordered);
+    size_t max_width = 0;
+    for (const auto& level_ids : levels) {
+      max_width = std::max(max_width, level_ids.size());
+    }
+    HCTR_LOG_S(INFO, ROOT) << "Branch-parallel " << (fprop ? "fprop" : "bprop") << " schedule: "
+                           << ordered.size() << " layers in " << levels.size()
+                           << " levels (max width " << max_width << ")" << std::endl;
+    it = branch_schedules_.emplace(key, std::move(levels)).first;
+  }
+
+  auto run = [&](Layer* layer) {
+    if (fprop) {
       layer->fprop(train);
+    } else {
+      layer->bprop();
     }
-  } else {
-    for (auto it = layers.rbegin(); it != layers.rend(); it++) {
-      (*it)->bprop();
+  };
+  const cudaStream_t& main_stream = gpu_resource_->get_stream();
+  for (const auto& level_ids : it->second) {
+    if (level_ids.size() == 1) {
+      run(ordered[level_ids[0]]);
+      continue;
+    }
+    // Fork: side streams start after everything enqueued on the main stream so far; the first
+    // branch keeps the main stream so a two-way split costs one extra stream, not two.
+    const cudaEvent_t& fork_event = gpu_resource_->get_event("branch_fork");
+    HCTR_LIB_THROW(cudaEventRecord(fork_event, main_stream));
+    run(ordered[level_ids[0]]);
+    for (size_t j = 1; j < level_ids.size(); j++) {
+      const std::string stream_name = "graph_branch_" + std::to_string(j);
+      const cudaStream_t& side_stream = gpu_resource_->get_stream(stream_name);
+      HCTR_LIB_THROW(cudaStreamWaitEvent(side_stream, fork_event));
+      {
+        StreamContext context(gpu_resource_, stream_name);
+        run(ordered[level_ids[j]]);
+      }
+      const cudaEvent_t& join_event = gpu_resource_->get_event("branch_join_" + std::to_string(j));
+      HCTR_LIB_THROW(cudaEventRecord(join_event, side_stream));
+      HCTR_LIB_THROW(cudaStreamWaitEvent(main_stream, join_event));
     }
   }
 }
@@ -37,7 +37,8 @@ DataGeneratorParams::DataGeneratorParams(
     const std::vector<size_t>& slot_size_array, const std::vector<int>& nnz_array,
     Check_t check_type, Distribution_t dist_type, PowerLaw_t power_law_type, float alpha,
     int num_files, int eval_num_files, int num_samples_per_file, int num_samples,
-    int eval_num_samples, bool float_label_dense, int num_threads)
+    int eval_num_samples, bool float_label_dense, int num_threads,
+    const std::vector<float>& alpha_array)
     : format(format),
       label_dim(label_dim),
       dense_dim(dense_dim),
@@ -51,6 +52,7 @@ DataGeneratorParams::DataGeneratorParams(
       dist_type(dist_type),
       power_law_type(power_law_type),
       alpha(alpha),
+      alpha_array(alpha_array),
       num_files(num_files),
       eval_num_files(eval_num_files),
       num_samples_per_file(num_samples_per_file),
@@ -76,6 +78,17 @@ DataGeneratorParams::DataGeneratorParams(
   if (this->num_threads < 1) {
     HCTR_OWN_THROW(Error_t::WrongInput, "must have num_threads at least 1");
   }
+  if (!this->alpha_array.empty()) {
+    if (this->alpha_array.size() != static_cast<size_t>(num_slot)) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "alpha_array.size() should be equal to num_slot");
+    }
+    for (const float slot_alpha : this->alpha_array) {
+      if (slot_alpha > 0 && abs(slot_alpha - 1.0) < 1e-6) {
+        HCTR_OWN_THROW(Error_t::WrongInput,
+                       "per-slot alpha should not equal to 1.0 for power law distribution");
+      }
+    }
+  }
 }
 
 DataGenerator::~DataGenerator() {}
@@ -140,14 +153,14 @@ void DataGenerator::generate() {
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
           data_generation_for_test2<long long, Check_t::Sum>(
               data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
               data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
         } else {
           data_generation_for_test2<unsigned int, Check_t::Sum>(
               data_generator_params_.source, train_data_folder + "/train/gen_",
@@ -155,14 +168,14 @@ void DataGenerator::generate() {
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
           data_generation_for_test2<unsigned int, Check_t::Sum>(
               data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
               data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
         }
       } else {
         if (data_generator_params_.i64_input_key) {
@@ -172,14 +185,14 @@ void DataGenerator::generate() {
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
           data_generation_for_test2<long long, Check_t::None>(
               data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
               data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
         } else {
           data_generation_for_test2<unsigned int, Check_t::None>(
               data_generator_params_.source, train_data_folder + "/train/gen_",
@@ -187,14 +200,14 @@ void DataGenerator::generate() {
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
           data_generation_for_test2<unsigned int, Check_t::None>(
               data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
               data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
               data_generator_params_.num_slot, data_generator_params_.slot_size_array,
               data_generator_params_.label_dim, data_generator_params_.dense_dim,
               data_generator_params_.nnz_array, data_generator_params_.num_threads, use_long_tail,
-              alpha);
+              alpha, data_generator_params_.alpha_array);
         }
       }
       break;
@@ -261,27 +274,31 @@ void DataGenerator::generate() {
             data_generator_params_.num_files, data_generator_params_.num_samples_per_file,
             data_generator_params_.num_slot, data_generator_params_.label_dim,
             data_generator_params_.dense_dim, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha,
+            data_generator_params_.num_threads, data_generator_params_.alpha_array);
 
         data_generation_for_parquet<int64_t>(
             data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
             data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
             data_generator_params_.num_slot, data_generator_params_.label_dim,
             data_generator_params_.dense_dim, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha,
+            data_generator_params_.num_threads, data_generator_params_.alpha_array);
       } else {  // I32 = unsigned int
         data_generation_for_parquet<unsigned int>(
             data_generator_params_.source, train_data_folder + "/train/gen_",
             data_generator_params_.num_files, data_generator_params_.num_samples_per_file,
             data_generator_params_.num_slot, data_generator_params_.label_dim,
             data_generator_params_.dense_dim, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha,
+            data_generator_params_.num_threads, data_generator_params_.alpha_array);
         data_generation_for_parquet<unsigned int>(
             data_generator_params_.eval_source, eval_data_folder + "/val/gen_",
             data_generator_params_.eval_num_files, data_generator_params_.num_samples_per_file,
             data_generator_params_.num_slot, data_generator_params_.label_dim,
             data_generator_params_.dense_dim, data_generator_params_.slot_size_array,
-            data_generator_params_.nnz_array, use_long_tail, alpha);
+            data_generator_params_.nnz_array, use_long_tail, alpha,
+            data_generator_params_.num_threads, data_generator_params_.alpha_array);
       }
 #endif
       break;
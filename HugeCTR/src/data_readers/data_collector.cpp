@@ -98,7 +98,23 @@ DataCollector<T>::DataCollector(const std::vector<std::shared_ptr<ThreadBuffer23
       loop_flag_{true},
       last_batch_nnz_(
           broadcast_buffer->is_fixed_length.size() * resource_manager->get_local_gpu_count(), 0),
+      zero_copy_sparse_(std::getenv("HCTR_COLLECTOR_ZERO_COPY") != nullptr),
       resource_manager_(resource_manager) {
+  if (zero_copy_sparse_) {
+    // Alias the sparse output tensors to the broadcast buffers so downstream consumers
+    // (e.g. the DataDistributor) read the collected batch in place. The delay-release
+    // protocol guarantees the broadcast buffer is not rewritten before finalize_batch().
+    // Must run before consumers grab the output tensors, i.e. in the DataReader ctor.
+    size_t local_gpu_count = resource_manager_->get_local_gpu_count();
+    for (size_t i = 0; i < local_gpu_count; ++i) {
+      for (size_t param_id = 0; param_id < output_buffer23_->sparse_name_vec.size(); ++param_id) {
+        const auto &top_name = output_buffer23_->sparse_name_vec[param_id];
+        size_t idx_broadcast = i * broadcast_buffer_->param_num + param_id;
+        output_buffer23_->sparse_tensors_map[top_name][i] =
+            broadcast_buffer_->sparse_buffers[idx_broadcast];
+      }
+    }
+  }
   background_collector_thread_ = std::thread([this]() { background_collector_.start(); });
 }
 template <typename T>
@@ -132,7 +148,8 @@ long long DataCollector<T>::read_a_batch_to_device() {
       auto label_tensor = output_buffer23_->label_tensors[i];
       auto label_dense_tensor = broadcast_buffer_->dense_tensors[i];
 
-      for (size_t param_id = 0; param_id < output_buffer23_->sparse_name_vec.size(); ++param_id) {
+      for (size_t param_id = 0;
+           !zero_copy_sparse_ && param_id < output_buffer23_->sparse_name_vec.size(); ++param_id) {
         const auto &top_name = output_buffer23_->sparse_name_vec[param_id];
         int idx_broadcast = i * broadcast_buffer_->param_num + param_id;
         auto src_sparse_tensor = broadcast_buffer_->sparse_buffers[idx_broadcast];
@@ -273,13 +273,13 @@ void DataReader<TypeKey>::create_drwg_parquet(std::string file_list, bool strict
                                               const std::vector<long long> slot_offset,
                                               bool start_reading_from_beginning,
                                               long long max_samples_per_group, int label_dense_num,
-                                              int label_dense_dim) {
+                                              int label_dense_dim, bool shard_files_across_ranks) {
   source_type_ = SourceType_t::Parquet;
   // worker_group_.empty
   worker_group_.reset(new DataReaderWorkerGroupParquet<TypeKey>(
       thread_buffers_, file_list, strict_order_of_batches, repeat_, params_, slot_offset,
       data_source_params_, resource_manager_, start_reading_from_beginning, label_dense_num,
-      label_dense_dim, max_samples_per_group));
+      label_dense_dim, max_samples_per_group, shard_files_across_ranks));
 }
 #endif
 
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <cudf/strings/strings_column_view.hpp>
 #include <data_readers/dataframe_container.hpp>
 #include <fstream>
+#include <gpu_cache/include/hash_functions.cuh>
 #include <utils.hpp>
 namespace HugeCTR {
 
@@ -60,6 +62,81 @@ static void concat_offset(int32_t* lhs_offset, size_t len_l, const int32_t* rhs_
   vector_scalar_op<<<grid, block, 0, stream>>>(lhs_offset + len_l + 1, rhs_offset, len_r + 1,
                                                lhs_offset + len_l, add);
 }
+// MurmurHash3 x86_32 over a variable-length byte range. The MurmurHash3_32 in
+// gpu_cache/include/hash_functions.cuh hashes exactly sizeof(Key) bytes, so string payloads
+// need this length-driven body; the mixing primitives are shared with that implementation.
+__device__ static uint32_t murmur3_32_bytes(const char* data, int32_t len, uint32_t seed) {
+  using Mixer = MurmurHash3_32<uint32_t>;
+  constexpr uint32_t c1 = 0xcc9e2d51;
+  constexpr uint32_t c2 = 0x1b873593;
+  uint32_t h1 = seed;
+  const int32_t nblocks = len / 4;
+  for (int32_t i = 0; i < nblocks; i++) {
+    uint32_t k1;
+    // chars buffers carry no alignment guarantee
+    memcpy(&k1, data + i * 4, sizeof(uint32_t));
+    k1 *= c1;
+    k1 = Mixer::rotl32(k1, 15);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = Mixer::rotl32(h1, 13);
+    h1 = h1 * 5 + 0xe6546b64;
+  }
+  const uint8_t* tail = reinterpret_cast<const uint8_t*>(data + nblocks * 4);
+  uint32_t k1 = 0;
+  switch (len & 3) {
+    case 3:
+      k1 ^= tail[2] << 16;
+    case 2:
+      k1 ^= tail[1] << 8;
+    case 1:
+      k1 ^= tail[0];
+      k1 *= c1;
+      k1 = Mixer::rotl32(k1, 15);
+      k1 *= c2;
+      h1 ^= k1;
+  };
+  h1 ^= len;
+  return Mixer::fmix32(h1);
+}
+
+// One thread per string: hash the bytes [offsets[i], offsets[i+1]) of the cudf chars buffer
+// into a categorical key. 64-bit key types combine two differently seeded hashes so the key
+// space is not capped at 2^32.
+template <typename T>
+__global__ void string_to_hash_kernel(const char* chars, const int32_t* offsets,
+                                      size_t num_strings, T* keys) {
+  uint32_t gtid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (gtid < num_strings) {
+    const int32_t begin = offsets[gtid];
+    const int32_t len = offsets[gtid + 1] - begin;
+    const uint32_t lo = murmur3_32_bytes(chars + begin, len, 0);
+    if (sizeof(T) == 8) {
+      const uint32_t hi = murmur3_32_bytes(chars + begin, len, 0x9747b28c);
+      keys[gtid] = static_cast<T>((static_cast<uint64_t>(hi) << 32) | lo);
+    } else {
+      keys[gtid] = static_cast<T>(lo);
+    }
+  }
+}
+
+// Hash every entry of a cudf string column into keys_out, entirely in device memory.
+template <typename T>
+static void string_keys_from_cudf(const cudf::column_view& str_col, T* keys_out,
+                                  cudaStream_t stream) {
+  const size_t num_strings = str_col.size();
+  if (num_strings == 0) {
+    return;
+  }
+  cudf::strings_column_view str_view(str_col);
+  const uint32_t block_size = 256;
+  dim3 block(block_size, 1, 1);
+  dim3 grid((num_strings + block.x - 1) / block.x, 1, 1);
+  string_to_hash_kernel<<<grid, block, 0, stream>>>(str_view.chars().data<char>(),
+                                                    str_view.offsets().data<int32_t>(), num_strings,
+                                                    keys_out);
+}
+
 // max sparse bytes is induced from max_sparse_size
 // max_dense_size should be read from row_group_reading_thread
 template <typename T>
@@ -608,6 +685,22 @@ void dump_table_data_to(cudf::table_view& table_view, std::map<int, int>& dense_
       if ((static_cast<size_t>(row_offset_view.size()) != (num_rows + 1))) {
         HCTR_OWN_THROW(Error_t::WrongInput, "Parquet Rows not consistent");
       }
+      if (val_id == cudf::type_to_id<cudf::string_view>()) {
+        // String categoricals are hashed into keys on device. Unlike the numeric branches,
+        // the destination is the container-owned slab assigned by reset_ptrs(), since the
+        // cudf buffer holds characters, not keys; the row offsets stay shallow.
+        const size_t num_keys = value_view.size();
+        if (num_keys > df_ptrs_dst->max_rows_ * df_ptrs_dst->max_sparse_size_[col]) {
+          HCTR_OWN_THROW(Error_t::WrongInput, "Parquet string cat exceeds slot capacity");
+        }
+        string_keys_from_cudf(value_view, df_ptrs_dst->sparse_ptr_[col],
+                              df_ptrs_dst->get_copy_stream());
+        df_ptrs_dst->sparse_offset_ptr_[col] =
+            const_cast<int32_t*>(row_offset_view.data<int32_t>());
+        df_ptrs_dst->sparse_size_[col] = num_keys;
+        df_ptrs_dst->sparse_size_bytes_[col] = num_keys * sizeof(T);
+        continue;
+      }
       if (val_id != cudf::type_to_id<int32_t>() && val_id != cudf::type_to_id<int64_t>() &&
           val_id != cudf::type_to_id<uint32_t>() && val_id != cudf::type_to_id<uint64_t>()) {
         HCTR_LOG_S(ERROR, WORLD) << "Parquet worker : cat m-hot KeyType should "
@@ -630,6 +723,15 @@ void dump_table_data_to(cudf::table_view& table_view, std::map<int, int>& dense_
       sparse_nnz_array[col] = 1;
       one_hot_slot_id.push_back((int)(col));
       cudf::type_id val_id = col_view.type().id();
+      if (val_id == cudf::type_to_id<cudf::string_view>()) {
+        // One-hot string categorical: one hashed key per row, written to the owned slab.
+        string_keys_from_cudf(col_view, df_ptrs_dst->sparse_ptr_[col],
+                              df_ptrs_dst->get_copy_stream());
+        df_ptrs_dst->sparse_offset_ptr_[col] = nullptr;
+        df_ptrs_dst->sparse_size_[col] = num_rows;
+        df_ptrs_dst->sparse_size_bytes_[col] = num_rows * sizeof(T);
+        continue;
+      }
       if (val_id != cudf::type_to_id<int32_t>() && val_id != cudf::type_to_id<int64_t>() &&
           val_id != cudf::type_to_id<uint32_t>() && val_id != cudf::type_to_id<uint64_t>()) {
         HCTR_LOG_S(ERROR, WORLD) << "Parquet worker : cat s-hot KeyType should "
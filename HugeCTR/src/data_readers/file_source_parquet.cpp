@@ -37,6 +37,16 @@ ParquetFileSource::ParquetFileSource(unsigned int worker_id, unsigned int stride
       sequential_file_consumption_(sequtial_file_consumption) {
   slice_stream_ = NULL;
   file_loader_ = std::make_unique<FileLoader>(data_source_params);
+  // GDS mode hands the file path to cudf so column chunks are DMA-transferred from NVMe
+  // into device memory through cuFile, bypassing the host staging buffer. Only local
+  // files can be registered with cuFile.
+  use_gds_ = (std::getenv("HCTR_PARQUET_GDS") != nullptr) &&
+             (data_source_params.type == FileSystemType_t::Local);
+  if (std::getenv("HCTR_PARQUET_GDS") && !use_gds_) {
+    HCTR_LOG(WARNING, ROOT,
+             "HCTR_PARQUET_GDS is only supported on the local file system; falling back to "
+             "host-staged reads\n");
+  }
   // load _metadata.json
   std::string metadata_file_name = get_metada_filename(file_list_.get_a_file_with_id(0, true));
   if (!(file_metadata_.get_metadata_status())) {
@@ -118,13 +128,29 @@ Error_t ParquetFileSource::next_source(long long expected_num_row_group) noexcep
     if (res != Error_t::Success) {
       HCTR_OWN_THROW(res, "Library Dependency Error. Rebuild with Arrow::Parquet Library");
     }
-    // check if file exists
-    Error_t err = file_loader_->load(file_name_);
-    if (err != Error_t::Success) {
-      return err;
+    if (use_gds_) {
+      // cudf opens the file through its cuFile datasource: column chunks are DMA'ed
+      // device-side at read_group() time and nothing is staged in host memory.
+      std::string local_path = file_name_;
+      auto first_colon = local_path.find_first_of(":");
+      if (first_colon != std::string::npos) {
+        local_path.erase(0, first_colon + 1);
+      }
+      parquet_args_ =
+          cudf_io::parquet_reader_options::builder(cudf_io::source_info{local_path});
+    } else {
+      // check if file exists
+      Error_t err = file_loader_->load(file_name_);
+      if (err != Error_t::Success) {
+        return err;
+      }
+      parquet_args_ = cudf_io::parquet_reader_options::builder(cudf_io::source_info{
+          file_loader_->get_loaded_data(), file_loader_->get_current_file_size()});
+    }
+    if (file_metadata_.has_column_projection()) {
+      // cudf skips the column chunks of unreferenced columns entirely
+      parquet_args_.set_columns(file_metadata_.get_projected_column_names());
     }
-    parquet_args_ = cudf_io::parquet_reader_options::builder(cudf_io::source_info{
-        file_loader_->get_loaded_data(), file_loader_->get_current_file_size()});
     curr_row_idx_ = 0;  // set row to zero id
     row_group_index_ = 0;
     row_group_offset_ = 0;
@@ -136,6 +162,10 @@ Error_t ParquetFileSource::next_source(long long expected_num_row_group) noexcep
   }
 }
 bool ParquetFileSource::is_open() noexcept { return can_read_file_; }
+
+void ParquetFileSource::set_column_projection(size_t num_used_slots) {
+  file_metadata_.resolve_column_projection(num_used_slots);
+}
 cudf_io::table_with_metadata ParquetFileSource::read_group(size_t row_group_id,
                                                            rmm::mr::device_memory_resource* mr) {
   nvtxRangePushA("load_DF");
@@ -182,6 +212,23 @@ cudf_io::table_with_metadata ParquetFileSource::read_group(size_t row_group_id,
   return tbl_w_metadata;
 }
 
+void ParquetFileSource::skip_group(size_t row_group_id) {
+  if (!counter_) {
+    HCTR_OWN_THROW(Error_t::UnspecificError, "Read parquet file first\n");
+  }
+  curr_row_group_ = row_group_id;
+  if (sequential_file_consumption_) {
+    file_name_ = file_list_.get_a_file_with_id(counter_ - 1, repeat_);
+  } else {
+    file_name_ = file_list_.get_a_file_with_id(offset_ + (counter_ - 1) * stride_, repeat_);
+  }
+  std::vector<long long> row_groups_offset =
+      file_metadata_.get_file_stats(get_filename(file_name_)).row_groups_offset;
+  // always points to next ready-to-read row
+  curr_row_idx_ = row_groups_offset[row_group_id + 1];
+  curr_row_group_++;
+}
+
 const Metadata& ParquetFileSource::get_file_metadata() { return file_metadata_; }
 int ParquetFileSource::get_cur_file_id() {
   // counter_ always points to the next file to be read
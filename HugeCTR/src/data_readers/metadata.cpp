@@ -22,6 +22,7 @@
 #endif
 
 #include <iostream>
+#include <map>
 #include <nlohmann/json.hpp>
 
 namespace HugeCTR {
@@ -34,6 +35,51 @@ void Metadata::reset_metadata(std::string file_name) {
   num_rows_total_files_ = 0;
   rows_file_offset_.clear();
   get_parquet_metadata(file_name);
+  // re-derive the projection from the freshly parsed schema
+  if (projected_num_slots_ > 0) {
+    size_t num_used_slots = projected_num_slots_;
+    projected_col_names_.clear();
+    projected_col_index_.clear();
+    projected_num_slots_ = 0;
+    resolve_column_projection(num_used_slots);
+  }
+}
+
+void Metadata::resolve_column_projection(size_t num_used_slots) {
+  if (!loaded_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall, "Please load _metadata.json first\n");
+  }
+  if (projected_num_slots_ == num_used_slots && !projected_col_names_.empty()) {
+    return;  // already resolved; reused across the files of the list
+  }
+  projected_col_names_.clear();
+  projected_col_index_.clear();
+  // label, dense and the first num_used_slots cat columns, each group in
+  // parquet-index order: the same order read_new_file() walks when building
+  // the slot -> column maps, so projected positions line up with the remap
+  std::map<int, std::string> index_to_name;
+  for (auto& c : label_names_) {
+    index_to_name.insert(std::make_pair(c.index, c.col_name));
+  }
+  for (auto& c : cont_names_) {
+    index_to_name.insert(std::make_pair(c.index, c.col_name));
+  }
+  std::map<int, std::string> cat_index_to_name;
+  for (auto& c : cat_names_) {
+    cat_index_to_name.insert(std::make_pair(c.index, c.col_name));
+  }
+  size_t slot = 0;
+  for (auto it = cat_index_to_name.begin(); it != cat_index_to_name.end() && slot < num_used_slots;
+       it++, slot++) {
+    index_to_name.insert(*it);
+  }
+  int projected_pos = 0;
+  for (auto& entry : index_to_name) {
+    projected_col_index_.insert(std::make_pair(entry.first, projected_pos));
+    projected_col_names_.push_back(entry.second);
+    projected_pos++;
+  }
+  projected_num_slots_ = num_used_slots;
 }
 // filename is xxxx/_metadata.json
 void Metadata::get_parquet_metadata(std::string file_name) {
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <common.hpp>
 #include <core23/tensor.hpp>
 #include <data_reader.hpp>
+#include <random>
 #include <data_readers/multi_hot/async_data_reader.hpp>
 #include <data_readers/multi_hot/async_reader_common.hpp>
 #include <data_readers/multi_hot/split_batch.hpp>
@@ -44,6 +46,7 @@ AsyncDataReader<SparseType>::AsyncDataReader(
       s3w_streams_(resource_manager->get_local_gpu_count()),
       d2d_streams_(resource_manager->get_local_gpu_count()),
       cache_buffers_(false),
+      shuffle_samples_(shuffle),
       is_dense_float_(is_dense_float) {
   assert(batch_size_ % resource_manager_->get_global_gpu_count() == 0);
   assert(params.size() == 1);
@@ -120,9 +123,24 @@ AsyncDataReader<SparseType>::AsyncDataReader(
     bucket_position_tensors_.emplace_back(bucket_position_tensor);
     max_hotness_tensors_.emplace_back(max_hotness_tensor);
 
-    // set default stream
-    s3w_streams_[i] = local_gpu->get_stream();
-    d2d_streams_[i] = local_gpu->get_stream();
+    if (shuffle_samples_) {
+      sample_perm_tensors_.emplace_back(
+          core23::TensorParams()
+              .shape({static_cast<int64_t>(batch_size_per_dev_)})
+              .data_type(core23::ScalarType::Int32)
+              .device({core23::DeviceType::GPU, static_cast<int8_t>(gpu_id)}));
+      h_sample_perm_tensors_.emplace_back(core23::TensorParams()
+                                              .shape({static_cast<int64_t>(batch_size_per_dev_)})
+                                              .data_type(core23::ScalarType::Int32)
+                                              .device(core23::DeviceType::CPU));
+    }
+
+    // dedicated high-priority side streams so split_3_way and the label/dense D2D overlap
+    // with the iteration's compute work instead of serializing on the compute stream.
+    // Consumers order against them through the "sparse_tensors_ready" /
+    // "bottom_MLP_tensors_ready" events (see stream_wait_*_tensors and ready_to_collect).
+    s3w_streams_[i] = local_gpu->get_high_priority_stream("s3w");
+    d2d_streams_[i] = local_gpu->get_high_priority_stream("s3w_d2d");
     int64_t bytes = batch_size_per_dev_ *
                     (label_dim * sizeof(LabelType) +
                      dense_dim_align8 * (mixed_precision ? sizeof(__half) : sizeof(float)));
@@ -292,6 +310,20 @@ long long AsyncDataReader<SparseType>::read_a_batch_to_device_delay_release() {
         auto ptr_wrap = std::make_shared<RawPtrWrapper>(
             reinterpret_cast<InputType*>(batch.get_device_data(i, slot_id)));
 
+        core23::Tensor sample_perm;
+        if (shuffle_samples_) {
+          // fresh permutation per batch and device; seeded deterministically so a rerun
+          // of the same dataset produces the same sample order
+          std::mt19937 gen(current_batch_id * num_local_gpus + i);
+          int* h_perm = h_sample_perm_tensors_[i].data<int>();
+          std::iota(h_perm, h_perm + current_batch_size_per_device, 0);
+          std::shuffle(h_perm, h_perm + current_batch_size_per_device, gen);
+          HCTR_LIB_THROW(cudaMemcpyAsync(sample_perm_tensors_[i].data(), h_perm,
+                                         current_batch_size_per_device * sizeof(int),
+                                         cudaMemcpyHostToDevice, stream));
+          sample_perm = sample_perm_tensors_[i];
+        }
+
         if (mixed_precision_) {
           split_3_way_feat_major<__half, SparseType>(
               batch_tensors.label_tensors[i], batch_tensors.dense_tensors[i],
@@ -303,7 +335,7 @@ long long AsyncDataReader<SparseType>::read_a_batch_to_device_delay_release() {
                   core23::ToScalarType<InputType>::value,
                   core23::Device(core23::DeviceType::GPU, static_cast<int8_t>(gpu_id))),
               bucket_id_tensors_[i], bucket_position_tensors_[i], max_hotness_tensors_[i], stream,
-              is_dense_float_);
+              is_dense_float_, sample_perm);
         } else {
           split_3_way_feat_major<float, SparseType>(
               batch_tensors.label_tensors[i], batch_tensors.dense_tensors[i],
@@ -315,7 +347,7 @@ long long AsyncDataReader<SparseType>::read_a_batch_to_device_delay_release() {
                   core23::ToScalarType<InputType>::value,
                   core23::Device(core23::DeviceType::GPU, static_cast<int8_t>(gpu_id))),
               bucket_id_tensors_[i], bucket_position_tensors_[i], max_hotness_tensors_[i], stream,
-              is_dense_float_);
+              is_dense_float_, sample_perm);
         }
       }
     }
@@ -405,7 +437,17 @@ bool AsyncDataReader<SparseType>::current_batch_incomplete() const {
 
 template <typename SparseType>
 void AsyncDataReader<SparseType>::ready_to_collect() {
-  // nothing to do, already released
+  // the split and the label/dense D2D were issued on the side streams; make the compute
+  // stream wait on their completion events so non-scheduled consumers stay ordered.
+  // Scheduled pipelines additionally wait via stream_wait_sparse/dense_tensors.
+  for (size_t i = 0; i < resource_manager_->get_local_gpu_count(); i++) {
+    auto local_gpu = resource_manager_->get_local_gpu(i);
+    CudaDeviceContext ctx(local_gpu->get_device_id());
+    HCTR_LIB_THROW(cudaStreamWaitEvent(local_gpu->get_stream(),
+                                       local_gpu->get_event("sparse_tensors_ready")));
+    HCTR_LIB_THROW(cudaStreamWaitEvent(local_gpu->get_stream(),
+                                       local_gpu->get_event("bottom_MLP_tensors_ready")));
+  }
 }
 
 template <typename SparseType>
@@ -488,8 +530,59 @@ bool AsyncDataReader<SparseType>::is_started() const {
 }
 template <typename SparseType>
 void AsyncDataReader<SparseType>::start() {
+  install_upload_filter_();
   reader_impl_->start();
 }
+
+template <typename SparseType>
+void AsyncDataReader<SparseType>::set_required_sparse_features(
+    const std::vector<int>& feature_ids) {
+  if (required_sparse_features_.empty()) {
+    required_sparse_features_.resize(sparse_dim_, false);
+  }
+  for (int fea_id : feature_ids) {
+    HCTR_CHECK_HINT(fea_id >= 0 && fea_id < static_cast<int>(sparse_dim_),
+                    "invalid sparse feature id %d", fea_id);
+    required_sparse_features_[fea_id] = true;
+  }
+}
+
+template <typename SparseType>
+void AsyncDataReader<SparseType>::install_upload_filter_() {
+  if (required_sparse_features_.empty() ||
+      std::all_of(required_sparse_features_.begin(), required_sparse_features_.end(),
+                  [](bool required) { return required; })) {
+    return;  // the whole batch is consumed; keep the plain upload path
+  }
+
+  // Labels and dense features occupy the sample head and always survive; a sparse bucket
+  // survives only when some registered consumer references it. Adjacent surviving regions
+  // are merged so the gather runs on as few, as wide memcpys as possible.
+  const size_t label_dense_bytes = (label_dim_ + dense_dim_) * sizeof(InputType);
+  std::vector<std::pair<size_t, size_t>> keep_ranges{{0, label_dense_bytes}};
+  size_t offset = label_dense_bytes;
+  for (size_t fea_id = 0; fea_id < sparse_dim_; ++fea_id) {
+    const size_t bucket_bytes = static_cast<size_t>(nnz_per_slot_[fea_id]) * sizeof(SparseType);
+    if (required_sparse_features_[fea_id]) {
+      auto& last = keep_ranges.back();
+      if (last.first + last.second == offset) {
+        last.second += bucket_bytes;
+      } else {
+        keep_ranges.emplace_back(offset, bucket_bytes);
+      }
+    }
+    offset += bucket_bytes;
+  }
+
+  size_t kept_bytes = 0;
+  for (const auto& range : keep_ranges) {
+    kept_bytes += range.second;
+  }
+  const size_t raw_bytes = sample_size_items_ * sizeof(InputType);
+  reader_impl_->set_sample_filter(keep_ranges, raw_bytes, batch_size_per_dev_);
+  HCTR_LOG_S(INFO, ROOT) << "Filtered upload enabled: " << kept_bytes << " / " << raw_bytes
+                         << " bytes per sample reach the GPUs" << std::endl;
+}
 template <typename SparseType>
 std::vector<core23::Tensor> AsyncDataReader<SparseType>::get_dense_tensor23s() const {
   return dense_tensors_;
@@ -523,7 +616,8 @@ void AsyncDataReader<SparseType>::create_drwg_parquet(std::string file_list,
                                                       const std::vector<long long> slot_offset,
                                                       bool start_reading_from_beginning,
                                                       long long max_samples_per_group,
-                                                      int label_dense_num, int label_dense_dim) {}
+                                                      int label_dense_num, int label_dense_dim,
+                                                      bool shard_files_across_ranks) {}
 #endif
 template <typename SparseType>
 void AsyncDataReader<SparseType>::set_source(std::string file_list) {}
@@ -21,6 +21,19 @@
 #include <common.hpp>
 #include <data_readers/multi_hot/detail/aio_context.hpp>
 #include <data_readers/multi_hot/detail/batch_file_reader.hpp>
+#include <data_readers/multi_hot/detail/io_uring_context.hpp>
+
+namespace {
+
+std::unique_ptr<HugeCTR::IOContext> make_io_context(size_t io_depth) {
+#ifdef ENABLE_IO_URING
+  return std::make_unique<HugeCTR::IOUringContext>(io_depth);
+#else
+  return std::make_unique<HugeCTR::AIOContext>(io_depth);
+#endif
+}
+
+}  // namespace
 
 namespace HugeCTR {
 
@@ -33,7 +46,7 @@ BatchFileReader::BatchFileReader(const std::string& fname, size_t slot, size_t m
       free_batches_(max_batches_inflight_),
       batch_locations_(std::move(batch_locations)),
       batch_locations_iterator_(batch_locations_->begin()),
-      io_ctx_(new AIOContext(max_batches_inflight_)),
+      io_ctx_(make_io_context(max_batches_inflight_)),
       buf_size_(batch_locations_->get_batch_size_bytes() + io_ctx_->get_alignment()) {
   tmp_completed_batches_.reserve(max_batches_inflight_);
   empty_batches_.reserve(max_batches_inflight_);
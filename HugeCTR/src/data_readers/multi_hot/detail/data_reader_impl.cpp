@@ -108,22 +108,20 @@ DataReaderImpl::DataReaderImpl(const std::vector<FileSource>& source_files,
   pending_transfers_.resize(resource_manager->get_local_gpu_count());
 
   for (size_t i = 0; i < resource_manager->get_local_gpu_count(); ++i) {
-    CudaCPUDeviceContext ctx(resource_manager->get_local_gpu(i)->get_device_id());
-    cudaStream_t stream;
-    // Needs to be highest priority to ensure transfers get executed as soon as they are unblocked
-    HCTR_LIB_THROW(cudaStreamCreateWithPriority(&stream, cudaStreamNonBlocking, -100));
-    placement_streams_.push_back(stream);
+    auto local_gpu = resource_manager->get_local_gpu(i);
+    CudaCPUDeviceContext ctx(local_gpu->get_device_id());
+    // Needs to be highest priority to ensure transfers get executed as soon as they are
+    // unblocked; the release callbacks are background work and go to the low pool.
+    // Both streams are owned by the GPUResource stream pools.
+    placement_streams_.push_back(local_gpu->get_high_priority_stream("batch_placement"));
+    callback_streams_.push_back(local_gpu->get_low_priority_stream("batch_release_callback"));
 
     cudaEvent_t event;
     HCTR_LIB_THROW(cudaEventCreate(&event));
     placement_events_.push_back(event);
 
-    cudaStream_t cb_stream;
     cudaEvent_t cb_event;
-    HCTR_LIB_THROW(cudaStreamCreateWithFlags(&cb_stream, cudaStreamNonBlocking));
     HCTR_LIB_THROW(cudaEventCreate(&cb_event));
-
-    callback_streams_.push_back(cb_stream);
     callback_events_.push_back(cb_event);
   }
 }
@@ -158,6 +156,36 @@ std::unique_ptr<IBatchLocations> DataReaderImpl::configure_locations(FileSource
   return locations;
 }
 
+void DataReaderImpl::set_sample_filter(
+    const std::vector<std::pair<size_t, size_t>>& keep_ranges, size_t raw_sample_size_bytes,
+    size_t max_samples_per_shard) {
+  HCTR_CHECK_HINT(!running_, "sample filter must be configured before start()");
+  HCTR_CHECK_HINT(!keep_ranges.empty(), "sample filter requires at least one keep range");
+  HCTR_CHECK_HINT(sample_filters_.empty(), "sample filter has already been configured");
+
+  size_t kept_bytes = 0;
+  for (const auto& range : keep_ranges) {
+    HCTR_CHECK_HINT(range.first + range.second <= raw_sample_size_bytes,
+                    "sample filter range exceeds the sample size");
+    kept_bytes += range.second;
+  }
+  if (kept_bytes == raw_sample_size_bytes) {
+    return;  // everything survives; the plain upload path is strictly better
+  }
+
+  sample_filters_.resize(resource_manager_->get_local_gpu_count());
+  for (size_t i = 0; i < sample_filters_.size(); ++i) {
+    CudaDeviceContext ctx(resource_manager_->get_local_gpu(i)->get_device_id());
+    auto& filter = sample_filters_[i];
+    filter.keep_ranges = keep_ranges;
+    filter.raw_sample_size_bytes = raw_sample_size_bytes;
+    filter.kept_sample_size_bytes = kept_bytes;
+    const size_t staging_bytes = max_samples_per_shard * kept_bytes;
+    HCTR_LIB_THROW(cudaHostAlloc(&filter.h_staging, staging_bytes, cudaHostAllocDefault));
+    HCTR_LIB_THROW(cudaMalloc(&filter.d_staging, staging_bytes));
+  }
+}
+
 void DataReaderImpl::start() {
   running_ = true;
   for (const auto& entry : file_readers_) {
@@ -257,10 +285,12 @@ void DataReaderImpl::read_batches(BatchFileReader& file_reader, int device_id) {
       DeviceTransfer* transfer = nullptr;
       if (io_batch->shard_size_bytes > 0)  // incomplete batch may not have local batch on all GPUs
       {
-        transfer = new DeviceTransfer(device_id,
-                                      io_batch->data,                              // src
-                                      local_batch.device_data[io_batch->slot_id],  // dst
-                                      io_batch->shard_size_bytes);
+        transfer = new DeviceTransfer(
+            device_id,
+            io_batch->data,                              // src
+            local_batch.device_data[io_batch->slot_id],  // dst
+            io_batch->shard_size_bytes,
+            sample_filters_.empty() ? nullptr : &sample_filters_[device_id]);
       }
 
       size_t buf_idx = local_batch.num_transfers++;  // atomic
@@ -350,8 +380,6 @@ void DataReaderImpl::upload_batches(size_t device_id) {
       std::this_thread::yield();
     }
   }
-
-  HCTR_LIB_THROW(cudaStreamDestroy(stream));
 }
 
 void DataReaderImpl::release_batch_callback(cudaStream_t stream, cudaError_t status,
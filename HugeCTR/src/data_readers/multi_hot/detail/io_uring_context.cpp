@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_IO_URING
+
+#include <cassert>
+#include <cstring>
+#include <data_readers/multi_hot/detail/io_uring_context.hpp>
+#include <stdexcept>
+
+namespace HugeCTR {
+
+#define round_up(x, y) ((((x) + ((y)-1)) / (y)) * (y))
+
+IOUringContext::IOUringContext(size_t io_depth) : io_depth_(io_depth) {
+  tmp_events_.reserve(io_depth);
+
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  // Let the kernel reap NVMe completions from interrupt context so collect() can often
+  // return events without a syscall.
+  int ret = io_uring_queue_init_params(io_depth, &ring_, &params);
+  if (ret < 0) {
+    throw std::runtime_error("io_uring_queue_init failed: " + std::string(strerror(-ret)));
+  }
+}
+
+IOUringContext::~IOUringContext() {
+  // app can't exit with IO requests in-flight
+  (void)collect(num_inflight_, 1e6);  // wait 1s
+  assert(num_inflight_ == 0);
+  io_uring_queue_exit(&ring_);
+}
+
+void IOUringContext::submit(const IORequest& request) {
+  io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  assert(sqe);
+
+  // For O_DIRECT, offsets and sizes need to be aligned
+  size_t aligned_offset = (request.offset / get_alignment()) * get_alignment();
+  size_t size = round_up(request.size + (request.offset - aligned_offset), get_alignment());
+
+  io_uring_prep_read(sqe, request.fd, request.data, size, aligned_offset);
+  io_uring_sqe_set_data(sqe, request.user_data);
+  num_unsubmitted_++;
+
+  // Flush the whole SQ in one syscall once the caller has queued a full batch, instead of
+  // one io_submit per request like the AIO path.
+  if (num_unsubmitted_ == io_depth_ - num_inflight_) {
+    int ret = io_uring_submit(&ring_);
+    if (ret < 0) {
+      throw std::runtime_error("io_uring_submit failed: " + std::string(strerror(-ret)));
+    }
+    num_inflight_ += num_unsubmitted_;
+    num_unsubmitted_ = 0;
+  }
+}
+
+const std::vector<IOEvent>& IOUringContext::collect(size_t min_reqs, size_t timeout_us) {
+  if (num_unsubmitted_ > 0) {
+    int ret = io_uring_submit(&ring_);
+    if (ret < 0) {
+      throw std::runtime_error("io_uring_submit failed: " + std::string(strerror(-ret)));
+    }
+    num_inflight_ += num_unsubmitted_;
+    num_unsubmitted_ = 0;
+  }
+
+  min_reqs = std::min(min_reqs, num_inflight_);
+
+  if (min_reqs > 0) {
+    __kernel_timespec timeout = {0, (long long)timeout_us * 1000};
+    io_uring_cqe* cqe = nullptr;
+    int ret = io_uring_wait_cqes(&ring_, &cqe, min_reqs, &timeout, nullptr);
+    if (ret < 0 && ret != -ETIME) {
+      throw std::runtime_error("io_uring_wait_cqes failed: " + std::string(strerror(-ret)));
+    }
+  }
+
+  tmp_events_.clear();
+
+  io_uring_cqe* cqe = nullptr;
+  while (tmp_events_.size() < io_depth_ && io_uring_peek_cqe(&ring_, &cqe) == 0) {
+    if (cqe->res < 0 && cqe->res != -EAGAIN) {
+      throw std::runtime_error("io_uring returned failed event: " +
+                               std::string(strerror(-cqe->res)));
+    }
+
+    IOEvent event;
+    event.error = cqe->res < 0 ? errno_to_enum(-cqe->res) : IOError::IO_SUCCESS;
+    event.user_data = io_uring_cqe_get_data(cqe);
+
+    tmp_events_.emplace_back(event);
+
+    io_uring_cqe_seen(&ring_, cqe);
+    num_inflight_--;
+  }
+
+  return tmp_events_;
+}
+
+IOError IOUringContext::errno_to_enum(int err) {
+  switch (err) {
+    case 0:
+      return IOError::IO_SUCCESS;
+    case EAGAIN:
+      return IOError::IO_EAGAIN;
+    case EBADF:
+      return IOError::IO_EBADF;
+    case EFAULT:
+      return IOError::IO_EFAULT;
+    case EINVAL:
+      return IOError::IO_EINVAL;
+    case EINTR:
+      return IOError::IO_EINTR;
+    default:
+      return IOError::IO_UNKNOWN;
+  }
+}
+
+size_t IOUringContext::get_alignment() const {
+  return 4096;  // O_DIRECT requirement
+}
+
+}  // namespace HugeCTR
+
+#endif  // ENABLE_IO_URING
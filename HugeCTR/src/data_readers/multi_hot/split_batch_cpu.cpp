@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <data_readers/multi_hot/split_batch.hpp>
+
+namespace HugeCTR {
+
+namespace {
+
+#if defined(__AVX512F__)
+
+// log(x) for x >= 0.5 via AVX-512 getexp/getmant: x = m * 2^e with
+// m in [0.75, 1.5), so log(x) = e * ln(2) + log(m) with log(m) approximated
+// by the cephes logf polynomial in f = m - 1.
+inline __m512 avx512_log_ps(__m512 x) {
+  __m512 e = _mm512_getexp_ps(x);
+  __m512 m = _mm512_getmant_ps(x, _MM_MANT_NORM_p75_1p5, _MM_MANT_SIGN_src);
+  // getmant halves mantissas in [1.5, 2); the true exponent is then e + 1
+  __mmask16 adjust = _mm512_cmp_ps_mask(m, _mm512_set1_ps(1.0f), _CMP_LT_OQ);
+  e = _mm512_mask_add_ps(e, adjust, e, _mm512_set1_ps(1.0f));
+
+  __m512 f = _mm512_sub_ps(m, _mm512_set1_ps(1.0f));
+  __m512 z = _mm512_mul_ps(f, f);
+
+  __m512 p = _mm512_set1_ps(7.0376836292e-2f);
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(-1.1514610310e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(1.1676998740e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(-1.2420140846e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(1.4249322787e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(-1.6668057665e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(2.0000714765e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(-2.4999993993e-1f));
+  p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(3.3333331174e-1f));
+  p = _mm512_mul_ps(_mm512_mul_ps(p, f), z);
+  p = _mm512_fmadd_ps(z, _mm512_set1_ps(-0.5f), p);
+
+  __m512 result = _mm512_add_ps(f, p);
+  result = _mm512_fmadd_ps(e, _mm512_set1_ps(0.6931471805599453f), result);
+  return result;
+}
+
+template <typename DenseType>
+inline void avx512_store_dense(DenseType* out, __m512 v) {
+  if constexpr (std::is_same<DenseType, __half>::value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  } else {
+    _mm512_storeu_ps(reinterpret_cast<float*>(out), v);
+  }
+}
+
+#endif  // __AVX512F__
+
+// Convert one row of dense features: int32 columns become log(x + 1), float32
+// columns pass through; both are emitted as DenseType.
+template <typename DenseType>
+void convert_dense_row(const int* in, DenseType* out, int64_t dense_dim, bool dense_is_float) {
+  int64_t col = 0;
+#if defined(__AVX512F__)
+  if (dense_is_float) {
+    for (; col + 16 <= dense_dim; col += 16) {
+      __m512 v = _mm512_loadu_ps(reinterpret_cast<const float*>(in) + col);
+      avx512_store_dense(out + col, v);
+    }
+  } else {
+    for (; col + 16 <= dense_dim; col += 16) {
+      __m512i vi = _mm512_loadu_si512(reinterpret_cast<const void*>(in + col));
+      __m512 v = _mm512_add_ps(_mm512_cvtepi32_ps(vi), _mm512_set1_ps(1.0f));
+      avx512_store_dense(out + col, avx512_log_ps(v));
+    }
+  }
+#endif
+  for (; col < dense_dim; ++col) {
+    float value =
+        dense_is_float ? reinterpret_cast<const float*>(in)[col] : logf(in[col] + 1.0f);
+    out[col] = static_cast<DenseType>(value);
+  }
+}
+
+}  // namespace
+
+template <typename DenseType, typename SparseType>
+void split_3_way_feat_major_cpu(core23::Tensor label_tensor, core23::Tensor dense_tensor,
+                                core23::Tensor sparse_tensors,
+                                core23::Tensor label_dense_sparse_tensor, core23::Tensor bucket_ids,
+                                core23::Tensor bucket_positions, core23::Tensor max_hotnesses,
+                                bool dense_is_float, core23::Tensor sample_perm) {
+  const int* sample_perm_ptr = sample_perm.empty() ? nullptr : sample_perm.data<int>();
+  const auto batch_size = label_dense_sparse_tensor.size(0);
+  const auto label_dim = label_tensor.size(1);
+  const auto dense_dim = dense_tensor.size(1);
+  const auto sample_dim = label_dense_sparse_tensor.size(1);
+  assert(label_dim > 0 && "label_dim is 0");
+  assert(dense_dim > 0 && "dense_dim is 0");
+  assert(sample_dim > 0 && "sample_dim is 0");
+
+  const int* label_dense_sparse_ptr = label_dense_sparse_tensor.data<int>();
+  float* label_ptr = label_tensor.data<float>();
+  DenseType* dense_ptr = dense_tensor.data<DenseType>();
+  SparseType** sparse_tensors_ptr = reinterpret_cast<SparseType**>(sparse_tensors.data());
+  const int* bucket_ids_ptr = bucket_ids.data<int>();
+  const int* bucket_positions_ptr = bucket_positions.data<int>();
+  const int* max_hotnesses_ptr = max_hotnesses.data<int>();
+
+  for (int64_t in_row = 0; in_row < batch_size; ++in_row) {
+    const int* sample = label_dense_sparse_ptr + in_row * sample_dim;
+    // with a permutation, sample in_row of the staged batch is emitted as sample row
+    const int64_t row = sample_perm_ptr ? sample_perm_ptr[in_row] : in_row;
+
+    for (int64_t col = 0; col < label_dim; ++col) {
+      label_ptr[row * label_dim + col] = static_cast<float>(sample[col]);
+    }
+
+    convert_dense_row(sample + label_dim, dense_ptr + row * dense_dim, dense_dim, dense_is_float);
+
+    for (int64_t col = label_dim + dense_dim; col < sample_dim; ++col) {
+      const auto col_data = sample[col];
+      if constexpr (std::is_same<SparseType, long long>::value) {
+        const auto sparse_col = col - label_dim - dense_dim;
+        const auto bucket_id = bucket_ids_ptr[sparse_col / 2];
+        const auto bucket_idx =
+            (row * max_hotnesses_ptr[bucket_id] + bucket_positions_ptr[sparse_col / 2]) * 2 +
+            (sparse_col & 1);
+        reinterpret_cast<int**>(sparse_tensors_ptr)[bucket_id][bucket_idx] = col_data;
+      } else {
+        const auto sparse_col = col - label_dim - dense_dim;
+        const auto bucket_id = bucket_ids_ptr[sparse_col];
+        const auto bucket_idx = row * max_hotnesses_ptr[bucket_id] + bucket_positions_ptr[sparse_col];
+        sparse_tensors_ptr[bucket_id][bucket_idx] = static_cast<SparseType>(col_data);
+      }
+    }
+  }
+}
+
+#define INSTANTIATE_SPLIT_3_WAY_CPU_23(DENSE_T, SPARSE_T)                                      \
+  template void split_3_way_feat_major_cpu<DENSE_T, SPARSE_T>(                                 \
+      core23::Tensor label_tensor, core23::Tensor dense_tensor, core23::Tensor sparse_tensors, \
+      core23::Tensor label_dense_sparse_tensor, core23::Tensor bucket_ids,                     \
+      core23::Tensor bucket_positions, core23::Tensor max_hotnesses, bool dense_is_float,      \
+      core23::Tensor sample_perm)
+
+INSTANTIATE_SPLIT_3_WAY_CPU_23(float, uint32_t);
+INSTANTIATE_SPLIT_3_WAY_CPU_23(__half, uint32_t);
+INSTANTIATE_SPLIT_3_WAY_CPU_23(float, long long);
+INSTANTIATE_SPLIT_3_WAY_CPU_23(__half, long long);
+
+}  // namespace HugeCTR
@@ -359,7 +359,8 @@ ParquetDataReaderWorker<T>::ParquetDataReaderWorker(
     std::vector<std::shared_ptr<std::atomic<int>>>& accomplished_workers,
     const std::shared_ptr<ResourceManager>& resource_manager,
     std::shared_ptr<std::vector<size_t>> dense_width_dim, char* go_next_epoch,
-    std::mutex& epoch_mtx, std::condition_variable& epoch_cv)
+    std::mutex& epoch_mtx, std::condition_variable& epoch_cv, unsigned int file_shard_id,
+    unsigned int file_shard_count)
 
     : IDataReaderWorker(worker_id, worker_num, gpu_resource, !repeat, loop_flag, buffer),
       params_(params),
@@ -415,8 +416,15 @@ ParquetDataReaderWorker<T>::ParquetDataReaderWorker(
   // TODO this eager allocation is a WAR of resolving race condition with the main thread;
   // Do not remove the allocation before we have a better way to resolve the race condition
   device_memory_dense_dim_array_.data();
+  // The file shard folds the process id into the source's (offset, stride) so
+  // each rank walks a disjoint slice of the list; worker ids used for intra-group
+  // coordination stay local.
   source_ = std::make_shared<ParquetFileSource>(
-      worker_id, worker_num, file_list, strict_order_of_batches, repeat, data_source_params);
+      file_shard_id * worker_num + worker_id, file_shard_count * worker_num, file_list,
+      strict_order_of_batches, repeat, data_source_params);
+  // only decode the columns the model references (labels, dense and the first
+  // slots_ cat columns); datasets wider than the model skip the extra chunks
+  parquet_file_source()->set_column_projection(slots_);
 
   if ((int)slot_offset_.size() < slots_) {
     slot_offset_.resize(slots_, static_cast<long long int>(0));
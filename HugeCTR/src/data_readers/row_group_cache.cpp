@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <data_readers/row_group_cache.hpp>
+#include <utils.hpp>
+
+namespace HugeCTR {
+
+template <typename T>
+RowGroupCache<T>::RowGroupCache(int device_id, size_t max_bytes)
+    : device_id_(device_id), max_bytes_(max_bytes) {}
+
+template <typename T>
+RowGroupCache<T>::~RowGroupCache() {
+  for (auto& kv : entries_) {
+    if (kv.second.pinned_data) {
+      cudaFreeHost(kv.second.pinned_data);
+    }
+  }
+}
+
+template <typename T>
+bool RowGroupCache<T>::lookup(const std::string& key, std::shared_ptr<DFContainer<T>>& dst,
+                              std::vector<size_t>& dense_dim_array,
+                              std::vector<int>& one_hot_slot_id,
+                              std::vector<int>& sparse_nnz_array) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  const Entry& e = it->second;
+
+  CudaDeviceContext context(device_id_);
+  dst->reset_ptrs();
+  cudaStream_t stream = dst->get_copy_stream();
+  for (size_t i = 0; i < dst->num_dense_; i++) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(dst->dense_ptr_[i], e.pinned_data + e.dense_offsets[i],
+                                   e.dense_size_bytes_[i], cudaMemcpyHostToDevice, stream));
+  }
+  for (size_t i = 0; i < dst->num_sparse_; i++) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(dst->sparse_ptr_[i], e.pinned_data + e.sparse_offsets[i],
+                                   e.sparse_size_bytes_[i], cudaMemcpyHostToDevice, stream));
+    if (e.sparse_row_offsets[i] != SIZE_MAX) {
+      HCTR_LIB_THROW(cudaMemcpyAsync(dst->sparse_offset_ptr_[i],
+                                     e.pinned_data + e.sparse_row_offsets[i],
+                                     (e.num_rows + 1) * sizeof(int32_t), cudaMemcpyHostToDevice,
+                                     stream));
+    } else {
+      dst->sparse_offset_ptr_[i] = nullptr;
+    }
+  }
+  dst->dense_size_ = e.dense_size_;
+  dst->dense_size_bytes_ = e.dense_size_bytes_;
+  dst->sparse_size_ = e.sparse_size_;
+  dst->sparse_size_bytes_ = e.sparse_size_bytes_;
+  dst->num_rows_ = e.num_rows;
+  dst->current_row_ = 0;
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+  dense_dim_array = e.dense_dim_array;
+  one_hot_slot_id = e.one_hot_slot_id;
+  sparse_nnz_array = e.sparse_nnz_array;
+  return true;
+}
+
+template <typename T>
+void RowGroupCache<T>::insert(const std::string& key, const std::shared_ptr<DFContainer<T>>& src,
+                              const std::vector<size_t>& dense_dim_array,
+                              const std::vector<int>& one_hot_slot_id,
+                              const std::vector<int>& sparse_nnz_array) {
+  if (entries_.count(key)) {
+    return;
+  }
+
+  Entry e;
+  e.dense_size_ = src->dense_size_;
+  e.dense_size_bytes_ = src->dense_size_bytes_;
+  e.sparse_size_ = src->sparse_size_;
+  e.sparse_size_bytes_ = src->sparse_size_bytes_;
+  e.num_rows = src->num_rows_;
+  e.dense_dim_array = dense_dim_array;
+  e.one_hot_slot_id = one_hot_slot_id;
+  e.sparse_nnz_array = sparse_nnz_array;
+
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < src->num_dense_; i++) {
+    e.dense_offsets.push_back(total_bytes);
+    total_bytes += src->dense_size_bytes_[i];
+  }
+  for (size_t i = 0; i < src->num_sparse_; i++) {
+    e.sparse_offsets.push_back(total_bytes);
+    total_bytes += src->sparse_size_bytes_[i];
+  }
+  for (size_t i = 0; i < src->num_sparse_; i++) {
+    if (src->sparse_offset_ptr_[i]) {
+      e.sparse_row_offsets.push_back(total_bytes);
+      total_bytes += (src->num_rows_ + 1) * sizeof(int32_t);
+    } else {
+      e.sparse_row_offsets.push_back(SIZE_MAX);
+    }
+  }
+
+  if (used_bytes_ + total_bytes > max_bytes_) {
+    if (!budget_warned_) {
+      HCTR_LOG(WARNING, ROOT,
+               "Row-group cache budget (%zu bytes) exhausted; remaining row groups will be "
+               "re-decoded every epoch\n",
+               max_bytes_);
+      budget_warned_ = true;
+    }
+    return;
+  }
+
+  CudaDeviceContext context(device_id_);
+  HCTR_LIB_THROW(cudaMallocHost(&e.pinned_data, total_bytes));
+  e.pinned_bytes = total_bytes;
+
+  cudaStream_t stream = src->get_copy_stream();
+  for (size_t i = 0; i < src->num_dense_; i++) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(e.pinned_data + e.dense_offsets[i], src->dense_ptr_[i],
+                                   e.dense_size_bytes_[i], cudaMemcpyDeviceToHost, stream));
+  }
+  for (size_t i = 0; i < src->num_sparse_; i++) {
+    HCTR_LIB_THROW(cudaMemcpyAsync(e.pinned_data + e.sparse_offsets[i], src->sparse_ptr_[i],
+                                   e.sparse_size_bytes_[i], cudaMemcpyDeviceToHost, stream));
+    if (e.sparse_row_offsets[i] != SIZE_MAX) {
+      HCTR_LIB_THROW(cudaMemcpyAsync(e.pinned_data + e.sparse_row_offsets[i],
+                                     src->sparse_offset_ptr_[i],
+                                     (src->num_rows_ + 1) * sizeof(int32_t),
+                                     cudaMemcpyDeviceToHost, stream));
+    }
+  }
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+  used_bytes_ += total_bytes;
+  entries_.emplace(key, e);
+}
+
+template class RowGroupCache<unsigned int>;
+template class RowGroupCache<long long>;
+}  // namespace HugeCTR
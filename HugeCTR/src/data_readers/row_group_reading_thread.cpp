@@ -46,7 +46,13 @@ RowGroupReadingThread<T>::RowGroupReadingThread(
       strict_order_of_batches_(strict_order_of_batches),
       local_row_group_id_(0),
       dense_idx_to_parquet_col_(dense_idx_to_parquet_col),
-      categorical_idx_parquet_col_(categorical_idx_parquet_col){};
+      categorical_idx_parquet_col_(categorical_idx_parquet_col) {
+  if (const char* cache_gb = std::getenv("HCTR_ROW_GROUP_CACHE")) {
+    // budget is per reading thread, in GB of pinned host memory
+    size_t max_bytes = static_cast<size_t>(std::atof(cache_gb) * 1024.0 * 1024.0 * 1024.0);
+    row_group_cache_ = std::make_unique<RowGroupCache<T>>(device_id_, max_bytes);
+  }
+};
 
 // one of the consumer will notify producer that it has got the group
 template <typename T>
@@ -172,6 +178,17 @@ Error_t RowGroupReadingThread<T>::get_one_read_group(
     return Error_t::EndOfFile;
   }
   CudaDeviceContext ctx(device_id_);
+  std::string cache_key;
+  if (row_group_cache_) {
+    cache_key = RowGroupCache<T>::make_key(source_->get_cur_file(), this->local_row_group_id_);
+    if (row_group_cache_->lookup(cache_key, df_container_producer_[this->worker_id_],
+                                 dense_dim_array, one_hot_slot_id, sparse_nnz_array)) {
+      // cudf decode skipped; keep the source cursors in sync for EOF accounting
+      source_->skip_group(this->local_row_group_id_);
+      this->local_row_group_id_ += this->strict_order_of_batches_ ? this->num_workers_ : 1;
+      return Error_t::Success;
+    }
+  }
   auto tbl_w_metadata = source_->read_group(this->local_row_group_id_, this->memory_resource_);
   this->local_row_group_id_ += this->strict_order_of_batches_ ? this->num_workers_ : 1;
   tbl_w_metadata.tbl.swap(this->cached_df_);
@@ -179,6 +196,10 @@ Error_t RowGroupReadingThread<T>::get_one_read_group(
   dump_table_data_to(data_view, dense_idx_to_parquet_col_, categorical_idx_parquet_col_, params,
                      df_container_producer_[this->worker_id_], dense_dim_array, one_hot_slot_id,
                      sparse_nnz_array);
+  if (row_group_cache_) {
+    row_group_cache_->insert(cache_key, df_container_producer_[this->worker_id_], dense_dim_array,
+                             one_hot_slot_id, sparse_nnz_array);
+  }
   return Error_t::Success;
 };
 
@@ -216,8 +237,11 @@ void RowGroupReadingThread<T>::read_new_file(long long expected_row_groups) {
           for (auto& c : label_col_names) {
             tmp_col_index.insert(c.index);
           }
+          // with column projection active the decoded table only holds the
+          // referenced columns, so raw parquet indices are remapped to their
+          // projected positions
           for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-            dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
+            dense_idx_to_parquet_col_.insert(std::make_pair(i, metadata.get_projected_index(*it)));
             i++;
           }
           tmp_col_index.clear();
@@ -225,7 +249,7 @@ void RowGroupReadingThread<T>::read_new_file(long long expected_row_groups) {
             tmp_col_index.insert(c.index);
           }
           for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-            dense_idx_to_parquet_col_.insert(std::make_pair(i, *it));
+            dense_idx_to_parquet_col_.insert(std::make_pair(i, metadata.get_projected_index(*it)));
             i++;
           }
         }
@@ -238,8 +262,11 @@ void RowGroupReadingThread<T>::read_new_file(long long expected_row_groups) {
           for (auto& c : cat_col_names) {
             tmp_col_index.insert(c.index);
           }
+          // pruned cat columns map to -1; they sit beyond the model's slot
+          // count so dump_table_data_to() never dereferences them
           for (auto it = tmp_col_index.begin(); it != tmp_col_index.end(); it++) {
-            categorical_idx_parquet_col_.insert(std::make_pair(i, *it));
+            categorical_idx_parquet_col_.insert(
+                std::make_pair(i, metadata.get_projected_index(*it)));
             i++;
           }
         }
@@ -15,6 +15,7 @@
  */
 
 #include <embeddings/embedding_collection.hpp>
+#include <sstream>
 
 #include "embedding/dense_model_parallel_embedding.hpp"
 #include "embedding/hier_model_parallel_embedding.hpp"
@@ -174,19 +175,136 @@ EmbeddingCollection::EmbeddingCollection(
   }
   int num_gpus = resource_manager->get_local_gpu_count();
 
+  // HCTR_HIER_ALL2ALL=1 upgrades the flat all-to-all of SparseModelParallel groups to
+  // the two-phase hierarchical exchange without touching the model config: vectors
+  // headed to the same remote node are reduced intra-node over NVLink first and only
+  // the per-node union crosses the inter-node links.
+  const char *const hier_a2a_env = std::getenv("HCTR_HIER_ALL2ALL");
+  if (hier_a2a_env != nullptr && 1 == std::atoi(hier_a2a_env) &&
+      ebc_param_.comm_strategy_ == CommunicationStrategy::Uniform) {
+    if (resource_manager->get_num_process() > 1 && resource_manager->all_p2p_enabled()) {
+      HCTR_LOG(INFO, ROOT, "HCTR_HIER_ALL2ALL: using Hierarchical communication strategy\n");
+      ebc_param_.comm_strategy_ = CommunicationStrategy::Hierarchical;
+      eval_ebc_param_.comm_strategy_ = CommunicationStrategy::Hierarchical;
+    } else {
+      HCTR_LOG(WARNING, ROOT,
+               "HCTR_HIER_ALL2ALL ignored: requires a multi-node run with all intra-node "
+               "peer access enabled\n");
+    }
+  }
+
   for (int gpu_id = 0; gpu_id < num_gpus; ++gpu_id) {
     HugeCTR::CudaDeviceContext context(core[gpu_id]->get_device_id());
     // embedding storage
     embedding_tables_.push_back(create_grouped_embedding_tables(resource_manager, core[gpu_id],
                                                                 ebc_param_, emb_table_param_list));
     // embedding ops
-    embeddings_.push_back(create_grouped_embeddings(core[gpu_id], ebc_param_));
-    eval_embeddings_.push_back(create_grouped_embeddings(core[gpu_id], eval_ebc_param_));
+    embeddings_.push_back(
+        create_grouped_embeddings(core[gpu_id], ebc_param_, emb_table_param_list));
+    eval_embeddings_.push_back(
+        create_grouped_embeddings(core[gpu_id], eval_ebc_param_, emb_table_param_list));
   }
 
   init_embedding_output_attrs(core);
   init_wgrad(core, exchange_wgrad);
   init_peer_buffer(core);
+
+  const char *const ebc_cuda_graph_env = std::getenv("HCTR_EBC_CUDA_GRAPH");
+  use_cuda_graph_ = (ebc_cuda_graph_env != nullptr && 1 == std::atoi(ebc_cuda_graph_env));
+  forward_graphs_.resize(num_gpus);
+  backward_graphs_.resize(num_gpus);
+
+  const char *const grad_accum_env = std::getenv("HCTR_EBC_GRAD_ACCUM_STEPS");
+  grad_accum_steps_ = grad_accum_env != nullptr ? std::atoi(grad_accum_env) : 1;
+  if (grad_accum_steps_ > 1) {
+    const char *const accum_capacity_env = std::getenv("HCTR_EBC_GRAD_ACCUM_CAPACITY");
+    int64_t capacity_factor = accum_capacity_env != nullptr ? std::atoll(accum_capacity_env) : 4;
+
+    int max_ev_size = 0;
+    for (auto &table_param : emb_table_param_list_) {
+      max_ev_size = std::max(max_ev_size, table_param.ev_size);
+    }
+
+    grad_accum_counters_.resize(num_gpus);
+    wgrad_accumulators_.resize(num_gpus);
+    for (int gpu_id = 0; gpu_id < num_gpus; ++gpu_id) {
+      HugeCTR::CudaDeviceContext context(core[gpu_id]->get_device_id());
+      grad_accum_counters_[gpu_id].assign(wgrad_list_[gpu_id].size(), 0);
+      for (auto &wgrad : wgrad_list_[gpu_id]) {
+        if (!wgrad.is_dynamic_allocate && wgrad.unique_keys.num_elements() > 0) {
+          wgrad_accumulators_[gpu_id].push_back(std::make_unique<WgradAccumulator>(
+              core[gpu_id], wgrad, capacity_factor * wgrad.unique_keys.num_elements(),
+              max_ev_size));
+        } else {
+          wgrad_accumulators_[gpu_id].push_back(nullptr);
+        }
+      }
+    }
+    HCTR_LOG_S(INFO, ROOT) << "Embedding gradient accumulation enabled: optimizer fires every "
+                           << grad_accum_steps_ << " micro-batches" << std::endl;
+  }
+
+  const char *const ebc_profile_env = std::getenv("HCTR_EBC_PROFILE");
+  use_profiler_ = (ebc_profile_env != nullptr && 1 == std::atoi(ebc_profile_env));
+  if (use_profiler_ && use_cuda_graph_) {
+    HCTR_LOG(WARNING, ROOT,
+             "HCTR_EBC_PROFILE is ignored with HCTR_EBC_CUDA_GRAPH: timing events cannot be "
+             "harvested during graph capture\n");
+    use_profiler_ = false;
+  }
+  if (use_profiler_) {
+    profile_stats_.resize(num_gpus);
+    HCTR_LOG(INFO, ROOT, "Embedding collection profiler enabled\n");
+  }
+}
+
+void EmbeddingCollection::profile_stage_timing(int gpu_id, size_t grouped_id, Stage stage,
+                                               const char *direction,
+                                               const std::function<void()> &stage_fn) {
+  auto local_gpu = resource_manager_->get_local_gpu(gpu_id);
+  cudaStream_t stream = local_gpu->get_stream();
+  std::string key =
+      std::string(direction) + "/group" + std::to_string(grouped_id) + "/" + to_string(stage);
+  const cudaEvent_t &start = local_gpu->get_event("ebc_prof_start_" + key);
+  const cudaEvent_t &stop = local_gpu->get_event("ebc_prof_stop_" + key);
+
+  HCTR_LIB_THROW(cudaEventRecord(start, stream));
+  stage_fn();
+  HCTR_LIB_THROW(cudaEventRecord(stop, stream));
+  HCTR_LIB_THROW(cudaEventSynchronize(stop));
+
+  float ms = 0.f;
+  HCTR_LIB_THROW(cudaEventElapsedTime(&ms, start, stop));
+  StageProfileStat &stat = profile_stats_[gpu_id][key];
+  stat.count += 1;
+  stat.total_ms += ms;
+  stat.last_ms = ms;
+  // ~20-iteration horizon so the rolling value tracks a regression quickly
+  stat.ewma_ms = stat.count == 1 ? ms : 0.95 * stat.ewma_ms + 0.05 * ms;
+}
+
+std::string EmbeddingCollection::profile_report() const {
+  if (!use_profiler_) return "";
+  std::ostringstream os;
+  os << "EmbeddingCollection profile (ms per call)\n";
+  for (size_t gpu_id = 0; gpu_id < profile_stats_.size(); ++gpu_id) {
+    for (auto &[key, stat] : profile_stats_[gpu_id]) {
+      os << "gpu" << gpu_id << " " << key << ": count " << stat.count << ", avg "
+         << (stat.count > 0 ? stat.total_ms / stat.count : 0.0) << ", ewma " << stat.ewma_ms
+         << ", last " << stat.last_ms << "\n";
+    }
+  }
+  return os.str();
+}
+
+void EmbeddingCollection::set_output_layout(EmbeddingLayout layout) {
+  ebc_param_.output_layout_ = layout;
+  eval_ebc_param_.output_layout_ = layout;
+  for (auto &attrs_per_gpu : embedding_output_attrs_) {
+    for (auto &attr : attrs_per_gpu) {
+      attr.layout = layout;
+    }
+  }
 }
 
 void EmbeddingCollection::init_embedding_output_attrs(
@@ -366,6 +484,13 @@ void EmbeddingCollection::forward_per_gpu(Stage stage, bool is_train, int gpu_id
     ILookup *lookup = dynamic_cast<ILookup *>(get_table(gpu_id, grouped_id));
     EmbeddingOutput embedding_output{output_buffer, embedding_output_attrs_[gpu_id][grouped_id]};
 
+    if (use_profiler_) {
+      profile_stage_timing(gpu_id, grouped_id, stage, is_train ? "train_fwd" : "eval_fwd", [&] {
+        embeddings[grouped_id]->forward_per_gpu(stage, input[grouped_id], lookup, embedding_output,
+                                                batch_size);
+      });
+      continue;
+    }
     embeddings[grouped_id]->forward_per_gpu(stage, input[grouped_id], lookup, embedding_output,
                                             batch_size);
   }
@@ -384,6 +509,22 @@ void EmbeddingCollection::forward_per_gpu(bool is_train, int gpu_id,
   } else {
     HCTR_OWN_THROW(HugeCTR::Error_t::IllegalCall, "comm strategy not supported in forward_per_gpu");
   }
+  if (use_cuda_graph_) {
+    // the input/output tensors are persistent per GPU, so the captured graph stays
+    // valid as long as the batch shape does; a new shape captures a fresh graph
+    cudaStream_t stream = resource_manager_->get_local_gpu(gpu_id)->get_stream();
+    auto &graph = forward_graphs_[gpu_id][{is_train, batch_size}];
+    graph.capture(
+        [&](cudaStream_t) {
+          for (auto stage : stages) {
+            forward_per_gpu(stage, is_train, gpu_id, input, output_buffer, batch_size);
+          }
+        },
+        stream);
+    graph.exec(stream);
+    return;
+  }
+
   for (auto stage : stages) {
     forward_per_gpu(stage, is_train, gpu_id, input, output_buffer, batch_size);
   }
@@ -396,6 +537,13 @@ void EmbeddingCollection::backward_per_gpu(Stage stage, int gpu_id,
     if (!embeddings_[gpu_id][grouped_id]->is_valid_stage(stage)) continue;
 
     EmbeddingOutput top_grad_buffer{top_grad, embedding_output_attrs_[gpu_id][grouped_id]};
+    if (use_profiler_) {
+      profile_stage_timing(gpu_id, grouped_id, stage, "bwd", [&] {
+        embeddings_[gpu_id][grouped_id]->backward_per_gpu(
+            stage, input[grouped_id], top_grad_buffer, wgrad_list_[gpu_id][grouped_id], batch_size);
+      });
+      continue;
+    }
     embeddings_[gpu_id][grouped_id]->backward_per_gpu(stage, input[grouped_id], top_grad_buffer,
                                                       wgrad_list_[gpu_id][grouped_id], batch_size);
   }
@@ -421,6 +569,20 @@ void EmbeddingCollection::backward_per_gpu(int gpu_id,
                    "comm strategy not supported in backward_per_gpu");
   }
 
+  if (use_cuda_graph_) {
+    cudaStream_t stream = resource_manager_->get_local_gpu(gpu_id)->get_stream();
+    auto &graph = backward_graphs_[gpu_id][batch_size];
+    graph.capture(
+        [&](cudaStream_t) {
+          for (auto stage : stages) {
+            backward_per_gpu(stage, gpu_id, input, top_grad, batch_size);
+          }
+        },
+        stream);
+    graph.exec(stream);
+    return;
+  }
+
   for (auto stage : stages) {
     backward_per_gpu(stage, gpu_id, input, top_grad, batch_size);
   }
@@ -433,6 +595,18 @@ void EmbeddingCollection::update_per_gpu(int gpu_id, EmbeddingGroupType embeddin
     auto &wgrad = wgrad_list_[gpu_id][grouped_id];
 
     auto table = get_table(gpu_id, grouped_id);
+    if (grad_accum_steps_ > 1 && wgrad_accumulators_[gpu_id][grouped_id]) {
+      auto &accumulator = wgrad_accumulators_[gpu_id][grouped_id];
+      cudaStream_t stream = resource_manager_->get_local_gpu(gpu_id)->get_stream();
+      accumulator->accumulate(wgrad, stream);
+      if (++grad_accum_counters_[gpu_id][grouped_id] < grad_accum_steps_) continue;
+      grad_accum_counters_[gpu_id][grouped_id] = 0;
+      accumulator->compact_and_reset(stream);
+      table->update(accumulator->unique_keys(), accumulator->num_unique_keys(),
+                    accumulator->table_ids(), accumulator->ev_start_indices(),
+                    accumulator->data());
+      continue;
+    }
     table->update(wgrad.unique_keys, wgrad.num_unique_keys, wgrad.table_ids, wgrad.ev_start_indices,
                   wgrad.data);
   }
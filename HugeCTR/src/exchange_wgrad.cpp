@@ -14,11 +14,21 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <exchange_wgrad.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
+namespace {
+
+bool wgrad_bucketing_requested() {
+  const char* const env = std::getenv("HCTR_WGRAD_AR_BUCKETS");
+  return env != nullptr && 1 == std::atoi(env);
+}
+
+}  // namespace
+
 template <typename T>
 NetworkExchangeWgrad<T>::NetworkExchangeWgrad(
     const std::shared_ptr<ResourceManager>& resource_manager,
@@ -28,16 +38,69 @@ NetworkExchangeWgrad<T>::NetworkExchangeWgrad(
   null_wgrad_buffs_.resize(num_gpus_, nullptr);
   auto ar_comm = collective_manager_->get_ar_comm();
   ar_handle_ = ar_comm->register_coll();
+  bucketing_requested_ = wgrad_bucketing_requested();
+  const float topk_ratio = wgrad_topk_ratio();
+  if (topk_ratio > 0.f) {
+    compressor_ = std::make_unique<WgradCompressor<T>>(resource_manager->get_local_gpus(),
+                                                       topk_ratio);
+    if (bucketing_requested_) {
+      HCTR_LOG_S(WARNING, ROOT) << "wgrad top-k compression replaces the allreduce, "
+                                   "ignoring HCTR_WGRAD_AR_BUCKETS"
+                                << std::endl;
+      bucketing_requested_ = false;
+    }
+  }
+  if (bucketing_requested_) {
+    ar_handle_top_ = ar_comm->register_coll();
+  }
+  const float dyn_scale = dynamic_loss_scale_init();
+  if (dyn_scale > 0.f) {
+    loss_scale_guard_ =
+        std::make_unique<LossScaleGuard<T>>(resource_manager->get_local_gpus(), dyn_scale);
+  }
 }
+template <typename T>
+void NetworkExchangeWgrad<T>::set_bucket_split(size_t offset_in_bytes) {
+  // grouped allreduce needs 16B-aligned buffers with sizes divisible by num_gpus * 16
+  const size_t align = 16 * num_gpus_;
+  bucket_split_ = offset_in_bytes - offset_in_bytes % align;
+}
+
+template <typename T>
+bool NetworkExchangeWgrad<T>::bucketed() const {
+  return bucketing_requested_ && bucket_split_ != 0;
+}
+
 template <typename T>
 void NetworkExchangeWgrad<T>::init_ar_comm(const std::vector<void*>& ptr, size_t sizes) {
   network_wgrad_size_ = sizes;
   auto ar_comm = collective_manager_->get_ar_comm();
+  if (bucketing_requested_ && (bucket_split_ == 0 || bucket_split_ >= sizes)) {
+    HCTR_LOG_S(WARNING, ROOT) << "wgrad bucketing requested but no usable split offset, "
+                                 "falling back to a single allreduce"
+                              << std::endl;
+    bucket_split_ = 0;
+  }
   for (size_t g = 0; g < num_gpus_; g++) {
     HCTR_CHECK_HINT(ptr[g], "buffer does not exist");
-    ar_comm->set_coll_buf(ar_handle_, ptr[g], network_wgrad_size_, g);
+    if (bucketed()) {
+      ar_comm->set_coll_buf(ar_handle_, ptr[g], bucket_split_, g);
+      ar_comm->set_coll_buf(ar_handle_top_, static_cast<char*>(ptr[g]) + bucket_split_,
+                            network_wgrad_size_ - bucket_split_, g);
+    } else {
+      ar_comm->set_coll_buf(ar_handle_, ptr[g], network_wgrad_size_, g);
+    }
   }
   ar_comm->register_coll_buf(ar_handle_);
+  if (bucketed()) {
+    ar_comm->register_coll_buf(ar_handle_top_);
+  }
+  if (compressor_) {
+    compressor_->init_buf(ptr, sizes);
+  }
+  if (loss_scale_guard_) {
+    loss_scale_guard_->init_buf(ptr, sizes);
+  }
 }
 
 template <typename T>
@@ -47,8 +110,29 @@ void NetworkExchangeWgrad<T>::update_embed_wgrad_size(size_t size) {
 
 template <typename T>
 void NetworkExchangeWgrad<T>::allreduce(size_t device_id, cudaStream_t stream) {
+  if (compressor_) {
+    compressor_->compress_exchange(device_id, stream);
+  } else {
+    auto ar_comm = collective_manager_->get_ar_comm();
+    ar_comm->all_reduce(ar_handle_, stream, device_id);
+    if (bucketed()) {
+      ar_comm->all_reduce(ar_handle_top_, stream, device_id);
+    }
+  }
+  if (loss_scale_guard_) {
+    loss_scale_guard_->check_and_update(device_id, stream);
+  }
+}
+
+template <typename T>
+void NetworkExchangeWgrad<T>::allreduce_bucket(size_t device_id, size_t bucket,
+                                               cudaStream_t stream) {
   auto ar_comm = collective_manager_->get_ar_comm();
-  ar_comm->all_reduce(ar_handle_, stream, device_id);
+  ar_comm->all_reduce(bucket == 0 ? ar_handle_ : ar_handle_top_, stream, device_id);
+  // The bottom bucket is reduced last, so the whole buffer is final by then.
+  if (loss_scale_guard_ && bucket == 0) {
+    loss_scale_guard_->check_and_update(device_id, stream);
+  }
 }
 
 template <typename T>
@@ -61,16 +145,69 @@ GroupedExchangeWgrad<T>::GroupedExchangeWgrad(
 
   auto ar_comm = collective_manager_->get_ar_comm();
   ar_handle_ = ar_comm->register_coll();
+  bucketing_requested_ = wgrad_bucketing_requested();
+  const float topk_ratio = wgrad_topk_ratio();
+  if (topk_ratio > 0.f) {
+    compressor_ = std::make_unique<WgradCompressor<T>>(resource_manager->get_local_gpus(),
+                                                       topk_ratio);
+    if (bucketing_requested_) {
+      HCTR_LOG_S(WARNING, ROOT) << "wgrad top-k compression replaces the allreduce, "
+                                   "ignoring HCTR_WGRAD_AR_BUCKETS"
+                                << std::endl;
+      bucketing_requested_ = false;
+    }
+  }
+  if (bucketing_requested_) {
+    ar_handle_top_ = ar_comm->register_coll();
+  }
+  const float dyn_scale = dynamic_loss_scale_init();
+  if (dyn_scale > 0.f) {
+    loss_scale_guard_ =
+        std::make_unique<LossScaleGuard<T>>(resource_manager->get_local_gpus(), dyn_scale);
+  }
+}
+template <typename T>
+void GroupedExchangeWgrad<T>::set_bucket_split(size_t offset_in_bytes) {
+  // grouped allreduce needs 16B-aligned buffers with sizes divisible by num_gpus * 16
+  const size_t align = 16 * num_gpus_;
+  bucket_split_ = offset_in_bytes - offset_in_bytes % align;
+}
+
+template <typename T>
+bool GroupedExchangeWgrad<T>::bucketed() const {
+  return bucketing_requested_ && bucket_split_ != 0;
 }
+
 template <typename T>
 void GroupedExchangeWgrad<T>::init_ar_comm(const std::vector<void*>& ptr, size_t sizes) {
   network_wgrad_size_ = sizes;
   auto ar_comm = collective_manager_->get_ar_comm();
+  if (bucketing_requested_ && (bucket_split_ == 0 || bucket_split_ >= sizes)) {
+    HCTR_LOG_S(WARNING, ROOT) << "wgrad bucketing requested but no usable split offset, "
+                                 "falling back to a single allreduce"
+                              << std::endl;
+    bucket_split_ = 0;
+  }
   for (size_t g = 0; g < num_gpus_; g++) {
     HCTR_CHECK_HINT(ptr[g], "buffer does not exist");
-    ar_comm->set_coll_buf(ar_handle_, ptr[g], network_wgrad_size_, g);
+    if (bucketed()) {
+      ar_comm->set_coll_buf(ar_handle_, ptr[g], bucket_split_, g);
+      ar_comm->set_coll_buf(ar_handle_top_, static_cast<char*>(ptr[g]) + bucket_split_,
+                            network_wgrad_size_ - bucket_split_, g);
+    } else {
+      ar_comm->set_coll_buf(ar_handle_, ptr[g], network_wgrad_size_, g);
+    }
   }
   ar_comm->register_coll_buf(ar_handle_);
+  if (bucketed()) {
+    ar_comm->register_coll_buf(ar_handle_top_);
+  }
+  if (compressor_) {
+    compressor_->init_buf(ptr, sizes);
+  }
+  if (loss_scale_guard_) {
+    loss_scale_guard_->init_buf(ptr, sizes);
+  }
 }
 
 template <typename T>
@@ -81,8 +218,59 @@ void GroupedExchangeWgrad<T>::update_embed_wgrad_size(size_t size) {
 
 template <typename T>
 void GroupedExchangeWgrad<T>::allreduce(size_t device_id, cudaStream_t stream) {
+  if (compressor_) {
+    compressor_->compress_exchange(device_id, stream);
+  } else {
+    auto ar_comm = collective_manager_->get_ar_comm();
+    ar_comm->all_reduce(ar_handle_, stream, device_id);
+    if (bucketed()) {
+      ar_comm->all_reduce(ar_handle_top_, stream, device_id);
+    }
+  }
+  if (loss_scale_guard_) {
+    loss_scale_guard_->check_and_update(device_id, stream);
+  }
+}
+
+template <typename T>
+void GroupedExchangeWgrad<T>::allreduce_bucket(size_t device_id, size_t bucket,
+                                               cudaStream_t stream) {
   auto ar_comm = collective_manager_->get_ar_comm();
-  ar_comm->all_reduce(ar_handle_, stream, device_id);
+  ar_comm->all_reduce(bucket == 0 ? ar_handle_ : ar_handle_top_, stream, device_id);
+  // The bottom bucket is reduced last, so the whole buffer is final by then.
+  if (loss_scale_guard_ && bucket == 0) {
+    loss_scale_guard_->check_and_update(device_id, stream);
+  }
+}
+
+template <typename T>
+float* NetworkExchangeWgrad<T>::dynamic_loss_scale_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->loss_scale_ptr(device_id) : nullptr;
+}
+
+template <typename T>
+const float* NetworkExchangeWgrad<T>::dynamic_unscale_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->unscale_ptr(device_id) : nullptr;
+}
+
+template <typename T>
+const int* NetworkExchangeWgrad<T>::skip_step_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->skip_step_ptr(device_id) : nullptr;
+}
+
+template <typename T>
+float* GroupedExchangeWgrad<T>::dynamic_loss_scale_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->loss_scale_ptr(device_id) : nullptr;
+}
+
+template <typename T>
+const float* GroupedExchangeWgrad<T>::dynamic_unscale_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->unscale_ptr(device_id) : nullptr;
+}
+
+template <typename T>
+const int* GroupedExchangeWgrad<T>::skip_step_ptr(size_t device_id) const {
+  return loss_scale_guard_ ? loss_scale_guard_->skip_step_ptr(device_id) : nullptr;
 }
 
 template class NetworkExchangeWgrad<__half>;
@@ -25,9 +25,24 @@ namespace {
 
 __global__ void lr_update_kernel(float base_lr, size_t warmup_steps, size_t decay_start,
                                  size_t decay_steps, float decay_power, float end_lr, size_t* step,
-                                 float* current_lr, float* last_lr) {
+                                 float* current_lr, float* last_lr, float wd_start, float wd_end,
+                                 size_t wd_ramp_start, size_t wd_ramp_steps, float loss_scale,
+                                 float* current_wd, float* current_scale) {
   size_t step_val = *step;
   *step = step_val + 1;
+
+  // All schedule-dependent scalars are evaluated here so no host write is needed
+  // between iterations and the step stays graph-capturable.
+  if (step_val < wd_ramp_start || wd_ramp_steps == 0) {
+    *current_wd = wd_start;
+  } else if (step_val < wd_ramp_start + wd_ramp_steps) {
+    float ramp = (step_val - wd_ramp_start) / (float)wd_ramp_steps;
+    *current_wd = wd_start + (wd_end - wd_start) * ramp;
+  } else {
+    *current_wd = wd_end;
+  }
+  *current_scale = loss_scale;
+
   if (step_val < warmup_steps) {
     *current_lr = step_val * base_lr / warmup_steps;
     *last_lr = *current_lr;
@@ -67,25 +82,53 @@ GpuLearningRateScheduler::GpuLearningRateScheduler(float base_lr, size_t warmup_
   HCTR_LIB_THROW(cudaMalloc(&step_, sizeof(size_t)));
   HCTR_LIB_THROW(cudaMalloc(&current_lr_, sizeof(float)));
   HCTR_LIB_THROW(cudaMalloc(&last_lr_, sizeof(float)));
+  HCTR_LIB_THROW(cudaMalloc(&current_wd_, sizeof(float)));
+  HCTR_LIB_THROW(cudaMalloc(&current_scale_, sizeof(float)));
   initialize_array<<<1, 1, 0, gpu_resource_->get_stream()>>>(step_, 1, (size_t)0);
-  lr_update_kernel<<<1, 1, 0, gpu_resource_->get_stream()>>>(base_lr_, warmup_steps_, decay_start_,
-                                                             decay_steps_, decay_power_, end_lr_,
-                                                             step_, current_lr_, last_lr_);
+  lr_update_kernel<<<1, 1, 0, gpu_resource_->get_stream()>>>(
+      base_lr_, warmup_steps_, decay_start_, decay_steps_, decay_power_, end_lr_, step_,
+      current_lr_, last_lr_, wd_start_, wd_end_, wd_ramp_start_, wd_ramp_steps_, loss_scale_,
+      current_wd_, current_scale_);
 }
 
 GpuLearningRateScheduler::~GpuLearningRateScheduler() {
   HCTR_LIB_CHECK_(cudaFree(step_));
   HCTR_LIB_CHECK_(cudaFree(current_lr_));
   HCTR_LIB_CHECK_(cudaFree(last_lr_));
+  HCTR_LIB_CHECK_(cudaFree(current_wd_));
+  HCTR_LIB_CHECK_(cudaFree(current_scale_));
+}
+
+void GpuLearningRateScheduler::set_weight_decay_ramp(float wd_start, float wd_end,
+                                                     size_t ramp_start, size_t ramp_steps) {
+  if (wd_start < 0.f || wd_end < 0.f) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "wd_start < 0.f || wd_end < 0.f");
+  }
+  wd_start_ = wd_start;
+  wd_end_ = wd_end;
+  wd_ramp_start_ = ramp_start;
+  wd_ramp_steps_ = ramp_steps;
+}
+
+void GpuLearningRateScheduler::set_loss_scale(float loss_scale) {
+  if (loss_scale <= 0.f) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "loss_scale <= 0.f");
+  }
+  loss_scale_ = loss_scale;
 }
 
 void GpuLearningRateScheduler::update() {
   CudaDeviceContext context(gpu_resource_->get_device_id());
-  lr_update_kernel<<<1, 1, 0, gpu_resource_->get_stream()>>>(base_lr_, warmup_steps_, decay_start_,
-                                                             decay_steps_, decay_power_, end_lr_,
-                                                             step_, current_lr_, last_lr_);
+  lr_update_kernel<<<1, 1, 0, gpu_resource_->get_stream()>>>(
+      base_lr_, warmup_steps_, decay_start_, decay_steps_, decay_power_, end_lr_, step_,
+      current_lr_, last_lr_, wd_start_, wd_end_, wd_ramp_start_, wd_ramp_steps_, loss_scale_,
+      current_wd_, current_scale_);
 }
 
 float* GpuLearningRateScheduler::get_learning_rate() const { return current_lr_; }
 
+float* GpuLearningRateScheduler::get_weight_decay() const { return current_wd_; }
+
+float* GpuLearningRateScheduler::get_loss_scale() const { return current_scale_; }
+
 }  // namespace HugeCTR
@@ -36,11 +36,16 @@ GPUResource::GPUResource(int device_id, size_t local_id, size_t global_id,
   HCTR_LIB_THROW(cublasCreate(&cublas_handle_));
   HCTR_LIB_THROW(cudnnCreate(&cudnn_handle_));
 
+  HCTR_LIB_THROW(
+      cudaDeviceGetStreamPriorityRange(&least_stream_priority_, &greatest_stream_priority_));
+
   set_stream(stream_name_, 0);
   cudaStream_t computation_stream_ = stream_event_manager_.get_stream(stream_name_);
   memcpy_stream_ = stream_event_manager_.get_stream("memcpy_stream_", cudaStreamNonBlocking);
   computation_stream_2_ = stream_event_manager_.get_stream("computation_stream_2_");
-  p2p_stream_ = stream_event_manager_.get_stream("p2p_stream_", cudaStreamNonBlocking);
+  // inter-GPU copies are latency-critical and must not queue behind compute
+  p2p_stream_ = stream_event_manager_.get_stream("p2p_stream_", cudaStreamNonBlocking,
+                                                 greatest_stream_priority_);
   wait_wgrad_event_ = stream_event_manager_.get_event("wgrad_event", cudaEventDefault);
 
   HCTR_LIB_THROW(
@@ -96,6 +101,16 @@ const cudaStream_t& GPUResource::get_stream(const std::string& name, int priorit
   return stream_event_manager_.get_stream(name, cudaStreamNonBlocking, priority);
 }
 
+const cudaStream_t& GPUResource::get_high_priority_stream(const std::string& name) {
+  return stream_event_manager_.get_stream("high_priority." + name, cudaStreamNonBlocking,
+                                          greatest_stream_priority_);
+}
+
+const cudaStream_t& GPUResource::get_low_priority_stream(const std::string& name) {
+  return stream_event_manager_.get_stream("low_priority." + name, cudaStreamNonBlocking,
+                                          least_stream_priority_);
+}
+
 const cudaEvent_t& GPUResource::get_event(const std::string& name) {
   return stream_event_manager_.get_event(name, cudaEventDisableTiming);
 }
@@ -41,4 +41,36 @@ void GraphWrapper::exec(cudaStream_t stream) {
   HCTR_LIB_THROW(cudaGraphLaunch(graph_exec, stream));
 }
 
+size_t GraphWrapper::bucket_batch_size(size_t batch_size) {
+  size_t bucket = 1;
+  while (bucket < batch_size) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+bool GraphWrapper::captured(size_t key) const { return keyed_graphs.count(key) != 0; }
+
+void GraphWrapper::capture(size_t key, std::function<void(cudaStream_t)> workload,
+                           cudaStream_t stream) {
+  if (captured(key)) {
+    return;
+  }
+
+  std::pair<cudaGraph_t, cudaGraphExec_t> keyed_graph;
+  HCTR_LIB_THROW(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+  workload(stream);
+  HCTR_LIB_THROW(cudaStreamEndCapture(stream, &keyed_graph.first));
+  HCTR_LIB_THROW(cudaGraphInstantiate(&keyed_graph.second, keyed_graph.first, NULL, NULL, 0));
+  keyed_graphs[key] = keyed_graph;
+}
+
+void GraphWrapper::exec(size_t key, cudaStream_t stream) {
+  auto it = keyed_graphs.find(key);
+  if (it == keyed_graphs.end()) {
+    HCTR_OWN_THROW(Error_t::IllegalCall, "Trying to execute graph which was not captured");
+  }
+  HCTR_LIB_THROW(cudaGraphLaunch(it->second.second, stream));
+}
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <cub/cub.cuh>
 #include <thrust/pair.h>
 
+#include <algorithm>
+
 #include <hashtable/cudf/concurrent_unordered_map.cuh>
 #include <hashtable/nv_hashtable.hpp>
 
@@ -162,6 +165,55 @@ __global__ void dump_kernel(KeyType* d_key, ValType* d_val, const Table* table,
   }
 }
 
+template <typename Table, typename KeyType>
+__global__ void home_bucket_kernel(const KeyType* const keys, size_t len,
+                                   const size_t hash_capacity, size_t* home_buckets,
+                                   size_t* indices) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    typename Table::hasher hf;
+    home_buckets[i] = hf(keys[i]) % hash_capacity;
+    indices[i] = i;
+  }
+}
+
+__global__ void probe_shift_kernel(const size_t* const home_buckets, size_t len, int64_t* shifts) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    shifts[i] = static_cast<int64_t>(home_buckets[i]) - static_cast<int64_t>(i);
+  }
+}
+
+/* Scatter the pairs (sorted by home bucket) straight into the final linear-probing slots.
+ * With the pairs in home-bucket order, the slot the sequential probing would end up in is
+ * slot_i = i + max_{j<=i}(home_j - j): it is home_i if the cluster starts here, and the
+ * slot right after the previous pair otherwise. Every slot is owned by exactly one thread,
+ * so plain stores suffice. The rare pairs pushed past the last bucket must wrap around and
+ * probe against the already-placed ones, so they are collected and inserted via the CAS
+ * path afterwards. */
+template <typename Table, typename KeyType, typename ValType>
+__global__ void bulk_scatter_kernel(Table* table, const KeyType* const keys,
+                                    const ValType* const vals, const size_t* const indices,
+                                    const int64_t* const max_shifts, size_t len,
+                                    const size_t hash_capacity, KeyType* overflow_keys,
+                                    ValType* overflow_vals, size_t* overflow_count) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    const size_t src = indices[i];
+    const size_t slot = static_cast<size_t>(max_shifts[i] + static_cast<int64_t>(i));
+    if (slot < hash_capacity) {
+      typename Table::value_type pair;
+      pair.first = keys[src];
+      pair.second = vals[src];
+      store_pair_vectorized(table->data() + slot, pair);
+    } else {
+      const size_t j = atomicAdd(overflow_count, static_cast<size_t>(1));
+      overflow_keys[j] = keys[src];
+      overflow_vals[j] = vals[src];
+    }
+  }
+}
+
 }  // namespace
 
 template <typename KeyType, typename ValType>
@@ -302,6 +354,113 @@ void HashTable<KeyType, ValType>::clear(cudaStream_t stream) {
   set_value_head(0, stream);
 }
 
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::bulk_build(const KeyType* d_keys, const ValType* d_vals,
+                                             size_t len, cudaStream_t stream) {
+  if (len == 0) {
+    return;
+  }
+  HCTR_CHECK_HINT(len <= capacity_,
+                  "bulk_build: %zu pairs exceed the hash table capacity %zu. Please increase the "
+                  "capacity of the hash table.",
+                  len, capacity_);
+
+  using Table = HashTableContainer<KeyType, ValType>;
+  const size_t hash_capacity = container_->size();
+
+  // Query the scratch sizes of the cub primitives and share one scratch buffer between them.
+  size_t sort_temp_bytes = 0;
+  HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(nullptr, sort_temp_bytes,
+                                                 static_cast<const size_t*>(nullptr),
+                                                 static_cast<size_t*>(nullptr),
+                                                 static_cast<const size_t*>(nullptr),
+                                                 static_cast<size_t*>(nullptr), len, 0,
+                                                 static_cast<int>(sizeof(size_t) * 8), stream));
+  size_t scan_temp_bytes = 0;
+  HCTR_LIB_THROW(cub::DeviceScan::InclusiveScan(nullptr, scan_temp_bytes,
+                                                static_cast<const int64_t*>(nullptr),
+                                                static_cast<int64_t*>(nullptr), cub::Max(), len,
+                                                stream));
+  const size_t temp_bytes = std::max(sort_temp_bytes, scan_temp_bytes);
+
+  size_t* d_home_buckets;  // [0, len): unsorted, [len, 2 * len): sorted by home bucket
+  size_t* d_indices;       // [0, len): iota, [len, 2 * len): permutation of the sort
+  int64_t* d_shifts;       // [0, len): home_i - i, [len, 2 * len): its inclusive prefix-max
+  KeyType* d_overflow_keys;
+  ValType* d_overflow_vals;
+  size_t* d_overflow_count;
+  void* d_temp;
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_home_buckets, 2 * len * sizeof(size_t)));
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_indices, 2 * len * sizeof(size_t)));
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_shifts, 2 * len * sizeof(int64_t)));
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_overflow_keys, len * sizeof(KeyType)));
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_overflow_vals, len * sizeof(ValType)));
+  HCTR_LIB_THROW(cudaMalloc((void**)&d_overflow_count, sizeof(size_t)));
+  HCTR_LIB_THROW(cudaMalloc(&d_temp, temp_bytes));
+
+  // Only the bits which can appear in a bucket index take part in the radix sort.
+  int end_bit = 1;
+  while (end_bit < static_cast<int>(sizeof(size_t) * 8) && ((hash_capacity - 1) >> end_bit) != 0) {
+    end_bit++;
+  }
+
+  const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
+  home_bucket_kernel<Table><<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_keys, len, hash_capacity,
+                                                                   d_home_buckets, d_indices);
+  size_t temp_bytes_in_use = temp_bytes;
+  HCTR_LIB_THROW(cub::DeviceRadixSort::SortPairs(d_temp, temp_bytes_in_use, d_home_buckets,
+                                                 d_home_buckets + len, d_indices, d_indices + len,
+                                                 len, 0, end_bit, stream));
+  probe_shift_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(d_home_buckets + len, len, d_shifts);
+  temp_bytes_in_use = temp_bytes;
+  HCTR_LIB_THROW(cub::DeviceScan::InclusiveScan(d_temp, temp_bytes_in_use, d_shifts,
+                                                d_shifts + len, cub::Max(), len, stream));
+  HCTR_LIB_THROW(cudaMemsetAsync(d_overflow_count, 0, sizeof(size_t), stream));
+  bulk_scatter_kernel<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+      container_, d_keys, d_vals, d_indices + len, d_shifts + len, len, hash_capacity,
+      d_overflow_keys, d_overflow_vals, d_overflow_count);
+
+  // The pairs pushed past the last bucket wrap around; they go through the regular CAS path.
+  size_t overflow_count;
+  HCTR_LIB_THROW(cudaMemcpyAsync(&overflow_count, d_overflow_count, sizeof(size_t),
+                                 cudaMemcpyDeviceToHost, stream));
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  if (overflow_count > 0) {
+    insert(d_overflow_keys, d_overflow_vals, overflow_count, stream);
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  }
+
+  HCTR_LIB_THROW(cudaFree(d_home_buckets));
+  HCTR_LIB_THROW(cudaFree(d_indices));
+  HCTR_LIB_THROW(cudaFree(d_shifts));
+  HCTR_LIB_THROW(cudaFree(d_overflow_keys));
+  HCTR_LIB_THROW(cudaFree(d_overflow_vals));
+  HCTR_LIB_THROW(cudaFree(d_overflow_count));
+  HCTR_LIB_THROW(cudaFree(d_temp));
+}
+
+template <typename KeyType, typename ValType>
+size_t HashTable<KeyType, ValType>::image_size_in_bytes() const {
+  return container_->size() * sizeof(typename HashTableContainer<KeyType, ValType>::value_type);
+}
+
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::dump_image(void* d_image, cudaStream_t stream) const {
+  HCTR_LIB_THROW(cudaMemcpyAsync(d_image, container_->data(), image_size_in_bytes(),
+                                 cudaMemcpyDeviceToDevice, stream));
+}
+
+template <typename KeyType, typename ValType>
+void HashTable<KeyType, ValType>::restore_image(const void* d_image, size_t image_size_in_bytes,
+                                                cudaStream_t stream) {
+  HCTR_CHECK_HINT(image_size_in_bytes == this->image_size_in_bytes(),
+                  "restore_image: the image size %zu doesn't match the bucket array size %zu. The "
+                  "image must come from a hash table of the same capacity and key/value types.",
+                  image_size_in_bytes, this->image_size_in_bytes());
+  HCTR_LIB_THROW(cudaMemcpyAsync(container_->data(), d_image, image_size_in_bytes,
+                                 cudaMemcpyDeviceToDevice, stream));
+}
+
 template class HashTable<unsigned int, size_t>;
 template class HashTable<long long, size_t>;
 
@@ -15,10 +15,13 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <core23/staging_buffer_pool.hpp>
 #include <hps/embedding_cache.hpp>
 //#include <hps/embedding_cache_stoch.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/memory_pool.hpp>
+#include <hps/metrics.hpp>
 #include <hps/static_table.hpp>
 #include <hps/uvm_table.hpp>
 #include <io/filesystem.hpp>
@@ -203,6 +206,12 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
     }
   }
 
+  // Hit-rate telemetry for the adaptive cache refresher.
+  tracked_hit_rate_ = std::make_unique<std::atomic<double>[]>(cache_config_.num_emb_table_);
+  for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+    tracked_hit_rate_[i].store(-1.0, std::memory_order_relaxed);
+  }
+
   // Construct gpu embedding cache, 1 per embedding table
   if (cache_config_.use_gpu_embedding_cache_) {
     // This is the only two places to set the cuda context in embedding cache
@@ -211,13 +220,24 @@ EmbeddingCache<TypeHashKey>::EmbeddingCache(const InferenceParams& inference_par
 
     // Allocate resources.
     gpu_emb_caches_.reserve(cache_config_.num_emb_table_);
+    if (inference_params.fp8_quant && cache_config_.use_hctr_cache_implementation) {
+      HCTR_LOG(WARNING, ROOT,
+               "fp8_quant is not supported by the HugeCTR cache implementation; the embedding "
+               "cache will store fp32 vectors.\n");
+    }
+    const bool fp8_quant =
+        inference_params.fp8_quant && !cache_config_.use_hctr_cache_implementation;
+    if (fp8_quant) {
+      HCTR_LOG(INFO, ROOT, "Store FP8 quantized embedding vectors in the embedding cache.\n");
+    }
     for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
       if (cache_config_.use_hctr_cache_implementation) {
         gpu_emb_caches_.emplace_back(std::make_unique<NVCache>(
             cache_config_.num_set_in_cache_[i], cache_config_.embedding_vec_size_[i]));
       } else {
         gpu_emb_caches_.emplace_back(std::make_unique<EmbeddingCacheWrapper<TypeHashKey>>(
-            cache_config_.num_set_in_cache_[i], cache_config_.embedding_vec_size_[i]));
+            cache_config_.num_set_in_cache_[i], cache_config_.embedding_vec_size_[i], fp8_quant,
+            cache_config_.max_query_len_per_emb_table_[i]));
       }
     }
 
@@ -253,11 +273,71 @@ EmbeddingCache<TypeHashKey>::~EmbeddingCache() {
       cudaStreamDestroy(stream);
     }
     refresh_streams_.clear();
+    for (auto& stream : peer_streams_) {
+      cudaStreamDestroy(stream);
+    }
+    peer_streams_.clear();
+    if (d_peer_missing_length_) {
+      cudaFree(d_peer_missing_length_);
+      d_peer_missing_length_ = nullptr;
+    }
+    if (h_peer_missing_length_) {
+      cudaFreeHost(h_peer_missing_length_);
+      h_peer_missing_length_ = nullptr;
+    }
 
     gpu_emb_caches_.clear();
   }
 }
 
+template <typename TypeHashKey>
+void EmbeddingCache<TypeHashKey>::set_sibling_caches(
+    const std::vector<std::shared_ptr<EmbeddingCacheBase>>& siblings) {
+  if (!cache_config_.use_gpu_embedding_cache_ || siblings.empty()) {
+    return;
+  }
+  CudaDeviceContext dev_restorer;
+  dev_restorer.set_device(cache_config_.cuda_dev_id_);
+  sibling_caches_.assign(siblings.begin(), siblings.end());
+  peer_streams_.reserve(cache_config_.num_emb_table_);
+  for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+    cudaStream_t stream;
+    cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+    peer_streams_.push_back(stream);
+  }
+  HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&d_peer_missing_length_),
+                            cache_config_.num_emb_table_ * sizeof(size_t)));
+  HCTR_LIB_THROW(cudaHostAlloc(reinterpret_cast<void**>(&h_peer_missing_length_),
+                               cache_config_.num_emb_table_ * sizeof(size_t),
+                               cudaHostAllocPortable));
+  peer_sharding_ = true;
+}
+
+template <typename TypeHashKey>
+size_t EmbeddingCache<TypeHashKey>::peer_query(size_t const table_id, const void* const d_keys,
+                                               size_t const num_keys, float* const d_vectors,
+                                               uint64_t* const d_missing_index,
+                                               void* const d_missing_keys) {
+  if (!peer_sharding_ || !cache_config_.use_gpu_embedding_cache_) {
+    return std::numeric_limits<size_t>::max();
+  }
+  // Serve the sibling on our own device and stream; all buffers belong to the caller and are
+  // reached through peer access. Peer queries from different siblings are serialized.
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  CudaDeviceContext dev_restorer;
+  dev_restorer.set_device(cache_config_.cuda_dev_id_);
+  const size_t task_per_warp_tile = (num_keys < 1000000) ? 1 : 32;
+  gpu_emb_caches_[table_id]->Query(static_cast<const TypeHashKey*>(d_keys), num_keys, d_vectors,
+                                   d_missing_index, static_cast<TypeHashKey*>(d_missing_keys),
+                                   d_peer_missing_length_ + table_id, peer_streams_[table_id],
+                                   task_per_warp_tile);
+  HCTR_LIB_THROW(cudaMemcpyAsync(h_peer_missing_length_ + table_id,
+                                 d_peer_missing_length_ + table_id, sizeof(size_t),
+                                 cudaMemcpyDeviceToHost, peer_streams_[table_id]));
+  HCTR_LIB_THROW(cudaStreamSynchronize(peer_streams_[table_id]));
+  return h_peer_missing_length_[table_id];
+}
+
 template <typename TypeHashKey>
 void EmbeddingCache<TypeHashKey>::lookup(size_t const table_id, float* const d_vectors,
                                          const void* const h_keys, size_t const num_keys,
@@ -388,6 +468,62 @@ void EmbeddingCache<TypeHashKey>::lookup_from_device(size_t const table_id, floa
     // Set async flag
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
     ec_profiler_->end(start, "Native Embedding Cache Query API");
+
+    // Peer-sharded mode: chain the miss list through the sibling devices' caches over peer access
+    // before falling back to the database backend. Keys a sibling resolves never reach the insert
+    // path below, so each row stays resident on the first device that fetched it and the
+    // aggregate HBM of the node acts as one cache tier.
+    if (peer_sharding_ && workspace_handler.h_missing_length_[table_id] > 0 &&
+        !workspace_handler.d_peer_missing_index_.empty()) {
+      start = profiler::start();
+      for (auto& sibling_weak : sibling_caches_) {
+        const size_t stage_length = workspace_handler.h_missing_length_[table_id];
+        if (stage_length == 0) {
+          break;
+        }
+        const auto sibling = sibling_weak.lock();
+        if (!sibling) {
+          continue;
+        }
+        const size_t stage_missing_length = sibling->peer_query(
+            table_id, workspace_handler.d_missing_embeddingcolumns_[table_id], stage_length,
+            workspace_handler.d_missing_emb_vec_[table_id],
+            workspace_handler.d_peer_missing_index_[table_id],
+            workspace_handler.d_peer_missing_embeddingcolumns_[table_id]);
+        if (stage_missing_length == std::numeric_limits<size_t>::max()) {
+          continue;
+        }
+        // Patch the compacted hit buffer with the rows the sibling resolved. Rows the sibling
+        // also missed stay stale for now; later stages or the backend fetch below patch them,
+        // always through the then-current miss index on the same stream.
+        merge_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
+                            workspace_handler.d_missing_emb_vec_[table_id],
+                            workspace_handler.d_missing_index_[table_id], stage_length,
+                            cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_, stream);
+        // Map the sibling's miss positions (relative to this stage's input) back to the unique
+        // key space and make its missed keys the next stage's input.
+        compose_missing_index_async(workspace_handler.d_peer_missing_index_[table_id],
+                                    workspace_handler.d_missing_index_[table_id],
+                                    stage_missing_length, BLOCK_SIZE_, stream);
+        HCTR_LIB_THROW(cudaMemcpyAsync(workspace_handler.d_missing_index_[table_id],
+                                       workspace_handler.d_peer_missing_index_[table_id],
+                                       stage_missing_length * sizeof(uint64_t),
+                                       cudaMemcpyDeviceToDevice, stream));
+        HCTR_LIB_THROW(cudaMemcpyAsync(
+            workspace_handler.d_missing_embeddingcolumns_[table_id],
+            workspace_handler.d_peer_missing_embeddingcolumns_[table_id],
+            stage_missing_length * sizeof(TypeHashKey), cudaMemcpyDeviceToDevice, stream));
+        // The next sibling reads these buffers on its own stream, so they must be materialized
+        // before its peer query starts.
+        HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+        workspace_handler.h_missing_length_[table_id] = stage_missing_length;
+      }
+      HCTR_LIB_THROW(cudaMemcpyAsync(workspace_handler.d_missing_length_ + table_id,
+                                     workspace_handler.h_missing_length_ + table_id,
+                                     sizeof(size_t), cudaMemcpyHostToDevice, stream));
+      ec_profiler_->end(start, "Chained peer embedding cache lookup");
+    }
+
     if (workspace_handler.h_unique_length_[table_id] == 0) {
       workspace_handler.h_hit_rate_[table_id] = 1.0;
     } else {
@@ -399,22 +535,76 @@ void EmbeddingCache<TypeHashKey>::lookup_from_device(size_t const table_id, floa
     start = profiler::start(workspace_handler.h_hit_rate_[table_id], ProfilerType_t::Occupancy);
     ec_profiler_->end(start, "The hit rate of Embedding Cache", ProfilerType_t::Occupancy);
 
-    // Handle the missing keys mode 1: synchronous
+    // Fold the observation into the smoothed hit rate (concurrent updates may race; losing an
+    // observation is acceptable for telemetry).
+    {
+      constexpr double ema_weight{0.05};
+      const double observed{workspace_handler.h_hit_rate_[table_id]};
+      const double prev{tracked_hit_rate_[table_id].load(std::memory_order_relaxed)};
+      tracked_hit_rate_[table_id].store(
+          prev < 0.0 ? observed : prev + ema_weight * (observed - prev), std::memory_order_relaxed);
+    }
+    metrics::Registry::instance().lookup_keys.add(workspace_handler.h_unique_length_[table_id]);
+    metrics::Registry::instance().lookup_hit_keys.add(
+        workspace_handler.h_unique_length_[table_id] -
+        workspace_handler.h_missing_length_[table_id]);
+
+    // Handle the missing keys mode 1: fetch from the database backend, overlapped with
+    // the hit-vector gather on the lookup stream
     if (!async_insert_flag) {
       start = profiler::start();
-      parameter_server_->insert_embedding_cache(table_id, this->shared_from_this(),
-                                                workspace_handler, stream);
-      // Wait for memory copy to complete
-      // HCTR_LIB_THROW(cudaStreamSynchronize(stream));
-      ec_profiler_->end(start, "Missing key synchronization insert into Embedding Cache");
+      // Decompress the hit emb_vec buffer to output buffer right away; output rows of
+      // missing keys contain stale data until the scatter below patches them
+      decompress_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
+                               workspace_handler.d_unique_output_index_[table_id], d_vectors,
+                               num_keys, cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_,
+                               stream);
+      // Fetch the missing keys from the database backend on a worker thread so the
+      // fetch runs concurrently with the gather above
+      const auto fetch_begin = std::chrono::steady_clock::now();
+      auto fetch_done = insert_workers_.submit([this, self(this->shared_from_this()), table_id,
+                                                workspace_handler]() mutable {
+        try {
+          std::lock_guard<std::mutex> lock(stream_mutex_);
+          CudaDeviceContext dev_restorer{cache_config_.cuda_dev_id_};
+          cudaEvent_t fetch_event;
+          HCTR_LIB_THROW(cudaEventCreate(&fetch_event));
+          parameter_server_->insert_embedding_cache(table_id, self, workspace_handler,
+                                                    insert_streams_[table_id]);
+          HCTR_LIB_THROW(cudaEventRecord(fetch_event, insert_streams_[table_id]));
+          HCTR_LIB_THROW(cudaEventSynchronize(fetch_event));
+          HCTR_LIB_THROW(cudaEventDestroy(fetch_event));
+        } catch (const std::runtime_error& rt_err) {
+          HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
+        }
+      });
+      fetch_done.get();
+      metrics::Registry::instance().miss_fetch_latency_us.observe(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                fetch_begin)
+              .count()));
+      ec_profiler_->end(start,
+                        "Missing key fetch from database backend overlapped with hit gather");
       start = profiler::start();
+      // Patch the compressed hit buffer and scatter only the late arrivals to the output
       merge_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
                           workspace_handler.d_missing_emb_vec_[table_id],
                           workspace_handler.d_missing_index_[table_id],
                           workspace_handler.h_missing_length_[table_id],
                           cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_, stream);
-      ec_profiler_->end(start, "Merge output from Embedding Cache", ProfilerType_t::Timeliness,
-                        stream);
+      HCTR_LIB_THROW(cudaMemsetAsync(workspace_handler.d_missing_flag_[table_id], 0,
+                                     workspace_handler.h_unique_length_[table_id] * sizeof(char),
+                                     stream));
+      mark_missing_flag_async(workspace_handler.d_missing_flag_[table_id],
+                              workspace_handler.d_missing_index_[table_id],
+                              workspace_handler.h_missing_length_[table_id], BLOCK_SIZE_, stream);
+      scatter_missing_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
+                                    workspace_handler.d_unique_output_index_[table_id],
+                                    workspace_handler.d_missing_flag_[table_id], d_vectors,
+                                    num_keys, cache_config_.embedding_vec_size_[table_id],
+                                    BLOCK_SIZE_, stream);
+      ec_profiler_->end(start, "Scatter late-arriving missing vectors to output",
+                        ProfilerType_t::Timeliness, stream);
     }
     // mode 2: Asynchronous
     else {
@@ -426,17 +616,20 @@ void EmbeddingCache<TypeHashKey>::lookup_from_device(size_t const table_id, floa
                                  cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_, stream);
       ec_profiler_->end(start, "Fill default embedding vector asynchronously",
                         ProfilerType_t::Timeliness, stream);
+      start = profiler::start();
+      // Decompress the hit emb_vec buffer to output buffer
+      decompress_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
+                               workspace_handler.d_unique_output_index_[table_id], d_vectors,
+                               num_keys, cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_,
+                               stream);
+      ec_profiler_->end(start, "decompress/deunique output from Embedding Cache",
+                        ProfilerType_t::Timeliness, stream);
     }
     start = profiler::start();
-    // Decompress the hit emb_vec buffer to output buffer
-    decompress_emb_vec_async(workspace_handler.d_hit_emb_vec_[table_id],
-                             workspace_handler.d_unique_output_index_[table_id], d_vectors,
-                             num_keys, cache_config_.embedding_vec_size_[table_id], BLOCK_SIZE_,
-                             stream);
     // Clear the unique op object to be ready for next lookup
     static_cast<UniqueOp*>(workspace_handler.unique_op_obj_[table_id])->clear(stream);
     HCTR_LIB_THROW(cudaStreamSynchronize(stream));
-    ec_profiler_->end(start, "decompress/deunique output from Embedding Cache");
+    ec_profiler_->end(start, "Clear the unique op and synchronize the lookup stream");
 
     // Handle the missing keys, mode 2: synchronous
     if (async_insert_flag) {
@@ -649,6 +842,26 @@ EmbeddingCacheWorkspace EmbeddingCache<TypeHashKey>::create_workspace() {
                                     cache_config_.embedding_vec_size_[i] * sizeof(float)));
       workspace_handler.d_missing_emb_vec_.push_back(d_missing_emb_vec);
 
+      char* d_missing_flag;
+      HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&d_missing_flag),
+                                cache_config_.max_query_len_per_emb_table_[i] * sizeof(char)));
+      workspace_handler.d_missing_flag_.push_back(d_missing_flag);
+
+      if (peer_sharding_) {
+        void* d_peer_missing_embeddingcolumns;
+        HCTR_LIB_THROW(
+            cudaMalloc(&d_peer_missing_embeddingcolumns,
+                       cache_config_.max_query_len_per_emb_table_[i] * sizeof(TypeHashKey)));
+        workspace_handler.d_peer_missing_embeddingcolumns_.push_back(
+            d_peer_missing_embeddingcolumns);
+
+        uint64_t* d_peer_missing_index;
+        HCTR_LIB_THROW(
+            cudaMalloc(reinterpret_cast<void**>(&d_peer_missing_index),
+                       cache_config_.max_query_len_per_emb_table_[i] * sizeof(uint64_t)));
+        workspace_handler.d_peer_missing_index_.push_back(d_peer_missing_index);
+      }
+
       const size_t capacity = static_cast<size_t>(cache_config_.max_query_len_per_emb_table_[i] /
                                                   UNIQUE_OP_LOAD_FACTOR);
       workspace_handler.unique_op_obj_.push_back(new UniqueOp(capacity));
@@ -709,6 +922,14 @@ void EmbeddingCache<TypeHashKey>::destroy_workspace(EmbeddingCacheWorkspace& wor
       workspace_handler.d_missing_index_[i] = nullptr;
       HCTR_LIB_THROW(cudaFree(workspace_handler.d_missing_emb_vec_[i]));
       workspace_handler.d_missing_emb_vec_[i] = nullptr;
+      HCTR_LIB_THROW(cudaFree(workspace_handler.d_missing_flag_[i]));
+      workspace_handler.d_missing_flag_[i] = nullptr;
+      if (i < workspace_handler.d_peer_missing_embeddingcolumns_.size()) {
+        HCTR_LIB_THROW(cudaFree(workspace_handler.d_peer_missing_embeddingcolumns_[i]));
+        workspace_handler.d_peer_missing_embeddingcolumns_[i] = nullptr;
+        HCTR_LIB_THROW(cudaFree(workspace_handler.d_peer_missing_index_[i]));
+        workspace_handler.d_peer_missing_index_[i] = nullptr;
+      }
       delete static_cast<UniqueOp*>(workspace_handler.unique_op_obj_[i]);
     }
 
@@ -745,15 +966,14 @@ EmbeddingCacheRefreshspace EmbeddingCache<TypeHashKey>::create_refreshspace() {
     CudaDeviceContext dev_restorer;
     dev_restorer.check_device(cache_config_.cuda_dev_id_);
 
-    // Create memory buffers.
-    HCTR_LIB_THROW(cudaHostAlloc(&refreshspace_handler.h_refresh_embeddingcolumns_,
-                                 max_num_key_in_buffer * sizeof(TypeHashKey),
-                                 cudaHostAllocPortable));
-    HCTR_LIB_THROW(cudaHostAlloc(reinterpret_cast<void**>(&refreshspace_handler.h_refresh_emb_vec_),
-                                 max_num_key_in_buffer * max_embedding_size * sizeof(float),
-                                 cudaHostAllocPortable));
-    HCTR_LIB_THROW(cudaHostAlloc(reinterpret_cast<void**>(&refreshspace_handler.h_length_),
-                                 sizeof(size_t), cudaHostAllocPortable));
+    // Create memory buffers. The host side comes from the shared staging pool, so repeated
+    // refresh-space churn reuses the same registered pages instead of re-pinning them.
+    auto& staging_pool = core23::StagingBufferPool::instance();
+    refreshspace_handler.h_refresh_embeddingcolumns_ =
+        staging_pool.acquire(max_num_key_in_buffer * sizeof(TypeHashKey));
+    refreshspace_handler.h_refresh_emb_vec_ = static_cast<float*>(
+        staging_pool.acquire(max_num_key_in_buffer * max_embedding_size * sizeof(float)));
+    refreshspace_handler.h_length_ = static_cast<size_t*>(staging_pool.acquire(sizeof(size_t)));
     HCTR_LIB_THROW(cudaMalloc(&refreshspace_handler.d_refresh_embeddingcolumns_,
                               max_num_key_in_buffer * sizeof(TypeHashKey)));
     HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&refreshspace_handler.d_refresh_emb_vec_),
@@ -773,11 +993,12 @@ void EmbeddingCache<TypeHashKey>::destroy_refreshspace(
     dev_restorer.check_device(cache_config_.cuda_dev_id_);
 
     // Release resources.
-    HCTR_LIB_THROW(cudaFreeHost(refreshspace_handler.h_refresh_embeddingcolumns_));
+    auto& staging_pool = core23::StagingBufferPool::instance();
+    staging_pool.release(refreshspace_handler.h_refresh_embeddingcolumns_);
     refreshspace_handler.h_refresh_embeddingcolumns_ = nullptr;
-    HCTR_LIB_THROW(cudaFreeHost(refreshspace_handler.h_refresh_emb_vec_));
+    staging_pool.release(refreshspace_handler.h_refresh_emb_vec_);
     refreshspace_handler.h_refresh_emb_vec_ = nullptr;
-    HCTR_LIB_THROW(cudaFreeHost(refreshspace_handler.h_length_));
+    staging_pool.release(refreshspace_handler.h_length_);
     refreshspace_handler.h_length_ = nullptr;
 
     HCTR_LIB_THROW(cudaFree(refreshspace_handler.d_refresh_embeddingcolumns_));
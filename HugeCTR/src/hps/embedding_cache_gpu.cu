@@ -14,21 +14,95 @@
  * limitations under the License.
  */
 
+#include <cuda_fp8.h>
+
 #include <embedding_cache_combined.cuh>
 #include <hps/embedding_cache_gpu.hpp>
+#include <hps/quantize.hpp>
 #include <nv_gpu_cache.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
+namespace {
+
+__forceinline__ __device__ float warp_reduce_max(float val) {
+#pragma unroll
+  for (int mask = 16; mask > 0; mask >>= 1) {
+    val = max(val, __shfl_xor_sync(0xffffffff, val, mask, 32));
+  }
+  return val;
+}
+
+// One block per row: compute the row amax, derive the per-row scale (same formula as
+// quantize.cu) and store the row as [fp8 x vec_size][pad][float scale] with stride row_bytes
+__global__ void quantize_rows_kernel(const float* in, const size_t vec_size, int8_t* out,
+                                     const size_t row_bytes) {
+  __shared__ float s_max[32];
+  __shared__ float s_scale;
+  const size_t row = blockIdx.x;
+  const float* src = in + row * vec_size;
+  int8_t* dst = out + row * row_bytes;
+
+  float amax = 0.f;
+  for (size_t i = threadIdx.x; i < vec_size; i += blockDim.x) {
+    amax = max(amax, fabsf(src[i]));
+  }
+  amax = warp_reduce_max(amax);
+  if ((threadIdx.x & 0x1f) == 0) {
+    s_max[threadIdx.x >> 5] = amax;
+  }
+  __syncthreads();
+  if (threadIdx.x == 0) {
+    float block_max = 0.f;
+    for (unsigned int i = 0; i < (blockDim.x + 31) / 32; i++) {
+      block_max = max(block_max, s_max[i]);
+    }
+    constexpr float min_scaling_factor = 1 / (FP8_E4M3_MAX * CLAMP);
+    s_scale = max(block_max / FP8_E4M3_MAX, min_scaling_factor);
+    *reinterpret_cast<float*>(dst + row_bytes - sizeof(float)) = s_scale;
+  }
+  __syncthreads();
+  const float scale = s_scale;
+  for (size_t i = threadIdx.x; i < vec_size; i += blockDim.x) {
+    reinterpret_cast<__nv_fp8_e4m3*>(dst)[i] = __nv_fp8_e4m3(src[i] / scale);
+  }
+}
+
+__global__ void dequantize_rows_kernel(const int8_t* in, const size_t vec_size,
+                                       const size_t row_bytes, float* out) {
+  const size_t row = blockIdx.x;
+  const int8_t* src = in + row * row_bytes;
+  const float scale = *reinterpret_cast<const float*>(src + row_bytes - sizeof(float));
+  float* dst = out + row * vec_size;
+  for (size_t i = threadIdx.x; i < vec_size; i += blockDim.x) {
+    dst[i] = float(reinterpret_cast<const __nv_fp8_e4m3*>(src)[i]) * scale;
+  }
+}
+
+dim3 quant_block_dim(const size_t vec_size) {
+  return dim3(std::min<size_t>((vec_size + 31) / 32 * 32, 256));
+}
+
+}  // namespace
+
 template <typename key_type>
 EmbeddingCacheWrapper<key_type>::EmbeddingCacheWrapper(const size_t capacity_in_set,
-                                                       const size_t embedding_vec_size) {
-  config_.cacheSzInBytes =
-      SLAB_SIZE * SET_ASSOCIATIVITY * capacity_in_set * embedding_vec_size * sizeof(float);
-  config_.embedWidth = embedding_vec_size * sizeof(float);
+                                                       const size_t embedding_vec_size,
+                                                       const bool fp8_quant,
+                                                       const size_t max_query_len)
+    : fp8_quant_(fp8_quant),
+      embedding_vec_size_(embedding_vec_size),
+      max_query_len_(max_query_len) {
+  // Quantized rows hold fp8 elements followed by the per-row scale, padded so that the scale
+  // stays 4-byte aligned
+  config_.embedWidth =
+      fp8_quant ? (embedding_vec_size * sizeof(__nv_fp8_e4m3) + 3) / 4 * 4 + sizeof(float)
+                : embedding_vec_size * sizeof(float);
+  config_.cacheSzInBytes = SLAB_SIZE * SET_ASSOCIATIVITY * capacity_in_set * config_.embedWidth;
   maxUpdateSampleSz = capacity_in_set * EmbedCache<key_type, key_type>::NUM_WAYS;
   config_.numTables = 1;
+  assert(!fp8_quant_ || max_query_len_ > 0);
   cache_ptr_ = std::make_shared<EmbedCache<key_type, key_type>>(&allocator_, &logger_, config_);
   cache_ptr_->Init();
 }
@@ -55,6 +129,9 @@ template <typename key_type>
 void EmbeddingCacheWrapper<key_type>::DestroyPerStreamLookupData(PerStreamLookupData& lookup) {
   CUDA_CHECK(cudaEventDestroy(lookup.event));
   cache_ptr_->LookupContextDestroy(lookup.hLookup);
+  if (lookup.dQuantValues) {
+    CUDA_CHECK(cudaFree(lookup.dQuantValues));
+  }
 }
 
 template <typename key_type>
@@ -62,6 +139,9 @@ void EmbeddingCacheWrapper<key_type>::DestroyPerStreamModifyData(PerStreamModify
   CUDA_CHECK(cudaEventDestroy(modify.wait_token));
   cache_ptr_->ModifyContextDestroy(modify.hUpdate);
   CUDA_CHECK(cudaFreeHost(modify.hIndices));
+  if (modify.dQuantValues) {
+    CUDA_CHECK(cudaFree(modify.dQuantValues));
+  }
 }
 
 // Query API, i.e. A single read from the cache
@@ -73,8 +153,15 @@ void EmbeddingCacheWrapper<key_type>::Query(const key_type* d_keys, const size_t
   // ReadLock l(read_write_lock_);
   auto hLookup = GetLookupData(stream);
   // call cache Query
-  cache_ptr_->Lookup(hLookup.hLookup, d_keys, len, (int8_t*)d_values, d_missing_index,
-                     d_missing_keys, d_missing_len, 0, config_.embedWidth, stream);
+  int8_t* lookup_dst = fp8_quant_ ? hLookup.dQuantValues : (int8_t*)d_values;
+  cache_ptr_->Lookup(hLookup.hLookup, d_keys, len, lookup_dst, d_missing_index, d_missing_keys,
+                     d_missing_len, 0, config_.embedWidth, stream);
+  if (fp8_quant_ && len > 0) {
+    // Expand the quantized rows into the caller's fp32 buffer. Rows of missing keys contain
+    // stale data, consistent with the non-quantized path; the caller patches them afterwards
+    dequantize_rows_kernel<<<len, quant_block_dim(embedding_vec_size_), 0, stream>>>(
+        hLookup.dQuantValues, embedding_vec_size_, config_.embedWidth, d_values);
+  }
   CUDA_CHECK(cudaEventRecord(hLookup.event, stream));
 }
 
@@ -125,6 +212,9 @@ EmbeddingCacheWrapper<key_type>::PerStreamLookupData EmbeddingCacheWrapper<key_t
     if (lookup_handle_map_.find(stream) == lookup_handle_map_.end()) {
       cache_ptr_->LookupContextCreate(ret.hLookup, nullptr, 0);
       CUDA_CHECK(cudaEventCreate(&ret.event));
+      if (fp8_quant_) {
+        CUDA_CHECK(cudaMalloc(&ret.dQuantValues, max_query_len_ * config_.embedWidth));
+      }
       lookup_handle_map_[stream] = ret;
     }
     ret = lookup_handle_map_[stream];
@@ -155,6 +245,9 @@ EmbeddingCacheWrapper<key_type>::PerStreamModifyData EmbeddingCacheWrapper<key_t
       cache_ptr_->ModifyContextCreate(ret.hUpdate, maxUpdateSampleSz);
       CUDA_CHECK(cudaMallocHost(&ret.hIndices, maxUpdateSampleSz * sizeof(key_type)));
       CUDA_CHECK(cudaEventCreate(&ret.wait_token));
+      if (fp8_quant_) {
+        CUDA_CHECK(cudaMalloc(&ret.dQuantValues, maxUpdateSampleSz * config_.embedWidth));
+      }
       update_handle_map_[stream] = ret;
     }
     ret = update_handle_map_[stream];
@@ -172,16 +265,23 @@ void EmbeddingCacheWrapper<key_type>::ModifyInternal(const key_type* d_keys, con
   auto modifiedLen = std::min(len, (size_t)maxUpdateSampleSz);
   CUDA_CHECK(cudaMemcpyAsync(hUpdate.hIndices, d_keys, sizeof(key_type) * modifiedLen,
                              cudaMemcpyDefault, stream));
+  const int8_t* modify_values = (const int8_t*)d_values;
+  if (fp8_quant_ && modifiedLen > 0) {
+    // Compress the incoming fp32 rows to the quantized row layout before handing them over
+    quantize_rows_kernel<<<modifiedLen, quant_block_dim(embedding_vec_size_), 0, stream>>>(
+        d_values, embedding_vec_size_, hUpdate.dQuantValues, config_.embedWidth);
+    modify_values = hUpdate.dQuantValues;
+  }
   CUDA_CHECK(cudaStreamSynchronize(stream));
   switch (op) {
     case ModifyOp::MODIFY_UPDATE:
       cache_ptr_->ModifyContextSetUpdateDataDenseData(hUpdate.hUpdate, hUpdate.hIndices,
-                                                      modifiedLen, (const int8_t*)d_values, 0,
+                                                      modifiedLen, modify_values, 0,
                                                       config_.embedWidth);
       break;
     case ModifyOp::MODIFY_REPLACE:
       cache_ptr_->ModifyContextSetReplaceDataDenseData(hUpdate.hUpdate, hUpdate.hIndices,
-                                                       modifiedLen, (const int8_t*)d_values, 0,
+                                                       modifiedLen, modify_values, 0,
                                                        config_.embedWidth);
       break;
     default:
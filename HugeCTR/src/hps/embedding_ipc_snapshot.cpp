@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core23/logger.hpp>
+#include <fstream>
+#include <hps/embedding_cache_base.hpp>
+#include <hps/embedding_ipc_snapshot.hpp>
+#include <utils.hpp>
+#include <vector>
+
+namespace HugeCTR {
+
+void ingest_ipc_snapshot(const std::string& descriptor_path,
+                         std::shared_ptr<EmbeddingCacheBase> embedding_cache) {
+  std::ifstream file(descriptor_path, std::ios::binary);
+  HCTR_CHECK_HINT(file.is_open(), "Cannot open IPC snapshot descriptor %s",
+                  descriptor_path.c_str());
+
+  EmbeddingIpcShardHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  HCTR_CHECK_HINT(file.good() && header.magic == EMBEDDING_IPC_MAGIC,
+                  "%s is not an embedding IPC snapshot descriptor", descriptor_path.c_str());
+  HCTR_CHECK_HINT(header.version == EMBEDDING_IPC_VERSION,
+                  "Unsupported embedding IPC snapshot version %u", header.version);
+
+  std::vector<EmbeddingIpcTableRecord> records(header.num_tables);
+  file.read(reinterpret_cast<char*>(records.data()),
+            records.size() * sizeof(EmbeddingIpcTableRecord));
+  HCTR_CHECK_HINT(file.good(), "Truncated embedding IPC snapshot descriptor %s",
+                  descriptor_path.c_str());
+
+  CudaDeviceContext context(embedding_cache->get_device_id());
+
+  void* keys_allocation = nullptr;
+  void* vectors_allocation = nullptr;
+  HCTR_LIB_THROW(
+      cudaIpcOpenMemHandle(&keys_allocation, header.keys_handle, cudaIpcMemLazyEnablePeerAccess));
+  HCTR_LIB_THROW(cudaIpcOpenMemHandle(&vectors_allocation, header.vectors_handle,
+                                      cudaIpcMemLazyEnablePeerAccess));
+  const char* keys = static_cast<const char*>(keys_allocation) + header.keys_base_offset_bytes;
+  const char* vectors =
+      static_cast<const char*>(vectors_allocation) + header.vectors_base_offset_bytes;
+
+  cudaStream_t stream;
+  HCTR_LIB_THROW(cudaStreamCreate(&stream));
+  for (const auto& record : records) {
+    const void* d_keys = keys + record.key_offset * header.key_size_bytes;
+    const void* d_vectors = vectors + record.vector_offset * sizeof(float);
+    embedding_cache->refresh(record.table_id, d_keys, d_vectors, record.num_keys, stream);
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    HCTR_LOG_S(INFO, ROOT) << "IPC snapshot: refreshed table " << record.table_id << " with "
+                           << record.num_keys << " keys peer-to-peer" << std::endl;
+  }
+  HCTR_LIB_THROW(cudaStreamDestroy(stream));
+
+  HCTR_LIB_THROW(cudaIpcCloseMemHandle(keys_allocation));
+  HCTR_LIB_THROW(cudaIpcCloseMemHandle(vectors_allocation));
+}
+
+}  // namespace HugeCTR
@@ -36,17 +36,21 @@ HashMapBackend<Key>::HashMapBackend(const HashMapBackendParams& params) : Base(p
 
 template <typename Key>
 size_t HashMapBackend<Key>::size(const std::string& table_name) const {
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<const TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return 0;
   }
-  const std::vector<Partition>& parts{tables_it->second};
+  const std::vector<Partition>& parts{*tables_it->second};
 
-  return std::accumulate(parts.begin(), parts.end(), UINT64_C(0),
-                         [](const size_t a, const Partition& b) { return a + b.entries.size(); });
+  size_t num_entries{0};
+  for (const Partition& part : parts) {
+    const std::shared_lock part_lock(*part.guard);
+    num_entries += part.entries.size();
+  }
+  return num_entries;
 }
 
 template <typename Key>
@@ -54,14 +58,14 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
                                      const Key* const keys,
                                      const std::chrono::nanoseconds& time_budget) const {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<const TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return Base::contains(table_name, num_keys, keys, time_budget);
   }
-  const std::vector<Partition>& parts{tables_it->second};
+  const std::vector<Partition>& parts{*tables_it->second};
 
   const Key* const keys_end{&keys[num_keys]};
   const size_t num_partitions{parts.size()};
@@ -75,6 +79,7 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
   } else if (num_keys == 1 || num_partitions == 1) {
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     const Partition& part{parts[part_index]};
+    const std::shared_lock part_lock(*part.guard);
 
     // Step through keys batch-by-batch.
     std::chrono::nanoseconds elapsed;
@@ -96,6 +101,7 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
 
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       const Partition& part{parts[part_index]};
+      const std::shared_lock part_lock(*part.guard);
 
       size_t hit_count{0};
 
@@ -132,19 +138,29 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
                                    const uint32_t value_size, const size_t value_stride) {
   HCTR_CHECK(value_size <= value_stride);
 
-  const std::unique_lock lock(read_write_guard_);
+  const std::unique_lock lock(write_guard_);
 
-  // Locate the partitions, or create them, if they do not exist yet.
-  const auto& tables_it{tables_.try_emplace(table_name).first};
-  std::vector<Partition>& parts{tables_it->second};
-  if (parts.empty()) {
+  // Locate the partitions, or create them, if they do not exist yet. New tables are
+  // published by atomically swapping in a copied table-map snapshot, so concurrent
+  // readers are never blocked.
+  std::shared_ptr<TableMap> tables{std::atomic_load(&tables_)};
+  auto tables_it{tables->find(table_name)};
+  if (tables_it == tables->end() || tables_it->second->empty()) {
     HCTR_CHECK(value_size > 0 && value_size <= this->params_.allocation_rate);
 
-    parts.reserve(this->params_.num_partitions);
-    while (parts.size() < this->params_.num_partitions) {
-      parts.emplace_back(value_size, this->params_);
+    const auto parts_ptr{std::make_shared<std::vector<Partition>>()};
+    parts_ptr->reserve(this->params_.num_partitions);
+    while (parts_ptr->size() < this->params_.num_partitions) {
+      parts_ptr->emplace_back(value_size, this->params_);
     }
+
+    const auto new_tables{std::make_shared<TableMap>(*tables)};
+    (*new_tables)[table_name] = parts_ptr;
+    std::atomic_store(&tables_, new_tables);
+    tables = new_tables;
+    tables_it = tables->find(table_name);
   }
+  std::vector<Partition>& parts{*tables_it->second};
 
   const Key* const keys_end{&keys[num_pairs]};
   const size_t num_partitions{parts.size()};
@@ -159,6 +175,7 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size == value_size);
+    const std::unique_lock part_lock(*part.guard);
 
     // Step through batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
@@ -183,6 +200,7 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size == value_size);
+      const std::unique_lock part_lock(*part.guard);
 
       size_t num_inserts{0};
 
@@ -222,14 +240,14 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
                                   const size_t value_stride, const DatabaseMissCallback& on_miss,
                                   const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return Base::fetch(table_name, num_keys, keys, values, value_stride, on_miss, time_budget);
   }
-  std::vector<Partition>& parts{tables_it->second};
+  std::vector<Partition>& parts{*tables_it->second};
 
   const Key* const keys_end{&keys[num_keys]};
   const size_t num_partitions{parts.size()};
@@ -245,6 +263,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
+    const std::shared_lock part_lock(*part.guard);
 
     // Step through input batch-by-batch.
     std::chrono::nanoseconds elapsed;
@@ -267,6 +286,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
+      const std::shared_lock part_lock(*part.guard);
 
       size_t miss_count{0};
 
@@ -306,15 +326,15 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
                                   const DatabaseMissCallback& on_miss,
                                   const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return Base::fetch(table_name, num_indices, indices, keys, values, value_stride, on_miss,
                        time_budget);
   }
-  std::vector<Partition>& parts{tables_it->second};
+  std::vector<Partition>& parts{*tables_it->second};
 
   const size_t* const indices_end{&indices[num_indices]};
   const size_t num_partitions{parts.size()};
@@ -330,6 +350,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
+    const std::shared_lock part_lock(*part.guard);
 
     // Step through input batch-by-batch.
     std::chrono::nanoseconds elapsed;
@@ -352,6 +373,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
+      const std::shared_lock part_lock(*part.guard);
 
       size_t miss_count{0};
 
@@ -386,21 +408,28 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
 
 template <typename Key>
 size_t HashMapBackend<Key>::evict(const std::string& table_name) {
-  const std::unique_lock lock(read_write_guard_);
+  const std::unique_lock lock(write_guard_);
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const std::shared_ptr<TableMap> tables{std::atomic_load(&tables_)};
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return 0;
   }
-  const std::vector<Partition>& parts{tables_it->second};
+  const std::shared_ptr<std::vector<Partition>> parts_ptr{tables_it->second};
 
-  // Count items and erase.
+  // Unlink the table by swapping in a snapshot without it; readers still holding the
+  // previous map keep a valid reference until they drop it.
+  const auto new_tables{std::make_shared<TableMap>(*tables)};
+  new_tables->erase(table_name);
+  std::atomic_store(&tables_, new_tables);
+
+  // Count items.
   size_t num_deletions{0};
-  for (const Partition& part : parts) {
+  for (const Partition& part : *parts_ptr) {
+    const std::shared_lock part_lock(*part.guard);
     num_deletions += part.entries.size();
   }
-  tables_.erase(tables_it);
 
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_deletions,
              " entries.\n");
@@ -410,14 +439,15 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name) {
 template <typename Key>
 size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t num_keys,
                                   const Key* const keys) {
-  const std::unique_lock lock(read_write_guard_);
+  const std::unique_lock lock(write_guard_);
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const std::shared_ptr<TableMap> tables{std::atomic_load(&tables_)};
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return 0;
   }
-  std::vector<Partition>& parts{tables_it->second};
+  std::vector<Partition>& parts{*tables_it->second};
 
   const Key* const keys_end{&keys[num_keys]};
   const size_t num_partitions{parts.size()};
@@ -430,6 +460,7 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
   } else if (num_keys == 1 || num_partitions == 1) {
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
+    const std::unique_lock part_lock(*part.guard);
 
     // Step through input batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
@@ -446,6 +477,7 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
 
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
+      const std::unique_lock part_lock(*part.guard);
 
       size_t num_deletions{0};
 
@@ -476,10 +508,10 @@ template <typename Key>
 std::vector<std::string> HashMapBackend<Key>::find_tables(const std::string& model_name) {
   const std::string& tag_prefix{HierParameterServerBase::make_tag_name(model_name, "", false)};
 
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<const TableMap> tables{std::atomic_load(&tables_)};
 
   std::vector<std::string> matches;
-  for (const auto& pair : tables_) {
+  for (const auto& pair : *tables) {
     if (pair.first.find(tag_prefix) == 0) {
       matches.push_back(pair.first);
     }
@@ -489,14 +521,14 @@ std::vector<std::string> HashMapBackend<Key>::find_tables(const std::string& mod
 
 template <typename Key>
 size_t HashMapBackend<Key>::dump_bin(const std::string& table_name, std::ofstream& file) {
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<const TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return 0;
   }
-  const std::vector<Partition>& parts{tables_it->second};
+  const std::vector<Partition>& parts{*tables_it->second};
 
   // Store value size.
   const uint32_t value_size{parts.empty() ? 0 : parts.front().value_size};
@@ -505,12 +537,31 @@ size_t HashMapBackend<Key>::dump_bin(const std::string& table_name, std::ofstrea
   // Store values.
   size_t num_entries{0};
 
+  // Online snapshot: each partition is frozen only for the in-memory copy below; the
+  // (much slower) file write happens after its guard has been dropped, so inserts into
+  // the partition resume while its frozen image is being serialized. The buffer is
+  // reused across partitions, so at most one partition is duplicated at any time.
+  const size_t entry_size{sizeof(Key) + value_size};
+  std::vector<char> snapshot;
+
   for (const Partition& part : parts) {
-    for (const Entry& entry : part.entries) {
-      file.write(reinterpret_cast<const char*>(&entry.first), sizeof(Key));
-      file.write(entry.second.value, value_size);
+    size_t part_entries;
+    {
+      const std::shared_lock part_lock(*part.guard);
+      part_entries = part.entries.size();
+      snapshot.resize(part_entries * entry_size);
+
+      char* dst{snapshot.data()};
+      for (const Entry& entry : part.entries) {
+        std::memcpy(dst, &entry.first, sizeof(Key));
+        // `&*` unwraps both raw and interprocess offset pointers.
+        hps_value_copy(&*entry.second.value, value_size, dst + sizeof(Key));
+        dst += entry_size;
+      }
     }
-    num_entries += part.entries.size();
+
+    file.write(snapshot.data(), static_cast<std::streamsize>(part_entries * entry_size));
+    num_entries += part_entries;
   }
 
   return num_entries;
@@ -519,14 +570,21 @@ size_t HashMapBackend<Key>::dump_bin(const std::string& table_name, std::ofstrea
 #ifdef HCTR_USE_ROCKS_DB
 template <typename Key>
 size_t HashMapBackend<Key>::dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) {
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_ptr<const TableMap> tables{std::atomic_load(&tables_)};
 
   // Locate the partitions.
-  const auto& tables_it{tables_.find(table_name)};
-  if (tables_it == tables_.end()) {
+  const auto& tables_it{tables->find(table_name)};
+  if (tables_it == tables->end()) {
     return 0;
   }
-  const std::vector<Partition>& parts{tables_it->second};
+  const std::vector<Partition>& parts{*tables_it->second};
+
+  // Hold all partitions; entry references are retained across the whole dump.
+  std::vector<std::shared_lock<std::shared_mutex>> part_locks;
+  part_locks.reserve(parts.size());
+  for (const Partition& part : parts) {
+    part_locks.emplace_back(*part.guard);
+  }
 
   // Sort keys by value.
   std::vector<const Entry*> entries;
@@ -15,15 +15,19 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <hps/hash_map_backend.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/kafka_message.hpp>
+#include <hps/metrics.hpp>
 #include <hps/modelloader.hpp>
 #include <hps/mp_hash_map_backend.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/rocksdb_backend.hpp>
+#include <hps/value_log_backend.hpp>
 #include <regex>
 
 namespace HugeCTR {
@@ -78,6 +82,10 @@ std::shared_ptr<HierParameterServerBase> HierParameterServerBase::create(
 
 HierParameterServerBase::~HierParameterServerBase() = default;
 
+std::string HierParameterServerBase::export_metrics() const {
+  return metrics::Registry::instance().export_prometheus();
+}
+
 template <typename TypeHashKey>
 HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_config& ps_config)
     : HierParameterServerBase(), ps_config_(ps_config) {
@@ -101,6 +109,15 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
                    "Wrong input: The size of parameter server parameters are not correct.");
   }
 
+  // Optional request coalescing window for concurrent lookups (0 = disabled).
+  if (const char* env = std::getenv("HCTR_HPS_COALESCE_WINDOW_US")) {
+    coalesce_window_us_ = std::atol(env);
+    if (coalesce_window_us_ > 0) {
+      HCTR_LOG_S(INFO, WORLD) << "HPS lookup coalescing window: " << coalesce_window_us_ << " us"
+                              << std::endl;
+    }
+  }
+
   // Connect to volatile database.
   {
     const auto& conf = inference_params_array[0].volatile_db;
@@ -136,6 +153,7 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
             conf.shared_memory_name,
             std::chrono::milliseconds{100},  // heart_beat_frequency
             conf.shared_memory_auto_remove,
+            conf.shared_memory_read_only,
         };
         volatile_db_ = std::make_unique<MultiProcessHashMapBackend<TypeHashKey>>(params);
       } break;
@@ -196,6 +214,16 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
       } break;
 #endif  // HCTR_USE_ROCKS_DB
 
+      case DatabaseType_t::ValueLog: {
+        HCTR_LOG_S(INFO, WORLD) << "Creating ValueLog backend..." << std::endl;
+        ValueLogBackendParams params{
+            conf.max_batch_size,
+            conf.path,
+            conf.read_only,
+        };
+        persistent_db_ = std::make_unique<ValueLogBackend<TypeHashKey>>(params);
+      } break;
+
       default:
         HCTR_DIE("Selected backend (persistent_db.type = %d) is not supported!", conf.type);
         break;
@@ -230,10 +258,68 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
       init_ec(inference_params_array[i], model_cache_map_[inference_params_array[i].model_name]);
     }
   }
+
+  // Optionally apply online update batches to the GPU embedding caches as deltas
+  // (0 or unset = caches only see updates at the next refresh).
+  if (const char* env = std::getenv("HCTR_EC_DELTA_UPDATE")) {
+    ec_delta_update_enabled_ = std::atoi(env) != 0;
+    if (ec_delta_update_enabled_) {
+      HCTR_LOG(INFO, WORLD,
+               "HPS online updates will be applied to the GPU embedding caches as deltas.\n");
+    }
+  }
+
+  // Optionally start the adaptive cache refresher (0 or unset = disabled).
+  if (const char* env = std::getenv("HCTR_HPS_ADAPTIVE_REFRESH")) {
+    adaptive_refresh_threshold_ = std::atof(env);
+    if (const char* interval_env = std::getenv("HCTR_HPS_ADAPTIVE_REFRESH_INTERVAL_MS")) {
+      adaptive_refresh_interval_ms_ = std::max(std::atol(interval_env), 10L);
+    }
+    if (adaptive_refresh_threshold_ > 0.0) {
+      HCTR_LOG_S(INFO, WORLD) << "HPS adaptive cache refresh: hit rate threshold = "
+                              << adaptive_refresh_threshold_
+                              << ", poll interval = " << adaptive_refresh_interval_ms_ << " ms"
+                              << std::endl;
+      adaptive_refresher_ = std::thread([this] { adaptive_refresh_loop_(); });
+    }
+  }
+
+  // Optional cache-invalidation bus (HCTR_HPS_INVALIDATION_BUS = number of key partitions per
+  // table; 0 or unset = disabled). The partition count must match the updater which publishes
+  // the version vectors.
+  if (const char* env = std::getenv("HCTR_HPS_INVALIDATION_BUS")) {
+    const long num_partitions = std::atol(env);
+    if (num_partitions > 0) {
+      if (const char* interval_env = std::getenv("HCTR_HPS_INVALIDATION_REFRESH_INTERVAL_MS")) {
+        invalidation_refresh_interval_ms_ = std::max(std::atol(interval_env), 10L);
+      }
+      invalidation_tracker_ =
+          std::make_unique<CacheInvalidationTracker<TypeHashKey>>(num_partitions);
+      HCTR_LOG_S(INFO, WORLD) << "HPS cache-invalidation bus: " << num_partitions
+                              << " key partitions per table, refresh poll interval = "
+                              << invalidation_refresh_interval_ms_ << " ms" << std::endl;
+      invalidation_refresher_ = std::thread([this] { invalidation_refresh_loop_(); });
+    }
+  }
 }
 
 template <typename TypeHashKey>
 HierParameterServer<TypeHashKey>::~HierParameterServer() {
+  // Stop the adaptive cache refresher and the invalidation refresher.
+  if (adaptive_refresher_.joinable() || invalidation_refresher_.joinable()) {
+    {
+      const std::lock_guard<std::mutex> lock(refresher_mutex_);
+      refresher_stop_signal_ = true;
+    }
+    refresher_cv_.notify_all();
+    if (adaptive_refresher_.joinable()) {
+      adaptive_refresher_.join();
+    }
+    if (invalidation_refresher_.joinable()) {
+      invalidation_refresher_.join();
+    }
+  }
+
   // Await all pending volatile database transactions.
   volatile_db_async_inserter_.await_idle();
 
@@ -251,6 +337,39 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
     const InferenceParams& inference_params) {
   IModelLoader* rawreader =
       ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw);
+  // Worker that digests staged chunks during startup population, so backend insertion
+  // (which fans out across partitions internally) overlaps with reading the next chunk.
+  ThreadPool streamed_inserter{"db load inserter", 1};
+  // Pipelined streamed insert over one load pass: chunks are snapshotted into alternating
+  // staging buffers (the loader reuses its own) and handed to the worker; while the backend
+  // inserts chunk i, chunk i + 1 is still being read from storage.
+  auto pipelined_insert = [&](DatabaseBackendBase<TypeHashKey>* db, const std::string& tag_name,
+                              const size_t embedding_size) {
+    std::vector<TypeHashKey> staged_keys[2];
+    std::vector<char> staged_values[2];
+    std::future<void> pending;
+    for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
+      const std::pair<void*, size_t> key_result = rawreader->getkeys(i);
+      const std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
+      std::vector<TypeHashKey>& keys = staged_keys[i % 2];
+      std::vector<char>& values = staged_values[i % 2];
+      const TypeHashKey* const src_keys = reinterpret_cast<const TypeHashKey*>(key_result.first);
+      const char* const src_values = reinterpret_cast<const char*>(vec_result.first);
+      keys.assign(src_keys, src_keys + key_result.second);
+      values.assign(src_values, src_values + vec_result.second * sizeof(float));
+      // At most one task is in flight and it holds the other staging slot.
+      if (pending.valid()) {
+        pending.wait();
+      }
+      pending = streamed_inserter.submit([db, &keys, &values, &tag_name, embedding_size]() {
+        db->insert(tag_name, keys.size(), keys.data(), values.data(),
+                   embedding_size * sizeof(float), embedding_size * sizeof(float));
+      });
+    }
+    if (pending.valid()) {
+      pending.wait();
+    }
+  };
   size_t num_tables = inference_params.fuse_embedding_table
                           ? inference_params.fused_sparse_model_files.size()
                           : inference_params.sparse_model_files.size();
@@ -292,27 +411,13 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
 
       volatile_db_async_inserter_.await_idle();
       if (!inference_params.fuse_embedding_table) {
-        for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
-          std::pair<void*, size_t> key_result = rawreader->getkeys(i);
-          std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-          volatile_db_->insert(tag_name, key_result.second,
-                               reinterpret_cast<const TypeHashKey*>(key_result.first),
-                               reinterpret_cast<const char*>(vec_result.first),
-                               embedding_size * sizeof(float), embedding_size * sizeof(float));
-        }
+        pipelined_insert(volatile_db_.get(), tag_name, embedding_size);
       } else {
         for (int table_id = 0; table_id < inference_params.fused_sparse_model_files[j].size();
              table_id++) {
           rawreader->load(inference_params.embedding_table_names[j],
                           inference_params.fused_sparse_model_files[j][table_id]);
-          for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
-            std::pair<void*, size_t> key_result = rawreader->getkeys(i);
-            std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-            volatile_db_->insert(tag_name, key_result.second,
-                                 reinterpret_cast<const TypeHashKey*>(key_result.first),
-                                 reinterpret_cast<const char*>(vec_result.first),
-                                 embedding_size * sizeof(float), embedding_size * sizeof(float));
-          }
+          pipelined_insert(volatile_db_.get(), tag_name, embedding_size);
         }
       }
 
@@ -330,27 +435,13 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
     if (persistent_db_ && persistent_db_initialize_after_startup_ &&
         inference_params.embedding_cache_type == HugeCTR::EmbeddingCacheType_t::Dynamic) {
       if (!inference_params.fuse_embedding_table) {
-        for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
-          std::pair<void*, size_t> key_result = rawreader->getkeys(i);
-          std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-          persistent_db_->insert(tag_name, key_result.second,
-                                 reinterpret_cast<const TypeHashKey*>(key_result.first),
-                                 reinterpret_cast<const char*>(vec_result.first),
-                                 embedding_size * sizeof(float), embedding_size * sizeof(float));
-        }
+        pipelined_insert(persistent_db_.get(), tag_name, embedding_size);
       } else {
         for (int table_id = 0; table_id < inference_params.fused_sparse_model_files[j].size();
              table_id++) {
           rawreader->load(inference_params.embedding_table_names[j],
                           inference_params.fused_sparse_model_files[j][table_id]);
-          for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
-            std::pair<void*, size_t> key_result = rawreader->getkeys(i);
-            std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-            persistent_db_->insert(tag_name, key_result.second,
-                                   reinterpret_cast<const TypeHashKey*>(key_result.first),
-                                   reinterpret_cast<const char*>(vec_result.first),
-                                   embedding_size * sizeof(float), embedding_size * sizeof(float));
-          }
+          pipelined_insert(persistent_db_.get(), tag_name, embedding_size);
         }
         HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; cached " << num_key
                                 << " embeddings in persistent database ("
@@ -422,6 +513,26 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
             inference_params.update_source.failure_backoff_ms,
             inference_params.update_source.max_commit_interval);
       }
+      // Cache-invalidation version vectors. Every node has to see every vector, so this
+      // subscription always uses a host-local consumer group, regardless of whether the
+      // database tiers are shared across the fleet.
+      if (invalidation_tracker_) {
+        std::ostringstream consumer_group;
+        consumer_group << kafka_group_prefix << "inval." << host_name;
+
+        std::ostringstream tag_filter;
+        tag_filter << '^' << PS_CACHE_INVALIDATION_TAG_PREFIX << "\\..+$";
+
+        invalidation_source_ = std::make_unique<KafkaMessageSource<TypeHashKey>>(
+            inference_params.update_source.brokers, consumer_group.str(),
+            std::vector<std::string>{tag_filter.str()},
+            inference_params.update_source.metadata_refresh_interval_ms,
+            inference_params.update_source.receive_buffer_size,
+            inference_params.update_source.poll_timeout_ms,
+            inference_params.update_source.max_batch_size,
+            inference_params.update_source.failure_backoff_ms,
+            inference_params.update_source.max_commit_interval);
+      }
       break;
 
     default:
@@ -431,9 +542,10 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
 
   HCTR_LOG(DEBUG, WORLD, "Real-time subscribers created!\n");
 
-  // TODO: Update embedding cache!
-
-  // Turn on background updates.
+  // Turn on background updates. With HCTR_EC_DELTA_UPDATE the consumed batches are also upserted
+  // into the GPU embedding caches right away (after landing in the CPU backend, so a concurrent
+  // cache miss can never fetch a value older than the delta). When both sources are engaged the
+  // deltas are taken from the volatile one only, to avoid applying each batch twice.
   if (volatile_db_source_) {
     volatile_db_source_->engage([&](const std::string& tag, const size_t num_pairs,
                                     const TypeHashKey* keys, const char* values,
@@ -441,6 +553,9 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
       HCTR_LOG_C(TRACE, WORLD, "Volatile DB update for tag: '", tag, "', num_pairs: ", num_pairs,
                  ", value_size: ", value_size, " bytes\n");
       volatile_db_->insert(tag, num_pairs, keys, values, value_size, value_size);
+      if (ec_delta_update_enabled_) {
+        update_embedding_cache_deltas_(tag, num_pairs, keys, values, value_size);
+      }
     });
   }
 
@@ -451,10 +566,113 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
       HCTR_LOG_C(TRACE, WORLD, "Persistent DB update for tag: '", tag, "', num_pairs: ", num_pairs,
                  ", value_size: ", value_size, " bytes\n");
       persistent_db_->insert(tag, num_pairs, keys, values, value_size, value_size);
+      if (ec_delta_update_enabled_ && !volatile_db_source_) {
+        update_embedding_cache_deltas_(tag, num_pairs, keys, values, value_size);
+      }
+    });
+  }
+
+  if (invalidation_source_) {
+    invalidation_source_->engage([&](const std::string& tag, const size_t num_pairs,
+                                     const TypeHashKey* keys, const char* values,
+                                     const size_t value_size) {
+      HCTR_LOG_C(TRACE, WORLD, "Version vector for tag: '", tag, "', num_pairs: ", num_pairs,
+                 "\n");
+      if (!invalidation_tracker_->observe(tag, num_pairs, keys, values, value_size)) {
+        HCTR_LOG_C(WARNING, WORLD, "Ignoring non-invalidation message for tag '", tag,
+                   "' on the invalidation subscription.\n");
+      }
     });
   }
 }
 
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::update_embedding_cache_deltas_(
+    const std::string& tag, const size_t num_pairs, const TypeHashKey* const keys,
+    const char* const values, const size_t value_size) {
+  if (num_pairs == 0) {
+    return;
+  }
+  // Resolve the table tag to the owning model and table id.
+  std::string model_name;
+  size_t table_id = 0;
+  bool found = false;
+  for (const auto& model : model_cache_map_) {
+    const auto table_names = ps_config_.emb_table_name_.find(model.first);
+    if (table_names == ps_config_.emb_table_name_.end()) {
+      continue;
+    }
+    for (size_t i = 0; i < table_names->second.size() && !found; i++) {
+      if (make_tag_name(model.first, table_names->second[i]) == tag) {
+        model_name = model.first;
+        table_id = i;
+        found = true;
+      }
+    }
+    if (found) {
+      break;
+    }
+  }
+  if (!found) {
+    return;
+  }
+
+  // Version fence: batches take a ticket per tag in consumption order; the apply section is
+  // serialized and a batch that has been overtaken by a newer one for the same tag is dropped,
+  // so a delayed delta can never overwrite fresher values.
+  uint64_t version;
+  {
+    const std::lock_guard<std::mutex> lock(ec_delta_version_mutex_);
+    version = ++ec_delta_enqueue_versions_[tag];
+  }
+  const std::lock_guard<std::mutex> apply_lock(ec_delta_apply_mutex_);
+  if (ec_delta_applied_versions_[tag] > version) {
+    HCTR_LOG_C(TRACE, WORLD, "Dropping stale delta batch for tag '", tag, "'\n");
+    return;
+  }
+
+  for (const auto& device_cache : model_cache_map_[model_name]) {
+    const std::shared_ptr<EmbeddingCacheBase>& embedding_cache{device_cache.second};
+    if (!embedding_cache->use_gpu_embedding_cache()) {
+      continue;
+    }
+    const embedding_cache_config& cache_config{embedding_cache->get_cache_config()};
+    if (value_size != cache_config.embedding_vec_size_[table_id] * sizeof(float)) {
+      HCTR_LOG_C(WARNING, WORLD, "Delta batch for tag '", tag, "' has value size ", value_size,
+                 " bytes; expected ", cache_config.embedding_vec_size_[table_id] * sizeof(float),
+                 ". Skipping the GPU cache update.\n");
+      continue;
+    }
+    CudaDeviceContext dev_restorer{embedding_cache->get_device_id()};
+    cudaStream_t stream = embedding_cache->get_refresh_streams()[table_id];
+    MemoryBlock* memory_block = nullptr;
+    while (memory_block == nullptr) {
+      memory_block = reinterpret_cast<struct MemoryBlock*>(
+          this->apply_buffer(model_name, device_cache.first, CACHE_SPACE_TYPE::REFRESHER));
+    }
+    EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
+    const size_t chunk_length =
+        cache_config.num_set_in_refresh_workspace_ * SLAB_SIZE * SET_ASSOCIATIVITY;
+    for (size_t start = 0; start < num_pairs; start += chunk_length) {
+      *refreshspace_handler.h_length_ = std::min(chunk_length, num_pairs - start);
+      HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_,
+                                     keys + start,
+                                     *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
+                                     cudaMemcpyHostToDevice, stream));
+      HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_emb_vec_,
+                                     values + start * value_size,
+                                     *refreshspace_handler.h_length_ * value_size,
+                                     cudaMemcpyHostToDevice, stream));
+      // Upsert through the bulk insert path, on the background refresh stream of the table so
+      // deltas serialize with any in-flight refresh of the same table.
+      embedding_cache->init(table_id, refreshspace_handler, stream);
+      HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    }
+    this->free_buffer(memory_block);
+  }
+  ec_delta_applied_versions_[tag] = version;
+}
+
 template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::init_ec(
     InferenceParams& inference_params,
@@ -490,10 +708,47 @@ void HierParameterServer<TypeHashKey>::init_ec(
                                  cache_config.cache_refresh_percentage_per_iteration));
         size_t length = SLAB_SIZE * SET_ASSOCIATIVITY * stride_set;
         refreshspace_handler.h_length_ = &length;
+        // Warm-up from a key-popularity snapshot (HCTR_EC_WARMUP_FILE): pre-fill the cache with
+        // the hottest keys of the table instead of the head of the model file, so p99 does not
+        // degrade while the cache fills through misses after a restart.
+        bool warmed_up = false;
+        const char* warmup_env = std::getenv("HCTR_EC_WARMUP_FILE");
+        if (warmup_env && !inference_params.fuse_embedding_table) {
+          const size_t cache_capacity =
+              SLAB_SIZE * SET_ASSOCIATIVITY * cache_config.num_set_in_cache_[j];
+          const size_t num_warmup_keys = rawreader->load_warmup_keys(
+              inference_params.embedding_table_names[j], inference_params.sparse_model_files[j],
+              warmup_env, j, cache_capacity, cache_config.embedding_vec_size_[j]);
+          const TypeHashKey* h_warmup_keys =
+              static_cast<const TypeHashKey*>(rawreader->getkeys());
+          const float* h_warmup_vecs = static_cast<const float*>(rawreader->getvectors());
+          const size_t chunk_length = SLAB_SIZE * SET_ASSOCIATIVITY * stride_set;
+          for (size_t start = 0; start < num_warmup_keys; start += chunk_length) {
+            length = std::min(chunk_length, num_warmup_keys - start);
+            HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_,
+                                           h_warmup_keys + start, length * sizeof(TypeHashKey),
+                                           cudaMemcpyHostToDevice, stream));
+            HCTR_LIB_THROW(cudaMemcpyAsync(
+                refreshspace_handler.d_refresh_emb_vec_,
+                h_warmup_vecs + start * cache_config.embedding_vec_size_[j],
+                length * cache_config.embedding_vec_size_[j] * sizeof(float),
+                cudaMemcpyHostToDevice, stream));
+            embedding_cache_map[device_id]->init(j, refreshspace_handler, stream);
+            HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+          }
+          if (num_warmup_keys > 0) {
+            HCTR_LOG_S(INFO, ROOT)
+                << "Warmed up the embedding table " << j << " with " << num_warmup_keys
+                << " keys from " << warmup_env << std::endl;
+            warmed_up = true;
+          }
+          length = SLAB_SIZE * SET_ASSOCIATIVITY * stride_set;
+        }
         size_t num_iteration = 0;
         std::pair<void*, size_t> key_result;
         std::pair<void*, size_t> vec_result;
-        for (size_t idx_set = 0; idx_set + stride_set < cache_config.num_set_in_cache_[j];
+        for (size_t idx_set = 0;
+             !warmed_up && idx_set + stride_set < cache_config.num_set_in_cache_[j];
              idx_set += stride_set) {
           if (inference_params.fuse_embedding_table) {
             size_t table_id = idx_set % inference_params.fused_sparse_model_files[j].size();
@@ -648,6 +903,63 @@ void HierParameterServer<TypeHashKey>::create_embedding_cache_per_model(
     inference_params.device_id = device_id;
     embedding_cache_map[device_id] = EmbeddingCacheBase::create(inference_params, ps_config_, this);
   }
+  // Peer-sharded cache mode (HCTR_EC_PEER_SHARDING): chain cache misses through the sibling
+  // devices' caches over peer access before hitting the CPU memory tiers, so a model larger than
+  // one device's HBM can still be cache-resident on the aggregate HBM of the node. Requires peer
+  // access between every pair of deployed devices; siblings are wired in deployment order,
+  // rotated per device so no single cache serves every first-stage peer query.
+  const char* peer_sharding_env = std::getenv("HCTR_EC_PEER_SHARDING");
+  if (peer_sharding_env && std::atoi(peer_sharding_env) != 0 &&
+      inference_params.deployed_devices.size() > 1) {
+    bool peer_access_ok = true;
+    for (auto device_id : inference_params.deployed_devices) {
+      for (auto peer_id : inference_params.deployed_devices) {
+        if (device_id == peer_id) {
+          continue;
+        }
+        int can_access_peer = 0;
+        HCTR_LIB_THROW(cudaDeviceCanAccessPeer(&can_access_peer, device_id, peer_id));
+        if (!can_access_peer) {
+          HCTR_LOG(WARNING, ROOT,
+                   "Device %d cannot access device %d via peer access; disabling the peer-sharded "
+                   "embedding cache for model %s.\n",
+                   device_id, peer_id, inference_params.model_name.c_str());
+          peer_access_ok = false;
+          break;
+        }
+      }
+      if (!peer_access_ok) {
+        break;
+      }
+    }
+    if (peer_access_ok) {
+      for (auto device_id : inference_params.deployed_devices) {
+        CudaDeviceContext dev_restorer{device_id};
+        for (auto peer_id : inference_params.deployed_devices) {
+          if (device_id == peer_id) {
+            continue;
+          }
+          const cudaError_t err = cudaDeviceEnablePeerAccess(peer_id, 0);
+          if (err != cudaSuccess && err != cudaErrorPeerAccessAlreadyEnabled) {
+            HCTR_LIB_THROW(err);
+          }
+          cudaGetLastError();
+        }
+      }
+      const size_t num_devices = inference_params.deployed_devices.size();
+      for (size_t i = 0; i < num_devices; i++) {
+        std::vector<std::shared_ptr<EmbeddingCacheBase>> siblings;
+        siblings.reserve(num_devices - 1);
+        for (size_t j = 1; j < num_devices; j++) {
+          siblings.push_back(
+              embedding_cache_map[inference_params.deployed_devices[(i + j) % num_devices]]);
+        }
+        embedding_cache_map[inference_params.deployed_devices[i]]->set_sibling_caches(siblings);
+      }
+      HCTR_LOG(INFO, ROOT, "Enable peer-sharded embedding cache across %zu devices for model %s\n",
+               num_devices, inference_params.model_name.c_str());
+    }
+  }
   model_cache_map_[inference_params.model_name] = embedding_cache_map;
   memory_pool_config_.num_woker_buffer_size_per_model[inference_params.model_name] =
       inference_params.number_of_worker_buffers_in_pool;
@@ -744,6 +1056,103 @@ void HierParameterServer<TypeHashKey>::lookup(const void* const h_keys, const si
   if (!length) {
     return;
   }
+  if (coalesce_window_us_ <= 0) {
+    lookup_database(reinterpret_cast<const TypeHashKey*>(h_keys), length, h_vectors, model_name,
+                    table_id);
+    return;
+  }
+
+  const std::string& tag_name =
+      make_tag_name(model_name, ps_config_.emb_table_name_[model_name][table_id]);
+  CoalescingState* state;
+  {
+    std::lock_guard<std::mutex> lock(coalescing_mutex_);
+    auto& slot = coalescing_states_[tag_name];
+    if (!slot) {
+      slot = std::make_unique<CoalescingState>();
+    }
+    state = slot.get();
+  }
+
+  // Join the open batch for this table, or open a new one and become its leader.
+  std::shared_ptr<LookupBatch> batch;
+  bool is_leader = false;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->open_batch) {
+      state->open_batch = std::make_shared<LookupBatch>();
+      is_leader = true;
+    }
+    batch = state->open_batch;
+    batch->requests.push_back(
+        {reinterpret_cast<const TypeHashKey*>(h_keys), length, h_vectors});
+  }
+
+  if (!is_leader) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&batch] { return batch->done; });
+    return;
+  }
+
+  // Keep the batch open for the configured window so concurrent requests can join.
+  std::this_thread::sleep_for(std::chrono::microseconds(coalesce_window_us_));
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->open_batch == batch) {
+      state->open_batch.reset();
+    }
+  }
+
+  if (batch->requests.size() == 1) {
+    lookup_database(reinterpret_cast<const TypeHashKey*>(h_keys), length, h_vectors, model_name,
+                    table_id);
+  } else {
+    // Deduplicate the keys of all joined requests, query the backend once and
+    // demultiplex the fetched vectors back to each request's output buffer.
+    const size_t embedding_size = ps_config_.embedding_vec_size_[model_name][table_id];
+    size_t total_num_keys = 0;
+    for (const auto& request : batch->requests) {
+      total_num_keys += request.length;
+    }
+    std::unordered_map<TypeHashKey, size_t> unique_index;
+    unique_index.reserve(total_num_keys);
+    std::vector<TypeHashKey> unique_keys;
+    unique_keys.reserve(total_num_keys);
+    for (const auto& request : batch->requests) {
+      for (size_t i = 0; i < request.length; ++i) {
+        if (unique_index.try_emplace(request.keys[i], unique_keys.size()).second) {
+          unique_keys.push_back(request.keys[i]);
+        }
+      }
+    }
+    std::vector<float> unique_vectors(unique_keys.size() * embedding_size);
+    lookup_database(unique_keys.data(), unique_keys.size(), unique_vectors.data(), model_name,
+                    table_id);
+    for (const auto& request : batch->requests) {
+      for (size_t i = 0; i < request.length; ++i) {
+        std::copy_n(&unique_vectors[unique_index[request.keys[i]] * embedding_size],
+                    embedding_size, &request.vectors[i * embedding_size]);
+      }
+    }
+    HCTR_LOG_C(DEBUG, WORLD, "Coalesced ", batch->requests.size(), " lookups (", total_num_keys,
+               " keys) into one backend query of ", unique_keys.size(), " keys.\n");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    batch->done = true;
+  }
+  state->cv.notify_all();
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::lookup_database(const TypeHashKey* const h_keys,
+                                                       const size_t length, float* const h_vectors,
+                                                       const std::string& model_name,
+                                                       const size_t table_id) {
+  if (!length) {
+    return;
+  }
 
   const auto start_time = std::chrono::high_resolution_clock::now();
   BaseUnit* start = profiler::start();
@@ -756,7 +1165,15 @@ void HierParameterServer<TypeHashKey>::lookup(const void* const h_keys, const si
   const size_t embedding_size = ps_config_.embedding_vec_size_[model_name][table_id];
   const size_t expected_value_size = embedding_size * sizeof(float);
   const std::string& embedding_table_name = ps_config_.emb_table_name_[model_name][table_id];
-  const std::string& tag_name = make_tag_name(model_name, embedding_table_name);
+  std::string tag_name;
+  {
+    const std::shared_lock<std::shared_mutex> lock(model_version_mutex_);
+    const auto version_it = active_model_versions_.find(model_name);
+    tag_name = version_it == active_model_versions_.end()
+                   ? make_tag_name(model_name, embedding_table_name)
+                   : make_tag_name(versioned_model_name_(model_name, version_it->second),
+                                   embedding_table_name);
+  }
   const float default_vec_value = ps_config_.default_emb_vec_value_[*model_id][table_id];
 
 #ifdef ENABLE_INFERENCE
@@ -938,10 +1355,354 @@ void HierParameterServer<TypeHashKey>::refresh_embedding_cache(const std::string
   // apply the memory block for embedding cache refresh workspace
   this->free_buffer(memory_block);
   timer_refresh.stop();
+  metrics::Registry::instance().refresh_duration_us.observe(
+      static_cast<uint64_t>(timer_refresh.elapsedSeconds() * 1e6));
   HCTR_LOG_S(TRACE, ROOT) << "The total Time of embedding cache refresh is : "
                           << timer_refresh.elapsedSeconds() << "s" << std::endl;
 }
 
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::load_model_version(
+    const std::string& model_name, const std::string& version,
+    const std::vector<std::string>& sparse_model_files) {
+  HCTR_CHECK_HINT(inference_params_map_.find(model_name) != inference_params_map_.end(),
+                  "Cannot stage a version of model '%s'; the model is not deployed.\n",
+                  model_name.c_str());
+  const std::vector<std::string>& table_names = ps_config_.emb_table_name_[model_name];
+  HCTR_CHECK_HINT(sparse_model_files.size() == table_names.size(),
+                  "Model '%s' has %zu embedding tables, but %zu table folders were provided.\n",
+                  model_name.c_str(), table_names.size(), sparse_model_files.size());
+
+  IModelLoader* rawreader =
+      ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw);
+  for (size_t j = 0; j < table_names.size(); j++) {
+    rawreader->load(table_names[j], sparse_model_files[j]);
+    // The versioned model name goes through the same syntax check as a regular one.
+    const std::string tag_name =
+        make_tag_name(versioned_model_name_(model_name, version), table_names[j]);
+    const size_t embedding_size = ps_config_.embedding_vec_size_[model_name][j];
+    for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
+      const std::pair<void*, size_t> key_result = rawreader->getkeys(i);
+      const std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
+      const TypeHashKey* const keys = reinterpret_cast<const TypeHashKey*>(key_result.first);
+      const char* const values = reinterpret_cast<const char*>(vec_result.first);
+      if (volatile_db_) {
+        volatile_db_->insert(tag_name, key_result.second, keys, values,
+                             embedding_size * sizeof(float), embedding_size * sizeof(float));
+      }
+      if (persistent_db_) {
+        persistent_db_->insert(tag_name, key_result.second, keys, values,
+                               embedding_size * sizeof(float), embedding_size * sizeof(float));
+      }
+    }
+    HCTR_LOG_S(INFO, WORLD) << "Staged " << rawreader->getkeycount() << " embeddings of table '"
+                            << table_names[j] << "' under shadow tag '" << tag_name << "'."
+                            << std::endl;
+  }
+  rawreader->delete_table();
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::activate_model_version(const std::string& model_name,
+                                                              const std::string& version) {
+  HCTR_CHECK_HINT(inference_params_map_.find(model_name) != inference_params_map_.end(),
+                  "Cannot activate a version of model '%s'; the model is not deployed.\n",
+                  model_name.c_str());
+
+  std::string previous_version;
+  {
+    const std::unique_lock<std::shared_mutex> lock(model_version_mutex_);
+    const auto version_it = active_model_versions_.find(model_name);
+    if (version_it != active_model_versions_.end()) {
+      previous_version = version_it->second;
+    }
+    if (previous_version == version) {
+      HCTR_LOG_C(WARNING, WORLD, "Version '", version, "' of model '", model_name,
+                 "' is already active.\n");
+      return;
+    }
+    if (version.empty()) {
+      active_model_versions_.erase(model_name);
+    } else {
+      active_model_versions_[model_name] = version;
+    }
+  }
+  HCTR_LOG_S(INFO, WORLD) << "Model '" << model_name << "' cut over from version '"
+                          << previous_version << "' to version '" << version << "'." << std::endl;
+
+  // Re-pull the GPU embedding caches, so they serve the new version right away instead of
+  // aging the old vectors out through the periodic refresh.
+  const auto cache_map_it = model_cache_map_.find(model_name);
+  if (cache_map_it != model_cache_map_.end()) {
+    for (const auto& device_cache : cache_map_it->second) {
+      if (!device_cache.second->use_gpu_embedding_cache() ||
+          device_cache.second->get_cache_config().cache_refresh_percentage_per_iteration <= 0) {
+        continue;
+      }
+      refresh_embedding_cache(model_name, static_cast<int>(device_cache.first));
+    }
+  }
+
+  // Nothing references the previous version anymore; drop its tables from the backends.
+  if (!previous_version.empty()) {
+    for (const std::string& table_name : ps_config_.emb_table_name_[model_name]) {
+      const std::string old_tag =
+          make_tag_name(versioned_model_name_(model_name, previous_version), table_name);
+      if (volatile_db_) {
+        volatile_db_->evict(old_tag);
+      }
+      if (persistent_db_) {
+        persistent_db_->evict(old_tag);
+      }
+    }
+  }
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::adaptive_refresh_loop_() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(refresher_mutex_);
+      refresher_cv_.wait_for(lock, std::chrono::milliseconds(adaptive_refresh_interval_ms_),
+                             [this] { return refresher_stop_signal_; });
+      if (refresher_stop_signal_) {
+        return;
+      }
+    }
+
+    for (const auto& model : model_cache_map_) {
+      for (const auto& device_cache : model.second) {
+        const std::shared_ptr<EmbeddingCacheBase>& embedding_cache{device_cache.second};
+        if (!embedding_cache->use_gpu_embedding_cache()) {
+          continue;
+        }
+        const embedding_cache_config& cache_config{embedding_cache->get_cache_config()};
+        if (cache_config.cache_refresh_percentage_per_iteration <= 0) {
+          continue;
+        }
+
+        // The degradation signal is the lowest smoothed hit rate across the tables.
+        double min_hit_rate{1.0};
+        bool have_observation{false};
+        for (size_t i = 0; i < cache_config.num_emb_table_; i++) {
+          const double hit_rate{embedding_cache->get_tracked_hit_rate(i)};
+          if (hit_rate >= 0.0) {
+            min_hit_rate = std::min(min_hit_rate, hit_rate);
+            have_observation = true;
+          }
+        }
+        if (!have_observation || min_hit_rate >= adaptive_refresh_threshold_) {
+          continue;
+        }
+
+        HCTR_LOG_S(INFO, WORLD) << "Adaptive refresh: hit rate of model " << model.first
+                                << " on device " << device_cache.first << " degraded to "
+                                << min_hit_rate << " (threshold = " << adaptive_refresh_threshold_
+                                << "). Refreshing the stalest cache segment..." << std::endl;
+        try {
+          refresh_embedding_cache_partial_(model.first, static_cast<int>(device_cache.first));
+        } catch (const std::exception& e) {
+          HCTR_LOG_S(ERROR, WORLD) << "Adaptive refresh of model " << model.first
+                                   << " failed: " << e.what() << std::endl;
+        }
+      }
+    }
+  }
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::refresh_embedding_cache_partial_(
+    const std::string& model_name, const int device_id) {
+  const auto refresh_begin = std::chrono::steady_clock::now();
+  std::shared_ptr<EmbeddingCacheBase> embedding_cache = get_embedding_cache(model_name, device_id);
+  embedding_cache_config cache_config = embedding_cache->get_cache_config();
+
+  std::vector<cudaStream_t> streams = embedding_cache->get_refresh_streams();
+  // apply the memory block for embedding cache refresh workspace
+  MemoryBlock* memory_block = nullptr;
+  while (memory_block == nullptr) {
+    memory_block = reinterpret_cast<struct MemoryBlock*>(
+        this->apply_buffer(model_name, device_id, CACHE_SPACE_TYPE::REFRESHER));
+  }
+  EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
+
+  // One refresh-workspace-sized window per table, rotating through the cache sets so that
+  // consecutive triggers always revisit the segment whose content is stalest.
+  std::vector<size_t>& cursors{refresh_set_cursors_[model_name + "/" + std::to_string(device_id)]};
+  cursors.resize(cache_config.num_emb_table_, 0);
+
+  const size_t stride_set = cache_config.num_set_in_refresh_workspace_;
+  for (size_t i = 0; i < cache_config.num_emb_table_; i++) {
+    const size_t num_sets = cache_config.num_set_in_cache_[i];
+    const size_t idx_set = cursors[i] >= num_sets ? 0 : cursors[i];
+    const size_t end_idx = std::min(idx_set + stride_set, num_sets);
+    cursors[i] = end_idx >= num_sets ? 0 : end_idx;
+
+    embedding_cache->dump(i, refreshspace_handler.d_refresh_embeddingcolumns_,
+                          refreshspace_handler.d_length_, idx_set, end_idx, streams[i]);
+    HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_length_, refreshspace_handler.d_length_,
+                                   sizeof(size_t), cudaMemcpyDeviceToHost, streams[i]));
+    HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+    HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_refresh_embeddingcolumns_,
+                                   refreshspace_handler.d_refresh_embeddingcolumns_,
+                                   *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
+                                   cudaMemcpyDeviceToHost, streams[i]));
+    HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+    this->lookup(
+        reinterpret_cast<const TypeHashKey*>(refreshspace_handler.h_refresh_embeddingcolumns_),
+        *refreshspace_handler.h_length_, refreshspace_handler.h_refresh_emb_vec_, model_name, i);
+    HCTR_LIB_THROW(cudaMemcpyAsync(
+        refreshspace_handler.d_refresh_emb_vec_, refreshspace_handler.h_refresh_emb_vec_,
+        *refreshspace_handler.h_length_ * cache_config.embedding_vec_size_[i] * sizeof(float),
+        cudaMemcpyHostToDevice, streams[i]));
+    HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+    embedding_cache->refresh(
+        static_cast<int>(i), refreshspace_handler.d_refresh_embeddingcolumns_,
+        refreshspace_handler.d_refresh_emb_vec_, *refreshspace_handler.h_length_, streams[i]);
+    HCTR_LIB_THROW(cudaStreamSynchronize(streams[i]));
+
+    HCTR_LOG_S(TRACE, ROOT) << "Adaptive refresh updated sets [" << idx_set << ", " << end_idx
+                            << ") of table " << i << " (" << *refreshspace_handler.h_length_
+                            << " keys)." << std::endl;
+  }
+  this->free_buffer(memory_block);
+  metrics::Registry::instance().refresh_duration_us.observe(
+      static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - refresh_begin)
+                                .count()));
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::invalidation_refresh_loop_() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(refresher_mutex_);
+      refresher_cv_.wait_for(lock, std::chrono::milliseconds(invalidation_refresh_interval_ms_),
+                             [this] { return refresher_stop_signal_; });
+      if (refresher_stop_signal_) {
+        return;
+      }
+    }
+
+    const auto dirty_map = invalidation_tracker_->fetch_dirty_partitions();
+    for (const auto& dirty_entry : dirty_map) {
+      // Resolve the table tag to the owning model and table id.
+      std::string model_name;
+      size_t table_id = 0;
+      bool found = false;
+      for (const auto& model : model_cache_map_) {
+        const auto table_names = ps_config_.emb_table_name_.find(model.first);
+        if (table_names == ps_config_.emb_table_name_.end()) {
+          continue;
+        }
+        for (size_t i = 0; i < table_names->second.size() && !found; i++) {
+          if (make_tag_name(model.first, table_names->second[i]) == dirty_entry.first) {
+            model_name = model.first;
+            table_id = i;
+            found = true;
+          }
+        }
+        if (found) {
+          break;
+        }
+      }
+      if (!found) {
+        continue;
+      }
+
+      for (const auto& device_cache : model_cache_map_[model_name]) {
+        if (!device_cache.second->use_gpu_embedding_cache()) {
+          continue;
+        }
+        try {
+          refresh_invalidated_partitions_(model_name, static_cast<int>(device_cache.first),
+                                          table_id, dirty_entry.second);
+        } catch (const std::exception& e) {
+          HCTR_LOG_S(ERROR, WORLD) << "Invalidation refresh of tag '" << dirty_entry.first
+                                   << "' failed: " << e.what() << std::endl;
+        }
+      }
+    }
+  }
+}
+
+template <typename TypeHashKey>
+void HierParameterServer<TypeHashKey>::refresh_invalidated_partitions_(
+    const std::string& model_name, const int device_id, const size_t table_id,
+    const std::vector<bool>& dirty_partitions) {
+  const auto refresh_begin = std::chrono::steady_clock::now();
+  std::shared_ptr<EmbeddingCacheBase> embedding_cache = get_embedding_cache(model_name, device_id);
+  embedding_cache_config cache_config = embedding_cache->get_cache_config();
+
+  CudaDeviceContext dev_restorer{embedding_cache->get_device_id()};
+  cudaStream_t stream = embedding_cache->get_refresh_streams()[table_id];
+  // apply the memory block for embedding cache refresh workspace
+  MemoryBlock* memory_block = nullptr;
+  while (memory_block == nullptr) {
+    memory_block = reinterpret_cast<struct MemoryBlock*>(
+        this->apply_buffer(model_name, device_id, CACHE_SPACE_TYPE::REFRESHER));
+  }
+  EmbeddingCacheRefreshspace refreshspace_handler = memory_block->refresh_buffer;
+
+  // Walk the cached keys of the table window by window, but only re-pull the keys which fall
+  // into a dirty partition; the unchanged partitions cost one host-side scan and no I/O.
+  const size_t num_partitions = invalidation_tracker_->num_partitions();
+  const size_t stride_set = cache_config.num_set_in_refresh_workspace_;
+  size_t num_scanned = 0;
+  size_t num_refreshed = 0;
+  for (size_t idx_set = 0; idx_set < cache_config.num_set_in_cache_[table_id];
+       idx_set += stride_set) {
+    const size_t end_idx = std::min(idx_set + stride_set, cache_config.num_set_in_cache_[table_id]);
+    embedding_cache->dump(table_id, refreshspace_handler.d_refresh_embeddingcolumns_,
+                          refreshspace_handler.d_length_, idx_set, end_idx, stream);
+    HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_length_, refreshspace_handler.d_length_,
+                                   sizeof(size_t), cudaMemcpyDeviceToHost, stream));
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.h_refresh_embeddingcolumns_,
+                                   refreshspace_handler.d_refresh_embeddingcolumns_,
+                                   *refreshspace_handler.h_length_ * sizeof(TypeHashKey),
+                                   cudaMemcpyDeviceToHost, stream));
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    TypeHashKey* const h_keys =
+        reinterpret_cast<TypeHashKey*>(refreshspace_handler.h_refresh_embeddingcolumns_);
+    const size_t num_dumped = *refreshspace_handler.h_length_;
+    num_scanned += num_dumped;
+    size_t num_dirty = 0;
+    for (size_t k = 0; k < num_dumped; k++) {
+      if (dirty_partitions[invalidation_partition_of(static_cast<uint64_t>(h_keys[k]),
+                                                     num_partitions)]) {
+        h_keys[num_dirty++] = h_keys[k];
+      }
+    }
+    if (num_dirty == 0) {
+      continue;
+    }
+    num_refreshed += num_dirty;
+
+    this->lookup(h_keys, num_dirty, refreshspace_handler.h_refresh_emb_vec_, model_name, table_id);
+    HCTR_LIB_THROW(cudaMemcpyAsync(refreshspace_handler.d_refresh_embeddingcolumns_, h_keys,
+                                   num_dirty * sizeof(TypeHashKey), cudaMemcpyHostToDevice,
+                                   stream));
+    HCTR_LIB_THROW(cudaMemcpyAsync(
+        refreshspace_handler.d_refresh_emb_vec_, refreshspace_handler.h_refresh_emb_vec_,
+        num_dirty * cache_config.embedding_vec_size_[table_id] * sizeof(float),
+        cudaMemcpyHostToDevice, stream));
+    embedding_cache->refresh(static_cast<int>(table_id),
+                             refreshspace_handler.d_refresh_embeddingcolumns_,
+                             refreshspace_handler.d_refresh_emb_vec_, num_dirty, stream);
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+  }
+  this->free_buffer(memory_block);
+  metrics::Registry::instance().refresh_duration_us.observe(
+      static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - refresh_begin)
+                                .count()));
+  HCTR_LOG_S(TRACE, ROOT) << "Invalidation refresh of model " << model_name << " table "
+                          << table_id << " on device " << device_id << " re-pulled "
+                          << num_refreshed << " / " << num_scanned << " cached keys." << std::endl;
+}
+
 template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::insert_embedding_cache(
     const size_t table_id, std::shared_ptr<EmbeddingCacheBase> embedding_cache,
@@ -89,6 +89,78 @@ DataType toScalarType(const DLDataType& dtype) {
   return DataType::Complex;
 }
 
+static DLDeviceType toDLDeviceType(const DeviceType device) {
+  switch (device) {
+    case DeviceType::CPU:
+      return DLDeviceType::kDLCPU;
+    case DeviceType::CUDA:
+      return DLDeviceType::kDLCUDA;
+    case DeviceType::CUDAHost:
+      return DLDeviceType::kDLCUDAHost;
+    default:
+      HCTR_THROW_IF(true, HugeCTR::Error_t::DataCheckError,
+                    "to_dlpack received an invalid device type: " + std::to_string(device));
+  }
+  return DLDeviceType::kDLCPU;
+}
+
+static DLDataType toDLDataType(const DataType type) {
+  DLDataType dtype;
+  dtype.lanes = 1;
+  switch (type) {
+    case DataType::Int:
+      dtype.code = DLDataTypeCode::kDLInt;
+      dtype.bits = 32;
+      break;
+    case DataType::Int64:
+      dtype.code = DLDataTypeCode::kDLInt;
+      dtype.bits = 64;
+      break;
+    case DataType::Float:
+      dtype.code = DLDataTypeCode::kDLFloat;
+      dtype.bits = 32;
+      break;
+    case DataType::Bfloat:
+      dtype.code = DLDataTypeCode::kDLBfloat;
+      dtype.bits = 16;
+      break;
+    default:
+      HCTR_THROW_IF(true, HugeCTR::Error_t::DataCheckError,
+                    "to_dlpack received an unsupported data type: " + std::to_string(type));
+  }
+  return dtype;
+}
+
+namespace {
+
+// Owns the shape array and the DLManagedTensor itself, but never the data buffer.
+struct HPSManagedTensorContext {
+  DLManagedTensor tensor;
+  std::vector<int64_t> shape;
+};
+
+}  // namespace
+
+DLManagedTensor* toDLPack(void* data, const DeviceType device, const int32_t device_id,
+                          const DataType type, const std::vector<int64_t>& shape) {
+  HPSManagedTensorContext* ctx(new HPSManagedTensorContext);
+  ctx->shape = shape;
+  ctx->tensor.dl_tensor.data = data;
+  ctx->tensor.dl_tensor.device.device_type = toDLDeviceType(device);
+  ctx->tensor.dl_tensor.device.device_id = device_id;
+  ctx->tensor.dl_tensor.ndim = static_cast<int32_t>(ctx->shape.size());
+  ctx->tensor.dl_tensor.dtype = toDLDataType(type);
+  ctx->tensor.dl_tensor.shape = ctx->shape.data();
+  ctx->tensor.dl_tensor.strides = nullptr;
+  ctx->tensor.dl_tensor.byte_offset = 0;
+  ctx->tensor.manager_ctx = ctx;
+  ctx->tensor.deleter = [](DLManagedTensor* self) {
+    delete static_cast<HPSManagedTensorContext*>(self->manager_ctx);
+  };
+
+  return &ctx->tensor;
+}
+
 HPSTensor fromDLPack(const DLManagedTensor* src) {
   HPSTensor* hpstensor(new HPSTensor);
   DeviceType device = getATenDevice(src->dl_tensor.device);
@@ -38,6 +38,7 @@ bool VolatileDatabaseParams::operator==(const VolatileDatabaseParams& p) const {
          num_partitions == p.num_partitions && allocation_rate == p.allocation_rate &&
          shared_memory_size == p.shared_memory_size && shared_memory_name == p.shared_memory_name &&
          shared_memory_auto_remove == p.shared_memory_auto_remove &&
+         shared_memory_read_only == p.shared_memory_read_only &&
          num_node_connections == p.num_node_connections && max_batch_size == p.max_batch_size &&
          enable_tls == p.enable_tls && tls_ca_certificate == p.tls_ca_certificate &&
          tls_client_certificate == p.tls_client_certificate && tls_client_key == p.tls_client_key &&
@@ -91,7 +92,8 @@ VolatileDatabaseParams::VolatileDatabaseParams(
     const std::string& address, const std::string& user_name, const std::string& password,
     const size_t num_partitions, const size_t allocation_rate, const size_t shared_memory_size,
     const std::string& shared_memory_name, const bool shared_memory_auto_remove,
-    const size_t num_node_connections, const size_t max_batch_size, const bool enable_tls,
+    const bool shared_memory_read_only, const size_t num_node_connections,
+    const size_t max_batch_size, const bool enable_tls,
     const std::string& tls_ca_certificate, const std::string& tls_client_certificate,
     const std::string& tls_client_key, const std::string& tls_server_name_identification,
     // Overflow handling related.
@@ -112,6 +114,7 @@ VolatileDatabaseParams::VolatileDatabaseParams(
       shared_memory_size{shared_memory_size},
       shared_memory_name{shared_memory_name},
       shared_memory_auto_remove{shared_memory_auto_remove},
+      shared_memory_read_only{shared_memory_read_only},
       num_node_connections{num_node_connections},
       max_batch_size{max_batch_size},
       enable_tls{enable_tls},
@@ -457,6 +460,8 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
         get_value_from_json_soft(volatile_db, "shared_memory_name", params.shared_memory_name);
     params.shared_memory_auto_remove = get_value_from_json_soft(
         volatile_db, "shared_memory_auto_remove", params.shared_memory_auto_remove);
+    params.shared_memory_read_only = get_value_from_json_soft(
+        volatile_db, "shared_memory_read_only", params.shared_memory_read_only);
 
     params.num_node_connections =
         get_value_from_json_soft(volatile_db, "num_node_connections", params.num_node_connections);
@@ -898,6 +903,13 @@ DatabaseType_t get_hps_database_type(const nlohmann::json& json, const std::stri
       return enum_value;
     }
 
+  enum_value = DatabaseType_t::ValueLog;
+  names = {hctr_enum_to_c_str(enum_value), "valuelog"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
   return default_value;
 }
 
@@ -61,6 +61,41 @@ __global__ void decompress_emb_vec(const float* d_src_emb_vec, const uint64_t* d
   }
 }
 
+// Kernel to flag the unique indices whose embedding vectors arrived late from the database backend
+__global__ void mark_missing_flag(char* d_missing_flag, const uint64_t* d_missing_index,
+                                  const size_t len) {
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx < len) {
+    d_missing_flag[d_missing_index[idx]] = 1;
+  }
+}
+
+// Kernel to map a miss index that is relative to the previous miss list back to the unique key
+// space. Each thread rewrites only its own element, so the update is safe in place.
+__global__ void compose_missing_index(uint64_t* d_rel_index, const uint64_t* d_missing_index,
+                                      const size_t len) {
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx < len) {
+    d_rel_index[idx] = d_missing_index[d_rel_index[idx]];
+  }
+}
+
+// Kernel to scatter only the flagged (late-arriving) vectors to the output buffer
+__global__ void scatter_missing_emb_vec(const float* d_src_emb_vec, const uint64_t* d_src_index,
+                                        const char* d_missing_flag, float* d_dst_emb_vec,
+                                        const size_t len, const size_t emb_vec_size) {
+  const size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx < (len * emb_vec_size)) {
+    size_t dst_emb_vec = idx / emb_vec_size;
+    size_t dst_float = idx % emb_vec_size;
+    size_t src_emb_vec = d_src_index[dst_emb_vec];
+    if (d_missing_flag[src_emb_vec]) {
+      d_dst_emb_vec[dst_emb_vec * emb_vec_size + dst_float] =
+          d_src_emb_vec[src_emb_vec * emb_vec_size + dst_float];
+    }
+  }
+}
+
 void merge_emb_vec_async(float* d_vals_merge_dst_ptr, const float* d_vals_retrieved_ptr,
                          const uint64_t* d_missing_index_ptr, const size_t missing_len,
                          const size_t emb_vec_size, const size_t BLOCK_SIZE, cudaStream_t stream) {
@@ -96,4 +131,38 @@ void decompress_emb_vec_async(const float* d_unique_src_ptr, const uint64_t* d_u
       d_unique_src_ptr, d_unique_index_ptr, d_decompress_dst_ptr, decompress_len, emb_vec_size);
 }
 
+void mark_missing_flag_async(char* d_missing_flag_ptr, const uint64_t* d_missing_index_ptr,
+                             const size_t missing_len, const size_t BLOCK_SIZE,
+                             cudaStream_t stream) {
+  if (missing_len == 0) {
+    return;
+  }
+  mark_missing_flag<<<((missing_len - 1) / BLOCK_SIZE) + 1, BLOCK_SIZE, 0, stream>>>(
+      d_missing_flag_ptr, d_missing_index_ptr, missing_len);
+}
+
+void compose_missing_index_async(uint64_t* d_rel_index_ptr, const uint64_t* d_missing_index_ptr,
+                                 const size_t missing_len, const size_t BLOCK_SIZE,
+                                 cudaStream_t stream) {
+  if (missing_len == 0) {
+    return;
+  }
+  compose_missing_index<<<((missing_len - 1) / BLOCK_SIZE) + 1, BLOCK_SIZE, 0, stream>>>(
+      d_rel_index_ptr, d_missing_index_ptr, missing_len);
+}
+
+void scatter_missing_emb_vec_async(const float* d_unique_src_ptr,
+                                   const uint64_t* d_unique_index_ptr,
+                                   const char* d_missing_flag_ptr, float* d_scatter_dst_ptr,
+                                   const size_t scatter_len, const size_t emb_vec_size,
+                                   const size_t BLOCK_SIZE, cudaStream_t stream) {
+  if (scatter_len == 0) {
+    return;
+  }
+  size_t scatter_len_in_float = scatter_len * emb_vec_size;
+  scatter_missing_emb_vec<<<((scatter_len_in_float - 1) / BLOCK_SIZE) + 1, BLOCK_SIZE, 0, stream>>>(
+      d_unique_src_ptr, d_unique_index_ptr, d_missing_flag_ptr, d_scatter_dst_ptr, scatter_len,
+      emb_vec_size);
+}
+
 }  // namespace HugeCTR
@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 
+#include <core23/macros.hpp>
+#include <cstdlib>
 #include <hps/lookup_session.hpp>
+#include <hps/metrics.hpp>
 #include <utils.hpp>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -76,7 +80,11 @@ LookupSession::LookupSession(const InferenceParams& inference_params,
       cudaStream_t stream;
       cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
       lookup_streams_.push_back(stream);
+      cudaEvent_t event;
+      HCTR_LIB_THROW(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      lookup_done_events_.push_back(event);
     }
+    HCTR_LIB_THROW(cudaStreamCreateWithFlags(&batched_join_stream_, cudaStreamNonBlocking));
     embedding_cache_->insert_stream_for_sync(lookup_streams_);
     if (inference_params_.fuse_embedding_table) {
       size_t key_size_in_byte =
@@ -98,6 +106,13 @@ LookupSession::LookupSession(const InferenceParams& inference_params,
       }
     }
 
+    static const bool eager_warmup = [] {
+      const char* env = std::getenv("HCTR_LOOKUP_SESSION_WARMUP");
+      return env == nullptr || std::atoi(env) != 0;
+    }();
+    if (eager_warmup) {
+      this->warmup();
+    }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw;
@@ -105,10 +120,48 @@ LookupSession::LookupSession(const InferenceParams& inference_params,
   return;
 }
 
+void LookupSession::warmup() {
+  CudaDeviceContext dev_restorer;
+  dev_restorer.set_device(inference_params_.device_id);
+  const size_t key_size_in_byte =
+      inference_params_.i64_input_key ? sizeof(long long) : sizeof(unsigned int);
+  const size_t num_tables = inference_params_.fuse_embedding_table
+                                ? inference_params_.fused_sparse_model_files.size()
+                                : inference_params_.sparse_model_files.size();
+  for (size_t table_id = 0; table_id < num_tables; ++table_id) {
+    const size_t num_keys =
+        inference_params_.max_batchsize *
+        inference_params_.maxnum_catfeature_query_per_table_per_sample[table_id];
+    const size_t ev_size = inference_params_.embedding_vecsize_per_table[table_id];
+    float* d_vectors;
+    HCTR_LIB_THROW(
+        cudaMalloc(reinterpret_cast<void**>(&d_vectors), num_keys * ev_size * sizeof(float)));
+    // All-zero keys dedupe to a single miss inside the cache, so the dummy lookup walks every
+    // workspace buffer at its maximum extent without flooding the backend.
+    if (inference_params_.fuse_embedding_table) {
+      HCTR_LIB_THROW(cudaMemsetAsync(key_buffer_for_each_fused_table_[table_id], 0,
+                                     num_keys * key_size_in_byte, lookup_streams_[table_id]));
+      this->lookup_from_device_impl(key_buffer_for_each_fused_table_[table_id], d_vectors, num_keys,
+                                    table_id, lookup_streams_[table_id]);
+    } else {
+      const std::vector<char> h_keys(num_keys * key_size_in_byte, 0);
+      this->lookup_impl(h_keys.data(), d_vectors, num_keys, table_id, lookup_streams_[table_id]);
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(lookup_streams_[table_id]));
+    HCTR_LIB_THROW(cudaFree(d_vectors));
+  }
+  HCTR_LOG_S(INFO, WORLD) << "Lookup session warm-up done for model '"
+                          << inference_params_.model_name << "' on device "
+                          << inference_params_.device_id << " (" << num_tables << " tables)."
+                          << std::endl;
+}
+
 LookupSession::~LookupSession() {
   CudaDeviceContext dev_restorer;
   dev_restorer.set_device(inference_params_.device_id);
   for (auto stream : lookup_streams_) HCTR_LIB_CHECK_(cudaStreamDestroy(stream));
+  for (auto event : lookup_done_events_) HCTR_LIB_CHECK_(cudaEventDestroy(event));
+  HCTR_LIB_CHECK_(cudaStreamDestroy(batched_join_stream_));
   if (inference_params_.fuse_embedding_table) {
     size_t num_tables = inference_params_.fused_sparse_model_files.size();
     for (size_t fused_id{0}; fused_id < num_tables; ++fused_id) {
@@ -123,6 +176,7 @@ LookupSession::~LookupSession() {
 void LookupSession::lookup_with_table_fusion_impl(const void* keys, float* d_vectors,
                                                   size_t num_keys, size_t table_id, bool key_on_gpu,
                                                   cudaStream_t stream) {
+  HCTR_NVTX_RANGE("hps::lookup_fused");
   size_t fused_table_id = inference_params_.original_table_id_to_fused_table_id_map[table_id];
   auto original_table_id_list =
       inference_params_.fused_table_id_to_original_table_id_map[fused_table_id];
@@ -238,14 +292,28 @@ void LookupSession::lookup_with_table_fusion_impl(const void* keys, float* d_vec
 
 void LookupSession::lookup_from_device_impl(const void* d_keys, float* d_vectors, size_t num_keys,
                                             size_t table_id, cudaStream_t stream) {
+  HCTR_NVTX_RANGE("hps::lookup_from_device");
   CudaDeviceContext dev_restorer;
   dev_restorer.set_device(inference_params_.device_id);
   embedding_cache_->lookup_from_device(table_id, d_vectors, d_keys, num_keys,
                                        inference_params_.hit_rate_threshold, stream);
 }
 
+void LookupSession::lookup_from_device_graph_safe(const void* d_keys, float* d_vectors,
+                                                  size_t num_keys, size_t table_id,
+                                                  cudaStream_t stream) {
+  // The fusion path synchronizes worker threads through mutex_/cv_, which cannot be captured
+  // into a CUDA graph.
+  HCTR_THROW_IF(inference_params_.fuse_embedding_table, Error_t::IllegalCall,
+                "Graph-capturable lookup is not supported with fuse_embedding_table");
+  CudaDeviceContext dev_restorer;
+  dev_restorer.set_device(inference_params_.device_id);
+  embedding_cache_->lookup_from_device_graph_safe(table_id, d_vectors, d_keys, num_keys, stream);
+}
+
 void LookupSession::lookup_impl(const void* const h_keys, float* const d_vectors,
                                 const size_t num_keys, const size_t table_id, cudaStream_t stream) {
+  HCTR_NVTX_RANGE("hps::lookup");
   CudaDeviceContext dev_restorer;
   dev_restorer.set_device(inference_params_.device_id);
   embedding_cache_->lookup(table_id, d_vectors, h_keys, num_keys,
@@ -278,6 +346,9 @@ void LookupSession::lookup(const void* const h_keys, float* const d_vectors, con
 
   ls_profiler_->end(start, "End-to-end lookup embedding keys for Lookup session");
   const auto latency = std::chrono::high_resolution_clock::now() - begin;
+  metrics::Registry::instance().lookup_requests.add(1);
+  metrics::Registry::instance().lookup_latency_us.observe(
+      static_cast<uint64_t>(latency.count() / 1000));
   HCTR_LOG_S(TRACE, WORLD) << "Lookup single table; number of keys " << num_keys << ", table id  "
                            << table_id << "lookup latency: " << latency.count() / 1000 << " us."
                            << std::endl;
@@ -323,10 +394,66 @@ void LookupSession::lookup(const std::vector<const void*>& h_keys_per_table,
 
   ls_profiler_->end(start, "End-to-end lookup embedding keys from multi-table Lookup session");
   const auto latency = std::chrono::high_resolution_clock::now() - begin;
+  metrics::Registry::instance().lookup_requests.add(1);
+  metrics::Registry::instance().lookup_latency_us.observe(
+      static_cast<uint64_t>(latency.count() / 1000));
   HCTR_LOG_S(TRACE, WORLD) << "Lookup multiple tables;"
                            << "lookup latency: " << latency.count() / 1000 << " us." << std::endl;
 }
 
+void LookupSession::lookup_batched(const std::vector<const void*>& h_keys_per_table,
+                                   const std::vector<float*>& d_vectors_per_table,
+                                   const std::vector<size_t>& num_keys_per_table) {
+  size_t original_num_tables =
+      inference_params_.fuse_embedding_table
+          ? inference_params_.original_table_id_to_fused_table_id_map.size()
+          : inference_params_.sparse_model_files.size();
+  HCTR_CHECK_HINT(h_keys_per_table.size() == original_num_tables,
+                  "The h_keys_per_table.size() should be equal to the number of embedding tables");
+  HCTR_CHECK_HINT(
+      d_vectors_per_table.size() == original_num_tables,
+      "The d_vectors_per_table.size() should be equal to the number of embedding tables");
+
+  const auto begin = std::chrono::high_resolution_clock::now();
+  BaseUnit* start = profiler::start();
+
+  for (size_t table_id{0}; table_id < original_num_tables; ++table_id) {
+    if (inference_params_.fuse_embedding_table) {
+      auto work_func = [this, h_keys_per_table, d_vectors_per_table, num_keys_per_table,
+                        table_id]() {
+        size_t fused_table_id = inference_params_.original_table_id_to_fused_table_id_map[table_id];
+        this->lookup_with_table_fusion_impl(
+            h_keys_per_table[table_id], d_vectors_per_table[table_id], num_keys_per_table[table_id],
+            table_id, false, lookup_streams_[fused_table_id]);
+      };
+      table_fusion_thread_pool_.submit(work_func);
+    } else {
+      this->lookup_impl(h_keys_per_table[table_id], d_vectors_per_table[table_id],
+                        num_keys_per_table[table_id], table_id, lookup_streams_[table_id]);
+    }
+  }
+  if (inference_params_.fuse_embedding_table) {
+    table_fusion_thread_pool_.await_idle();
+  }
+  // Join all lookup streams onto one stream so the request pays for a single
+  // device synchronization instead of one per table.
+  CudaDeviceContext dev_restorer;
+  dev_restorer.set_device(inference_params_.device_id);
+  for (size_t idx{0}; idx < lookup_streams_.size(); ++idx) {
+    HCTR_LIB_THROW(cudaEventRecord(lookup_done_events_[idx], lookup_streams_[idx]));
+    HCTR_LIB_THROW(cudaStreamWaitEvent(batched_join_stream_, lookup_done_events_[idx]));
+  }
+  HCTR_LIB_THROW(cudaStreamSynchronize(batched_join_stream_));
+
+  ls_profiler_->end(start, "End-to-end batched lookup embedding keys from Lookup session");
+  const auto latency = std::chrono::high_resolution_clock::now() - begin;
+  metrics::Registry::instance().lookup_requests.add(1);
+  metrics::Registry::instance().lookup_latency_us.observe(
+      static_cast<uint64_t>(latency.count() / 1000));
+  HCTR_LOG_S(TRACE, WORLD) << "Batched lookup of multiple tables;"
+                           << "lookup latency: " << latency.count() / 1000 << " us." << std::endl;
+}
+
 void LookupSession::lookup_from_device(const void* d_keys, float* d_vectors, size_t num_keys,
                                        size_t table_id, cudaStream_t stream) {
   if (inference_params_.fuse_embedding_table) {
@@ -353,6 +480,9 @@ void LookupSession::lookup_from_device(const void* const d_keys, float* const d_
 
   ls_profiler_->end(start, "End-to-end lookup embedding keys for Lookup session");
   const auto latency = std::chrono::high_resolution_clock::now() - begin;
+  metrics::Registry::instance().lookup_requests.add(1);
+  metrics::Registry::instance().lookup_latency_us.observe(
+      static_cast<uint64_t>(latency.count() / 1000));
   HCTR_LOG_S(TRACE, WORLD) << "Lookup single table; number of keys " << num_keys << ", table id  "
                            << table_id << "lookup latency: " << latency.count() / 1000 << " us."
                            << std::endl;
@@ -399,6 +529,9 @@ void LookupSession::lookup_from_device(const std::vector<const void*>& d_keys_pe
 
   ls_profiler_->end(start, "End-to-end lookup embedding keys for multi-table Lookup session");
   const auto latency = std::chrono::high_resolution_clock::now() - begin;
+  metrics::Registry::instance().lookup_requests.add(1);
+  metrics::Registry::instance().lookup_latency_us.observe(
+      static_cast<uint64_t>(latency.count() / 1000));
   HCTR_LOG_S(TRACE, WORLD) << "Lookup multiple tables;"
                            << "lookup latency: " << latency.count() / 1000 << " us." << std::endl;
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstring>
 #include <hps/message.hpp>
 
 namespace HugeCTR {
@@ -34,4 +35,139 @@ void MessageSinkBase<Key>::flush() {
 template class MessageSinkBase<unsigned int>;
 template class MessageSinkBase<long long>;
 
+std::string make_invalidation_tag(const std::string& tag) {
+  std::string invalidation_tag{PS_CACHE_INVALIDATION_TAG_PREFIX};
+  invalidation_tag += '.';
+  invalidation_tag += tag;
+  return invalidation_tag;
+}
+
+bool parse_invalidation_tag(const std::string& tag, std::string& table_tag) {
+  const size_t prefix_length = std::strlen(PS_CACHE_INVALIDATION_TAG_PREFIX);
+  if (tag.size() <= prefix_length + 1 || tag[prefix_length] != '.' ||
+      tag.compare(0, prefix_length, PS_CACHE_INVALIDATION_TAG_PREFIX) != 0) {
+    return false;
+  }
+  table_tag = tag.substr(prefix_length + 1);
+  return true;
+}
+
+template <typename Key>
+CacheInvalidationPublisher<Key>::CacheInvalidationPublisher(MessageSinkBase<Key>* const sink,
+                                                            const size_t num_partitions)
+    : sink_{sink}, num_partitions_{num_partitions} {
+  HCTR_CHECK(sink != nullptr);
+  HCTR_CHECK(num_partitions > 0);
+}
+
+template <typename Key>
+void CacheInvalidationPublisher<Key>::on_update(const std::string& tag, const size_t num_pairs,
+                                                const Key* const keys) {
+  if (num_pairs == 0) {
+    return;
+  }
+
+  // Bump the versions of the partitions the batch touches; only they are emitted.
+  std::vector<Key> changed_partitions;
+  std::vector<char> changed_versions;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<uint64_t>& versions{versions_[tag]};
+    versions.resize(num_partitions_, 0);
+
+    std::vector<bool> touched(num_partitions_, false);
+    for (size_t i = 0; i < num_pairs; i++) {
+      touched[invalidation_partition_of(static_cast<uint64_t>(keys[i]), num_partitions_)] = true;
+    }
+
+    for (size_t partition = 0; partition < num_partitions_; partition++) {
+      if (!touched[partition]) {
+        continue;
+      }
+      const uint64_t version = ++versions[partition];
+      changed_partitions.push_back(static_cast<Key>(partition));
+      const char* const version_bytes = reinterpret_cast<const char*>(&version);
+      changed_versions.insert(changed_versions.end(), version_bytes,
+                              version_bytes + sizeof(version));
+    }
+  }
+
+  sink_->post(make_invalidation_tag(tag), changed_partitions.size(), changed_partitions.data(),
+              changed_versions.data(), sizeof(uint64_t));
+}
+
+template class CacheInvalidationPublisher<unsigned int>;
+template class CacheInvalidationPublisher<long long>;
+
+template <typename Key>
+CacheInvalidationTracker<Key>::CacheInvalidationTracker(const size_t num_partitions)
+    : num_partitions_{num_partitions} {
+  HCTR_CHECK(num_partitions > 0);
+}
+
+template <typename Key>
+bool CacheInvalidationTracker<Key>::observe(const std::string& tag, const size_t num_pairs,
+                                            const Key* const keys, const char* const values,
+                                            const size_t value_size) {
+  std::string table_tag;
+  if (!parse_invalidation_tag(tag, table_tag)) {
+    return false;
+  }
+  if (value_size != sizeof(uint64_t)) {
+    HCTR_LOG_C(WARNING, WORLD, "Malformed version vector for tag '", tag, "' (value size ",
+               value_size, " bytes); ignoring.\n");
+    return true;
+  }
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<uint64_t>& seen{seen_versions_[table_tag]};
+  seen.resize(num_partitions_, 0);
+  std::vector<bool>& dirty{dirty_[table_tag]};
+  dirty.resize(num_partitions_, false);
+
+  for (size_t i = 0; i < num_pairs; i++) {
+    const size_t partition = static_cast<size_t>(keys[i]);
+    if (partition >= num_partitions_) {
+      // The publisher runs with a different partition count. Versions cannot be compared
+      // then; conservatively mark the whole table dirty.
+      HCTR_LOG_C(WARNING, WORLD, "Version vector for tag '", tag, "' references partition ",
+                 partition, " >= ", num_partitions_,
+                 "; partition counts mismatch. Marking all partitions dirty.\n");
+      dirty.assign(num_partitions_, true);
+      return true;
+    }
+    uint64_t version;
+    std::memcpy(&version, values + i * sizeof(uint64_t), sizeof(uint64_t));
+    if (version > seen[partition]) {
+      seen[partition] = version;
+      dirty[partition] = true;
+    }
+  }
+  return true;
+}
+
+template <typename Key>
+std::unordered_map<std::string, std::vector<bool>>
+CacheInvalidationTracker<Key>::fetch_dirty_partitions() {
+  std::unordered_map<std::string, std::vector<bool>> result;
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : dirty_) {
+    bool any_dirty = false;
+    for (size_t partition = 0; partition < entry.second.size() && !any_dirty; partition++) {
+      any_dirty = entry.second[partition];
+    }
+    if (any_dirty) {
+      result.emplace(entry.first, entry.second);
+      entry.second.assign(num_partitions_, false);
+    }
+  }
+  return result;
+}
+
+template class CacheInvalidationTracker<unsigned int>;
+template class CacheInvalidationTracker<long long>;
+
 }  // namespace HugeCTR
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hps/metrics.hpp>
+#include <sstream>
+
+namespace HugeCTR {
+
+namespace metrics {
+
+Registry& Registry::instance() {
+  static Registry registry;
+  return registry;
+}
+
+namespace {
+
+void render_counter(std::ostringstream& os, const char* name, const char* help,
+                    const uint64_t value) {
+  os << "# HELP " << name << ' ' << help << '\n';
+  os << "# TYPE " << name << " counter\n";
+  os << name << ' ' << value << '\n';
+}
+
+void render_histogram(std::ostringstream& os, const char* name, const char* help,
+                      const LatencyHistogram& histogram) {
+  uint64_t buckets[LatencyHistogram::NUM_BUCKETS];
+  uint64_t sum;
+  uint64_t count;
+  histogram.snapshot(buckets, sum, count);
+
+  os << "# HELP " << name << ' ' << help << '\n';
+  os << "# TYPE " << name << " histogram\n";
+  uint64_t cumulative = 0;
+  for (int i = 0; i < LatencyHistogram::NUM_BUCKETS - 1; i++) {
+    cumulative += buckets[i];
+    os << name << "_bucket{le=\"" << (1ull << i) << "\"} " << cumulative << '\n';
+  }
+  os << name << "_bucket{le=\"+Inf\"} " << count << '\n';
+  os << name << "_sum " << sum << '\n';
+  os << name << "_count " << count << '\n';
+}
+
+}  // namespace
+
+std::string Registry::export_prometheus() const {
+  std::ostringstream os;
+
+  render_counter(os, "hps_lookup_requests_total", "Synchronous lookup requests served.",
+                 lookup_requests.value());
+  const uint64_t keys = lookup_keys.value();
+  const uint64_t hit_keys = lookup_hit_keys.value();
+  render_counter(os, "hps_lookup_keys_total",
+                 "Unique keys queried against the GPU embedding caches.", keys);
+  render_counter(os, "hps_lookup_hit_keys_total",
+                 "Unique keys served from the GPU embedding caches.", hit_keys);
+
+  os << "# HELP hps_cache_hit_ratio Overall GPU embedding cache hit ratio.\n";
+  os << "# TYPE hps_cache_hit_ratio gauge\n";
+  os << "hps_cache_hit_ratio "
+     << (keys > 0 ? static_cast<double>(hit_keys) / static_cast<double>(keys) : 0.0) << '\n';
+
+  render_histogram(os, "hps_lookup_latency_microseconds",
+                   "End-to-end lookup latency of the lookup session.", lookup_latency_us);
+  render_histogram(os, "hps_miss_fetch_latency_microseconds",
+                   "Database backend fetch latency of cache-missed keys.", miss_fetch_latency_us);
+  render_histogram(os, "hps_refresh_duration_microseconds",
+                   "Duration of full or partial embedding cache refreshes.", refresh_duration_us);
+
+  return os.str();
+}
+
+}  // namespace metrics
+
+}  // namespace HugeCTR
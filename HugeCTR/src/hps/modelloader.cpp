@@ -14,16 +14,59 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <common.hpp>
+#include <core23/staging_buffer_pool.hpp>
+#include <cstdlib>
+#include <fstream>
 #include <hps/inference_utils.hpp>
 #include <hps/modelloader.hpp>
 #include <parser.hpp>
+#include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
+MemoryMappedFile::~MemoryMappedFile() { reset(); }
+
+bool MemoryMappedFile::map(const std::string& path) {
+  reset();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  void* const addr = ::mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  // Startup population walks the files front to back; let the kernel read ahead aggressively.
+  ::madvise(addr, file_stat.st_size, MADV_SEQUENTIAL);
+  data_ = addr;
+  nbytes_ = static_cast<size_t>(file_stat.st_size);
+  return true;
+}
+
+void MemoryMappedFile::reset() {
+  if (data_) {
+    ::munmap(data_, nbytes_);
+    data_ = nullptr;
+    nbytes_ = 0;
+  }
+}
+
 template <typename TKey, typename TValue>
 void* UnifiedEmbeddingTable<TKey, TValue>::get_cache_keys() {
   return this->keys.data();
@@ -156,6 +199,21 @@ void RawModelLoader<TKey, TValue>::load(const std::string& table_name, const std
   const size_t num_key = key_file_size_in_byte / key_size_in_byte;
   embedding_table_->total_key_count = num_key;
 
+  // Map the files directly when they live on a local file system, so the streamed insert
+  // iterations below hand the database backends pointers into the page cache instead of staging
+  // every chunk in heap buffers. Remote paths (S3/GCS/HDFS) fall back to FileSystem::read.
+  // HCTR_MODEL_LOADER_MMAP=0 disables the mapping.
+  const char* mmap_env = std::getenv("HCTR_MODEL_LOADER_MMAP");
+  const bool allow_mmap = !(mmap_env && std::atoi(mmap_env) == 0);
+  use_mmap_ = allow_mmap && std::filesystem::exists(key_file) && key_map_.map(key_file) &&
+              vec_map_.map(vec_file);
+  if (use_mmap_ &&
+      (key_map_.size() != key_file_size_in_byte || vec_map_.size() != vec_file_size_in_byte)) {
+    key_map_.reset();
+    vec_map_.reset();
+    use_mmap_ = false;
+  }
+
   if (std::filesystem::exists(meta_file)) {
     const size_t meta_file_size_in_byte = fs_->get_file_size(meta_file);
     if (meta_file_size_in_byte == 0) {
@@ -194,16 +252,87 @@ void RawModelLoader<TKey, TValue>::load(const std::string& table_name, const std
   }
 }
 
+template <typename TKey, typename TValue>
+size_t RawModelLoader<TKey, TValue>::load_warmup_keys(const std::string& table_name,
+                                                      const std::string& path,
+                                                      const std::string& popularity_file,
+                                                      size_t table_id, size_t max_keys,
+                                                      size_t emb_size) {
+  // Collect the most popular keys of this table from the snapshot. The file is sorted by count
+  // within a table, so reading in order keeps the hottest keys when max_keys truncates.
+  std::ifstream popularity_stream(popularity_file);
+  if (!popularity_stream.is_open()) {
+    HCTR_LOG(WARNING, ROOT,
+             "Cannot open the key-popularity file %s; skip the warm-up of table %s\n",
+             popularity_file.c_str(), table_name.c_str());
+    return 0;
+  }
+  std::unordered_map<TKey, size_t> wanted_keys;
+  std::string line;
+  while (wanted_keys.size() < max_keys && std::getline(popularity_stream, line)) {
+    std::istringstream entry(line);
+    size_t entry_table_id;
+    long long key;
+    unsigned long long count;
+    if ((entry >> entry_table_id >> key >> count) && entry_table_id == table_id) {
+      wanted_keys.emplace(static_cast<TKey>(key), wanted_keys.size());
+    }
+  }
+  if (wanted_keys.empty()) {
+    return 0;
+  }
+
+  const std::string emb_file_prefix = path + "/";
+  const std::string key_file = emb_file_prefix + "key";
+  const std::string vec_file = emb_file_prefix + "emb_vector";
+  auto fs = FileSystemBuilder::build_unique_by_path(path);
+  const size_t num_key = fs->get_file_size(key_file) / sizeof(long long);
+
+  // Scan the key file to locate the selected keys. Duplicate keys in the file keep their first
+  // occurrence.
+  constexpr size_t scan_chunk = 1 << 20;
+  std::vector<long long> key_chunk(std::min(scan_chunk, num_key));
+  std::vector<std::pair<size_t, TKey>> key_positions;
+  key_positions.reserve(wanted_keys.size());
+  for (size_t offset = 0; offset < num_key && !wanted_keys.empty(); offset += scan_chunk) {
+    const size_t chunk_length = std::min(scan_chunk, num_key - offset);
+    fs->read(key_file, key_chunk.data(), chunk_length * sizeof(long long),
+             offset * sizeof(long long));
+    for (size_t i = 0; i < chunk_length && !wanted_keys.empty(); i++) {
+      const TKey key = static_cast<TKey>(key_chunk[i]);
+      if (wanted_keys.erase(key)) {
+        key_positions.emplace_back(offset + i, key);
+      }
+    }
+  }
+
+  // Gather the vectors of the located keys. The positions are ascending by construction, so the
+  // reads move forward through the vector file.
+  embedding_table_->keys.resize(key_positions.size());
+  embedding_table_->vectors.resize(key_positions.size() * emb_size);
+  for (size_t i = 0; i < key_positions.size(); i++) {
+    embedding_table_->keys[i] = key_positions[i].second;
+    fs->read(vec_file, embedding_table_->vectors.data() + i * emb_size,
+             emb_size * sizeof(TValue), key_positions[i].first * emb_size * sizeof(TValue));
+  }
+  embedding_table_->key_count = key_positions.size();
+  return key_positions.size();
+}
+
 template <typename TKey, typename TValue>
 void RawModelLoader<TKey, TValue>::delete_table() {
+  key_map_.reset();
+  vec_map_.reset();
+  use_mmap_ = false;
   std::vector<TKey>().swap(embedding_table_->keys);
   std::vector<TValue>().swap(embedding_table_->vectors);
   std::vector<TKey>().swap(embedding_table_->meta);
   std::vector<TKey>().swap(embedding_table_->uvm_keys);
   std::vector<TValue>().swap(embedding_table_->uvm_vectors);
-  cudaFreeHost(embedding_table_->quant_scales_);
-  cudaFreeHost(embedding_table_->d_vec_);
-  cudaFreeHost(embedding_table_->d_vec_quant);
+  auto& staging_pool = core23::StagingBufferPool::instance();
+  staging_pool.release(embedding_table_->quant_scales_);
+  staging_pool.release(embedding_table_->d_vec_);
+  staging_pool.release(embedding_table_->d_vec_quant);
   delete embedding_table_;
 }
 
@@ -286,12 +415,26 @@ void RawModelLoader<TKey, TValue>::get_cache_uvm(size_t iteration, size_t emb_si
 template <typename TKey, typename TValue>
 std::pair<void*, size_t> RawModelLoader<TKey, TValue>::getkeys(size_t iteration) {
   const std::string key_file = embedding_folder_path + "/" + "key";
-  embedding_table_->keys.resize(key_iteration);
   size_t iteration_reading_amount = key_iteration;
   if ((iteration + 1) * key_iteration > embedding_table_->total_key_count) {
     iteration_reading_amount = embedding_table_->total_key_count - iteration * key_iteration;
   }
 
+  if (use_mmap_) {
+    const long long* mapped_keys =
+        static_cast<const long long*>(key_map_.data()) + iteration * key_iteration;
+    if (std::is_same<TKey, long long>::value) {
+      // Zero-copy: the backend reads straight from the mapping.
+      return std::make_pair(const_cast<long long*>(mapped_keys), iteration_reading_amount);
+    }
+    embedding_table_->keys.resize(key_iteration);
+    std::transform(mapped_keys, mapped_keys + iteration_reading_amount,
+                   embedding_table_->keys.begin(),
+                   [](long long key) { return static_cast<TKey>(key); });
+    return std::make_pair(embedding_table_->keys.data(), iteration_reading_amount);
+  }
+
+  embedding_table_->keys.resize(key_iteration);
   if (std::is_same<TKey, long long>::value) {
     fs_->read(key_file, embedding_table_->keys.data(), iteration_reading_amount * sizeof(TKey),
               iteration * key_iteration * sizeof(TKey));
@@ -309,21 +452,37 @@ template <typename TKey, typename TValue>
 std::pair<void*, size_t> RawModelLoader<TKey, TValue>::getvectors(size_t iteration, size_t emb_size,
                                                                   bool fp8_quant) {
   if (fp8_quant && iteration == 0) {
-    cudaHostAlloc((void**)&(embedding_table_->quant_scales_), key_iteration * sizeof(float),
-                  cudaHostAllocPortable);
-    cudaHostAlloc((void**)&(embedding_table_->d_vec_), key_iteration * emb_size * sizeof(float),
-                  cudaHostAllocPortable);
-    cudaHostAlloc((void**)&(embedding_table_->d_vec_quant),
-                  key_iteration * emb_size * sizeof(__nv_fp8_e4m3), cudaHostAllocPortable);
+    auto& staging_pool = core23::StagingBufferPool::instance();
+    embedding_table_->quant_scales_ =
+        static_cast<float*>(staging_pool.acquire(key_iteration * sizeof(float)));
+    embedding_table_->d_vec_ =
+        static_cast<float*>(staging_pool.acquire(key_iteration * emb_size * sizeof(float)));
+    embedding_table_->d_vec_quant = static_cast<__nv_fp8_e4m3*>(
+        staging_pool.acquire(key_iteration * emb_size * sizeof(__nv_fp8_e4m3)));
     cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
   }
   const std::string vec_file = embedding_folder_path + "/" + "emb_vector";
-  embedding_table_->vectors.resize(key_iteration * emb_size);
   size_t iteration_reading_amount = key_iteration * emb_size;
   if ((iteration + 1) * key_iteration * emb_size > embedding_table_->total_key_count * emb_size) {
     iteration_reading_amount =
         embedding_table_->total_key_count * emb_size - iteration * key_iteration * emb_size;
   }
+
+  if (use_mmap_) {
+    const TValue* mapped_vecs =
+        static_cast<const TValue*>(vec_map_.data()) + iteration * key_iteration * emb_size;
+    if (fp8_quant) {
+      cudaMemcpy(embedding_table_->d_vec_, mapped_vecs, iteration_reading_amount * sizeof(float),
+                 cudaMemcpyHostToDevice);
+      quantizer_->quantize(embedding_table_->d_vec_, embedding_table_->d_vec_quant,
+                           embedding_table_->quant_scales_, key_iteration, emb_size, stream);
+      return std::make_pair(embedding_table_->d_vec_quant, iteration_reading_amount);
+    }
+    // Zero-copy: the backend reads straight from the mapping.
+    return std::make_pair(const_cast<TValue*>(mapped_vecs), iteration_reading_amount);
+  }
+
+  embedding_table_->vectors.resize(key_iteration * emb_size);
   fs_->read(vec_file, embedding_table_->vectors.data(), iteration_reading_amount * sizeof(TValue),
             key_iteration * emb_size * iteration * sizeof(TValue));
   if (fp8_quant) {
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <numa.h>
+
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <boost/interprocess/sync/sharable_lock.hpp>
 #include <boost/utility/string_view.hpp>
 #include <core23/logger.hpp>
+#include <cstdlib>
 #include <hps/hash_map_backend_detail.hpp>
 #include <hps/hier_parameter_server_base.hpp>
 #include <hps/mp_hash_map_backend.hpp>
@@ -28,24 +31,67 @@
 
 namespace HugeCTR {
 
+namespace {
+
+/**
+ * Spread the SHM mapping's pages round-robin across all NUMA nodes. Without this, first-touch
+ * places every page on the node of the inserting thread, so a several-hundred-GB cache ends up
+ * on one socket and all queries contend for that socket's memory bandwidth. The interleave
+ * policy only affects pages that have not been faulted in yet, so it must be applied right
+ * after the segment is mapped. Default on; opt out with HCTR_MP_HASH_MAP_NUMA_INTERLEAVE=0.
+ */
+void interleave_shm_pages(void* addr, size_t size) {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_MP_HASH_MAP_NUMA_INTERLEAVE");
+    return env == nullptr || std::atoi(env) != 0;
+  }();
+  if (!enabled || numa_available() < 0 || numa_max_node() < 1) {
+    return;
+  }
+  numa_interleave_memory(addr, size, numa_all_nodes_ptr);
+  HCTR_LOG_S(INFO, WORLD) << "Interleaving " << size << " bytes of shared memory across "
+                          << numa_max_node() + 1 << " NUMA nodes." << std::endl;
+}
+
+}  // namespace
+
 template <typename Key>
 MultiProcessHashMapBackend<Key>::MultiProcessHashMapBackend(
     const MultiProcessHashMapBackendParams& params)
     : Base(params),
-      sm_segment_(boost::interprocess::open_or_create, params.shared_memory_name.c_str(),
-                  params.shared_memory_size),
+      sm_segment_(params.read_only
+                      ? Segment(boost::interprocess::open_read_only,
+                                params.shared_memory_name.c_str())
+                      : Segment(boost::interprocess::open_or_create,
+                                params.shared_memory_name.c_str(), params.shared_memory_size)),
       char_allocator_{sm_segment_.get_allocator<char>()},
       value_page_allocator_{sm_segment_.get_allocator<ValuePage>()},
       partition_allocator_{sm_segment_.get_allocator<Partition>()},
-      sm_{sm_segment_.find_or_construct<SharedMemory>("sm")(params.heart_beat_frequency,
-                                                            params.auto_remove, sm_segment_)} {
-  HCTR_CHECK(sm_);
+      sm_{params.read_only
+              ? sm_segment_.find<SharedMemory>("sm").first
+              : sm_segment_.find_or_construct<SharedMemory>("sm")(params.heart_beat_frequency,
+                                                                  params.auto_remove, sm_segment_)} {
+  HCTR_CHECK_HINT(sm_, "Shared memory '", params.shared_memory_name,
+                  "' does not contain a database. Start the owner process first!");
+
+  // Read-only processes attach passively. The mapping is write-protected, so they must neither
+  // lock, nor tick the heart beat, nor remove the segment on exit.
+  if (params.read_only) {
+    HCTR_LOG_S(INFO, WORLD) << "Connected to shared memory '" << params.shared_memory_name
+                            << "' in read-only mode; HCTR allocated = " << sm_segment_.get_size()
+                            << " bytes, HCTR free = " << sm_segment_.get_free_memory() << " bytes."
+                            << std::endl;
+    return;
+  }
+
   HCTR_CHECK(sm_->heart_beat_frequency == params.heart_beat_frequency);
   HCTR_CHECK(sm_->auto_remove == params.auto_remove);
 
   HCTR_LOG_S(INFO, WORLD) << "Connecting to shared memory '" << params.shared_memory_name << "'..."
                           << std::endl;
 
+  interleave_shm_pages(sm_segment_.get_address(), sm_segment_.get_size());
+
   // Ensure exclusive access.
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
@@ -94,6 +140,11 @@ MultiProcessHashMapBackend<Key>::~MultiProcessHashMapBackend() {
   HCTR_LOG_S(INFO, WORLD) << "Disconnecting from shared memory '"
                           << this->params_.shared_memory_name << "'." << std::endl;
 
+  // Read-only processes hold no locks, have no heart beat and never remove the segment.
+  if (this->params_.read_only) {
+    return;
+  }
+
   // Ensure exclusive access.
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
@@ -112,7 +163,7 @@ MultiProcessHashMapBackend<Key>::~MultiProcessHashMapBackend() {
 
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::size(const std::string& table_name) const {
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate the partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -130,7 +181,7 @@ size_t MultiProcessHashMapBackend<Key>::contains(
     const std::string& table_name, const size_t num_keys, const Key* const keys,
     const std::chrono::nanoseconds& time_budget) const {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -208,6 +259,8 @@ size_t MultiProcessHashMapBackend<Key>::insert(const std::string& table_name,
                                                const char* const values, const uint32_t value_size,
                                                const size_t value_stride) {
   HCTR_CHECK(value_size <= value_stride);
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `insert` is not permitted!");
 
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
@@ -303,7 +356,7 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
                                               const DatabaseMissCallback& on_miss,
                                               const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate the partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -325,7 +378,11 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
-    const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
+    // Read-only processes must not refresh access metadata (write-protected mapping). The
+    // `EvictRandom` fetch path is the only one that leaves entries untouched.
+    const DatabaseOverflowPolicy_t overflow_policy{this->params_.read_only
+                                                       ? DatabaseOverflowPolicy_t::EvictRandom
+                                                       : part.overflow_policy};
 
     // Step through input batch-by-batch.
     std::chrono::nanoseconds elapsed;
@@ -348,7 +405,9 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
-      const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
+      const DatabaseOverflowPolicy_t overflow_policy{this->params_.read_only
+                                                         ? DatabaseOverflowPolicy_t::EvictRandom
+                                                         : part.overflow_policy};
 
       size_t miss_count{0};
 
@@ -389,7 +448,7 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
                                               const DatabaseMissCallback& on_miss,
                                               const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate the partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -412,7 +471,11 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
     const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
-    const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
+    // Read-only processes must not refresh access metadata (write-protected mapping). The
+    // `EvictRandom` fetch path is the only one that leaves entries untouched.
+    const DatabaseOverflowPolicy_t overflow_policy{this->params_.read_only
+                                                       ? DatabaseOverflowPolicy_t::EvictRandom
+                                                       : part.overflow_policy};
 
     // Step through input batch-by-batch.
     std::chrono::nanoseconds elapsed;
@@ -435,7 +498,9 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
-      const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
+      const DatabaseOverflowPolicy_t overflow_policy{this->params_.read_only
+                                                         ? DatabaseOverflowPolicy_t::EvictRandom
+                                                         : part.overflow_policy};
 
       size_t miss_count{0};
 
@@ -470,6 +535,9 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
 
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `evict` is not permitted!");
+
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
@@ -494,6 +562,9 @@ size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name) {
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name, const size_t num_keys,
                                               const Key* const keys) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `evict` is not permitted!");
+
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
@@ -561,7 +632,7 @@ std::vector<std::string> MultiProcessHashMapBackend<Key>::find_tables(
     const std::string& model_name) {
   const std::string& tag_prefix{HierParameterServerBase::make_tag_name(model_name, "", false)};
 
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   std::vector<std::string> matches;
   for (const auto& pair : sm_->tables) {
@@ -575,7 +646,7 @@ std::vector<std::string> MultiProcessHashMapBackend<Key>::find_tables(
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::dump_bin(const std::string& table_name,
                                                  std::ofstream& file) {
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate the partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -606,7 +677,7 @@ size_t MultiProcessHashMapBackend<Key>::dump_bin(const std::string& table_name,
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::dump_sst(const std::string& table_name,
                                                  rocksdb::SstFileWriter& file) {
-  const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
+  const SharableLock lock{lock_shared_()};
 
   // Locate the partitions.
   const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
@@ -79,6 +79,21 @@ void LookupManager::forward(const std::string& model_name, int32_t table_id,
   }
 }
 
+void LookupManager::forward_graph_safe(const std::string& model_name, int32_t table_id,
+                                       int32_t global_replica_id, size_t num_keys,
+                                       size_t emb_vec_size, const void* values_ptr,
+                                       void* emb_vector_ptr, bool i64_input_tensor,
+                                       cudaStream_t context_stream) {
+  if (!forward_check(model_name, table_id, global_replica_id, num_keys, emb_vec_size,
+                     i64_input_tensor)) {
+    return;
+  }
+  auto lookup_session =
+      lookup_session_map_.find(model_name)->second.find(global_replica_id)->second;
+  lookup_session->lookup_from_device_graph_safe(
+      values_ptr, reinterpret_cast<float*>(emb_vector_ptr), num_keys, table_id, context_stream);
+}
+
 bool LookupManager::init_check(parameter_server_config& ps_config, int32_t global_batch_size,
                                const int32_t num_replicas_in_sync, pluginType_t plugin_type) const {
   switch (plugin_type) {
@@ -16,7 +16,9 @@
 
 #include <boost/algorithm/string.hpp>
 #include <core23/logger.hpp>
+#include <cstdlib>
 #include <hps/database_backend_detail.hpp>
+#include <hps/hash_map_backend_detail.hpp>
 #include <hps/hier_parameter_server_base.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/redis_backend_detail.hpp>
@@ -32,6 +34,18 @@ namespace HugeCTR {
 
 #ifdef HCTR_USE_REDIS
 
+// Packed fetch (`HCTR_HPS_REDIS_PACKED_FETCH`): assembles the whole batch reply on the server
+// into one blob -- a hit flag byte per key, followed by the values of the hits back-to-back --
+// so the client parses a single bulk string instead of one per key.
+static const char* const kRedisPackedFetchScript{
+    "local flags = {} "
+    "local vals = {} "
+    "for i = 1, #ARGV do "
+    "  local v = redis.call('HGET', KEYS[1], ARGV[i]) "
+    "  if v then flags[i] = '\\1' vals[#vals + 1] = v else flags[i] = '\\0' end "
+    "end "
+    "return table.concat(flags) .. table.concat(vals)"};
+
 inline std::string make_hkey(const std::string& table_name, const size_t part, const char suffix) {
   std::ostringstream os;
   // These curly brackets (`{` and `}`) are not a design choice. Instead, this will trigger Redis to
@@ -88,12 +102,19 @@ RedisClusterBackend<Key>::RedisClusterBackend(const RedisClusterBackendParams& p
       host = host.substr(0, comma_pos);
     }
 
-    const std::string::size_type colon_pos = host.find(':');
-    if (colon_pos == std::string::npos) {
-      options.host = host;
+    if (host.rfind("unix://", 0) == 0) {
+      // In-host deployments can skip the TCP loopback entirely. Cluster redirects carry TCP
+      // addresses, so this only works when the co-located instance serves all slots.
+      options.type = sw::redis::ConnectionType::UNIX;
+      options.path = host.substr(7);
     } else {
-      options.host = host.substr(0, colon_pos);
-      options.port = std::stoi(host.substr(colon_pos + 1));
+      const std::string::size_type colon_pos = host.find(':');
+      if (colon_pos == std::string::npos) {
+        options.host = host;
+      } else {
+        options.host = host.substr(0, colon_pos);
+        options.port = std::stoi(host.substr(colon_pos + 1));
+      }
     }
   }
   options.user = params.user_name;
@@ -114,9 +135,27 @@ RedisClusterBackend<Key>::RedisClusterBackend(const RedisClusterBackendParams& p
   sw::redis::ConnectionPoolOptions pool_options;
   pool_options.size = params.num_node_connections;
 
+  // Optionally pipeline consecutive fetch batches to avoid per-batch round-trips.
+  if (const char* const depth_str{std::getenv("HCTR_HPS_REDIS_PIPELINE_DEPTH")}) {
+    pipeline_depth_ = std::max<size_t>(std::stoull(depth_str), 1);
+    HCTR_LOG_C(INFO, WORLD, get_name(), ": Fetch pipeline depth = ", pipeline_depth_, ".\n");
+  }
+
+  // Optionally collapse each fetch batch into one packed server-side reply blob.
+  if (const char* const packed_str{std::getenv("HCTR_HPS_REDIS_PACKED_FETCH")}) {
+    packed_fetch_ = std::atoi(packed_str) != 0;
+    if (packed_fetch_) {
+      HCTR_LOG_C(INFO, WORLD, get_name(), ": Packed fetch enabled.\n");
+    }
+  }
+
   // Connect to cluster.
-  HCTR_LOG_C(INFO, WORLD, get_name(), ": Connecting via ", options.host, ':', options.port,
-             "...\n");
+  if (options.type == sw::redis::ConnectionType::UNIX) {
+    HCTR_LOG_C(INFO, WORLD, get_name(), ": Connecting via ", options.path, "...\n");
+  } else {
+    HCTR_LOG_C(INFO, WORLD, get_name(), ": Connecting via ", options.host, ':', options.port,
+               "...\n");
+  }
   redis_ = std::make_unique<sw::redis::RedisCluster>(options, pool_options);
 }
 
@@ -329,6 +368,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
   const Key* const keys_end{&keys[num_keys]};
   const size_t max_batch_size{this->params_.max_batch_size};
   const size_t num_partitions{this->params_.num_partitions};
+  const size_t pipeline_depth{pipeline_depth_};
 
   size_t miss_count{0};
   size_t skip_count{0};
@@ -348,23 +388,47 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
 
       // Step through input batch-by-batch.
       std::chrono::nanoseconds elapsed;
-      for (const Key* k{keys}; k != keys_end;) {
-        HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
+      if (pipeline_depth > 1) {
+        std::vector<std::vector<sw::redis::StringView>> batch_k_views;
+        batch_k_views.reserve(pipeline_depth);
 
-        const size_t prev_miss_count{miss_count};
-        const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-        if (!HCTR_HPS_REDIS_FETCH_(SEQUENTIAL_DIRECT)) {
-          break;
+        for (const Key* k{keys}; k != keys_end;) {
+          HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
+
+          const size_t prev_miss_count{miss_count};
+          if (!HCTR_HPS_REDIS_FETCH_PIPELINED_(SEQUENTIAL_DIRECT)) {
+            break;
+          }
+
+          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
+                     ": Pipelined ", batch_k_views.size(), " batches; ",
+                     miss_count - prev_miss_count, " misses. Time: ", elapsed.count(), " / ",
+                     time_budget.count(), " ns.\n");
+
+          // Refresh metadata if required.
+          if (touched_keys && !touched_keys->empty()) {
+            queue_metadata_refresh_(table_name, part_index, std::move(touched_keys));
+          }
         }
+      } else {
+        for (const Key* k{keys}; k != keys_end;) {
+          HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
 
-        HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                   ", batch ", (k - keys - 1) / max_batch_size, ": ",
-                   batch_size - miss_count + prev_miss_count, " / ", batch_size,
-                   " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+          const size_t prev_miss_count{miss_count};
+          const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
+          if (!HCTR_HPS_REDIS_FETCH_(SEQUENTIAL_DIRECT)) {
+            break;
+          }
 
-        // Refresh metadata if required.
-        if (touched_keys && !touched_keys->empty()) {
-          queue_metadata_refresh_(table_name, part_index, std::move(touched_keys));
+          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
+                     ", batch ", (k - keys - 1) / max_batch_size, ": ",
+                     batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                     " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+
+          // Refresh metadata if required.
+          if (touched_keys && !touched_keys->empty()) {
+            queue_metadata_refresh_(table_name, part_index, std::move(touched_keys));
+          }
         }
       }
     });
@@ -385,20 +449,39 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
 
         // Step through input batch-by-batch.
         std::chrono::nanoseconds elapsed;
-        size_t num_batches{0};
-        for (const Key* k{keys}; k != keys_end; ++num_batches) {
-          HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_DIRECT, on_miss);
-
-          const size_t prev_miss_count{miss_count};
-          size_t batch_size{0};
-          if (!HCTR_HPS_REDIS_FETCH_(PARALLEL_DIRECT)) {
-            break;
+        if (pipeline_depth > 1) {
+          std::vector<std::vector<sw::redis::StringView>> batch_k_views;
+          batch_k_views.reserve(pipeline_depth);
+
+          for (const Key* k{keys}; k != keys_end;) {
+            HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_DIRECT, on_miss);
+
+            const size_t prev_miss_count{miss_count};
+            if (!HCTR_HPS_REDIS_FETCH_PIPELINED_(PARALLEL_DIRECT)) {
+              break;
+            }
+
+            HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/',
+                       part_index, ": Pipelined ", batch_k_views.size(), " batches; ",
+                       miss_count - prev_miss_count, " misses. Time: ", elapsed.count(), " / ",
+                       time_budget.count(), " ns.\n");
+          }
+        } else {
+          size_t num_batches{0};
+          for (const Key* k{keys}; k != keys_end; ++num_batches) {
+            HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_DIRECT, on_miss);
+
+            const size_t prev_miss_count{miss_count};
+            size_t batch_size{0};
+            if (!HCTR_HPS_REDIS_FETCH_(PARALLEL_DIRECT)) {
+              break;
+            }
+
+            HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/',
+                       part_index, ", batch ", num_batches, ": ",
+                       batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                       " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
           }
-
-          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                     ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count,
-                     " / ", batch_size, " hits. Time: ", elapsed.count(), " / ",
-                     time_budget.count(), " ns.\n");
         }
 
         // Refresh metadata if required.
@@ -431,6 +514,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
   const size_t* const indices_end{&indices[num_indices]};
   const size_t max_batch_size{this->params_.max_batch_size};
   const size_t num_partitions{this->params_.num_partitions};
+  const size_t pipeline_depth{pipeline_depth_};
 
   size_t miss_count{0};
   size_t skip_count{0};
@@ -450,19 +534,38 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
 
       // Step through input batch-by-batch.
       std::chrono::nanoseconds elapsed;
-      for (const size_t* i{indices}; i != indices_end;) {
-        HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
+      if (pipeline_depth > 1) {
+        std::vector<std::vector<sw::redis::StringView>> batch_k_views;
+        batch_k_views.reserve(pipeline_depth);
 
-        const size_t prev_miss_count{miss_count};
-        const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
-        if (!HCTR_HPS_REDIS_FETCH_(SEQUENTIAL_INDIRECT)) {
-          break;
+        for (const size_t* i{indices}; i != indices_end;) {
+          HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
+
+          const size_t prev_miss_count{miss_count};
+          if (!HCTR_HPS_REDIS_FETCH_PIPELINED_(SEQUENTIAL_INDIRECT)) {
+            break;
+          }
+
+          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
+                     ": Pipelined ", batch_k_views.size(), " batches; ",
+                     miss_count - prev_miss_count, " misses. Time: ", elapsed.count(), " / ",
+                     time_budget.count(), " ns.\n");
         }
+      } else {
+        for (const size_t* i{indices}; i != indices_end;) {
+          HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
 
-        HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                   ", batch ", (i - indices - 1) / max_batch_size, ": ",
-                   batch_size - miss_count + prev_miss_count, " / ", batch_size,
-                   " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+          const size_t prev_miss_count{miss_count};
+          const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
+          if (!HCTR_HPS_REDIS_FETCH_(SEQUENTIAL_INDIRECT)) {
+            break;
+          }
+
+          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
+                     ", batch ", (i - indices - 1) / max_batch_size, ": ",
+                     batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                     " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+        }
       }
 
       // Refresh metadata if required.
@@ -487,21 +590,40 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
 
         // Step through input batch-by-batch.
         std::chrono::nanoseconds elapsed;
-        size_t num_batches{0};
-        for (const size_t* i{indices}; i != indices_end; ++num_batches) {
-          HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_INDIRECT, on_miss);
-
-          // Assemble query.
-          const size_t prev_miss_count{miss_count};
-          size_t batch_size{0};
-          if (!HCTR_HPS_REDIS_FETCH_(PARALLEL_INDIRECT)) {
-            break;
+        if (pipeline_depth > 1) {
+          std::vector<std::vector<sw::redis::StringView>> batch_k_views;
+          batch_k_views.reserve(pipeline_depth);
+
+          for (const size_t* i{indices}; i != indices_end;) {
+            HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_INDIRECT, on_miss);
+
+            const size_t prev_miss_count{miss_count};
+            if (!HCTR_HPS_REDIS_FETCH_PIPELINED_(PARALLEL_INDIRECT)) {
+              break;
+            }
+
+            HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/',
+                       part_index, ": Pipelined ", batch_k_views.size(), " batches; ",
+                       miss_count - prev_miss_count, " misses. Time: ", elapsed.count(), " / ",
+                       time_budget.count(), " ns.\n");
+          }
+        } else {
+          size_t num_batches{0};
+          for (const size_t* i{indices}; i != indices_end; ++num_batches) {
+            HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_INDIRECT, on_miss);
+
+            // Assemble query.
+            const size_t prev_miss_count{miss_count};
+            size_t batch_size{0};
+            if (!HCTR_HPS_REDIS_FETCH_(PARALLEL_INDIRECT)) {
+              break;
+            }
+
+            HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/',
+                       part_index, ", batch ", num_batches, ": ",
+                       batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                       " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
           }
-
-          HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                     ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count,
-                     " / ", batch_size, " hits. Time: ", elapsed.count(), " / ",
-                     time_budget.count(), " ns.\n");
         }
 
         // Refresh metadata if required.
@@ -1048,6 +1170,53 @@ void RedisClusterBackend<Key>::refresh_metadata_lru_(const std::string& table_na
   });
 }
 
+template <typename Key>
+void RedisClusterBackend<Key>::fetch_packed_batch_(
+    const std::string& hkey_v, const std::vector<sw::redis::StringView>& k_views,
+    const Key* const keys, char* const values, const size_t value_stride,
+    const DatabaseMissCallback& on_miss, size_t& miss_count,
+    std::shared_ptr<std::vector<Key>>& touched_keys) {
+  const std::vector<sw::redis::StringView> script_keys{hkey_v};
+  sw::redis::Redis node{redis_->redis(hkey_v, false)};
+  const std::string blob{node.eval<std::string>(kRedisPackedFetchScript, script_keys.begin(),
+                                                script_keys.end(), k_views.begin(),
+                                                k_views.end())};
+
+  const size_t batch_size{k_views.size()};
+  HCTR_CHECK(blob.size() >= batch_size);
+  const char* const flags{blob.data()};
+
+  size_t hit_count{0};
+  for (size_t i{0}; i < batch_size; ++i) {
+    hit_count += flags[i] != 0;
+  }
+
+  // All values of one table are uniformly sized, so the size falls out of the payload.
+  const size_t payload_bytes{blob.size() - batch_size};
+  HCTR_CHECK(hit_count == 0 || payload_bytes % hit_count == 0);
+  const size_t value_size{hit_count != 0 ? payload_bytes / hit_count : 0};
+  HCTR_CHECK(value_size <= value_stride);
+
+  const char* src{flags + batch_size};
+  for (size_t i{0}; i < batch_size; ++i) {
+    const Key* const k{reinterpret_cast<const Key*>(k_views[i].data())};
+    if (flags[i]) {
+      hps_value_copy(src, value_size, &values[(k - keys) * value_stride]);
+      src += value_size;
+
+      if (this->params_.overflow_policy != DatabaseOverflowPolicy_t::EvictRandom) {
+        if (!touched_keys) {
+          touched_keys = std::make_shared<std::vector<Key>>();
+        }
+        touched_keys->emplace_back(keys[k - keys]);
+      }
+    } else {
+      on_miss(k - keys);
+      ++miss_count;
+    }
+  }
+}
+
 template <typename Key>
 void RedisClusterBackend<Key>::queue_metadata_refresh_(const std::string& table_name,
                                                        const size_t part_index,
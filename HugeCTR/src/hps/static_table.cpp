@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/memory_pool.hpp>
 #include <hps/static_table.hpp>
@@ -94,6 +95,23 @@ StaticTable<TypeHashKey, TypeEmbVec>::StaticTable(const InferenceParams& inferen
     cache_config_.num_set_in_cache_.push_back(num_row);
   }
 
+  // Optional double-buffered refresh; trades a second device-memory copy of every table for
+  // stall-free model-version rollover.
+  if (const char* const env = std::getenv("HCTR_STATIC_TABLE_DOUBLE_BUFFER")) {
+    double_buffer_ = std::atoi(env) != 0;
+  }
+  if (double_buffer_) {
+    HCTR_LOG(INFO, ROOT, "Static table double-buffered refresh enabled.\n");
+    active_tables_ = std::make_unique<std::atomic<Cache*>[]>(cache_config_.num_emb_table_);
+    for (size_t i = 0; i < cache_config_.num_emb_table_; i++) {
+      const size_t num_row = ps_config.embedding_key_count_.at(inference_params.model_name)[i];
+      shadow_tables_.emplace_back(std::make_unique<Cache>(
+          num_row, cache_config_.embedding_vec_size_[i],
+          cache_config_.default_value_for_each_table[i], inference_params.enable_pagelock));
+      active_tables_[i].store(static_tables_[i].get(), std::memory_order_relaxed);
+    }
+  }
+
   const size_t max_num_keys =
       *max_element(cache_config_.num_set_in_cache_.begin(), cache_config_.num_set_in_cache_.end());
   HCTR_LIB_THROW(cudaMalloc(&d_insert_keys_buffer_, sizeof(TypeHashKey) * max_num_keys));
@@ -161,6 +179,22 @@ void StaticTable<TypeHashKey, TypeEmbVec>::lookup_from_device(size_t table_id, f
   parameter_server_->free_buffer(memory_block);
 }
 
+template <typename TypeHashKey, typename TypeEmbVec>
+void StaticTable<TypeHashKey, TypeEmbVec>::lookup_from_device_graph_safe(size_t table_id,
+                                                                         float* d_vectors,
+                                                                         const void* d_keys,
+                                                                         size_t num_keys,
+                                                                         cudaStream_t stream) {
+  // Query consumes the caller's device keys directly: no workspace pool, no key staging and no
+  // profiler bookkeeping, so everything issued here is stream-ordered and capturable. Missing
+  // keys yield the table's default vector until the background refresh resolves them.
+  CudaDeviceContext dev_restorer;
+  dev_restorer.check_device(cache_config_.cuda_dev_id_);
+
+  active_table_(table_id)->Query(static_cast<const TypeHashKey*>(d_keys), num_keys, d_vectors,
+                                 stream);
+}
+
 template <typename TypeHashKey, typename TypeEmbVec>
 void StaticTable<TypeHashKey, TypeEmbVec>::lookup_from_device(size_t table_id, float* d_vectors,
                                                               MemoryBlock* memory_block,
@@ -171,7 +205,7 @@ void StaticTable<TypeHashKey, TypeEmbVec>::lookup_from_device(size_t table_id, f
   CudaDeviceContext dev_restorer;
   dev_restorer.check_device(cache_config_.cuda_dev_id_);
 
-  static_tables_[table_id]->Query(
+  active_table_(table_id)->Query(
       static_cast<TypeHashKey*>(workspace_handler.d_embeddingcolumns_[table_id]), num_keys,
       d_vectors, stream);
 }
@@ -316,9 +350,9 @@ void StaticTable<TypeHashKey, TypeEmbVec>::init(const size_t table_id,
   dev_restorer.check_device(cache_config_.cuda_dev_id_);
   HCTR_LIB_THROW(cudaMemcpyAsync(d_insert_keys_buffer_, h_refresh_embeddingcolumns_,
                                  sizeof(TypeHashKey) * h_length_, cudaMemcpyHostToDevice, stream));
-  static_tables_[table_id]->Add(static_cast<TypeHashKey*>(d_insert_keys_buffer_), h_length_,
-                                reinterpret_cast<TypeEmbVec*>(h_refresh_emb_vec_), h_quant_scales,
-                                stream);
+  active_table_(table_id)->Add(static_cast<TypeHashKey*>(d_insert_keys_buffer_), h_length_,
+                               reinterpret_cast<TypeEmbVec*>(h_refresh_emb_vec_), h_quant_scales,
+                               stream);
   HCTR_LIB_THROW(cudaStreamSynchronize(stream));
 }
 
@@ -328,6 +362,21 @@ void StaticTable<TypeHashKey, TypeEmbVec>::refresh(const size_t table_id, const
                                                    cudaStream_t stream) {
   CudaDeviceContext dev_restorer;
   dev_restorer.check_device(cache_config_.cuda_dev_id_);
+  if (double_buffer_) {
+    // Build the new version in the off-line instance, then publish it with an atomic swap.
+    // Lookups that already hold the old pointer keep reading the previous version; it is not
+    // recycled before the next refresh, which is far beyond the lifetime of any in-flight
+    // lookup kernel.
+    Cache* const front{active_tables_[table_id].load(std::memory_order_relaxed)};
+    Cache* const shadow{front == static_tables_[table_id].get() ? shadow_tables_[table_id].get()
+                                                                : static_tables_[table_id].get()};
+    shadow->Clear(stream);
+    shadow->Init(static_cast<const TypeHashKey*>(d_keys), length,
+                 static_cast<const TypeEmbVec*>(d_vectors), stream);
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+    active_tables_[table_id].store(shadow, std::memory_order_release);
+    return;
+  }
   static_tables_[table_id]->Clear(stream);
   static_tables_[table_id]->Init(static_cast<const TypeHashKey*>(d_keys), length,
                                  static_cast<const TypeEmbVec*>(d_vectors), stream);
@@ -0,0 +1,672 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <core23/logger.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <hps/hier_parameter_server_base.hpp>
+#include <hps/value_log_backend.hpp>
+#include <numeric>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+namespace {
+
+// O_DIRECT transfers must be aligned to the logical block size; 4 KiB covers all NVMe devices.
+constexpr size_t direct_io_alignment{4096};
+
+inline uint64_t align_down(const uint64_t x) { return x & ~(direct_io_alignment - 1); }
+inline uint64_t align_up(const uint64_t x) {
+  return (x + direct_io_alignment - 1) & ~(direct_io_alignment - 1);
+}
+
+struct FreeDeleter {
+  void operator()(char* const p) const { std::free(p); }
+};
+using AlignedBuffer = std::unique_ptr<char, FreeDeleter>;
+
+inline AlignedBuffer alloc_aligned(const size_t size) {
+  char* const p{static_cast<char*>(
+      std::aligned_alloc(direct_io_alignment, static_cast<size_t>(align_up(size))))};
+  HCTR_CHECK_HINT(p, "Failed to allocate aligned I/O buffer (", size, " bytes)!");
+  return AlignedBuffer{p};
+}
+
+inline void write_all(const int fd, const char* data, size_t size) {
+  while (size) {
+    const ssize_t num_written{::write(fd, data, size)};
+    HCTR_CHECK_HINT(num_written > 0, "Value log write failed: ", std::strerror(errno));
+    data += num_written;
+    size -= static_cast<size_t>(num_written);
+  }
+}
+
+inline void pread_all(const int fd, char* data, size_t size, uint64_t offset) {
+  while (size) {
+    const ssize_t num_read{::pread(fd, data, size, static_cast<off_t>(offset))};
+    HCTR_CHECK_HINT(num_read > 0, "Value log read failed: ", std::strerror(errno));
+    data += num_read;
+    size -= static_cast<size_t>(num_read);
+    offset += static_cast<uint64_t>(num_read);
+  }
+}
+
+// One resolved fetch hit: read `value_size` bytes at `offset` from the value log into `dst`.
+struct ReadJob {
+  uint64_t offset;
+  char* dst;
+};
+
+/**
+ * Serve a batch of resolved fetch hits from the value log. Prefers O_DIRECT reads (batched
+ * through io_uring, if available) and falls back to buffered `pread` if the file-system does not
+ * support direct I/O.
+ */
+void read_values(const int direct_fd, const int cached_fd, const uint64_t log_size,
+                 const uint32_t value_size, const std::vector<ReadJob>& jobs,
+                 const size_t io_depth) {
+  if (jobs.empty()) {
+    return;
+  }
+
+  // Aligned span that is guaranteed to cover one arbitrarily placed value.
+  const size_t span_size{static_cast<size_t>(align_up(value_size)) + direct_io_alignment};
+
+#ifdef ENABLE_IO_URING
+  if (direct_fd >= 0) {
+    const size_t depth{std::max<size_t>(std::min(io_depth, jobs.size()), 1)};
+    const AlignedBuffer staging{alloc_aligned(depth * span_size)};
+
+    io_uring ring;
+    {
+      const int ret{io_uring_queue_init(static_cast<unsigned>(depth), &ring, 0)};
+      HCTR_CHECK_HINT(ret == 0, "io_uring_queue_init failed: ", std::strerror(-ret));
+    }
+
+    std::vector<size_t> free_slots(depth);
+    std::iota(free_slots.begin(), free_slots.end(), 0);
+    std::vector<size_t> job_slots(jobs.size());
+
+    size_t next_job{0};
+    size_t num_completed{0};
+    while (num_completed < jobs.size()) {
+      // Top up the submission queue.
+      unsigned num_prepped{0};
+      while (next_job < jobs.size() && !free_slots.empty()) {
+        io_uring_sqe* const sqe{io_uring_get_sqe(&ring)};
+        if (!sqe) {
+          break;
+        }
+        const ReadJob& job{jobs[next_job]};
+        const size_t slot{free_slots.back()};
+        free_slots.pop_back();
+        job_slots[next_job] = slot;
+
+        const uint64_t span_begin{align_down(job.offset)};
+        const size_t span_len{
+            static_cast<size_t>(std::min(align_up(job.offset + value_size), align_up(log_size)) -
+                                span_begin)};
+        io_uring_prep_read(sqe, direct_fd, staging.get() + slot * span_size,
+                           static_cast<unsigned>(span_len), span_begin);
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(next_job));
+        ++next_job;
+        ++num_prepped;
+      }
+      if (num_prepped) {
+        const int ret{io_uring_submit(&ring)};
+        HCTR_CHECK_HINT(ret >= 0, "io_uring_submit failed: ", std::strerror(-ret));
+      }
+
+      // Reap at least one completion, and whatever else is already available.
+      io_uring_cqe* cqe;
+      {
+        const int ret{io_uring_wait_cqe(&ring, &cqe)};
+        HCTR_CHECK_HINT(ret == 0, "io_uring_wait_cqe failed: ", std::strerror(-ret));
+      }
+      do {
+        const size_t job_index{reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe))};
+        const ReadJob& job{jobs[job_index]};
+        const uint64_t span_begin{align_down(job.offset)};
+
+        HCTR_CHECK_HINT(cqe->res >= 0,
+                        "Value log io_uring read failed: ", std::strerror(-cqe->res));
+        HCTR_CHECK_HINT(static_cast<uint64_t>(cqe->res) >= job.offset + value_size - span_begin,
+                        "Value log read truncated!");
+
+        const size_t slot{job_slots[job_index]};
+        std::copy_n(staging.get() + slot * span_size + (job.offset - span_begin), value_size,
+                    job.dst);
+        free_slots.push_back(slot);
+
+        io_uring_cqe_seen(&ring, cqe);
+        ++num_completed;
+      } while (num_completed < jobs.size() && io_uring_peek_cqe(&ring, &cqe) == 0);
+    }
+
+    io_uring_queue_exit(&ring);
+    return;
+  }
+#endif  // ENABLE_IO_URING
+
+  if (direct_fd >= 0) {
+    const AlignedBuffer staging{alloc_aligned(span_size)};
+    for (const ReadJob& job : jobs) {
+      const uint64_t span_begin{align_down(job.offset)};
+      const size_t span_len{
+          static_cast<size_t>(std::min(align_up(job.offset + value_size), align_up(log_size)) -
+                              span_begin)};
+
+      // A single read suffices; short reads only happen at the (unaligned) end of the log.
+      const ssize_t num_read{
+          ::pread(direct_fd, staging.get(), span_len, static_cast<off_t>(span_begin))};
+      HCTR_CHECK_HINT(num_read >= 0, "Value log read failed: ", std::strerror(errno));
+      HCTR_CHECK_HINT(static_cast<uint64_t>(num_read) >= job.offset + value_size - span_begin,
+                      "Value log read truncated!");
+
+      std::copy_n(staging.get() + (job.offset - span_begin), value_size, job.dst);
+    }
+  } else {
+    for (const ReadJob& job : jobs) {
+      pread_all(cached_fd, job.dst, value_size, job.offset);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename Key>
+ValueLogBackend<Key>::Table::~Table() {
+  for (const int fd : {log_write_fd, log_direct_fd, log_cached_fd, index_write_fd}) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+template <typename Key>
+ValueLogBackend<Key>::ValueLogBackend(const ValueLogBackendParams& params) : Base(params) {
+  HCTR_LOG(INFO, WORLD, "Opening ValueLog database...\n");
+
+  if (!this->params_.read_only) {
+    std::filesystem::create_directories(this->params_.path);
+  }
+
+  // Recover tables that already exist on disk.
+  if (std::filesystem::exists(this->params_.path)) {
+    for (const auto& entry : std::filesystem::directory_iterator(this->params_.path)) {
+      if (entry.path().extension() != ".keys") {
+        continue;
+      }
+      const std::string table_name{entry.path().stem().string()};
+      HCTR_LOG_C(INFO, WORLD, "ValueLog ", this->params_.path, ", found table `", table_name,
+                 "`.\n");
+      tables_.emplace(table_name, open_table_(table_name, 0));
+    }
+  }
+
+  HCTR_LOG(INFO, WORLD, "Connected to ValueLog database!\n");
+}
+
+template <typename Key>
+ValueLogBackend<Key>::~ValueLogBackend() {
+  HCTR_LOG(INFO, WORLD, "Disconnecting from ValueLog database...\n");
+
+  if (!this->params_.read_only) {
+    const std::unique_lock lock(tables_guard_);
+    for (const auto& pair : tables_) {
+      HCTR_CHECK_HINT(::fdatasync(pair.second->log_write_fd) == 0,
+                      "Value log sync failed: ", std::strerror(errno));
+      HCTR_CHECK_HINT(::fdatasync(pair.second->index_write_fd) == 0,
+                      "Index log sync failed: ", std::strerror(errno));
+    }
+  }
+  tables_.clear();
+
+  HCTR_LOG(INFO, WORLD, "Disconnected from ValueLog database!\n");
+}
+
+template <typename Key>
+std::unique_ptr<typename ValueLogBackend<Key>::Table> ValueLogBackend<Key>::open_table_(
+    const std::string& table_name, const uint32_t value_size) {
+  const std::filesystem::path value_path{value_log_path_(table_name)};
+  const std::filesystem::path index_path{index_log_path_(table_name)};
+
+  auto table{std::make_unique<Table>()};
+
+  // Replay the index log, if the table already exists on disk.
+  const bool exists{std::filesystem::exists(index_path)};
+  if (exists) {
+    std::ifstream file{index_path, std::ios::binary};
+    HCTR_CHECK_HINT(file.is_open(), "Unable to open index log `", index_path.string(), "`!");
+
+    file.read(reinterpret_cast<char*>(&table->value_size), sizeof(uint32_t));
+    HCTR_CHECK_HINT(!file.fail(), "Index log `", index_path.string(), "` is corrupt!");
+    HCTR_CHECK(!value_size || value_size == table->value_size);
+
+    // A partially written trailing record (crash during insert) is silently discarded.
+    IndexRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(IndexRecord))) {
+      if (record.offset == tombstone_offset_) {
+        table->index.erase(record.key);
+      } else {
+        table->index.insert_or_assign(record.key, record.offset);
+      }
+    }
+
+    table->log_size =
+        std::filesystem::exists(value_path) ? std::filesystem::file_size(value_path) : 0;
+  } else {
+    HCTR_CHECK_HINT(!this->params_.read_only, "ValueLog table `", table_name,
+                    "` does not exist. Cannot create tables in read-only mode!");
+    HCTR_CHECK(value_size > 0);
+    table->value_size = value_size;
+  }
+
+  // Write handles (append-only).
+  if (!this->params_.read_only) {
+    table->log_write_fd = ::open(value_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    HCTR_CHECK_HINT(table->log_write_fd >= 0, "Unable to open value log `", value_path.string(),
+                    "`: ", std::strerror(errno));
+    table->index_write_fd = ::open(index_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    HCTR_CHECK_HINT(table->index_write_fd >= 0, "Unable to open index log `", index_path.string(),
+                    "`: ", std::strerror(errno));
+    if (!exists) {
+      write_all(table->index_write_fd, reinterpret_cast<const char*>(&table->value_size),
+                sizeof(uint32_t));
+    }
+  }
+
+  // Read handles.
+  table->log_cached_fd = ::open(value_path.c_str(), O_RDONLY);
+  HCTR_CHECK_HINT(table->log_cached_fd >= 0, "Unable to open value log `", value_path.string(),
+                  "`: ", std::strerror(errno));
+  table->log_direct_fd = ::open(value_path.c_str(), O_RDONLY | O_DIRECT);
+  if (table->log_direct_fd < 0) {
+    HCTR_LOG_C(WARNING, WORLD, get_name(), " backend; Table ", table_name,
+               ": File-system does not support O_DIRECT (", std::strerror(errno),
+               "). Falling back to buffered reads.\n");
+  }
+
+  return table;
+}
+
+template <typename Key>
+typename ValueLogBackend<Key>::Table& ValueLogBackend<Key>::get_or_create_table_(
+    const std::string& table_name, const uint32_t value_size) {
+  {
+    const std::shared_lock lock(tables_guard_);
+    const auto& it{tables_.find(table_name)};
+    if (it != tables_.end()) {
+      return *it->second;
+    }
+  }
+
+  const std::unique_lock lock(tables_guard_);
+  std::unique_ptr<Table>& table{tables_[table_name]};
+  if (!table) {
+    table = open_table_(table_name, value_size);
+  }
+  return *table;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::size(const std::string& table_name) const {
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+
+  const std::shared_lock table_lock(table->guard);
+  return table->index.size();
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::contains(const std::string& table_name, const size_t num_keys,
+                                      const Key* const keys,
+                                      const std::chrono::nanoseconds& time_budget) const {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::contains(table_name, num_keys, keys, time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  size_t hit_count{0};
+  size_t skip_count{0};
+
+  // Step through keys batch-by-batch.
+  std::chrono::nanoseconds elapsed;
+  const Key* const keys_end{&keys[num_keys]};
+  for (const Key* k{keys}; k != keys_end;) {
+    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, nullptr);
+
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT,
+                       hit_count += table->index.find(*k) != table->index.end());
+  }
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_keys - skip_count, " hits, ", skip_count, " skipped.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::insert(const std::string& table_name, const size_t num_pairs,
+                                    const Key* const keys, const char* const values,
+                                    const uint32_t value_size, const size_t value_stride) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `insert` is not permitted!");
+  HCTR_CHECK(value_size > 0 && value_size <= value_stride);
+
+  Table& table{get_or_create_table_(table_name, value_size)};
+  const std::unique_lock table_lock(table.guard);
+  HCTR_CHECK(table.value_size == value_size);
+
+  size_t num_inserts{0};
+
+  std::vector<char> staging;
+  staging.reserve(std::min(num_pairs, this->params_.max_batch_size) * value_size);
+  std::vector<IndexRecord> records;
+  records.reserve(std::min(num_pairs, this->params_.max_batch_size));
+
+  const Key* const keys_end{&keys[num_pairs]};
+  for (const Key* k{keys}; k != keys_end;) {
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+
+    const size_t prev_num_inserts{num_inserts};
+    staging.clear();
+    records.clear();
+    HCTR_HPS_DB_APPLY_(
+        SEQUENTIAL_DIRECT, const char* const value{&values[(k - keys) * value_stride]};
+        staging.insert(staging.end(), value, &value[value_size]);
+        records.push_back(IndexRecord{*k, table.log_size});
+        num_inserts += table.index.insert_or_assign(*k, table.log_size).second;
+        table.log_size += value_size);
+
+    // Values must reach the log before the index records that reference them.
+    write_all(table.log_write_fd, staging.data(), staging.size());
+    write_all(table.index_write_fd, reinterpret_cast<const char*>(records.data()),
+              records.size() * sizeof(IndexRecord));
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (k - keys - 1) / this->params_.max_batch_size, ": Inserted ",
+               num_inserts - prev_num_inserts, " + updated ",
+               batch_size - num_inserts + prev_num_inserts, " = ", batch_size, " entries.\n");
+  }
+
+  // Durability point (corresponds to RocksDB's WAL flush).
+  HCTR_CHECK_HINT(::fdatasync(table.log_write_fd) == 0,
+                  "Value log sync failed: ", std::strerror(errno));
+  HCTR_CHECK_HINT(::fdatasync(table.index_write_fd) == 0,
+                  "Index log sync failed: ", std::strerror(errno));
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Inserted ", num_inserts,
+             " + updated ", num_pairs - num_inserts, " = ", num_pairs, " entries.\n");
+  return num_inserts;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::fetch(const std::string& table_name, const size_t num_keys,
+                                   const Key* const keys, char* const values,
+                                   const size_t value_stride, const DatabaseMissCallback& on_miss,
+                                   const std::chrono::nanoseconds& time_budget) {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::fetch(table_name, num_keys, keys, values, value_stride, on_miss, time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  size_t miss_count{0};
+  size_t skip_count{0};
+
+  std::vector<ReadJob> jobs;
+  jobs.reserve(std::min(num_keys, this->params_.max_batch_size));
+
+  // Step through input batch-by-batch.
+  std::chrono::nanoseconds elapsed;
+  const Key* const keys_end{&keys[num_keys]};
+  for (const Key* k{keys}; k != keys_end;) {
+    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
+
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+
+    const size_t prev_miss_count{miss_count};
+    jobs.clear();
+    HCTR_HPS_DB_APPLY_(
+        SEQUENTIAL_DIRECT, const auto& it{table->index.find(*k)};
+        if (it != table->index.end()) {
+          jobs.push_back(ReadJob{it->second, &values[(k - keys) * value_stride]});
+        } else {
+          on_miss(k - keys);
+          ++miss_count;
+        });
+    read_values(table->log_direct_fd, table->log_cached_fd, table->log_size, table->value_size,
+                jobs, this->params_.io_depth);
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (k - keys - 1) / this->params_.max_batch_size, ": ",
+               batch_size - miss_count + prev_miss_count, " / ", batch_size,
+               " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+  }
+
+  const size_t hit_count{num_keys - skip_count - miss_count};
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_keys - skip_count, " hits; skipped ", skip_count, " keys.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::fetch(const std::string& table_name, const size_t num_indices,
+                                   const size_t* const indices, const Key* const keys,
+                                   char* const values, const size_t value_stride,
+                                   const DatabaseMissCallback& on_miss,
+                                   const std::chrono::nanoseconds& time_budget) {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::fetch(table_name, num_indices, indices, keys, values, value_stride, on_miss,
+                       time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  size_t miss_count{0};
+  size_t skip_count{0};
+
+  std::vector<ReadJob> jobs;
+  jobs.reserve(std::min(num_indices, this->params_.max_batch_size));
+
+  std::chrono::nanoseconds elapsed;
+  const size_t* const indices_end{&indices[num_indices]};
+  for (const size_t* i{indices}; i != indices_end;) {
+    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
+
+    const size_t batch_size{std::min<size_t>(indices_end - i, this->params_.max_batch_size)};
+
+    const size_t prev_miss_count{miss_count};
+    jobs.clear();
+    HCTR_HPS_DB_APPLY_(
+        SEQUENTIAL_INDIRECT, const auto& it{table->index.find(*k)};
+        if (it != table->index.end()) {
+          jobs.push_back(ReadJob{it->second, &values[(k - keys) * value_stride]});
+        } else {
+          on_miss(k - keys);
+          ++miss_count;
+        });
+    read_values(table->log_direct_fd, table->log_cached_fd, table->log_size, table->value_size,
+                jobs, this->params_.io_depth);
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (i - indices - 1) / this->params_.max_batch_size, ": ",
+               batch_size - miss_count + prev_miss_count, " / ", batch_size,
+               " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+  }
+
+  const size_t hit_count{num_indices - skip_count - miss_count};
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_indices - skip_count, " hits; skipped ", skip_count, " keys.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::evict(const std::string& table_name) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `evict` is not permitted!");
+
+  const std::unique_lock lock(tables_guard_);
+  const auto& it{tables_.find(table_name)};
+  if (it == tables_.end()) {
+    return 0;
+  }
+  const size_t num_entries{it->second->index.size()};
+
+  // Drop the entire table; closes the file handles before deleting the logs.
+  tables_.erase(it);
+  std::filesystem::remove(value_log_path_(table_name));
+  std::filesystem::remove(index_log_path_(table_name));
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_entries,
+             " entries.\n");
+  return num_entries;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::evict(const std::string& table_name, const size_t num_keys,
+                                   const Key* const keys) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(),
+                  " backend is attached in read-only mode. `evict` is not permitted!");
+
+  Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::unique_lock table_lock(table->guard);
+
+  size_t num_deletions{0};
+
+  std::vector<IndexRecord> records;
+  records.reserve(std::min(num_keys, this->params_.max_batch_size));
+
+  const Key* const keys_end{&keys[num_keys]};
+  for (const Key* k{keys}; k != keys_end;) {
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+
+    records.clear();
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT, if (table->index.erase(*k)) {
+      records.push_back(IndexRecord{*k, tombstone_offset_});
+      ++num_deletions;
+    });
+
+    // The value slots are leaked deliberately; the log is append-only.
+    write_all(table->index_write_fd, reinterpret_cast<const char*>(records.data()),
+              records.size() * sizeof(IndexRecord));
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (k - keys - 1) / this->params_.max_batch_size, ": Erased ", records.size(), " / ",
+               batch_size, " entries.\n");
+  }
+  HCTR_CHECK_HINT(::fdatasync(table->index_write_fd) == 0,
+                  "Index log sync failed: ", std::strerror(errno));
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_deletions,
+             " / ", num_keys, " entries.\n");
+  return num_deletions;
+}
+
+template <typename Key>
+std::vector<std::string> ValueLogBackend<Key>::find_tables(const std::string& model_name) {
+  const std::string& tag_prefix{HierParameterServerBase::make_tag_name(model_name, "", false)};
+
+  const std::shared_lock lock(tables_guard_);
+
+  std::vector<std::string> table_names;
+  for (const auto& pair : tables_) {
+    if (pair.first.find(tag_prefix) == 0) {
+      table_names.emplace_back(pair.first);
+    }
+  }
+  return table_names;
+}
+
+template <typename Key>
+size_t ValueLogBackend<Key>::dump_bin(const std::string& table_name, std::ofstream& file) {
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  // Value size field.
+  const uint32_t value_size{table->index.empty() ? 0 : table->value_size};
+  file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
+
+  std::vector<char> value(value_size);
+  for (const auto& pair : table->index) {
+    pread_all(table->log_cached_fd, value.data(), value_size, pair.second);
+    file.write(reinterpret_cast<const char*>(&pair.first), sizeof(Key));
+    file.write(value.data(), value_size);
+  }
+  return table->index.size();
+}
+
+#ifdef HCTR_USE_ROCKS_DB
+template <typename Key>
+size_t ValueLogBackend<Key>::dump_sst(const std::string& table_name,
+                                      rocksdb::SstFileWriter& file) {
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  // SST files require the keys in sorted order.
+  std::vector<std::pair<Key, uint64_t>> entries;
+  entries.reserve(table->index.size());
+  for (const auto& pair : table->index) {
+    entries.emplace_back(pair.first, pair.second);
+  }
+  std::sort(entries.begin(), entries.end());
+
+  std::vector<char> value(table->value_size);
+  for (const auto& entry : entries) {
+    pread_all(table->log_cached_fd, value.data(), table->value_size, entry.second);
+    HCTR_ROCKSDB_CHECK(file.Put({reinterpret_cast<const char*>(&entry.first), sizeof(Key)},
+                                {value.data(), value.size()}));
+  }
+  return entries.size();
+}
+#endif  // HCTR_USE_ROCKS_DB
+
+template class ValueLogBackend<unsigned int>;
+template class ValueLogBackend<long long>;
+
+}  // namespace HugeCTR
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <argparse/argparse.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <common.hpp>
+#include <cstdlib>
+#include <hps/embedding_cache.hpp>
+#include <hps/hier_parameter_server.hpp>
+#include <hps/inference_utils.hpp>
+#include <hps/lookup_session.hpp>
+#include <inference_key_generator.hpp>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace HugeCTR;
+
+/**
+ * HPS load generator. Unlike the single-threaded hps_profiler, which measures component latency
+ * in isolation, this harness drives many concurrent lookup sessions against the deployed devices
+ * to answer capacity questions before a rollout:
+ *
+ *  - Closed loop: each session issues its next request as soon as the previous one completes,
+ *    which measures the saturation throughput of the deployment.
+ *  - Open loop: requests arrive on a shared Poisson schedule at a configured QPS, so reported
+ *    latency includes the queueing delay a real frontend would see. An open-loop run whose p99
+ *    stays flat is the usual "can we serve this rate" signal.
+ *
+ * Key popularity is skewed with the generators from inference_key_generator.hpp (power-law,
+ * hot-key, or histogram), matching the hps_profiler options.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class KeyDistribution_t { Powerlaw, Hotkey, Histogram };
+
+struct LoadgenConfig {
+  KeyDistribution_t distribution;
+  size_t table_size;
+  size_t num_keys;
+  float alpha;
+  float hot_key_percentage;
+  float hot_key_coverage;
+  std::vector<double> histogram;
+  int num_sessions;
+  int requests;
+  int warmup_requests;
+  double target_qps;  // <= 0 selects the closed loop
+};
+
+// One lookup session pinned to a deployed device, with its own key and vector buffers so that
+// workers never contend on anything but the HPS itself.
+struct Session {
+  std::shared_ptr<LookupSessionBase> lookup_session;
+  int device_id;
+  size_t table_id;
+  size_t embedding_size;
+  long long* h_keys = nullptr;
+  float* d_vectors = nullptr;
+};
+
+void fill_keys(const LoadgenConfig& config, long long* h_keys) {
+  // The generators seed themselves, so each request draws fresh keys.
+  switch (config.distribution) {
+    case KeyDistribution_t::Powerlaw:
+      batch_key_generator_by_powerlaw(h_keys, config.num_keys, config.table_size, config.alpha);
+      break;
+    case KeyDistribution_t::Hotkey:
+      batch_key_generator_by_hotkey(h_keys, config.num_keys, config.table_size,
+                                    config.hot_key_percentage, config.hot_key_coverage);
+      break;
+    case KeyDistribution_t::Histogram: {
+      std::vector<double> histogram = config.histogram;
+      batch_key_generator_by_histogram(h_keys, config.num_keys, config.table_size, histogram);
+      break;
+    }
+  }
+}
+
+double percentile(const std::vector<double>& sorted_latencies, double q) {
+  if (sorted_latencies.empty()) {
+    return 0.0;
+  }
+  const size_t rank = std::min(
+      sorted_latencies.size() - 1,
+      static_cast<size_t>(std::ceil(q * static_cast<double>(sorted_latencies.size()))) - 1);
+  return sorted_latencies[rank];
+}
+
+void report(const std::string& mode, std::vector<double>& latencies_us, double elapsed_s) {
+  std::sort(latencies_us.begin(), latencies_us.end());
+  double sum = 0.0;
+  for (const double latency : latencies_us) {
+    sum += latency;
+  }
+  const size_t count = latencies_us.size();
+
+  std::cout << "*** Load Generator Results (" << mode << ") ***" << std::endl;
+  std::cout << "requests        : " << count << std::endl;
+  std::cout << "elapsed         : " << elapsed_s << " s" << std::endl;
+  std::cout << "achieved QPS    : " << (elapsed_s > 0.0 ? count / elapsed_s : 0.0) << std::endl;
+  std::cout << "mean latency    : " << (count > 0 ? sum / count : 0.0) << " us" << std::endl;
+  std::cout << "p50  latency    : " << percentile(latencies_us, 0.50) << " us" << std::endl;
+  std::cout << "p95  latency    : " << percentile(latencies_us, 0.95) << " us" << std::endl;
+  std::cout << "p99  latency    : " << percentile(latencies_us, 0.99) << " us" << std::endl;
+  std::cout << "p999 latency    : " << percentile(latencies_us, 0.999) << " us" << std::endl;
+  std::cout << "max  latency    : " << (count > 0 ? latencies_us.back() : 0.0) << " us"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  argparse::ArgumentParser args("HPS_Loadgen");
+
+  args.add_argument("--config")
+      .help("The path of the HPS json configuration file")
+      .required()
+      .action([](const std::string& value) { return value; });
+
+  args.add_argument("--table_size")
+      .help("The number of keys in the embedded table")
+      .default_value(100000)
+      .action([](const std::string& value) { return std::stoi(value); });
+
+  args.add_argument("--distribution")
+      .help(
+          "The distribution of the generated query key in each request. Can be 'powerlaw', "
+          "'hotkey', or 'histogram'")
+      .default_value("powerlaw")
+      .action([](const std::string& value) { return value; });
+
+  args.add_argument("--histogram")
+      .help(
+          "The histogram with probabilities of each bin, please provide probabilities numbers "
+          "separated by space")
+      .nargs(1, 20)
+      .default_value<std::vector<double>>({0.4, 0.3, 0.2, 0.1})
+      .scan<'g', double>();
+
+  args.add_argument("--alpha")
+      .help("Alpha of power distribution")
+      .default_value<float>(1.2)
+      .action([](const std::string& value) { return std::stof(value); });
+
+  args.add_argument("--hot_key_percentage")
+      .help("Percentage of hot keys in embedding tables")
+      .default_value<float>(0.2)
+      .action([](const std::string& value) { return std::stof(value); });
+
+  args.add_argument("--hot_key_coverage")
+      .help("The probability of the hot key in each request")
+      .default_value<float>(0.8)
+      .action([](const std::string& value) { return std::stof(value); });
+
+  args.add_argument("--num_key")
+      .help("The number of keys to query for each request")
+      .default_value(1000)
+      .action([](const std::string& value) { return std::stoi(value); });
+
+  args.add_argument("--num_sessions")
+      .help("The number of concurrent lookup sessions, spread across the deployed devices")
+      .default_value(4)
+      .action([](const std::string& value) { return std::stoi(value); });
+
+  args.add_argument("--requests")
+      .help("The total number of measured lookup requests")
+      .default_value(10000)
+      .action([](const std::string& value) { return std::stoi(value); });
+
+  args.add_argument("--warmup_requests")
+      .help("Requests issued before measurement starts; their latency is discarded")
+      .default_value(1000)
+      .action([](const std::string& value) { return std::stoi(value); });
+
+  args.add_argument("--target_qps")
+      .help(
+          "Open-loop arrival rate (Poisson) in requests per second over all sessions. When not "
+          "set (or <= 0), the generator runs closed loop at saturation")
+      .default_value<double>(0.0)
+      .action([](const std::string& value) { return std::stod(value); });
+
+  try {
+    args.parse_args(argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::cout << err.what() << std::endl;
+    std::cout << args;
+    exit(1);
+  }
+
+  std::unordered_map<std::string, KeyDistribution_t> distmap{
+      {"powerlaw", KeyDistribution_t::Powerlaw},
+      {"hotkey", KeyDistribution_t::Hotkey},
+      {"histogram", KeyDistribution_t::Histogram}};
+  auto it = distmap.find(args.get<std::string>("--distribution"));
+  KeyDistribution_t dist;
+  if (it != distmap.end()) {
+    dist = it->second;
+  } else {
+    std::cout << "Unsupported distribution type. Will use power-law distribution instead."
+              << std::endl;
+    dist = KeyDistribution_t::Powerlaw;
+  }
+
+  LoadgenConfig config;
+  config.distribution = dist;
+  config.table_size = static_cast<size_t>(args.get<int>("--table_size") - 1);
+  config.num_keys = static_cast<size_t>(args.get<int>("--num_key"));
+  config.alpha = args.get<float>("--alpha");
+  config.hot_key_percentage = args.get<float>("--hot_key_percentage");
+  config.hot_key_coverage = args.get<float>("--hot_key_coverage");
+  config.histogram = args.get<std::vector<double>>("--histogram");
+  config.num_sessions = std::max(1, args.get<int>("--num_sessions"));
+  config.requests = args.get<int>("--requests");
+  config.warmup_requests = args.get<int>("--warmup_requests");
+  config.target_qps = args.get<double>("--target_qps");
+
+  parameter_server_config ps_config{args.get<std::string>("--config")};
+  auto parameter_server = HierParameterServerBase::create(ps_config);
+
+  auto& inference_params = ps_config.inference_params_array[0];
+  HCTR_CHECK_HINT(!inference_params.fuse_embedding_table,
+                  "HPS load generator does not support table fusion");
+  HCTR_CHECK_HINT(inference_params.i64_input_key,
+                  "HPS load generator requires input keys of int64_t");
+
+  const auto& embedding_size_per_table =
+      ps_config.embedding_vec_size_.at(inference_params.model_name);
+  const size_t table_id = inference_params.sparse_model_files.size() - 1;
+  const size_t embedding_size = embedding_size_per_table[table_id];
+
+  // Sessions are assigned to the deployed devices round-robin, each with private buffers.
+  std::vector<Session> sessions(config.num_sessions);
+  for (int i = 0; i < config.num_sessions; i++) {
+    const int device_id =
+        inference_params.deployed_devices[i % inference_params.deployed_devices.size()];
+    inference_params.device_id = device_id;
+    auto embedding_cache =
+        parameter_server->get_embedding_cache(inference_params.model_name, device_id);
+    sessions[i].lookup_session = LookupSessionBase::create(inference_params, embedding_cache);
+    sessions[i].device_id = device_id;
+    sessions[i].table_id = table_id;
+    sessions[i].embedding_size = embedding_size;
+    HCTR_LIB_THROW(cudaMallocHost(reinterpret_cast<void**>(&sessions[i].h_keys),
+                                  config.num_keys * sizeof(long long)));
+    CudaDeviceContext context(device_id);
+    HCTR_LIB_THROW(cudaMalloc(reinterpret_cast<void**>(&sessions[i].d_vectors),
+                              config.num_keys * embedding_size * sizeof(float)));
+  }
+
+  const bool open_loop = config.target_qps > 0.0;
+  const int total_requests = config.warmup_requests + config.requests;
+
+  // Open loop: pre-draw the Poisson arrival schedule (exponential inter-arrival gaps) so all
+  // workers share one clock, and measure latency from the scheduled arrival so queueing delay
+  // caused by an overloaded deployment shows up in the percentiles.
+  std::vector<double> arrival_offsets_s(open_loop ? total_requests : 0);
+  if (open_loop) {
+    std::mt19937 gen(std::random_device{}());
+    std::exponential_distribution<double> gap(config.target_qps);
+    double now = 0.0;
+    for (int i = 0; i < total_requests; i++) {
+      now += gap(gen);
+      arrival_offsets_s[i] = now;
+    }
+  }
+
+  std::atomic<int> next_request{0};
+  std::vector<std::vector<double>> latencies_us_per_session(config.num_sessions);
+  const auto start = Clock::now();
+
+  auto worker = [&](int session_index) {
+    Session& session = sessions[session_index];
+    CudaDeviceContext context(session.device_id);
+    std::vector<double>& latencies_us = latencies_us_per_session[session_index];
+    latencies_us.reserve(static_cast<size_t>(total_requests) / config.num_sessions + 1);
+
+    for (;;) {
+      const int request = next_request.fetch_add(1, std::memory_order_relaxed);
+      if (request >= total_requests) {
+        return;
+      }
+      fill_keys(config, session.h_keys);
+
+      Clock::time_point issue = Clock::now();
+      if (open_loop) {
+        const auto scheduled =
+            start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(arrival_offsets_s[request]));
+        if (scheduled > issue) {
+          std::this_thread::sleep_until(scheduled);
+        }
+        issue = scheduled;  // latency includes time the request waited for a free session
+      }
+      session.lookup_session->lookup(session.h_keys, session.d_vectors, config.num_keys,
+                                     session.table_id);
+      if (request >= config.warmup_requests) {
+        latencies_us.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - issue).count());
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < config.num_sessions; i++) {
+    workers.emplace_back(worker, i);
+  }
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  const double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<double> latencies_us;
+  for (const auto& session_latencies : latencies_us_per_session) {
+    latencies_us.insert(latencies_us.end(), session_latencies.begin(), session_latencies.end());
+  }
+  report(open_loop ? "open loop, target QPS = " + std::to_string(config.target_qps)
+                   : "closed loop, " + std::to_string(config.num_sessions) + " sessions",
+         latencies_us, elapsed_s);
+
+  for (Session& session : sessions) {
+    CudaDeviceContext context(session.device_id);
+    HCTR_LIB_CHECK_(cudaFree(session.d_vectors));
+    HCTR_LIB_CHECK_(cudaFreeHost(session.h_keys));
+  }
+  return 0;
+}
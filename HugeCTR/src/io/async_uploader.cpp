@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <core23/logger.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <io/async_uploader.hpp>
+#include <io/filesystem.hpp>
+#include <vector>
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr size_t CHECKSUM_CHUNK_BYTES = 4 * 1024 * 1024;
+
+uint32_t crc32_update(uint32_t crc, const char* data, size_t num_bytes) {
+  static const auto table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xffu] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+uint32_t crc32_of_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  HCTR_CHECK_HINT(in.is_open(), "Cannot open '%s' for checksumming", path.c_str());
+  std::vector<char> chunk(CHECKSUM_CHUNK_BYTES);
+  uint32_t crc = 0;
+  while (in) {
+    in.read(chunk.data(), chunk.size());
+    crc = crc32_update(crc, chunk.data(), static_cast<size_t>(in.gcount()));
+  }
+  return crc;
+}
+
+bool readback_verification_enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_UPLOAD_VERIFY_READBACK");
+    return env != nullptr && 1 == std::atoi(env);
+  }();
+  return enabled;
+}
+
+}  // namespace
+
+AsyncFileUploader& AsyncFileUploader::instance() {
+  static AsyncFileUploader uploader;
+  return uploader;
+}
+
+AsyncFileUploader::AsyncFileUploader() {
+  const char* spool_dir_env = std::getenv("HCTR_UPLOAD_SPOOL_DIR");
+  spool_dir_ = spool_dir_env != nullptr ? spool_dir_env : "/tmp/hugectr_upload_spool";
+
+  const char* spool_gb_env = std::getenv("HCTR_UPLOAD_SPOOL_GB");
+  const size_t spool_gb = spool_gb_env != nullptr ? std::atoll(spool_gb_env) : 64;
+  spool_capacity_ = spool_gb << 30;
+
+  const char* threads_env = std::getenv("HCTR_UPLOAD_THREADS");
+  const int num_threads = threads_env != nullptr ? std::max(1, std::atoi(threads_env)) : 4;
+
+  std::filesystem::create_directories(spool_dir_);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this] { upload_loop(); });
+  }
+}
+
+AsyncFileUploader::~AsyncFileUploader() {
+  drain();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    terminate_ = true;
+  }
+  job_cond_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void AsyncFileUploader::enqueue(const std::string& source_path, const std::string& target_path) {
+  const size_t num_bytes = std::filesystem::file_size(source_path);
+  HCTR_CHECK_HINT(num_bytes <= spool_capacity_,
+                  "File '%s' is larger than the upload spool; raise HCTR_UPLOAD_SPOOL_GB",
+                  source_path.c_str());
+
+  UploadJob job;
+  job.target_path = target_path;
+  job.num_bytes = num_bytes;
+  job.crc32 = crc32_of_file(source_path);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_cond_.wait(lock, [&] { return spooled_bytes_ + num_bytes <= spool_capacity_; });
+    spooled_bytes_ += num_bytes;
+    job.spool_path = spool_dir_ + "/" + std::to_string(next_spool_id_++) + "." +
+                     std::filesystem::path(source_path).filename().string();
+  }
+
+  // Hard-link when the spool shares a device with the checkpoint; fall back to a copy.
+  std::error_code ec;
+  std::filesystem::create_hard_link(source_path, job.spool_path, ec);
+  if (ec) {
+    std::filesystem::copy_file(source_path, job.spool_path,
+                               std::filesystem::copy_options::overwrite_existing);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+    ++num_in_flight_;
+  }
+  job_cond_.notify_one();
+}
+
+void AsyncFileUploader::drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  space_cond_.wait(lock, [&] { return num_in_flight_ == 0; });
+}
+
+size_t AsyncFileUploader::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_in_flight_;
+}
+
+void AsyncFileUploader::upload_loop() {
+  for (;;) {
+    UploadJob job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cond_.wait(lock, [&] { return terminate_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+
+    bool ok = false;
+    try {
+      const auto fs = FileSystemBuilder::build_unique_by_path(job.target_path);
+      fs->upload(job.spool_path, job.target_path);
+
+      const size_t remote_bytes = fs->get_file_size(job.target_path);
+      HCTR_CHECK_HINT(remote_bytes == job.num_bytes,
+                      "Upload of '%s' is truncated: %zu bytes remote, %zu bytes local",
+                      job.target_path.c_str(), remote_bytes, job.num_bytes);
+
+      if (readback_verification_enabled()) {
+        const std::string readback_path = job.spool_path + ".verify";
+        fs->fetch(job.target_path, readback_path);
+        const uint32_t remote_crc = crc32_of_file(readback_path);
+        std::filesystem::remove(readback_path);
+        HCTR_CHECK_HINT(remote_crc == job.crc32, "Upload of '%s' is corrupt: crc %08x != %08x",
+                        job.target_path.c_str(), remote_crc, job.crc32);
+      }
+      ok = true;
+    } catch (const std::exception& e) {
+      HCTR_LOG_S(ERROR, WORLD) << "Background upload of '" << job.target_path
+                               << "' failed: " << e.what() << std::endl;
+    }
+    if (ok) {
+      HCTR_LOG_S(INFO, WORLD) << "Uploaded '" << job.target_path << "' (" << job.num_bytes
+                              << " bytes, crc32 " << std::hex << job.crc32 << std::dec << ")."
+                              << std::endl;
+    }
+
+    std::filesystem::remove(job.spool_path);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      spooled_bytes_ -= job.num_bytes;
+      --num_in_flight_;
+    }
+    space_cond_.notify_all();
+  }
+}
+
+}  // namespace HugeCTR
@@ -200,19 +200,29 @@ int GCSFileSystem::write(const std::string& path, const void* const data, const
   return data_size;
 }
 
-int GCSFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
-                        const size_t offset) {
+int GCSFileSystem::read_range(const std::string& path, void* const buffer, const size_t nbytes,
+                              const size_t offset) {
   GCSPath gcs_path = GCSPath::FromString(path);
   HCTR_CHECK_HINT(gcs_path.has_bucket_and_object(),
                   "This GCS path does not contain bucket or key information.");
   gcs::ObjectReadStream stream = client_->ReadObject(gcs_path.bucket, gcs_path.object,
-                                                     gcs::ReadRange(offset, offset + buffer_size));
-  stream.read(reinterpret_cast<char*>(buffer), buffer_size);
+                                                     gcs::ReadRange(offset, offset + nbytes));
+  stream.read(reinterpret_cast<char*>(buffer), nbytes);
   stream.Close();
   HCTR_CHECK_HINT(!stream.IsOpen(), "Failed to read from GCS.");
   return stream.gcount();
 }
 
+int GCSFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
+                        const size_t offset) {
+  size_t content_length = get_file_size(path);
+  return ranged_reader_.read(path, buffer, buffer_size, offset, content_length,
+                             [this](const std::string& part_path, void* part_buffer,
+                                    size_t part_nbytes, size_t part_offset) {
+                               return read_range(part_path, part_buffer, part_nbytes, part_offset);
+                             });
+}
+
 void GCSFileSystem::copy(const std::string& source_path, const std::string& target_path) {
   GCSPath source_gcs_path = GCSPath::FromString(source_path);
   HCTR_CHECK_HINT(source_gcs_path.has_bucket_and_object(),
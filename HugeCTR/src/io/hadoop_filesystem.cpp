@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <core23/logger.hpp>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <io/hadoop_filesystem.hpp>
 #include <iostream>
@@ -24,6 +28,36 @@
 namespace HugeCTR {
 
 #ifdef ENABLE_HDFS
+
+namespace {
+
+// Reads at or below this size go through the read-ahead buffer; larger reads are streamed
+// directly, like before.
+constexpr size_t MAX_AGGREGATED_READ_BYTES = 1024 * 1024;
+
+constexpr size_t MAX_CACHED_READ_FILES = 128;
+
+// Small-IO aggregation (metadata cache, read-handle reuse, read-ahead) is on by default;
+// HCTR_HDFS_SMALL_IO_AGGREGATION=0 restores one RPC per call.
+bool small_io_aggregation_enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_HDFS_SMALL_IO_AGGREGATION");
+    return env == nullptr || 0 != std::atoi(env);
+  }();
+  return enabled;
+}
+
+size_t read_ahead_bytes() {
+  static const size_t num_bytes = [] {
+    const char* env = std::getenv("HCTR_HDFS_READ_AHEAD_MB");
+    const size_t num_mb = env != nullptr ? std::max(1, std::atoi(env)) : 4;
+    return num_mb << 20;
+  }();
+  return num_bytes;
+}
+
+}  // namespace
+
 void HdfsConfigs::set_buffer_size(int32_t buffer_size) { this->buffer_size = buffer_size; }
 
 void HdfsConfigs::set_replication(int16_t replication) { this->replication = replication; }
@@ -112,6 +146,16 @@ HadoopFileSystem::~HadoopFileSystem() { disconnect(); }
 
 void HadoopFileSystem::disconnect() {
   if (fs_) {
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      for (auto& entry : read_files_) {
+        hdfsCloseFile(fs_, entry.second);
+      }
+      read_files_.clear();
+      read_file_index_.clear();
+      file_size_cache_.clear();
+    }
+
     const int res = hdfsDisconnect(fs_);
     HCTR_CHECK_HINT(!res, "Unable to disconnect HDFS.");
     fs_ = nullptr;
@@ -151,12 +195,64 @@ void HadoopFileSystem::connect_to_local() {
 size_t HadoopFileSystem::get_file_size(const std::string& path) const {
   HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
 
+  if (small_io_aggregation_enabled()) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return file_size_locked(path);
+  }
+
+  hdfsFileInfo* const fi = hdfsGetPathInfo(fs_, path.c_str());
+
+  size_t file_size;
+  if (fi) {
+    file_size = fi[0].mSize;
+    hdfsFreeFileInfo(fi, 1);
+  } else {
+    file_size = 0;
+    HCTR_LOG_S(ERROR, WORLD) << "HDFS file '" << path << "' does not exist." << std::endl;
+  }
+
+  return file_size;
+}
+
+size_t HadoopFileSystem::file_size_locked(const std::string& path) const {
+  auto it = file_size_cache_.find(path);
+  if (it != file_size_cache_.end()) {
+    return it->second;
+  }
+
+  // One listing RPC stats every sibling of the path at once; with many-small-files datasets
+  // this turns 40K hdfsGetPathInfo round trips per epoch into one per directory.
+  const std::string parent = std::filesystem::path(path).parent_path().string();
+  if (!parent.empty()) {
+    int fi_count;
+    hdfsFileInfo* const fi = hdfsListDirectory(fs_, parent.c_str(), &fi_count);
+    if (fi) {
+      for (int i = 0; i < fi_count; ++i) {
+        if (fi[i].mKind == kObjectKindFile) {
+          const size_t file_size = fi[i].mSize;
+          // hdfsListDirectory may return fully qualified URIs; index the entry under the
+          // caller's naming scheme as well so the lookup below hits.
+          file_size_cache_.emplace(fi[i].mName, file_size);
+          file_size_cache_.emplace(
+              parent + "/" + std::filesystem::path(fi[i].mName).filename().string(), file_size);
+        }
+      }
+      hdfsFreeFileInfo(fi, fi_count);
+    }
+  }
+
+  it = file_size_cache_.find(path);
+  if (it != file_size_cache_.end()) {
+    return it->second;
+  }
+
   hdfsFileInfo* const fi = hdfsGetPathInfo(fs_, path.c_str());
 
   size_t file_size;
   if (fi) {
     file_size = fi[0].mSize;
     hdfsFreeFileInfo(fi, 1);
+    file_size_cache_.emplace(path, file_size);
   } else {
     file_size = 0;
     HCTR_LOG_S(ERROR, WORLD) << "HDFS file '" << path << "' does not exist." << std::endl;
@@ -179,6 +275,17 @@ void HadoopFileSystem::delete_file(const std::string& path) {
   int res = hdfsDelete(fs_, path.c_str(), static_cast<int>(true));
 
   HCTR_CHECK_HINT(res == 0, "Failed to delete the file in HDFS: ", path);
+
+  // The delete is recursive, so drop every cached size and handle rather than matching paths.
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  file_size_cache_.clear();
+  for (auto& entry : read_files_) {
+    hdfsCloseFile(fs_, entry.second);
+  }
+  read_files_.clear();
+  read_file_index_.clear();
+  read_ahead_.path.clear();
+  read_ahead_.data.clear();
 }
 
 void HadoopFileSystem::fetch(const std::string& source_path, const std::string& target_path) {
@@ -197,6 +304,8 @@ void HadoopFileSystem::upload(const std::string& source_path, const std::string&
   int res = hdfsCopy(local_fs_, source_path.c_str(), fs_, target_path.c_str());
 
   HCTR_CHECK_HINT(res == 0, "Failed to upload the file from Local to HDFS: ", source_path);
+
+  invalidate_cache(target_path);
 }
 
 int HadoopFileSystem::write(const std::string& path, const void* const data, const size_t data_size,
@@ -227,6 +336,7 @@ int HadoopFileSystem::write(const std::string& path, const void* const data, con
 
   HCTR_LOG_S(INFO, WORLD) << "Successfully wrote " << num_written << " bytes to HDFS file '" << path
                           << "'." << std::endl;
+  invalidate_cache(path);
   return num_written;
 }
 
@@ -235,6 +345,10 @@ int HadoopFileSystem::read(const std::string& path, void* const buffer, const si
   HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
   HCTR_CHECK_HINT(buffer, "Buffer pointer is invalid.");
 
+  if (small_io_aggregation_enabled() && buffer_size <= MAX_AGGREGATED_READ_BYTES) {
+    return read_aggregated(path, buffer, buffer_size, offset);
+  }
+
   hdfsFile file = hdfsOpenFile(fs_, path.c_str(), O_RDONLY, 0, 0, 0);
   HCTR_CHECK_HINT(file, "Failed to open HDFS file: ", path);
 
@@ -245,6 +359,70 @@ int HadoopFileSystem::read(const std::string& path, void* const buffer, const si
   return num_read;
 }
 
+hdfsFile HadoopFileSystem::acquire_read_file_locked(const std::string& path) const {
+  const auto it = read_file_index_.find(path);
+  if (it != read_file_index_.end()) {
+    read_files_.splice(read_files_.begin(), read_files_, it->second);
+    return it->second->second;
+  }
+
+  if (read_files_.size() >= MAX_CACHED_READ_FILES) {
+    hdfsCloseFile(fs_, read_files_.back().second);
+    read_file_index_.erase(read_files_.back().first);
+    read_files_.pop_back();
+  }
+
+  hdfsFile file = hdfsOpenFile(fs_, path.c_str(), O_RDONLY, 0, 0, 0);
+  HCTR_CHECK_HINT(file, "Failed to open HDFS file: ", path);
+
+  read_files_.emplace_front(path, file);
+  read_file_index_.emplace(path, read_files_.begin());
+  return file;
+}
+
+int HadoopFileSystem::read_aggregated(const std::string& path, void* const buffer,
+                                      const size_t buffer_size, const size_t offset) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+
+  const bool hit = read_ahead_.path == path && offset >= read_ahead_.offset &&
+                   offset + buffer_size <= read_ahead_.offset + read_ahead_.data.size();
+  if (!hit) {
+    const size_t file_size = file_size_locked(path);
+    HCTR_CHECK_HINT(offset + buffer_size <= file_size, "Reading past the end of HDFS file: ",
+                    path);
+
+    const size_t num_bytes = std::min(std::max(read_ahead_bytes(), buffer_size),
+                                      file_size - offset);
+    read_ahead_.path = path;
+    read_ahead_.offset = offset;
+    read_ahead_.data.resize(num_bytes);
+
+    hdfsFile file = acquire_read_file_locked(path);
+    const tSize num_read = hdfsPread(fs_, file, offset, read_ahead_.data.data(), num_bytes);
+    HCTR_CHECK_HINT(num_read >= 0 && static_cast<size_t>(num_read) == num_bytes,
+                    "Reading HDFS file failed: ", path);
+  }
+
+  std::memcpy(buffer, read_ahead_.data.data() + (offset - read_ahead_.offset), buffer_size);
+  return static_cast<int>(buffer_size);
+}
+
+void HadoopFileSystem::invalidate_cache(const std::string& path) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+
+  file_size_cache_.erase(path);
+  const auto it = read_file_index_.find(path);
+  if (it != read_file_index_.end()) {
+    hdfsCloseFile(fs_, it->second->second);
+    read_files_.erase(it->second);
+    read_file_index_.erase(it);
+  }
+  if (read_ahead_.path == path) {
+    read_ahead_.path.clear();
+    read_ahead_.data.clear();
+  }
+}
+
 void HadoopFileSystem::copy(const std::string& source_path, const std::string& target_path) {
   HCTR_CHECK_HINT(fs_, "Not connected to HDFS.");
 
@@ -252,6 +430,8 @@ void HadoopFileSystem::copy(const std::string& source_path, const std::string& t
 
   HCTR_CHECK_HINT(res == 0, "Copying HDFS file failed: ", source_path);
 
+  invalidate_cache(target_path);
+
   HCTR_LOG_S(INFO, WORLD) << "Successfully copied " << source_path << " to " << target_path << '.'
                           << std::endl;
 }
@@ -14,16 +14,170 @@
  * limitations under the License.
  */
 
+#ifdef ENABLE_IO_URING
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <core23/logger.hpp>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <io/io_utils.hpp>
 #include <io/local_filesystem.hpp>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 namespace HugeCTR {
 
+#ifdef ENABLE_IO_URING
+namespace {
+
+// O_DIRECT transfers must be aligned to the logical block size; 4 KiB covers all NVMe devices.
+constexpr size_t direct_io_alignment{4096};
+// Buffered single-stream reads stop scaling long before NVMe bandwidth, so reads at least
+// this large are driven through a queue of O_DIRECT extent reads instead.
+constexpr size_t direct_read_threshold{64ul << 20};
+constexpr size_t direct_read_extent{16ul << 20};
+constexpr unsigned direct_read_depth{8};
+
+inline uint64_t align_down(const uint64_t x) { return x & ~(direct_io_alignment - 1); }
+
+/**
+ * Read [offset, offset + size) of `path` into `buffer` through io_uring-queued O_DIRECT
+ * extent reads. Returns false if the file cannot be opened for direct IO (e.g. tmpfs) or
+ * the ring cannot be set up, in which case the caller falls back to buffered reading.
+ */
+bool read_extents_direct(const std::string& path, char* const buffer, const size_t size,
+                         const size_t offset) {
+  const int fd{::open(path.c_str(), O_RDONLY | O_DIRECT)};
+  if (fd < 0) {
+    return false;
+  }
+  const off_t file_size{::lseek(fd, 0, SEEK_END)};
+  if (file_size < 0) {
+    ::close(fd);
+    return false;
+  }
+  const uint64_t read_end{std::min<uint64_t>(offset + size, static_cast<uint64_t>(file_size))};
+  if (offset >= read_end) {
+    ::close(fd);
+    return true;
+  }
+
+  io_uring ring;
+  if (io_uring_queue_init(direct_read_depth, &ring, 0) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // Aligned extents covering the requested range; the head/tail slack of the first and
+  // last extents is read into staging and dropped during the copy-out.
+  struct Extent {
+    uint64_t span_begin;
+    size_t span_len;
+    size_t done;
+    size_t slot;
+  };
+  std::vector<Extent> extents;
+  for (uint64_t span_begin{align_down(offset)}; span_begin < read_end;
+       span_begin += direct_read_extent) {
+    const size_t span_len{static_cast<size_t>(
+        std::min<uint64_t>(direct_read_extent, static_cast<uint64_t>(file_size) - span_begin))};
+    extents.push_back({span_begin, span_len, 0, 0});
+  }
+
+  char* const staging_raw{static_cast<char*>(
+      std::aligned_alloc(direct_io_alignment, direct_read_depth * direct_read_extent))};
+  HCTR_CHECK_HINT(staging_raw, "Failed to allocate direct IO staging buffer!");
+  const std::unique_ptr<char, decltype(&std::free)> staging{staging_raw, &std::free};
+
+  std::vector<size_t> free_slots(direct_read_depth);
+  for (size_t i = 0; i < free_slots.size(); ++i) {
+    free_slots[i] = i;
+  }
+
+  auto submit_extent = [&](const size_t extent_index) {
+    Extent& extent{extents[extent_index]};
+    io_uring_sqe* const sqe{io_uring_get_sqe(&ring)};
+    HCTR_CHECK_HINT(sqe, "io_uring submission queue unexpectedly full!");
+    io_uring_prep_read(sqe, fd, staging.get() + extent.slot * direct_read_extent + extent.done,
+                       static_cast<unsigned>(extent.span_len - extent.done),
+                       static_cast<off_t>(extent.span_begin + extent.done));
+    io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(extent_index));
+  };
+
+  size_t next_extent{0};
+  size_t num_completed{0};
+  bool read_failed{false};
+  while (num_completed < extents.size() && !read_failed) {
+    unsigned num_prepped{0};
+    while (next_extent < extents.size() && !free_slots.empty()) {
+      extents[next_extent].slot = free_slots.back();
+      free_slots.pop_back();
+      submit_extent(next_extent);
+      ++next_extent;
+      ++num_prepped;
+    }
+    if (num_prepped) {
+      const int ret{io_uring_submit(&ring)};
+      if (ret < 0) {
+        read_failed = true;
+        break;
+      }
+    }
+
+    io_uring_cqe* cqe;
+    if (io_uring_wait_cqe(&ring, &cqe) != 0) {
+      read_failed = true;
+      break;
+    }
+    do {
+      const size_t extent_index{reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe))};
+      Extent& extent{extents[extent_index]};
+      if (cqe->res <= 0) {
+        read_failed = true;
+        io_uring_cqe_seen(&ring, cqe);
+        break;
+      }
+      extent.done += static_cast<size_t>(cqe->res);
+      if (extent.done < extent.span_len) {
+        // Short read: O_DIRECT completes in block-sized units, resubmit the remainder.
+        submit_extent(extent_index);
+        const int ret{io_uring_submit(&ring)};
+        if (ret < 0) {
+          read_failed = true;
+          io_uring_cqe_seen(&ring, cqe);
+          break;
+        }
+      } else {
+        // Copy the useful sub-range of the extent out of staging.
+        const uint64_t copy_begin{std::max<uint64_t>(extent.span_begin, offset)};
+        const uint64_t copy_end{std::min<uint64_t>(extent.span_begin + extent.span_len, read_end)};
+        std::memcpy(buffer + (copy_begin - offset),
+                    staging.get() + extent.slot * direct_read_extent +
+                        (copy_begin - extent.span_begin),
+                    copy_end - copy_begin);
+        free_slots.push_back(extent.slot);
+        ++num_completed;
+      }
+      io_uring_cqe_seen(&ring, cqe);
+    } while (io_uring_peek_cqe(&ring, &cqe) == 0);
+  }
+
+  io_uring_queue_exit(&ring);
+  ::close(fd);
+  return !read_failed;
+}
+
+}  // namespace
+#endif  // ENABLE_IO_URING
+
 LocalFileSystem::LocalFileSystem() {}
 
 LocalFileSystem::~LocalFileSystem() {}
@@ -72,6 +226,17 @@ int LocalFileSystem::write(const std::string& path, const void* const data, cons
 
 int LocalFileSystem::read(const std::string& path, void* const buffer, const size_t buffer_size,
                           const size_t offset) {
+#ifdef ENABLE_IO_URING
+  // Large reads (whole sparse-model key/vector files, dense checkpoints) bypass the page
+  // cache and run as a queue of O_DIRECT extent reads, which is what it takes to get NVMe
+  // drives anywhere near their rated bandwidth. Anything the direct path cannot serve
+  // falls through to the buffered stream below.
+  if (buffer_size >= direct_read_threshold &&
+      read_extents_direct(path, reinterpret_cast<char*>(buffer), buffer_size, offset)) {
+    const size_t file_size{std::filesystem::file_size(path)};
+    return offset < file_size ? static_cast<int>(std::min(buffer_size, file_size - offset)) : 0;
+  }
+#endif
   std::ifstream file_stream(path);
   HCTR_CHECK_HINT(file_stream.is_open(), "File not open for reading: ", path);
   file_stream.seekg(offset);
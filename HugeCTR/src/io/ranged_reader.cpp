@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <io/ranged_reader.hpp>
+#include <thread_pool.hpp>
+
+namespace HugeCTR {
+
+namespace {
+
+size_t env_or_default(const char* name, size_t fallback) {
+  const char* env = std::getenv(name);
+  if (env) {
+    const long long value = std::atoll(env);
+    if (value > 0) {
+      return static_cast<size_t>(value);
+    }
+  }
+  return fallback;
+}
+
+}  // namespace
+
+size_t object_store_inflight_parts() {
+  return env_or_default("HCTR_OBJECT_STORE_INFLIGHT_PARTS", 16);
+}
+
+RangedReader::RangedReader()
+    : part_nbytes_(env_or_default("HCTR_OBJECT_STORE_PART_NBYTES", 16ul * 1024 * 1024)),
+      num_inflight_(object_store_inflight_parts()) {
+  const char* env = std::getenv("HCTR_OBJECT_STORE_READAHEAD");
+  readahead_enabled_ = !(env && std::atoi(env) == 0);
+}
+
+RangedReader::~RangedReader() {
+  if (ra_future_.valid()) {
+    ra_future_.wait();
+  }
+}
+
+int RangedReader::read(const std::string& path, void* buffer, size_t buffer_size, size_t offset,
+                       size_t file_size, const FetchRangeFn& fetch_range) {
+  if (offset >= file_size) {
+    return 0;
+  }
+  const size_t nbytes = std::min(buffer_size, file_size - offset);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  const bool sequential = (path == last_path_ && offset == last_end_);
+
+  bool served = false;
+  if (ra_future_.valid() && path == ra_path_ && offset == ra_offset_) {
+    ra_future_.wait();
+    if (nbytes <= ra_valid_nbytes_) {
+      std::memcpy(buffer, ra_buffer_.data(), nbytes);
+      served = true;
+    }
+  }
+  if (!served) {
+    // Let any stale readahead drain before reusing its buffer for the next one.
+    if (ra_future_.valid()) {
+      ra_future_.wait();
+    }
+    lock.unlock();
+    parallel_fetch_(path, buffer, nbytes, offset, fetch_range);
+    lock.lock();
+  }
+
+  const size_t read_end = offset + nbytes;
+  if (readahead_enabled_ && (sequential || served) && read_end < file_size) {
+    start_readahead_(path, read_end, std::min(nbytes, file_size - read_end), fetch_range);
+  }
+  last_path_ = path;
+  last_end_ = read_end;
+  return static_cast<int>(nbytes);
+}
+
+int RangedReader::parallel_fetch_(const std::string& path, void* buffer, size_t nbytes,
+                                  size_t offset, const FetchRangeFn& fetch_range) {
+  if (nbytes <= part_nbytes_) {
+    return fetch_range(path, buffer, nbytes, offset);
+  }
+  const size_t num_parts = (nbytes + part_nbytes_ - 1) / part_nbytes_;
+  std::atomic<int> total_bytes{0};
+  size_t part = 0;
+  while (part < num_parts) {
+    // Bound in-flight requests to the configured window per wave.
+    const size_t wave_end = std::min(num_parts, part + num_inflight_);
+    std::vector<std::future<void>> futures;
+    for (; part < wave_end; ++part) {
+      const size_t begin = part * part_nbytes_;
+      futures.push_back(ThreadPool::get().submit([&, begin]() {
+        const size_t part_size = std::min(part_nbytes_, nbytes - begin);
+        total_bytes +=
+            fetch_range(path, static_cast<char*>(buffer) + begin, part_size, offset + begin);
+      }));
+    }
+    ThreadPool::await(futures.begin(), futures.end());
+  }
+  return total_bytes.load();
+}
+
+void RangedReader::start_readahead_(const std::string& path, size_t offset, size_t nbytes,
+                                    const FetchRangeFn& fetch_range) {
+  ra_path_ = path;
+  ra_offset_ = offset;
+  ra_valid_nbytes_ = 0;
+  ra_buffer_.resize(nbytes);
+  ra_future_ = std::async(std::launch::async, [this, path, offset, nbytes, fetch_range]() {
+    const int fetched = parallel_fetch_(path, ra_buffer_.data(), nbytes, offset, fetch_range);
+    ra_valid_nbytes_ = fetched > 0 ? static_cast<size_t>(fetched) : 0;
+  });
+}
+
+}  // namespace HugeCTR
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <kernel_autotuner.hpp>
+#include <limits>
+#include <sstream>
+
+namespace HugeCTR {
+
+KernelAutotuner& KernelAutotuner::get() {
+  static KernelAutotuner instance;
+  return instance;
+}
+
+KernelAutotuner::KernelAutotuner() {
+  const char* env = std::getenv("HCTR_KERNEL_AUTOTUNE");
+  enabled_ = env != nullptr && std::atoi(env) != 0;
+  const char* path = std::getenv("HCTR_AUTOTUNE_CACHE");
+  if (path != nullptr) {
+    cache_path_ = path;
+  }
+}
+
+void KernelAutotuner::load_cache() {
+  if (!enabled_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loaded_) {
+    return;
+  }
+  loaded_ = true;
+  if (cache_path_.empty()) {
+    return;
+  }
+  std::ifstream file(cache_path_);
+  if (!file.is_open()) {
+    return;  // first run; the cache is written once winners exist
+  }
+  std::string key;
+  int winner;
+  size_t num_loaded = 0;
+  while (file >> key >> winner) {
+    winners_[key] = winner;
+    num_loaded++;
+  }
+  if (num_loaded > 0) {
+    HCTR_LOG_S(INFO, ROOT) << "Loaded " << num_loaded << " kernel autotune winners from "
+                           << cache_path_ << std::endl;
+  }
+}
+
+// The caller holds mutex_.
+void KernelAutotuner::save_cache() {
+  if (cache_path_.empty()) {
+    return;
+  }
+  std::ofstream file(cache_path_, std::ios::trunc);
+  if (!file.is_open()) {
+    HCTR_LOG_S(WARNING, ROOT) << "Cannot write kernel autotune cache to " << cache_path_
+                              << std::endl;
+    return;
+  }
+  for (const auto& [key, winner] : winners_) {
+    file << key << ' ' << winner << '\n';
+  }
+}
+
+std::string KernelAutotuner::make_key(const std::string& tag,
+                                      const std::vector<int64_t>& shape) const {
+  int device = 0;
+  HCTR_LIB_THROW(cudaGetDevice(&device));
+  int major = 0, minor = 0;
+  HCTR_LIB_THROW(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device));
+  HCTR_LIB_THROW(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device));
+  std::ostringstream os;
+  os << tag;
+  for (auto dim : shape) {
+    os << '_' << dim;
+  }
+  os << "_sm" << major << minor;
+  return os.str();
+}
+
+int KernelAutotuner::tune(const std::string& tag, const std::vector<int64_t>& shape,
+                          const std::vector<int>& candidates,
+                          const std::function<void(int)>& launch, cudaStream_t stream) {
+  HCTR_CHECK_HINT(!candidates.empty(), "KernelAutotuner needs at least one candidate.");
+  if (!enabled_ || candidates.size() == 1) {
+    return candidates.front();
+  }
+  load_cache();
+
+  const std::string key = make_key(tag, shape);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = winners_.find(key);
+  if (it != winners_.end()) {
+    // A persisted winner from another build may no longer be offered; re-benchmark then.
+    for (auto candidate : candidates) {
+      if (candidate == it->second) {
+        return it->second;
+      }
+    }
+  }
+
+  constexpr int warmup_reps = 3;
+  constexpr int timed_reps = 10;
+  cudaEvent_t start, stop;
+  HCTR_LIB_THROW(cudaEventCreate(&start));
+  HCTR_LIB_THROW(cudaEventCreate(&stop));
+  int best_candidate = candidates.front();
+  float best_ms = std::numeric_limits<float>::max();
+  for (auto candidate : candidates) {
+    for (int i = 0; i < warmup_reps; i++) {
+      launch(candidate);
+    }
+    HCTR_LIB_THROW(cudaEventRecord(start, stream));
+    for (int i = 0; i < timed_reps; i++) {
+      launch(candidate);
+    }
+    HCTR_LIB_THROW(cudaEventRecord(stop, stream));
+    HCTR_LIB_THROW(cudaEventSynchronize(stop));
+    float elapsed_ms = 0.f;
+    HCTR_LIB_THROW(cudaEventElapsedTime(&elapsed_ms, start, stop));
+    if (elapsed_ms < best_ms) {
+      best_ms = elapsed_ms;
+      best_candidate = candidate;
+    }
+  }
+  HCTR_LIB_THROW(cudaEventDestroy(start));
+  HCTR_LIB_THROW(cudaEventDestroy(stop));
+
+  HCTR_LOG_S(INFO, ROOT) << "Autotuned " << key << " -> " << best_candidate << " ("
+                         << best_ms / timed_reps << " ms)" << std::endl;
+  winners_[key] = best_candidate;
+  save_cache();
+  return best_candidate;
+}
+
+}  // namespace HugeCTR
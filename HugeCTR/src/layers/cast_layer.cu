@@ -16,43 +16,12 @@
 
 #include <cuda_fp16.h>
 
+#include <core23/low_level_primitives.hpp>
 #include <layers/cast_layer.hpp>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
-namespace {
-
-__global__ void cast_kernel(__half* out, const float* in, int size) {
-  __half2* out2 = (__half2*)(out);
-  float2* in2 = (float2*)(in);
-  int size2 = size / 2;
-
-  int start = blockIdx.x * blockDim.x + threadIdx.x;
-  for (int i = start; i < size2; i += blockDim.x * gridDim.x) {
-    out2[i] = __float22half2_rn(__ldg(in2 + i));
-  }
-  if (start == 0 && size % 2 > 0) {
-    out[size - 1] = __float2half(__ldg(in + size - 1));
-  }
-}
-
-__global__ void cast_kernel(float* out, const __half* in, int size) {
-  float2* out2 = (float2*)(out);
-  __half2* in2 = (__half2*)(in);
-  int size2 = size / 2;
-
-  int start = blockIdx.x * blockDim.x + threadIdx.x;
-  for (int i = start; i < size2; i += blockDim.x * gridDim.x) {
-    out2[i] = __half22float2(__ldg(in2 + i));
-  }
-  if (start == 0 && size % 2 > 0) {
-    out[size - 1] = __half2float(__ldg(in + size - 1));
-  }
-}
-
-}  // namespace
-
 template <typename From, typename To>
 CastLayer<From, To>::CastLayer(const core23::Tensor& input_tensor,
                                const core23::Tensor& output_tensor,
@@ -68,11 +37,11 @@ void CastLayer<From, To>::fprop(bool is_train) {
 
   const From* in = input_tensors_[0].data<From>();
   To* out = output_tensors_[0].data<To>();
-  int num_elements = input_tensors_[0].num_elements();
+  const int64_t num_elements = input_tensors_[0].num_elements();
 
-  const auto threads = 512;
-  const auto blocks = std::min((num_elements - 1) / threads + 1, 1024);
-  cast_kernel<<<blocks, threads, 0, get_gpu().get_stream()>>>(out, in, num_elements);
+  core23::convert_pad_transpose_async(out, in, 1, num_elements, num_elements, false,
+                                      input_tensors_[0].device(),
+                                      core23::CUDAStream(get_gpu().get_stream()));
 }
 
 template <typename From, typename To>
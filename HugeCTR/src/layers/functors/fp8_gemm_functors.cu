@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <layers/functors/fp8_gemm_functors.hpp>
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr float kFp8E4M3Max = 448.0f;
+
+__device__ __forceinline__ void atomic_max_positive_float(float* address, float value) {
+  // For non-negative floats the IEEE-754 bit pattern is monotonic, so an integer atomicMax
+  // is equivalent to a float maximum.
+  atomicMax(reinterpret_cast<int*>(address), __float_as_int(value));
+}
+
+__global__ void quantize_e4m3_kernel(const __half* in, __nv_fp8_e4m3* out, int64_t num_elements,
+                                     const float* scale, float* amax) {
+  const float s = *scale;
+  float local_amax = 0.f;
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < num_elements;
+       i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    float value = __half2float(in[i]);
+    local_amax = fmaxf(local_amax, fabsf(value));
+    out[i] = __nv_fp8_e4m3(value * s);
+  }
+  for (int offset = warpSize / 2; offset > 0; offset /= 2) {
+    local_amax = fmaxf(local_amax, __shfl_down_sync(0xffffffff, local_amax, offset));
+  }
+  if ((threadIdx.x & (warpSize - 1)) == 0) {
+    atomic_max_positive_float(amax, local_amax);
+  }
+}
+
+// The kernel matrix is small compared with the activations, so a scattered write is cheap
+// enough here; the activation quantization above stays fully coalesced.
+__global__ void quantize_transpose_e4m3_kernel(const __half* in, __nv_fp8_e4m3* out,
+                                               int64_t num_rows, int64_t num_cols,
+                                               const float* scale, float* amax) {
+  const float s = *scale;
+  const int64_t num_elements = num_rows * num_cols;
+  float local_amax = 0.f;
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < num_elements;
+       i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    int64_t row = i / num_cols;
+    int64_t col = i - row * num_cols;
+    float value = __half2float(in[i]);
+    local_amax = fmaxf(local_amax, fabsf(value));
+    out[col * num_rows + row] = __nv_fp8_e4m3(value * s);
+  }
+  for (int offset = warpSize / 2; offset > 0; offset /= 2) {
+    local_amax = fmaxf(local_amax, __shfl_down_sync(0xffffffff, local_amax, offset));
+  }
+  if ((threadIdx.x & (warpSize - 1)) == 0) {
+    atomic_max_positive_float(amax, local_amax);
+  }
+}
+
+__global__ void update_scale_kernel(float* state, int history_length) {
+  // state layout matches Fp8ScalingState: [0] amax, [1] scale, [2] scale_inv, [3...) history.
+  if (blockIdx.x == 0 && threadIdx.x == 0) {
+    float* history = state + 3;
+    for (int i = history_length - 1; i > 0; i--) {
+      history[i] = history[i - 1];
+    }
+    history[0] = state[0];
+    float amax_max = 0.f;
+    for (int i = 0; i < history_length; i++) {
+      amax_max = fmaxf(amax_max, history[i]);
+    }
+    float scale = amax_max > 0.f ? kFp8E4M3Max / amax_max : 1.f;
+    state[1] = scale;
+    state[2] = 1.f / scale;
+    state[0] = 0.f;
+  }
+}
+
+}  // namespace
+
+void Fp8ScalingState::init(const core23::Device& device, cudaStream_t stream) {
+  state_ = core23::Tensor(core23::TensorParams()
+                              .data_type(core23::ScalarType::Float)
+                              .shape({3 + kHistoryLength})
+                              .device(device));
+  HCTR_LIB_THROW(
+      cudaMemsetAsync(state_.data<float>(), 0, state_.num_bytes(), stream));
+  // A zeroed history yields scale == scale_inv == 1 for the first iteration.
+  update_scale_kernel<<<1, 1, 0, stream>>>(state_.data<float>(), kHistoryLength);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+void Fp8ScalingState::update(cudaStream_t stream) {
+  update_scale_kernel<<<1, 1, 0, stream>>>(state_.data<float>(), kHistoryLength);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+const float* Fp8ScalingState::scale() const { return state_.data<float>() + 1; }
+
+const float* Fp8ScalingState::scale_inv() const { return state_.data<float>() + 2; }
+
+float* Fp8ScalingState::amax() { return state_.data<float>(); }
+
+void quantize_e4m3_async(const __half* in, __nv_fp8_e4m3* out, int64_t num_elements,
+                         const float* scale, float* amax, cudaStream_t stream) {
+  constexpr int block_size = 256;
+  int grid_size = static_cast<int>(std::min<int64_t>((num_elements + block_size - 1) / block_size,
+                                                     2048));
+  quantize_e4m3_kernel<<<grid_size, block_size, 0, stream>>>(in, out, num_elements, scale, amax);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+void quantize_transpose_e4m3_async(const __half* in, __nv_fp8_e4m3* out, int64_t num_rows,
+                                   int64_t num_cols, const float* scale, float* amax,
+                                   cudaStream_t stream) {
+  constexpr int block_size = 256;
+  const int64_t num_elements = num_rows * num_cols;
+  int grid_size = static_cast<int>(std::min<int64_t>((num_elements + block_size - 1) / block_size,
+                                                     2048));
+  quantize_transpose_e4m3_kernel<<<grid_size, block_size, 0, stream>>>(in, out, num_rows, num_cols,
+                                                                       scale, amax);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+bool CublasFp8Desc::supported(size_t batch_size, size_t bottom_size, size_t top_size) {
+  return batch_size % 16 == 0 && bottom_size % 16 == 0 && top_size % 16 == 0;
+}
+
+void CublasFp8Desc::set_fprop_attr(const __half* bias_ptr, Activation_t act, size_t batch_size,
+                                   size_t bottom_size, size_t top_size,
+                                   const float* kernel_scale_inv, const float* bottom_scale_inv) {
+  // In column-major terms this computes top^T = kernel^T * bottom^T, like the row-major
+  // workaround in CublasDesc. FP8 matmuls additionally require the TN layout, so A is the
+  // column-major (transposed) E4M3 copy of the kernel with CUBLAS_OP_T applied.
+  HCTR_LIB_THROW(cublasLtMatmulDescCreate(&cublas_op_desc, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+
+  cublasOperation_t op_a = CUBLAS_OP_T;
+  cublasOperation_t op_b = CUBLAS_OP_N;
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_TRANSA, &op_a,
+                                                sizeof(op_a)));
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_TRANSB, &op_b,
+                                                sizeof(op_b)));
+
+  int8_t fast_accum = 1;
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_FAST_ACCUM,
+                                                &fast_accum, sizeof(fast_accum)));
+
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc,
+                                                CUBLASLT_MATMUL_DESC_A_SCALE_POINTER,
+                                                &kernel_scale_inv, sizeof(kernel_scale_inv)));
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc,
+                                                CUBLASLT_MATMUL_DESC_B_SCALE_POINTER,
+                                                &bottom_scale_inv, sizeof(bottom_scale_inv)));
+
+  epilogue = CUBLASLT_EPILOGUE_DEFAULT;
+  if (act == Activation_t::Relu) {
+    epilogue = bias_ptr != nullptr ? CUBLASLT_EPILOGUE_RELU_BIAS : CUBLASLT_EPILOGUE_RELU;
+  } else if (bias_ptr != nullptr) {
+    epilogue = CUBLASLT_EPILOGUE_BIAS;
+  }
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                &epilogue, sizeof(epilogue)));
+  if (bias_ptr != nullptr) {
+    HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                  &bias_ptr, sizeof(bias_ptr)));
+  }
+
+  uint32_t pointer_mode = CUBLASLT_POINTER_MODE_HOST;
+  HCTR_LIB_THROW(cublasLtMatmulDescSetAttribute(cublas_op_desc, CUBLASLT_MATMUL_DESC_POINTER_MODE,
+                                                &pointer_mode, sizeof(pointer_mode)));
+
+  // A: kernel^T stored column-major [bottom_size x top_size]; B: bottom^T, i.e. the row-major
+  // activation buffer viewed column-major [bottom_size x batch_size]; C/D: top^T in half.
+  HCTR_LIB_THROW(cublasLtMatrixLayoutCreate(&cublas_mat_a_desc, CUDA_R_8F_E4M3, bottom_size,
+                                            top_size, bottom_size));
+  HCTR_LIB_THROW(cublasLtMatrixLayoutCreate(&cublas_mat_b_desc, CUDA_R_8F_E4M3, bottom_size,
+                                            batch_size, bottom_size));
+  HCTR_LIB_THROW(
+      cublasLtMatrixLayoutCreate(&cublas_mat_c_desc, CUDA_R_16F, top_size, batch_size, top_size));
+}
+
+CublasFp8Desc::~CublasFp8Desc() {
+  cublasLtMatmulDescDestroy(cublas_op_desc);
+  cublasLtMatrixLayoutDestroy(cublas_mat_a_desc);
+  cublasLtMatrixLayoutDestroy(cublas_mat_b_desc);
+  cublasLtMatrixLayoutDestroy(cublas_mat_c_desc);
+}
+
+void CublasFp8Algo::init_algorithm(const CublasFp8Desc& cublas_desc,
+                                   cublasLtHandle_t cublaslt_handle) {
+  HCTR_LIB_THROW(cublasLtMatmulPreferenceCreate(&cublas_preference));
+
+  HCTR_LIB_THROW(cudaMalloc(&cublaslt_workspace, cublaslt_workspace_size));
+  HCTR_LIB_THROW(cublasLtMatmulPreferenceSetAttribute(
+      cublas_preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &cublaslt_workspace_size,
+      sizeof(cublaslt_workspace_size)));
+
+  cublasLtMatmulHeuristicResult_t heuristic_result;
+  int returned_res = 0;
+  HCTR_LIB_THROW(cublasLtMatmulAlgoGetHeuristic(
+      cublaslt_handle, cublas_desc.cublas_op_desc, cublas_desc.cublas_mat_a_desc,
+      cublas_desc.cublas_mat_b_desc, cublas_desc.cublas_mat_c_desc, cublas_desc.cublas_mat_c_desc,
+      cublas_preference, 1, &heuristic_result, &returned_res));
+
+  algo = heuristic_result.algo;
+
+  if (returned_res == 0) {
+    HCTR_LIB_THROW(CUBLAS_STATUS_NOT_SUPPORTED);
+  }
+  initialized = true;
+}
+
+CublasFp8Algo::~CublasFp8Algo() {
+  if (initialized) {
+    cudaFree(cublaslt_workspace);
+    cublasLtMatmulPreferenceDestroy(cublas_preference);
+  }
+}
+
+void Fp8GemmFunctor::operator()(const __nv_fp8_e4m3* kernel, const __nv_fp8_e4m3* bottom,
+                                __half* top, const CublasFp8Desc& cublas_desc,
+                                const CublasFp8Algo& cublas_algo, cublasLtHandle_t cublaslt_handle,
+                                cudaStream_t stream) {
+  const float alpha = 1.0f;
+  const float beta = 0.0f;
+  HCTR_LIB_THROW(cublasLtMatmul(cublaslt_handle, cublas_desc.cublas_op_desc, &alpha, kernel,
+                                cublas_desc.cublas_mat_a_desc, bottom,
+                                cublas_desc.cublas_mat_b_desc, &beta, top,
+                                cublas_desc.cublas_mat_c_desc, top, cublas_desc.cublas_mat_c_desc,
+                                &cublas_algo.algo, cublas_algo.cublaslt_workspace,
+                                cublas_algo.cublaslt_workspace_size, stream));
+}
+
+}  // namespace HugeCTR
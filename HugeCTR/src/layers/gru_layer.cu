@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <common.hpp>
+#include <cstdlib>
 #include <functional>
 #include <gpu_resource.hpp>
 #include <include/utils.cuh>
@@ -29,6 +30,64 @@
 
 namespace HugeCTR {
 
+// One block per batch sample, one thread per hidden unit. The three recurrent weight
+// matrices stay resident in shared memory (stored transposed so the per-timestep dot
+// products are bank-conflict free) while the kernel iterates over all timesteps, and the
+// input projections W_g * x_t arrive precomputed per gate. Gate order and equations follow
+// cudnn's CUDNN_GRU with CUDNN_RNN_SINGLE_INP_BIAS:
+//   r_t = sigmoid(W_r x_t + R_r h_{t-1} + b_r)
+//   i_t = sigmoid(W_i x_t + R_i h_{t-1} + b_i)
+//   h'_t = tanh(W_h x_t + r_t * (R_h h_{t-1}) + b_h)
+//   h_t = (1 - i_t) * h'_t + i_t * h_{t-1}
+template <typename T>
+__global__ void persistent_gru_fprop_kernel(const T* proj_r, const T* proj_i, const T* proj_h,
+                                            const T* r_r, const T* r_i, const T* r_h,
+                                            const T* bias_r, const T* bias_i, const T* bias_h,
+                                            T* out, int batch_size, int seq_length,
+                                            int hidden_size) {
+  extern __shared__ float smem[];
+  float* rr_s = smem;  // [hidden_size][hidden_size], rr_s[j * hidden_size + i] = R_r(i, j)
+  float* ri_s = rr_s + hidden_size * hidden_size;
+  float* rh_s = ri_s + hidden_size * hidden_size;
+  float* h_prev = rh_s + hidden_size * hidden_size;
+
+  const int batch = blockIdx.x;
+  const int tid = threadIdx.x;
+  for (int idx = tid; idx < hidden_size * hidden_size; idx += blockDim.x) {
+    const int i = idx / hidden_size;
+    const int j = idx - i * hidden_size;
+    rr_s[j * hidden_size + i] = static_cast<float>(r_r[idx]);
+    ri_s[j * hidden_size + i] = static_cast<float>(r_i[idx]);
+    rh_s[j * hidden_size + i] = static_cast<float>(r_h[idx]);
+  }
+  // The cudnn path also starts from hx = NULL, i.e. an all-zero initial hidden state.
+  h_prev[tid] = 0.f;
+  __syncthreads();
+
+  const float b_r = bias_r != nullptr ? static_cast<float>(bias_r[tid]) : 0.f;
+  const float b_i = bias_i != nullptr ? static_cast<float>(bias_i[tid]) : 0.f;
+  const float b_h = bias_h != nullptr ? static_cast<float>(bias_h[tid]) : 0.f;
+
+  for (int t = 0; t < seq_length; t++) {
+    const int64_t offset = (static_cast<int64_t>(t) * batch_size + batch) * hidden_size + tid;
+    float acc_r = 0.f, acc_i = 0.f, acc_h = 0.f;
+    for (int j = 0; j < hidden_size; j++) {
+      const float h_j = h_prev[j];
+      acc_r += rr_s[j * hidden_size + tid] * h_j;
+      acc_i += ri_s[j * hidden_size + tid] * h_j;
+      acc_h += rh_s[j * hidden_size + tid] * h_j;
+    }
+    const float r = 1.f / (1.f + __expf(-(static_cast<float>(proj_r[offset]) + b_r + acc_r)));
+    const float i_gate = 1.f / (1.f + __expf(-(static_cast<float>(proj_i[offset]) + b_i + acc_i)));
+    const float h_cand = tanhf(static_cast<float>(proj_h[offset]) + b_h + r * acc_h);
+    const float h_new = (1.f - i_gate) * h_cand + i_gate * h_prev[tid];
+    __syncthreads();
+    h_prev[tid] = h_new;
+    out[offset] = static_cast<T>(h_new);
+    __syncthreads();
+  }
+}
+
 template <typename T>
 GRULayer<T>::GRULayer(const core23::Tensor& in_tensor, const core23::Tensor& out_tensor,
                       int64_t hiddenSize, int64_t batch_size, int64_t SeqLength,
@@ -55,6 +114,13 @@ GRULayer<T>::GRULayer(const core23::Tensor& in_tensor, const core23::Tensor& out
     outputTensorSize = miniBatch * seqLength_ * hiddenSize_;
     hiddenTensorSize = miniBatch * hiddenSize_;
 
+    static const bool use_persistent_gru = []() {
+      const char* env = std::getenv("HCTR_PERSISTENT_GRU");
+      return env != nullptr && std::atoi(env) != 0;
+    }();
+    // One thread per hidden unit caps the persistent path at a CUDA block's worth of units.
+    enable_persistent_gru_ = use_persistent_gru && hiddenSize_ <= 1024;
+
     // weightSpaceSize = m*k + m*m + 1*m; //include W, U weight matrixs and bias vector.
 
     // HCTR_LIB_THROW(cudnnSetTensor4dDescriptorEx(hDesc, data_type, n, 1, 1, n,
@@ -198,6 +264,64 @@ void GRULayer<T>::fprop(bool is_train) {
   T* in = in_tensor.data<T>();
   T* out = out_tensor.data<T>();
 
+  if (enable_persistent_gru_ && !is_train) {
+    if (!persistent_ready_) {
+      const size_t smem_bytes = (3ull * hiddenSize_ * hiddenSize_ + hiddenSize_) * sizeof(float);
+      int max_smem = 0;
+      HCTR_LIB_THROW(cudaDeviceGetAttribute(&max_smem, cudaDevAttrMaxSharedMemoryPerBlockOptin,
+                                            this->get_device_id()));
+      if (smem_bytes > static_cast<size_t>(max_smem)) {
+        HCTR_LOG_S(WARNING, ROOT)
+            << "Persistent GRU needs " << smem_bytes
+            << " bytes of shared memory, which exceeds the device limit; falling back to cudnn"
+            << std::endl;
+        enable_persistent_gru_ = false;
+      } else {
+        HCTR_LIB_THROW(cudaFuncSetAttribute(persistent_gru_fprop_kernel<T>,
+                                            cudaFuncAttributeMaxDynamicSharedMemorySize,
+                                            smem_bytes));
+        // Resolve cudnn's opaque weight space into per-gate pointers. For CUDNN_GRU,
+        // linLayerIDs 0/1/2 are the input GEMMs of the reset, update and new gates and
+        // 3/4/5 the recurrent ones; with CUDNN_RNN_SINGLE_INP_BIAS only 0/1/2 carry biases.
+        cudnnTensorDescriptor_t w_desc, b_desc;
+        HCTR_LIB_THROW(cudnnCreateTensorDescriptor(&w_desc));
+        HCTR_LIB_THROW(cudnnCreateTensorDescriptor(&b_desc));
+        for (int id = 0; id < 6; id++) {
+          HCTR_LIB_THROW(cudnnGetRNNWeightParams(cudnnHandle, rnnDesc, 0, weightSpaceSize, weight,
+                                                 id, w_desc, (void**)&w_mat_[id], b_desc,
+                                                 (void**)&w_bias_[id]));
+        }
+        HCTR_LIB_THROW(cudnnDestroyTensorDescriptor(w_desc));
+        HCTR_LIB_THROW(cudnnDestroyTensorDescriptor(b_desc));
+        HCTR_LIB_THROW(cudaMalloc((void**)&gate_proj_, 3 * outputTensorSize * sizeof(T)));
+        persistent_ready_ = true;
+      }
+    }
+    if (persistent_ready_) {
+      // Sequence-parallel input projections: proj_g^T (hidden x seq*batch, column-major) =
+      // W_g^T * X^T with X the [seq * batch, embedding] input and W_g the [hidden, embedding]
+      // row-major matrix cudnn stores.
+      const int rows = static_cast<int>(seqLength_ * miniBatch);
+      const int vec_size = static_cast<int>(embedding_vec_size_);
+      const float alpha = 1.0f, beta = 0.0f;
+      for (int g = 0; g < 3; g++) {
+        T* proj = gate_proj_ + static_cast<size_t>(g) * outputTensorSize;
+        HCTR_LIB_THROW(cublasGemmEx(this->get_gpu().get_cublas_handle(), CUBLAS_OP_T, CUBLAS_OP_N,
+                                    hiddenSize_, rows, vec_size, &alpha, w_mat_[g], CUDA_R_32F,
+                                    vec_size, in, CUDA_R_32F, vec_size, &beta, proj, CUDA_R_32F,
+                                    hiddenSize_, CUDA_R_32F, falgo_));
+      }
+      const size_t smem_bytes = (3ull * hiddenSize_ * hiddenSize_ + hiddenSize_) * sizeof(float);
+      persistent_gru_fprop_kernel<T>
+          <<<miniBatch, hiddenSize_, smem_bytes, this->get_gpu().get_stream()>>>(
+              gate_proj_, gate_proj_ + outputTensorSize, gate_proj_ + 2 * outputTensorSize,
+              w_mat_[3], w_mat_[4], w_mat_[5], w_bias_[0], w_bias_[1], w_bias_[2], out,
+              static_cast<int>(miniBatch), static_cast<int>(seqLength_), hiddenSize_);
+      HCTR_LIB_THROW(cudaGetLastError());
+      return;
+    }
+  }
+
 #ifdef KERAS_CHECK
   cudnnTensorDescriptor_t wDesc;
   cudnnTensorDescriptor_t bDesc;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <cuda.h>
 #include <cuda_fp16.h>
 #include <cuda_runtime_api.h>
@@ -836,6 +838,91 @@ __global__ void gather_concat_fprop_kernel_no_shared(T *out, const T *in0, const
     }
   }
 }
+// Int8 inference path: dynamic per-batch symmetric quantization. An amax reduction over both
+// inputs feeds a scale update on device, the concat pass quantizes straight into the int8 GEMM
+// operand, and the gather pass fuses the dequantization of the int32 dot products back to T.
+template <typename T>
+__global__ void int8_amax_kernel(const T *in_mlp, const T *in_emb, const int64_t mlp_len,
+                                 const int64_t emb_len, float *amax) {
+  const int64_t total = mlp_len + emb_len;
+  float local_amax = 0.f;
+  for (int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x; i < total;
+       i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    const float value =
+        i < mlp_len ? static_cast<float>(in_mlp[i]) : static_cast<float>(in_emb[i - mlp_len]);
+    local_amax = fmaxf(local_amax, fabsf(value));
+  }
+  for (int offset = warpSize / 2; offset > 0; offset /= 2) {
+    local_amax = fmaxf(local_amax, __shfl_down_sync(0xffffffff, local_amax, offset));
+  }
+  if ((threadIdx.x & (warpSize - 1)) == 0) {
+    // Non-negative floats compare correctly through their integer bit patterns.
+    atomicMax(reinterpret_cast<int *>(amax), __float_as_int(local_amax));
+  }
+}
+
+// scale_buf layout: [0] amax (reset after use), [1] quantization scale, [2] dequantization
+// factor for the int32 dot products (1 / scale^2).
+__global__ void int8_scale_kernel(float *scale_buf) {
+  if (blockIdx.x == 0 && threadIdx.x == 0) {
+    const float amax = scale_buf[0];
+    const float scale = amax > 0.f ? 127.f / amax : 1.f;
+    scale_buf[1] = scale;
+    scale_buf[2] = 1.f / (scale * scale);
+    scale_buf[0] = 0.f;
+  }
+}
+
+template <typename T>
+__global__ void quantize_concat_kernel(int8_t *out, const T *in_mlp, const T *in_emb, const int h,
+                                       const int out_w, const int in_w, const int n_emb,
+                                       const float *scale_buf) {
+  const int n_ins = 1 + n_emb;
+  const float scale = scale_buf[1];
+  if (blockIdx.x < n_ins) {
+    const T *in = (blockIdx.x == 0) ? in_mlp : in_emb + (blockIdx.x - 1) * in_w;
+    for (int bid = blockIdx.y; bid < h; bid += gridDim.y) {
+      int in_idx_base = (blockIdx.x == 0) ? bid * in_w : bid * in_w * n_emb;
+      for (int tid = threadIdx.x; tid < in_w; tid += blockDim.x) {
+        int in_idx = in_idx_base + tid;
+        int out_idx = bid * out_w + blockIdx.x * in_w + tid;
+        int q = __float2int_rn(static_cast<float>(in[in_idx]) * scale);
+        out[out_idx] = static_cast<int8_t>(max(-127, min(127, q)));
+      }
+    }
+  }
+}
+
+template <typename T>
+__global__ void gather_concat_dequant_fprop_kernel(T *out, const T *in0, const int32_t *mat,
+                                                   const int h, const int n_ins, const int w,
+                                                   const float *scale_buf) {
+  const float dequant = scale_buf[2];
+  int out_len = w + (n_ins * (n_ins + 1) / 2 - n_ins) + 1;
+  for (int bid = blockIdx.x; bid < h; bid += gridDim.x) {
+    int g_in_idx_base = bid * n_ins * n_ins;
+    int g_out_idx_base = bid * out_len + w;  // the first w elements should be copied from in0
+    // lower triangle
+    for (int row = threadIdx.y; row < n_ins; row += blockDim.y) {
+      int g_out_idx = g_out_idx_base + (row) * (row - 1) / 2;
+      for (int col = threadIdx.x; col < n_ins; col += blockDim.x) {
+        if (col < row) {
+          int idx_in_blk = row * n_ins + col;
+          int g_in_idx = g_in_idx_base + idx_in_blk;
+          out[g_out_idx + col] = static_cast<T>(static_cast<float>(mat[g_in_idx]) * dequant);
+        }
+      }
+    }
+    // copy bottom mlp
+    for (int col = threadIdx.x; col < w; col += blockDim.x) {
+      out[g_out_idx_base - w + col] = in0[bid * w + col];
+    }
+    if (!threadIdx.x && !threadIdx.y) {
+      out[(bid + 1) * out_len - 1] = (T)0.f;
+    }
+  }
+}
+
 template <typename T>
 __global__ void transpose_and_add_oneshot(const T *src, T *dst, const int h, const int n_ins) {
   extern __shared__ char s_buf_char[];
@@ -978,6 +1065,15 @@ void InteractionLayer<T>::init(const core23::Tensor &input_bottom_mlp_tensor,
     if (first_input_shape.size(1) != second_input_shape.size(2)) {
       HCTR_OWN_THROW(Error_t::WrongInput, "the input tensors' widths must be the same");
     }
+
+    static const bool use_int8 = [] {
+      const char *env = std::getenv("HCTR_INT8_INTERACTION");
+      return env != nullptr && std::atoi(env) != 0;
+    }();
+    // cublas int8 GEMM requires k % 4 == 0; the int8 buffers are allocated lazily on the first
+    // inference batch so training-only runs pay nothing for the toggle.
+    enable_int8_inference_ = use_int8 && (first_input_shape.size(1) % 4 == 0);
+
     core23::BufferParams buf_p{.channel = GetBlobsBufferChannel()};
 
     auto tensor_params = input_bottom_mlp_tensor.my_params().buffer_params(buf_p);
@@ -1108,14 +1204,90 @@ void InteractionLayer<T>::fprop_generic(bool is_train) {
   }
   HCTR_LIB_THROW(cudaGetLastError());
 }
+
+template <typename T>
+void InteractionLayer<T>::fprop_int8() {
+  CudaDeviceContext context(get_device_id());
+
+  auto *in_mlp = input_tensors_[0].data<T>();
+  auto *in_emb = input_tensors_[1].data<T>();
+  T *gather = output_tensors_[0].data<T>();
+  const int h = input_tensors_[0].size(0);
+  const int in_w = input_tensors_[0].size(1);
+  const int n_emb = input_tensors_[1].size(1);
+  const int n_ins = 1 + n_emb;
+  const int out_w = n_ins * in_w;
+  auto stream = get_gpu().get_stream();
+
+  if (!int8_buffers_ready_) {
+    core23::Device device(core23::DeviceType::GPU, get_device_id());
+    auto params = core23::TensorParams().device(device);
+    int8_concat_tensor_ =
+        core23::Tensor(params.shape({h, out_w}).data_type(core23::ScalarType::Int8));
+    int32_mat_tensor_ =
+        core23::Tensor(params.shape({h, n_ins * n_ins}).data_type(core23::ScalarType::Int32));
+    int8_scale_tensor_ = core23::Tensor(params.shape({3}).data_type(core23::ScalarType::Float));
+    HCTR_LIB_THROW(
+        cudaMemsetAsync(int8_scale_tensor_.data(), 0, int8_scale_tensor_.num_bytes(), stream));
+    int8_buffers_ready_ = true;
+  }
+
+  float *scale_buf = int8_scale_tensor_.data<float>();
+  int8_t *concat = int8_concat_tensor_.data<int8_t>();
+  int32_t *mat = int32_mat_tensor_.data<int32_t>();
+
+  // phase 0: per-batch amax reduction, scale update and quantizing concat, all on stream
+  const int64_t mlp_len = input_tensors_[0].num_elements();
+  const int64_t emb_len = input_tensors_[1].num_elements();
+  const int num_blocks =
+      static_cast<int>(std::min<int64_t>((mlp_len + emb_len + 255) / 256, 2048));
+  int8_amax_kernel<<<num_blocks, 256, 0, stream>>>(in_mlp, in_emb, mlp_len, emb_len, scale_buf);
+  int8_scale_kernel<<<1, 1, 0, stream>>>(scale_buf);
+
+  dim3 grid0(n_ins, get_gpu().get_sm_count(), 1);
+  dim3 block0(((in_w <= 128) ? 128 : ((in_w <= 256) ? 256 : 512)), 1, 1);
+  quantize_concat_kernel<<<grid0, block0, 0, stream>>>(concat, in_mlp, in_emb, h, out_w, in_w,
+                                                       n_emb, scale_buf);
+
+  // phase 1: int8 batched matmul (imma on Turing and later, dp4a otherwise)
+  const int m = n_ins;
+  const int n = n_ins;
+  const int k = in_w;
+  int32_t alpha = 1;
+  int32_t beta = 0;
+  long long int stride_a = static_cast<long long int>(n) * k;
+  long long int stride_b = static_cast<long long int>(k) * m;
+  long long int stride_c = static_cast<long long int>(n) * m;
+  HCTR_LIB_THROW(cublasGemmStridedBatchedEx(
+      get_gpu().get_cublas_handle(), CUBLAS_OP_T, CUBLAS_OP_N, m, n, k, &alpha, concat, CUDA_R_8I,
+      k, stride_a, concat, CUDA_R_8I, k, stride_b, &beta, mat, CUDA_R_32I, n, stride_c, h,
+      CUBLAS_COMPUTE_32I, CUBLAS_GEMM_DEFAULT_TENSOR_OP));
+
+  // phase 2: gather & concat with fused dequantization
+  dim3 grid1(get_gpu().get_sm_count() * 8, 1, 1);
+  dim3 block1(16, 16, 1);
+  gather_concat_dequant_fprop_kernel<<<grid1, block1, 0, stream>>>(gather, in_mlp, mat, h, n_ins,
+                                                                   in_w, scale_buf);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
 template <>
 void InteractionLayer<float>::fprop(bool is_train) {
+  if (enable_int8_inference_ && !is_train) {
+    this->fprop_int8();
+    return;
+  }
   this->fprop_generic(is_train);
 }
 template <>
 void InteractionLayer<__half>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
+  if (enable_int8_inference_ && !is_train) {
+    this->fprop_int8();
+    return;
+  }
+
   __half *in_mlp = input_tensors_[0].data<__half>();
   __half *in_emb = input_tensors_[1].data<__half>();
   __half *output = output_tensors_[0].data<__half>();
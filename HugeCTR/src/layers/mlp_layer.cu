@@ -14,11 +14,55 @@
  * limitations under the License.
  */
 
+#include <curand_kernel.h>
+
+#include <cstdlib>
 #include <layers/mlp_layer.hpp>
 #include <type_traits>
 
 namespace HugeCTR {
 
+namespace {
+
+// In-place counter-based dropout. The mask is never materialized: bprop replays the same
+// Philox sequence (same seed and offset) to regenerate it, so a regularized MLP costs one
+// elementwise pass per direction instead of a standalone layer with its own tensors.
+template <typename T>
+__global__ void fused_inplace_dropout_kernel(T* data, int64_t num_elements, float rate,
+                                             float scale, unsigned long long seed,
+                                             unsigned long long offset) {
+  int64_t tid = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x;
+  int64_t base = tid * 4;
+  if (base >= num_elements) {
+    return;
+  }
+  curandStatePhilox4_32_10_t state;
+  curand_init(seed, tid, offset, &state);
+  float4 uniform = curand_uniform4(&state);
+  const float u[4] = {uniform.x, uniform.y, uniform.z, uniform.w};
+#pragma unroll
+  for (int j = 0; j < 4; j++) {
+    if (base + j < num_elements) {
+      float keep = u[j] > rate ? scale : 0.f;
+      data[base + j] = static_cast<T>(static_cast<float>(data[base + j]) * keep);
+    }
+  }
+}
+
+template <typename T>
+void fused_dropout_async(T* data, int64_t num_elements, float rate, unsigned long long seed,
+                         unsigned long long offset, cudaStream_t stream) {
+  constexpr int block_size = 256;
+  int64_t num_quads = (num_elements + 3) / 4;
+  int grid_size = static_cast<int>((num_quads + block_size - 1) / block_size);
+  float scale = 1.f / (1.f - rate);
+  fused_inplace_dropout_kernel<<<grid_size, block_size, 0, stream>>>(data, num_elements, rate,
+                                                                     scale, seed, offset);
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
+}  // namespace
+
 template class MLPLayer<float>;
 template class MLPLayer<__half>;
 
@@ -29,17 +73,24 @@ MLPLayer<T>::MLPLayer(const std::vector<core23::Tensor>& bottom_tensors,
                       const std::shared_ptr<GPUResource>& gpu_resource,
                       const std::vector<Activation_t>& acts, const std::vector<bool>& use_bias,
                       std::vector<Initializer_t> initializer_types, bool skip_head_dgrad,
-                      bool async_wgrad, bool fuse_wb, bool enable_tf32_compute)
+                      bool async_wgrad, bool fuse_wb, bool enable_tf32_compute,
+                      const std::vector<float>& dropout_rates)
     : TrainableLayer<T>(bottom_tensors, top_tensors, gpu_resource, initializer_types),
       num_outputs_(num_outputs),
       acts_(acts),
       use_bias_(use_bias),
+      dropout_rates_(dropout_rates),
       skip_head_dgrad_(skip_head_dgrad),
       async_wgrad_(async_wgrad),
       fuse_wb_(fuse_wb),
       enable_tf32_compute_(enable_tf32_compute),
       event_overlap_created_(false) {
   int num_layers = num_outputs.size();
+  for (float rate : dropout_rates_) {
+    HCTR_THROW_IF(rate < 0.f || rate >= 1.f, Error_t::WrongInput,
+                  "MLPLayer dropout rates must be in [0, 1)");
+  }
+  dropout_offsets_.assign(num_layers, 0);
   train_tensors_.resize(num_layers);
   mask_tensors_.resize(num_layers);
   output_mask_.resize(num_layers);
@@ -113,6 +164,10 @@ void MLPLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(this->get_device_id());
   int num_layers = num_outputs_.size();
   for (int i = 0; i < num_layers; i++) {
+    if (enable_fp8_fprop_ && !is_train && fp8_layer_[i]) {
+      fprop_fp8_layer(i);
+      continue;
+    }
     const T* kernel = kernels_[i].data<T>();
     const T* bottom =
         i == 0 ? this->input_tensors_[0].template data<T>() : train_tensors_[i - 1].data<T>();
@@ -125,6 +180,11 @@ void MLPLayer<T>::fprop(bool is_train) {
       HCTR_LIB_THROW(cudaMemcpyAsync(mask_out, top_fprop, len * sizeof(T), cudaMemcpyDeviceToDevice,
                                      this->get_gpu().get_stream()));
     }
+    if (is_train && i < static_cast<int>(dropout_rates_.size()) && dropout_rates_[i] > 0.f) {
+      fused_dropout_async(top_fprop, train_tensors_[i].num_elements(), dropout_rates_[i],
+                          static_cast<unsigned long long>(i), dropout_offsets_[i]++,
+                          this->get_gpu().get_stream());
+    }
   }
 }
 
@@ -171,6 +231,14 @@ void MLPLayer<T>::bprop() {
                           this->get_gpu().get_cublaslt_handle(), this->get_gpu().get_stream(),
                           this->get_gpu().get_comp_overlap_stream(), event_overlap_,
                           enable_async_wgrad, i == 0 ? skip_head_dgrad_ : false);
+    // The dgrad output is the gradient of the (i - 1)-th GEMM's (dropped) output, so replay
+    // that GEMM's dropout mask here. The multiply commutes with the dRelu epilogue applied
+    // inside the GEMM, both being elementwise.
+    if (i > 0 && i - 1 < static_cast<int>(dropout_rates_.size()) && dropout_rates_[i - 1] > 0.f) {
+      fused_dropout_async(bottom_bprop, train_tensors_[i - 1].num_elements(),
+                          dropout_rates_[i - 1], static_cast<unsigned long long>(i - 1),
+                          dropout_offsets_[i - 1] - 1, this->get_gpu().get_stream());
+    }
   }
 
   if (async_wgrad_) {
@@ -232,6 +300,86 @@ void MLPLayer<T>::initialize() {
     layer_algo_[i].set_fprop_algo(layer_desc_[i], this->get_gpu().get_cublaslt_handle());
     layer_algo_[i].set_bprop_algo(layer_desc_[i], this->get_gpu().get_cublaslt_handle());
   }
+
+  if constexpr (std::is_same_v<T, __half>) {
+    static const bool use_fp8 = []() {
+      const char* env = std::getenv("HCTR_FP8_MLP");
+      return env != nullptr && std::atoi(env) != 0;
+    }();
+    enable_fp8_fprop_ = use_fp8 && this->get_gpu().get_cc_major() >= 9;
+    if (enable_fp8_fprop_) {
+      core23::Device device(core23::DeviceType::GPU, this->get_device_id());
+      cudaStream_t stream = this->get_gpu().get_stream();
+      fp8_layer_.resize(num_layers, false);
+      fp8_kernels_.resize(num_layers);
+      fp8_bottoms_.resize(num_layers);
+      fp8_kernel_scales_.resize(num_layers);
+      fp8_bottom_scales_.resize(num_layers);
+      fp8_desc_.resize(num_layers);
+      fp8_algo_.resize(num_layers);
+      int num_fp8_layers = 0;
+      for (int i = 0; i < num_layers; i++) {
+        const auto& bottom_tensor_dim =
+            i == 0 ? this->input_tensors_[0].shape() : train_tensors_[i - 1].shape();
+        int64_t batch_size = bottom_tensor_dim.size(0);
+        int64_t input_size = bottom_tensor_dim.size(1);
+        int64_t output_size = num_outputs_[i];
+        if (!CublasFp8Desc::supported(batch_size, input_size, output_size)) {
+          continue;
+        }
+        fp8_layer_[i] = true;
+        num_fp8_layers++;
+        fp8_kernels_[i] = core23::Tensor(core23::TensorParams()
+                                             .data_type(core23::ScalarType::UInt8)
+                                             .shape({input_size, output_size})
+                                             .device(device));
+        fp8_bottoms_[i] = core23::Tensor(core23::TensorParams()
+                                             .data_type(core23::ScalarType::UInt8)
+                                             .shape({batch_size, input_size})
+                                             .device(device));
+        fp8_kernel_scales_[i].init(device, stream);
+        fp8_bottom_scales_[i].init(device, stream);
+        const T* bias_ptr = use_bias_[i] ? biases_[i].data<T>() : nullptr;
+        fp8_desc_[i].set_fprop_attr(bias_ptr, acts_[i], batch_size, input_size, output_size,
+                                    fp8_kernel_scales_[i].scale_inv(),
+                                    fp8_bottom_scales_[i].scale_inv());
+        fp8_algo_[i].init_algorithm(fp8_desc_[i], this->get_gpu().get_cublaslt_handle());
+      }
+      if (num_fp8_layers == 0) {
+        enable_fp8_fprop_ = false;
+      } else {
+        HCTR_LOG_S(INFO, ROOT) << "MLPLayer: FP8 fprop enabled for " << num_fp8_layers << " of "
+                               << num_layers << " layers" << std::endl;
+      }
+    }
+  }
+}
+
+template <typename T>
+void MLPLayer<T>::fprop_fp8_layer(int index) {
+  if constexpr (std::is_same_v<T, __half>) {
+    const auto& bottom_tensor = index == 0 ? this->input_tensors_[0] : train_tensors_[index - 1];
+    int64_t batch_size = bottom_tensor.shape().size(0);
+    int64_t input_size = bottom_tensor.shape().size(1);
+    int64_t output_size = num_outputs_[index];
+    cudaStream_t stream = this->get_gpu().get_stream();
+
+    // Fold the amaxes recorded in the previous iteration into the history windows and
+    // refresh the scales before quantizing (delayed scaling).
+    fp8_kernel_scales_[index].update(stream);
+    fp8_bottom_scales_[index].update(stream);
+
+    auto* fp8_kernel = reinterpret_cast<__nv_fp8_e4m3*>(fp8_kernels_[index].data<uint8_t>());
+    auto* fp8_bottom = reinterpret_cast<__nv_fp8_e4m3*>(fp8_bottoms_[index].data<uint8_t>());
+    quantize_transpose_e4m3_async(kernels_[index].data<T>(), fp8_kernel, input_size, output_size,
+                                  fp8_kernel_scales_[index].scale(),
+                                  fp8_kernel_scales_[index].amax(), stream);
+    quantize_e4m3_async(bottom_tensor.data<T>(), fp8_bottom, batch_size * input_size,
+                        fp8_bottom_scales_[index].scale(), fp8_bottom_scales_[index].amax(),
+                        stream);
+    fp8_gemm_functor_(fp8_kernel, fp8_bottom, train_tensors_[index].data<T>(), fp8_desc_[index],
+                      fp8_algo_[index], this->get_gpu().get_cublaslt_handle(), stream);
+  }
 }
 
 template <typename T>
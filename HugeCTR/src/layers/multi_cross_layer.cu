@@ -17,7 +17,9 @@
 #include <cublas_v2.h>
 #include <linalg/gemv.h>
 
+#include <cstdlib>
 #include <cuda/std/array>
+#include <kernel_autotuner.hpp>
 #include <layers/multi_cross_layer.hpp>
 #include <linalg/binary_op.cuh>
 #include <linalg/matrix_vector_op.cuh>
@@ -497,9 +499,15 @@ void matrix_pair_mul(core23::Tensor& o_vec, const core23::Tensor& mat_a,
   assert(h == mat_b.shape().size(0) && w == mat_a.shape().size(1) && h == o_vec.shape().size(0) &&
          1 == o_vec.shape().size(1));
 
-  const int BLOCK_DIM = 256;
-  const int GRID_DIM = calc_grid(h * WARP_SIZE, BLOCK_DIM);
-  matrix_pair_mul_kernel<<<GRID_DIM, BLOCK_DIM, 0, stream>>>(pout, pmat_a, h, w, pmat_b);
+  // One warp per row; any multiple of the warp size is a valid block. 256 is the historical
+  // default and what the autotuner falls back to when disabled.
+  auto launch = [&](int block_dim) {
+    const int grid_dim = calc_grid(h * WARP_SIZE, block_dim);
+    matrix_pair_mul_kernel<<<grid_dim, block_dim, 0, stream>>>(pout, pmat_a, h, w, pmat_b);
+  };
+  const int block_dim = KernelAutotuner::get().tune("multi_cross_matrix_pair_mul", {h, w},
+                                                    {256, 64, 128, 512, 1024}, launch, stream);
+  launch(block_dim);
 }
 
 template <typename T>
@@ -754,6 +762,84 @@ void MultiCrossBackwardFunctorv2<T>::operator()(
   auto U_row = kernel_tensors[0].shape()[0];
   auto V_col = kernel_tensors[1].shape()[1];
   bool dgrad_act_shared = grad_tensors[0].data() == input_tensor.data();
+
+  // The wgrad projections (dU, dV, db) do not feed the sequential dY recurrence, so they can
+  // all be deferred and issued as one contiguous batch once the dgrad chain has produced every
+  // S0/S1. With rank-64 projections the per-layer GEMMs are launch-bound, and this schedule
+  // replaces the two event handoffs per layer with a single one for the whole iteration.
+  // HCTR_DCN_GROUPED_WGRAD=0 restores the interleaved schedule.
+  static const bool grouped_wgrad = [] {
+    const char* env = std::getenv("HCTR_DCN_GROUPED_WGRAD");
+    return env == nullptr || 0 != std::atoi(env);
+  }();
+  if (grouped_wgrad) {
+    for (int i = num_layers - 1; i >= 0; i--) {
+      // S0 = dY_i .* X , shape: (batchsize, w)
+      // dX += dY_i .* H , shape: (batchsize, w)
+      fused_mul_fma3<T>(bprop_bottoms[2 * i], accum_dx_tensor_, grad_tensors[i + 1], input_tensor,
+                        layer_hidden_tensors[i], dgrad_stream);
+
+      // dH = S1 = S0 * V^T shape: (batchsize, project_dim)
+      const T* mat_a = bprop_bottoms[2 * i].data<T>();
+      const T* mat_b = kernel_tensors[2 * i + 1].data<T>();
+      T* mat_c = bprop_bottoms[1 + 2 * i].data<T>();
+      this->gemm_functor_(1.0f, mat_a, mat_b, 0.0f, mat_c, mat_c, xuvb_descr_[i],
+                          xuvb_bprop_algo_[i], cublaslt_handle, dgrad_stream);
+
+      // dY_{i-1} = S1 * U^T + dY_{i} shape: (batchsize, w). Layer 0 is deferred below when its
+      // dgrad output aliases the layer input that the wgrad batch still has to read.
+      if (i > 0 || !dgrad_act_shared) {
+        mat_a = bprop_bottoms[1 + 2 * i].data<T>();
+        mat_b = kernel_tensors[i * 2].data<T>();
+        mat_c = grad_tensors[i + 1].data<T>();
+        T* mat_d = grad_tensors[i].data<T>();
+        this->gemm_functor_(1.0f, mat_a, mat_b, 1.0f, mat_c, mat_d, dhidden_descrs_bprop_[i],
+                            dhidden_bprop_algos_[i], cublaslt_handle, dgrad_stream);
+      }
+    }
+
+    if (async_wgrad) {
+      HCTR_LIB_THROW(cudaEventRecord(event_overlap, dgrad_stream));
+      HCTR_LIB_THROW(cudaStreamWaitEvent(wgrad_stream, event_overlap));
+    }
+    cudaStream_t batch_stream = async_wgrad ? wgrad_stream : dgrad_stream;
+    for (int i = num_layers - 1; i >= 0; i--) {
+      // db, dV = XU_{i}^T * S0 shape: (project_dim, w)
+      const T* mat_a = XU_tensors[i].data<T>();
+      const T* mat_b = bprop_bottoms[2 * i].data<T>();
+      T* mat_c = kernel_output_tensors[2 * i + 1].data<T>();
+      this->gemm_functor_(1.0f, mat_a, mat_b, 1.0f, mat_c, mat_c, xu_descr_[i], xu_bprop_algo_[i],
+                          cublaslt_handle, batch_stream);
+
+      // dU = X_{i-1} ^T * S1 shape: (w, project_dim)
+      mat_a = i == 0 ? input_tensor.data<T>() : layer_output_tensors[i - 1].data<T>();
+      mat_b = bprop_bottoms[1 + 2 * i].data<T>();
+      mat_c = kernel_output_tensors[2 * i].data<T>();
+      this->gemm_functor_(1.0f, mat_a, mat_b, 1.0f, mat_c, mat_c, du_descrs_bprop_[i],
+                          du_bprop_algos_[i], cublaslt_handle, batch_stream);
+    }
+
+    if (dgrad_act_shared) {
+      if (async_wgrad) {
+        HCTR_LIB_THROW(cudaEventRecord(event_overlap, wgrad_stream));
+        HCTR_LIB_THROW(cudaStreamWaitEvent(dgrad_stream, event_overlap));
+      }
+      const T* mat_a = bprop_bottoms[1].data<T>();
+      const T* mat_b = kernel_tensors[0].data<T>();
+      const T* mat_c = grad_tensors[1].data<T>();
+      T* mat_d = grad_tensors[0].data<T>();
+      this->gemm_functor_(1.0f, mat_a, mat_b, 1.0f, mat_c, mat_d, dhidden_descrs_bprop_[0],
+                          dhidden_bprop_algos_[0], cublaslt_handle, dgrad_stream);
+    }
+
+    matrix_add<T>(grad_tensors[0], accum_dx_tensor_, grad_tensors[0], dgrad_stream);
+    if (async_wgrad) {
+      HCTR_LIB_THROW(cudaEventRecord(event_overlap, wgrad_stream));
+      HCTR_LIB_THROW(cudaStreamWaitEvent(dgrad_stream, event_overlap));
+    }
+    return;
+  }
+
   for (int i = num_layers - 1; i >= 0; i--) {
     // S0 = dY_i .* X , shape: (batchsize, w)
     // dX += dY_i .* H , shape: (batchsize, w)
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <core23/tensor_operations.hpp>
+#include <cstdlib>
 #include <functional>
 #include <layers/multi_head_attention_layer.hpp>
 #include <memory>
@@ -154,6 +155,104 @@ __global__ void transpose_V(T* v_buf, const T* V, const int batch_size, const in
   float input_V = V[d0 * d0_stride + d1 * d1_stride + d2 * d2_stride + d3];
   v_buf[d0 * d0_out_stride + d1 * d1_out_stride + d2 * d2_out_stride + d3] = input_V;
 }
+// One thread per query row; K/V tiles are staged through shared memory and combined with an
+// online (running max / running sum) softmax, so the [seq_from, seq_to] score matrix is never
+// materialized. Q, K, V and the output are addressed in their natural
+// [batch, seq, head_num * size_per_head] layout, so no 0213 transpose passes are needed either.
+template <typename T, int kMaxSizePerHead>
+__global__ void flash_attention_fprop_kernel(const T* query, const T* key, const T* value,
+                                             const T* mask, T* out, const int head_num,
+                                             const int seq_len_from, const int seq_len_to,
+                                             const int size_per_head, const float scale) {
+  constexpr int kKeyTileRows = 32;
+  __shared__ float k_tile[kKeyTileRows][kMaxSizePerHead];
+  __shared__ float v_tile[kKeyTileRows][kMaxSizePerHead];
+
+  const int batch = blockIdx.z;
+  const int head = blockIdx.y;
+  const int row = blockIdx.x * blockDim.x + threadIdx.x;
+  const int hidden_dim = head_num * size_per_head;
+  const bool active = row < seq_len_from;
+
+  float q_row[kMaxSizePerHead];
+  float acc[kMaxSizePerHead];
+  float row_max = -1e20f;
+  float row_sum = 0.f;
+  if (active) {
+    const T* q_ptr = query + (static_cast<int64_t>(batch) * seq_len_from + row) * hidden_dim +
+                     head * size_per_head;
+    for (int d = 0; d < size_per_head; d++) {
+      q_row[d] = static_cast<float>(q_ptr[d]);
+      acc[d] = 0.f;
+    }
+  }
+
+  for (int tile_start = 0; tile_start < seq_len_to; tile_start += kKeyTileRows) {
+    const int tile_rows = min(kKeyTileRows, seq_len_to - tile_start);
+    for (int idx = threadIdx.x; idx < tile_rows * size_per_head; idx += blockDim.x) {
+      const int r = idx / size_per_head;
+      const int d = idx - r * size_per_head;
+      const int64_t src = (static_cast<int64_t>(batch) * seq_len_to + tile_start + r) * hidden_dim +
+                          head * size_per_head + d;
+      k_tile[r][d] = static_cast<float>(key[src]);
+      v_tile[r][d] = static_cast<float>(value[src]);
+    }
+    __syncthreads();
+
+    if (active) {
+      for (int r = 0; r < tile_rows; r++) {
+        float score = 0.f;
+        for (int d = 0; d < size_per_head; d++) {
+          score += q_row[d] * k_tile[r][d];
+        }
+        score *= scale;
+        if (mask != nullptr) {
+          // Same (1 - mask) * 10000 convention as mask_softmax_fprop_kernel; the mask is
+          // shared across heads.
+          const int64_t mask_offset =
+              (static_cast<int64_t>(batch) * seq_len_from + row) * seq_len_to + tile_start + r;
+          score -= (1.f - static_cast<float>(mask[mask_offset])) * 10000.0f;
+        }
+        const float new_max = fmaxf(row_max, score);
+        const float correction = __expf(row_max - new_max);
+        const float p = __expf(score - new_max);
+        row_sum = row_sum * correction + p;
+        for (int d = 0; d < size_per_head; d++) {
+          acc[d] = acc[d] * correction + p * v_tile[r][d];
+        }
+        row_max = new_max;
+      }
+    }
+    __syncthreads();
+  }
+
+  if (active) {
+    T* out_ptr = out + (static_cast<int64_t>(batch) * seq_len_from + row) * hidden_dim +
+                 head * size_per_head;
+    const float inv_sum = 1.f / row_sum;
+    for (int d = 0; d < size_per_head; d++) {
+      out_ptr[d] = static_cast<T>(acc[d] * inv_sum);
+    }
+  }
+}
+
+template <typename T>
+void flash_attention_fprop(const T* query, const T* key, const T* value, const T* mask, T* out,
+                           int batch_size, int head_num, int seq_len_from, int seq_len_to,
+                           int size_per_head, cudaStream_t stream) {
+  constexpr int block_size = 128;
+  dim3 grid_dim((seq_len_from + block_size - 1) / block_size, head_num, batch_size);
+  const float scale = 1.f / sqrtf(static_cast<float>(size_per_head));
+  if (size_per_head <= 32) {
+    flash_attention_fprop_kernel<T, 32><<<grid_dim, block_size, 0, stream>>>(
+        query, key, value, mask, out, head_num, seq_len_from, seq_len_to, size_per_head, scale);
+  } else {
+    flash_attention_fprop_kernel<T, 64><<<grid_dim, block_size, 0, stream>>>(
+        query, key, value, mask, out, head_num, seq_len_from, seq_len_to, size_per_head, scale);
+  }
+  HCTR_LIB_THROW(cudaGetLastError());
+}
+
 // input is q, k, v, mask
 template <typename T>
 MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
@@ -202,6 +301,12 @@ MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
     k = k_shape[1];
     size_per_head = q_shape[2] / h;
     num_head_ = h;
+    static const bool use_flash_attention = []() {
+      const char* env = std::getenv("HCTR_FLASH_ATTENTION");
+      return env != nullptr && std::atoi(env) != 0;
+    }();
+    // The per-thread register accumulators cap the fused path at 64 elements per head.
+    enable_flash_attention_ = use_flash_attention && size_per_head <= 64;
     core23::BufferParams buf_p{.channel = GetBlobsBufferChannel()};
 
     auto common_tensor_params = input_tensors_[0]
@@ -246,6 +351,19 @@ MultiHeadAttentionLayer<T>::MultiHeadAttentionLayer(
 template <typename T>
 void MultiHeadAttentionLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
+  if (enable_flash_attention_ && !is_train) {
+    const auto& in_tensor_shape = input_tensors_[0].shape();
+    const int batch_size = in_tensor_shape[0];
+    const int from_seq_len = in_tensor_shape[dims_ - 2];
+    const int to_seq_len = input_tensors_[1].size(dims_ - 2);
+    const int size_per_head = in_tensor_shape[dims_ - 1] / num_head_;
+    const T* mask = num_ == 4 ? input_tensors_[3].data<T>() : nullptr;
+    flash_attention_fprop(input_tensors_[0].data<T>(), input_tensors_[1].data<T>(),
+                          input_tensors_[2].data<T>(), mask, output_tensors_[0].data<T>(),
+                          batch_size, num_head_, from_seq_len, to_seq_len, size_per_head,
+                          get_gpu().get_stream());
+    return;
+  }
   T* query = input_tensors_[0].data<T>();
   T* key = input_tensors_[1].data<T>();
   T* value = input_tensors_[2].data<T>();
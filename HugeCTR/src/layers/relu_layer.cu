@@ -22,6 +22,7 @@
 #include <include/utils.cuh>
 #include <layers/relu_layer.hpp>
 #include <linalg/binary_op.cuh>
+#include <network_buffer_channels.hpp>
 #include <linalg/unary_op.cuh>
 #include <utils.hpp>
 
@@ -55,17 +56,88 @@ __global__ void half4_relu_kernel(__half* __restrict__ out, const __half* __rest
   }
 }
 
+// In-place mode: the output buffer aliases the input, so fprop keeps a 1-bit-per-element sign
+// mask of the pre-activation instead of a second activation tensor, and bprop re-applies the
+// mask to the gradient the upper layer wrote into the shared buffer. The warp iterates over a
+// 32-aligned padded length so every ballot covers a full warp; lane 0 owns the mask word.
+template <typename T>
+__global__ void relu_inplace_fprop_kernel(T* data, uint32_t* mask, const int64_t len) {
+  const int64_t padded_len = (len + 31) / 32 * 32;
+  const int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+  for (int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x; i < padded_len;
+       i += stride) {
+    bool positive = false;
+    if (i < len) {
+      T value = data[i];
+      positive = value > T(0);
+      if (!positive) {
+        data[i] = T(0);
+      }
+    }
+    uint32_t ballot = __ballot_sync(0xffffffff, positive);
+    if ((threadIdx.x & 31) == 0 && i < len) {
+      mask[i / 32] = ballot;
+    }
+  }
+}
+
+template <typename T>
+__global__ void relu_inplace_bprop_kernel(T* grad, const uint32_t* mask, const int64_t len) {
+  const int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+  for (int64_t i = blockIdx.x * static_cast<int64_t>(blockDim.x) + threadIdx.x; i < len;
+       i += stride) {
+    if (((mask[i / 32] >> (i & 31)) & 1u) == 0u) {
+      grad[i] = T(0);
+    }
+  }
+}
+
+core23::Tensor make_relu_mask_tensor(const core23::Tensor& input_tensor) {
+  core23::BufferParams buf_p{.channel = GetBlobsBufferChannel()};
+  return core23::Tensor(input_tensor.my_params()
+                            .data_type(core23::ScalarType::UInt32)
+                            .shape({(input_tensor.num_elements() + 31) / 32})
+                            .buffer_params(buf_p));
+}
+
+template <typename T>
+void relu_inplace_fprop(core23::Tensor& data, core23::Tensor& mask, cudaStream_t stream) {
+  constexpr int block_dim = 256;
+  const int64_t len = data.num_elements();
+  const int grid_dim = static_cast<int>(std::min<int64_t>((len + block_dim - 1) / block_dim, 2048));
+  relu_inplace_fprop_kernel<<<grid_dim, block_dim, 0, stream>>>(data.data<T>(),
+                                                                mask.data<uint32_t>(), len);
+}
+
+template <typename T>
+void relu_inplace_bprop(core23::Tensor& grad, const core23::Tensor& mask, cudaStream_t stream) {
+  constexpr int block_dim = 256;
+  const int64_t len = grad.num_elements();
+  const int grid_dim = static_cast<int>(std::min<int64_t>((len + block_dim - 1) / block_dim, 2048));
+  relu_inplace_bprop_kernel<<<grid_dim, block_dim, 0, stream>>>(grad.data<T>(),
+                                                                mask.data<uint32_t>(), len);
+}
+
 }  // namespace
 
 template <typename T>
 ReluLayer<T>::ReluLayer(const core23::Tensor& input_tensor, const core23::Tensor& output_tensor,
-                        const std::shared_ptr<GPUResource>& gpu_resource)
-    : Layer({input_tensor}, {output_tensor}, gpu_resource) {}
+                        const std::shared_ptr<GPUResource>& gpu_resource, bool in_place)
+    : Layer({input_tensor}, {output_tensor}, gpu_resource), in_place_(in_place) {
+  if (in_place_) {
+    mask_tensor_ = make_relu_mask_tensor(input_tensor);
+  }
+}
 
 template <typename T>
 void ReluLayer<T>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
+  if (in_place_) {
+    relu_inplace_fprop<T>(input_tensors_[0], mask_tensor_, get_gpu().get_stream());
+    return;
+  }
+
   int len = input_tensors_[0].num_elements();
 
   auto fop = [] __device__(T in) { return (in > T(0)) ? in : T(0); };
@@ -78,6 +150,11 @@ template <typename T>
 void ReluLayer<T>::bprop() {
   CudaDeviceContext context(get_device_id());
 
+  if (in_place_) {
+    relu_inplace_bprop<T>(input_tensors_[0], mask_tensor_, get_gpu().get_stream());
+    return;
+  }
+
   int len = input_tensors_[0].num_elements();
   auto bop = [] __device__(T d_out, T d_in) { return (d_in > T(0)) ? d_out : T(0); };
   MLCommon::LinAlg::binaryOp(input_tensors_[0].data<T>(), output_tensors_[0].data<T>(),
@@ -86,12 +163,21 @@ void ReluLayer<T>::bprop() {
 
 ReluLayer<__half>::ReluLayer(const core23::Tensor& input_tensor,
                              const core23::Tensor& output_tensor,
-                             const std::shared_ptr<GPUResource>& gpu_resource)
-    : Layer({input_tensor}, {output_tensor}, gpu_resource) {}
+                             const std::shared_ptr<GPUResource>& gpu_resource, bool in_place)
+    : Layer({input_tensor}, {output_tensor}, gpu_resource), in_place_(in_place) {
+  if (in_place_) {
+    mask_tensor_ = make_relu_mask_tensor(input_tensor);
+  }
+}
 
 void ReluLayer<__half>::fprop(bool is_train) {
   CudaDeviceContext context(get_device_id());
 
+  if (in_place_) {
+    relu_inplace_fprop<__half>(input_tensors_[0], mask_tensor_, get_gpu().get_stream());
+    return;
+  }
+
   const size_t BLOCK_DIM = 1024;
 
   const auto size = input_tensors_[0].num_elements();
@@ -118,6 +204,11 @@ void ReluLayer<__half>::fprop(bool is_train) {
 void ReluLayer<__half>::bprop() {
   CudaDeviceContext context(get_device_id());
 
+  if (in_place_) {
+    relu_inplace_bprop<__half>(input_tensors_[0], mask_tensor_, get_gpu().get_stream());
+    return;
+  }
+
   const size_t BLOCK_DIM = 1024;
 
   const size_t size = input_tensors_[0].num_elements();
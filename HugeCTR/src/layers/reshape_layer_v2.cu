@@ -15,6 +15,7 @@
  */
 
 #include <common.hpp>
+#include <cstdlib>
 #include <layers/reshape_layer_v2.hpp>
 #include <network_buffer_channels.hpp>
 #include <utils.hpp>
@@ -69,9 +70,21 @@ ReshapeLayerV2<T>::ReshapeLayerV2(const core23::Tensor& input_tensor, core23::Te
     std::vector<int64_t> out_dimensions =
         reshape_layer_utils::calc_output_shape(input_tensor_shape, out_shape_with_placeholder);
 
-    core23::BufferParams buf{.channel = GetBlobsBufferChannel()};
-    output_tensor =
-        core23::Tensor(input_tensor.my_params().shape(out_dimensions).buffer_params(buf));
+    static const bool in_place = [] {
+      const char* env = std::getenv("HCTR_INPLACE_ACTIVATIONS");
+      return env != nullptr && std::atoi(env) != 0;
+    }();
+    if (in_place) {
+      // A reshape is pure data movement, so the output can be a zero-copy view of the input
+      // buffer; this drops both the memcpy per direction and the separate activation.
+      is_view_ = true;
+      core23::Tensor shared_input = input_tensor;
+      output_tensor = shared_input.reshape(core23::Shape(out_dimensions));
+    } else {
+      core23::BufferParams buf{.channel = GetBlobsBufferChannel()};
+      output_tensor =
+          core23::Tensor(input_tensor.my_params().shape(out_dimensions).buffer_params(buf));
+    }
 
     output_tensors_.push_back(output_tensor);
   } catch (const std::runtime_error& rt_err) {
@@ -82,6 +95,9 @@ ReshapeLayerV2<T>::ReshapeLayerV2(const core23::Tensor& input_tensor, core23::Te
 
 template <typename T>
 void ReshapeLayerV2<T>::fprop(bool is_train) {
+  if (is_view_) {
+    return;
+  }
   core23::Tensor& input_tensor = input_tensors_[0];
   core23::Tensor& output_tensor = output_tensors_[0];
 
@@ -92,6 +108,9 @@ void ReshapeLayerV2<T>::fprop(bool is_train) {
 
 template <typename T>
 void ReshapeLayerV2<T>::bprop() {
+  if (is_view_) {
+    return;
+  }
   core23::Tensor& input_tensor = input_tensors_[0];
   core23::Tensor& output_tensor = output_tensors_[0];
 
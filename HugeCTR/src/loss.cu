@@ -95,8 +95,8 @@ void Loss<T>::compute(bool is_train, long long current_batchsize, float rterm) {
     HCTR_OWN_THROW(Error_t::WrongInput, "current_batchsize > batch_size && current_batchsize < 0");
   }
 
-  do_compute(input, label, loss, current_batchsize, feature_dim, scaler_, rterm, label_weight,
-             is_train, get_gpu().get_stream());
+  do_compute(input, label, loss, current_batchsize, feature_dim, scaler_, scaler_ptr_, rterm,
+             label_weight, is_train, get_gpu().get_stream());
   if (is_train) {
     // once current_batchsize < batch_size in train we set the rest dgrad to 0
     if (current_batchsize < batch_size) {
@@ -156,8 +156,12 @@ CrossEntropyLoss<T>::CrossEntropyLoss(const core23::Tensor &label_tensor,
 // Suppose we use one thread to calculate one sample
 template <typename T>
 __global__ void CrossEntropy_Kernel(T *input, const float *label, float *cel_loss, int batch_size,
-                                    int total_gpu_count, int feature_dim, float scaler, float rterm,
-                                    float label_weight, bool is_train) {
+                                    int total_gpu_count, int feature_dim, float scaler,
+                                    const float *scaler_ptr, float rterm, float label_weight,
+                                    bool is_train) {
+  if (scaler_ptr != nullptr) {
+    scaler = *scaler_ptr;
+  }
   int tid = threadIdx.x;
   extern __shared__ float loss_s[];
 
@@ -200,14 +204,15 @@ __global__ void CrossEntropy_Kernel(T *input, const float *label, float *cel_los
 
 template <typename T>
 void CrossEntropyLoss<T>::do_compute(T *input, const float *label, float *loss, int batch_size,
-                                     int feature_dim, float scaler, float rterm, float label_weight,
-                                     bool is_train, cudaStream_t stream) {
+                                     int feature_dim, float scaler, const float *scaler_ptr,
+                                     float rterm, float label_weight, bool is_train,
+                                     cudaStream_t stream) {
   int block_size = min(batch_size, 1024);
   size_t smem_size = block_size * sizeof(float);
   if (block_size > 0) {
     CrossEntropy_Kernel<<<1, block_size, smem_size, stream>>>(
-        input, label, loss, batch_size, Loss<T>::get_total_gpu_count(), feature_dim, scaler, rterm,
-        label_weight, is_train);
+        input, label, loss, batch_size, Loss<T>::get_total_gpu_count(), feature_dim, scaler,
+        scaler_ptr, rterm, label_weight, is_train);
   }
 }
 
@@ -229,9 +234,12 @@ BinaryCrossEntropyLoss<T>::BinaryCrossEntropyLoss(
 // Suppose we use one thread to calculate one sample
 template <typename T>
 __global__ void BinaryCrossEntropy_Kernel(T *input, const float *label, float *bce_loss,
-                                          float scaler, int batch_size, int total_gpu_count,
-                                          float rterm, float label_weight, bool is_train,
-                                          bool gen_loss_summary) {
+                                          float scaler, const float *scaler_ptr, int batch_size,
+                                          int total_gpu_count, float rterm, float label_weight,
+                                          bool is_train, bool gen_loss_summary) {
+  if (scaler_ptr != nullptr) {
+    scaler = *scaler_ptr;
+  }
   int tid = blockIdx.x * blockDim.x + threadIdx.x;
   float val = 0.0f;
   if (tid < batch_size) {
@@ -264,7 +272,8 @@ __global__ void BinaryCrossEntropy_Kernel(T *input, const float *label, float *b
 template <typename T>
 void BinaryCrossEntropyLoss<T>::do_compute(T *input, const float *label, float *loss,
                                            int batch_size, int feature_dim, float scaler,
-                                           float rterm, float label_weight, bool is_train,
+                                           const float *scaler_ptr, float rterm,
+                                           float label_weight, bool is_train,
                                            cudaStream_t stream) {
   int block_size = 512;
   int grid_size = (batch_size + block_size - 1) / block_size;
@@ -273,8 +282,8 @@ void BinaryCrossEntropyLoss<T>::do_compute(T *input, const float *label, float *
       HCTR_LIB_THROW(cudaMemsetAsync(loss, 0, sizeof(float), stream));
     }
     BinaryCrossEntropy_Kernel<<<grid_size, block_size, 0, stream>>>(
-        input, label, loss, scaler, batch_size, Loss<T>::get_total_gpu_count(), rterm, label_weight,
-        is_train, Loss<T>::gen_loss_summary_);
+        input, label, loss, scaler, scaler_ptr, batch_size, Loss<T>::get_total_gpu_count(), rterm,
+        label_weight, is_train, Loss<T>::gen_loss_summary_);
   }
 }
 
@@ -305,8 +314,11 @@ __forceinline__ __device__ __host__ float cross_entropy_loss_backward(float x, f
 template <typename T>
 __global__ void MultiCrossEntropy_Kernel(T *input, const float *label, const float *target_weight,
                                          float *bce_loss, int batchsize, int total_gpu_count,
-                                         int labels_per_sample, float scaler, float rterm,
-                                         bool is_train) {
+                                         int labels_per_sample, float scaler,
+                                         const float *scaler_ptr, float rterm, bool is_train) {
+  if (scaler_ptr != nullptr) {
+    scaler = *scaler_ptr;
+  }
   int tid = threadIdx.x + blockDim.x * blockIdx.x;
   int num_threads = blockDim.x * gridDim.x;
   float loss_s = 0.f;
@@ -338,8 +350,8 @@ __global__ void MultiCrossEntropy_Kernel(T *input, const float *label, const flo
 
 template <typename T>
 void MultiCrossEntropyLoss<T>::do_compute(T *input, const float *label, float *loss, int batch_size,
-                                          int feature_dim, float scaler, float rterm,
-                                          float /*label_weight*/, bool is_train,
+                                          int feature_dim, float scaler, const float *scaler_ptr,
+                                          float rterm, float /*label_weight*/, bool is_train,
                                           cudaStream_t stream) {
   // label_weight not currently used, since multiCross is not used for multi-label models
 
@@ -353,7 +365,7 @@ void MultiCrossEntropyLoss<T>::do_compute(T *input, const float *label, float *l
   target_weight = target_weight_.data<float>();
   MultiCrossEntropy_Kernel<<<GRID_SIZE, BLOCK_SIZE, 0, stream>>>(
       input, label, target_weight, loss, batch_size, Loss<T>::get_total_gpu_count(),
-      labels_per_sample, scaler, rterm, is_train);
+      labels_per_sample, scaler, scaler_ptr, rterm, is_train);
 }
 
 template <typename T>
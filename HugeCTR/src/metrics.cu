@@ -16,7 +16,9 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <core23/buffer_channel_helpers.hpp>
+#include <cstdlib>
 #include <cub/cub.cuh>
 #include <diagnose.hpp>
 #include <general_buffer2.hpp>
@@ -430,7 +432,13 @@ std::unique_ptr<Metric> Metric::Create(const Type type, bool use_mixed_precision
   std::unique_ptr<Metric> ret;
   switch (type) {
     case Type::AUC:
-      if (use_mixed_precision) {
+      if (StreamingAUC<float>::enabled()) {
+        if (use_mixed_precision) {
+          ret.reset(new StreamingAUC<__half>(batch_size_eval, label_dim, resource_manager));
+        } else {
+          ret.reset(new StreamingAUC<float>(batch_size_eval, label_dim, resource_manager));
+        }
+      } else if (use_mixed_precision) {
         ret.reset(new AUC<__half>(batch_size_eval, n_batches, label_dim, resource_manager));
       } else {
         ret.reset(new AUC<float>(batch_size_eval, n_batches, label_dim, resource_manager));
@@ -443,12 +451,32 @@ std::unique_ptr<Metric> Metric::Create(const Type type, bool use_mixed_precision
       ret.reset(new HitRate<float>(batch_size_eval, resource_manager));
       break;
     case Type::NDCG:
-      if (use_mixed_precision) {
+      if (PerQueryRanking<float>::enabled()) {
+        if (use_mixed_precision) {
+          ret.reset(new PerQueryRanking<__half>(PerQueryRanking<__half>::Kind::NDCG,
+                                                batch_size_eval, resource_manager));
+        } else {
+          ret.reset(new PerQueryRanking<float>(PerQueryRanking<float>::Kind::NDCG,
+                                               batch_size_eval, resource_manager));
+        }
+      } else if (use_mixed_precision) {
         ret.reset(new NDCG<__half>(batch_size_eval, n_batches, resource_manager));
       } else {
         ret.reset(new NDCG<float>(batch_size_eval, n_batches, resource_manager));
       }
       break;
+    case Type::MRR:
+      HCTR_CHECK_HINT(PerQueryRanking<float>::enabled(),
+                      "The MRR metric requires HCTR_RANKING_QUERY_SIZE to define the "
+                      "per-query candidate list length.");
+      if (use_mixed_precision) {
+        ret.reset(new PerQueryRanking<__half>(PerQueryRanking<__half>::Kind::MRR, batch_size_eval,
+                                              resource_manager));
+      } else {
+        ret.reset(new PerQueryRanking<float>(PerQueryRanking<float>::Kind::MRR, batch_size_eval,
+                                             resource_manager));
+      }
+      break;
     case Type::SMAPE:
       ret.reset(new SMAPE<float>(batch_size_eval, resource_manager));
       break;
@@ -1241,6 +1269,343 @@ void AUC<T>::run_finalize_step(float* d_preds, float* d_labels, int local_id,
   }
 }
 
+namespace {
+
+template <typename PredType>
+__global__ void streaming_auc_bin_kernel(const PredType* preds, const float* labels,
+                                         size_t num_elems, int num_classes, int num_bins,
+                                         float pred_min, float pred_max, CountType* pos_bins,
+                                         CountType* neg_bins) {
+  size_t base = blockIdx.x * blockDim.x + threadIdx.x;
+  for (size_t i = base; i < num_elems; i += blockDim.x * gridDim.x) {
+    // predictions and labels are sample-major: [sample][class]
+    int class_id = i % num_classes;
+    float pred = TypeConvertFunc<float, PredType>::convert(preds[i]);
+    float frac = (pred - pred_min) / (pred_max - pred_min);
+    int bin = max(0, min(num_bins - 1, static_cast<int>(frac * num_bins)));
+    CountType* bins = labels[i] > 0.5f ? pos_bins : neg_bins;
+    atomicAdd(bins + class_id * num_bins + bin, 1u);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+bool StreamingAUC<T>::enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_STREAMING_AUC");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return enabled;
+}
+
+template <typename T>
+StreamingAUC<T>::StreamingAUC(int batch_size_per_gpu, int label_dim,
+                              const std::shared_ptr<ResourceManager>& resource_manager)
+    : Metric(),
+      num_classes_(label_dim),
+      resource_manager_(resource_manager),
+      num_local_gpus_(resource_manager->get_local_gpu_count()),
+      batch_size_per_gpu_(batch_size_per_gpu),
+      per_class_aucs_(label_dim, 0.0f) {
+  num_bins_ = [] {
+    const char* env = std::getenv("HCTR_STREAMING_AUC_BINS");
+    int num_bins = (env != nullptr) ? std::atoi(env) : 0;
+    return num_bins > 0 ? num_bins : 8192;
+  }();
+
+  pos_bins_.resize(num_local_gpus_);
+  neg_bins_.resize(num_local_gpus_);
+  for (int local_id = 0; local_id < num_local_gpus_; local_id++) {
+    int device_id = resource_manager_->get_local_gpu(local_id)->get_device_id();
+    CudaDeviceContext context(device_id);
+    core23::TensorParams tensor_params =
+        core23::TensorParams()
+            .device(core23::Device(core23::DeviceType::GPU, device_id))
+            .data_type(core23::ScalarType::UInt32)
+            .shape(core23::Shape({static_cast<int64_t>(num_classes_) * num_bins_}));
+    pos_bins_[local_id] = core23::Tensor(tensor_params);
+    neg_bins_[local_id] = core23::Tensor(tensor_params);
+    HCTR_LIB_THROW(cudaMemset(pos_bins_[local_id].data(), 0, pos_bins_[local_id].num_bytes()));
+    HCTR_LIB_THROW(cudaMemset(neg_bins_[local_id].data(), 0, neg_bins_[local_id].num_bytes()));
+  }
+}
+
+template <typename T>
+StreamingAUC<T>::~StreamingAUC() {}
+
+template <typename T>
+void StreamingAUC<T>::local_reduce(int local_gpu_id, Core23RawMetricMap raw_metrics) {
+  core23::Tensor pred_tensor = raw_metrics[RawType::Pred];
+  core23::Tensor label_tensor = raw_metrics[RawType::Label];
+  int device_id = resource_manager_->get_local_gpu(local_gpu_id)->get_device_id();
+  int global_device_id = resource_manager_->get_local_gpu(local_gpu_id)->get_global_id();
+
+  CudaDeviceContext context(device_id);
+  int num_valid_samples =
+      get_num_valid_samples(global_device_id, current_batch_size_, batch_size_per_gpu_);
+  if (num_valid_samples <= 0) {
+    return;
+  }
+  auto stream = resource_manager_->get_local_gpu(local_gpu_id)->get_stream();
+  int num_sms = resource_manager_->get_local_gpu(local_gpu_id)->get_sm_count();
+
+  dim3 grid(num_sms * 2, 1, 1);
+  dim3 block(1024, 1, 1);
+  streaming_auc_bin_kernel<T><<<grid, block, 0, stream>>>(
+      pred_tensor.data<PredType>(), label_tensor.data<LabelType>(),
+      static_cast<size_t>(num_valid_samples) * num_classes_, num_classes_, num_bins_, pred_min_,
+      pred_max_, pos_bins_[local_gpu_id].data<CountType>(),
+      neg_bins_[local_gpu_id].data<CountType>());
+}
+
+template <typename T>
+void StreamingAUC<T>::global_reduce(int n_nets) {
+  // No need to do anything here
+}
+
+template <typename T>
+float StreamingAUC<T>::finalize_metric() {
+  std::vector<CountType> h_pos_bins(num_classes_ * num_bins_);
+  std::vector<CountType> h_neg_bins(num_classes_ * num_bins_);
+
+#pragma omp parallel num_threads(num_local_gpus_)
+  {
+    int local_id = omp_get_thread_num();
+    auto gpu_resource = resource_manager_->get_local_gpu(local_id).get();
+    CudaDeviceContext context(gpu_resource->get_device_id());
+    auto stream = gpu_resource->get_stream();
+
+    CountType* pos_bins = pos_bins_[local_id].data<CountType>();
+    CountType* neg_bins = neg_bins_[local_id].data<CountType>();
+    size_t num_elems = num_classes_ * num_bins_;
+    metric_comm::allreduce(pos_bins, pos_bins, num_elems, gpu_resource, stream);
+    metric_comm::allreduce(neg_bins, neg_bins, num_elems, gpu_resource, stream);
+
+    if (local_id == 0) {
+      HCTR_LIB_THROW(cudaMemcpyAsync(h_pos_bins.data(), pos_bins, num_elems * sizeof(CountType),
+                                     cudaMemcpyDeviceToHost, stream));
+      HCTR_LIB_THROW(cudaMemcpyAsync(h_neg_bins.data(), neg_bins, num_elems * sizeof(CountType),
+                                     cudaMemcpyDeviceToHost, stream));
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    // reset for the next evaluation phase
+    HCTR_LIB_THROW(
+        cudaMemsetAsync(pos_bins, 0, pos_bins_[local_id].num_bytes(), stream));
+    HCTR_LIB_THROW(
+        cudaMemsetAsync(neg_bins, 0, neg_bins_[local_id].num_bytes(), stream));
+  }
+
+  // Sweep the bins from the highest score down: each bin edge is one point of the
+  // ROC curve, integrated with the trapezoid rule.
+  double auc_sum = 0.0;
+  for (size_t class_id = 0; class_id < num_classes_; class_id++) {
+    const CountType* pos = h_pos_bins.data() + class_id * num_bins_;
+    const CountType* neg = h_neg_bins.data() + class_id * num_bins_;
+    double total_pos = 0.0, total_neg = 0.0;
+    for (int bin = 0; bin < num_bins_; bin++) {
+      total_pos += pos[bin];
+      total_neg += neg[bin];
+    }
+
+    double auc = 0.5;
+    if (total_pos > 0.0 && total_neg > 0.0) {
+      auc = 0.0;
+      double tp = 0.0, fp = 0.0, prev_tpr = 0.0, prev_fpr = 0.0;
+      for (int bin = num_bins_ - 1; bin >= 0; bin--) {
+        tp += pos[bin];
+        fp += neg[bin];
+        double tpr = tp / total_pos;
+        double fpr = fp / total_neg;
+        auc += (fpr - prev_fpr) * (tpr + prev_tpr) * 0.5;
+        prev_tpr = tpr;
+        prev_fpr = fpr;
+      }
+    }
+    per_class_aucs_[class_id] = static_cast<float>(auc);
+    auc_sum += auc;
+  }
+
+  return static_cast<float>(auc_sum / num_classes_);
+}
+
+template <typename T>
+bool PerQueryRanking<T>::enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_RANKING_QUERY_SIZE");
+    return env != nullptr && std::atoi(env) > 1;
+  }();
+  return enabled;
+}
+
+template <typename T>
+PerQueryRanking<T>::PerQueryRanking(Kind kind, int batch_size_per_gpu,
+                                    const std::shared_ptr<ResourceManager>& resource_manager)
+    : Metric(),
+      kind_(kind),
+      resource_manager_(resource_manager),
+      num_local_gpus_(resource_manager->get_local_gpu_count()),
+      batch_size_per_gpu_(batch_size_per_gpu),
+      n_batches_(0) {
+  query_size_ = [] {
+    const char* env = std::getenv("HCTR_RANKING_QUERY_SIZE");
+    return env != nullptr ? std::atoi(env) : 0;
+  }();
+  HCTR_CHECK_HINT(query_size_ > 1 && query_size_ <= 2048,
+                  "HCTR_RANKING_QUERY_SIZE must be within [2, 2048].");
+  HCTR_CHECK_HINT(batch_size_per_gpu_ % query_size_ == 0,
+                  "The per-GPU evaluation batch size must be a multiple of "
+                  "HCTR_RANKING_QUERY_SIZE so that queries do not straddle batches.");
+  top_k_ = [] {
+    const char* env = std::getenv("HCTR_NDCG_K");
+    int top_k = (env != nullptr) ? std::atoi(env) : 0;
+    return top_k > 0 ? top_k : 10;
+  }();
+
+  accum_.resize(num_local_gpus_);
+  for (int local_id = 0; local_id < num_local_gpus_; local_id++) {
+    int device_id = resource_manager_->get_local_gpu(local_id)->get_device_id();
+    CudaDeviceContext context(device_id);
+    core23::TensorParams tensor_params =
+        core23::TensorParams()
+            .device(core23::Device(core23::DeviceType::GPU, device_id))
+            .data_type(core23::ScalarType::Float)
+            .shape(core23::Shape({2}));
+    accum_[local_id] = core23::Tensor(tensor_params);
+    HCTR_LIB_THROW(cudaMemset(accum_[local_id].data(), 0, accum_[local_id].num_bytes()));
+  }
+}
+
+template <typename T>
+PerQueryRanking<T>::~PerQueryRanking() {}
+
+// One block per query. Every candidate's rank is the number of candidates with a higher
+// score (ties broken by index), computed by an O(query_size^2) scan over shared memory;
+// with the list lengths these metrics target this is cheaper than a per-query sort.
+template <typename T>
+__global__ void per_query_ranking_kernel(const T* preds, const float* labels, int num_queries,
+                                         int query_size, int top_k, bool mrr, float* accum) {
+  extern __shared__ float smem[];
+  float* s_scores = smem;
+  float* s_labels = smem + query_size;
+  __shared__ float s_dcg;
+  __shared__ float s_idcg;
+  __shared__ int s_best_rank;
+
+  for (int query = blockIdx.x; query < num_queries; query += gridDim.x) {
+    const T* query_preds = preds + static_cast<size_t>(query) * query_size;
+    const float* query_labels = labels + static_cast<size_t>(query) * query_size;
+    for (int i = threadIdx.x; i < query_size; i += blockDim.x) {
+      s_scores[i] = static_cast<float>(query_preds[i]);
+      s_labels[i] = query_labels[i];
+    }
+    if (threadIdx.x == 0) {
+      s_dcg = 0.0f;
+      s_idcg = 0.0f;
+      s_best_rank = query_size;
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < query_size; i += blockDim.x) {
+      const float score = s_scores[i];
+      const float label = s_labels[i];
+      int rank = 0;
+      int label_rank = 0;
+      for (int j = 0; j < query_size; j++) {
+        rank += (s_scores[j] > score) || (s_scores[j] == score && j < i);
+        label_rank += (s_labels[j] > label) || (s_labels[j] == label && j < i);
+      }
+      if (label > 0.0f) {
+        const float gain = exp2f(label) - 1.0f;
+        if (rank < top_k) {
+          atomicAdd(&s_dcg, gain / log2f(rank + 2.0f));
+        }
+        // The label ranks are a permutation, so summing the gains at the label ranks is the
+        // DCG of the ideally ordered list.
+        if (label_rank < top_k) {
+          atomicAdd(&s_idcg, gain / log2f(label_rank + 2.0f));
+        }
+        atomicMin(&s_best_rank, rank);
+      }
+    }
+    __syncthreads();
+
+    if (threadIdx.x == 0) {
+      if (mrr) {
+        if (s_best_rank < query_size) {
+          atomicAdd(accum, 1.0f / (s_best_rank + 1.0f));
+          atomicAdd(accum + 1, 1.0f);
+        }
+      } else if (s_idcg > 0.0f) {
+        atomicAdd(accum, s_dcg / s_idcg);
+        atomicAdd(accum + 1, 1.0f);
+      }
+    }
+    __syncthreads();
+  }
+}
+
+template <typename T>
+void PerQueryRanking<T>::local_reduce(int local_gpu_id, Core23RawMetricMap raw_metrics) {
+  core23::Tensor pred_tensor = raw_metrics[RawType::Pred];
+  core23::Tensor label_tensor = raw_metrics[RawType::Label];
+  int device_id = resource_manager_->get_local_gpu(local_gpu_id)->get_device_id();
+  int global_device_id = resource_manager_->get_local_gpu(local_gpu_id)->get_global_id();
+
+  CudaDeviceContext context(device_id);
+  int num_valid_samples =
+      get_num_valid_samples(global_device_id, current_batch_size_, batch_size_per_gpu_);
+  int num_queries = num_valid_samples / query_size_;
+  if (num_queries <= 0) {
+    return;
+  }
+  auto stream = resource_manager_->get_local_gpu(local_gpu_id)->get_stream();
+  int num_sms = resource_manager_->get_local_gpu(local_gpu_id)->get_sm_count();
+
+  dim3 grid(std::min(num_queries, num_sms * 2), 1, 1);
+  dim3 block(128, 1, 1);
+  size_t smem_size = 2 * query_size_ * sizeof(float);
+  per_query_ranking_kernel<T><<<grid, block, smem_size, stream>>>(
+      pred_tensor.data<PredType>(), label_tensor.data<LabelType>(), num_queries, query_size_,
+      top_k_, kind_ == Kind::MRR, accum_[local_gpu_id].data<float>());
+}
+
+template <typename T>
+void PerQueryRanking<T>::global_reduce(int n_nets) {
+  // The per-GPU device counters already hold the running sums; they are merged once in
+  // finalize_metric().
+  n_batches_++;
+}
+
+template <typename T>
+float PerQueryRanking<T>::finalize_metric() {
+  float h_accum[2] = {0.0f, 0.0f};
+
+#pragma omp parallel num_threads(num_local_gpus_)
+  {
+    int local_id = omp_get_thread_num();
+    auto gpu_resource = resource_manager_->get_local_gpu(local_id).get();
+    CudaDeviceContext context(gpu_resource->get_device_id());
+    auto stream = gpu_resource->get_stream();
+
+    float* accum = accum_[local_id].data<float>();
+    metric_comm::allreduce(accum, accum, 2, gpu_resource, stream);
+
+    if (local_id == 0) {
+      HCTR_LIB_THROW(
+          cudaMemcpyAsync(h_accum, accum, 2 * sizeof(float), cudaMemcpyDeviceToHost, stream));
+    }
+    HCTR_LIB_THROW(cudaStreamSynchronize(stream));
+
+    // reset for the next evaluation phase
+    HCTR_LIB_THROW(cudaMemsetAsync(accum, 0, accum_[local_id].num_bytes(), stream));
+  }
+
+  n_batches_ = 0;
+  return h_accum[1] > 0.0f ? h_accum[0] / h_accum[1] : 0.0f;
+}
+
 __global__ void scale_labels_kernel(float* labels, float* scaled_labels, size_t offset,
                                     size_t num_samples) {
   size_t base = blockIdx.x * blockDim.x + threadIdx.x;
@@ -2148,6 +2513,10 @@ void ReallocBuffer<T, U>::release_mmap_memory() {
 template class AverageLoss<float>;
 template class AUC<float>;
 template class AUC<__half>;
+template class StreamingAUC<float>;
+template class StreamingAUC<__half>;
+template class PerQueryRanking<float>;
+template class PerQueryRanking<__half>;
 template class HitRate<float>;
 
 }  // namespace metrics
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <optimizer.hpp>
 #include <optimizers/adagrad_optimizer.hpp>
 #include <optimizers/adam_optimizer.hpp>
@@ -25,6 +27,26 @@
 
 namespace HugeCTR {
 
+bool Optimizer::zero1_dense_enabled() {
+  static const bool enabled = [] {
+    const char* env = std::getenv("HCTR_ZERO1_DENSE");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return enabled;
+}
+
+std::pair<int64_t, int64_t> Optimizer::zero1_shard_range(int64_t num_elements) const {
+  int num_ranks = 1;
+  int rank = 0;
+  HCTR_LIB_THROW(ncclCommCount(gpu_resource_->get_nccl(), &num_ranks));
+  HCTR_LIB_THROW(ncclCommUserRank(gpu_resource_->get_nccl(), &rank));
+
+  const int64_t shard_len = (num_elements + num_ranks - 1) / num_ranks;
+  const int64_t start = std::min(static_cast<int64_t>(rank) * shard_len, num_elements);
+  const int64_t count = std::min(shard_len, num_elements - start);
+  return {start, count};
+}
+
 OptParamsPy::OptParamsPy() : initialized(false) {}
 
 OptParamsPy::OptParamsPy(Optimizer_t optimizer_type, Update_t update_t,
@@ -17,6 +17,7 @@
 #include <core23/data_type.hpp>
 #include <general_buffer2.hpp>
 #include <optimizers/adam_optimizer.hpp>
+#include <tuple>
 #include <utils.cuh>
 #include <utils.hpp>
 
@@ -53,11 +54,17 @@ AdamOptimizer<T>::AdamOptimizer(std::optional<WeightTensors> weight_tensors,
       beta1_(beta1),
       beta2_(beta2),
       epsilon_(epsilon) {
+  // with ZeRO-1 sharding this rank only keeps m/v for its shard of the weights
+  int64_t state_len = weight_tensors_->flatten().size(0);
+  if (zero1_dense_enabled()) {
+    state_len = zero1_shard_range(state_len).second;
+  }
+
   core23::TensorParams tensor_params =
       core23::TensorParams()
           .device(core23::Device(core23::DeviceType::GPU, gpu_resource->get_device_id()))
           .data_type(core23::ScalarType::Float)
-          .shape(core23::Shape({weight_tensors_->flatten().size(0)}))
+          .shape(core23::Shape({state_len}))
           .buffer_channel(GetOptStateBufferChannnel());
 
   m_tensor_ = core23::Tensor(tensor_params);
@@ -86,14 +93,21 @@ void AdamOptimizer<T>::update() {
   float* weight = flat_weight_tensor.data();
   const T* wgrad = flat_wgrad_tensor.data();
 
-  auto len = flat_weight_tensor.size(0);
+  int64_t len = flat_weight_tensor.size(0);
+  int64_t start = 0;
+  if (weights_sharded()) {
+    std::tie(start, len) = zero1_shard_range(len);
+    if (len == 0) {
+      return;
+    }
+  }
   const size_t grid_dim = (len - 1) / block_dim + 1;
 
   float* m = m_tensor_.data<float>();
   float* v = v_tensor_.data<float>();
 
   adam_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-      len, weight, m, v, wgrad, alpha_t, beta1_, beta2_, epsilon_, scaler_);
+      len, weight + start, m, v, wgrad + start, alpha_t, beta1_, beta2_, epsilon_, scaler_);
 }
 
 template class AdamOptimizer<float>;
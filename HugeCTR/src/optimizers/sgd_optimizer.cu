@@ -95,7 +95,14 @@ __device__ inline void sgd_update_device(int len, float* weight, __half* weight_
 
 template <typename T>
 __global__ void sgd_update_kernel(int len, float* weight, __half* weight_half, const T* wgrad,
-                                  float lr, float scaler, bool use_mixed_precision) {
+                                  float lr, float scaler, bool use_mixed_precision,
+                                  const float* unscale_ptr, const int* skip_step_ptr) {
+  if (skip_step_ptr != nullptr && *skip_step_ptr != 0) {
+    return;
+  }
+  if (unscale_ptr != nullptr) {
+    scaler = *unscale_ptr;
+  }
   if (true == use_mixed_precision) {
     sgd_update_device(len, weight, weight_half, wgrad, lr, scaler);
   } else {
@@ -103,13 +110,20 @@ __global__ void sgd_update_kernel(int len, float* weight, __half* weight_half, c
   }
 }
 
+// Scheduler-driven variant: both the learning rate and the loss scale are read from the
+// scheduler's device buffers, so the launch carries no per-iteration host scalar and can
+// be replayed from a captured graph.
 template <typename T>
 __global__ void sgd_update_kernel(int len, float* weight, __half* weight_half, const T* wgrad,
-                                  const float* lr_ptr, float scaler, bool use_mixed_precision) {
+                                  const float* lr_ptr, const float* scale_ptr,
+                                  bool use_mixed_precision, const int* skip_step_ptr) {
+  if (skip_step_ptr != nullptr && *skip_step_ptr != 0) {
+    return;
+  }
   if (true == use_mixed_precision) {
-    sgd_update_device(len, weight, weight_half, wgrad, *lr_ptr, scaler);
+    sgd_update_device(len, weight, weight_half, wgrad, *lr_ptr, *scale_ptr);
   } else {
-    sgd_update_device(len, weight, wgrad, *lr_ptr, scaler);
+    sgd_update_device(len, weight, wgrad, *lr_ptr, *scale_ptr);
   }
 }
 
@@ -145,11 +159,16 @@ void SGDOptimizer<T>::update() {
   const size_t grid_dim = (len + block_dim * vec_width - 1) / (block_dim * vec_width);
   if (gpu_learning_rate_scheduler_ == nullptr) {
     sgd_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-        len, weight, weight_half, wgrad, lr_, scaler_, use_mixed_precision_);
+        len, weight, weight_half, wgrad, lr_, scaler_, use_mixed_precision_, dynamic_unscale_ptr_,
+        skip_step_ptr_);
   } else {
     float* lr_ptr = gpu_learning_rate_scheduler_->get_learning_rate();
+    // The dynamic loss-scale guard supersedes the scheduler's static scale.
+    const float* scale_ptr = dynamic_unscale_ptr_ != nullptr
+                                 ? dynamic_unscale_ptr_
+                                 : gpu_learning_rate_scheduler_->get_loss_scale();
     sgd_update_kernel<<<grid_dim, block_dim, 0, gpu_resource_->get_stream()>>>(
-        len, weight, weight_half, wgrad, lr_ptr, scaler_, use_mixed_precision_);
+        len, weight, weight_half, wgrad, lr_ptr, scale_ptr, use_mixed_precision_, skip_step_ptr_);
   }
 }
 
@@ -123,11 +123,25 @@ GpuLearningRateSchedulers get_gpu_learning_rate_schedulers(
   auto decay_power = get_value_from_json_soft<float>(j_hparam, "decay_power", 2.f);
   auto end_lr = get_value_from_json_soft<float>(j_hparam, "end_lr", 0.f);
 
+  // "mixed_precision" in the solver clause carries the loss scaler value
+  bool mixed_precision = false;
+  float scaler = 1.f;
+  if (has_key_(config, "solver")) {
+    auto j_solver = get_json(config, "solver");
+    if (has_key_(j_solver, "mixed_precision")) {
+      mixed_precision = true;
+      scaler = get_value_from_json<float>(j_solver, "mixed_precision");
+    }
+  }
+
   GpuLearningRateSchedulers lr_scheds;
   for (size_t i = 0; i < resource_manager->get_local_gpu_count(); i++) {
     auto& gpu_resource = resource_manager->get_local_gpu(i);
     lr_scheds.emplace_back(new GpuLearningRateScheduler(
         base_lr, warmup_steps, decay_start, decay_steps, decay_power, end_lr, gpu_resource));
+    if (mixed_precision) {
+      lr_scheds.back()->set_loss_scale(scaler);
+    }
   }
 
   return lr_scheds;
@@ -16,10 +16,29 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrome_trace.hpp>
+#include <core23/macros.hpp>
+#include <cstdlib>
+#include <numeric>
 #include <pipeline.hpp>
 
 namespace HugeCTR {
 
+namespace {
+
+bool pipeline_trace_enabled() {
+  static const bool enabled = [] {
+    const char* const env = std::getenv("HCTR_PIPELINE_TRACE");
+    return env != nullptr && 1 == std::atoi(env);
+  }();
+  return enabled;
+}
+
+constexpr size_t TRACE_RING_CAPACITY = 1024;
+
+}  // namespace
+
 StreamContextScheduleable::StreamContextScheduleable(std::function<void()> workload)
     : stream_name_(std::nullopt),
       priority_(0),
@@ -34,6 +53,40 @@ StreamContextScheduleable::~StreamContextScheduleable() {
   if (completion_event_) {
     cudaEventDestroy(completion_event_.value());
   }
+  if (trace_start_) {
+    cudaEventDestroy(trace_start_);
+  }
+  if (trace_stop_) {
+    cudaEventDestroy(trace_stop_);
+  }
+}
+
+void StreamContextScheduleable::enable_trace() {
+  if (trace_enabled_) return;
+  HCTR_LIB_THROW(cudaEventCreate(&trace_start_));
+  HCTR_LIB_THROW(cudaEventCreate(&trace_stop_));
+  trace_enabled_ = true;
+}
+
+bool StreamContextScheduleable::trace_elapsed_ms(float& ms) {
+  if (!trace_recorded_) {
+    return false;
+  }
+  if (cudaEventQuery(trace_stop_) != cudaSuccess) {
+    return false;
+  }
+  HCTR_LIB_THROW(cudaEventElapsedTime(&ms, trace_start_, trace_stop_));
+  return true;
+}
+
+bool StreamContextScheduleable::trace_window_ms(cudaEvent_t origin, float& begin_ms,
+                                                float& end_ms) {
+  if (!trace_recorded_ || cudaEventQuery(trace_stop_) != cudaSuccess) {
+    return false;
+  }
+  HCTR_LIB_THROW(cudaEventElapsedTime(&begin_ms, origin, trace_start_));
+  HCTR_LIB_THROW(cudaEventElapsedTime(&end_ms, origin, trace_stop_));
+  return true;
 }
 
 void StreamContextScheduleable::set_absolute_stream(const std::string &stream_name, int priority) {
@@ -80,7 +133,7 @@ void StreamContextScheduleable::init(std::shared_ptr<GPUResource> gpu) {
   StreamContext stream_context{gpu, current_stream_name, priority};
 }
 
-void StreamContextScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_graph) {
+void StreamContextScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_graph, size_t) {
   CudaDeviceContext context{gpu->get_device_id()};
 
   auto [current_stream_name, priority] = get_stream_name(gpu);
@@ -93,19 +146,26 @@ void StreamContextScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_g
           wait_external_ && use_graph ? cudaEventWaitExternal : cudaEventWaitDefault));
     }
   }
+  if (trace_enabled_ && !use_graph) {
+    HCTR_LIB_THROW(cudaEventRecord(trace_start_, stream));
+  }
   if (workload_) workload_();
   if (completion_event_.has_value()) {
     HCTR_LIB_THROW(cudaEventRecordWithFlags(
         completion_event_.value(), stream,
         record_external_ && use_graph ? cudaEventRecordExternal : cudaEventRecordDefault));
   }
+  if (trace_enabled_ && !use_graph) {
+    HCTR_LIB_THROW(cudaEventRecord(trace_stop_, stream));
+    trace_recorded_ = true;
+  }
 }
 
-void GraphScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_graph) {
+void GraphScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_graph, size_t graph_key) {
   if (scheduleable_list_.empty()) return;
   auto do_it = [=](cudaStream_t) {
     for (auto &scheduleable : scheduleable_list_) {
-      scheduleable->run(gpu, use_graph);
+      scheduleable->run(gpu, use_graph, graph_key);
     }
   };
   auto first_node = std::dynamic_pointer_cast<StreamContextScheduleable>(scheduleable_list_[0]);
@@ -117,15 +177,15 @@ void GraphScheduleable::run(std::shared_ptr<GPUResource> gpu, bool use_graph) {
     do_it(stream);
     return;
   }
-  if (!graph_.initialized) {
-    graph_.capture(do_it, stream);
+  if (!graph_.captured(graph_key)) {
+    graph_.capture(graph_key, do_it, stream);
 #ifdef ENABLE_MPI
 #pragma omp master
     MPI_Barrier(MPI_COMM_WORLD);
 #endif
 #pragma omp barrier
   }
-  graph_.exec(stream);
+  graph_.exec(graph_key, stream);
 }
 
 Pipeline::Pipeline(const std::string &stream_name, std::shared_ptr<GPUResource> gpu_resource,
@@ -137,19 +197,117 @@ Pipeline::Pipeline(const std::string &stream_name, std::shared_ptr<GPUResource>
   for (auto &scheduleable : scheduleable_list_) {
     scheduleable->init(gpu_resource_);
   }
+
+  if (pipeline_trace_enabled()) {
+    // flatten one level: the model pipelines wrap their stages in a single GraphScheduleable
+    auto collect = [&](const std::shared_ptr<Scheduleable> &scheduleable) {
+      if (auto stage = std::dynamic_pointer_cast<StreamContextScheduleable>(scheduleable)) {
+        stage->enable_trace();
+        traced_stages_.push_back(stage.get());
+      }
+    };
+    for (auto &scheduleable : scheduleable_list_) {
+      if (auto graph = std::dynamic_pointer_cast<GraphScheduleable>(scheduleable)) {
+        for (auto &inner : graph->get_scheduleable_list()) {
+          collect(inner);
+        }
+      } else {
+        collect(scheduleable);
+      }
+    }
+  }
+}
+
+void Pipeline::harvest_trace() {
+  std::vector<float> durations(traced_stages_.size());
+  for (size_t i = 0; i < traced_stages_.size(); i++) {
+    if (!traced_stages_[i]->trace_elapsed_ms(durations[i])) {
+      // first iteration or the stage is still in flight: drop the sample
+      return;
+    }
+  }
+  // feed the unified Chrome trace: place each stage window on the wall clock via the
+  // host anchor captured when this iteration was launched
+  if (ChromeTraceRecorder::enabled() && trace_anchor_us_ != 0) {
+    const cudaEvent_t origin = traced_stages_[0]->trace_start_event();
+    const int device_id = gpu_resource_->get_device_id();
+    for (StreamContextScheduleable* stage : traced_stages_) {
+      float begin_ms, end_ms;
+      if (!stage->trace_window_ms(origin, begin_ms, end_ms)) continue;
+      // parallel streams can start marginally before the origin event
+      begin_ms = std::max(begin_ms, 0.f);
+      end_ms = std::max(end_ms, begin_ms);
+      const auto begin_us = trace_anchor_us_ + static_cast<uint64_t>(begin_ms * 1000.f);
+      const auto dur_us = static_cast<uint64_t>((end_ms - begin_ms) * 1000.f);
+      ChromeTraceRecorder::instance().record(stage->trace_label(), "pipeline", device_id,
+                                             stream_name_ + "/" + stage->trace_label(), begin_us,
+                                             dur_us);
+    }
+  }
+
+  if (trace_ring_.size() < TRACE_RING_CAPACITY) {
+    trace_ring_.push_back(std::move(durations));
+    trace_ring_iters_.push_back(trace_count_);
+  } else {
+    const size_t slot = trace_count_ % TRACE_RING_CAPACITY;
+    trace_ring_[slot] = std::move(durations);
+    trace_ring_iters_[slot] = trace_count_;
+  }
+  trace_count_++;
 }
 
 void Pipeline::run() {
+  HCTR_NVTX_RANGE("pipeline::run");
   StreamContext stream_context(gpu_resource_, stream_name_);
+  if (!traced_stages_.empty()) {
+    // read out the previous iteration's events before they are re-recorded below
+    harvest_trace();
+    trace_anchor_us_ = ChromeTraceRecorder::now_us();
+  }
   for (auto &scheduleable : scheduleable_list_) {
     scheduleable->run(gpu_resource_, false);
   }
 }
 
-void Pipeline::run_graph() {
+void Pipeline::run_graph(size_t graph_key) {
+  HCTR_NVTX_RANGE("pipeline::run_graph");
   StreamContext stream_context(gpu_resource_, stream_name_);
   for (auto &scheduleable : scheduleable_list_) {
-    scheduleable->run(gpu_resource_, true);
+    scheduleable->run(gpu_resource_, true, graph_key);
+  }
+}
+
+void Pipeline::dump_trace() const {
+  if (trace_ring_.empty()) {
+    return;
+  }
+  const size_t num_samples = trace_ring_.size();
+
+  std::vector<float> totals(num_samples);
+  for (size_t i = 0; i < num_samples; i++) {
+    totals[i] = std::accumulate(trace_ring_[i].begin(), trace_ring_[i].end(), 0.f);
+  }
+  std::vector<size_t> order(num_samples);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return totals[a] > totals[b]; });
+
+  std::vector<float> sorted_totals = totals;
+  std::nth_element(sorted_totals.begin(), sorted_totals.begin() + num_samples / 2,
+                   sorted_totals.end());
+  const float median_total = sorted_totals[num_samples / 2];
+
+  const size_t num_outliers = std::max<size_t>(1, num_samples / 100);
+  auto log = HCTR_LOG_S(INFO, WORLD);
+  log << "Pipeline trace [device " << gpu_resource_->get_device_id() << ", stream '" << stream_name_
+      << "']: " << num_samples << " sampled iterations, median " << median_total
+      << " ms; worst " << num_outliers << ":" << std::endl;
+  for (size_t k = 0; k < num_outliers; k++) {
+    const size_t i = order[k];
+    log << "  iter " << trace_ring_iters_[i] << ": " << totals[i] << " ms |";
+    for (size_t s = 0; s < traced_stages_.size(); s++) {
+      log << " " << s << ":" << traced_stages_[s]->trace_label() << "=" << trace_ring_[i][s];
+    }
+    log << std::endl;
   }
 }
 
@@ -871,7 +871,91 @@ struct InputOutputInfo {
   std::vector<std::string> output_names;
 };
 
+// Opt-in (HCTR_EBC_LAYOUT_NEGOTIATION=1) layout negotiation between the embedding
+// collection output and its first dense consumer. When a Concat layer gathers
+// exactly the collection's per-lookup outputs in declaration order, the
+// concatenated result is byte-identical to the collection's contiguous output
+// buffer written batch-major, so the collection is flipped to BatchMajor and the
+// Concat top is bound directly onto that buffer instead of running a full
+// permute copy (and its backward scatter) every iteration. The per-lookup
+// feature-major views become stale after the flip, which is why every one of
+// them must have the Concat as its only consumer.
+void Model::negotiate_ebc_output_layout(std::vector<DenseLayer>& dense_layers) {
+  const char* env = std::getenv("HCTR_EBC_LAYOUT_NEGOTIATION");
+  if (env == nullptr || std::atoi(env) == 0) {
+    return;
+  }
+  // train_ebc_outptut_ is indexed per local gpu, which presumes a single collection
+  if (ebc_list_.size() != 1 || ebc_top_name_lists_.size() != 1 ||
+      ebc_top_name_lists_[0].empty()) {
+    return;
+  }
+  const std::vector<std::string>& ebc_top_names = ebc_top_name_lists_[0];
+
+  std::map<std::string, int> consumer_counts;
+  for (const auto& dense_layer : dense_layers) {
+    for (const auto& name : dense_layer.bottom_names) {
+      consumer_counts[name]++;
+    }
+  }
+
+  for (auto it = dense_layers.begin(); it != dense_layers.end(); ++it) {
+    if (it->layer_type != Layer_t::Concat || it->top_names.size() != 1 ||
+        it->bottom_names != ebc_top_names) {
+      continue;
+    }
+    bool sole_consumer = true;
+    for (const auto& bottom_name : it->bottom_names) {
+      sole_consumer = sole_consumer && (consumer_counts[bottom_name] == 1);
+    }
+    if (!sole_consumer) {
+      return;
+    }
+    const std::string top_name = it->top_names[0];
+
+    ebc_list_[0]->set_output_layout(embedding::EmbeddingLayout::BatchMajor);
+
+    // Bind the Concat top onto the contiguous output buffer on every gpu. The
+    // raw shape holds the global batch size; per-gpu tensors hold the local share.
+    const std::vector<int>& raw_shape = tensor_shape_info_raw_[top_name];
+    size_t num_total_gpus = resource_manager_->get_global_gpu_count();
+    int num_local_gpus = resource_manager_->get_local_gpu_count();
+    auto bind_output = [&](std::vector<core23::Tensor>& ebc_output,
+                           std::vector<std::vector<TensorEntity>>& tensor_entries_list,
+                           int64_t batch_size_per_gpu) {
+      for (int local_gpu_id = 0; local_gpu_id < num_local_gpus; ++local_gpu_id) {
+        const core23::Tensor& output = ebc_output[local_gpu_id];
+        std::vector<int64_t> dims{batch_size_per_gpu};
+        for (size_t dim = 1; dim < raw_shape.size(); ++dim) {
+          dims.push_back(raw_shape[dim]);
+        }
+        core23::Tensor top_tensor = core23::Tensor::bind(
+            output.data(), core23::Shape(dims), output.data_type(), output.device());
+        tensor_entries_list[local_gpu_id].push_back({top_name, top_tensor});
+      }
+    };
+    bind_output(train_ebc_outptut_, train_tensor_entities_list_,
+                solver_.batchsize / num_total_gpus);
+    bind_output(evaluate_ebc_outptut_, evaluate_tensor_entities_list_,
+                solver_.batchsize_eval / num_total_gpus);
+
+    // graph bookkeeping the elided layer would otherwise have done
+    for (const auto& bottom_name : it->bottom_names) {
+      deactivate_tensor(tensor_active_, bottom_name);
+    }
+    activate_tensor(tensor_active_, top_name);
+    embedding_dependent_tensors_.insert(top_name);
+
+    HCTR_LOG_S(INFO, ROOT) << "Negotiated batch-major embedding collection output for " << top_name
+                           << ", eliding its Concat layer" << std::endl;
+    dense_layers.erase(it);
+    return;
+  }
+}
+
 void Model::add_dense_layers(std::vector<DenseLayer>& dense_layers) {
+  negotiate_ebc_output_layout(dense_layers);
+  fuse_dense_layer_patterns(dense_layers, solver_.use_mixed_precision);
   auto add_dense_layers_op = [&dense_layers, this](bool is_train) {
     size_t num_local_gpus = resource_manager_->get_local_gpu_count();
     std::vector<std::vector<std::unique_ptr<Layer>>> layers(num_local_gpus);
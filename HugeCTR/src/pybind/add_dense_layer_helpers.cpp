@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <core23/data_type.hpp>
 #include <core23/tensor.hpp>
 #include <core23_wrapper.hpp>
+#include <cstdlib>
 #include <layer.hpp>
 #include <layers/add_layer.hpp>
 #include <layers/batch_norm_layer.hpp>
@@ -53,11 +55,13 @@
 #include <layers/softmax_layer.hpp>
 #include <layers/sub_layer.hpp>
 #include <layers/weight_multiply_layer.hpp>
+#include <map>
 #include <network_buffer_channels.hpp>
 #include <parser.hpp>
 #include <pybind/add_dense_layer_helpers.hpp>
 #include <pybind/model.hpp>
 #include <regularizer_factory.hpp>
+#include <set>
 namespace HugeCTR {
 
 namespace {
@@ -100,6 +104,199 @@ std::optional<core23::Tensor> get_tensor_from_entities(
   return {};
 }
 
+void fuse_dense_layer_patterns(std::vector<DenseLayer>& dense_layers, bool use_mixed_precision) {
+  const char* env = std::getenv("HCTR_DENSE_FUSION");
+  if (env == nullptr || std::atoi(env) == 0) {
+    return;
+  }
+
+  // A tensor may only be fused away if exactly one layer consumes it.
+  auto count_consumers = [&dense_layers]() {
+    std::map<std::string, int> counts;
+    for (const auto& dense_layer : dense_layers) {
+      for (const auto& name : dense_layer.bottom_names) {
+        counts[name]++;
+      }
+    }
+    return counts;
+  };
+  std::map<std::string, int> consumer_counts = count_consumers();
+
+  // Collapse maximal InnerProduct[+ReLU][+Dropout] chains into a single MLP block, so the
+  // FC+bias+ReLU sequence runs through MLPLayer's fused cublasLt epilogues and any interior
+  // dropout runs as MLPLayer's in-place counter-based pass instead of discrete layers.
+  std::vector<DenseLayer> fused;
+  size_t i = 0;
+  while (i < dense_layers.size()) {
+    const auto& head = dense_layers[i];
+    if (head.layer_type != Layer_t::InnerProduct || head.bottom_names.size() != 1 ||
+        head.top_names.size() != 1) {
+      fused.push_back(head);
+      i++;
+      continue;
+    }
+
+    std::vector<size_t> num_outputs{head.num_output};
+    std::vector<Activation_t> acts{Activation_t::None};
+    std::vector<float> dropout_rates{0.f};
+    bool act_slot_open = true;
+    size_t last_index = i;
+    std::string current_top = head.top_names[0];
+    for (size_t j = i + 1; j < dense_layers.size(); j++) {
+      const auto& next = dense_layers[j];
+      if (next.bottom_names.size() != 1 || next.top_names.size() != 1 ||
+          next.bottom_names[0] != current_top || consumer_counts[current_top] != 1) {
+        break;
+      }
+      if (next.layer_type == Layer_t::ReLU && act_slot_open) {
+        acts.back() = Activation_t::Relu;
+        act_slot_open = false;
+      } else if (next.layer_type == Layer_t::Dropout && next.dropout_rate > 0.f &&
+                 next.dropout_rate < 1.f && dropout_rates.back() == 0.f &&
+                 j + 1 < dense_layers.size() &&
+                 dense_layers[j + 1].layer_type == Layer_t::InnerProduct &&
+                 dense_layers[j + 1].bottom_names.size() == 1 &&
+                 dense_layers[j + 1].bottom_names[0] == next.top_names[0] &&
+                 consumer_counts[next.top_names[0]] == 1) {
+        // Interior dropout only: the next InnerProduct must continue the chain, or the
+        // dropout would be silently lost when the chain ends here.
+        dropout_rates.back() = next.dropout_rate;
+        act_slot_open = false;
+      } else if (next.layer_type == Layer_t::InnerProduct) {
+        num_outputs.push_back(next.num_output);
+        acts.push_back(Activation_t::None);
+        dropout_rates.push_back(0.f);
+        act_slot_open = true;
+      } else {
+        break;
+      }
+      current_top = next.top_names[0];
+      last_index = j;
+    }
+
+    if (num_outputs.size() < 2) {
+      fused.push_back(head);
+      i++;
+      continue;
+    }
+
+    DenseLayer mlp = head;
+    mlp.layer_type = Layer_t::MLP;
+    mlp.top_names = dense_layers[last_index].top_names;
+    mlp.num_outputs = num_outputs;
+    mlp.acts = acts;
+    mlp.use_bias = true;
+    mlp.biases.assign(num_outputs.size(), true);
+    if (std::any_of(dropout_rates.begin(), dropout_rates.end(), [](float r) { return r > 0.f; })) {
+      mlp.mlp_dropout_rates = dropout_rates;
+    }
+    for (size_t j = i + 1; j <= last_index; j++) {
+      mlp.compute_config.async_wgrad =
+          mlp.compute_config.async_wgrad || dense_layers[j].compute_config.async_wgrad;
+      mlp.compute_config.fuse_wb =
+          mlp.compute_config.fuse_wb || dense_layers[j].compute_config.fuse_wb;
+    }
+    HCTR_LOG_S(INFO, ROOT) << "Fused " << (last_index - i + 1) << " dense layers ending at "
+                           << mlp.top_names[0] << " into an MLP block" << std::endl;
+    fused.push_back(mlp);
+    i = last_index + 1;
+  }
+  dense_layers = std::move(fused);
+
+  // At a DCNv2 cross <-> MLP boundary, overlap the weight-gradient GEMMs of both sides and let
+  // the MLP side fuse its weight and bias gradients into the cublasLt epilogue, so the boundary
+  // stops serializing the two fused blocks during bprop.
+  for (size_t j = 0; j + 1 < dense_layers.size(); j++) {
+    auto& upper = dense_layers[j];
+    auto& lower = dense_layers[j + 1];
+    const bool cross_to_mlp = upper.layer_type == Layer_t::MultiCross &&
+                              upper.projection_dim > 0 && lower.layer_type == Layer_t::MLP;
+    const bool mlp_to_cross = upper.layer_type == Layer_t::MLP &&
+                              lower.layer_type == Layer_t::MultiCross && lower.projection_dim > 0;
+    if ((cross_to_mlp || mlp_to_cross) && !upper.top_names.empty() &&
+        !lower.bottom_names.empty() && upper.top_names[0] == lower.bottom_names[0]) {
+      upper.compute_config.async_wgrad = true;
+      lower.compute_config.async_wgrad = true;
+      (cross_to_mlp ? lower : upper).compute_config.fuse_wb = true;
+    }
+  }
+
+  // Back-to-back Reshape layers: ReshapeLayerV2's fprop is a full-tensor memcpy, and only the
+  // final shape is observable, so the earlier copy can be dropped outright. The selected form
+  // gathers a slot subset and is left alone.
+  consumer_counts = count_consumers();
+  for (size_t j = 0; j + 1 < dense_layers.size();) {
+    auto& first = dense_layers[j];
+    auto& second = dense_layers[j + 1];
+    if (first.layer_type == Layer_t::Reshape && second.layer_type == Layer_t::Reshape &&
+        !first.selected && !second.selected && first.top_names.size() == 1 &&
+        second.bottom_names.size() == 1 && second.bottom_names[0] == first.top_names[0] &&
+        consumer_counts[first.top_names[0]] == 1) {
+      second.bottom_names = first.bottom_names;
+      dense_layers.erase(dense_layers.begin() + j);
+      consumer_counts = count_consumers();
+    } else {
+      j++;
+    }
+  }
+
+  // A fan-in of flattening Reshape layers ([batch, slots, width] -> [batch * slots, width])
+  // feeding one Concat is one copy per input plus a gather; FusedReshapeConcatGeneral performs
+  // the same flatten-and-concat as a single gather straight from the 3D inputs. It validates
+  // the input shapes at build time, and only has a float instantiation.
+  if (!use_mixed_precision) {
+    consumer_counts = count_consumers();
+    std::map<std::string, size_t> reshape_by_top;
+    for (size_t j = 0; j < dense_layers.size(); j++) {
+      const auto& dl = dense_layers[j];
+      if (dl.layer_type == Layer_t::Reshape && !dl.selected && dl.bottom_names.size() == 1 &&
+          dl.top_names.size() == 1) {
+        const bool flattens =
+            (dl.reshape_out_dimension.size() == 2 && dl.reshape_out_dimension[0] < 0) ||
+            (dl.leading_dim > 0 && dl.time_step == 0);
+        if (flattens) {
+          reshape_by_top[dl.top_names[0]] = j;
+        }
+      }
+    }
+    std::set<size_t> dead;
+    for (size_t j = 0; j < dense_layers.size(); j++) {
+      auto& concat = dense_layers[j];
+      if (concat.layer_type != Layer_t::Concat || concat.bottom_names.size() < 2) {
+        continue;
+      }
+      bool all_fusable = true;
+      for (const auto& name : concat.bottom_names) {
+        all_fusable = all_fusable && reshape_by_top.count(name) != 0 &&
+                      consumer_counts[name] == 1 && dead.count(reshape_by_top[name]) == 0;
+      }
+      if (!all_fusable) {
+        continue;
+      }
+      std::vector<std::string> raw_bottoms;
+      for (const auto& name : concat.bottom_names) {
+        raw_bottoms.push_back(dense_layers[reshape_by_top[name]].bottom_names[0]);
+        dead.insert(reshape_by_top[name]);
+      }
+      HCTR_LOG_S(INFO, ROOT) << "Fused " << concat.bottom_names.size()
+                             << " Reshape layers and a Concat into FusedReshapeConcatGeneral "
+                                "ending at "
+                             << concat.top_names[0] << std::endl;
+      concat.layer_type = Layer_t::FusedReshapeConcatGeneral;
+      concat.bottom_names = std::move(raw_bottoms);
+    }
+    if (!dead.empty()) {
+      std::vector<DenseLayer> rewritten;
+      for (size_t j = 0; j < dense_layers.size(); j++) {
+        if (dead.count(j) == 0) {
+          rewritten.push_back(dense_layers[j]);
+        }
+      }
+      dense_layers = std::move(rewritten);
+    }
+  }
+}
+
 InputTensorsAndOutputNames get_input_tensors_and_output_names(
     const std::vector<std::string>& bottom_names, const std::vector<std::string>& top_names,
     const std::vector<TensorEntity>& tensor_entities) {
@@ -374,12 +571,14 @@ void add_dense_layer_impl(DenseLayer& dense_layer, std::vector<TensorEntity>& te
         layers.emplace_back(new MLPLayer<__half>(
             in_tensors, train_out_tensors, num_outputs, gpu_resource, acts, biases,
             initializer_types, skip_dgrad, dense_layer.compute_config.async_wgrad,
-            dense_layer.compute_config.fuse_wb, enable_tf32_compute));
+            dense_layer.compute_config.fuse_wb, enable_tf32_compute,
+            dense_layer.mlp_dropout_rates));
       } else {
         layers.emplace_back(new MLPLayer<float>(
             in_tensors, train_out_tensors, num_outputs, gpu_resource, acts, biases,
             initializer_types, skip_dgrad, dense_layer.compute_config.async_wgrad,
-            dense_layer.compute_config.fuse_wb, enable_tf32_compute));
+            dense_layer.compute_config.fuse_wb, enable_tf32_compute,
+            dense_layer.mlp_dropout_rates));
       }
 
       if (output_size == 1) {
@@ -559,12 +758,23 @@ void add_dense_layer_impl(DenseLayer& dense_layer, std::vector<TensorEntity>& te
     }
     case Layer_t::ReLU: {
       auto& in_tensor = input_output_info.input_tensors[0];
-      core23::Tensor out_tensor(tensor_params.shape(in_tensor.shape()));
+      // HCTR_INPLACE_ACTIVATIONS=1: run ReLU in place on the input buffer and keep only a
+      // 1-bit sign mask for bprop, instead of a second full activation tensor. The input must
+      // not be read by any other layer after this one runs.
+      static const bool in_place_activations = [] {
+        const char* env = std::getenv("HCTR_INPLACE_ACTIVATIONS");
+        return env != nullptr && std::atoi(env) != 0;
+      }();
+      core23::Tensor out_tensor = in_place_activations
+                                      ? in_tensor
+                                      : core23::Tensor(tensor_params.shape(in_tensor.shape()));
       std::unique_ptr<Layer> layer;
       if (use_mixed_precision) {
-        layer.reset(new ReluLayer<__half>(in_tensor, out_tensor, gpu_resource));
+        layer.reset(
+            new ReluLayer<__half>(in_tensor, out_tensor, gpu_resource, in_place_activations));
       } else {
-        layer.reset(new ReluLayer<float>(in_tensor, out_tensor, gpu_resource));
+        layer.reset(
+            new ReluLayer<float>(in_tensor, out_tensor, gpu_resource, in_place_activations));
       }
       layers.emplace_back(std::move(layer));
       output_tensor_entities.push_back({input_output_info.output_names[0], out_tensor});
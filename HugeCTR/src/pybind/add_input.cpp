@@ -334,10 +334,23 @@ void add_input(Input& input, DataReaderParams& reader_params,
             source_data, reader_params.read_file_sequentially, slot_offset, repeat_dataset,
             parquet_source_max_row_group_size, parquet_dense_cols + parquet_label_cols,
             dense_dim + total_label_dim);
+        // HCTR_SHARDED_EVAL=1: shard the eval file list across ranks so every
+        // process reads only 1/N of the eval set instead of the whole thing; the
+        // metric partials the ranks produce are merged by the existing global
+        // NCCL reduction, so AUC and friends are unaffected. Needs repeat mode
+        // (ranks must never run out of batches at different times) and
+        // concurrent file consumption.
+        const bool shard_eval_files = std::getenv("HCTR_SHARDED_EVAL") != nullptr &&
+                                      resource_manager->get_num_process() > 1 && repeat_dataset &&
+                                      !reader_params.read_file_sequentially;
+        if (shard_eval_files) {
+          HCTR_LOG(INFO, ROOT, "Sharding the evaluation file list across %d processes\n",
+                   resource_manager->get_num_process());
+        }
         evaluate_data_reader->create_drwg_parquet(
             eval_source, reader_params.read_file_sequentially, slot_offset, repeat_dataset,
             parquet_eval_max_row_group_size, parquet_dense_cols + parquet_label_cols,
-            dense_dim + total_label_dim);
+            dense_dim + total_label_dim, shard_eval_files);
 #endif
         break;
       }
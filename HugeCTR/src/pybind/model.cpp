@@ -26,6 +26,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <network_buffer_channels.hpp>
 #include <pybind/model.hpp>
 #include <resource_managers/resource_manager_core.hpp>
@@ -285,6 +287,7 @@ void init_learning_rate_scheduler(std::shared_ptr<LearningRateScheduler>& lr_sch
     gpu_lr_sches.emplace_back(new GpuLearningRateScheduler(
         solver.lr, solver.warmup_steps, solver.decay_start, solver.decay_steps, solver.decay_power,
         solver.end_lr, gpu_resource));
+    gpu_lr_sches.back()->set_loss_scale(solver.use_mixed_precision ? solver.scaler : 1.f);
   }
 }
 
@@ -313,6 +316,62 @@ void init_exchange_wgrad(const std::shared_ptr<ResourceManager>& resource_manage
   }
 }
 
+// Hyperparameter sweeps construct one Model per trial inside the same process; recreating
+// the CUDA contexts, NCCL communicators, and per-GPU streams behind ResourceManagerCore
+// dominates each trial's startup. With HCTR_WARM_RESOURCE_POOL=1, fully initialized
+// resource managers are kept alive in a process-wide pool and handed to the next Model
+// constructed with the same device layout and seed, so only model-specific state (networks,
+// buffers, readers) is rebuilt. Entries are reference counted: a manager stays pooled as
+// long as its device layout keeps being requested, and is evicted once it is idle and a
+// different layout shows up. A fork-based warm server is not an option here because CUDA
+// contexts do not survive fork(); sweep drivers should loop trials in one process instead.
+static std::shared_ptr<ResourceManager> acquire_resource_manager(
+    const std::vector<std::vector<int>>& vvgpu, unsigned long long seed,
+    DeviceMap::Layout layout) {
+  static const bool warm_pool = [] {
+    const char* env = std::getenv("HCTR_WARM_RESOURCE_POOL");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  if (!warm_pool) {
+    return ResourceManagerCore::create(vvgpu, seed, layout);
+  }
+
+  static std::mutex pool_guard;
+  static std::map<std::string, std::shared_ptr<ResourceManager>> pool;
+
+  std::ostringstream key_stream;
+  key_stream << static_cast<int>(layout) << ':' << seed;
+  for (const auto& gpus : vvgpu) {
+    key_stream << '|';
+    for (int gpu : gpus) {
+      key_stream << gpu << ',';
+    }
+  }
+  const std::string key = key_stream.str();
+
+  const std::lock_guard lock(pool_guard);
+  auto pool_it = pool.find(key);
+  if (pool_it != pool.end()) {
+    HCTR_LOG(INFO, ROOT, "Reusing warm resource manager for this device layout\n");
+    return pool_it->second;
+  }
+  // The shared_ptr use count doubles as the reference count: an entry only the
+  // pool still references (use_count == 1) has no live Model, so evict it
+  // before building a manager for a new signature instead of letting stale
+  // layouts pin NCCL communicators and device memory for the whole process.
+  for (auto it = pool.begin(); it != pool.end();) {
+    if (it->second.use_count() == 1) {
+      HCTR_LOG(INFO, ROOT, "Evicting idle warm resource manager of a different device layout\n");
+      it = pool.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto resource_manager = ResourceManagerCore::create(vvgpu, seed, layout);
+  pool.emplace(key, resource_manager);
+  return resource_manager;
+}
+
 Model::Model(const Solver& solver, const DataReaderParams& reader_params,
              std::shared_ptr<OptParamsPy>& opt_params_py)
     : solver_(solver),
@@ -338,7 +397,7 @@ Model::Model(const Solver& solver, const DataReaderParams& reader_params,
   } else {
     HCTR_LOG(INFO, ROOT, "Initialize model: %s\n", solver_.model_name.c_str());
   }
-  resource_manager_ = ResourceManagerCore::create(solver.vvgpu, solver.seed, solver.device_layout);
+  resource_manager_ = acquire_resource_manager(solver.vvgpu, solver.seed, solver.device_layout);
   collective_manager_ = std::make_shared<CollectiveManager>(resource_manager_);
   embedding_para_io_ = std::shared_ptr<embedding::EmbeddingParameterIO>(
       new embedding::EmbeddingParameterIO(resource_manager_));
@@ -373,6 +432,9 @@ Model::Model(const Solver& solver, const DataReaderParams& reader_params,
 }
 
 Model::~Model() {
+  if (snapshot_writer_thread_.joinable()) {
+    snapshot_writer_thread_.join();
+  }
   for (auto device : resource_manager_->get_local_gpu_device_id_list()) {
     CudaDeviceContext context(device);
     HCTR_LIB_CHECK_(cudaDeviceSynchronize());
@@ -606,6 +668,9 @@ void Model::embedding_load(const std::string& path, const std::vector<std::strin
         }
         int shard_id = static_cast<int>(std::distance(shard_gpu_list.begin(), find_shard_id_iter));
 
+        // The filter is derived from the *current* shard matrix, not from the topology that
+        // produced the dump, so a dump can be reloaded into a different GPU count and each
+        // rank picks up exactly the keys its new shard owns (re-sharding on load).
         auto tmp_filter = [=](size_t key) { return key % num_shards == shard_id; };
         core23::Tensor keys;
         core23::Tensor embedding_weights;
@@ -664,6 +729,60 @@ void Model::embedding_dump(const std::string& path, const std::vector<std::strin
   }
 }
 
+void Model::embedding_dump_for_hps(const std::string& path,
+                                   const std::vector<std::string>& table_names) {
+  std::vector<struct embedding::EmbeddingParameterInfo> epis;
+
+  embedding_para_io_->get_parameter_info_from_model(path, epis);
+
+  // Per collection: the dumped table ids and their folder names, kept in table-id order so
+  // the folders line up with the HPS table order of the model.
+  std::map<int, std::vector<std::pair<int, std::string>>> tables_per_collection;
+  if (!table_names.empty()) {
+    check_table_name_correct(ebc_name_to_global_id_dict_, table_names);
+    for (auto& name : table_names) {
+      auto& id_pair = ebc_name_to_global_id_dict_.at(name);
+      tables_per_collection[id_pair.first].emplace_back(id_pair.second, name);
+    }
+  } else {
+    for (auto& [name, id_pair] : ebc_name_to_global_id_dict_) {
+      tables_per_collection[id_pair.first].emplace_back(id_pair.second, name);
+    }
+  }
+
+  for (auto& collection_entry : tables_per_collection) {
+    auto& cid = collection_entry.first;
+    auto& tmp_tables = collection_entry.second;
+    std::sort(tmp_tables.begin(), tmp_tables.end());
+    std::vector<int> tmp_table_ids;
+    std::vector<std::string> tmp_folder_names;
+    for (auto& table_entry : tmp_tables) {
+      tmp_table_ids.push_back(table_entry.first);
+      tmp_folder_names.push_back(table_entry.second);
+    }
+    embedding_para_io_->dump_for_hps(path, epis[cid], tmp_table_ids, tmp_folder_names);
+  }
+}
+
+void Model::set_bottom_dense_trainable_(bool trainable) {
+  if (!buff_allocated_) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "Cannot freeze or unfreeze the bottom dense "
+                   "network before calling Model.compile()");
+  }
+  if (networks_.empty() || networks_[0]->bottom_layers_.empty()) {
+    HCTR_OWN_THROW(Error_t::IllegalCall,
+                   "The model has no bottom dense network "
+                   "to freeze or unfreeze");
+  }
+  for (auto& network : networks_) {
+    for (auto* layer : network->bottom_layers_) {
+      layer->set_trainable(trainable);
+    }
+  }
+  HCTR_LOG(INFO, ROOT, "Bottom dense network trainable: %s\n", b2s(trainable));
+}
+
 void Model::set_source(std::string source, std::string eval_source) {
   if (solver_.repeat_dataset) {
     HCTR_OWN_THROW(Error_t::IllegalCall,
@@ -873,6 +992,75 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
     this->start_data_reading();
     this->init_data_reader_.reset();
 
+    // HCTR_ASYNC_EVAL=1 defers metric finalization to the next evaluation point: the eval
+    // batches are launched as usual (same host threads, so the collective issue order stays
+    // identical on every rank) but the host does not join on them, and the queued eval work
+    // drains on its own streams underneath the following training iterations. Metrics are
+    // reported one interval late.
+    const char* const async_eval_env = std::getenv("HCTR_ASYNC_EVAL");
+    bool async_eval = (async_eval_env != nullptr && 1 == std::atoi(async_eval_env));
+    if (async_eval && solver_.perf_logging) {
+      HCTR_LOG_S(INFO, ROOT) << "HCTR_ASYNC_EVAL is ignored when perf_logging is on" << std::endl;
+      async_eval = false;
+    }
+    int pending_eval_iter = -1;
+
+    // 0: continue training, 1: stop (early stop, callbacks notified), 2: stop (hit target AUC)
+    auto report_eval_metrics = [&](int eval_iter) -> int {
+      auto eval_metrics = this->get_eval_metrics();
+      std::map<std::string, float> eval_results;
+      for (auto& eval_metric : eval_metrics) {
+        eval_results[eval_metric.first] = eval_metric.second;
+      }
+      bool early_stop = false;
+      for (auto tc : training_callbacks_) {
+        early_stop = tc->on_eval_end(eval_iter, eval_results) || early_stop;
+      }
+      if (early_stop) {
+        for (auto tc : training_callbacks_) {
+          tc->on_training_end(eval_iter);
+        }
+        return 1;
+      }
+      size_t metric_id = 0;
+      for (auto& eval_metric : eval_metrics) {
+        metric_id++;
+        HCTR_LOG_S(INFO, ROOT) << "Evaluation, " << eval_metric.first << ": " << eval_metric.second
+                               << std::endl;
+        if (solver_.perf_logging) {
+          HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_accuracy", eval_metric.second,
+                        float(eval_iter) / max_iter, eval_iter);
+        }
+        if (!eval_metric.first.compare("AUC")) {
+          print_class_aucs(metrics_[metric_id - 1]->get_per_class_metric());
+          const auto auc_threshold = solver_.metrics_spec[HugeCTR::metrics::Type::AUC];
+          if (eval_metric.second > auc_threshold) {
+            timer.stop();
+            if (solver_.perf_logging) {
+              size_t train_samples =
+                  static_cast<size_t>(eval_iter + 1) * static_cast<size_t>(solver_.batchsize);
+
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop",
+                            float(eval_iter) / max_iter);
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "epoch_stop", 0);
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "run_stop", "success");
+              HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "train_samples", train_samples);
+              timer_log.stop();
+            }
+            HCTR_LOG(INFO, ROOT,
+                     "Hit target accuracy AUC %.5f at "
+                     "%d / %d iterations with batchsize %d "
+                     "in %.2fs. Average speed %f "
+                     "records/s.\n",
+                     auc_threshold, eval_iter, max_iter, solver_.batchsize, timer.elapsedSeconds(),
+                     float(eval_iter) * solver_.batchsize / timer.elapsedSeconds());
+            return 2;
+          }
+        }
+      }
+      return 0;
+    };
+
     for (int iter = 0; iter < max_iter; iter++) {
       float lr = 0;
       if (!this->use_gpu_learning_rate_scheduling()) {
@@ -914,6 +1102,13 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
           }
         }
         this->check_overflow();
+        if (pending_eval_iter >= 0) {
+          // finalize the previous evaluation before its weights and metric buffers are reused
+          if (report_eval_metrics(pending_eval_iter)) {
+            return;
+          }
+          pending_eval_iter = -1;
+        }
         this->copy_weights_for_evaluation();
         timer_eval.start();
         if (solver_.perf_logging) {
@@ -927,68 +1122,33 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
           graph_.is_last_eval_batch_ = (batches == solver_.max_eval_batches - 1);
           this->eval();
         }
-        auto eval_metrics = this->get_eval_metrics();
-        std::map<std::string, float> eval_results;
-        for (auto& eval_metric : eval_metrics) {
-          eval_results[eval_metric.first] = eval_metric.second;
-        }
-        bool early_stop = false;
-        for (auto tc : training_callbacks_) {
-          early_stop = tc->on_eval_end(iter, eval_results) || early_stop;
-        }
-        if (early_stop) {
-          for (auto tc : training_callbacks_) {
-            tc->on_training_end(iter);
+        if (async_eval) {
+          pending_eval_iter = iter;
+        } else {
+          if (report_eval_metrics(iter)) {
+            return;
           }
-          return;
-        }
-        size_t metric_id = 0;
-        for (auto& eval_metric : eval_metrics) {
-          metric_id++;
-          HCTR_LOG_S(INFO, ROOT) << "Evaluation, " << eval_metric.first << ": "
-                                 << eval_metric.second << std::endl;
+          timer_eval.stop();
+          HCTR_LOG_S(INFO, ROOT) << "Eval Time for " << solver_.max_eval_batches
+                                 << " iters: " << timer_eval.elapsedSeconds() << "s" << std::endl;
           if (solver_.perf_logging) {
-            HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_accuracy", eval_metric.second,
-                          float(iter) / max_iter, iter);
-          }
-          if (!eval_metric.first.compare("AUC")) {
-            print_class_aucs(metrics_[metric_id - 1]->get_per_class_metric());
-            const auto auc_threshold = solver_.metrics_spec[HugeCTR::metrics::Type::AUC];
-            if (eval_metric.second > auc_threshold) {
-              timer.stop();
-              if (solver_.perf_logging) {
-                size_t train_samples =
-                    static_cast<size_t>(iter + 1) * static_cast<size_t>(solver_.batchsize);
-
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop", float(iter) / max_iter);
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "epoch_stop", 0);
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "run_stop", "success");
-                HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "train_samples", train_samples);
-                timer_log.stop();
-              }
-              HCTR_LOG(INFO, ROOT,
-                       "Hit target accuracy AUC %.5f at "
-                       "%d / %d iterations with batchsize %d "
-                       "in %.2fs. Average speed %f "
-                       "records/s.\n",
-                       auc_threshold, iter, max_iter, solver_.batchsize, timer.elapsedSeconds(),
-                       float(iter) * solver_.batchsize / timer.elapsedSeconds());
-              return;
-            }
+            HCTR_LOG_ARGS(
+                timer_log.elapsedMilliseconds(), "eval_stop",
+                float(iter) / max_iter);  // use iteration to calculate it's in which epoch
           }
         }
-        timer_eval.stop();
-        HCTR_LOG_S(INFO, ROOT) << "Eval Time for " << solver_.max_eval_batches
-                               << " iters: " << timer_eval.elapsedSeconds() << "s" << std::endl;
-        if (solver_.perf_logging) {
-          HCTR_LOG_ARGS(timer_log.elapsedMilliseconds(), "eval_stop",
-                        float(iter) / max_iter);  // use iteration to calculate it's in which epoch
-        }
       }
       if (snapshot > 0 && (iter + 1) % snapshot == 0 && iter != 0) {
         this->download_params_to_files(snapshot_prefix, iter + 1);
       }
     }  // end for iter
+    if (pending_eval_iter >= 0) {
+      // flush the evaluation still in flight from the last interval
+      if (report_eval_metrics(pending_eval_iter)) {
+        return;
+      }
+      pending_eval_iter = -1;
+    }
     for (auto tc : training_callbacks_) {
       tc->on_training_end(max_iter - 1);
     }
@@ -1007,6 +1167,7 @@ void Model::fit(int num_epochs, int max_iter, int display, int eval_interval, in
              max_iter, solver_.batchsize, timer.elapsedSeconds());
 
   }  // end if else
+  this->dump_pipeline_trace();
   high_level_eval_ = false;
 }
 
@@ -1087,6 +1248,12 @@ bool Model::train() {
     }
     this->check_overflow();
 
+    if (resource_manager_->straggler_simulation_enabled()) {
+      for (size_t id = 0; id < resource_manager_->get_local_gpu_count(); ++id) {
+        resource_manager_->inject_straggler_delay(id);
+      }
+    }
+
     if (solver_.use_embedding_collection) {
       train_pipeline_with_ebc();
       return true;
@@ -1102,8 +1269,11 @@ bool Model::train() {
     {
       size_t id = omp_get_thread_num();
       CudaCPUDeviceContext ctx(resource_manager_->get_local_gpu(id)->get_device_id());
-      if (solver_.use_cuda_graph && !train_data_reader_->current_batch_incomplete()) {
-        graph_.train_pipeline_[id].run_graph();
+      if (solver_.use_cuda_graph) {
+        // incomplete (final, smaller) batches replay their own graph keyed by batch
+        // size instead of dropping to the slower non-graph path
+        graph_.train_pipeline_[id].run_graph(
+            static_cast<size_t>(train_data_reader_->get_current_batchsize()));
       } else {
         graph_.train_pipeline_[id].run();
       }
@@ -1245,9 +1415,69 @@ Error_t Model::download_params_to_files(std::string prefix, int iter) {
                                         std::to_string(iter) + ".model");
   }
   download_sparse_params_to_files_(snapshot_sparse_names, snapshot_sparse_opt_names);
+  if (train_data_distributor_) {
+    // no-op unless HCTR_KEY_FREQ_SKETCH=1
+    train_data_distributor_->dump_key_frequency(prefix + "_key_freq_" + std::to_string(iter));
+  }
+  const char* const async_snapshot_env = std::getenv("HCTR_ASYNC_SNAPSHOT");
+  if (async_snapshot_env != nullptr && 1 == std::atoi(async_snapshot_env)) {
+    return snapshot_dense_params_to_files_(snapshot_dense_name, snapshot_dense_opt_name);
+  }
   return download_dense_params_to_files_(snapshot_dense_name, snapshot_dense_opt_name);
 }
 
+Error_t Model::snapshot_dense_params_to_files_(std::string weights_file,
+                                               std::string dense_opt_states_file) {
+  try {
+    // at most one snapshot in flight: the staging buffers are handed to the
+    // writer thread, so wait for the previous writer before taking a new one
+    if (snapshot_writer_thread_.joinable()) {
+      snapshot_writer_thread_.join();
+    }
+    if (resource_manager_->is_master_process()) {
+      auto& network = networks_[0];
+      size_t weight_bytes = network->get_params_num() * sizeof(float);
+      size_t opt_state_bytes = network->get_opt_states_size_in_byte();
+
+      // one D2H pass into host staging; training resumes as soon as it is done
+      auto h_weights = std::make_shared<std::vector<char>>(weight_bytes);
+      auto h_opt_states = std::make_shared<std::vector<char>>(opt_state_bytes);
+      network->download_params_to_host(reinterpret_cast<float*>(h_weights->data()));
+      if (opt_state_bytes > 0) {
+        network->download_opt_states_to_host(h_opt_states->data());
+      }
+      std::string no_trained_params = network->get_no_trained_params_in_string();
+
+      snapshot_writer_thread_ = std::thread([weights_file, dense_opt_states_file, h_weights,
+                                             h_opt_states, no_trained_params]() {
+        try {
+          auto fs = FileSystemBuilder::build_unique_by_path(weights_file);
+          fs->write(weights_file, h_weights->data(), h_weights->size(), true);
+          HCTR_LOG(INFO, ROOT, "Dumping dense weights to file, successful\n");
+          auto opt_fs = FileSystemBuilder::build_unique_by_path(dense_opt_states_file);
+          opt_fs->write(dense_opt_states_file, h_opt_states->data(), h_opt_states->size(), true);
+          HCTR_LOG(INFO, ROOT, "Dumping dense optimizer states to file, successful\n");
+          if (no_trained_params.length() != 0) {
+            std::string ntp_file = weights_file + ".ntp.json";
+            auto ntp_fs = FileSystemBuilder::build_unique_by_path(ntp_file);
+            ntp_fs->write(ntp_file, no_trained_params.c_str(), no_trained_params.length(), true);
+            HCTR_LOG(INFO, ROOT, "Dumping untrainable weights to file, successful\n");
+          }
+        } catch (const std::exception& err) {
+          Logger::get().print(err);
+        }
+      });
+    }
+  } catch (const core23::RuntimeError& rt_err) {
+    Logger::get().print(rt_err);
+    return rt_err.error;
+  } catch (const std::exception& err) {
+    Logger::get().print(err);
+    return Error_t::UnspecificError;
+  }
+  return Error_t::Success;
+}
+
 void Model::check_overflow() const {
   if (!overflow_check_) {
     return;
@@ -22,10 +22,13 @@
 #include <core23/mpi_init_service.hpp>
 #include <core23_helper.hpp>
 #include <core23_network.hpp>
+#include <cstdlib>
 #include <data_readers/multi_hot/async_data_reader.hpp>
+#include <embedding/frequency_aware_placement.hpp>
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <kernel_autotuner.hpp>
 #include <network_buffer_channels.hpp>
 #include <pybind/model.hpp>
 #include <resource_managers/resource_manager_core.hpp>
@@ -398,6 +401,39 @@ void Model::add(const EmbeddingCollectionConfig& user_ebc_config) {
     }
   }
 
+  // HCTR_AUTO_SHARD=1 replaces the user-provided shard matrix with a computed one that
+  // balances table memory and lookup load across GPUs within each model-parallel group.
+  // Lookup load is approximated statically by the summed hotness of the lookups hitting
+  // each table, weighted by its embedding-vector size.
+  const char* const auto_shard_env = std::getenv("HCTR_AUTO_SHARD");
+  if (auto_shard_env != nullptr && 1 == std::atoi(auto_shard_env)) {
+    std::vector<embedding::TablePlacementStats> table_stats;
+    for (int table_id = 0; table_id < num_table; ++table_id) {
+      double lookup_load = 0.;
+      for (auto& lookup : lookup_params) {
+        if (lookup.table_id == table_id) {
+          lookup_load += lookup.max_hotness;
+        }
+      }
+      table_stats.push_back(
+          {table_id,
+           static_cast<size_t>(std::max<int64_t>(emb_table_list[table_id].max_vocabulary_size, 0)),
+           emb_table_list[table_id].ev_size, lookup_load});
+    }
+    embedding::balance_shard_placement(table_stats, num_total_gpus, grouped_emb_params,
+                                       &shard_matrix);
+
+    auto log = HCTR_LOG_S(INFO, ROOT);
+    log << "HCTR_AUTO_SHARD computed shard matrix:" << std::endl;
+    for (int gpu = 0; gpu < num_total_gpus; ++gpu) {
+      log << "  gpu " << gpu << ":";
+      for (int table_id = 0; table_id < num_table; ++table_id) {
+        log << ' ' << shard_matrix[gpu][table_id];
+      }
+      log << std::endl;
+    }
+  }
+
   embedding::AllreduceStrategy allreduce_strategy = ebc_config.allreduce_strategy_;
   if (solver_.grouped_all_reduce) {
     allreduce_strategy = embedding::AllreduceStrategy::GroupDense;
@@ -521,6 +557,7 @@ void Model::add(const EmbeddingCollectionConfig& user_ebc_config) {
       embedding_dependent_tensors_.insert(top_name);
     }
     input_output_info_.push_back(std::make_pair(bottom_name, join(top_name_list, ",")));
+    ebc_top_name_lists_.push_back(top_name_list);
     if (solver_.use_mixed_precision) {
       allocate_ebc_output_helper_for_feature_major<__half>(
           resource_manager_, batch_size_per_gpu, ebc_config, ebc_param, train_tensor_entities_list_,
@@ -552,6 +589,8 @@ void Model::add(const EmbeddingCollectionConfig& user_ebc_config) {
         {ebc_config.batch_major_output_name_, {solver_.batchsize, concate_out_dims}});
     input_output_info_.push_back(std::make_pair(bottom_name, ebc_config.batch_major_output_name_));
     embedding_dependent_tensors_.insert(ebc_config.batch_major_output_name_);
+    // already batch-major: nothing for the layout negotiation to rewrite
+    ebc_top_name_lists_.push_back({});
 
     // allocate output buffer
     if (solver_.use_mixed_precision) {
@@ -595,6 +634,27 @@ void Model::add(const EmbeddingCollectionConfig& user_ebc_config) {
                                                               ebc_config.dr_lookup_ids_);
   eval_data_distributor_ = std::make_shared<DataDistributor>(
       core_list, eval_ebc_param, emb_table_list, ebc_config.dr_lookup_ids_);
+
+  // Filtered uploads (HCTR_FILTERED_UPLOAD=1): when the dataset carries more sparse
+  // buckets than this model's lookups reference (e.g. several models sharing one reader
+  // file), the reader stages only the surviving sample columns host-side and skips the
+  // rest of the H2D transfer instead of filtering the keys after the full batch landed
+  // on device.
+  static const bool filtered_upload = [] {
+    const char* env = std::getenv("HCTR_FILTERED_UPLOAD");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  if (filtered_upload) {
+    auto register_used_features = [&](IDataReader* reader_ptr) {
+      if (auto reader = dynamic_cast<MultiHot::AsyncDataReader<uint32_t>*>(reader_ptr)) {
+        reader->set_required_sparse_features(ebc_config.dr_lookup_ids_);
+      } else if (auto reader = dynamic_cast<MultiHot::AsyncDataReader<long long>*>(reader_ptr)) {
+        reader->set_required_sparse_features(ebc_config.dr_lookup_ids_);
+      }
+    };
+    register_used_features(train_data_reader_.get());
+    register_used_features(evaluate_data_reader_.get());
+  }
 }
 
 void Model::pre_add_dense_layer(DenseLayer& dense_layer) {
@@ -723,6 +783,8 @@ void Model::compile() {
   HCTR_PRINT(INFO,
              "===================================================Model "
              "Compile===================================================\n");
+  // Preload persisted kernel autotune winners so tuned models skip the first-run benchmarks.
+  KernelAutotuner::get().load_cache();
   build_networks();
 
   // TODO: this is a WAR; need to find a way to remove the preallocation
@@ -897,6 +959,12 @@ void Model::initialize() {
     HCTR_CHECK_HINT(size_ && ptr_, "wgrad is null or it's a confederal buffer");
     wgrad_buffer_ptrs.push_back(ptr_);
   }
+  // bucketed wgrad exchange: split the fused buffer where the top-MLP wgrads begin so
+  // their allreduce can overlap the bottom MLP backward (layout identical on every GPU)
+  if (void* boundary = networks_[0]->get_top_wgrad_boundary()) {
+    exchange_wgrad_->set_bucket_split(static_cast<char*>(boundary) -
+                                      static_cast<char*>(wgrad_buffer_ptrs[0]));
+  }
   exchange_wgrad_->init_ar_comm(wgrad_buffer_ptrs, wgrad_buffer_size);
 #endif
   init_params_for_dense_();
@@ -946,6 +1014,28 @@ void Model::create_pipelines() {
     }
   }
 
+  // dynamic loss scaling: the losses read the live scale and the optimizer skips steps
+  // whose post-allreduce wgrad overflowed, both through the guard's device pointers
+  if (exchange_wgrad_->dynamic_loss_scale_ptr(0) != nullptr) {
+    if (opt_params_.optimizer != Optimizer_t::SGD) {
+      HCTR_OWN_THROW(Error_t::WrongInput,
+                     "HCTR_DYNAMIC_LOSS_SCALE is only supported with the SGD dense optimizer");
+    }
+    // The embedding optimizers unscale with the static solver scaler and do not observe the
+    // skip flag, so a moving scale would mis-scale their gradients and overflow steps would
+    // still reach the embedding tables.
+    if (!embeddings_.empty() || !ebc_list_.empty()) {
+      HCTR_OWN_THROW(Error_t::WrongInput,
+                     "HCTR_DYNAMIC_LOSS_SCALE is not supported for models with embeddings: the "
+                     "embedding update paths only apply the static solver scaler");
+    }
+    for (size_t i = 0; i < networks_.size(); i++) {
+      networks_[i]->set_dynamic_loss_scale_ptrs(exchange_wgrad_->dynamic_loss_scale_ptr(i),
+                                                exchange_wgrad_->dynamic_unscale_ptr(i),
+                                                exchange_wgrad_->skip_step_ptr(i));
+    }
+  }
+
   if (solver_.use_embedding_collection) {
     create_train_pipeline_with_ebc(networks_);
     create_evaluate_pipeline_with_ebc(networks_);
@@ -16,6 +16,7 @@
 
 #include <HugeCTR/include/data_readers/multi_hot/async_data_reader.hpp>
 #include <algorithm>
+#include <chrome_trace.hpp>
 #include <core23/logger.hpp>
 #include <core23_network.hpp>
 #include <fstream>
@@ -27,6 +28,17 @@
 
 namespace HugeCTR {
 
+namespace {
+
+// A span only drops backward work when it is non-empty and every one of its layers has
+// been frozen via Layer::set_trainable(false).
+bool all_layers_frozen(const std::vector<Layer*>& layers) {
+  return !layers.empty() && std::none_of(layers.begin(), layers.end(),
+                                         [](const Layer* layer) { return layer->is_trainable(); });
+}
+
+}  // namespace
+
 void Model::exchange_wgrad(size_t device_id) {
   auto& gpu_resource = resource_manager_->get_local_gpu(device_id);
   CudaCPUDeviceContext context(gpu_resource->get_device_id());
@@ -35,6 +47,27 @@ void Model::exchange_wgrad(size_t device_id) {
   }
 }
 
+void Model::exchange_wgrad_bucket(size_t device_id, size_t bucket) {
+  auto& gpu_resource = resource_manager_->get_local_gpu(device_id);
+  CudaCPUDeviceContext context(gpu_resource->get_device_id());
+  if (resource_manager_->get_global_gpu_count() > 1) {
+    exchange_wgrad_->allreduce_bucket(device_id, bucket, gpu_resource->get_stream());
+  }
+}
+
+void Model::dump_pipeline_trace() {
+  for (auto& pipeline : graph_.train_pipeline_) {
+    pipeline.dump_trace();
+  }
+  for (auto& pipeline : graph_.evaluate_pipeline_) {
+    pipeline.dump_trace();
+  }
+}
+
+void Model::export_chrome_trace(const std::string& path) {
+  ChromeTraceRecorder::instance().export_json(path);
+}
+
 void Model::create_train_network_pipeline(std::vector<std::shared_ptr<Network>>& networks) {
   graph_.train_pipeline_.resize(resource_manager_->get_local_gpu_count());
 
@@ -46,9 +79,8 @@ void Model::create_train_network_pipeline(std::vector<std::shared_ptr<Network>>&
 
     auto BNET_input_ready_wait = std::make_shared<StreamContextScheduleable>([=] {
       auto stream = gpu_resource->get_stream();
-      scheduled_reader->stream_wait_dense_tensors(
-          stream, local_id,
-          solver_.use_cuda_graph && !scheduled_reader->current_batch_incomplete());
+      // with batch-size-keyed graphs even incomplete batches run inside a graph
+      scheduled_reader->stream_wait_dense_tensors(stream, local_id, solver_.use_cuda_graph);
     });
 
     auto network_forward_and_backward = std::make_shared<StreamContextScheduleable>([=] {
@@ -125,6 +157,10 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
           HCTR_LIB_THROW(cudaStreamSynchronize(stream));
           return;
         }
+        // the sparse values are produced by split_3_way on the reader's side stream
+        if (auto scheduled_reader = dynamic_cast<SchedulableDataReader*>(train_data_reader_.get())) {
+          scheduled_reader->stream_wait_sparse_tensors(gpu_resource->get_stream(), local_id, false);
+        }
         if (auto reader =
                 dynamic_cast<MultiHot::AsyncDataReader<uint32_t>*>(train_data_reader_.get())) {
           train_data_distributor_->distribute(
@@ -276,7 +312,10 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
 
     auto bottom_network_bprop = std::make_shared<StreamContextScheduleable>([=] {
       if (skip_bottom_mlp) return;
-      networks[local_id]->prop_layers(networks[local_id]->bottom_layers_, false, is_train);
+      // The bottom span consumes only the raw dense input, so its input gradients are
+      // never needed and a frozen run of bottom layers is pruned from the backward pass.
+      networks[local_id]->prop_layers(networks[local_id]->bottom_layers_, false, is_train,
+                                      false);
     });
 
     auto network_graph = std::make_shared<GraphScheduleable>(
@@ -286,9 +325,32 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
     const char* const skip_allreduce_env = std::getenv("SKIP_ALLREDUCE");
     bool skip_allreduce = (skip_allreduce_env != nullptr && 1 == std::atoi(skip_allreduce_env));
 
+    // bucketed wgrad exchange (HCTR_WGRAD_AR_BUCKETS=1): only split when the
+    // intra-iteration overlap wiring below can launch the top bucket early;
+    // without that wiring a single allreduce is strictly better
+    const bool bucketed_wgrad_ar =
+        solver_.train_intra_iteration_overlap && exchange_wgrad_->bucketed();
+
     auto network_exchange_wgrad = std::make_shared<StreamContextScheduleable>([=] {
       if (skip_allreduce) return;
-      this->exchange_wgrad(local_id);
+      // Bucket 0 carries the bottom-layer wgrads. When the whole bottom span is frozen
+      // its bprop has been pruned and the bucket never changes, so its allreduce is
+      // dropped with it; without bucketing in flight, fall back to reducing only the
+      // top bucket when the split allows it.
+      const bool bottom_frozen = all_layers_frozen(networks[local_id]->bottom_layers_);
+      if (bucketed_wgrad_ar) {
+        if (bottom_frozen) return;
+        this->exchange_wgrad_bucket(local_id, 0);
+      } else if (bottom_frozen && this->exchange_wgrad_->bucketed()) {
+        this->exchange_wgrad_bucket(local_id, 1);
+      } else {
+        this->exchange_wgrad(local_id);
+      }
+    });
+
+    auto network_exchange_wgrad_top = std::make_shared<StreamContextScheduleable>([=] {
+      if (skip_allreduce) return;
+      this->exchange_wgrad_bucket(local_id, 1);
     });
 
     auto update_params =
@@ -333,7 +395,6 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
 
       // allreduce wait dp local reduce
       auto done_ebc_dp_local_reduce = ebc_dp_local_reduce->record_done();
-      network_exchange_wgrad->wait_event({done_ebc_dp_local_reduce});
 
       // dp update wait allreduce
       auto done_ebc_dp_allreduce = ebc_dp_allreduce->record_done();
@@ -343,6 +404,29 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
       auto done_ebc_dp_update = ebc_dp_update->record_done();
       auto done_ebc_mp_update = ebc_mp_update->record_done();
       sync_back->wait_event({done_ebc_dp_update, done_ebc_mp_update});
+
+      // run the wgrad exchange on its own stream: the allreduce only needs the dense
+      // wgrads (complete after bottom MLP bprop) and the DP local reduce, so it
+      // overlaps with the remaining embedding backward stages instead of serializing
+      // on the default stream before update_params
+      std::string wgrad_stream = "wgrad";
+      network_exchange_wgrad->set_stream(wgrad_stream);
+      ebc_dp_allreduce->set_stream(wgrad_stream);
+
+      auto done_bottom_network_bprop = bottom_network_bprop->record_done(use_graph);
+      network_exchange_wgrad->wait_event({done_ebc_dp_local_reduce, done_bottom_network_bprop});
+
+      auto done_network_exchange_wgrad = network_exchange_wgrad->record_done();
+      if (bucketed_wgrad_ar) {
+        // the top-MLP bucket only needs the top network bprop, so it reduces on its own
+        // stream while the bottom MLP and the embedding backward stages still run
+        network_exchange_wgrad_top->set_stream("wgrad_top");
+        network_exchange_wgrad_top->wait_event({done_top_network_bprop});
+        auto done_network_exchange_wgrad_top = network_exchange_wgrad_top->record_done();
+        update_params->wait_event({done_network_exchange_wgrad, done_network_exchange_wgrad_top});
+      } else {
+        update_params->wait_event({done_network_exchange_wgrad});
+      }
     }
 
     if (!solver_.train_inter_iteration_overlap) {
@@ -367,6 +451,14 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
       auto done_distribute_data = distribute_data->record_done();
       ebc_mp_model_forward->wait_event({done_distribute_data});
 
+      if (bucketed_wgrad_ar) {
+        // keep the top bucket ahead of the bottom one so every rank issues the
+        // collectives in the same order
+        scheduleable_list.insert(
+            std::find(scheduleable_list.begin(), scheduleable_list.end(), network_exchange_wgrad),
+            network_exchange_wgrad_top);
+      }
+
       graph_.train_pipeline_[local_id] = Pipeline{"default", gpu_resource, scheduleable_list};
     } else {
       auto ebc_cache_train_ddl_output =
@@ -384,6 +476,26 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
         graph_.train_copy_ops_[local_id + resource_manager_->get_local_gpu_count()]->run();
       });
 
+      // HCTR_PREFETCH_EMB_FORWARD=1: issue the model-parallel lookup for the prefetched
+      // batch on the prefetch stream once this iteration's embedding update is done, so
+      // it overlaps the dense optimizer step; the next iteration's ebc_mp_model_forward
+      // then only swaps in the double-buffered result (Uniform comm strategy only, the
+      // other group types ignore the stage and keep their in-iteration model forward).
+      const char* const prefetch_emb_forward_env = std::getenv("HCTR_PREFETCH_EMB_FORWARD");
+      bool prefetch_emb_forward =
+          (prefetch_emb_forward_env != nullptr && 1 == std::atoi(prefetch_emb_forward_env));
+
+      auto ebc_mp_model_forward_prefetch = std::make_shared<StreamContextScheduleable>([=] {
+        if (skip_prefetch_in_last_batch(is_train)) return;
+        if (skip_embedding) return;
+
+        for (auto& ebc : ebc_list_) {
+          ebc->forward_per_gpu(embedding::Stage::MPPrefetchModelForward, is_train, local_id,
+                               train_ddl_output_[local_id], train_ebc_outptut_[local_id],
+                               train_data_reader_->get_full_batchsize());
+        }
+      });
+
       std::vector<std::shared_ptr<Scheduleable>> scheduleable_list = {
           ebc_cache_train_ddl_output,
           ebc_mp_model_forward,
@@ -407,13 +519,34 @@ void Model::create_train_pipeline_with_ebc(std::vector<std::shared_ptr<Network>>
       std::string prefetch_stream = "prefetch";
 
       auto done_ebc_cache_train_ddl_output = ebc_cache_train_ddl_output->record_done();
-      ebc_mp_model_forward->wait_event({done_ebc_cache_train_ddl_output});
 
       distribute_data->set_absolute_stream(prefetch_stream);
       distribute_data->wait_event({done_ebc_cache_train_ddl_output});
 
       auto done_distribute_data = distribute_data->record_done();
       ebc_cache_train_ddl_output->wait_event({done_distribute_data});
+
+      if (prefetch_emb_forward) {
+        ebc_mp_model_forward_prefetch->set_absolute_stream(prefetch_stream);
+        auto done_ebc_mp_update = ebc_mp_update->record_done();
+        // the prefetched lookup must read the distributed keys and the updated tables
+        ebc_mp_model_forward_prefetch->wait_event({done_distribute_data, done_ebc_mp_update});
+
+        auto done_prefetch_model_forward = ebc_mp_model_forward_prefetch->record_done();
+        ebc_mp_model_forward->wait_event(
+            {done_ebc_cache_train_ddl_output, done_prefetch_model_forward});
+
+        scheduleable_list.insert(scheduleable_list.end() - 2, ebc_mp_model_forward_prefetch);
+      } else {
+        ebc_mp_model_forward->wait_event({done_ebc_cache_train_ddl_output});
+      }
+      if (bucketed_wgrad_ar) {
+        // keep the top bucket ahead of the bottom one so every rank issues the
+        // collectives in the same order
+        scheduleable_list.insert(
+            std::find(scheduleable_list.begin(), scheduleable_list.end(), network_exchange_wgrad),
+            network_exchange_wgrad_top);
+      }
       graph_.train_pipeline_[local_id] = Pipeline{"default", gpu_resource, scheduleable_list};
     }
   }
@@ -456,7 +589,9 @@ void Model::train_pipeline_with_ebc() {
     }
   }
 
-  const bool use_graph = solver_.use_cuda_graph && !train_data_reader_->current_batch_incomplete();
+  const bool use_graph = solver_.use_cuda_graph;
+  // incomplete batches replay a separately captured graph keyed by their batch size
+  const size_t graph_key = static_cast<size_t>(train_data_reader_->get_current_batchsize());
 
 #pragma omp parallel num_threads(resource_manager_->get_local_gpu_count())
   {
@@ -465,7 +600,7 @@ void Model::train_pipeline_with_ebc() {
     CudaCPUDeviceContext context(device_id);
 
     if (use_graph) {
-      graph_.train_pipeline_[id].run_graph();
+      graph_.train_pipeline_[id].run_graph(graph_key);
     } else {
       graph_.train_pipeline_[id].run();
     }
@@ -486,6 +621,11 @@ void Model::create_evaluate_pipeline_with_ebc(std::vector<std::shared_ptr<Networ
     auto eval_data_distribute = std::make_shared<StreamContextScheduleable>([=] {
       if (skip_prefetch_in_last_batch(is_train)) return;
       if (is_scheduled_datareader()) {
+        // the sparse values are produced by split_3_way on the reader's side stream
+        if (auto scheduled_reader =
+                dynamic_cast<SchedulableDataReader*>(evaluate_data_reader_.get())) {
+          scheduled_reader->stream_wait_sparse_tensors(gpu_resource->get_stream(), local_id, false);
+        }
         if (auto reader =
                 dynamic_cast<MultiHot::AsyncDataReader<uint32_t>*>(evaluate_data_reader_.get())) {
           eval_data_distributor_->distribute(
@@ -638,8 +778,9 @@ void Model::evaluate_pipeline_with_ebc() {
     }
   }
 
-  const bool use_graph =
-      solver_.use_cuda_graph && !evaluate_data_reader_->current_batch_incomplete();
+  const bool use_graph = solver_.use_cuda_graph;
+  // incomplete batches replay a separately captured graph keyed by their batch size
+  const size_t graph_key = static_cast<size_t>(evaluate_data_reader_->get_current_batchsize());
 
 #pragma omp parallel num_threads(number_of_networks())
   {
@@ -648,7 +789,7 @@ void Model::evaluate_pipeline_with_ebc() {
     CudaCPUDeviceContext context(device_id);
 
     if (use_graph) {
-      graph_.evaluate_pipeline_[id].run_graph();
+      graph_.evaluate_pipeline_[id].run_graph(graph_key);
     } else {
       graph_.evaluate_pipeline_[id].run();
     }
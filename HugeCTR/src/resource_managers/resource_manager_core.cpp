@@ -16,10 +16,13 @@
 
 #include <omp.h>
 
+#include <chrono>
 #include <core23/logger.hpp>
 #include <cstdlib>
 #include <random>
 #include <resource_managers/resource_manager_core.hpp>
+#include <sstream>
+#include <thread>
 #include <utils.hpp>
 
 #ifndef DISABLE_CUDF
@@ -33,6 +36,17 @@
 
 namespace HugeCTR {
 
+namespace {
+
+// Host function enqueued onto a GPU stream; while it sleeps, all work behind it on that stream
+// stalls, which is how a throttled GPU looks to the other ranks of a collective.
+void straggler_sleep(void* delay) {
+  const long delay_us = static_cast<long>(reinterpret_cast<intptr_t>(delay));
+  std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+}
+
+}  // namespace
+
 void ResourceManagerCore::all2all_warmup() {
   auto num_global_gpus = get_global_gpu_count();
   auto num_local_gpus = get_local_gpu_count();
@@ -186,6 +200,8 @@ ResourceManagerCore::ResourceManagerCore(int num_process, int process_id, Device
 
   all2all_warmup();
 
+  init_straggler_simulation();
+
 #ifndef DISABLE_CUDF
   initialize_rmm_resources();
 #endif
@@ -208,6 +224,62 @@ ResourceManagerCore::~ResourceManagerCore() {
   }
 #endif
 }
+void ResourceManagerCore::init_straggler_simulation() {
+  // HCTR_STRAGGLER_RANKS is a comma-separated list of process ranks that should act as
+  // stragglers; HCTR_STRAGGLER_DELAY_US is the base per-injection delay and
+  // HCTR_STRAGGLER_JITTER_US an optional uniform +/- jitter around it.
+  const char* const ranks_env = std::getenv("HCTR_STRAGGLER_RANKS");
+  if (ranks_env == nullptr || ranks_env[0] == '\0') {
+    return;
+  }
+
+  bool rank_selected = false;
+  std::istringstream ranks_stream(ranks_env);
+  std::string rank_str;
+  while (std::getline(ranks_stream, rank_str, ',')) {
+    if (!rank_str.empty() && std::atoi(rank_str.c_str()) == process_id_) {
+      rank_selected = true;
+      break;
+    }
+  }
+  if (!rank_selected) {
+    return;
+  }
+
+  const char* const delay_env = std::getenv("HCTR_STRAGGLER_DELAY_US");
+  straggler_delay_us_ = delay_env ? std::atol(delay_env) : 0;
+  if (straggler_delay_us_ <= 0) {
+    return;
+  }
+
+  const char* const jitter_env = std::getenv("HCTR_STRAGGLER_JITTER_US");
+  straggler_jitter_us_ = jitter_env ? std::atol(jitter_env) : 0;
+
+  straggler_sim_enabled_ = true;
+  HCTR_LOG_S(WARNING, WORLD) << "Straggler simulation enabled on this rank: "
+                             << straggler_delay_us_ << " us +/- " << straggler_jitter_us_
+                             << " us injected per iteration. Do not use in production."
+                             << std::endl;
+}
+
+void ResourceManagerCore::inject_straggler_delay(size_t local_gpu_id) const {
+  if (!straggler_sim_enabled_) {
+    return;
+  }
+
+  long delay_us = straggler_delay_us_;
+  if (straggler_jitter_us_ > 0) {
+    static thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<long> dis(-straggler_jitter_us_, straggler_jitter_us_);
+    delay_us = std::max(0L, delay_us + dis(gen));
+  }
+
+  const auto& local_gpu = get_local_gpu(local_gpu_id);
+  CudaDeviceContext context(local_gpu->get_device_id());
+  HCTR_LIB_THROW(cudaLaunchHostFunc(local_gpu->get_stream(), straggler_sleep,
+                                    reinterpret_cast<void*>(static_cast<intptr_t>(delay_us))));
+}
+
 bool ResourceManagerCore::p2p_enabled(int src_device_id, int dst_device_id) const {
   return p2p_matrix_[src_device_id][dst_device_id];
 }
@@ -21,6 +21,14 @@
 
 namespace HugeCTR {
 
+namespace {
+
+// Set while a worker runs so submissions from within a task can use the LIFO slot.
+thread_local ThreadPool* t_owner_pool = nullptr;
+thread_local size_t t_worker_index = 0;
+
+}  // namespace
+
 ThreadPool::ThreadPool(const std::string& name) : ThreadPool(name, 0) {}
 
 ThreadPool::ThreadPool(const std::string& name, size_t num_workers) : name_(name) {
@@ -34,7 +42,10 @@ ThreadPool::ThreadPool(const std::string& name, size_t num_workers) : name_(name
     }
   }
 
-  // Create worker threads.
+  // Create the per-worker queues before the workers that consume them.
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t i = 0; i < num_workers; i++) {
     workers_.emplace_back(&ThreadPool::run_, this, i);
   }
@@ -60,7 +71,7 @@ ThreadPool::~ThreadPool() {
 bool ThreadPool::idle() const {
   // Momentarily request exclusive access, and read out the idle status.
   std::lock_guard<std::mutex> lock(barrier_);
-  return num_idle_workers_ == workers_.size() && packages_.empty();
+  return num_idle_workers_ == workers_.size() && num_queued_.load() == 0;
 }
 
 void ThreadPool::await_idle() const {
@@ -68,7 +79,7 @@ void ThreadPool::await_idle() const {
   std::unique_lock<std::mutex> lock(barrier_);
 
   // Are we idle already? If not wait for a worker to exit.
-  while (num_idle_workers_ != workers_.size() || !packages_.empty()) {
+  while (num_idle_workers_ != workers_.size() || num_queued_.load() != 0) {
     if (terminate_) {
       HCTR_OWN_THROW(Error_t::IllegalCall, "Attempted to await an already terminated ThreadPool!");
     }
@@ -80,18 +91,31 @@ std::future<void> ThreadPool::submit(std::function<void()> task) {
   std::packaged_task<void()> package(std::move(task));
   std::future<void> result = package.get_future();
 
-  // Momentarily request exclusive access, to submit the task.
   {
     std::lock_guard<std::mutex> lock(barrier_);
     if (terminate_) {
       HCTR_OWN_THROW(Error_t::IllegalCall,
                      "Attempted to submit work to an already terminated ThreadPool!");
     }
-    packages_.emplace_back(std::move(package));
   }
 
-  // Wake up a worker.
-  submit_sempahore_.notify_one();
+  // Queue the task: LIFO slot of the submitting worker, or round-robin for external callers.
+  num_queued_.fetch_add(1);
+  if (t_owner_pool == this) {
+    std::lock_guard<std::mutex> lock(queues_[t_worker_index]->mutex);
+    queues_[t_worker_index]->packages.emplace_front(std::move(package));
+  } else {
+    const size_t target = submit_counter_.fetch_add(1) % queues_.size();
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->packages.emplace_back(std::move(package));
+  }
+
+  // Wake up a worker. The lock orders the notification against sleeping workers, which
+  // re-check num_queued_ under the same lock before waiting.
+  {
+    std::lock_guard<std::mutex> lock(barrier_);
+    submit_sempahore_.notify_one();
+  }
 
   return result;
 }
@@ -104,14 +128,53 @@ ThreadPool& ThreadPool::get() {
   return *default_pool.get();
 }
 
+bool ThreadPool::try_pop_(const size_t thread_index, std::packaged_task<void()>& package) {
+  // Own queue first (front: LIFO slot and the oldest external work alike live there).
+  {
+    WorkerQueue& own = *queues_[thread_index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.packages.empty()) {
+      package = std::move(own.packages.front());
+      own.packages.pop_front();
+      num_queued_.fetch_sub(1);
+      return true;
+    }
+  }
+
+  // Steal from the back of the siblings' queues, starting with the next neighbor so
+  // concurrent thieves fan out instead of hammering the same victim.
+  for (size_t offset = 1; offset < queues_.size(); offset++) {
+    WorkerQueue& victim = *queues_[(thread_index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.packages.empty()) {
+      package = std::move(victim.packages.back());
+      victim.packages.pop_back();
+      num_queued_.fetch_sub(1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void ThreadPool::run_(const size_t thread_index) {
   if (name_ != "") {
     Logger::set_thread_name(name_ + " #" + std::to_string(thread_index));
   }
+  t_owner_pool = this;
+  t_worker_index = thread_index;
+
   while (true) {
     thread_local std::packaged_task<void()> package;
 
-    // Acquire exclusive access.
+    if (try_pop_(thread_index, package)) {
+      // Execute work package. Idle waiters are signaled when the worker re-enters the
+      // idle state below, exactly as before the per-worker queues.
+      package();
+      continue;
+    }
+
+    // All queues looked empty: go to sleep.
     {
       std::unique_lock barrier_lock(barrier_);
 
@@ -120,8 +183,7 @@ void ThreadPool::run_(const size_t thread_index) {
         return;
       }
 
-      // If no work package queued.
-      while (packages_.empty()) {
+      while (num_queued_.load() == 0) {
         // Enter idle state (notify threads that wait for the threadpool to go idle).
         num_idle_workers_ += 1;
         idle_semaphore_.notify_all();
@@ -135,13 +197,7 @@ void ThreadPool::run_(const size_t thread_index) {
           return;
         }
       }
-
-      package = std::move(packages_.front());
-      packages_.pop_front();
     }
-
-    // Execute work package.
-    package();
   }
 }
 
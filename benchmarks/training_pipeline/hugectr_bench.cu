@@ -0,0 +1,490 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * hugectr_bench: end-to-end training hot-path benchmark.
+ *
+ * Runs parameterized synthetic steps through DataDistributor -> EmbeddingCollection
+ * (forward / backward / update) plus a cuBLAS GEMM proxy for the dense network, and reports
+ * per-stage times together with the achieved bandwidth as a fraction of the configured
+ * theoretical HBM / NVLink peaks (roofline style). Intended as a regression gate: run with
+ * fixed parameters and track the per-stage numbers between builds.
+ *
+ * Example:
+ *   ./hugectr_bench --batch-size-per-gpu 8192 --num-tables 32 --vocab-size 1000000 \
+ *                   --ev-size 128 --hotness 10 --iters 100 --hbm-gb-s 2039 --nvlink-gb-s 300
+ */
+
+#include <cublas_v2.h>
+#include <cuda_runtime.h>
+
+#include <core/hctr_impl/hctr_backend.hpp>
+#include <core23/buffer_factory.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <embedding/data_distributor/data_distributor.hpp>
+#include <embedding/embedding.hpp>
+#include <embeddings/embedding_collection.hpp>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <resource_managers/resource_manager_core.hpp>
+#include <string>
+#include <vector>
+
+using namespace embedding;
+
+namespace {
+
+struct BenchParams {
+  int batch_size_per_gpu = 8192;
+  int num_tables = 26;
+  int vocab_size = 1000000;
+  int ev_size = 128;
+  int hotness = 1;
+  int niters = 100;
+  int warmup_iters = 10;
+  std::vector<int> mlp_layers{1024, 512, 256};
+  // Theoretical peaks used as roofline denominators. Defaults match an A100-80GB SXM node;
+  // override them for the hardware under test.
+  double hbm_gb_s = 2039.0;
+  double nvlink_gb_s = 300.0;
+  double ib_gb_s = 25.0;
+};
+
+void print_usage(const char* prog) {
+  std::cout
+      << "usage: " << prog << " [options]\n"
+      << "  --batch-size-per-gpu N   per-GPU batch size (default 8192)\n"
+      << "  --num-tables N           number of embedding tables/lookups (default 26)\n"
+      << "  --vocab-size N           vocabulary size per table (default 1000000)\n"
+      << "  --ev-size N              embedding vector size (default 128)\n"
+      << "  --hotness N              fixed hotness per lookup (default 1)\n"
+      << "  --iters N                measured iterations (default 100)\n"
+      << "  --warmup N               warmup iterations (default 10)\n"
+      << "  --mlp L0,L1,...          dense GEMM proxy layer sizes, empty to skip (default "
+         "1024,512,256)\n"
+      << "  --hbm-gb-s X             theoretical HBM bandwidth per GPU (default 2039)\n"
+      << "  --nvlink-gb-s X          theoretical NVLink bandwidth per GPU (default 300)\n"
+      << "  --ib-gb-s X              theoretical IB bandwidth per node (default 25)\n";
+}
+
+std::vector<int> parse_int_list(const std::string& s) {
+  std::vector<int> result;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      result.push_back(std::stoi(item));
+    }
+  }
+  return result;
+}
+
+BenchParams parse_args(int argc, char** argv) {
+  BenchParams params;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    auto next = [&]() -> const char* {
+      HCTR_CHECK_HINT(i + 1 < argc, "missing value for %s", arg.c_str());
+      return argv[++i];
+    };
+    if (arg == "--batch-size-per-gpu") {
+      params.batch_size_per_gpu = std::atoi(next());
+    } else if (arg == "--num-tables") {
+      params.num_tables = std::atoi(next());
+    } else if (arg == "--vocab-size") {
+      params.vocab_size = std::atoi(next());
+    } else if (arg == "--ev-size") {
+      params.ev_size = std::atoi(next());
+    } else if (arg == "--hotness") {
+      params.hotness = std::atoi(next());
+    } else if (arg == "--iters") {
+      params.niters = std::atoi(next());
+    } else if (arg == "--warmup") {
+      params.warmup_iters = std::atoi(next());
+    } else if (arg == "--mlp") {
+      params.mlp_layers = parse_int_list(next());
+    } else if (arg == "--hbm-gb-s") {
+      params.hbm_gb_s = std::atof(next());
+    } else if (arg == "--nvlink-gb-s") {
+      params.nvlink_gb_s = std::atof(next());
+    } else if (arg == "--ib-gb-s") {
+      params.ib_gb_s = std::atof(next());
+    } else {
+      print_usage(argv[0]);
+      exit(arg == "--help" ? 0 : -1);
+    }
+  }
+  return params;
+}
+
+/** Accumulates the per-iteration maximum across GPUs of one pipeline stage. */
+struct StageTimer {
+  std::string name;
+  double total_ms = 0.0;
+  int num_iters = 0;
+
+  void record(double iter_ms) {
+    total_ms += iter_ms;
+    num_iters++;
+  }
+  double mean_ms() const { return num_iters ? total_ms / num_iters : 0.0; }
+};
+
+void report_stage(const StageTimer& timer, double bytes_per_iter, double peak_gb_s,
+                  const char* peak_name) {
+  const double ms = timer.mean_ms();
+  const double gb_s = ms > 0 ? bytes_per_iter / (ms * 1e-3) / 1e9 : 0.0;
+  std::cout << std::left << std::setw(14) << timer.name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << ms << " ms" << std::setw(12)
+            << bytes_per_iter / 1e6 << " MB" << std::setw(10) << std::setprecision(1) << gb_s
+            << " GB/s" << std::setw(8) << (peak_gb_s > 0 ? gb_s / peak_gb_s * 100.0 : 0.0) << " %"
+            << "  (of " << peak_name << ")" << std::endl;
+}
+
+/** cuBLAS SGEMM stack standing in for the dense network, sized like a recommender MLP. */
+class DenseNetworkProxy {
+ public:
+  DenseNetworkProxy(const std::vector<int>& layer_sizes, int batch_size, int input_dim,
+                    cudaStream_t stream)
+      : layer_sizes_(layer_sizes), batch_size_(batch_size), stream_(stream) {
+    if (layer_sizes_.empty()) {
+      return;
+    }
+    HCTR_LIB_THROW(cublasCreate(&handle_));
+    HCTR_LIB_THROW(cublasSetStream(handle_, stream_));
+    int in_dim = input_dim;
+    for (int out_dim : layer_sizes_) {
+      float* weight;
+      float* activation;
+      HCTR_LIB_THROW(cudaMalloc(&weight, sizeof(float) * in_dim * out_dim));
+      HCTR_LIB_THROW(cudaMalloc(&activation, sizeof(float) * batch_size_ * out_dim));
+      HCTR_LIB_THROW(cudaMemset(weight, 0, sizeof(float) * in_dim * out_dim));
+      HCTR_LIB_THROW(cudaMemset(activation, 0, sizeof(float) * batch_size_ * out_dim));
+      weights_.push_back(weight);
+      activations_.push_back(activation);
+      in_dims_.push_back(in_dim);
+      in_dim = out_dim;
+    }
+  }
+
+  ~DenseNetworkProxy() {
+    for (float* p : weights_) {
+      cudaFree(p);
+    }
+    for (float* p : activations_) {
+      cudaFree(p);
+    }
+    if (handle_) {
+      cublasDestroy(handle_);
+    }
+  }
+
+  // One training step: forward GEMMs plus the two backward GEMMs (dgrad + wgrad) per layer.
+  void step(const float* input) {
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    const float* layer_input = input;
+    for (size_t i = 0; i < layer_sizes_.size(); i++) {
+      const int m = layer_sizes_[i];
+      const int k = in_dims_[i];
+      // Forward: activation = weight^T * input.
+      HCTR_LIB_THROW(cublasSgemm(handle_, CUBLAS_OP_T, CUBLAS_OP_N, m, batch_size_, k, &alpha,
+                                 weights_[i], k, layer_input, k, &beta, activations_[i], m));
+      layer_input = activations_[i];
+    }
+    for (size_t i = layer_sizes_.size(); i-- > 0;) {
+      const int m = layer_sizes_[i];
+      const int k = in_dims_[i];
+      const float* grad_in = activations_[i];
+      const float* act_in = i == 0 ? input : activations_[i - 1];
+      // Wgrad: weight += input * grad^T; dgrad: grad_out = weight * grad.
+      HCTR_LIB_THROW(cublasSgemm(handle_, CUBLAS_OP_N, CUBLAS_OP_T, k, m, batch_size_, &alpha,
+                                 act_in, k, grad_in, m, &beta, weights_[i], k));
+      if (i > 0) {
+        HCTR_LIB_THROW(cublasSgemm(handle_, CUBLAS_OP_N, CUBLAS_OP_N, k, batch_size_, m, &alpha,
+                                   weights_[i], k, grad_in, m, &beta,
+                                   const_cast<float*>(activations_[i - 1]), k));
+      }
+    }
+  }
+
+  double flops_per_step() const {
+    double flops = 0.0;
+    for (size_t i = 0; i < layer_sizes_.size(); i++) {
+      // Forward + dgrad + wgrad each cost 2*m*n*k.
+      flops += 3.0 * 2.0 * layer_sizes_[i] * in_dims_[i] * batch_size_;
+    }
+    return flops;
+  }
+
+  bool enabled() const { return !layer_sizes_.empty(); }
+
+ private:
+  std::vector<int> layer_sizes_;
+  std::vector<int> in_dims_;
+  std::vector<float*> weights_;
+  std::vector<float*> activations_;
+  int batch_size_;
+  cudaStream_t stream_;
+  cublasHandle_t handle_ = nullptr;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const BenchParams bench = parse_args(argc, argv);
+
+  int num_local_gpus = 0;
+  HCTR_LIB_THROW(cudaGetDeviceCount(&num_local_gpus));
+  HCTR_CHECK_HINT(num_local_gpus > 0, "no visible GPU");
+  const int num_global_gpus = num_local_gpus;  // single-node benchmark
+  const int batch_size = bench.batch_size_per_gpu * num_global_gpus;
+
+  std::vector<int> device_list_per_node(num_local_gpus);
+  std::iota(device_list_per_node.begin(), device_list_per_node.end(), 0);
+  auto resource_manager = HugeCTR::ResourceManagerCore::create({device_list_per_node}, 0);
+
+  std::vector<std::shared_ptr<core::CoreResourceManager>> core_list;
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    core_list.push_back(
+        std::make_shared<hctr_internal::HCTRCoreResourceManager>(resource_manager, gpu_id));
+  }
+
+  auto sync_gpus = [&]() {
+    for (auto& core : core_list) {
+      HugeCTR::CudaDeviceContext context(core->get_device_id());
+      HCTR_LIB_THROW(cudaStreamSynchronize(core->get_local_gpu()->get_stream()));
+    }
+  };
+
+  // All tables model-parallel, sharded across every GPU.
+  std::vector<EmbeddingTableParam> table_params;
+  std::vector<LookupParam> lookup_params;
+  HugeCTR::OptParams opt;
+  opt.optimizer = HugeCTR::Optimizer_t::SGD;
+  opt.lr = 0.01f;
+  opt.scaler = 1.f;
+  for (int table_id = 0; table_id < bench.num_tables; ++table_id) {
+    table_params.emplace_back(table_id, bench.vocab_size, bench.ev_size, opt);
+    lookup_params.emplace_back(table_id, table_id,
+                               bench.hotness == 1 ? Combiner::Concat : Combiner::Sum, bench.hotness,
+                               bench.ev_size);
+  }
+  std::vector<std::vector<int>> shard_matrix(
+      num_global_gpus, std::vector<int>(bench.num_tables, 1));
+  std::vector<int> all_table_ids(bench.num_tables);
+  std::iota(all_table_ids.begin(), all_table_ids.end(), 0);
+  std::vector<GroupedTableParam> grouped_table_params{
+      {TablePlacementStrategy::ModelParallel, all_table_ids}};
+
+  EmbeddingCollectionParam ebc_param(
+      bench.num_tables, bench.num_tables, lookup_params, shard_matrix, grouped_table_params,
+      batch_size, core23::ScalarType::UInt32, core23::ScalarType::UInt32,
+      core23::ScalarType::UInt32, core23::ScalarType::Float, core23::ScalarType::Float,
+      EmbeddingLayout::FeatureMajor, EmbeddingLayout::FeatureMajor, SortStrategy::Segmented,
+      KeysPreprocessStrategy::AddOffset, AllreduceStrategy::Dense, CommunicationStrategy::Uniform,
+      CompressionParam{});
+
+  // Synthetic inputs: one fixed batch of uniform keys per GPU, reused every iteration so the
+  // benchmark measures the pipeline rather than host-side generation.
+  std::vector<std::vector<core23::Tensor>> sparse_dp_tensors;
+  std::vector<std::vector<core23::Tensor>> sparse_dp_bucket_range;
+  std::vector<core23::Tensor> ebc_top_grads;
+  std::vector<core23::Tensor> ebc_output;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> key_dist(0, bench.vocab_size - 1);
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+    core23::Device device(core23::DeviceType::GPU, core_list[gpu_id]->get_device_id());
+    core23::TensorParams params = core23::TensorParams().device(device);
+
+    std::vector<core23::Tensor> keys_per_lookup;
+    std::vector<core23::Tensor> bucket_range_per_lookup;
+    for (int lookup_id = 0; lookup_id < bench.num_tables; ++lookup_id) {
+      keys_per_lookup.emplace_back(params.shape({bench.batch_size_per_gpu, bench.hotness})
+                                       .data_type(core23::ScalarType::UInt32));
+      bucket_range_per_lookup.emplace_back(
+          params.shape({bench.batch_size_per_gpu + 1}).data_type(core23::ScalarType::UInt32));
+
+      std::vector<uint32_t> h_keys(bench.batch_size_per_gpu * bench.hotness);
+      for (auto& key : h_keys) {
+        key = key_dist(gen);
+      }
+      std::vector<uint32_t> h_bucket_range(bench.batch_size_per_gpu + 1);
+      for (int i = 0; i <= bench.batch_size_per_gpu; ++i) {
+        h_bucket_range[i] = i * bench.hotness;
+      }
+      core23::copy_sync(keys_per_lookup.back(), h_keys);
+      core23::copy_sync(bucket_range_per_lookup.back(), h_bucket_range);
+    }
+    sparse_dp_tensors.push_back(std::move(keys_per_lookup));
+    sparse_dp_bucket_range.push_back(std::move(bucket_range_per_lookup));
+
+    int64_t num_ev = 0;
+    for (const auto& lookup_param : lookup_params) {
+      num_ev += (lookup_param.combiner == Combiner::Concat)
+                    ? lookup_param.ev_size * lookup_param.max_hotness
+                    : lookup_param.ev_size;
+    }
+    num_ev *= bench.batch_size_per_gpu;
+    ebc_top_grads.emplace_back(params.shape({num_ev}).data_type(core23::ScalarType::Float));
+    ebc_output.emplace_back(params.shape({num_ev}).data_type(core23::ScalarType::Float));
+  }
+
+  std::vector<int> dr_lookup_ids(bench.num_tables);
+  std::iota(dr_lookup_ids.begin(), dr_lookup_ids.end(), 0);
+  auto data_distributor = std::make_shared<HugeCTR::DataDistributor>(core_list, ebc_param,
+                                                                     table_params, dr_lookup_ids);
+  std::vector<HugeCTR::DataDistributor::Result> data_distributor_outputs;
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+    data_distributor_outputs.push_back(
+        HugeCTR::allocate_output_for_data_distributor(core_list[gpu_id], ebc_param));
+  }
+
+  auto ebc = std::make_unique<embedding::EmbeddingCollection>(resource_manager, core_list,
+                                                              ebc_param, ebc_param, table_params);
+
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    core23::Device device(core23::DeviceType::GPU, core_list[gpu_id]->get_device_id());
+    core23::AllocateBuffers(device);
+  }
+  core23::AllocateBuffers(core23::Device(core23::DeviceType::CPU));
+
+  // Dense network proxy per GPU, fed by the embedding output width.
+  const int64_t dense_input_dim = ebc_output[0].num_elements() / bench.batch_size_per_gpu;
+  std::vector<std::unique_ptr<DenseNetworkProxy>> dense_proxies;
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+    dense_proxies.push_back(std::make_unique<DenseNetworkProxy>(
+        bench.mlp_layers, bench.batch_size_per_gpu, static_cast<int>(dense_input_dim),
+        core_list[gpu_id]->get_local_gpu()->get_stream()));
+  }
+  sync_gpus();
+
+  // Per-stage cuda events, [gpu][stage boundary].
+  constexpr int kNumStages = 5;  // distribute, forward, dense, backward, update
+  const char* stage_names[kNumStages] = {"distribute", "emb_forward", "dense_proxy",
+                                         "emb_backward", "emb_update"};
+  std::vector<std::vector<cudaEvent_t>> events(num_local_gpus);
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+    events[gpu_id].resize(kNumStages + 1);
+    for (auto& event : events[gpu_id]) {
+      HCTR_LIB_THROW(cudaEventCreate(&event));
+    }
+  }
+
+  std::vector<StageTimer> timers(kNumStages);
+  for (int s = 0; s < kNumStages; ++s) {
+    timers[s].name = stage_names[s];
+  }
+
+  HCTR_LOG_S(INFO, ROOT) << "hugectr_bench: " << num_local_gpus << " GPUs, batch_size_per_gpu "
+                         << bench.batch_size_per_gpu << ", tables " << bench.num_tables
+                         << ", vocab " << bench.vocab_size << ", ev_size " << bench.ev_size
+                         << ", hotness " << bench.hotness << ", iters " << bench.niters
+                         << std::endl;
+
+  for (int iter = 0; iter < bench.warmup_iters + bench.niters; ++iter) {
+#pragma omp parallel for num_threads(num_local_gpus)
+    for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+      HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+      cudaStream_t stream = core_list[gpu_id]->get_local_gpu()->get_stream();
+
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][0], stream));
+      data_distributor->distribute(gpu_id, sparse_dp_tensors[gpu_id],
+                                   sparse_dp_bucket_range[gpu_id],
+                                   data_distributor_outputs[gpu_id], batch_size);
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][1], stream));
+      ebc->forward_per_gpu(true, gpu_id, data_distributor_outputs[gpu_id], ebc_output[gpu_id],
+                           batch_size);
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][2], stream));
+      if (dense_proxies[gpu_id]->enabled()) {
+        dense_proxies[gpu_id]->step(ebc_output[gpu_id].data<float>());
+      }
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][3], stream));
+      ebc->backward_per_gpu(gpu_id, data_distributor_outputs[gpu_id], ebc_top_grads[gpu_id],
+                            batch_size);
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][4], stream));
+      ebc->update_per_gpu(gpu_id);
+      HCTR_LIB_THROW(cudaEventRecord(events[gpu_id][5], stream));
+    }
+    sync_gpus();
+
+    if (iter >= bench.warmup_iters) {
+      for (int s = 0; s < kNumStages; ++s) {
+        float max_ms = 0.f;
+        for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+          float ms = 0.f;
+          HCTR_LIB_THROW(
+              cudaEventElapsedTime(&ms, events[gpu_id][s], events[gpu_id][s + 1]));
+          max_ms = std::max(max_ms, ms);
+        }
+        timers[s].record(max_ms);
+      }
+    }
+  }
+
+  // Roofline denominators. Byte counts are per GPU per iteration and intentionally coarse —
+  // they bound the minimum traffic of each stage, so the reported percentage is a lower bound
+  // on how close the stage runs to the respective peak.
+  const double keys_per_gpu =
+      static_cast<double>(bench.batch_size_per_gpu) * bench.num_tables * bench.hotness;
+  const double output_bytes_per_gpu =
+      static_cast<double>(ebc_output[0].num_elements()) * sizeof(float);
+  const double distribute_bytes = keys_per_gpu * sizeof(uint32_t);  // keys all2all
+  const double forward_hbm_bytes =
+      keys_per_gpu * bench.ev_size * sizeof(float) + output_bytes_per_gpu;  // gather + output
+  const double backward_hbm_bytes = forward_hbm_bytes;  // grad scatter mirrors the gather
+  const double update_hbm_bytes =
+      keys_per_gpu * bench.ev_size * sizeof(float) * 2;  // read + write touched rows
+
+  std::cout << "\nper-stage mean over " << bench.niters << " iterations (max across "
+            << num_local_gpus << " GPUs); IB peak for reference: " << bench.ib_gb_s << " GB/s\n";
+  report_stage(timers[0], distribute_bytes, bench.nvlink_gb_s, "NVLink");
+  report_stage(timers[1], forward_hbm_bytes, bench.hbm_gb_s, "HBM");
+  if (dense_proxies[0]->enabled()) {
+    const double ms = timers[2].mean_ms();
+    const double tflops =
+        ms > 0 ? dense_proxies[0]->flops_per_step() / (ms * 1e-3) / 1e12 : 0.0;
+    std::cout << std::left << std::setw(14) << timers[2].name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << ms << " ms" << std::setw(12) << tflops
+              << " TFLOP/s" << std::endl;
+  }
+  report_stage(timers[3], backward_hbm_bytes, bench.hbm_gb_s, "HBM");
+  report_stage(timers[4], update_hbm_bytes, bench.hbm_gb_s, "HBM");
+
+  double total_ms = 0.0;
+  for (const auto& timer : timers) {
+    total_ms += timer.mean_ms();
+  }
+  std::cout << std::left << std::setw(14) << "total" << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << total_ms << " ms  ("
+            << std::setprecision(0) << batch_size / (total_ms * 1e-3) << " samples/s)"
+            << std::endl;
+
+  for (int gpu_id = 0; gpu_id < num_local_gpus; ++gpu_id) {
+    HugeCTR::CudaDeviceContext context(core_list[gpu_id]->get_device_id());
+    for (auto& event : events[gpu_id]) {
+      HCTR_LIB_THROW(cudaEventDestroy(event));
+    }
+  }
+  return 0;
+}
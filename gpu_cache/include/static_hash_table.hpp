@@ -64,9 +64,21 @@ class StaticHashTable {
   void lookup(const key_type *keys, out_value_type *values, int num_keys,
               out_value_type default_value = 0, cudaStream_t stream = 0);
 
+  // In-place value update for keys that already exist in the table, so online
+  // refreshes do not need a rebuild or a second full-size value buffer.
+  // Each row is protected by a seqlock: its counter is odd while the row is
+  // being patched and concurrent lookup() calls retry instead of returning a
+  // torn vector. Keys not present in the table are skipped; pass a
+  // zero-initialized device counter as d_num_missing to count them.
+  // Note: like insert(), the keys of one update batch must not be duplicated.
+  void update(const key_type *keys, const value_type *values, size_type num_keys,
+              cudaStream_t stream = 0, const float *quant_scales = nullptr,
+              size_type *d_num_missing = nullptr);
+
  private:
   key_type *table_keys_;
   size_type *table_indices_;
+  unsigned int *row_locks_;
   int64_t key_capacity_;
 
   value_type *table_values_;
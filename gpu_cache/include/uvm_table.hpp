@@ -18,6 +18,7 @@
 
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace gpu_cache {
@@ -137,6 +138,19 @@ class UvmTable {
 
  private:
   static constexpr int num_buffers_ = 2;
+
+  // Promote host-resident rows that keep missing the device table into free device slots
+  // (HCTR_UVM_PROMOTION), so frequent keys stop paying the host gather on every lookup.
+  void promote_hot_keys_();
+
+  bool promotion_enabled_{false};
+  int promotion_threshold_{8};
+  float promotion_target_hit_rate_{0.9f};
+  size_t num_queried_keys_{0};
+  size_t num_missed_keys_{0};
+  std::unordered_map<key_type, int> h_miss_counts_;
+  std::vector<std::pair<key_type, index_type>> h_promotion_items_;
+
   key_type* d_keys_buffer_;
   vec_type* d_vectors_buffer_;
   vec_type* d_vectors_;
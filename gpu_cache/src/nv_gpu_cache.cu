@@ -584,108 +584,94 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
     size_t next_slab = warp_tile.shfl(src_slab, next_lane);
     size_t first_slab = next_slab;
 
-    // Counter to record how many slab have been searched
-    size_t counter = 0;
-
     // Variable to keep the min slot counter during the probing
     ref_counter_type min_slot_counter_val = max_ref_counter_type;
     // Variable to keep the slab distance for slot with min counter
     size_t slab_distance = max_slab_distance;
     // Variable to keep the slot distance for slot with min counter within the slab
     size_t slot_distance;
-    // Working queue before task started
-    const unsigned old_active_mask = active_mask;
+    // Position of the target key in the set after the probing sweep, -1 = not present
+    int hit_slab = -1;
+    int hit_lane = -1;
+    // Position of the first unused slot in the set after the probing sweep, -1 = set is full
+    int empty_slab = -1;
+    int empty_lane = -1;
 
     // Lock the slabset before operating the slabset
     warp_lock_mutex<mutex, warp_size>(warp_tile, set_mutex[next_set]);
 
-    // The warp-level inner loop: finish a single task in the work queue
-    while (active_mask == old_active_mask) {
-      // When all the slabs inside a slabset have been searched
-      // and no empty slots or target slots are found. Replace with LRU
-      if (counter >= set_associativity) {
-        // (sub)Warp all-reduction, the reduction result store in all threads
-        warp_min_reduction<ref_counter_type, warp_size>(warp_tile, min_slot_counter_val,
-                                                        slab_distance, slot_distance);
-
-        // Calculate the position of LR slot
-        size_t target_slab = (first_slab + slab_distance) % set_associativity;
-        size_t slot_index =
-            (next_set * set_associativity + target_slab) * warp_size + slot_distance;
-
-        // Replace the LR slot
-        if (lane_idx == (size_t)next_lane) {
-          keys[next_set].set_[target_slab].slab_[slot_distance] = key;
-          slot_counter[slot_index] = global_counter->load(cuda::std::memory_order_relaxed);
-        }
-
-        warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  vals + slot_index * embedding_vec_size,
-                                  d_values + next_idx * embedding_vec_size);
-
-        // Replace complete, mark this task completed
-        if (lane_idx == (size_t)next_lane) {
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
-      }
+    // Multi-probe sweep: the warp_tile evaluates every slab of the slabset in a single pass,
+    // collecting the key-match/empty-slot ballots and the LRU candidate together instead of
+    // re-probing slab-by-slab. The ballot results are warp-uniform, so the decision below
+    // needs no further communication
+#pragma unroll
+    for (int probe = 0; probe < set_associativity; probe++) {
+      const size_t probe_slab = (first_slab + probe) % set_associativity;
 
       // The warp_tile read out the slab
-      key_type read_key = keys[next_set].set_[next_slab].slab_[lane_idx];
+      key_type read_key = keys[next_set].set_[probe_slab].slab_[lane_idx];
 
       // Compare the slab data with the target key
       int found_lane = __ffs(warp_tile.ballot(read_key == next_key)) - 1;
-
-      // If found target key, the insertion/replace is no longer needed.
-      // Refresh the slot, the task is completed
-      if (found_lane >= 0) {
-        size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
-        if (lane_idx == (size_t)next_lane) {
-          slot_counter[found_offset] = global_counter->load(cuda::std::memory_order_relaxed);
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
+      if (found_lane >= 0 && hit_slab < 0) {
+        hit_slab = (int)probe_slab;
+        hit_lane = found_lane;
       }
 
-      // Compare the slab data with empty key.
-      // If found empty key, do insertion,the task is complete
+      // Compare the slab data with empty key
       found_lane = __ffs(warp_tile.ballot(read_key == empty_key)) - 1;
-      if (found_lane >= 0) {
-        size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
-
-        if (lane_idx == (size_t)next_lane) {
-          keys[next_set].set_[next_slab].slab_[found_lane] = key;
-          slot_counter[found_offset] = global_counter->load(cuda::std::memory_order_relaxed);
-        }
-
-        warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  vals + found_offset * embedding_vec_size,
-                                  d_values + next_idx * embedding_vec_size);
-
-        if (lane_idx == (size_t)next_lane) {
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
+      if (found_lane >= 0 && empty_slab < 0) {
+        empty_slab = (int)probe_slab;
+        empty_lane = found_lane;
       }
 
-      // If no target or unused slot found in this slab,
-      // Refresh LR info, continue probing
+      // Refresh LR info while the slab is at hand
       ref_counter_type read_slot_counter =
-          slot_counter[(next_set * set_associativity + next_slab) * warp_size + lane_idx];
+          slot_counter[(next_set * set_associativity + probe_slab) * warp_size + lane_idx];
       if (read_slot_counter < min_slot_counter_val) {
         min_slot_counter_val = read_slot_counter;
-        slab_distance = counter;
+        slab_distance = probe;
       }
+    }
 
-      counter++;
-      next_slab = (next_slab + 1) % set_associativity;
+    if (hit_slab >= 0) {
+      // Found target key, the insertion/replace is no longer needed.
+      // Refresh the slot, the task is completed
+      size_t found_offset = (next_set * set_associativity + hit_slab) * warp_size + hit_lane;
+      if (lane_idx == (size_t)next_lane) {
+        slot_counter[found_offset] = global_counter->load(cuda::std::memory_order_relaxed);
+      }
+    } else {
+      // Ballot-based victim selection: insert into the first unused slot if the set has one,
+      // otherwise replace the LR slot of the whole set
+      size_t target_slab;
+      size_t target_slot;
+      if (empty_slab >= 0) {
+        target_slab = empty_slab;
+        target_slot = empty_lane;
+      } else {
+        // (sub)Warp all-reduction, the reduction result store in all threads
+        warp_min_reduction<ref_counter_type, warp_size>(warp_tile, min_slot_counter_val,
+                                                        slab_distance, slot_distance);
+        target_slab = (first_slab + slab_distance) % set_associativity;
+        target_slot = slot_distance;
+      }
+      size_t slot_index = (next_set * set_associativity + target_slab) * warp_size + target_slot;
+
+      if (lane_idx == (size_t)next_lane) {
+        keys[next_set].set_[target_slab].slab_[target_slot] = key;
+        slot_counter[slot_index] = global_counter->load(cuda::std::memory_order_relaxed);
+      }
+
+      warp_tile_copy<warp_size>(lane_idx, embedding_vec_size, vals + slot_index * embedding_vec_size,
+                                d_values + next_idx * embedding_vec_size);
+    }
+
+    // Task completed, remove it from the work queue
+    if (lane_idx == (size_t)next_lane) {
+      active = false;
     }
+    active_mask = warp_tile.ballot(active);
 
     // Unlock the slabset after operating the slabset
     warp_unlock_mutex<mutex, warp_size>(warp_tile, set_mutex[next_set]);
@@ -743,108 +729,95 @@ __global__ void insert_replace_kernel(const key_type* d_keys, const float* d_val
     size_t next_slab = warp_tile.shfl(src_slab, next_lane);
     size_t first_slab = next_slab;
 
-    // Counter to record how many slab have been searched
-    size_t counter = 0;
-
     // Variable to keep the min slot counter during the probing
     ref_counter_type min_slot_counter_val = max_ref_counter_type;
     // Variable to keep the slab distance for slot with min counter
     size_t slab_distance = max_slab_distance;
     // Variable to keep the slot distance for slot with min counter within the slab
     size_t slot_distance;
-    // Working queue before task started
-    const unsigned old_active_mask = active_mask;
+    // Position of the target key in the set after the probing sweep, -1 = not present
+    int hit_slab = -1;
+    int hit_lane = -1;
+    // Position of the first unused slot in the set after the probing sweep, -1 = set is full
+    int empty_slab = -1;
+    int empty_lane = -1;
 
     // Lock the slabset before operating the slabset
     warp_lock_mutex<warp_size>(warp_tile, set_mutex[next_set]);
 
-    // The warp-level inner loop: finish a single task in the work queue
-    while (active_mask == old_active_mask) {
-      // When all the slabs inside a slabset have been searched
-      // and no empty slots or target slots are found. Replace with LRU
-      if (counter >= set_associativity) {
-        // (sub)Warp all-reduction, the reduction result store in all threads
-        warp_min_reduction<ref_counter_type, warp_size>(warp_tile, min_slot_counter_val,
-                                                        slab_distance, slot_distance);
-
-        // Calculate the position of LR slot
-        size_t target_slab = (first_slab + slab_distance) % set_associativity;
-        size_t slot_index =
-            (next_set * set_associativity + target_slab) * warp_size + slot_distance;
-
-        // Replace the LR slot
-        if (lane_idx == (size_t)next_lane) {
-          ((volatile key_type*)(keys[next_set].set_[target_slab].slab_))[slot_distance] = key;
-          slot_counter[slot_index] = atomicAdd(global_counter, 0);
-        }
-
-        warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  (volatile float*)(vals + slot_index * embedding_vec_size),
-                                  (volatile float*)(d_values + next_idx * embedding_vec_size));
-
-        // Replace complete, mark this task completed
-        if (lane_idx == (size_t)next_lane) {
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
-      }
+    // Multi-probe sweep: the warp_tile evaluates every slab of the slabset in a single pass,
+    // collecting the key-match/empty-slot ballots and the LRU candidate together instead of
+    // re-probing slab-by-slab. The ballot results are warp-uniform, so the decision below
+    // needs no further communication
+#pragma unroll
+    for (int probe = 0; probe < set_associativity; probe++) {
+      const size_t probe_slab = (first_slab + probe) % set_associativity;
 
       // The warp_tile read out the slab
-      key_type read_key = ((volatile key_type*)(keys[next_set].set_[next_slab].slab_))[lane_idx];
+      key_type read_key = ((volatile key_type*)(keys[next_set].set_[probe_slab].slab_))[lane_idx];
 
       // Compare the slab data with the target key
       int found_lane = __ffs(warp_tile.ballot(read_key == next_key)) - 1;
-
-      // If found target key, the insertion/replace is no longer needed.
-      // Refresh the slot, the task is completed
-      if (found_lane >= 0) {
-        size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
-        if (lane_idx == (size_t)next_lane) {
-          slot_counter[found_offset] = atomicAdd(global_counter, 0);
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
+      if (found_lane >= 0 && hit_slab < 0) {
+        hit_slab = (int)probe_slab;
+        hit_lane = found_lane;
       }
 
-      // Compare the slab data with empty key.
-      // If found empty key, do insertion,the task is complete
+      // Compare the slab data with empty key
       found_lane = __ffs(warp_tile.ballot(read_key == empty_key)) - 1;
-      if (found_lane >= 0) {
-        size_t found_offset = (next_set * set_associativity + next_slab) * warp_size + found_lane;
-
-        if (lane_idx == (size_t)next_lane) {
-          ((volatile key_type*)(keys[next_set].set_[next_slab].slab_))[found_lane] = key;
-          slot_counter[found_offset] = atomicAdd(global_counter, 0);
-        }
-
-        warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
-                                  (volatile float*)(vals + found_offset * embedding_vec_size),
-                                  (volatile float*)(d_values + next_idx * embedding_vec_size));
-
-        if (lane_idx == (size_t)next_lane) {
-          active = false;
-        }
-
-        active_mask = warp_tile.ballot(active);
-        break;
+      if (found_lane >= 0 && empty_slab < 0) {
+        empty_slab = (int)probe_slab;
+        empty_lane = found_lane;
       }
 
-      // If no target or unused slot found in this slab,
-      // Refresh LR info, continue probing
+      // Refresh LR info while the slab is at hand
       ref_counter_type read_slot_counter =
-          slot_counter[(next_set * set_associativity + next_slab) * warp_size + lane_idx];
+          slot_counter[(next_set * set_associativity + probe_slab) * warp_size + lane_idx];
       if (read_slot_counter < min_slot_counter_val) {
         min_slot_counter_val = read_slot_counter;
-        slab_distance = counter;
+        slab_distance = probe;
       }
+    }
 
-      counter++;
-      next_slab = (next_slab + 1) % set_associativity;
+    if (hit_slab >= 0) {
+      // Found target key, the insertion/replace is no longer needed.
+      // Refresh the slot, the task is completed
+      size_t found_offset = (next_set * set_associativity + hit_slab) * warp_size + hit_lane;
+      if (lane_idx == (size_t)next_lane) {
+        slot_counter[found_offset] = atomicAdd(global_counter, 0);
+      }
+    } else {
+      // Ballot-based victim selection: insert into the first unused slot if the set has one,
+      // otherwise replace the LR slot of the whole set
+      size_t target_slab;
+      size_t target_slot;
+      if (empty_slab >= 0) {
+        target_slab = empty_slab;
+        target_slot = empty_lane;
+      } else {
+        // (sub)Warp all-reduction, the reduction result store in all threads
+        warp_min_reduction<ref_counter_type, warp_size>(warp_tile, min_slot_counter_val,
+                                                        slab_distance, slot_distance);
+        target_slab = (first_slab + slab_distance) % set_associativity;
+        target_slot = slot_distance;
+      }
+      size_t slot_index = (next_set * set_associativity + target_slab) * warp_size + target_slot;
+
+      if (lane_idx == (size_t)next_lane) {
+        ((volatile key_type*)(keys[next_set].set_[target_slab].slab_))[target_slot] = key;
+        slot_counter[slot_index] = atomicAdd(global_counter, 0);
+      }
+
+      warp_tile_copy<warp_size>(lane_idx, embedding_vec_size,
+                                (volatile float*)(vals + slot_index * embedding_vec_size),
+                                (volatile float*)(d_values + next_idx * embedding_vec_size));
+    }
+
+    // Task completed, remove it from the work queue
+    if (lane_idx == (size_t)next_lane) {
+      active = false;
     }
+    active_mask = warp_tile.ballot(active);
 
     // Unlock the slabset after operating the slabset
     warp_unlock_mutex<warp_size>(warp_tile, set_mutex[next_set]);
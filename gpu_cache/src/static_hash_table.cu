@@ -252,12 +252,31 @@ __forceinline__ __device__ void warp_tile_copy(const size_t lane_idx,
   }
 }
 
+// Per-row seqlock: the counter is odd while update() is patching the row and
+// is bumped to the next even value when the writer is done. Readers snapshot
+// the counter before and after copying a row and retry if it was odd or
+// changed in between.
+__device__ __forceinline__ unsigned int row_seq_begin(const unsigned int *row_lock) {
+  unsigned int seq;
+  do {
+    seq = *(volatile const unsigned int *)row_lock;
+  } while (seq & 1);
+  __threadfence();
+  return seq;
+}
+
+__device__ __forceinline__ bool row_seq_changed(const unsigned int *row_lock, unsigned int seq) {
+  __threadfence();
+  return *(volatile const unsigned int *)row_lock != seq;
+}
+
 template <unsigned int tile_size, unsigned int group_size, typename key_type, typename value_type,
           typename out_value_type, typename size_type, typename hasher>
-__global__ void LookupKernel(key_type *table_keys, size_type *table_indices, float *quant_scales_,
-                             int64_t capacity, const key_type *keys, int num_keys,
-                             const value_type *values, int value_dim, out_value_type *output,
-                             hasher hash, const key_type empty_key, out_value_type default_value,
+__global__ void LookupKernel(key_type *table_keys, size_type *table_indices,
+                             unsigned int *row_locks, float *quant_scales_, int64_t capacity,
+                             const key_type *keys, int num_keys, const value_type *values,
+                             int value_dim, out_value_type *output, hasher hash,
+                             const key_type empty_key, out_value_type default_value,
                              const size_type invalid_slot) {
   static_assert(tile_size <= group_size, "tile_size cannot be larger than group_size");
   constexpr int WARP_SIZE = 32;
@@ -296,16 +315,104 @@ __global__ void LookupKernel(key_type *table_keys, size_type *table_indices, flo
       }
       auto index = table_indices[slot_to_read];
 
-      if constexpr (nv::is_fp8<value_type>::value) {
-        float scale;
-        scale = quant_scales_[index];
-        warp_tile_quant_copy<WARP_SIZE, value_type>(warp_tile.thread_rank(), value_dim,
-                                                    output + (size_t)value_dim * idx_to_write,
-                                                    values + (size_t)value_dim * index, scale);
+      // Seqlock read: if a concurrent update() is patching this row, or patched
+      // it while we were copying, copy the row again.
+      unsigned int retry = 0;
+      do {
+        unsigned int seq = 0;
+        if (warp_tile.thread_rank() == 0) {
+          seq = row_seq_begin(row_locks + index);
+        }
+        warp_tile.sync();
+
+        if constexpr (nv::is_fp8<value_type>::value) {
+          float scale;
+          scale = quant_scales_[index];
+          warp_tile_quant_copy<WARP_SIZE, value_type>(warp_tile.thread_rank(), value_dim,
+                                                      output + (size_t)value_dim * idx_to_write,
+                                                      values + (size_t)value_dim * index, scale);
+        } else {
+          warp_tile_copy<WARP_SIZE, value_type>(warp_tile.thread_rank(), value_dim,
+                                                output + (size_t)value_dim * idx_to_write,
+                                                values + (size_t)value_dim * index);
+        }
+
+        warp_tile.sync();
+        if (warp_tile.thread_rank() == 0) {
+          retry = row_seq_changed(row_locks + index, seq) ? 1 : 0;
+        }
+        retry = warp_tile.shfl(retry, 0);
+      } while (retry);
+    }
+  }
+}
+
+template <unsigned int tile_size, unsigned int group_size, typename key_type, typename value_type,
+          typename size_type, typename hasher>
+__global__ void UpdateKernel(key_type *table_keys, size_type *table_indices,
+                             unsigned int *row_locks, value_type *table_values,
+                             float *table_quant_scales, int64_t capacity, const key_type *keys,
+                             size_type num_keys, const value_type *values,
+                             const float *quant_scales, int value_dim, hasher hash,
+                             const key_type empty_key, const size_type invalid_slot,
+                             size_type *num_missing) {
+  static_assert(tile_size <= group_size, "tile_size cannot be larger than group_size");
+  constexpr int WARP_SIZE = 32;
+  static_assert(WARP_SIZE % tile_size == 0, "tile_size must be divisible by warp_size");
+
+  auto block = cooperative_groups::this_thread_block();
+  auto tile = cooperative_groups::tiled_partition<tile_size>(block);
+  auto warp_tile = cooperative_groups::tiled_partition<WARP_SIZE>(block);
+
+  int tile_idx = tile.meta_group_size() * block.group_index().x + tile.meta_group_rank();
+  int tile_cnt = tile.meta_group_size() * gridDim.x;
+
+  for (int it = 0; it < ((int)num_keys - 1) / tile_cnt + 1; it++) {
+    size_type slot = invalid_slot;
+    int key_num = it * tile_cnt + tile_idx;
+    if (key_num < (int)num_keys) {
+      key_type key = keys[key_num];
+      if (key == empty_key) {
+        if (tile.thread_rank() == 0 && table_keys[capacity] == key) {
+          slot = capacity;
+        }
       } else {
-        warp_tile_copy<WARP_SIZE, value_type>(warp_tile.thread_rank(), value_dim,
-                                              output + (size_t)value_dim * idx_to_write,
-                                              values + (size_t)value_dim * index);
+        slot = lookup<group_size>(table_keys, capacity, key, hash, tile, empty_key, invalid_slot);
+      }
+    }
+    for (int i = 0; i < WARP_SIZE / tile_size; i++) {
+      auto slot_to_write = warp_tile.shfl(slot, i * tile_size);
+      int idx_to_read = warp_tile.shfl(key_num, 0) + i;
+      if (idx_to_read >= (int)num_keys) break;
+      if (slot_to_write == invalid_slot) {
+        if (warp_tile.thread_rank() == 0 && num_missing != nullptr) {
+          atomicAdd(num_missing, (size_type)1);
+        }
+        continue;
+      }
+      auto index = table_indices[slot_to_write];
+
+      // Writer side of the per-row seqlock: mark the row odd, patch it, then
+      // bump the counter to the next even value so readers can validate.
+      if (warp_tile.thread_rank() == 0) {
+        atomicAdd(row_locks + index, 1);
+        __threadfence();
+      }
+      warp_tile.sync();
+
+      for (size_t j = warp_tile.thread_rank(); j < (size_t)value_dim; j += WARP_SIZE) {
+        table_values[(size_t)value_dim * index + j] = values[(size_t)value_dim * idx_to_read + j];
+      }
+      if constexpr (nv::is_fp8<value_type>::value) {
+        if (warp_tile.thread_rank() == 0) {
+          table_quant_scales[index] = quant_scales[idx_to_read];
+        }
+      }
+
+      __threadfence();
+      warp_tile.sync();
+      if (warp_tile.thread_rank() == 0) {
+        atomicAdd(row_locks + index, 1);
       }
     }
   }
@@ -318,6 +425,7 @@ StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size,
                                          hasher hash)
     : table_keys_(nullptr),
       table_indices_(nullptr),
+      row_locks_(nullptr),
       key_capacity_(capacity * 2),
       table_values_(nullptr),
       value_capacity_(capacity),
@@ -349,6 +457,9 @@ StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size,
   size_t num_values = (value_capacity_ * value_dim_ + align_m - 1) / align_m * align_m;
   CUDA_CHECK(cudaMalloc(&table_keys_, sizeof(key_type) * num_keys));
   CUDA_CHECK(cudaMalloc(&table_indices_, sizeof(size_type) * num_keys));
+  // Per-row seqlocks for update(), one counter per value row
+  CUDA_CHECK(cudaMalloc(&row_locks_, sizeof(unsigned int) * value_capacity_));
+  CUDA_CHECK(cudaMemset(row_locks_, 0, sizeof(unsigned int) * value_capacity_));
 // Allocate embedding on host
 #ifdef USE_HUGE_PAGES
   // Align size at hugepage boundaries.
@@ -430,6 +541,7 @@ void StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size
     cudaStream_t stream) {
   CUDA_CHECK(cudaMemsetAsync(table_keys_, 0xff, sizeof(key_type) * key_capacity_, stream));
   CUDA_CHECK(cudaMemsetAsync(table_keys_ + key_capacity_, 0, sizeof(key_type), stream));
+  CUDA_CHECK(cudaMemsetAsync(row_locks_, 0, sizeof(unsigned int) * value_capacity_, stream));
   size_ = 0;
 }
 
@@ -439,6 +551,7 @@ StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size,
                 hasher>::~StaticHashTable() {
   CUDA_CHECK(cudaFree(table_keys_));
   CUDA_CHECK(cudaFree(table_indices_));
+  CUDA_CHECK(cudaFree(row_locks_));
 
 #ifdef USE_HUGE_PAGES
   if (table_values_) {
@@ -481,11 +594,28 @@ void StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size
   const int grid = (num_keys - 1) / block + 1;
   // Lookup keys
   LookupKernel<tile_size, group_size><<<grid, block, 0, stream>>>(
-      table_keys_, table_indices_, quant_scales_, key_capacity_, keys, num_keys, table_values_,
-      value_dim_, values, hash_, empty_key, default_value, invalid_slot);
+      table_keys_, table_indices_, row_locks_, quant_scales_, key_capacity_, keys, num_keys,
+      table_values_, value_dim_, values, hash_, empty_key, default_value, invalid_slot);
   CUDA_CHECK(cudaStreamSynchronize(stream));
 }
 
+template <typename key_type, typename value_type, typename out_value_type, unsigned int tile_size,
+          unsigned int group_size, typename hasher>
+void StaticHashTable<key_type, value_type, out_value_type, tile_size, group_size, hasher>::update(
+    const key_type *keys, const value_type *values, size_type num_keys, cudaStream_t stream,
+    const float *quant_scales, size_type *d_num_missing) {
+  if (num_keys == 0) {
+    return;
+  }
+
+  constexpr int block = 256;
+  const int grid = (num_keys - 1) / block + 1;
+  // Patch values in place; rows are marked with their seqlock while written
+  UpdateKernel<tile_size, group_size><<<grid, block, 0, stream>>>(
+      table_keys_, table_indices_, row_locks_, table_values_, quant_scales_, key_capacity_, keys,
+      num_keys, values, quant_scales, value_dim_, hash_, empty_key, invalid_slot, d_num_missing);
+}
+
 template class StaticHashTable<uint32_t, float, float>;
 template class StaticHashTable<uint32_t, __nv_fp8_e4m3, float>;
 template class StaticHashTable<uint32_t, __nv_fp8_e4m3, __nv_fp8_e4m3>;
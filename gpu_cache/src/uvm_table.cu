@@ -18,6 +18,7 @@
 #include <cuda_runtime_api.h>
 
 #include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <mutex>
@@ -312,6 +313,16 @@ UvmTable<key_type, index_type, vec_type>::UvmTable(const size_t device_table_cap
   CUDA_CHECK(cudaMallocHost(&h_missing_keys_, sizeof(key_type) * max_batch_size_));
   CUDA_CHECK(cudaEventCreate(&query_event_));
   h_vectors_.resize(host_table_.capacity * vec_size_);
+
+  if (const char* env = std::getenv("HCTR_UVM_PROMOTION"); env && std::atoi(env) != 0) {
+    promotion_enabled_ = true;
+    if (const char* threshold = std::getenv("HCTR_UVM_PROMOTION_THRESHOLD")) {
+      promotion_threshold_ = std::max(1, std::atoi(threshold));
+    }
+    if (const char* hit_rate = std::getenv("HCTR_UVM_PROMOTION_HIT_RATE")) {
+      promotion_target_hit_rate_ = std::atof(hit_rate);
+    }
+  }
 }
 
 template <typename key_type, typename index_type, typename vec_type>
@@ -493,12 +504,99 @@ void UvmTable<key_type, index_type, vec_type>::query(const key_type* d_keys, con
     CUDA_CHECK(cudaEventRecord(cpy_events_[i], cpy_streams_[i]));
     CUDA_CHECK(cudaStreamWaitEvent(stream, cpy_events_[i]));
   }
+
+  if (promotion_enabled_) {
+    // Track how often each host-resident key misses the device table. Keys that keep missing are
+    // queued with their host index and promoted into free device slots in batches, so they stop
+    // paying the host gather above on every lookup.
+    num_queried_keys_ += num_keys;
+    num_missed_keys_ += num_missing_keys;
+    if (num_queried_keys_ >= 1000ul * max_batch_size_) {
+      // Steer the promotion aggressiveness by the observed device hit rate
+      float hit_rate = 1.0f - 1.0f * num_missed_keys_ / num_queried_keys_;
+      if (hit_rate < promotion_target_hit_rate_) {
+        promotion_threshold_ = std::max(1, promotion_threshold_ / 2);
+      } else {
+        promotion_threshold_ = std::min(64, promotion_threshold_ * 2);
+      }
+      num_queried_keys_ = 0;
+      num_missed_keys_ = 0;
+    }
+    for (int i = 0; i < num_missing_keys; i++) {
+      index_type index = h_output_host_indices_[i];
+      if (index == std::numeric_limits<index_type>::max()) {
+        auto iterator = h_final_missing_items_.find(h_missing_keys_[i]);
+        if (iterator == h_final_missing_items_.end()) continue;
+        index = iterator->second;
+      }
+      if (++h_miss_counts_[h_missing_keys_[i]] >= promotion_threshold_) {
+        h_promotion_items_.emplace_back(h_missing_keys_[i], index);
+        // Park the counter far below any threshold so a queued key cannot be queued again before
+        // the batch is flushed; hash_add_kernel does not filter duplicates
+        h_miss_counts_[h_missing_keys_[i]] = std::numeric_limits<int>::min();
+      }
+    }
+    // Crude aging: cold keys accumulate in the counter map forever otherwise
+    if (h_miss_counts_.size() > 4 * device_table_.capacity) {
+      h_miss_counts_.clear();
+    }
+    if (h_promotion_items_.size() >= 1024 ||
+        h_promotion_items_.size() >= static_cast<size_t>(max_batch_size_)) {
+      promote_hot_keys_();
+    }
+  }
+}
+
+template <typename key_type, typename index_type, typename vec_type>
+void UvmTable<key_type, index_type, vec_type>::promote_hot_keys_() {
+  const int num_keys =
+      static_cast<int>(std::min(h_promotion_items_.size(), static_cast<size_t>(max_batch_size_)));
+
+  // The promotion reuses the query scratch buffers, so all in-flight work of this table must have
+  // drained before they are overwritten
+  CUDA_CHECK(cudaStreamSynchronize(query_stream_));
+  for (int i = 0; i < num_buffers_; i++) {
+    CUDA_CHECK(cudaStreamSynchronize(cpy_streams_[i]));
+  }
+
+  std::vector<key_type> h_keys_buffer(num_keys);
+  std::vector<vec_type> h_vectors_buffer(static_cast<size_t>(num_keys) * vec_size_);
+  for (int i = 0; i < num_keys; i++) {
+    h_keys_buffer[i] = h_promotion_items_[i].first;
+    memcpy(h_vectors_buffer.data() + static_cast<size_t>(i) * vec_size_,
+           h_vectors_.data() + h_promotion_items_[i].second * vec_size_,
+           sizeof(vec_type) * vec_size_);
+  }
+
+  CUDA_CHECK(cudaMemcpy(d_keys_buffer_, h_keys_buffer.data(), sizeof(key_type) * num_keys,
+                        cudaMemcpyHostToDevice));
+  CUDA_CHECK(cudaMemset(d_missing_count_, 0, sizeof(*d_missing_count_)));
+  // Adding only fills free slots; keys whose set is full are rejected and simply stay host-resident
+  device_table_.add(d_keys_buffer_, num_keys, d_missing_keys_, d_missing_count_, 0);
+  // Query back the slot of every accepted key; rejected keys resolve to the max sentinel, which
+  // distribute_vectors_kernel skips
+  device_table_.query(d_keys_buffer_, num_keys, d_output_indices_, nullptr, nullptr, nullptr, 0);
+  CUDA_CHECK(cudaMemcpy(d_vectors_buffer_, h_vectors_buffer.data(),
+                        sizeof(vec_type) * num_keys * vec_size_, cudaMemcpyHostToDevice));
+  distribute_vectors_kernel<<<(num_keys - 1) / block_size + 1, block_size, 0, 0>>>(
+      d_output_indices_, num_keys, d_vectors_buffer_, vec_size_, d_vectors_);
+  CUDA_CHECK(cudaStreamSynchronize(0));
+  CUDA_CHECK(cudaMemset(d_missing_count_, 0, sizeof(*d_missing_count_)));
+
+  for (const auto& item : h_promotion_items_) {
+    h_miss_counts_.erase(item.first);
+  }
+  h_promotion_items_.clear();
 }
 
 template <typename key_type, typename index_type, typename vec_type>
 void UvmTable<key_type, index_type, vec_type>::clear(cudaStream_t stream) {
   device_table_.clear(stream);
   host_table_.clear(stream);
+  h_miss_counts_.clear();
+  h_promotion_items_.clear();
+  num_queried_keys_ = 0;
+  num_missed_keys_ = 0;
 }
 
 template <typename key_type, typename index_type, typename vec_type>
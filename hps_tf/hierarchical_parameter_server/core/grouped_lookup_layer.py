@@ -0,0 +1,120 @@
+"""
+ Copyright (c) 2023, NVIDIA CORPORATION.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+"""
+
+import tensorflow as tf
+from hierarchical_parameter_server.core import lookup_ops
+
+
+class GroupedLookupLayer(tf.keras.layers.Layer):
+    """
+    Abbreviated as ``hps.GroupedLookupLayer(*args, **kwargs)``.
+
+    This layer queries several embedding tables of one model with a single
+    TF op dispatch, which is functionally equivalent to one ``hps.LookupLayer``
+    per table but avoids paying the TF executor overhead once per table. It is
+    recommended for models with many tables. Note that ``ps_config_file``
+    and ``global_batch_size`` should be specified in the constructor if you want
+    to use implicit HPS initialization.
+
+    Parameters
+    ----------
+    model_name: str
+            The name of the model that has embedding tables.
+    table_ids: list of int
+            The indices of the embedding tables for the model specified by
+            model_name.
+    emb_vec_sizes: list of int
+            The embedding vector size of each embedding table specified
+            by model_name and table_ids.
+    emb_vec_dtype:
+            The data type of embedding vectors which must be ``tf.float32``.
+    ps_config_file: str
+            The JSON configuration file for HPS initialization.
+    global_batch_size: int
+            The global batch size for HPS that is deployed on multiple GPUs.
+
+    Examples
+    --------
+    .. code-block:: python
+
+        import hierarchical_parameter_server as hps
+
+        grouped_lookup_layer = hps.GroupedLookupLayer(model_name = args.model_name,
+                                                      table_ids = [0, 1, 2],
+                                                      emb_vec_sizes = [16, 16, 32],
+                                                      emb_vec_dtype = tf.float32,
+                                                      ps_config_file = args.ps_config_file,
+                                                      global_batch_size = args.global_batch_size)
+
+        @tf.function
+        def _infer_step(inputs_per_table):
+            embedding_vectors = grouped_lookup_layer(inputs_per_table)
+            ...
+
+        for i, (inputs_per_table, labels) in enumerate(dataset):
+            _infer_step(inputs_per_table)
+    """
+
+    def __init__(
+        self,
+        model_name,
+        table_ids,
+        emb_vec_sizes,
+        emb_vec_dtype,
+        ps_config_file="",
+        global_batch_size=1,
+        **kwargs
+    ):
+        super(GroupedLookupLayer, self).__init__(**kwargs)
+        self.model_name = model_name
+        self.table_ids = table_ids
+        self.emb_vec_sizes = emb_vec_sizes
+        self.emb_vec_dtype = emb_vec_dtype
+        self.ps_config_file = ps_config_file
+        self.global_batch_size = global_batch_size
+
+    def call(self, ids_list, max_norm=None):
+        """
+        The forward logic of this wrapper class.
+
+        Parameters
+        ----------
+        ids_list: list of tf.Tensor
+                Keys of all tables, one dense tensor per table. All tensors must
+                have the same data type, which can be ``tf.int32`` or ``tf.int64``.
+        max_norm:
+            if not ``None``, each embedding is clipped if its l2-norm is larger
+            than this value.
+
+        Returns
+        -------
+        emb_vectors: list of ``tf.Tensor`` of float32
+                the embedding vectors for the input keys of each table. The shape
+                of the i-th entry is *ids_list[i].get_shape() + emb_vec_sizes[i]*.
+        """
+        emb_vectors = lookup_ops.grouped_lookup(
+            ids_list=ids_list,
+            model_name=self.model_name,
+            table_ids=self.table_ids,
+            emb_vec_sizes=self.emb_vec_sizes,
+            emb_vec_dtype=self.emb_vec_dtype,
+            ps_config_file=self.ps_config_file,
+            global_batch_size=self.global_batch_size,
+            max_norm=max_norm,
+        )
+        for ids, emb_vector, emb_vec_size in zip(ids_list, emb_vectors, self.emb_vec_sizes):
+            emb_vector.set_shape(ids.get_shape() + emb_vec_size)
+        return emb_vectors
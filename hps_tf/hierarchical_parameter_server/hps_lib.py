@@ -55,4 +55,5 @@ if lib_file is None:
     raise FileNotFoundError("Could not find %s" % lib_name)
 hps_ops = load_library.load_op_library(lib_file)
 lookup = hps_ops.lookup
+grouped_lookup = hps_ops.grouped_lookup
 init = hps_ops.init
@@ -160,7 +160,140 @@ class Lookup : public OpKernel {
 };
 #endif
 
+#ifdef HPS_ASYNC_OP
+template <typename Device>
+class GroupedLookup : public AsyncOpKernel {
+ public:
+  explicit GroupedLookup(OpKernelConstruction *ctx) : AsyncOpKernel(ctx), thread_pool_("", 1) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("model_name", &model_name_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("table_ids", &table_ids_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("emb_vec_sizes", &emb_vec_sizes_));
+    OP_REQUIRES(ctx, table_ids_.size() == emb_vec_sizes_.size(),
+                errors::InvalidArgument("table_ids and emb_vec_sizes must have the same length."));
+  }
+
+  void ComputeAsync(OpKernelContext *ctx, DoneCallback done) override {
+    auto work_func = [this, ctx, done]() {
+      auto stream = ctx->op_device_context()->stream();
+      ScopedActivateExecutorContext scoped_activation{stream->parent()};
+      cudaStream_t gpu_stream = AsGpuStreamValue(stream);
+
+      Tensor const *status_tensor = nullptr;
+      OP_REQUIRES_OK_ASYNC(ctx, ctx->input("init_status", &status_tensor), done);
+      std::string init_status = status_tensor->flat<tstring>()(0);
+      OP_REQUIRES_ASYNC(ctx, init_status == "OK",
+                        errors::Aborted("hierarchical parameter server is not initialized."), done);
+
+      OpInputList values_list;
+      OP_REQUIRES_OK_ASYNC(ctx, ctx->input_list("values", &values_list), done);
+      OP_REQUIRES_ASYNC(ctx, values_list.size() == static_cast<int>(table_ids_.size()),
+                        errors::InvalidArgument("values must provide one key tensor per table."),
+                        done);
+
+      Tensor const *global_replica_id_tensor = nullptr;
+      OP_REQUIRES_OK_ASYNC(ctx, ctx->input("global_replica_id", &global_replica_id_tensor), done);
+      const int32_t global_replica_id_value = global_replica_id_tensor->scalar<int32_t>()();
+
+      // do forward propagation for all tables on the same stream
+      try {
+        for (int i = 0; i < values_list.size(); ++i) {
+          const Tensor &values_tensor = values_list[i];
+
+          Tensor *emb_vector_tensor = nullptr;
+          TensorShape emb_vector_tensor_shape = values_tensor.shape();
+          emb_vector_tensor_shape.AppendShape({emb_vec_sizes_[i]});
+          OP_REQUIRES_OK_ASYNC(
+              ctx, ctx->allocate_output(i, emb_vector_tensor_shape, &emb_vector_tensor), done);
+
+          size_t num_keys = static_cast<size_t>(values_tensor.NumElements());
+          bool i64_input_tensor = DT_INT64 == values_tensor.dtype();
+          Facade::instance()->forward(model_name_.c_str(), table_ids_[i], global_replica_id_value,
+                                      num_keys, static_cast<size_t>(emb_vec_sizes_[i]),
+                                      values_tensor.data(), emb_vector_tensor->data(),
+                                      i64_input_tensor, gpu_stream);
+        }
+      } catch (std::exception const &error) {
+        ctx->SetStatus(errors::Aborted(error.what()));
+        done();
+        return;
+      }
+      done();
+    };
+    thread_pool_.submit(work_func);
+  }
+
+ private:
+  std::string model_name_;
+  std::vector<tensorflow::int32> table_ids_;
+  std::vector<tensorflow::int32> emb_vec_sizes_;
+  HugeCTR::ThreadPool thread_pool_;
+};
+
+#else
+template <typename Device>
+class GroupedLookup : public OpKernel {
+ public:
+  explicit GroupedLookup(OpKernelConstruction *ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("model_name", &model_name_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("table_ids", &table_ids_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("emb_vec_sizes", &emb_vec_sizes_));
+    OP_REQUIRES(ctx, table_ids_.size() == emb_vec_sizes_.size(),
+                errors::InvalidArgument("table_ids and emb_vec_sizes must have the same length."));
+  }
+
+  void Compute(OpKernelContext *ctx) override {
+    cudaStream_t gpu_stream = AsGpuStreamValue(ctx->op_device_context()->stream());
+
+    Tensor const *status_tensor = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->input("init_status", &status_tensor));
+    std::string init_status = status_tensor->flat<tstring>()(0);
+    OP_REQUIRES(ctx, init_status == "OK",
+                errors::Aborted("hierarchical parameter server is not initialized."));
+
+    OpInputList values_list;
+    OP_REQUIRES_OK(ctx, ctx->input_list("values", &values_list));
+    OP_REQUIRES(ctx, values_list.size() == static_cast<int>(table_ids_.size()),
+                errors::InvalidArgument("values must provide one key tensor per table."));
+
+    Tensor const *global_replica_id_tensor = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->input("global_replica_id", &global_replica_id_tensor));
+    const int32_t global_replica_id_value = global_replica_id_tensor->scalar<int32_t>()();
+
+    // do forward propagation for all tables on the same stream
+    try {
+      for (int i = 0; i < values_list.size(); ++i) {
+        const Tensor &values_tensor = values_list[i];
+
+        Tensor *emb_vector_tensor = nullptr;
+        TensorShape emb_vector_tensor_shape = values_tensor.shape();
+        emb_vector_tensor_shape.AppendShape({emb_vec_sizes_[i]});
+        OP_REQUIRES_OK(ctx, ctx->allocate_output(i, emb_vector_tensor_shape, &emb_vector_tensor));
+
+        size_t num_keys = static_cast<size_t>(values_tensor.NumElements());
+        bool i64_input_tensor = DT_INT64 == values_tensor.dtype();
+        Facade::instance()->forward(model_name_.c_str(), table_ids_[i], global_replica_id_value,
+                                    num_keys, static_cast<size_t>(emb_vec_sizes_[i]),
+                                    values_tensor.data(), emb_vector_tensor->data(),
+                                    i64_input_tensor, gpu_stream);
+      }
+    } catch (std::exception const &error) {
+      ctx->SetStatus(errors::Aborted(error.what()));
+      return;
+    }
+  }
+
+  bool IsExpensive() override { return true; }
+
+ private:
+  std::string model_name_;
+  std::vector<tensorflow::int32> table_ids_;
+  std::vector<tensorflow::int32> emb_vec_sizes_;
+};
+#endif
+
 REGISTER_KERNEL_BUILDER(Name("Lookup").Device(DEVICE_GPU).HostMemory("global_replica_id"),
                         Lookup<GPUDevice>);
+REGISTER_KERNEL_BUILDER(Name("GroupedLookup").Device(DEVICE_GPU).HostMemory("global_replica_id"),
+                        GroupedLookup<GPUDevice>);
 
 }  // namespace tensorflow
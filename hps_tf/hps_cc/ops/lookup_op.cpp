@@ -50,3 +50,45 @@ REGISTER_OP("Lookup")
       return OkStatus();
 #endif
     });
+
+// Queries several tables of one model with a single op dispatch, so the TF executor
+// overhead is paid once per step instead of once per table.
+REGISTER_OP("GroupedLookup")
+    .Input("values: num_tables * value_dtype")
+    .Input("global_replica_id: int32")
+    .Output("emb_vectors: num_tables * dtype")
+    .Attr("num_tables: int >= 1")
+    .Attr("value_dtype: {int32, int64}")
+    .Attr("model_name: string")
+    .Attr("table_ids: list(int)")
+    .Attr("emb_vec_sizes: list(int)")
+    .Attr("dtype: {float32}")
+    .Input("init_status: status_dtype")
+    .Attr("status_dtype: {string}")
+    .SetShapeFn([](InferenceContext* ctx) {
+      int32_t num_tables;
+      TF_RETURN_IF_ERROR(ctx->GetAttr("num_tables", &num_tables));
+      std::vector<int32_t> emb_vec_sizes;
+      TF_RETURN_IF_ERROR(ctx->GetAttr("emb_vec_sizes", &emb_vec_sizes));
+      if (static_cast<int32_t>(emb_vec_sizes.size()) != num_tables) {
+        return errors::InvalidArgument("emb_vec_sizes must have num_tables entries.");
+      }
+
+      ShapeHandle replica_id_shape = ctx->input(num_tables);
+      DimensionHandle replica_id_num_elem = ctx->NumElements(replica_id_shape);
+      if (1 != ctx->Value(replica_id_num_elem)) {
+        return errors::InvalidArgument("global_replica_id must be a scalar.");
+      }
+
+      for (int32_t i = 0; i < num_tables; ++i) {
+        ShapeHandle output_shape;
+        TF_RETURN_IF_ERROR(
+            ctx->Concatenate(ctx->input(i), ctx->Vector(emb_vec_sizes[i]), &output_shape));
+        ctx->set_output(i, output_shape);
+      }
+#ifndef TF_GE_211
+      return Status::OK();
+#else
+      return OkStatus();
+#endif
+    });
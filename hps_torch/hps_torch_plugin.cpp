@@ -54,4 +54,42 @@ Tensor hps_embedding_lookup(const Tensor& input, const std::string& ps_config_fi
   return output;
 }
 
-TORCH_LIBRARY(hps_torch, m) { m.def("hps_embedding_lookup", &hps_embedding_lookup); }
\ No newline at end of file
+// CUDA-graph-compatible variant of hps_embedding_lookup. All work is stream-ordered on the
+// current stream, so the op can be recorded with torch.cuda.graphs.CUDAGraph; the model must be
+// deployed with use_static_table=true and the first call should happen outside capture so that
+// HPS initialization does not get recorded.
+Tensor hps_embedding_lookup_graph_safe(const Tensor& input, const std::string& ps_config_file,
+                                       const std::string& model_name, const int64_t table_id,
+                                       const int64_t emb_vec_size) {
+  at::DeviceGuard guard(input.device());
+  Facade::instance()->init(ps_config_file.c_str(), pluginType_t::TENSORFLOW);
+
+  AT_ASSERTM(input.is_contiguous(), "input tensor has to be contiguous");
+  AT_ASSERTM(input.is_cuda(), "input must be a CUDA tensor");
+
+  const int64_t device_id = input.device().index();
+  const int64_t batch_size = input.size(0);
+  const int64_t num_query = input.size(1);
+  const int64_t num_elements = batch_size * num_query;
+
+  // The static table writes every output row, so no zero-fill is needed
+  auto output = at::empty({batch_size, num_query, emb_vec_size}, input.options().dtype(at::kFloat));
+  auto stream = at::cuda::getCurrentCUDAStream();
+  bool i64_input_key = torch::kInt64 == input.dtype();
+
+  if (i64_input_key) {
+    Facade::instance()->forward_graph_safe(model_name.c_str(), table_id, device_id, num_elements,
+                                           emb_vec_size, input.data_ptr<int64_t>(),
+                                           output.data_ptr<float>(), i64_input_key, stream);
+  } else {
+    Facade::instance()->forward_graph_safe(model_name.c_str(), table_id, device_id, num_elements,
+                                           emb_vec_size, input.data_ptr<int32_t>(),
+                                           output.data_ptr<float>(), i64_input_key, stream);
+  }
+  return output;
+}
+
+TORCH_LIBRARY(hps_torch, m) {
+  m.def("hps_embedding_lookup", &hps_embedding_lookup);
+  m.def("hps_embedding_lookup_graph_safe", &hps_embedding_lookup_graph_safe);
+}
\ No newline at end of file
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <NvInfer.h>
+
+#include <hps_trt/hps_plugin/hps_lookup_interaction_plugin.hpp>
+#include <hps_trt/hps_plugin/trt_plugin_utils.hpp>
+#include <utility>
+
+using namespace nvinfer1;
+using nvinfer1::plugin::HpsLookupInteractionPlugin;
+using nvinfer1::plugin::HpsLookupInteractionPluginCreator;
+
+static const char* HPS_LOOKUP_INTERACTION_PLUGIN_VERSION{"1"};
+static const char* HPS_LOOKUP_INTERACTION_PLUGIN_NAME{"HPS_LOOKUP_INTERACTION_TRT"};
+PluginFieldCollection HpsLookupInteractionPluginCreator::mFC{};
+std::vector<PluginField> HpsLookupInteractionPluginCreator::mPluginAttributes;
+
+REGISTER_TENSORRT_PLUGIN(HpsLookupInteractionPluginCreator);
+
+namespace {
+
+// Rearranges keys from (batch, num_tables) to (num_tables, batch) so each table's keys
+// are contiguous for the batched LookupSession path.
+template <typename KeyT>
+__global__ void transpose_keys_kernel(const KeyT* keys, KeyT* keys_t, int32_t batch,
+                                      int32_t num_tables) {
+  const int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < batch * num_tables) {
+    const int32_t b = i / num_tables;
+    const int32_t t = i % num_tables;
+    keys_t[t * batch + b] = keys[i];
+  }
+}
+
+// One block per sample: stages the dense vector plus the per-table embedding vectors in
+// shared memory, copies the dense part to the output and appends the distinct pairwise
+// dot products of all m = num_tables + 1 features (lower triangle, row-wise).
+__global__ void dot_interaction_kernel(const float* dense, const float* emb, float* out,
+                                       int32_t batch, int32_t num_tables, int32_t emb_vec_size) {
+  extern __shared__ float feat[];  // (num_tables + 1) * emb_vec_size
+  const int32_t b = blockIdx.x;
+  const int32_t m = num_tables + 1;
+
+  for (int32_t i = threadIdx.x; i < emb_vec_size; i += blockDim.x) {
+    feat[i] = dense[static_cast<size_t>(b) * emb_vec_size + i];
+  }
+  for (int32_t t = 0; t < num_tables; ++t) {
+    for (int32_t i = threadIdx.x; i < emb_vec_size; i += blockDim.x) {
+      feat[(t + 1) * emb_vec_size + i] =
+          emb[(static_cast<size_t>(t) * batch + b) * emb_vec_size + i];
+    }
+  }
+  __syncthreads();
+
+  const int32_t num_pairs = m * (m - 1) / 2;
+  const int32_t out_dim = emb_vec_size + num_pairs;
+  float* out_b = out + static_cast<size_t>(b) * out_dim;
+  for (int32_t i = threadIdx.x; i < emb_vec_size; i += blockDim.x) {
+    out_b[i] = feat[i];
+  }
+  for (int32_t p = threadIdx.x; p < num_pairs; p += blockDim.x) {
+    int32_t i = 1;
+    while (p >= i * (i + 1) / 2) {
+      ++i;
+    }
+    const int32_t j = p - i * (i - 1) / 2;
+    float accum = 0.f;
+    for (int32_t k = 0; k < emb_vec_size; ++k) {
+      accum += feat[i * emb_vec_size + k] * feat[j * emb_vec_size + k];
+    }
+    out_b[emb_vec_size + p] = accum;
+  }
+}
+
+}  // namespace
+
+HpsLookupInteractionPlugin::HpsLookupInteractionPlugin(std::string name,
+                                                       std::string ps_config_file,
+                                                       std::string model_name,
+                                                       std::vector<int32_t> table_ids,
+                                                       int32_t emb_vec_size)
+    : mLayerName(std::move(name)),
+      ps_config_file(std::move(ps_config_file)),
+      model_name(std::move(model_name)),
+      table_ids(std::move(table_ids)),
+      emb_vec_size(emb_vec_size) {}
+
+HpsLookupInteractionPlugin::HpsLookupInteractionPlugin(std::string name, const void* data,
+                                                       size_t length)
+    : mLayerName(std::move(name)) {
+  // Deserialize in the same order as serialization
+  const char *d = static_cast<const char*>(data), *a = d;
+
+  const int32_t ps_config_file_str_size = read<int32_t>(d);
+  ps_config_file = read_string(d, ps_config_file_str_size);
+  const int32_t model_name_str_size = read<int32_t>(d);
+  model_name = read_string(d, model_name_str_size);
+  const int32_t num_tables = read<int32_t>(d);
+  table_ids.resize(num_tables);
+  for (int32_t i = 0; i < num_tables; ++i) {
+    table_ids[i] = read<int32_t>(d);
+  }
+  emb_vec_size = read<int32_t>(d);
+  mKeyType = read<DataType>(d);
+  mVecType = read<DataType>(d);
+  HCTR_CHECK_HINT(d == (a + length), "The size for reading serialized data is not correct");
+}
+
+int HpsLookupInteractionPlugin::initialize() noexcept { return 0; }
+
+void HpsLookupInteractionPlugin::terminate() noexcept {}
+
+void HpsLookupInteractionPlugin::destroy() noexcept { delete this; }
+
+int HpsLookupInteractionPlugin::getNbOutputs() const noexcept { return 1; }
+
+DimsExprs HpsLookupInteractionPlugin::getOutputDimensions(int32_t outputIndex,
+                                                          DimsExprs const* inputs,
+                                                          int32_t nbInputs,
+                                                          IExprBuilder& exprBuilder) noexcept {
+  try {
+    HCTR_CHECK_HINT(nbInputs == 2, "The number of inputs should be 2 (keys, dense)");
+    HCTR_CHECK_HINT(inputs[0].nbDims == 2, "The dimensions of keys should be 2");
+    HCTR_CHECK_HINT(inputs[1].nbDims == 2, "The dimensions of dense features should be 2");
+    DimsExprs ret;
+    ret.nbDims = 2;
+    ret.d[0] = inputs[0].d[0];
+    ret.d[1] = exprBuilder.constant(num_interaction_outputs());
+    return ret;
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+  }
+  return DimsExprs{};
+}
+
+DataType HpsLookupInteractionPlugin::getOutputDataType(int32_t index,
+                                                       nvinfer1::DataType const* inputTypes,
+                                                       int32_t nbInputs) const noexcept {
+  return DataType::kFLOAT;
+}
+
+size_t HpsLookupInteractionPlugin::getWorkspaceSize(PluginTensorDesc const* inputs,
+                                                    int32_t nbInputs,
+                                                    PluginTensorDesc const* outputs,
+                                                    int32_t nbOutputs) const noexcept {
+  const size_t num_tables = table_ids.size();
+  const size_t batch = inputs[0].dims.d[0] > 0 ? inputs[0].dims.d[0] : 1;
+  const size_t key_size =
+      inputs[0].type == DataType::kINT32 ? sizeof(int32_t) : sizeof(int64_t);
+  // transposed keys + per-table lookup results
+  return batch * num_tables * key_size + batch * num_tables * emb_vec_size * sizeof(float);
+}
+
+size_t HpsLookupInteractionPlugin::getSerializationSize() const noexcept {
+  return (4 + table_ids.size()) * sizeof(int32_t) + 2 * sizeof(DataType) + ps_config_file.size() +
+         model_name.size();
+}
+
+const char* HpsLookupInteractionPlugin::getPluginType() const noexcept {
+  return HPS_LOOKUP_INTERACTION_PLUGIN_NAME;
+}
+
+const char* HpsLookupInteractionPlugin::getPluginVersion() const noexcept {
+  return HPS_LOOKUP_INTERACTION_PLUGIN_VERSION;
+}
+
+bool HpsLookupInteractionPlugin::supportsFormatCombination(int32_t pos,
+                                                           const PluginTensorDesc* inOut,
+                                                           int32_t nbInputs,
+                                                           int32_t nbOutputs) noexcept {
+  if (pos == 0) {
+    const PluginTensorDesc& keys = inOut[0];
+    return (keys.type == DataType::kINT32 || keys.type == DataType::kINT64) &&
+           (keys.format == TensorFormat::kLINEAR);
+  }
+  if (pos == 1 || pos == 2) {
+    const PluginTensorDesc& desc = inOut[pos];
+    return (desc.type == mVecType) && (desc.format == TensorFormat::kLINEAR);
+  }
+  return false;
+}
+
+void HpsLookupInteractionPlugin::configurePlugin(const DynamicPluginTensorDesc* in,
+                                                 int32_t nbInput,
+                                                 const DynamicPluginTensorDesc* out,
+                                                 int32_t nbOutput) noexcept {}
+
+int32_t HpsLookupInteractionPlugin::enqueue(PluginTensorDesc const* inputDesc,
+                                            PluginTensorDesc const* outputDesc,
+                                            void const* const* inputs, void* const* outputs,
+                                            void* workspace, cudaStream_t stream) noexcept {
+  try {
+    const int32_t batch = inputDesc[0].dims.d[0];
+    const int32_t num_tables = static_cast<int32_t>(table_ids.size());
+    HCTR_CHECK_HINT(inputDesc[0].dims.d[1] == num_tables,
+                    "keys.shape[1] must match the number of table_ids");
+    HCTR_CHECK_HINT(inputDesc[1].dims.d[1] == emb_vec_size,
+                    "dense.shape[1] must match emb_vec_size");
+
+    int32_t device_id;
+    HCTR_LIB_THROW(cudaGetDevice(&device_id));
+    const bool i64_input_key = !(inputDesc[0].type == DataType::kINT32);
+    const size_t key_size = i64_input_key ? sizeof(int64_t) : sizeof(int32_t);
+
+    char* keys_t = static_cast<char*>(workspace);
+    float* emb = reinterpret_cast<float*>(keys_t + static_cast<size_t>(batch) * num_tables *
+                                                       key_size);
+
+    constexpr int32_t block_size = 256;
+    const int32_t grid_size = (batch * num_tables + block_size - 1) / block_size;
+    if (i64_input_key) {
+      transpose_keys_kernel<int64_t><<<grid_size, block_size, 0, stream>>>(
+          static_cast<const int64_t*>(inputs[0]), reinterpret_cast<int64_t*>(keys_t), batch,
+          num_tables);
+    } else {
+      transpose_keys_kernel<int32_t><<<grid_size, block_size, 0, stream>>>(
+          static_cast<const int32_t*>(inputs[0]), reinterpret_cast<int32_t*>(keys_t), batch,
+          num_tables);
+    }
+    HCTR_LIB_THROW(cudaGetLastError());
+
+    for (int32_t t = 0; t < num_tables; ++t) {
+      Facade::instance()->forward(model_name.c_str(), table_ids[t], device_id, batch, emb_vec_size,
+                                  keys_t + static_cast<size_t>(t) * batch * key_size,
+                                  emb + static_cast<size_t>(t) * batch * emb_vec_size,
+                                  i64_input_key, stream);
+    }
+
+    const size_t smem_size = static_cast<size_t>(num_tables + 1) * emb_vec_size * sizeof(float);
+    dot_interaction_kernel<<<batch, block_size, smem_size, stream>>>(
+        static_cast<const float*>(inputs[1]), emb, static_cast<float*>(outputs[0]), batch,
+        num_tables, emb_vec_size);
+    HCTR_LIB_THROW(cudaGetLastError());
+    return 0;
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+  }
+  return -1;
+}
+
+void HpsLookupInteractionPlugin::serialize(void* buffer) const noexcept {
+  const int32_t ps_config_file_str_size = ps_config_file.size();
+  const int32_t model_name_str_size = model_name.size();
+
+  char *d = static_cast<char*>(buffer), *a = d;
+
+  // Serialize plugin data
+  write(d, ps_config_file_str_size);
+  write_string(d, ps_config_file);
+  write(d, model_name_str_size);
+  write_string(d, model_name);
+  write(d, static_cast<int32_t>(table_ids.size()));
+  for (const int32_t table_id : table_ids) {
+    write(d, table_id);
+  }
+  write(d, emb_vec_size);
+  write(d, mKeyType);
+  write(d, mVecType);
+
+  HCTR_CHECK_HINT(d == a + getSerializationSize(), "The serialization size does not match");
+}
+
+IPluginV2DynamicExt* HpsLookupInteractionPlugin::clone() const noexcept {
+  try {
+    HpsLookupInteractionPlugin* ret = new HpsLookupInteractionPlugin(
+        mLayerName, ps_config_file, model_name, table_ids, emb_vec_size);
+    ret->setPluginNamespace(mNamespace.c_str());
+    return ret;
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+  }
+  return nullptr;
+}
+
+HpsLookupInteractionPluginCreator::HpsLookupInteractionPluginCreator() {
+  mPluginAttributes.clear();
+  mPluginAttributes.emplace_back(PluginField("ps_config_file", nullptr, PluginFieldType::kCHAR, 1));
+  mPluginAttributes.emplace_back(PluginField("model_name", nullptr, PluginFieldType::kCHAR, 1));
+  mPluginAttributes.emplace_back(PluginField("table_ids", nullptr, PluginFieldType::kINT32, 1));
+  mPluginAttributes.emplace_back(PluginField("emb_vec_size", nullptr, PluginFieldType::kINT32, 1));
+
+  mFC.nbFields = mPluginAttributes.size();
+  mFC.fields = mPluginAttributes.data();
+}
+
+const char* HpsLookupInteractionPluginCreator::getPluginName() const noexcept {
+  return HPS_LOOKUP_INTERACTION_PLUGIN_NAME;
+}
+
+const char* HpsLookupInteractionPluginCreator::getPluginVersion() const noexcept {
+  return HPS_LOOKUP_INTERACTION_PLUGIN_VERSION;
+}
+
+const PluginFieldCollection* HpsLookupInteractionPluginCreator::getFieldNames() noexcept {
+  return &mFC;
+}
+
+IPluginV2DynamicExt* HpsLookupInteractionPluginCreator::createPlugin(
+    const char* name, const PluginFieldCollection* fc) noexcept {
+  try {
+    int32_t emb_vec_size{0};
+    std::string model_name, ps_config_file;
+    std::vector<int32_t> table_ids;
+    const PluginField* fields = fc->fields;
+
+    validateRequiredAttributesExist({"ps_config_file", "model_name", "table_ids", "emb_vec_size"},
+                                    fc);
+    HCTR_CHECK_HINT(fc->nbFields == 4,
+                    "The number of fields for HPS lookup interaction plugin should be 4");
+
+    for (int32_t i = 0; i < fc->nbFields; i++) {
+      if (strcmp(fields[i].name, "ps_config_file") == 0) {
+        HCTR_CHECK_HINT(fields[i].type == PluginFieldType::kCHAR, "ps_config_file should be CHAR");
+        ps_config_file = static_cast<const char*>(fields[i].data);
+      } else if (strcmp(fields[i].name, "model_name") == 0) {
+        HCTR_CHECK_HINT(fields[i].type == PluginFieldType::kCHAR, "model_name should be CHAR");
+        model_name = static_cast<const char*>(fields[i].data);
+      } else if (strcmp(fields[i].name, "table_ids") == 0) {
+        HCTR_CHECK_HINT(fields[i].type == PluginFieldType::kINT32, "table_ids should be INT32");
+        const int32_t* data = static_cast<const int32_t*>(fields[i].data);
+        table_ids.assign(data, data + fields[i].length);
+      } else if (strcmp(fields[i].name, "emb_vec_size") == 0) {
+        HCTR_CHECK_HINT(fields[i].type == PluginFieldType::kINT32, "emb_vec_size should be INT32");
+        emb_vec_size = *(static_cast<const int32_t*>(fields[i].data));
+      }
+    }
+    HCTR_CHECK_HINT(!table_ids.empty(), "table_ids should not be empty");
+    Facade::instance()->init(ps_config_file.c_str(), pluginType_t::TENSORRT);
+    return new HpsLookupInteractionPlugin(name, ps_config_file, model_name, std::move(table_ids),
+                                          emb_vec_size);
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+  }
+  return nullptr;
+}
+
+IPluginV2DynamicExt* HpsLookupInteractionPluginCreator::deserializePlugin(
+    const char* name, const void* serialData, size_t serialLength) noexcept {
+  try {
+    // This object will be deleted when the network is destroyed, which will
+    // call HpsLookupInteractionPlugin::destroy()
+    const char* d = static_cast<const char*>(serialData);
+    const int32_t ps_config_file_str_size = read<int32_t>(d);
+    const std::string ps_config_file = read_string(d, ps_config_file_str_size);
+    Facade::instance()->init(ps_config_file.c_str(), pluginType_t::TENSORRT);
+    return new HpsLookupInteractionPlugin(name, serialData, serialLength);
+  } catch (const std::exception& err) {
+    HCTR_LOG_S(ERROR, WORLD) << err.what() << std::endl;
+  }
+  return nullptr;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <NvInferPlugin.h>
+#include <cuda_runtime.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <hps/plugin/facade.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace HierarchicalParameterServer;
+
+namespace nvinfer1 {
+
+namespace plugin {
+
+// Fused multi-table lookup + concat + dot interaction in one enqueue.
+//
+// Inputs:  [0] keys, shape (batch, num_tables), one key per table and sample
+//          [1] dense features, shape (batch, emb_vec_size), the bottom-MLP output
+// Output:  (batch, emb_vec_size + m * (m - 1) / 2) with m = num_tables + 1: the dense
+//          features followed by the distinct pairwise dot products of all m features.
+//
+// The lookup results never leave the TRT workspace, so neither the per-table embedding
+// tensors nor the concatenation are materialized as network intermediates.
+class HpsLookupInteractionPlugin : public IPluginV2DynamicExt {
+ public:
+  HpsLookupInteractionPlugin(std::string plugin_layer_name, std::string ps_config_file,
+                             std::string model_name, std::vector<int32_t> table_ids,
+                             int32_t emb_vec_size);
+
+  HpsLookupInteractionPlugin(std::string plugin_layer_name, const void* data, size_t length);
+
+  ~HpsLookupInteractionPlugin() override = default;
+
+  HpsLookupInteractionPlugin() = delete;
+
+  int initialize() noexcept override;
+
+  void terminate() noexcept override;
+
+  void destroy() noexcept override;
+
+  int getNbOutputs() const noexcept override;
+
+  DimsExprs getOutputDimensions(int32_t outputIndex, DimsExprs const* inputs, int32_t nbInputs,
+                                IExprBuilder& exprBuilder) noexcept override;
+
+  DataType getOutputDataType(int32_t index, nvinfer1::DataType const* inputTypes,
+                             int32_t nbInputs) const noexcept override;
+
+  size_t getWorkspaceSize(PluginTensorDesc const* inputs, int32_t nbInputs,
+                          PluginTensorDesc const* outputs,
+                          int32_t nbOutputs) const noexcept override;
+
+  size_t getSerializationSize() const noexcept override;
+
+  const char* getPluginType() const noexcept override;
+
+  const char* getPluginVersion() const noexcept override;
+
+  bool supportsFormatCombination(int32_t pos, const PluginTensorDesc* inOut, int32_t nbInputs,
+                                 int32_t nbOutputs) noexcept override;
+
+  void configurePlugin(const DynamicPluginTensorDesc* in, int32_t nbInput,
+                       const DynamicPluginTensorDesc* out, int32_t nbOutput) noexcept override;
+
+  int32_t enqueue(PluginTensorDesc const* inputDesc, PluginTensorDesc const* outputDesc,
+                  void const* const* inputs, void* const* outputs, void* workspace,
+                  cudaStream_t stream) noexcept override;
+
+  void serialize(void* buffer) const noexcept override;
+
+  IPluginV2DynamicExt* clone() const noexcept override;
+
+ protected:
+  void setPluginNamespace(const char* libNamespace) noexcept override { mNamespace = libNamespace; }
+
+  const char* getPluginNamespace() const noexcept override { return mNamespace.c_str(); }
+
+  std::string mNamespace;
+
+ private:
+  int32_t num_interaction_outputs() const {
+    const int32_t m = static_cast<int32_t>(table_ids.size()) + 1;
+    return emb_vec_size + m * (m - 1) / 2;
+  }
+
+  std::string mLayerName;
+  std::string ps_config_file;
+  std::string model_name;
+  std::vector<int32_t> table_ids;
+  int32_t emb_vec_size;
+  DataType mKeyType{DataType::kINT32};
+  DataType mVecType{DataType::kFLOAT};
+};
+
+class HpsLookupInteractionPluginCreator : public IPluginCreator {
+ public:
+  HpsLookupInteractionPluginCreator();
+
+  ~HpsLookupInteractionPluginCreator() override = default;
+
+  const char* getPluginName() const noexcept override;
+
+  const char* getPluginVersion() const noexcept override;
+
+  const PluginFieldCollection* getFieldNames() noexcept override;
+
+  IPluginV2DynamicExt* createPlugin(const char* name,
+                                    const PluginFieldCollection* fc) noexcept override;
+
+  IPluginV2DynamicExt* deserializePlugin(const char* name, const void* serialData,
+                                         size_t serialLength) noexcept override;
+
+  void setPluginNamespace(const char* libNamespace) noexcept override { mNamespace = libNamespace; }
+
+  const char* getPluginNamespace() const noexcept override { return mNamespace.c_str(); }
+
+ protected:
+  std::string mNamespace;
+
+ private:
+  static PluginFieldCollection mFC;
+  static std::vector<PluginField> mPluginAttributes;
+};
+
+}  // namespace plugin
+
+}  // namespace nvinfer1
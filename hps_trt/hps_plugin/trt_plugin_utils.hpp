@@ -46,19 +46,19 @@ T read(const char*& buffer) {
   return val;
 }
 
-void write_string(char*& buffer, const std::string& val) {
+inline void write_string(char*& buffer, const std::string& val) {
   std::memcpy(buffer, val.data(), val.size());
   buffer += val.size();
 }
 
-std::string read_string(const char*& buffer, size_t str_size) {
+inline std::string read_string(const char*& buffer, size_t str_size) {
   std::string val(str_size, 0);
   std::memcpy(val.data(), buffer, str_size);
   buffer += str_size;
   return val;
 }
 
-void validateRequiredAttributesExist(std::set<std::string> requiredFieldNames,
+inline void validateRequiredAttributesExist(std::set<std::string> requiredFieldNames,
                                      PluginFieldCollection const* fc) {
   for (int32_t i = 0; i < fc->nbFields; i++) {
     requiredFieldNames.erase(fc->fields[i].name);
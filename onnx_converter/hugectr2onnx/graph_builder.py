@@ -21,18 +21,37 @@ import onnx
 
 
 class GraphBuilder(object):
-    def __init__(self, convert_embedding):
+    def __init__(self, convert_embedding, keep_fused_ops=False):
         """Create GraphBuilder
         Args:
             convert_embedding: boolean, whether converting sparse embedding models to ONNX
+            keep_fused_ops: boolean, whether to emit contrib/plugin fused nodes
+                (com.microsoft FusedGemm, TensorRT plugin ops) instead of decomposing
+                fused HugeCTR layers into primitive ONNX ops. The exported model then
+                keeps the fusion boundaries chosen at training time, but only runs on
+                backends that provide these ops (ONNX Runtime contrib ops, TensorRT
+                with the HugeCTR plugins registered).
         """
         self.__convert_embeddding = convert_embedding
+        self.__keep_fused_ops = keep_fused_ops
+        self.__custom_opsets = {}
         self.__nodes = []
         self.__initializers = []
         self.__inputs = []
         self.__outputs = []
         self.__counter = 0
 
+    def __fused_gemm(self, inputs, outputs, activation="Relu"):
+        """Emit a com.microsoft::FusedGemm node (Gemm with a fused activation epilogue)."""
+        self.__custom_opsets["com.microsoft"] = 1
+        return helper.make_node(
+            op_type="FusedGemm",
+            inputs=inputs,
+            outputs=outputs,
+            domain="com.microsoft",
+            activation=activation,
+        )
+
     def add_layer(self, layer_params, weights_dict, dimensions):
         """Add layer to ONNX graph, one layer may consist of multiple ONNX nodes
         Args:
@@ -516,16 +535,26 @@ class GraphBuilder(object):
                     vals=bias.flatten(),
                 )
             )
-            self.__nodes.append(
-                helper.make_node(
-                    op_type="Gemm",
-                    inputs=[layer_params.bottom_names[0], weight_name, bias_name],
-                    outputs=[gemm_name],
+            if self.__keep_fused_ops:
+                self.__nodes.append(
+                    self.__fused_gemm(
+                        inputs=[layer_params.bottom_names[0], weight_name, bias_name],
+                        outputs=layer_params.top_names,
+                    )
+                )
+            else:
+                self.__nodes.append(
+                    helper.make_node(
+                        op_type="Gemm",
+                        inputs=[layer_params.bottom_names[0], weight_name, bias_name],
+                        outputs=[gemm_name],
+                    )
+                )
+                self.__nodes.append(
+                    helper.make_node(
+                        op_type="Relu", inputs=[gemm_name], outputs=layer_params.top_names
+                    )
                 )
-            )
-            self.__nodes.append(
-                helper.make_node(op_type="Relu", inputs=[gemm_name], outputs=layer_params.top_names)
-            )
         elif layer_type == "MLP":
             num_layers = len(layer_params.num_outputs)
             acts = [layer_params.activation] * num_layers
@@ -561,7 +590,8 @@ class GraphBuilder(object):
                         vals=weight.flatten(),
                     )
                 )
-                output_name = gemm_name if acts[i] == "Relu" else top_name
+                fuse_relu = self.__keep_fused_ops and acts[i] == "Relu"
+                output_name = gemm_name if acts[i] == "Relu" and not fuse_relu else top_name
                 if biases[i]:
                     self.__initializers.append(
                         helper.make_tensor(
@@ -571,24 +601,39 @@ class GraphBuilder(object):
                             vals=bias.flatten(),
                         )
                     )
+                    gemm_inputs = [bottom_name, weight_name, bias_name]
+                else:
+                    gemm_inputs = [bottom_name, weight_name]
+                if fuse_relu:
                     self.__nodes.append(
-                        helper.make_node(
-                            op_type="Gemm",
-                            inputs=[bottom_name, weight_name, bias_name],
-                            outputs=[output_name],
-                        )
+                        self.__fused_gemm(inputs=gemm_inputs, outputs=[output_name])
                     )
                 else:
                     self.__nodes.append(
                         helper.make_node(
-                            op_type="Gemm", inputs=[bottom_name, weight_name], outputs=[output_name]
+                            op_type="Gemm", inputs=gemm_inputs, outputs=[output_name]
                         )
                     )
 
-                if acts[i] == "Relu":
+                if acts[i] == "Relu" and not fuse_relu:
                     self.__nodes.append(
                         helper.make_node(op_type="Relu", inputs=[gemm_name], outputs=[top_name])
                     )
+        elif layer_type == "FusedReshapeConcat" and self.__keep_fused_ops:
+            # Single plugin node with the same boundary as the HugeCTR fused layer,
+            # instead of the Slice/Concat/Reshape decomposition below. TensorRT maps
+            # it onto the FusedReshapeConcat plugin; the slot count is carried as an
+            # attribute so the plugin can split item and ad features.
+            self.__custom_opsets["trt.plugins"] = 1
+            self.__nodes.append(
+                helper.make_node(
+                    op_type="FusedReshapeConcat",
+                    inputs=layer_params.bottom_names,
+                    outputs=layer_params.top_names,
+                    domain="trt.plugins",
+                    slot_num=dimensions[layer_params.bottom_names[0]][0],
+                )
+            )
         elif layer_type == "FusedReshapeConcat":
             slot_num = dimensions[layer_params.bottom_names[0]][0]
             output_fea_num = 0
@@ -1511,9 +1556,12 @@ class GraphBuilder(object):
         )
 
     def save_model(self, model_path, op_version=10, ir_version=7):
-        # Create the model (ModelProto)
-        model_def = helper.make_model(self.__graph_def)
-        model_def.opset_import[0].version = op_version
+        # Create the model (ModelProto), declaring every custom domain the fused
+        # export mode emitted nodes for next to the default opset
+        opset_imports = [helper.make_opsetid("", op_version)]
+        for domain, version in self.__custom_opsets.items():
+            opset_imports.append(helper.make_opsetid(domain, version))
+        model_def = helper.make_model(self.__graph_def, opset_imports=opset_imports)
         model_def.ir_version = ir_version
         onnx.checker.check_model(model_def)
         print("[HUGECTR2ONNX][INFO]: The model is checked!")
@@ -78,4 +78,153 @@ template class LookupLauncher<int32_t, float>;
 template class LookupLauncher<int64_t, __half>;
 template class LookupLauncher<int32_t, __half>;
 
+// Gathers and segment-reduces every table in one launch: thread j of task i accumulates
+// column (j % dimension) of sample (j / dimension) over that sample's keys.
+template <typename KeyType, typename DataType>
+__global__ static void FusedLookupCombineKernel(LookupCombineTask<KeyType, DataType> *task,
+                                                size_t num_tasks) {
+  for (size_t i = 0; i < num_tasks; ++i) {
+    const float *input = task[i].input;
+    const KeyType *key = reinterpret_cast<const KeyType *>(task[i].key);
+    const int64_t *offsets = task[i].offsets;
+    int32_t dimension = task[i].dimension;
+    int32_t batch = task[i].batch;
+    int32_t combiner = task[i].combiner;
+    DataType *output = reinterpret_cast<DataType *>(task[i].output);
+
+    size_t thread_cnt = blockDim.x * gridDim.x;
+    size_t thread_idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t items = static_cast<size_t>(batch) * dimension;
+    for (size_t j = thread_idx; j < items; j += thread_cnt) {
+      size_t sample = j / dimension;
+      size_t col = j % dimension;
+      int64_t start = offsets[sample];
+      int64_t end = offsets[sample + 1];
+      float accum = 0.0f;
+      for (int64_t r = start; r < end; ++r) {
+        size_t row = key[r];
+        accum += input[row * dimension + col];
+      }
+      if (combiner == kCombinerMean && end > start) {
+        accum /= end - start;
+      }
+      output[j] = accum;
+    }
+  }
+}
+
+// Expands the combined gradient back to per-key gradient values. The sample owning key
+// row r is found by binary search over the row offsets.
+template <typename DataType>
+__global__ static void FusedCombineGradKernel(CombineGradTask<DataType> *task, size_t num_tasks) {
+  for (size_t i = 0; i < num_tasks; ++i) {
+    const DataType *top_grad = reinterpret_cast<const DataType *>(task[i].top_grad);
+    const int64_t *offsets = task[i].offsets;
+    int32_t dimension = task[i].dimension;
+    int32_t batch = task[i].batch;
+    int32_t combiner = task[i].combiner;
+    DataType *grad = reinterpret_cast<DataType *>(task[i].grad);
+
+    size_t thread_cnt = blockDim.x * gridDim.x;
+    size_t thread_idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t items = static_cast<size_t>(task[i].num_keys) * dimension;
+    for (size_t j = thread_idx; j < items; j += thread_cnt) {
+      int64_t row = j / dimension;
+      size_t col = j % dimension;
+      int32_t low = 0;
+      int32_t high = batch - 1;
+      while (low < high) {
+        int32_t mid = (low + high + 1) / 2;
+        if (offsets[mid] <= row) {
+          low = mid;
+        } else {
+          high = mid - 1;
+        }
+      }
+      float g = static_cast<float>(top_grad[low * dimension + col]);
+      if (combiner == kCombinerMean) {
+        int64_t count = offsets[low + 1] - offsets[low];
+        if (count > 0) {
+          g /= count;
+        }
+      }
+      grad[j] = g;
+    }
+  }
+}
+
+template <typename KeyType, typename DataType>
+LookupCombineLauncher<KeyType, DataType>::LookupCombineLauncher()
+    : num_tasks_(0), d_tasks_(nullptr) {
+  int device;
+  CUDACHECK(cudaGetDevice(&device));
+  CUDACHECK(cudaDeviceGetAttribute(&sm_count_, cudaDevAttrMultiProcessorCount, device));
+}
+
+template <typename KeyType, typename DataType>
+LookupCombineLauncher<KeyType, DataType>::~LookupCombineLauncher() {
+  if (d_tasks_) {
+    CUDACHECK(cudaFree(d_tasks_));
+    d_tasks_ = nullptr;
+  }
+}
+
+template <typename KeyType, typename DataType>
+void LookupCombineLauncher<KeyType, DataType>::initialize(size_t num_tasks) {
+  if (d_tasks_) return;
+  num_tasks_ = num_tasks;
+  CUDACHECK(cudaMalloc(&d_tasks_, sizeof(LookupCombineTask<KeyType, DataType>) * num_tasks));
+}
+
+template <typename KeyType, typename DataType>
+void LookupCombineLauncher<KeyType, DataType>::operator()(
+    std::vector<LookupCombineTask<KeyType, DataType>> &h_tasks, cudaStream_t stream) {
+  CUDACHECK(cudaMemcpyAsync(d_tasks_, h_tasks.data(),
+                            sizeof(LookupCombineTask<KeyType, DataType>) * h_tasks.size(),
+                            cudaMemcpyHostToDevice, stream));
+  FusedLookupCombineKernel<KeyType, DataType>
+      <<<2 * sm_count_, 1024ul, 0, stream>>>(d_tasks_, num_tasks_);
+  CUDACHECK(cudaGetLastError());
+}
+
+template class LookupCombineLauncher<int64_t, float>;
+template class LookupCombineLauncher<int32_t, float>;
+template class LookupCombineLauncher<int64_t, __half>;
+template class LookupCombineLauncher<int32_t, __half>;
+
+template <typename DataType>
+CombineGradLauncher<DataType>::CombineGradLauncher() : num_tasks_(0), d_tasks_(nullptr) {
+  int device;
+  CUDACHECK(cudaGetDevice(&device));
+  CUDACHECK(cudaDeviceGetAttribute(&sm_count_, cudaDevAttrMultiProcessorCount, device));
+}
+
+template <typename DataType>
+CombineGradLauncher<DataType>::~CombineGradLauncher() {
+  if (d_tasks_) {
+    CUDACHECK(cudaFree(d_tasks_));
+    d_tasks_ = nullptr;
+  }
+}
+
+template <typename DataType>
+void CombineGradLauncher<DataType>::initialize(size_t num_tasks) {
+  if (d_tasks_) return;
+  num_tasks_ = num_tasks;
+  CUDACHECK(cudaMalloc(&d_tasks_, sizeof(CombineGradTask<DataType>) * num_tasks));
+}
+
+template <typename DataType>
+void CombineGradLauncher<DataType>::operator()(std::vector<CombineGradTask<DataType>> &h_tasks,
+                                               cudaStream_t stream) {
+  CUDACHECK(cudaMemcpyAsync(d_tasks_, h_tasks.data(),
+                            sizeof(CombineGradTask<DataType>) * h_tasks.size(),
+                            cudaMemcpyHostToDevice, stream));
+  FusedCombineGradKernel<DataType><<<2 * sm_count_, 1024ul, 0, stream>>>(d_tasks_, num_tasks_);
+  CUDACHECK(cudaGetLastError());
+}
+
+template class CombineGradLauncher<float>;
+template class CombineGradLauncher<__half>;
+
 }  // namespace sok
@@ -47,6 +47,67 @@ class LookupLauncher {
   int sm_count_;
 };
 
+// Combiner applied per sample by the fused lookup-and-combine kernels.
+constexpr int32_t kCombinerSum = 0;
+constexpr int32_t kCombinerMean = 1;
+
+template <typename KeyType, typename DataType>
+struct LookupCombineTask {
+  const float *input;
+  const void *key;         // flattened keys of the ragged batch
+  const int64_t *offsets;  // row offsets, batch + 1 entries
+  int32_t dimension;
+  int32_t batch;
+  int32_t combiner;
+  void *output;  // batch x dimension
+};
+
+template <typename DataType>
+struct CombineGradTask {
+  const void *top_grad;    // batch x dimension
+  const int64_t *offsets;  // row offsets, batch + 1 entries
+  int32_t dimension;
+  int32_t batch;
+  int32_t num_keys;
+  int32_t combiner;
+  void *grad;  // num_keys x dimension, per-key gradient values
+};
+
+template <typename KeyType, typename DataType>
+class LookupCombineLauncher {
+ public:
+  LookupCombineLauncher();
+  ~LookupCombineLauncher();
+
+  void initialize(size_t num_tasks);
+
+  void operator()(std::vector<LookupCombineTask<KeyType, DataType>> &h_tasks,
+                  cudaStream_t stream = 0);
+
+ private:
+  size_t num_tasks_;
+  LookupCombineTask<KeyType, DataType> *d_tasks_;
+
+  int sm_count_;
+};
+
+template <typename DataType>
+class CombineGradLauncher {
+ public:
+  CombineGradLauncher();
+  ~CombineGradLauncher();
+
+  void initialize(size_t num_tasks);
+
+  void operator()(std::vector<CombineGradTask<DataType>> &h_tasks, cudaStream_t stream = 0);
+
+ private:
+  size_t num_tasks_;
+  CombineGradTask<DataType> *d_tasks_;
+
+  int sm_count_;
+};
+
 }  // namespace sok
 
 #endif
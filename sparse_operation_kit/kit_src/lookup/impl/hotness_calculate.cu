@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "common/check.h"
 #include "lookup/impl/hotness_calculate.h"
 
@@ -48,6 +51,25 @@ void HotnessCalLauncher<DType>::initialize() {
   int device;
   CUDACHECK(cudaGetDevice(&device));
   CUDACHECK(cudaDeviceGetAttribute(&sm_count_, cudaDevAttrMultiProcessorCount, device));
+
+  const char* cache_env = std::getenv("SOK_HOTNESS_CACHE");
+  cache_enabled_ = cache_env != nullptr && std::atoi(cache_env) != 0;
+  const char* interval_env = std::getenv("SOK_HOTNESS_CACHE_INTERVAL");
+  if (interval_env != nullptr && std::atoll(interval_env) > 0) {
+    revalidate_interval_ = std::atoll(interval_env);
+  }
+}
+
+template <typename DType>
+HotnessCalLauncher<DType>::~HotnessCalLauncher() {
+  if (h_async_) {
+    cudaFreeHost(h_async_);
+    h_async_ = nullptr;
+  }
+  if (copy_done_) {
+    cudaEventDestroy(copy_done_);
+    copy_done_ = nullptr;
+  }
 }
 
 template <typename DType>
@@ -64,11 +86,41 @@ void HotnessCalLauncher<DType>::operator()(const void *row_length_recv_buffer,
   CUDACHECK(cudaMemsetAsync(t_output_device, 0, sizeof(int32_t) * num_lookup, stream));
   hotnessCalKernel<DType><<<grid_dim, block_dim, num_lookup * sizeof(int32_t), stream>>>(
       t_row_length_recv_buffer, local_batchsize, num_lookup, num_gpus, t_output_device);
-  CUDACHECK(cudaMemcpyAsync(t_output_host, t_output_device, sizeof(int32_t) * num_lookup,
+
+  if (!cache_enabled_) {
+    CUDACHECK(cudaMemcpyAsync(t_output_host, t_output_device, sizeof(int32_t) * num_lookup,
+                              cudaMemcpyDeviceToHost, stream));
+    CUDACHECK(cudaStreamSynchronize(stream));
+    return;
+  }
+
+  if (h_async_ == nullptr) {
+    CUDACHECK(cudaMallocHost(&h_async_, sizeof(int32_t) * num_lookup));
+    CUDACHECK(cudaEventCreateWithFlags(&copy_done_, cudaEventDisableTiming));
+    running_max_.resize(num_lookup, 0);
+  }
+
+  // Merge the previous step's measurement if it has landed; never block on it.
+  if (has_result_ && cudaEventQuery(copy_done_) == cudaSuccess) {
+    for (int i = 0; i < num_lookup; ++i) {
+      running_max_[i] = std::max(running_max_[i], h_async_[i]);
+    }
+  }
+
+  CUDACHECK(cudaMemcpyAsync(h_async_, t_output_device, sizeof(int32_t) * num_lookup,
                             cudaMemcpyDeviceToHost, stream));
-  CUDACHECK(cudaStreamSynchronize(stream));
+  CUDACHECK(cudaEventRecord(copy_done_, stream));
+
+  if (!has_result_ || step_count_ % revalidate_interval_ == 0) {
+    // First step, or periodic revalidation: take the exact value of this batch and
+    // let an inflated running max decay.
+    CUDACHECK(cudaEventSynchronize(copy_done_));
+    std::copy(h_async_, h_async_ + num_lookup, running_max_.begin());
+    has_result_ = true;
+  }
+  step_count_ += 1;
 
-  // CUDACHECK(cudaGetLastError());
+  std::copy(running_max_.begin(), running_max_.end(), t_output_host);
 }
 
 template class HotnessCalLauncher<int32_t>;
@@ -24,15 +24,30 @@
 
 namespace sok {
 
+// Computes the per-lookup max row length (hotness) of a batch. By default the result
+// is synchronized to the host every step. When SOK_HOTNESS_CACHE=1 the launcher
+// instead serves a running max that is merged from the previous step's asynchronous
+// measurement, removing the per-step device sync; every SOK_HOTNESS_CACHE_INTERVAL
+// steps (default 1024) it hard-syncs and resets the running max so over-estimates
+// can decay.
 template <typename DType>
 class HotnessCalLauncher {
  public:
   void initialize();
+  ~HotnessCalLauncher();
   void operator()(const void* row_length_recv_buffer, size_t local_batchsize, int num_lookup,
                   int num_gpus, void* output_device, void* output_host, cudaStream_t stream = 0);
 
  private:
   int sm_count_;
+
+  bool cache_enabled_ = false;
+  int64_t revalidate_interval_ = 1024;
+  uint64_t step_count_ = 0;
+  bool has_result_ = false;
+  int32_t* h_async_ = nullptr;  // pinned landing buffer for the async copy
+  cudaEvent_t copy_done_ = nullptr;
+  std::vector<int32_t> running_max_;
 };
 
 }  // namespace sok
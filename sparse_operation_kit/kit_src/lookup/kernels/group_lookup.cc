@@ -103,13 +103,149 @@ class GroupLookupOp : public OpKernel {
   sok::LookupLauncher<KeyType, DType> launcher_;
 };
 
+template <typename KeyType, typename DType>
+class GroupLookupCombineOp : public OpKernel {
+ public:
+  explicit GroupLookupCombineOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &N_));
+    std::vector<std::string> combiners;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("combiners", &combiners));
+    OP_REQUIRES(ctx, combiners.size() == static_cast<size_t>(N_),
+                errors::InvalidArgument("combiners must have one entry per table."));
+    for (const auto& combiner : combiners) {
+      OP_REQUIRES(ctx, combiner == "sum" || combiner == "mean",
+                  errors::InvalidArgument("combiner must be \"sum\" or \"mean\"."));
+      combiners_.push_back(combiner == "mean" ? sok::kCombinerMean : sok::kCombinerSum);
+    }
+    tasks_.resize(N_);
+    launcher_.initialize(N_);
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    std::vector<tf_shared_lock> locks;
+    for (int i = 0; i < N_; ++i) {
+      auto handle = HandleFromInput(ctx, i);
+      auto dtypes_and_shapes = handle.dtypes_and_shapes();
+      auto shape = dtypes_and_shapes[0].shape;
+      OP_REQUIRES(ctx, dtypes_and_shapes[0].dtype == DataType::DT_FLOAT,
+                  errors::InvalidArgument("Type of variable must be float."));
+      tasks_[i].dimension = shape.dim_size(1);
+      tasks_[i].combiner = combiners_[i];
+
+      core::RefCountPtr<Var> var;
+      OP_REQUIRES_OK(ctx, LookupResource(ctx, handle, &var));
+      float* input = var->tensor()->flat<float>().data();
+      bool is_unique = true;
+      for (int j = 0; j < i; ++j) {
+        if (input == tasks_[j].input) {
+          is_unique = false;
+          break;
+        }
+      }
+      if (is_unique) {
+        tf_shared_lock lock(*var->mu());
+        locks.push_back(std::move(lock));
+      }
+      tasks_[i].input = input;
+
+      Tensor values = ctx->input(N_ + i);
+      tasks_[i].key = values.data();
+
+      Tensor offsets = ctx->input(2 * N_ + i);
+      tasks_[i].offsets = offsets.flat<int64_t>().data();
+      int64_t batch = offsets.NumElements() - 1;
+      tasks_[i].batch = batch;
+
+      Tensor* output = nullptr;
+      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, {batch, shape.dim_size(1)}, &output));
+      tasks_[i].output = output->data();
+    }
+
+    auto device_ctx = ctx->op_device_context();
+    OP_REQUIRES(ctx, device_ctx != nullptr, errors::Aborted("No valid device context."));
+    auto stream = stream_executor::gpu::AsGpuStreamValue(device_ctx->stream());
+
+    launcher_(tasks_, stream);
+  }
+
+ private:
+  int N_;
+  std::vector<int32_t> combiners_;
+  std::vector<sok::LookupCombineTask<KeyType, DType>> tasks_;
+  sok::LookupCombineLauncher<KeyType, DType> launcher_;
+};
+
+template <typename KeyType, typename DType>
+class GroupLookupCombineGradOp : public OpKernel {
+ public:
+  explicit GroupLookupCombineGradOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &N_));
+    std::vector<std::string> combiners;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("combiners", &combiners));
+    OP_REQUIRES(ctx, combiners.size() == static_cast<size_t>(N_),
+                errors::InvalidArgument("combiners must have one entry per table."));
+    for (const auto& combiner : combiners) {
+      OP_REQUIRES(ctx, combiner == "sum" || combiner == "mean",
+                  errors::InvalidArgument("combiner must be \"sum\" or \"mean\"."));
+      combiners_.push_back(combiner == "mean" ? sok::kCombinerMean : sok::kCombinerSum);
+    }
+    tasks_.resize(N_);
+    launcher_.initialize(N_);
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    for (int i = 0; i < N_; ++i) {
+      Tensor top_grad = ctx->input(i);
+      tasks_[i].top_grad = top_grad.data();
+      int64_t dimension = top_grad.dim_size(1);
+      tasks_[i].dimension = dimension;
+      tasks_[i].combiner = combiners_[i];
+
+      Tensor values = ctx->input(N_ + i);
+      int64_t num_keys = values.NumElements();
+      tasks_[i].num_keys = num_keys;
+
+      Tensor offsets = ctx->input(2 * N_ + i);
+      tasks_[i].offsets = offsets.flat<int64_t>().data();
+      tasks_[i].batch = offsets.NumElements() - 1;
+
+      Tensor* grad = nullptr;
+      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, {num_keys, dimension}, &grad));
+      tasks_[i].grad = grad->data();
+    }
+
+    auto device_ctx = ctx->op_device_context();
+    OP_REQUIRES(ctx, device_ctx != nullptr, errors::Aborted("No valid device context."));
+    auto stream = stream_executor::gpu::AsGpuStreamValue(device_ctx->stream());
+
+    launcher_(tasks_, stream);
+  }
+
+ private:
+  int N_;
+  std::vector<int32_t> combiners_;
+  std::vector<sok::CombineGradTask<DType>> tasks_;
+  sok::CombineGradLauncher<DType> launcher_;
+};
+
 #define REGISTER_GPU_KERNELS(key_type_tf, key_type, dtype_tf, dtype)   \
   REGISTER_KERNEL_BUILDER(Name("GroupLookup")                          \
                               .Device(DEVICE_GPU)                      \
                               .HostMemory("handles")                   \
                               .TypeConstraint<key_type_tf>("Tindices") \
                               .TypeConstraint<dtype_tf>("dtype"),      \
-                          GroupLookupOp<key_type, dtype>)
+                          GroupLookupOp<key_type, dtype>);             \
+  REGISTER_KERNEL_BUILDER(Name("GroupLookupCombine")                   \
+                              .Device(DEVICE_GPU)                      \
+                              .HostMemory("handles")                   \
+                              .TypeConstraint<key_type_tf>("Tindices") \
+                              .TypeConstraint<dtype_tf>("dtype"),      \
+                          GroupLookupCombineOp<key_type, dtype>);      \
+  REGISTER_KERNEL_BUILDER(Name("GroupLookupCombineGrad")               \
+                              .Device(DEVICE_GPU)                      \
+                              .TypeConstraint<key_type_tf>("Tindices") \
+                              .TypeConstraint<dtype_tf>("dtype"),      \
+                          GroupLookupCombineGradOp<key_type, dtype>)
 
 #if TF_VERSION_MAJOR == 1
 REGISTER_GPU_KERNELS(int64, int64_t, float, float);
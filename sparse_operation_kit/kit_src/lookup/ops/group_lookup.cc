@@ -50,4 +50,64 @@ REGISTER_OP("GroupLookup")
       return sok_tsl_status();
     });
 
+REGISTER_OP("GroupLookupCombine")
+    .Input("handles: N * resource")
+    .Input("values: N * Tindices")
+    .Input("offsets: N * int64")
+    .Output("outputs: N * dtype")
+    .Attr("N: int")
+    .Attr("combiners: list(string)")
+    .Attr("Tindices: {int32, int64} = DT_INT64")
+    .Attr("dtype: {float32, float16} = DT_FLOAT")
+    .SetShapeFn([](InferenceContext* c) {
+      int N;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &N));
+      for (int i = 0; i < N; ++i) {
+        // rank(handle) should be 2
+        auto handle_shapes_and_types = c->input_handle_shapes_and_types(i);
+        auto handle_shape = (*handle_shapes_and_types)[0].shape;
+        ShapeHandle unused;
+        TF_RETURN_IF_ERROR(c->WithRank(handle_shape, 2, &unused));
+
+        // rank(values) and rank(offsets) should be 1
+        ShapeHandle values_shape;
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(N + i), 1, &values_shape));
+        ShapeHandle offsets_shape;
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(2 * N + i), 1, &offsets_shape));
+
+        // output shape: (offsets.shape[0] - 1, handle.shape[1])
+        shape_inference::DimensionHandle batch;
+        TF_RETURN_IF_ERROR(c->Subtract(c->Dim(offsets_shape, 0), 1, &batch));
+        c->set_output(i, c->Matrix(batch, c->Dim(handle_shape, 1)));
+      }
+      return sok_tsl_status();
+    });
+
+REGISTER_OP("GroupLookupCombineGrad")
+    .Input("top_grads: N * dtype")
+    .Input("values: N * Tindices")
+    .Input("offsets: N * int64")
+    .Output("grads: N * dtype")
+    .Attr("N: int")
+    .Attr("combiners: list(string)")
+    .Attr("Tindices: {int32, int64} = DT_INT64")
+    .Attr("dtype: {float32, float16} = DT_FLOAT")
+    .SetShapeFn([](InferenceContext* c) {
+      int N;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &N));
+      for (int i = 0; i < N; ++i) {
+        // rank(top_grads) should be 2
+        ShapeHandle top_grad_shape;
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(i), 2, &top_grad_shape));
+
+        // rank(values) should be 1
+        ShapeHandle values_shape;
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(N + i), 1, &values_shape));
+
+        // grad shape: (values.shape[0], top_grad.shape[1])
+        c->set_output(i, c->Matrix(c->Dim(values_shape, 0), c->Dim(top_grad_shape, 1)));
+      }
+      return sok_tsl_status();
+    });
+
 }  // namespace tensorflow
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <nlohmann/json.hpp>
+
+#include "common/check.h"
 #include "variable/kernels/dummy_var.h"
 
 namespace tensorflow {
@@ -26,6 +29,21 @@ DummyVar<KeyType, ValueType>::DummyVar(int64_t rows, int64_t cols, const std::st
     : var_(nullptr), type_(type), container_(container), name_(name) {
   var_ = sok::VariableFactory::create<KeyType, ValueType>(rows, cols, type, initializer, config,
                                                           stream);
+  if (!config.empty()) {
+    nlohmann::json config_json = nlohmann::json::parse(config);
+    auto track_delta_it = config_json.find("track_delta");
+    if (track_delta_it != config_json.end()) {
+      track_delta_ = track_delta_it->get<bool>();
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType>
+DummyVar<KeyType, ValueType>::~DummyVar() {
+  if (touched_keys_) {
+    cudaFree(touched_keys_);
+    touched_keys_ = nullptr;
+  }
 }
 
 template <typename KeyType, typename ValueType>
@@ -103,6 +121,7 @@ template <typename KeyType, typename ValueType>
 void DummyVar<KeyType, ValueType>::ScatterAdd(const void* keys, const void* values, size_t num_keys,
                                               cudaStream_t stream) {
   check_var();
+  log_touched(keys, num_keys, stream);
   var_->scatter_add(static_cast<const KeyType*>(keys), static_cast<const ValueType*>(values),
                     num_keys, stream);
 }
@@ -111,10 +130,48 @@ template <typename KeyType, typename ValueType>
 void DummyVar<KeyType, ValueType>::ScatterUpdate(const void* keys, const void* values,
                                                  size_t num_keys, cudaStream_t stream) {
   check_var();
+  log_touched(keys, num_keys, stream);
   var_->scatter_update(static_cast<const KeyType*>(keys), static_cast<const ValueType*>(values),
                        num_keys, stream);
 }
 
+template <typename KeyType, typename ValueType>
+void DummyVar<KeyType, ValueType>::log_touched(const void* keys, size_t num_keys,
+                                               cudaStream_t stream) {
+  if (!track_delta_ || num_keys == 0) {
+    return;
+  }
+  if (touched_count_ + num_keys > touched_capacity_) {
+    size_t new_capacity = touched_capacity_ == 0 ? 1024 * 1024 : touched_capacity_;
+    while (touched_count_ + num_keys > new_capacity) {
+      new_capacity *= 2;
+    }
+    KeyType* new_keys;
+    CUDACHECK(cudaMalloc(&new_keys, sizeof(KeyType) * new_capacity));
+    if (touched_keys_) {
+      CUDACHECK(cudaMemcpyAsync(new_keys, touched_keys_, sizeof(KeyType) * touched_count_,
+                                cudaMemcpyDeviceToDevice, stream));
+      CUDACHECK(cudaStreamSynchronize(stream));
+      CUDACHECK(cudaFree(touched_keys_));
+    }
+    touched_keys_ = new_keys;
+    touched_capacity_ = new_capacity;
+  }
+  CUDACHECK(cudaMemcpyAsync(touched_keys_ + touched_count_, keys, sizeof(KeyType) * num_keys,
+                            cudaMemcpyDeviceToDevice, stream));
+  touched_count_ += num_keys;
+}
+
+template <typename KeyType, typename ValueType>
+void DummyVar<KeyType, ValueType>::ExportTouched(void* keys, cudaStream_t stream) {
+  if (touched_count_ > 0) {
+    CUDACHECK(cudaMemcpyAsync(keys, touched_keys_, sizeof(KeyType) * touched_count_,
+                              cudaMemcpyDeviceToHost, stream));
+    CUDACHECK(cudaStreamSynchronize(stream));
+  }
+  touched_count_ = 0;
+}
+
 // explicit instance the template
 template class DummyVar<int32_t, float>;
 template class DummyVar<int64_t, float>;
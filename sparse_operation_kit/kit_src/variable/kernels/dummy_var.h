@@ -44,7 +44,7 @@ class DummyVar : public ResourceBase {
   DummyVar(int64_t rows, int64_t cols, const std::string &type, const std::string &initializer,
            const std::string &config, const std::string &container, const std::string &name,
            cudaStream_t stream);
-  ~DummyVar() = default;
+  ~DummyVar();
 
   std::string DebugString() const override;
   mutex *mu();
@@ -64,6 +64,13 @@ class DummyVar : public ResourceBase {
   void ScatterAdd(const void *keys, const void *values, size_t num_keys, cudaStream_t stream);
   void ScatterUpdate(const void *keys, const void *values, size_t num_keys, cudaStream_t stream);
 
+  // Delta tracking for incremental dump. When the variable was created with
+  // {"track_delta": true} in its config, every scatter update appends the touched
+  // keys to a device-side log; ExportTouched drains the log (keys may repeat).
+  inline bool track_delta() const { return track_delta_; }
+  inline size_t TouchedCount() const { return touched_count_; }
+  void ExportTouched(void *keys, cudaStream_t stream);
+
   inline std::shared_ptr<sok::VariableBase<KeyType, ValueType>> get_var() { return var_; }
 
  private:
@@ -73,7 +80,13 @@ class DummyVar : public ResourceBase {
   std::string name_;
   mutex mu_;
 
+  bool track_delta_ = false;
+  KeyType *touched_keys_ = nullptr;  // device-side log of touched keys
+  size_t touched_capacity_ = 0;
+  size_t touched_count_ = 0;
+
   void check_var();
+  void log_touched(const void *keys, size_t num_keys, cudaStream_t stream);
 };
 
 }  // namespace tensorflow
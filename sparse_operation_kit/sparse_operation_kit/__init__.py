@@ -66,9 +66,12 @@ from sparse_operation_kit.optimizer import SGD
 
 
 from sparse_operation_kit.lookup import lookup_sparse, sparse_read_and_evict
+from sparse_operation_kit.lookup import group_lookup_combine
 from sparse_operation_kit.lookup import all2all_dense_embedding
 
 from sparse_operation_kit.dump_load import dump, load, incremental_model_dump
+from sparse_operation_kit.dump_load import incremental_model_dump_to_filesystem
+from sparse_operation_kit.dump_load import incremental_model_load
 
 
 # a specific code path for dl framework tf2.11.0
@@ -15,6 +15,7 @@
 #
 import os
 import sys
+import json
 import string
 import numpy as np
 from enum import Enum
@@ -1378,16 +1379,17 @@ def incremental_model_dump(sok_vars, time_threshold, sess=None):
                 )
             )
         tmp_backend = sok_var.backend_type
-        if tmp_backend != "hybrid":
+        track_delta = getattr(sok_var, "_config_dict", {}).get("track_delta", False)
+        if tmp_backend != "hybrid" and not track_delta:
             raise Exception(
-                "Now only support sok.DynamicVariable with HKV backend, but the {}-th sok variable in the input sok_vars is not hkv backend!".format(
+                "Now only support sok.DynamicVariable with HKV backend or created with track_delta=True, but the {}-th sok variable in the input sok_vars is neither!".format(
                     str(i)
                 )
             )
 
     timestamp_list = []
     if len(time_threshold) == 1:
-        timestamp = datetime.timestamp(time_threshold[0])
+        timestamp = 0 if time_threshold[0] is None else datetime.timestamp(time_threshold[0])
         timestamp_ns = int(timestamp * 1e9)
 
         for i in range(len(sok_vars)):
@@ -1395,7 +1397,7 @@ def incremental_model_dump(sok_vars, time_threshold, sess=None):
     else:
         for i in range(len(time_threshold)):
             tmp_time = time_threshold[i]
-            timestamp = datetime.timestamp(tmp_time)
+            timestamp = 0 if tmp_time is None else datetime.timestamp(tmp_time)
             timestamp_ns = int(timestamp * 1e9)
             timestamp_list.append(np.array([timestamp_ns]))
     var_num = len(sok_vars)
@@ -1408,9 +1410,16 @@ def incremental_model_dump(sok_vars, time_threshold, sess=None):
         for i, sok_var in enumerate(sok_vars):
             time_threshold_tensor = tf.placeholder(shape=[None], dtype=tf.uint64)
             time_threshold_tensor_list.append(time_threshold_tensor)
-            tmp_keys, tmp_values = raw_ops.dummy_var_export_if(
-                sok_var.handle, time_threshold_tensor
-            )
+            if getattr(sok_var, "_config_dict", {}).get("track_delta", False):
+                tmp_keys = raw_ops.dummy_var_export_touched(sok_var.handle)
+                tmp_keys, _ = tf.unique(tmp_keys)
+                tmp_values = raw_ops.dummy_var_sparse_read(
+                    sok_var.handle, tmp_keys, dtype=sok_var.handle_dtype
+                )
+            else:
+                tmp_keys, tmp_values = raw_ops.dummy_var_export_if(
+                    sok_var.handle, time_threshold_tensor
+                )
             with tf.device("CPU"):
                 tmp_keys = tf.identity(tmp_keys)
                 tmp_values = tf.identity(tmp_values)
@@ -1435,10 +1444,17 @@ def incremental_model_dump(sok_vars, time_threshold, sess=None):
             values_list_global.append(result_list[i + var_num])
     else:
         for i, sok_var in enumerate(sok_vars):
-            time_threshold_tensor = tf.constant(timestamp_list[i], dtype=tf.uint64)
-            tmp_keys, tmp_values = raw_ops.dummy_var_export_if(
-                sok_var.handle, time_threshold_tensor
-            )
+            if getattr(sok_var, "_config_dict", {}).get("track_delta", False):
+                tmp_keys = raw_ops.dummy_var_export_touched(sok_var.handle)
+                tmp_keys, _ = tf.unique(tmp_keys)
+                tmp_values = raw_ops.dummy_var_sparse_read(
+                    sok_var.handle, tmp_keys, dtype=sok_var.handle_dtype
+                )
+            else:
+                time_threshold_tensor = tf.constant(timestamp_list[i], dtype=tf.uint64)
+                tmp_keys, tmp_values = raw_ops.dummy_var_export_if(
+                    sok_var.handle, time_threshold_tensor
+                )
             with tf.device("CPU"):
                 tmp_keys = tf.identity(tmp_keys)
                 tmp_values = tf.identity(tmp_values)
@@ -1450,3 +1466,102 @@ def incremental_model_dump(sok_vars, time_threshold, sess=None):
                 keys_list_global.append(allgather(keys_list_local[i]).numpy())
                 values_list_global.append(allgather(values_list_local[i]).numpy())
     return keys_list_global, values_list_global
+
+
+def incremental_model_dump_to_filesystem(path, sok_vars, time_threshold=None, sess=None):
+    """
+    Abbreviated as ``sok.incremental_model_dump_to_filesystem``.
+
+    Dump only the rows updated since ``time_threshold`` (HKV backend) or since the
+    last incremental dump (variables created with ``track_delta=True``) into binary
+    delta files plus a JSON manifest, instead of rewriting the whole table.
+
+    Layout under ``path``:
+        <table_name>-delta-key     the delta keys
+        <table_name>-delta-weight  the delta embedding vectors
+        manifest.json              per-table dtypes, counts and dimensions
+
+    Keys are gathered from all GPUs first and only global GPU 0 writes the files.
+    A delta can be applied onto a full checkpoint with ``sok.incremental_model_load``.
+
+    Parameters
+    ----------
+    path: str
+        directory to write the delta files and manifest into.
+    sok_vars: List, Tuple of SOK Variable
+        a single or list of sok.DynamicVariable, either with HKV backend or created
+        with ``track_delta=True``.
+    time_threshold: List, Tuple of ``datetime.datetime``, optional
+        same meaning as in ``sok.incremental_model_dump``; may be None for variables
+        created with ``track_delta=True``.
+    sess: tf.compat.v1.Session
+        Only use in TensorFlow 1.15.
+    """
+    if not (isinstance(sok_vars, list) or isinstance(sok_vars, tuple)):
+        sok_vars = [sok_vars]
+    keys_list, values_list = incremental_model_dump(sok_vars, time_threshold, sess=sess)
+    if global_gpu_id() != 0:
+        return
+    os.makedirs(path, exist_ok=True)
+    manifest = {
+        "format": "sok_incremental_delta",
+        "version": 1,
+        "utc_dump_time": datetime.utcnow().isoformat(),
+        "tables": [],
+    }
+    for var, keys, values in zip(sok_vars, keys_list, values_list):
+        table_name = var.name
+        for i in string.punctuation:
+            table_name = table_name.replace(i, "_")
+        key_path = path + "/" + table_name + "-delta-key"
+        weight_path = path + "/" + table_name + "-delta-weight"
+        with open(key_path, mode="wb") as fkey:
+            keys.tofile(fkey)
+        with open(weight_path, mode="wb") as femb:
+            values.tofile(femb)
+        manifest["tables"].append(
+            {
+                "table_name": table_name,
+                "key_file": os.path.basename(key_path),
+                "weight_file": os.path.basename(weight_path),
+                "key_dtype": str(keys.dtype),
+                "weight_dtype": str(values.dtype),
+                "num_keys": int(keys.shape[0]),
+                "dimension": int(var.dimension),
+            }
+        )
+    with open(path + "/manifest.json", mode="w") as fmanifest:
+        json.dump(manifest, fmanifest, indent=2)
+
+
+def incremental_model_load(path, sok_vars):
+    """
+    Abbreviated as ``sok.incremental_model_load``.
+
+    Apply a delta dump produced by ``sok.incremental_model_dump_to_filesystem`` onto
+    the given variables: the rows listed in the manifest are assigned, all other rows
+    are left untouched. Load a full checkpoint with ``sok.load`` first.
+    """
+    if not (isinstance(sok_vars, list) or isinstance(sok_vars, tuple)):
+        sok_vars = [sok_vars]
+    with open(path + "/manifest.json", mode="r") as fmanifest:
+        manifest = json.load(fmanifest)
+    if manifest.get("format") != "sok_incremental_delta":
+        raise Exception("{}/manifest.json is not a sok incremental delta manifest".format(path))
+    tables = {entry["table_name"]: entry for entry in manifest["tables"]}
+    for var in sok_vars:
+        table_name = var.name
+        for i in string.punctuation:
+            table_name = table_name.replace(i, "_")
+        if table_name not in tables:
+            raise Exception(
+                "table {} is not recorded in {}/manifest.json".format(table_name, path)
+            )
+        entry = tables[table_name]
+        keys = np.fromfile(path + "/" + entry["key_file"], dtype=np.dtype(entry["key_dtype"]))
+        values = np.fromfile(
+            path + "/" + entry["weight_file"], dtype=np.dtype(entry["weight_dtype"])
+        ).reshape([-1, entry["dimension"]])
+        if keys.shape[0] != entry["num_keys"] or values.shape[0] != entry["num_keys"]:
+            raise Exception("delta files of table {} are truncated".format(table_name))
+        assign(var, keys, values)
@@ -66,6 +66,14 @@ class DynamicVariable(ResourceVariable):
 
         If use HKV as the backend, please set init_capacity and max_capacity value equal to 2 powers.
 
+        The HKV backend is hierarchical: embedding vectors beyond ``max_hbm_for_vectors``
+        giga-bytes spill to pinned host memory and are fetched back in batches on lookup,
+        so a table can grow past the device memory without changing the training loop.
+        Pass the tier configuration as extra keyword arguments, e.g.
+        ``sok.DynamicVariable(dimension=128, var_type="hybrid", init_capacity=1024 * 1024,
+        max_capacity=64 * 1024 * 1024, max_hbm_for_vectors=40)``. Cold rows are selected
+        for eviction to the host tier according to ``evict_strategy`` (default "kLru").
+
     key_type: dtype
         specify the data type of indices. Unlike the static variable of
         tensorflow, this variable is dynamically allocated and contains
@@ -108,6 +108,51 @@ def _GroupLookupGrad(op, *top_grads):
     return grads
 
 
+def group_lookup_combine(params, sp_ids, combiners=None, dtype=None, name=None):
+    # Fused-version of tf.nn.embedding_lookup_sparse on single GPU: gathers and
+    # segment-reduces every table in one kernel launch instead of per-table
+    # gathers followed by TF-level segment ops.
+    if not (isinstance(params, list) or isinstance(params, tuple)):
+        params = [params]
+    if not (isinstance(sp_ids, list) or isinstance(sp_ids, tuple)):
+        sp_ids = [sp_ids]
+    if combiners is None:
+        combiners = ["mean"] * len(params)
+    with ops.name_scope("GroupLookupCombine" if name is None else name) as name:
+        for param in params:
+            variable_accessed(param)
+        handles = [param.handle for param in params]
+        values, offsets = [], []
+        for sp in sp_ids:
+            if isinstance(sp, tf.sparse.SparseTensor):
+                sp = tf.RaggedTensor.from_sparse(sp)
+            values.append(sp.values)
+            offsets.append(tf.cast(sp.row_splits, tf.int64))
+        outputs = raw_ops.group_lookup_combine(
+            handles, values, offsets, combiners=combiners, dtype=dtype
+        )
+        for i in range(len(outputs)):
+            outputs[i] = array_ops.identity(outputs[i])
+    return outputs
+
+
+@tf.RegisterGradient("GroupLookupCombine")
+def _GroupLookupCombineGrad(op, *top_grads):
+    N = op.get_attr("N")
+    combiners = op.get_attr("combiners")
+    values_list = [op.inputs[N + i] for i in range(N)]
+    offsets_list = [op.inputs[2 * N + i] for i in range(N)]
+    grad_values = raw_ops.group_lookup_combine_grad(
+        list(top_grads), values_list, offsets_list, combiners=combiners
+    )
+    grads = []
+    for i in range(N):
+        handle = op.inputs[i]
+        params_shape = variable_shape(handle)
+        grads.append(tf.IndexedSlices(grad_values[i], values_list[i], params_shape))
+    return grads + [None] * (2 * N)
+
+
 @tf.RegisterGradient("Reorder")
 def _ReorderGrad(op, grad):
     indices = op.inputs[1]
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <common.hpp>
+#include <data_readers/check_crc32.hpp>
 #include <data_readers/check_sum.hpp>
 #include <data_readers/file_source.hpp>
 
@@ -65,3 +66,49 @@ TEST(checker, CheckSum) {
   // }
   EXPECT_EQ(strncmp(tmp1, str, NUM_CHAR), 0);
 }
+
+TEST(checker, CheckCRC32) {
+  // reference bitwise CRC32C, independent of the accelerated implementation under test
+  auto ref_crc32c = [](const std::string& str) {
+    uint32_t crc = ~0u;
+    for (char c : str) {
+      crc ^= static_cast<unsigned char>(c);
+      for (int k = 0; k < 8; k++) {
+        crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1u)));
+      }
+    }
+    return ~crc;
+  };
+
+  auto func = [&](std::string file, std::string str) {
+    int count = str.length();
+    uint32_t crc = ref_crc32c(str);
+    std::ofstream out_stream(file, std::ofstream::binary);
+    out_stream.write(reinterpret_cast<char*>(&count), sizeof(int));
+    out_stream.write(str.c_str(), count);
+    out_stream.write(reinterpret_cast<char*>(&crc), sizeof(uint32_t));
+    out_stream.write(reinterpret_cast<char*>(&count), sizeof(int));
+    out_stream.write(str.c_str(), count);
+    out_stream.write(reinterpret_cast<char*>(&crc), sizeof(uint32_t));
+    out_stream.close();
+
+    out_stream.open("file_list.txt", std::ofstream::out);
+    out_stream << "1\n" << file;
+    out_stream.close();
+  };
+
+  const int NUM_CHAR = 7;
+  const char str[] = {"abcdefg"};
+  func("file1.txt", str);
+  const bool repeat = true;
+
+  FileSource file_source(0, 1, "file_list.txt", repeat);
+  CheckCRC32 check_crc32(file_source);
+  char tmp1[NUM_CHAR], tmp2[NUM_CHAR];
+  check_crc32.next_source(1);
+  EXPECT_EQ(check_crc32.read(tmp1, NUM_CHAR), Error_t::Success);
+  EXPECT_EQ(strncmp(tmp1, str, NUM_CHAR), 0);
+
+  EXPECT_EQ(check_crc32.read(tmp2, NUM_CHAR), Error_t::Success);
+  EXPECT_EQ(strncmp(tmp2, str, NUM_CHAR), 0);
+}
@@ -19,6 +19,7 @@
 #include <common.hpp>
 #include <core23/allocator_factory.hpp>
 #include <core23/allocator_params.hpp>
+#include <core23/details/pinned_arena_allocator.hpp>
 #include <core23/details/pool_cuda_allocator.hpp>
 #include <core23/logger.hpp>
 #include <cstdint>
@@ -106,12 +107,28 @@ TEST(test_core23, allocator_pool_cuda) {
   test_impl(my_allocator_params, device);
 }
 
+TEST(test_core23, allocator_stream_ordered_cuda) {
+  AllocatorParams my_allocator_params = g_allocator_params;
+  Device device(DeviceType::GPU, 0);
+  my_allocator_params.stream_ordered = true;
+  test_impl(my_allocator_params, device);
+}
+
 TEST(test_core23, allocator_pinned_host) {
   AllocatorParams my_allocator_params = g_allocator_params;
   Device device(DeviceType::CPU);
   test_impl(my_allocator_params, device);
 }
 
+TEST(test_core23, allocator_pinned_arena) {
+  AllocatorParams my_allocator_params = g_allocator_params;
+  Device device(DeviceType::CPU);
+  my_allocator_params.custom_factory = [](const auto& params, const auto& device) {
+    return std::unique_ptr<Allocator>(new PinnedArenaAllocator());
+  };
+  test_impl(my_allocator_params, device);
+}
+
 TEST(test_core23, allocator_new_delete) {
   AllocatorParams my_allocator_params = g_allocator_params;
   Device device(DeviceType::CPU);
@@ -18,12 +18,14 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
 #include <common.hpp>
 #include <core23/allocator_factory.hpp>
 #include <core23/allocator_params.hpp>
 #include <core23/buffer_client.hpp>
 #include <core23/buffer_factory.hpp>
 #include <core23/buffer_params.hpp>
+#include <core23/details/deferred_free_queue.hpp>
 #include <core23/details/pool_cuda_allocator.hpp>
 #include <core23/logger.hpp>
 #include <core23/offsetted_buffer.hpp>
@@ -113,6 +115,44 @@ void single_buffer_test_impl(BufferParams buffer_params, AllocatorParams allocat
   }
 }
 
+void lifetime_buffer_test_impl(Device device) {
+  AllocatorParams allocator_params = g_allocator_params;
+  BufferParams buffer_params = g_buffer_params;
+  buffer_params.channel = GetRandomBufferChannel();
+  buffer_params.lifetime_aware = true;
+
+  auto buffer = GetBuffer(buffer_params, device, std::move(GetAllocator(allocator_params, device)));
+  EXPECT_TRUE(buffer->subscribable());
+
+  constexpr int64_t num_bytes = 1024;
+
+  // Two clients with disjoint lifetimes must be aliased into the same storage, while a client
+  // whose lifetime overlaps both must get its own storage.
+  std::shared_ptr<DummyBufferClient> early_client(new DummyBufferClient());
+  std::shared_ptr<DummyBufferClient> late_client(new DummyBufferClient());
+  std::shared_ptr<DummyBufferClient> long_lived_client(new DummyBufferClient());
+  std::shared_ptr<DummyBufferClient> unannotated_client(new DummyBufferClient());
+  EXPECT_NO_THROW(buffer->subscribe(
+      early_client.get(),
+      {.num_bytes = num_bytes, .alignment = 16, .first_use = 0, .last_use = 1}));
+  EXPECT_NO_THROW(buffer->subscribe(
+      late_client.get(), {.num_bytes = num_bytes, .alignment = 16, .first_use = 2, .last_use = 3}));
+  EXPECT_NO_THROW(buffer->subscribe(
+      long_lived_client.get(),
+      {.num_bytes = num_bytes, .alignment = 16, .first_use = 0, .last_use = 3}));
+  EXPECT_NO_THROW(buffer->subscribe(unannotated_client.get(),
+                                    {.num_bytes = num_bytes, .alignment = 16}));
+
+  // Three distinct storage areas suffice: {early, late}, {long_lived} and {unannotated}.
+  EXPECT_TRUE(buffer->reserved_size() == 3 * num_bytes);
+  EXPECT_NO_THROW(buffer->allocate());
+
+  EXPECT_TRUE(early_client->data() == late_client->data());
+  EXPECT_FALSE(early_client->data() == long_lived_client->data());
+  EXPECT_FALSE(early_client->data() == unannotated_client->data());
+  EXPECT_FALSE(long_lived_client->data() == unannotated_client->data());
+}
+
 }  // namespace
 
 TEST(test_core23, single_unitary_buffer_gpu_simple) {
@@ -187,3 +227,33 @@ TEST(test_core23, single_confederal_buffer_gpu_pool) {
   my_buffer_params.unitary = false;
   single_buffer_test_impl(my_buffer_params, my_allocator_params, device);
 }
+
+TEST(test_core23, single_lifetime_buffer_gpu_simple) {
+  Device device(DeviceType::GPU, 0);
+  lifetime_buffer_test_impl(device);
+}
+
+TEST(test_core23, single_lifetime_buffer_pinned_host) {
+  Device device(DeviceType::CPU);
+  lifetime_buffer_test_impl(device);
+}
+
+TEST(test_core23, deferred_free_queue) {
+  Device device(DeviceType::GPU, 0);
+  CUDAStream stream(cudaStreamDefault);
+
+  auto allocator = GetAllocator(g_allocator_params, device);
+  void* ptr = allocator->allocate(1024 * 1024, stream);
+  EXPECT_FALSE(ptr == nullptr);
+
+  std::atomic<int> num_freed = 0;
+  auto& queue = DeferredFreeQueue::instance();
+  queue.enqueue(device, stream,
+                [allocator = std::shared_ptr<Allocator>(std::move(allocator)), ptr, &num_freed]() {
+                  allocator->deallocate(ptr);
+                  num_freed++;
+                });
+  queue.flush();
+  EXPECT_EQ(queue.pending(), 0);
+  EXPECT_EQ(num_freed, 1);
+}
@@ -87,6 +87,99 @@ void copy_test_impl(Device dst_device, Device src_device, bool async) {
       HugeCTR::test::compare_array_approx<int>(h_dst.data(), h_src.data(), h_dst.size(), 0));
 }
 
+void batched_copy_test_impl(Device device) {
+  // Many small copies with mixed sizes, including ones that defeat the vectorized path.
+  constexpr int64_t num_copies = 500;
+  TensorParams params = TensorParams().shape({num_copies, 160}).data_type(ScalarType::Char);
+  Tensor dst_tensor(params.device(device));
+  Tensor src_tensor(params.device(device));
+
+  std::vector<char> h_src(src_tensor.num_elements());
+  std::random_device r;
+  std::default_random_engine e(r());
+  std::uniform_int_distribution<int> uniform_dist(0, 127);
+  for (size_t i = 0; i < h_src.size(); i++) {
+    h_src[i] = static_cast<char>(uniform_dist(e));
+  }
+  copy_sync(src_tensor.data(), h_src.data(), src_tensor.num_bytes(), device, DeviceType::CPU);
+
+  std::vector<char> h_dst(dst_tensor.num_elements(), 0);
+  copy_sync(dst_tensor.data(), h_dst.data(), dst_tensor.num_bytes(), device, DeviceType::CPU);
+
+  std::vector<void*> dst_ptrs(num_copies);
+  std::vector<const void*> src_ptrs(num_copies);
+  std::vector<int64_t> num_bytes(num_copies);
+  for (int64_t i = 0; i < num_copies; i++) {
+    dst_ptrs[i] = dst_tensor.data<char>() + i * 160;
+    src_ptrs[i] = src_tensor.data<char>() + i * 160;
+    num_bytes[i] = (i % 2 == 0) ? 160 : 159;  // odd rows take the byte-wise path
+  }
+
+  CUDAStream stream(cudaStreamDefault, 0);
+  batched_copy_async(dst_ptrs.data(), src_ptrs.data(), num_bytes.data(), num_copies, device,
+                     stream);
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream()));
+
+  copy_sync(h_dst.data(), dst_tensor.data(), dst_tensor.num_bytes(), DeviceType::CPU, device);
+  for (int64_t i = 0; i < num_copies; i++) {
+    ASSERT_TRUE(HugeCTR::test::compare_array_approx<char>(h_dst.data() + i * 160,
+                                                          h_src.data() + i * 160, num_bytes[i], 0));
+    if (i % 2 != 0) {
+      ASSERT_TRUE(h_dst[i * 160 + 159] == 0);  // the last byte of odd rows must stay untouched
+    }
+  }
+}
+
+template <typename DstType, typename SrcType>
+void convert_pad_transpose_test_impl(Device device, bool transpose) {
+  constexpr int64_t num_rows = 33;
+  constexpr int64_t num_cols = 20;
+  const int64_t dst_rows = transpose ? num_cols : num_rows;
+  const int64_t dst_leading_dim = transpose ? 40 : 24;  // forces zero-padded trailing columns
+
+  Tensor src_tensor(TensorParams()
+                        .shape({num_rows, num_cols})
+                        .data_type(ToScalarType<SrcType>::value)
+                        .device(device));
+  Tensor dst_tensor(TensorParams()
+                        .shape({dst_rows, dst_leading_dim})
+                        .data_type(ToScalarType<DstType>::value)
+                        .device(device));
+
+  std::vector<SrcType> h_src(src_tensor.num_elements());
+  std::random_device r;
+  std::default_random_engine e(r());
+  std::uniform_real_distribution<float> uniform_dist(-1.f, 1.f);
+  for (size_t i = 0; i < h_src.size(); i++) {
+    h_src[i] = TypeConverter<SrcType, float>::value(uniform_dist(e));
+  }
+  copy_sync(src_tensor.data(), h_src.data(), src_tensor.num_bytes(), device, DeviceType::CPU);
+
+  CUDAStream stream(cudaStreamDefault, 0);
+  convert_pad_transpose_async<DstType, SrcType>(dst_tensor.data<DstType>(),
+                                                src_tensor.data<SrcType>(), num_rows, num_cols,
+                                                dst_leading_dim, transpose, device, stream);
+  HCTR_LIB_THROW(cudaStreamSynchronize(stream()));
+
+  std::vector<DstType> h_dst(dst_tensor.num_elements());
+  copy_sync(h_dst.data(), dst_tensor.data(), dst_tensor.num_bytes(), DeviceType::CPU, device);
+
+  std::vector<DstType> h_ref(dst_tensor.num_elements());
+  for (int64_t row = 0; row < dst_rows; row++) {
+    for (int64_t col = 0; col < dst_leading_dim; col++) {
+      const int64_t src_row = transpose ? col : row;
+      const int64_t src_col = transpose ? row : col;
+      h_ref[row * dst_leading_dim + col] =
+          (src_row < num_rows && src_col < num_cols)
+              ? TypeConverter<DstType, SrcType>::value(h_src[src_row * num_cols + src_col])
+              : TypeConverter<DstType, float>::value(0.f);
+    }
+  }
+
+  ASSERT_TRUE(
+      HugeCTR::test::compare_array_approx<DstType>(h_dst.data(), h_ref.data(), h_dst.size(), 0));
+}
+
 template <typename DstType, typename SrcType>
 void convert_test_impl(Device dst_device, Device src_device) {
   TensorParams params = TensorParams().shape({512, 512}).data_type(ToScalarType<SrcType>::value);
@@ -245,6 +338,31 @@ TEST(test_core23, gpu_to_cpu_copy_async_test) {
   copy_test_impl(dst_device, src_device, true);
 }
 
+TEST(test_core23, gpu_batched_copy_async_test) {
+  Device device(DeviceType::GPU, 0);
+  batched_copy_test_impl(device);
+}
+
+TEST(test_core23, cpu_batched_copy_async_test) {
+  Device device(DeviceType::CPU);
+  batched_copy_test_impl(device);
+}
+
+TEST(test_core23, gpu_float_to_half_convert_pad_test) {
+  Device device(DeviceType::GPU, 0);
+  convert_pad_transpose_test_impl<__half, float>(device, false);
+}
+
+TEST(test_core23, gpu_float_to_half_convert_transpose_pad_test) {
+  Device device(DeviceType::GPU, 0);
+  convert_pad_transpose_test_impl<__half, float>(device, true);
+}
+
+TEST(test_core23, cpu_float_convert_transpose_pad_test) {
+  Device device(DeviceType::CPU);
+  convert_pad_transpose_test_impl<float, float>(device, true);
+}
+
 TEST(test_core23, intra_gpu_float_to_half_convert_async_test) {
   Device device(DeviceType::GPU, 0);
   convert_test_impl<__half, float>(device, device);
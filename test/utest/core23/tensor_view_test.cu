@@ -198,6 +198,79 @@ void tensor_view_test_impl() {
   }
 }
 
+template <typename TensorViewType>
+__global__ void static_copy_kernel(TensorViewType input_tensor, TensorViewType output_tensor) {
+  const int64_t x_base = blockIdx.x * blockDim.x + threadIdx.x;
+  const int64_t y_base = blockIdx.y * blockDim.y + threadIdx.y;
+  for (int64_t y = y_base; y < output_tensor.size(0); y += blockDim.y * gridDim.y) {
+    for (int64_t x = x_base; x < output_tensor.size(1); x += blockDim.x * gridDim.x) {
+      output_tensor[y][x] = input_tensor[y][x];
+    }
+  }
+}
+
+void static_tensor_view_test_impl() {
+  std::random_device r;
+  std::default_random_engine e(r());
+  std::uniform_int_distribution<int> uniform_dist(0, 1024);
+
+  std::vector<int> h_ins(INPUT_SIZE);
+  for (size_t i = 0; i < h_ins.size(); i++) {
+    h_ins[i] = uniform_dist(e);
+  }
+  std::vector<int> h_outs(INPUT_SIZE);
+
+  BufferParams buffer_params;
+  buffer_params.channel = "STATIC_TENSOR_VIEW_TEST";
+
+  auto tensor_params = TensorParams()
+                           .shape({INPUT_SIZE_Y, INPUT_SIZE_X})
+                           .buffer_params(buffer_params)
+                           .data_type(ScalarType::Int32);
+  auto input_tensor_2d = Tensor(tensor_params);
+  auto output_tensor_2d = Tensor(tensor_params);
+
+  HCTR_LIB_THROW(cudaMemcpy(input_tensor_2d.data(), h_ins.data(), input_tensor_2d.num_bytes(),
+                            cudaMemcpyHostToDevice));
+
+  // The outermost extent stays dynamic while the inner extent and all strides fold at
+  // compile time.
+  auto input_tensor_view = input_tensor_2d.view<int, 2, DynamicExtent, INPUT_SIZE_X>();
+  auto output_tensor_view = output_tensor_2d.view<int, 2, DynamicExtent, INPUT_SIZE_X>();
+
+  EXPECT_TRUE(input_tensor_view.size(0) == INPUT_SIZE_Y);
+  EXPECT_TRUE(input_tensor_view.size(1) == INPUT_SIZE_X);
+  EXPECT_TRUE(input_tensor_view.stride(0) == INPUT_SIZE_X);
+  EXPECT_TRUE(input_tensor_view.stride(1) == 1);
+  EXPECT_TRUE(input_tensor_2d.data() == &input_tensor_view[0][0]);
+
+  // The static extents must be consistent with the Tensor's shape.
+  auto illegal_view = [&input_tensor_2d]() {
+    input_tensor_2d.view<int, 2, DynamicExtent, INPUT_SIZE_X + 1>();
+  };
+  EXPECT_THROW(illegal_view(), HugeCTR::core23::RuntimeError);
+
+  dim3 block(32, 32);
+  dim3 grid((INPUT_SIZE_X + block.x - 1) / block.x, (INPUT_SIZE_Y + block.y - 1) / block.y);
+  static_copy_kernel<<<grid, block>>>(input_tensor_view, output_tensor_view);
+  HCTR_LIB_THROW(cudaDeviceSynchronize());
+
+  HCTR_LIB_THROW(cudaMemcpy(h_outs.data(), output_tensor_2d.data(), output_tensor_2d.num_bytes(),
+                            cudaMemcpyDeviceToHost));
+
+  int64_t match_count = 0;
+  for (int64_t y = 0; y < INPUT_SIZE_Y; y++) {
+    for (int64_t x = 0; x < INPUT_SIZE_X; x++) {
+      if (h_outs[y * INPUT_SIZE_X + x] == h_ins[y * INPUT_SIZE_X + x]) {
+        match_count++;
+      }
+    }
+  }
+  EXPECT_TRUE(match_count == INPUT_SIZE_Y * INPUT_SIZE_X);
+}
+
 }  // namespace
 
 TEST(test_core23, tensor_view_3d_test) { tensor_view_test_impl(); }
+
+TEST(test_core23, static_tensor_view_test) { static_tensor_view_test_impl(); }
@@ -204,3 +204,101 @@ typedef ::testing::Types<std::tuple<float, unsigned int>, std::tuple<__half, uns
 
 REGISTER_TYPED_TEST_CASE_P(SplitBatchFixture, split_feat_major_one_hot, split_feat_major_multi_hot);
 INSTANTIATE_TYPED_TEST_CASE_P(SplitBatchTests, SplitBatchFixture, SplitTypes);
+
+// Host-side split for CPU-staging deployments; same layout as the device
+// kernel but all tensors live on the host.
+template <typename DenseType, typename SparseType>
+void run_split_cpu_test(bool dense_is_float) {
+  std::vector<int> nnz_per_slot;
+  for (int i = 0; i < sparse_dim; ++i) {
+    nnz_per_slot.push_back((rand() % 4) + 1);
+  }
+  const int total_nnz = std::accumulate(nnz_per_slot.begin(), nnz_per_slot.end(), 0);
+  const int64_t sample_dim = label_dim + dense_dim + total_nnz;
+
+  auto params = core23::TensorParams().device(core23::Device(core23::DeviceType::CPU));
+
+  core23::Tensor label_tensor(
+      params.shape({batch_size, label_dim}).data_type(core23::ScalarType::Float));
+  core23::Tensor dense_tensor(params.shape({batch_size, dense_dim})
+                                  .data_type(core23::ToScalarType<DenseType>::value));
+  core23::Tensor label_dense_sparse(
+      params.shape({batch_size, sample_dim}).data_type(core23::ScalarType::Int32));
+  core23::Tensor sparse_tensor_ptrs(
+      params.shape({sparse_dim}).data_type(core23::ScalarType::UInt64));
+  core23::Tensor bucket_id_tensor(
+      params.shape({total_nnz}).data_type(core23::ScalarType::Int32));
+  core23::Tensor bucket_position_tensor(
+      params.shape({total_nnz}).data_type(core23::ScalarType::Int32));
+  core23::Tensor max_hotness_tensor(
+      params.shape({sparse_dim}).data_type(core23::ScalarType::Int32));
+
+  std::vector<core23::Tensor> sparse_tensors;
+  for (int64_t i = 0; i < sparse_dim; ++i) {
+    sparse_tensors.emplace_back(params.shape({batch_size, nnz_per_slot[i]})
+                                    .data_type(core23::ToScalarType<SparseType>::value));
+    reinterpret_cast<SparseType**>(sparse_tensor_ptrs.data())[i] =
+        sparse_tensors.back().template data<SparseType>();
+  }
+
+  int* bucket_ids = bucket_id_tensor.data<int>();
+  int* bucket_positions = bucket_position_tensor.data<int>();
+  int bucket = 0, feat = 0;
+  for (auto hotness : nnz_per_slot) {
+    for (int pos = 0; pos < hotness; ++pos, ++feat) {
+      bucket_ids[feat] = bucket;
+      bucket_positions[feat] = pos;
+    }
+    max_hotness_tensor.data<int>()[bucket] = hotness;
+    bucket++;
+  }
+
+  // initialize each column with unique number so we can check the batch was split correctly
+  int* batch = label_dense_sparse.data<int>();
+  for (int64_t i = 0; i < batch_size * sample_dim; ++i) {
+    const int col_value = (i % sample_dim) + 1;
+    const int64_t col = i % sample_dim;
+    if (dense_is_float && col >= label_dim && col < label_dim + dense_dim) {
+      reinterpret_cast<float*>(batch)[i] = static_cast<float>(col_value);
+    } else {
+      batch[i] = col_value;
+    }
+  }
+
+  split_3_way_feat_major_cpu<DenseType, SparseType>(
+      label_tensor, dense_tensor, sparse_tensor_ptrs, label_dense_sparse, bucket_id_tensor,
+      bucket_position_tensor, max_hotness_tensor, dense_is_float);
+
+  for (int64_t i = 0; i < batch_size * label_dim; ++i) {
+    EXPECT_EQ(label_tensor.data<float>()[i], static_cast<float>((i % label_dim) + 1));
+  }
+
+  const float eps = std::is_same<DenseType, __half>::value ? 1e-2f : 1e-5f;
+  for (int64_t i = 0; i < batch_size * dense_dim; ++i) {
+    const int value = (i % dense_dim) + 1 + label_dim;
+    const float expected = dense_is_float ? static_cast<float>(value) : logf(value + 1.f);
+    EXPECT_NEAR(static_cast<float>(dense_tensor.data<DenseType>()[i]), expected, eps);
+  }
+
+  int64_t feat_id = 0;
+  for (int64_t i = 0; i < sparse_dim; ++i) {
+    const int hotness = nnz_per_slot[i];
+    for (int64_t j = 0; j < batch_size * hotness; ++j) {
+      const SparseType expected = label_dim + dense_dim + feat_id + (j % hotness) + 1;
+      EXPECT_EQ(sparse_tensors[i].template data<SparseType>()[j], expected);
+    }
+    feat_id += hotness;
+  }
+}
+
+TEST(SplitBatchCpuTest, split_feat_major_cpu_int_dense) {
+  run_split_cpu_test<float, uint32_t>(false);
+}
+
+TEST(SplitBatchCpuTest, split_feat_major_cpu_float_dense) {
+  run_split_cpu_test<float, uint32_t>(true);
+}
+
+TEST(SplitBatchCpuTest, split_feat_major_cpu_half_dense) {
+  run_split_cpu_test<__half, uint32_t>(false);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <embedding/frequency_aware_placement.hpp>
+
+using namespace embedding;
+
+TEST(test_frequency_aware_placement, hot_tables_replicated) {
+  // table 0: small & hot, table 1: small & warm, table 2: huge & cold
+  std::vector<TableFrequencyStats> stats = {
+      {0, 1000, 128, 0.7},
+      {1, 2000, 128, 0.25},
+      {2, 10000000, 128, 0.05},
+  };
+  FrequencyAwarePlacementParam param;
+  param.replication_budget_per_gpu = (1000 + 2000) * 128;
+
+  std::vector<GroupedTableParam> grouped_table_params;
+  std::vector<std::vector<int>> shard_matrix;
+  plan_frequency_aware_placement(stats, 4, param, &grouped_table_params, &shard_matrix);
+
+  ASSERT_EQ(grouped_table_params.size(), 2);
+  EXPECT_EQ(grouped_table_params[0].table_placement_strategy, TablePlacementStrategy::DataParallel);
+  EXPECT_EQ(grouped_table_params[0].table_ids, (std::vector<int>{0, 1}));
+  EXPECT_EQ(grouped_table_params[1].table_placement_strategy, TablePlacementStrategy::ModelParallel);
+  EXPECT_EQ(grouped_table_params[1].table_ids, (std::vector<int>{2}));
+
+  ASSERT_EQ(shard_matrix.size(), 4);
+  for (auto &row : shard_matrix) {
+    EXPECT_EQ(row, (std::vector<int>{1, 1, 1}));
+  }
+}
+
+TEST(test_frequency_aware_placement, budget_exhausted_falls_back_to_mp) {
+  std::vector<TableFrequencyStats> stats = {
+      {0, 1000, 128, 0.6},
+      {1, 1000, 128, 0.4},
+  };
+  FrequencyAwarePlacementParam param;
+  param.replication_budget_per_gpu = 1000 * 128;  // room for one table only
+
+  std::vector<GroupedTableParam> grouped_table_params;
+  std::vector<std::vector<int>> shard_matrix;
+  plan_frequency_aware_placement(stats, 2, param, &grouped_table_params, &shard_matrix);
+
+  ASSERT_EQ(grouped_table_params.size(), 2);
+  EXPECT_EQ(grouped_table_params[0].table_placement_strategy, TablePlacementStrategy::DataParallel);
+  EXPECT_EQ(grouped_table_params[0].table_ids, (std::vector<int>{0}));
+  EXPECT_EQ(grouped_table_params[1].table_ids, (std::vector<int>{1}));
+}
+
+TEST(test_frequency_aware_placement, low_traffic_tables_never_replicated) {
+  std::vector<TableFrequencyStats> stats = {
+      {0, 10, 8, 0.005},  // tiny but negligible traffic
+      {1, 1000, 8, 0.995},
+  };
+  FrequencyAwarePlacementParam param;
+  param.replication_budget_per_gpu = 1000000;
+
+  std::vector<GroupedTableParam> grouped_table_params;
+  std::vector<std::vector<int>> shard_matrix;
+  plan_frequency_aware_placement(stats, 2, param, &grouped_table_params, &shard_matrix);
+
+  ASSERT_EQ(grouped_table_params.size(), 2);
+  EXPECT_EQ(grouped_table_params[0].table_ids, (std::vector<int>{1}));
+  EXPECT_EQ(grouped_table_params[1].table_placement_strategy, TablePlacementStrategy::ModelParallel);
+  EXPECT_EQ(grouped_table_params[1].table_ids, (std::vector<int>{0}));
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <core23/tensor.hpp>
+#include <metrics.hpp>
+#include <numeric>
+#include <random>
+#include <resource_managers/resource_manager_core.hpp>
+#include <utest/test_utils.hpp>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+// The binned approximation error is bounded by the bin width; with the default
+// 8192 bins this margin leaves ample headroom.
+const float eps = 5.0e-3;
+
+// Exact single-class AUC by sorting on the host, used as the reference
+float host_exact_auc(const std::vector<float>& labels, const std::vector<float>& scores) {
+  std::vector<size_t> order(scores.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+
+  double total_pos = std::accumulate(labels.begin(), labels.end(), 0.0);
+  double total_neg = static_cast<double>(labels.size()) - total_pos;
+  if (total_pos == 0.0 || total_neg == 0.0) {
+    return 0.5f;
+  }
+
+  double tp = 0.0, fp = 0.0, prev_tpr = 0.0, prev_fpr = 0.0, auc = 0.0;
+  for (size_t idx : order) {
+    if (labels[idx] > 0.5f) {
+      tp += 1.0;
+    } else {
+      fp += 1.0;
+    }
+    double tpr = tp / total_pos;
+    double fpr = fp / total_neg;
+    auc += (fpr - prev_fpr) * (tpr + prev_tpr) * 0.5;
+    prev_tpr = tpr;
+    prev_fpr = fpr;
+  }
+  return static_cast<float>(auc);
+}
+
+void streaming_auc_test(size_t num_total_samples, size_t batch_size, size_t num_classes) {
+  std::vector<std::vector<int>> vvgpu{{0}};
+  const auto resource_manager = ResourceManagerCore::create(vvgpu, 424242);
+  int device_id = resource_manager->get_local_gpu(0)->get_device_id();
+  CudaDeviceContext context(device_id);
+
+  // Scores correlated with the labels so the AUC is meaningfully above 0.5
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> score_dist(0.0f, 1.0f);
+  std::vector<float> h_labels(num_total_samples * num_classes);
+  std::vector<float> h_scores(num_total_samples * num_classes);
+  for (size_t i = 0; i < h_scores.size(); i++) {
+    h_scores[i] = score_dist(gen);
+    std::bernoulli_distribution label_dist(0.25f + 0.5f * h_scores[i]);
+    h_labels[i] = label_dist(gen) ? 1.0f : 0.0f;
+  }
+
+  core23::Shape dims = {static_cast<int64_t>(batch_size), static_cast<int64_t>(num_classes)};
+  core23::Tensor labels_tensor(core23::TensorParams()
+                                   .data_type(core23::ToScalarType<float>::value)
+                                   .device(core23::Device(core23::DeviceType::GPU, device_id))
+                                   .shape(dims));
+  core23::Tensor scores_tensor(core23::TensorParams()
+                                   .data_type(core23::ToScalarType<float>::value)
+                                   .device(core23::Device(core23::DeviceType::GPU, device_id))
+                                   .shape(dims));
+  metrics::Core23RawMetricMap metric_map = {{metrics::RawType::Pred, scores_tensor},
+                                            {metrics::RawType::Label, labels_tensor}};
+
+  metrics::StreamingAUC<float> metric(batch_size, num_classes, resource_manager);
+
+  auto stream = resource_manager->get_local_gpu(0)->get_stream();
+  size_t num_processed = 0;
+  while (num_processed < num_total_samples) {
+    size_t current_batch_size = std::min(batch_size, num_total_samples - num_processed);
+    metric.set_current_batch_size(current_batch_size);
+
+    HCTR_LIB_THROW(cudaMemcpyAsync(labels_tensor.data(),
+                                   h_labels.data() + num_processed * num_classes,
+                                   current_batch_size * num_classes * sizeof(float),
+                                   cudaMemcpyHostToDevice, stream));
+    HCTR_LIB_THROW(cudaMemcpyAsync(scores_tensor.data(),
+                                   h_scores.data() + num_processed * num_classes,
+                                   current_batch_size * num_classes * sizeof(float),
+                                   cudaMemcpyHostToDevice, stream));
+    metric.local_reduce(0, metric_map);
+    metric.global_reduce(1);
+
+    num_processed += current_batch_size;
+  }
+
+  float gpu_result = metric.finalize_metric();
+
+  // Reference: average of the exact per-class AUCs (samples are class-major interleaved)
+  double ref_sum = 0.0;
+  for (size_t class_id = 0; class_id < num_classes; class_id++) {
+    std::vector<float> class_labels(num_total_samples);
+    std::vector<float> class_scores(num_total_samples);
+    for (size_t i = 0; i < num_total_samples; i++) {
+      class_labels[i] = h_labels[i * num_classes + class_id];
+      class_scores[i] = h_scores[i * num_classes + class_id];
+    }
+    ref_sum += host_exact_auc(class_labels, class_scores);
+  }
+  float ref_result = static_cast<float>(ref_sum / num_classes);
+
+  ASSERT_NEAR(gpu_result, ref_result, eps);
+}
+
+}  // namespace
+
+TEST(streaming_auc, single_class) { streaming_auc_test(200000, 4096, 1); }
+TEST(streaming_auc, single_class_partial_last_batch) { streaming_auc_test(100001, 8192, 1); }
+TEST(streaming_auc, multi_class) { streaming_auc_test(100000, 2048, 3); }
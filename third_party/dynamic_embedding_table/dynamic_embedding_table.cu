@@ -143,6 +143,24 @@ void DynamicEmbeddingTable<KeyType, ElementType>::lookup(
   CUCO_CUDA_TRY(cudaGetLastError());
 }
 
+template <typename KeyType, typename ElementType>
+void DynamicEmbeddingTable<KeyType, ElementType>::reserve(size_t const *num_keys_per_class,
+                                                          cudaStream_t stream) {
+  CUCO_CUDA_TRY(cudaEventRecord(primary_event_, stream));
+
+  for (size_t i = 0; i < num_classes_; ++i) {
+    if (num_keys_per_class[i] == 0) {
+      continue;
+    }
+    CUCO_CUDA_TRY(cudaStreamWaitEvent(stream_per_class_[i], primary_event_));
+    maps_[i]->reserve(num_keys_per_class[i], stream_per_class_[i]);
+    CUCO_CUDA_TRY(cudaEventRecord(event_per_class_[i], stream_per_class_[i]));
+    CUCO_CUDA_TRY(cudaStreamWaitEvent(stream, event_per_class_[i]));
+  }
+
+  CUCO_CUDA_TRY(cudaGetLastError());
+}
+
 template <typename KeyType, typename ElementType>
 void DynamicEmbeddingTable<KeyType, ElementType>::lookup_unsafe(
     KeyType const *keys, ElementType **output_elements, size_t num_keys, size_t const *id_spaces,
@@ -43,6 +43,10 @@ class DynamicEmbeddingTable {
   void initialize(cudaStream_t stream = 0);
   void uninitialize(cudaStream_t stream = 0);
 
+  // Pre-creates enough submaps per class to hold the given number of keys, so
+  // later inserts never have to allocate and initialize capacity on the fly.
+  void reserve(size_t const *num_keys_per_class, cudaStream_t stream = 0);
+
   void lookup(KeyType const *keys, ElementType *elements, size_t num_keys, size_t const *id_spaces,
               size_t const *id_space_offsets, size_t num_id_spaces, cudaStream_t stream = 0);
   void lookup_unsafe(KeyType const *keys, ElementType **elements, size_t num_keys,
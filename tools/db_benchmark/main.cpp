@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <argparse/argparse.hpp>
+#include <cmath>
 #include <core/memory.hpp>
 #include <core23/logger.hpp>
 #include <hps/hash_map_backend.hpp>
@@ -26,6 +28,7 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -33,6 +36,81 @@ using namespace HugeCTR;
 
 typedef long long Key;
 
+/**
+ * Draws keys from [0, num_keys) either uniformly or with power-law skew (same inverse-CDF
+ * formulation as the data generator), so the benchmark can replay the access pattern of a
+ * deployment instead of assuming every key is equally hot.
+ */
+class KeySampler {
+ public:
+  KeySampler(const size_t num_keys, const float alpha, const uint64_t seed)
+      : gen_(seed), uni_(0, num_keys - 1), real_(0.0, 1.0), alpha_(alpha), max_(num_keys) {}
+
+  Key next() {
+    if (alpha_ <= 0.f) {
+      return uni_(gen_);
+    }
+    const double x = real_(gen_);
+    const double y = pow((pow(max_, 1.0 - alpha_) - 1.0) * x + 1.0, 1.0 / (1.0 - alpha_));
+    return std::min(static_cast<Key>(round(y)) - 1, static_cast<Key>(max_) - 1);
+  }
+
+ private:
+  std::mt19937_64 gen_;
+  std::uniform_int_distribution<Key> uni_;
+  std::uniform_real_distribution<double> real_;
+  const float alpha_;  // <= 0 selects uniform; otherwise requires alpha_ != 1.0.
+  const double max_;
+};
+
+/**
+ * Sorts the collected per-batch latencies and prints percentiles plus a log2-bucketed
+ * histogram, so tail behavior is visible instead of just the mean.
+ */
+void print_latency_report(const std::string& name, std::vector<uint64_t>& lat_us,
+                          const size_t bytes_per_op) {
+  if (lat_us.empty()) {
+    return;
+  }
+  std::sort(lat_us.begin(), lat_us.end());
+
+  uint64_t sum = 0;
+  for (const uint64_t lat : lat_us) {
+    sum += lat;
+  }
+  const auto pct = [&](const double p) -> uint64_t {
+    const size_t idx = std::min(static_cast<size_t>(p * lat_us.size()), lat_us.size() - 1);
+    return lat_us[idx];
+  };
+
+  HCTR_LOG_S(INFO, WORLD) << name << ": ops = " << lat_us.size() << ", mean = " << std::fixed
+                          << std::setprecision(1) << (static_cast<double>(sum) / lat_us.size())
+                          << " us, p50 = " << pct(0.5) << " us, p90 = " << pct(0.9)
+                          << " us, p99 = " << pct(0.99) << " us, p99.9 = " << pct(0.999)
+                          << " us, max = " << lat_us.back() << " us, " << std::setprecision(3)
+                          << (static_cast<double>(bytes_per_op) * lat_us.size() / 1000.0 / sum)
+                          << " GB/s" << std::endl;
+
+  // Bucket b covers [2^b, 2^(b+1)) microseconds.
+  std::vector<size_t> buckets;
+  for (const uint64_t lat : lat_us) {
+    size_t b = 0;
+    while ((1ULL << (b + 1)) <= lat) {
+      ++b;
+    }
+    if (b >= buckets.size()) {
+      buckets.resize(b + 1, 0);
+    }
+    ++buckets[b];
+  }
+  for (size_t b = 0; b < buckets.size(); ++b) {
+    if (buckets[b]) {
+      HCTR_LOG_S(INFO, WORLD) << name << ": [" << (1ULL << b) << ", " << (1ULL << (b + 1))
+                              << ") us: " << buckets[b] << std::endl;
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   argparse::ArgumentParser args;
 
@@ -61,6 +139,11 @@ int main(int argc, char** argv) {
       .default_value(false)
       .implicit_value(true);
 
+  args.add_argument("--no_test_mixed")
+      .help("Disables concurrent mixed read/write test.")
+      .default_value(false)
+      .implicit_value(true);
+
   args.add_argument("--seed")
       .help("Seed for the random number generator.")
       .default_value<uint64_t>(4711)
@@ -148,6 +231,32 @@ int main(int argc, char** argv) {
       .default_value<size_t>(10)
       .scan<'u', size_t>();
 
+  args.add_argument("--query_alpha")
+      .help("Power-law skew for random key selection (0 = uniform; must not be 1).")
+      .default_value<float>(0.f)
+      .scan<'g', float>();
+
+  // Mixed read/write test parameters.
+  args.add_argument("--mixed_readers")
+      .help("Number of concurrent reader threads for the mixed test.")
+      .default_value<size_t>(4)
+      .scan<'u', size_t>();
+
+  args.add_argument("--mixed_writers")
+      .help("Number of concurrent writer threads for the mixed test.")
+      .default_value<size_t>(1)
+      .scan<'u', size_t>();
+
+  args.add_argument("--mixed_batch_size")
+      .help("Keys per fetch/insert batch in the mixed test.")
+      .default_value<size_t>(16384)
+      .scan<'u', size_t>();
+
+  args.add_argument("--mixed_ops")
+      .help("Batches each mixed test thread performs.")
+      .default_value<size_t>(256)
+      .scan<'u', size_t>();
+
   try {
     args.parse_args(argc, argv);
   } catch (const std::runtime_error& err) {
@@ -164,6 +273,7 @@ int main(int argc, char** argv) {
   const auto no_test_insert_evict = args.get<bool>("--no_test_insert_evict");
   const auto no_test_upsert = args.get<bool>("--no_test_upsert");
   const auto no_test_fetch = args.get<bool>("--no_test_fetch");
+  const auto no_test_mixed = args.get<bool>("--no_test_mixed");
   const auto seed = args.get<uint64_t>("--seed");
   // HM parameters.
   const auto hm_parts = args.get<size_t>("--hm_parts");
@@ -185,12 +295,20 @@ int main(int argc, char** argv) {
   const auto fill_burst = args.get<size_t>("--fill_burst");
   const auto query_amount = args.get<size_t>("--query_amount");
   const auto query_repeat = args.get<size_t>("--query_repeat");
+  const auto query_alpha = args.get<float>("--query_alpha");
+  // Mixed read/write test parameters.
+  const auto mixed_readers = args.get<size_t>("--mixed_readers");
+  const auto mixed_writers = args.get<size_t>("--mixed_writers");
+  // Writers reuse the shared fill values, so a batch cannot exceed the fill burst.
+  const auto mixed_batch_size = std::min(args.get<size_t>("--mixed_batch_size"), fill_burst);
+  const auto mixed_ops = args.get<size_t>("--mixed_ops");
 
   std::cout << "Options: " << std::endl
             << "  -----------------------------" << std::endl
             << "  no_test_insert_evict = " << no_test_insert_evict << std::endl
             << "  no_test_upsert       = " << no_test_upsert << std::endl
             << "  no_test_fetch        = " << no_test_fetch << std::endl
+            << "  no_test_mixed        = " << no_test_mixed << std::endl
             << "  seed                 = " << seed << std::endl
             << "  -----------------------------" << std::endl
             << "  broker = " << kafka_broker << std::endl
@@ -218,6 +336,12 @@ int main(int argc, char** argv) {
             << "  fill_burst   = " << fill_burst << std::endl
             << "  query_amount = " << query_amount << std::endl
             << "  query_repeat = " << query_repeat << std::endl
+            << "  query_alpha  = " << query_alpha << std::endl
+            << "  -----------------------------" << std::endl
+            << "  mixed_readers    = " << mixed_readers << std::endl
+            << "  mixed_writers    = " << mixed_writers << std::endl
+            << "  mixed_batch_size = " << mixed_batch_size << std::endl
+            << "  mixed_ops        = " << mixed_ops << std::endl
             << "  -----------------------------" << std::endl;
 
   const std::string tag_name = HierParameterServerBase::make_tag_name(model_name, table_name);
@@ -357,10 +481,10 @@ int main(int argc, char** argv) {
       }
 
       // Query.
-      std::uniform_int_distribution<size_t> key_dist(0, i - 1);
+      KeySampler key_sampler(i, query_alpha, gen());
       for (size_t k = 0; !no_test_fetch && k < query_repeat; ++k) {
         for (size_t j = 0; j < keys.size(); ++j) {
-          keys[j] = key_dist(gen);
+          keys[j] = key_sampler.next();
         }
 
         {
@@ -380,6 +504,77 @@ int main(int argc, char** argv) {
         }
       }
     }
+
+    // Concurrent mixed read/write test: dedicated reader and writer threads hammer the filled
+    // database with (optionally skewed) key batches, so lock contention and tail latencies show
+    // up the way they would behind a live inference server.
+    if (!no_test_mixed && (mixed_readers + mixed_writers) > 0 && fill_amount > 0) {
+      HCTR_LOG_S(INFO, WORLD) << "Running mixed read/write test (" << mixed_readers
+                              << " readers, " << mixed_writers << " writers)..." << std::endl;
+
+      std::vector<std::vector<uint64_t>> read_lat(mixed_readers);
+      std::vector<std::vector<uint64_t>> write_lat(mixed_writers);
+      std::vector<std::thread> threads;
+
+      for (size_t t = 0; t < mixed_readers; ++t) {
+        threads.emplace_back([&, t, thread_seed = gen()]() {
+          KeySampler sampler(fill_amount, query_alpha, thread_seed);
+          std::vector<Key> batch_keys(mixed_batch_size);
+          std::vector<float, AlignedAllocator<float>> batch_values(mixed_batch_size * emb_size);
+          std::vector<uint64_t>& lat = read_lat[t];
+          lat.reserve(mixed_ops);
+
+          for (size_t op = 0; op < mixed_ops; ++op) {
+            for (Key& key : batch_keys) {
+              key = sampler.next();
+            }
+            const auto t0 = std::chrono::high_resolution_clock::now();
+            db->fetch(tag_name, batch_keys.size(), batch_keys.data(),
+                      reinterpret_cast<char*>(batch_values.data()), emb_size * sizeof(float),
+                      [&](const size_t) {});
+            const auto t1 = std::chrono::high_resolution_clock::now();
+            lat.push_back(std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+          }
+        });
+      }
+
+      for (size_t t = 0; t < mixed_writers; ++t) {
+        threads.emplace_back([&, t, thread_seed = gen()]() {
+          KeySampler sampler(fill_amount, query_alpha, thread_seed);
+          std::vector<Key> batch_keys(mixed_batch_size);
+          std::vector<uint64_t>& lat = write_lat[t];
+          lat.reserve(mixed_ops);
+
+          for (size_t op = 0; op < mixed_ops; ++op) {
+            for (Key& key : batch_keys) {
+              key = sampler.next();
+            }
+            const auto t0 = std::chrono::high_resolution_clock::now();
+            db->insert(tag_name, batch_keys.size(), batch_keys.data(),
+                       reinterpret_cast<const char*>(in_values.data()), emb_size * sizeof(float),
+                       emb_size * sizeof(float));
+            const auto t1 = std::chrono::high_resolution_clock::now();
+            lat.push_back(std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+          }
+        });
+      }
+
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+
+      std::vector<uint64_t> all_read_lat;
+      for (const std::vector<uint64_t>& lat : read_lat) {
+        all_read_lat.insert(all_read_lat.end(), lat.begin(), lat.end());
+      }
+      std::vector<uint64_t> all_write_lat;
+      for (const std::vector<uint64_t>& lat : write_lat) {
+        all_write_lat.insert(all_write_lat.end(), lat.begin(), lat.end());
+      }
+
+      print_latency_report("mixed fetch", all_read_lat, kv_size * mixed_batch_size);
+      print_latency_report("mixed insert", all_write_lat, kv_size * mixed_batch_size);
+    }
   } catch (const DatabaseBackendError& error) {
     HCTR_LOG_S(ERROR, WORLD) << "Partition #" << error.partition() << ": " << error.what()
                              << std::endl;
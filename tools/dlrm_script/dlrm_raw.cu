@@ -25,7 +25,8 @@ auto dtype() {
 }
 
 void process_kaggle_dataset(const std::string &input_dir_path, const std::string &output_dir_path,
-                            const int num_numericals, const int num_categoricals) {
+                            const int num_numericals, const int num_categoricals,
+                            const bool float_dense, const bool write_parquet) {
   int max_chunk_per_file = 10000;  // loop count, in a single binary data, store how many chunks
 
   bool process_output = true;
@@ -267,10 +268,15 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 
     if (process_output) {
       std::ofstream *binary_writer = nullptr;
-
-      if (write_out)
-        binary_writer =
-            new std::ofstream(std::string(output_dir_path + "/train_data.bin"), std::ios::binary);
+      ParquetChunkWriter *parquet_writer = nullptr;
+
+      if (write_out) {
+        if (write_parquet)
+          parquet_writer = new ParquetChunkWriter(output_dir_path + "/train", float_dense);
+        else
+          binary_writer =
+              new std::ofstream(std::string(output_dir_path + "/train_data.bin"), std::ios::binary);
+      }
       size_t sz_total_output_binary = 0;
 
       const auto time_convert_start = std::chrono::high_resolution_clock::now();
@@ -284,14 +290,19 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
             false, dev_int_col_ptrs, dev_int_col_nullmask_ptrs, dev_cat_col_nullmask_ptrs,
             dev_categorical_col_hash_obj, dev_char_ptrs, dev_offset_ptrs, dev_out_buffer,
             host_out_buffer, binary_writer, dev_slot_size_array, rows_begin_train, rows_end_train,
-            3);
+            3, float_dense, parquet_writer);
 
-        HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for /train_data.bin"
+        HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for the train split"
                                << std::endl;
-        HCTR_LOG_S(INFO, ROOT) << "Size of train_data.bin: " << sz_total_output_binary << " Bytes."
+        HCTR_LOG_S(INFO, ROOT) << "Size of the train split: " << sz_total_output_binary << " Bytes."
                                << std::endl;
 
         if (binary_writer) binary_writer->close();
+        if (parquet_writer) {
+          parquet_writer->finalize();
+          delete parquet_writer;
+          parquet_writer = nullptr;
+        }
       }
 
       // validation-data and testing-data
@@ -304,41 +315,61 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 
         // val
         std::ofstream *binary_writer_val = nullptr;
-        if (write_out)
-          binary_writer_val =
-              new std::ofstream(std::string(output_dir_path + "/val_data.bin"), std::ios::binary);
+        ParquetChunkWriter *parquet_writer_val = nullptr;
+        if (write_out) {
+          if (write_parquet)
+            parquet_writer_val = new ParquetChunkWriter(output_dir_path + "/val", float_dense);
+          else
+            binary_writer_val =
+                new std::ofstream(std::string(output_dir_path + "/val_data.bin"), std::ios::binary);
+        }
 
         sz_total_output_binary = convert_input_binaries<key_type, value_type>(
             p_mr, input_file_path, column_dtypes, column_names, hash_bucket, max_chunk_per_file, 0,
             false, dev_int_col_ptrs, dev_int_col_nullmask_ptrs, dev_cat_col_nullmask_ptrs,
             dev_categorical_col_hash_obj, dev_char_ptrs, dev_offset_ptrs, dev_out_buffer,
             host_out_buffer, binary_writer_val, dev_slot_size_array, rows_begin_val, rows_end_val,
-            3);
+            3, float_dense, parquet_writer_val);
 
-        HCTR_LOG_S(INFO, ROOT) << "Size of val_data.bin: " << sz_total_output_binary << " Bytes."
+        HCTR_LOG_S(INFO, ROOT) << "Size of the val split: " << sz_total_output_binary << " Bytes."
                                << std::endl;
 
         if (binary_writer_val) binary_writer_val->close();
+        if (parquet_writer_val) {
+          parquet_writer_val->finalize();
+          delete parquet_writer_val;
+          parquet_writer_val = nullptr;
+        }
 
         // test
         std::ofstream *binary_writer_test = nullptr;
-        if (write_out)
-          binary_writer_test =
-              new std::ofstream(std::string(output_dir_path + "/test_data.bin"), std::ios::binary);
+        ParquetChunkWriter *parquet_writer_test = nullptr;
+        if (write_out) {
+          if (write_parquet)
+            parquet_writer_test = new ParquetChunkWriter(output_dir_path + "/test", float_dense);
+          else
+            binary_writer_test = new std::ofstream(
+                std::string(output_dir_path + "/test_data.bin"), std::ios::binary);
+        }
 
         sz_total_output_binary = convert_input_binaries<key_type, value_type>(
             p_mr, input_file_path, column_dtypes, column_names, hash_bucket, max_chunk_per_file, 0,
             false, dev_int_col_ptrs, dev_int_col_nullmask_ptrs, dev_cat_col_nullmask_ptrs,
             dev_categorical_col_hash_obj, dev_char_ptrs, dev_offset_ptrs, dev_out_buffer,
             host_out_buffer, binary_writer_test, dev_slot_size_array, rows_begin_test,
-            rows_end_test, 3);
+            rows_end_test, 3, float_dense, parquet_writer_test);
 
-        HCTR_LOG_S(INFO, ROOT) << "Size of test_data.bin: " << sz_total_output_binary << " Bytes."
+        HCTR_LOG_S(INFO, ROOT) << "Size of the test split: " << sz_total_output_binary << " Bytes."
                                << std::endl;
 
         if (binary_writer_test) binary_writer_test->close();
+        if (parquet_writer_test) {
+          parquet_writer_test->finalize();
+          delete parquet_writer_test;
+          parquet_writer_test = nullptr;
+        }
         HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path
-                               << " for val_data.bin and test_data.bin" << std::endl;
+                               << " for the val and test splits" << std::endl;
       }
 
       const auto time_convert_stop = std::chrono::high_resolution_clock::now();
@@ -393,7 +424,8 @@ void process_kaggle_dataset(const std::string &input_dir_path, const std::string
 void process_terabyte_dataset(const std::string &input_dir_path, const std::string &output_dir_path,
                               const int num_numericals, const int num_categoricals,
                               const std::vector<std::string> &train_days,
-                              const std::vector<std::string> &test_days) {
+                              const std::vector<std::string> &test_days, const bool float_dense,
+                              const bool write_parquet) {
   int max_chunk_per_file = 10000;  // loop count, in a single binary data, store how many chunks
 
   bool process_output = true;
@@ -639,9 +671,14 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
       const auto time_convert_start = std::chrono::high_resolution_clock::now();
 
       std::ofstream *binary_writer = nullptr;
-      if (write_out)
-        binary_writer =
-            new std::ofstream(std::string(output_dir_path + "/train_data.bin"), std::ios::binary);
+      ParquetChunkWriter *parquet_writer = nullptr;
+      if (write_out) {
+        if (write_parquet)
+          parquet_writer = new ParquetChunkWriter(output_dir_path + "/train", float_dense);
+        else
+          binary_writer =
+              new std::ofstream(std::string(output_dir_path + "/train_data.bin"), std::ios::binary);
+      }
       size_t sz_total_output_binary = 0;
 
       // train_data.bin
@@ -658,9 +695,9 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
             false, dev_int_col_ptrs, dev_int_col_nullmask_ptrs, dev_cat_col_nullmask_ptrs,
             dev_categorical_col_hash_obj, dev_char_ptrs, dev_offset_ptrs, dev_out_buffer,
             host_out_buffer, binary_writer, dev_slot_size_array, rows_begin_train, rows_end_train,
-            1);
+            1, float_dense, parquet_writer);
 
-        HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for /train_data.bin"
+        HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for the train split"
                                << std::endl;
 
         if (needed_samples_num < sample_nums[i]) {
@@ -671,17 +708,27 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
         }
 
       }  // end for train_days
-      HCTR_LOG_S(INFO, ROOT) << "Size of train_data.bin: " << sz_total_output_binary << " Bytes."
+      HCTR_LOG_S(INFO, ROOT) << "Size of the train split: " << sz_total_output_binary << " Bytes."
                              << std::endl;
       if (binary_writer) binary_writer->close();
+      if (parquet_writer) {
+        parquet_writer->finalize();
+        delete parquet_writer;
+        parquet_writer = nullptr;
+      }
 
       // testing-data
       {
         // test_data.bin
         std::ofstream *binary_writer_test = nullptr;
-        if (write_out)
-          binary_writer_test =
-              new std::ofstream(std::string(output_dir_path + "/test_data.bin"), std::ios::binary);
+        ParquetChunkWriter *parquet_writer_test = nullptr;
+        if (write_out) {
+          if (write_parquet)
+            parquet_writer_test = new ParquetChunkWriter(output_dir_path + "/test", float_dense);
+          else
+            binary_writer_test = new std::ofstream(
+                std::string(output_dir_path + "/test_data.bin"), std::ios::binary);
+        }
 
         sz_total_output_binary = 0;
         size_t saved_samples_num = 0;
@@ -700,9 +747,9 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
               0, false, dev_int_col_ptrs, dev_int_col_nullmask_ptrs, dev_cat_col_nullmask_ptrs,
               dev_categorical_col_hash_obj, dev_char_ptrs, dev_offset_ptrs, dev_out_buffer,
               host_out_buffer, binary_writer_test, dev_slot_size_array, rows_begin_test,
-              rows_end_test, 1);
+              rows_end_test, 1, float_dense, parquet_writer_test);
 
-          HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for /test_data.bin"
+          HCTR_LOG_S(INFO, ROOT) << "Processed file: " << input_file_path << " for the test split"
                                  << std::endl;
 
           if (needed_samples_num < sample_nums[train_days.size() + i]) {
@@ -714,10 +761,15 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
 
         }  // end for test_days
 
-        HCTR_LOG_S(INFO, ROOT) << "Size of test_data.bin: " << sz_total_output_binary << " Bytes."
+        HCTR_LOG_S(INFO, ROOT) << "Size of the test split: " << sz_total_output_binary << " Bytes."
                                << std::endl;
 
         if (binary_writer_test) binary_writer_test->close();
+        if (parquet_writer_test) {
+          parquet_writer_test->finalize();
+          delete parquet_writer_test;
+          parquet_writer_test = nullptr;
+        }
       }
 
       const auto time_convert_stop = std::chrono::high_resolution_clock::now();
@@ -770,35 +822,56 @@ void process_terabyte_dataset(const std::string &input_dir_path, const std::stri
 }
 
 int main(const int argc, const char *argv[]) {
-  if (argc < 3) {
+  // optional flags, accepted anywhere on the command line:
+  //   --float_dense  write float32 label/dense (log(x + 1) normalized) instead of int32
+  //   --parquet      write parquet files plus _metadata.json/_file_list.txt per split
+  //                  instead of the raw binaries
+  bool float_dense = false;
+  bool write_parquet = false;
+  std::vector<const char *> pos_args{argv[0]};
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--float_dense") == 0) {
+      float_dense = true;
+    } else if (std::strcmp(argv[i], "--parquet") == 0) {
+      write_parquet = true;
+    } else {
+      pos_args.push_back(argv[i]);
+    }
+  }
+  const int num_args = static_cast<int>(pos_args.size());
+
+  if (num_args < 3) {
     HCTR_LOG(INFO, ROOT, "Need min 2 args: input_dir output_dir\n");
-    HCTR_LOG(INFO, ROOT, "Usage for Kaggle Datasets: ./dlrm_raw input_dir output_dir\n");
+    HCTR_LOG(INFO, ROOT,
+             "Usage for Kaggle Datasets: ./dlrm_raw input_dir output_dir [--float_dense] "
+             "[--parquet]\n");
     HCTR_LOG(
         INFO, ROOT,
         "Usage for TeraBytes Datasets: ./dlrm_raw input_dir output_dir --train [days for training] "
-        "--test [days for testing], those days are separated with comma, no whitespace.\n");
+        "--test [days for testing] [--float_dense] [--parquet], those days are separated with "
+        "comma, no whitespace.\n");
     return -1;
   }
 
   const int num_numericals = 14;    // label + 13 int-dense-feature
   const int num_categoricals = 26;  // 26 int-categorical-feature
 
-  std::string input_dir_path(argv[1]);
-  std::string output_dir_path(argv[2]);
+  std::string input_dir_path(pos_args[1]);
+  std::string output_dir_path(pos_args[2]);
 
-  switch (argc) {
+  switch (num_args) {
     case 3: {
       HCTR_LOG_S(INFO, ROOT) << "Processing Kaggle datasets" << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "input_dir: " << input_dir_path << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "output_dir: " << output_dir_path << std::endl;
 
-      process_kaggle_dataset(input_dir_path, output_dir_path, num_numericals, num_categoricals);
+      process_kaggle_dataset(input_dir_path, output_dir_path, num_numericals, num_categoricals,
+                             float_dense, write_parquet);
       break;
     }
 
     case 7: {
-      if (argc == 7 &&
-          (std::strcmp(argv[3], "--train") != 0 || std::strcmp(argv[5], "--test") != 0)) {
+      if (std::strcmp(pos_args[3], "--train") != 0 || std::strcmp(pos_args[5], "--test") != 0) {
         HCTR_LOG(INFO, ROOT,
                  "Usage for TeraBytes Datasets: ./dlrm_raw input_dir output_dir --train [days for "
                  "training] "
@@ -808,17 +881,17 @@ int main(const int argc, const char *argv[]) {
         return -1;
       }
 
-      const std::vector<std::string> train_days = split_string(std::string(argv[4]), ",");
-      const std::vector<std::string> test_days = split_string(std::string(argv[6]), ",");
+      const std::vector<std::string> train_days = split_string(std::string(pos_args[4]), ",");
+      const std::vector<std::string> test_days = split_string(std::string(pos_args[6]), ",");
 
       HCTR_LOG_S(INFO, ROOT) << "Processing TeraBytes datasets." << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "input_dir: " << input_dir_path << std::endl;
       HCTR_LOG_S(INFO, ROOT) << "output_dir: " << output_dir_path << std::endl;
-      HCTR_LOG_S(INFO, ROOT) << "days for training: " << argv[4] << std::endl;
-      HCTR_LOG_S(INFO, ROOT) << "days for testing: " << argv[6] << std::endl;
+      HCTR_LOG_S(INFO, ROOT) << "days for training: " << pos_args[4] << std::endl;
+      HCTR_LOG_S(INFO, ROOT) << "days for testing: " << pos_args[6] << std::endl;
 
       process_terabyte_dataset(input_dir_path, output_dir_path, num_numericals, num_categoricals,
-                               train_days, test_days);
+                               train_days, test_days, float_dense, write_parquet);
       break;
     }
 
@@ -27,15 +27,20 @@
 #include <cudf/column/column.hpp>
 #include <cudf/column/column_view.hpp>
 #include <cudf/io/csv.hpp>
+#include <cudf/io/parquet.hpp>
 #include <cudf/strings/strings_column_view.hpp>
 #include <cudf/table/table.hpp>
 #include <cudf/table/table_view.hpp>
 #include <cudf/types.hpp>
+#include <filesystem>
 #include <fstream>
+#include <memory>
 #include <hash/concurrent_unordered_map.cuh>
 #include <iostream>
 #include <numeric>
 #include <regex>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
 #include <rmm/mr/device/cuda_memory_resource.hpp>
 #include <rmm/mr/device/device_memory_resource.hpp>
 #include <rmm/mr/device/per_device_resource.hpp>
@@ -492,6 +497,148 @@ __global__ void data_preprocess(int32_t *dev_out_buffer, int32_t rows_num,
   }
 }
 
+// Rewrites the label and dense lanes of the processed rows in place as float32
+// (same 4-byte lanes, so the writer paths are unchanged): label -> float(label),
+// dense -> log(x + 1). This fuses the log-normalization the python scripts used
+// to do in a separate pass, and emits the float_label_dense layout the readers
+// consume directly.
+__global__ void fused_log_normalize(int32_t *dev_out_buffer, int32_t rows_num) {
+  int gid = blockDim.x * blockIdx.x + threadIdx.x;
+  if (gid < (rows_num * 40)) {  // num_numericals + num_categoricals = 40
+    int col = gid % 40;
+    if (col < 14) {  // label and dense features
+      float *float_out = reinterpret_cast<float *>(dev_out_buffer);
+      int32_t value = dev_out_buffer[gid];
+      if (0 == col) {  // label
+        float_out[gid] = static_cast<float>(value);
+      } else {  // dense features, already shifted by dense_bias
+        float_out[gid] = logf(static_cast<float>(value < 0 ? 0 : value) + 1.f);
+      }
+    }
+  }
+}
+
+// Scatters the sample-interleaved output rows into per-column device buffers so
+// a processed chunk can be handed to the cudf parquet writer without a host pass.
+__global__ void split_rows_to_columns(const int32_t *dev_rows, int32_t rows_num,
+                                      int64_t *dev_col_ptrs) {
+  int gid = blockDim.x * blockIdx.x + threadIdx.x;
+  if (gid < (rows_num * 40)) {
+    int row = gid / 40;
+    int col = gid % 40;
+    reinterpret_cast<int32_t *>(dev_col_ptrs[col])[row] = dev_rows[gid];
+  }
+}
+
+// Streams processed chunks out as one parquet file each, then emits the
+// _metadata.json and _file_list.txt the HugeCTR parquet readers expect next to
+// the written files.
+class ParquetChunkWriter {
+ public:
+  ParquetChunkWriter(const std::string &output_dir, bool float_label_dense)
+      : output_dir_(output_dir), float_label_dense_(float_label_dense) {
+    std::filesystem::create_directories(output_dir_);
+  }
+
+  ///@param dev_rows, processed rows in the sample-interleaved layout,
+  /// 40 int32-wide lanes per sample (label + 13 dense + 26 categoricals).
+  void write_chunk(const int32_t *dev_rows, int32_t num_rows) {
+    const int num_columns = 40;  // num_numericals + num_categoricals
+
+    std::vector<rmm::device_buffer> col_data;
+    std::vector<int64_t> col_ptrs;
+    col_data.reserve(num_columns);
+    for (int k = 0; k < num_columns; k++) {
+      col_data.emplace_back(num_rows * sizeof(int32_t), rmm::cuda_stream_default);
+      col_ptrs.push_back(reinterpret_cast<int64_t>(col_data.back().data()));
+    }
+
+    int64_t *dev_col_ptrs = nullptr;
+    size_t sz_col_ptrs = num_columns * sizeof(int64_t);
+    HCTR_LIB_THROW(cudaMalloc(&dev_col_ptrs, sz_col_ptrs));
+    HCTR_LIB_THROW(cudaMemcpy(dev_col_ptrs, col_ptrs.data(), sz_col_ptrs, cudaMemcpyHostToDevice));
+
+    int block = 32;
+    int grid = (num_rows * num_columns + block - 1) / block;
+    split_rows_to_columns<<<grid, block>>>(dev_rows, num_rows, dev_col_ptrs);
+    HCTR_LIB_THROW(cudaDeviceSynchronize());
+    HCTR_LIB_THROW(cudaFree(dev_col_ptrs));
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    for (int k = 0; k < num_columns; k++) {
+      cudf::data_type dtype = (float_label_dense_ && k < 14)
+                                  ? cudf::data_type{cudf::type_id::FLOAT32}
+                                  : cudf::data_type{cudf::type_id::INT32};
+      columns.push_back(std::make_unique<cudf::column>(dtype, num_rows, std::move(col_data[k]),
+                                                       rmm::device_buffer{}, 0));
+    }
+    cudf::table chunk_table(std::move(columns));
+
+    cudf_io::table_input_metadata tbl_meta(chunk_table.view());
+    for (int k = 0; k < num_columns; k++) {
+      tbl_meta.column_metadata[k].set_name(column_name(k));
+    }
+
+    std::string file_name = "part_" + std::to_string(file_stats_.size()) + ".parquet";
+    auto out_opts = cudf_io::parquet_writer_options::builder(
+                        cudf_io::sink_info{output_dir_ + "/" + file_name}, chunk_table.view())
+                        .metadata(std::move(tbl_meta))
+                        .build();
+    cudf_io::write_parquet(out_opts);
+
+    file_stats_.emplace_back(file_name, num_rows);
+  }
+
+  // write _metadata.json and _file_list.txt once all chunks of a split are out
+  void finalize() {
+    size_t total_rows = 0;
+
+    std::ofstream meta_writer(output_dir_ + "/_metadata.json");
+    meta_writer << "{\"file_stats\": [";
+    for (size_t i = 0; i < file_stats_.size(); i++) {
+      if (i > 0) meta_writer << ", ";
+      meta_writer << "{\"file_name\": \"" << file_stats_[i].first
+                  << "\", \"num_rows\": " << file_stats_[i].second << "}";
+      total_rows += file_stats_[i].second;
+    }
+    meta_writer << "], ";
+    meta_writer << "\"labels\": [{\"col_name\": \"label\", \"index\": 0}], ";
+    meta_writer << "\"conts\": [";
+    for (int k = 1; k < 14; k++) {
+      if (k > 1) meta_writer << ", ";
+      meta_writer << "{\"col_name\": \"" << column_name(k) << "\", \"index\": " << k << "}";
+    }
+    meta_writer << "], \"cats\": [";
+    for (int k = 14; k < 40; k++) {
+      if (k > 14) meta_writer << ", ";
+      meta_writer << "{\"col_name\": \"" << column_name(k) << "\", \"index\": " << k << "}";
+    }
+    meta_writer << "]}" << std::endl;
+    meta_writer.close();
+
+    std::ofstream file_list_writer(output_dir_ + "/_file_list.txt");
+    file_list_writer << file_stats_.size() << std::endl;
+    for (const auto &stat : file_stats_) {
+      file_list_writer << output_dir_ + "/" + stat.first << std::endl;
+    }
+    file_list_writer.close();
+
+    HCTR_LOG_S(INFO, ROOT) << "Wrote " << file_stats_.size() << " parquet files, " << total_rows
+                           << " rows, to " << output_dir_ << std::endl;
+  }
+
+ private:
+  static std::string column_name(int col) {
+    if (0 == col) return "label";
+    if (col < 14) return "I" + std::to_string(col);
+    return "C" + std::to_string(col - 13);
+  }
+
+  std::string output_dir_;
+  bool float_label_dense_;
+  std::vector<std::pair<std::string, size_t>> file_stats_;  // <file_name, num_rows>
+};
+
 ///@param save_rows_begin, Rows begin to save from source, -1 means the very beginning
 ///@param save_rows_end, Rows end to save from source, -1 means till the file ending.
 template <typename key, typename value>
@@ -505,7 +652,9 @@ size_t convert_input_binaries(rmm::mr::device_memory_resource *mr, std::string i
                               int64_t *dev_offset_ptrs, int32_t *dev_out_buffer,
                               int32_t *host_out_buffer, std::ofstream *binary_writer,
                               uint32_t *dev_slot_size_array, int32_t save_rows_begin = -1,
-                              int32_t save_rows_end = -1, int32_t dense_bias = 0) {
+                              int32_t save_rows_end = -1, int32_t dense_bias = 0,
+                              bool float_dense_out = false,
+                              ParquetChunkWriter *parquet_writer = nullptr) {
   const int num_numericals = 14;
   const int num_categoricals = 26;
 
@@ -613,10 +762,17 @@ size_t convert_input_binaries(rmm::mr::device_memory_resource *mr, std::string i
       HCTR_LIB_THROW(cudaDeviceSynchronize());
     }
 
+    if (float_dense_out) {
+      int block = 32;
+      int grid = (num_rows * (num_numericals + num_categoricals) + block - 1) / block;
+      fused_log_normalize<<<grid, block>>>(dev_out_buffer, num_rows);
+      HCTR_LIB_THROW(cudaDeviceSynchronize());
+    }
+
     HCTR_LIB_THROW(
         cudaMemcpy(host_out_buffer, dev_out_buffer, size_of_output_binary, cudaMemcpyDeviceToHost));
 
-    if (binary_writer) {
+    if (binary_writer || parquet_writer) {
       Index indices = write_indices(save_rows_begin, save_rows_end, read_row_nums, num_rows);
       if (-1 != indices.begin_idx && -1 != indices.end_idx) {
         int32_t offset_rows = indices.begin_idx - (read_row_nums - num_rows);
@@ -631,7 +787,13 @@ size_t convert_input_binaries(rmm::mr::device_memory_resource *mr, std::string i
         }
 
         size_of_output_binary = write_rows * (num_numericals + num_categoricals) * sizeof(int32_t);
-        binary_writer->write((const char *)(host_out_buffer + offset_elems), size_of_output_binary);
+        if (binary_writer) {
+          binary_writer->write((const char *)(host_out_buffer + offset_elems),
+                               size_of_output_binary);
+        }
+        if (parquet_writer) {
+          parquet_writer->write_chunk(dev_out_buffer + offset_elems, write_rows);
+        }
 
         process_write_bytes += size_of_output_binary;
         sz_total_output_binary += size_of_output_binary;
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <argparse/argparse.hpp>
+#include <core23/logger.hpp>
+#include <fstream>
+#include <io/filesystem.hpp>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace HugeCTR;
+
+/**
+ * Offline pruning/compaction of a trained sparse model file (key + emb_vector
+ * pair, the format the HPS RawModelLoader consumes) driven by a key-frequency
+ * snapshot written during training (lines of table_id/key/count, sorted by
+ * count; see the data-distributor sketch dump and the embedding-cache warm-up
+ * which share the format).
+ *
+ * The output model holds only the keys the snapshot proves alive (count >=
+ * --min_count), ordered hottest-first. The frequency-sorted layout alone
+ * improves HashMapBackend locality, because the keys fetched together are the
+ * ones allocated together; pruning on top of it shrinks the file by whatever
+ * fraction of the vocabulary never occurs in serving traffic. --keep_unlisted
+ * turns pruning off and merely reorders: keys absent from the snapshot are
+ * appended after the sorted ones in their original order.
+ */
+
+namespace {
+
+// Chunk sizes for the streamed file walks; the tool never holds the vector
+// file in memory, so 130 GB checkpoints compact within a few GB of host RAM.
+constexpr size_t key_scan_chunk = 8L * 1024 * 1024;   // keys per read
+constexpr size_t vec_copy_chunk = 32L * 1024 * 1024;  // bytes per append
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  argparse::ArgumentParser args;
+
+  args.add_argument("--model")
+      .help("Path of the sparse model folder (containing `key` and `emb_vector`).")
+      .required();
+  args.add_argument("--freq")
+      .help("Path of the key-frequency snapshot (lines of table_id/key/count, sorted by count).")
+      .required();
+  args.add_argument("--output").help("Path of the folder to write the compacted model.").required();
+  args.add_argument("--table_id")
+      .help("Table id to select from the frequency snapshot.")
+      .default_value<size_t>(0)
+      .scan<'u', size_t>();
+  args.add_argument("--min_count")
+      .help("Keys observed fewer times than this are pruned.")
+      .default_value<size_t>(1)
+      .scan<'u', size_t>();
+  args.add_argument("--keep_unlisted")
+      .help("Do not prune: append keys absent from the snapshot after the frequency-sorted ones.")
+      .default_value(false)
+      .implicit_value(true);
+
+  try {
+    args.parse_args(argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    std::cout << args;
+    return 1;
+  }
+
+  const auto model_path = args.get<std::string>("--model");
+  const auto freq_path = args.get<std::string>("--freq");
+  const auto output_path = args.get<std::string>("--output");
+  const auto table_id = args.get<size_t>("--table_id");
+  const auto min_count = args.get<size_t>("--min_count");
+  const auto keep_unlisted = args.get<bool>("--keep_unlisted");
+
+  const std::string key_file = model_path + "/key";
+  const std::string vec_file = model_path + "/emb_vector";
+  const std::string out_key_file = output_path + "/key";
+  const std::string out_vec_file = output_path + "/emb_vector";
+
+  auto fs = FileSystemBuilder::build_unique_by_path(model_path);
+  const size_t key_file_size = fs->get_file_size(key_file);
+  const size_t vec_file_size = fs->get_file_size(vec_file);
+  HCTR_CHECK_HINT(key_file_size > 0 && key_file_size % sizeof(long long) == 0,
+                  "Embedding key file is empty or has a bogus size");
+  const size_t num_key = key_file_size / sizeof(long long);
+  HCTR_CHECK_HINT(vec_file_size % (num_key * sizeof(float)) == 0,
+                  "Embedding vector file size is not a multiple of the key count");
+  const size_t emb_size = vec_file_size / (num_key * sizeof(float));
+  const size_t vec_bytes = emb_size * sizeof(float);
+  HCTR_LOG(INFO, ROOT, "Input model: %zu keys, embedding size %zu (%.2f GB)\n", num_key, emb_size,
+           vec_file_size / (1024.0 * 1024.0 * 1024.0));
+
+  // Walk the key file once and remember where each key's vector lives.
+  // Duplicate keys keep their first occurrence, like the HPS loader.
+  std::unordered_map<long long, size_t> key_to_position;
+  key_to_position.reserve(num_key);
+  {
+    std::vector<long long> key_chunk(std::min(key_scan_chunk, num_key));
+    for (size_t offset = 0; offset < num_key; offset += key_scan_chunk) {
+      const size_t chunk_length = std::min(key_scan_chunk, num_key - offset);
+      fs->read(key_file, key_chunk.data(), chunk_length * sizeof(long long),
+               offset * sizeof(long long));
+      for (size_t i = 0; i < chunk_length; i++) {
+        key_to_position.emplace(key_chunk[i], offset + i);
+      }
+    }
+  }
+
+  // Select the surviving keys in snapshot (i.e. frequency) order.
+  std::vector<std::pair<long long, size_t>> kept;  // key, source position
+  std::vector<char> taken(num_key, 0);
+  size_t listed_keys = 0;
+  size_t pruned_by_count = 0;
+  {
+    std::ifstream freq_stream(freq_path);
+    HCTR_CHECK_HINT(freq_stream.is_open(), "Cannot open the key-frequency snapshot");
+    std::string line;
+    while (std::getline(freq_stream, line)) {
+      std::istringstream entry(line);
+      size_t entry_table_id;
+      long long key;
+      unsigned long long count;
+      if (!(entry >> entry_table_id >> key >> count) || entry_table_id != table_id) {
+        continue;
+      }
+      listed_keys++;
+      if (count < min_count) {
+        pruned_by_count++;
+        continue;
+      }
+      const auto it = key_to_position.find(key);
+      if (it == key_to_position.end() || taken[it->second]) {
+        continue;  // not part of this checkpoint, or listed twice
+      }
+      taken[it->second] = 1;
+      kept.emplace_back(key, it->second);
+    }
+  }
+  HCTR_LOG(INFO, ROOT, "Snapshot: %zu keys of table %zu, %zu below min_count, %zu matched\n",
+           listed_keys, table_id, pruned_by_count, kept.size());
+
+  if (keep_unlisted) {
+    // Reorder-only mode: the cold tail follows the hot head in file order.
+    std::vector<long long> position_to_key(num_key);
+    for (const auto& entry : key_to_position) {
+      position_to_key[entry.second] = entry.first;
+    }
+    for (size_t pos = 0; pos < num_key; pos++) {
+      if (!taken[pos]) {
+        kept.emplace_back(position_to_key[pos], pos);
+      }
+    }
+  }
+  HCTR_CHECK_HINT(!kept.empty(), "No key survives the compaction; refusing to write an empty model");
+
+  auto out_fs = FileSystemBuilder::build_unique_by_path(output_path);
+  out_fs->create_dir(output_path);
+
+  // Keys in one shot (8 bytes each), vectors streamed in appended chunks.
+  {
+    std::vector<long long> out_keys(kept.size());
+    for (size_t i = 0; i < kept.size(); i++) {
+      out_keys[i] = kept[i].first;
+    }
+    out_fs->write(out_key_file, out_keys.data(), out_keys.size() * sizeof(long long), true);
+  }
+  {
+    std::vector<char> vec_buffer;
+    vec_buffer.reserve(vec_copy_chunk + vec_bytes);
+    bool first_write = true;
+    for (const auto& entry : kept) {
+      const size_t buffered = vec_buffer.size();
+      vec_buffer.resize(buffered + vec_bytes);
+      fs->read(vec_file, vec_buffer.data() + buffered, vec_bytes, entry.second * vec_bytes);
+      if (vec_buffer.size() >= vec_copy_chunk) {
+        out_fs->write(out_vec_file, vec_buffer.data(), vec_buffer.size(), first_write);
+        first_write = false;
+        vec_buffer.clear();
+      }
+    }
+    if (!vec_buffer.empty()) {
+      out_fs->write(out_vec_file, vec_buffer.data(), vec_buffer.size(), first_write);
+    }
+  }
+
+  HCTR_LOG(INFO, ROOT, "Wrote %zu of %zu keys (%.2f GB -> %.2f GB) to %s\n", kept.size(), num_key,
+           vec_file_size / (1024.0 * 1024.0 * 1024.0),
+           kept.size() * vec_bytes / (1024.0 * 1024.0 * 1024.0), output_path.c_str());
+  return 0;
+}
@@ -0,0 +1,237 @@
+"""
+ Copyright (c) 2023, NVIDIA CORPORATION.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+"""
+
+import argparse
+import json
+import math
+import sys
+
+# Extra optimizer state copies per weight element, mirroring
+# OptParams::num_parameters_per_weight in HugeCTR/include/optimizer.hpp.
+OPTIMIZER_STATE_COPIES = {
+    "sgd": 0,
+    "momentumsgd": 1,
+    "nesterov": 1,
+    "adagrad": 1,
+    "rmsprop": 1,
+    "adam": 2,
+    "ftrl": 2,
+}
+
+
+class Table:
+    def __init__(self, spec, index):
+        self.name = spec.get("name", "table{}".format(index))
+        self.index = index
+        self.vocabulary_size = int(spec["vocabulary_size"])
+        self.ev_size = int(spec["ev_size"])
+        self.hotness = int(spec.get("hotness", 1))
+
+    def storage_bytes(self, opt_state_copies):
+        # Embedding weights are fp32 regardless of mixed precision; optimizer states add
+        # opt_state_copies further fp32 copies (embedding_storage sizing rules).
+        return self.vocabulary_size * self.ev_size * 4 * (1 + opt_state_copies)
+
+
+class Plan:
+    """Placement of every table plus the derived per-GPU memory and traffic model."""
+
+    def __init__(self, config):
+        self.num_gpus = int(config["num_gpus"])
+        self.batch_size_per_gpu = int(config["batch_size_per_gpu"])
+        self.batch_size = self.batch_size_per_gpu * self.num_gpus
+        optimizer = config.get("optimizer", "sgd").lower()
+        if optimizer not in OPTIMIZER_STATE_COPIES:
+            sys.exit("Unknown optimizer: {}".format(optimizer))
+        self.optimizer = optimizer
+        self.opt_state_copies = OPTIMIZER_STATE_COPIES[optimizer]
+        self.emb_output_bytes = 2 if config.get("mixed_precision", False) else 4
+        self.hbm_bytes_per_gpu = float(config.get("hbm_gb", 80.0)) * 1024**3
+        # Budget fraction reserved for the dense network, data reader, NCCL, CUDA context etc.
+        self.embedding_budget_fraction = float(config.get("embedding_budget_fraction", 0.7))
+        self.dp_threshold_bytes = float(config.get("dp_threshold_mb", 16.0)) * 1024**2
+        self.tables = [Table(spec, i) for i, spec in enumerate(config["tables"])]
+
+        self.dp_tables = []
+        # shards[gpu] = list of (table, row_fraction); row_fraction < 1 means row-wise sharding.
+        self.shards = [[] for _ in range(self.num_gpus)]
+        self._place()
+
+    def _place(self):
+        budget = self.hbm_bytes_per_gpu * self.embedding_budget_fraction
+        mp_tables = []
+        for table in self.tables:
+            if table.storage_bytes(self.opt_state_copies) <= self.dp_threshold_bytes:
+                self.dp_tables.append(table)
+            else:
+                mp_tables.append(table)
+
+        # Greedy longest-processing-time placement: biggest tables first, each onto the GPU
+        # with the smallest load so far. Tables too big for a single GPU's remaining budget
+        # are sharded row-wise across all GPUs instead.
+        mp_tables.sort(key=lambda t: t.storage_bytes(self.opt_state_copies), reverse=True)
+        load = [0.0] * self.num_gpus
+        for table in mp_tables:
+            size = table.storage_bytes(self.opt_state_copies)
+            target = min(range(self.num_gpus), key=lambda g: load[g])
+            if load[target] + size > budget and self.num_gpus > 1:
+                fraction = 1.0 / self.num_gpus
+                for gpu in range(self.num_gpus):
+                    self.shards[gpu].append((table, fraction))
+                    load[gpu] += size * fraction
+            else:
+                self.shards[target].append((table, 1.0))
+                load[target] += size
+
+    # ---- per-GPU memory model -------------------------------------------------------------
+
+    def table_bytes(self, gpu):
+        total = sum(t.storage_bytes(self.opt_state_copies) * frac for t, frac in self.shards[gpu])
+        total += sum(t.storage_bytes(self.opt_state_copies) for t in self.dp_tables)
+        return total
+
+    def wgrad_bytes(self, gpu):
+        # Local reduce produces at most min(batch * hotness, local rows) unique gradients per
+        # table per iteration (Wgrad sizing in embedding/common.hpp).
+        total = 0.0
+        for table, frac in self.shards[gpu]:
+            rows = min(self.batch_size * table.hotness, table.vocabulary_size * frac)
+            total += rows * table.ev_size * 4
+        for table in self.dp_tables:
+            rows = min(self.batch_size_per_gpu * table.hotness, table.vocabulary_size)
+            total += rows * table.ev_size * 4
+        return total
+
+    def workspace_bytes(self, gpu):
+        # Model comm buffer: every local lookup materializes batch * hotness vectors before
+        # the all-to-all; network comm buffer holds this GPU's batch share of every
+        # model-parallel lookup after it. Forward and backward reuse the same buffers.
+        model_buffer = sum(
+            self.batch_size * t.hotness * t.ev_size * self.emb_output_bytes * frac
+            for t, frac in self.shards[gpu]
+        )
+        network_buffer = sum(
+            self.batch_size_per_gpu * t.hotness * t.ev_size * self.emb_output_bytes
+            for shard in self.shards
+            for t, frac in shard
+        )
+        return model_buffer + network_buffer
+
+    # ---- traffic model --------------------------------------------------------------------
+
+    def all2all_bytes_per_gpu(self, gpu):
+        # Forward: this GPU sends every looked-up vector except its own batch share. The
+        # backward all-to-all moves the same volume in the opposite direction.
+        send = sum(
+            self.batch_size * t.hotness * t.ev_size * self.emb_output_bytes * frac
+            for t, frac in self.shards[gpu]
+        )
+        return send * (self.num_gpus - 1) / self.num_gpus * 2
+
+    def allreduce_bytes_per_gpu(self):
+        # Data-parallel wgrads are all-reduced; ring all-reduce moves ~2x the payload.
+        total = 0.0
+        for table in self.dp_tables:
+            rows = min(self.batch_size_per_gpu * table.hotness, table.vocabulary_size)
+            total += rows * table.ev_size * 4
+        return total * 2
+
+    # ---- reporting ------------------------------------------------------------------------
+
+    def shard_matrix(self):
+        matrix = [[0] * len(self.tables) for _ in range(self.num_gpus)]
+        for gpu in range(self.num_gpus):
+            for table, _ in self.shards[gpu]:
+                matrix[gpu][table.index] = 1
+            for table in self.dp_tables:
+                matrix[gpu][table.index] = 1
+        return matrix
+
+    def report(self):
+        mib = 1024**2
+        gib = 1024**3
+        print("Embedding planner")
+        print("  gpus                = {}".format(self.num_gpus))
+        print("  batch_size          = {} ({} per GPU)".format(self.batch_size, self.batch_size_per_gpu))
+        print("  optimizer           = {} (+{} state copies)".format(self.optimizer, self.opt_state_copies))
+        print("  emb output type     = {}".format("fp16" if self.emb_output_bytes == 2 else "fp32"))
+        print("  hbm per gpu         = {:.1f} GiB (embedding budget {:.0f}%)".format(
+            self.hbm_bytes_per_gpu / gib, self.embedding_budget_fraction * 100))
+        print()
+
+        oom = False
+        budget = self.hbm_bytes_per_gpu * self.embedding_budget_fraction
+        print("Per-GPU HBM usage:")
+        print("  {:>4} {:>12} {:>12} {:>12} {:>12} {:>8}".format(
+            "gpu", "tables MiB", "wgrad MiB", "wkspc MiB", "total MiB", "of bdgt"))
+        for gpu in range(self.num_gpus):
+            tables = self.table_bytes(gpu)
+            wgrad = self.wgrad_bytes(gpu)
+            workspace = self.workspace_bytes(gpu)
+            total = tables + wgrad + workspace
+            if total > budget:
+                oom = True
+            print("  {:>4} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.1f} {:>7.1f}%{}".format(
+                gpu, tables / mib, wgrad / mib, workspace / mib, total / mib,
+                total / budget * 100, "  << OVER BUDGET" if total > budget else ""))
+        print()
+
+        print("Per-iteration traffic:")
+        for gpu in range(self.num_gpus):
+            print("  gpu {}: all-to-all {:.1f} MiB (fwd+bwd)".format(
+                gpu, self.all2all_bytes_per_gpu(gpu) / mib))
+        print("  data-parallel wgrad all-reduce: {:.1f} MiB per GPU".format(
+            self.allreduce_bytes_per_gpu() / mib))
+        print()
+
+        print("Recommended placement:")
+        dp_names = [t.name for t in self.dp_tables]
+        if dp_names:
+            print("  data-parallel (replicated): {}".format(", ".join(dp_names)))
+        for gpu in range(self.num_gpus):
+            parts = []
+            for table, frac in self.shards[gpu]:
+                parts.append(table.name if frac >= 1.0 else
+                             "{} (1/{} of rows)".format(table.name, self.num_gpus))
+            print("  gpu {}: {}".format(gpu, ", ".join(parts) if parts else "-"))
+        print()
+        print("shard_matrix = {}".format(json.dumps(self.shard_matrix())))
+
+        if oom:
+            print()
+            print("WARNING: at least one GPU exceeds its embedding memory budget. Expect an OOM")
+            print("at job launch; reduce batch size, shard more tables, or add GPUs.")
+        return not oom
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Static memory and bandwidth planner for embedding collection configs. "
+        "Predicts per-GPU HBM usage and all-to-all volumes, and recommends a shard "
+        "placement, before any GPU is touched.")
+    parser.add_argument("config", help="Path to a JSON planner config (see README.md).")
+    args = parser.parse_args()
+
+    with open(args.config) as f:
+        config = json.load(f)
+
+    plan = Plan(config)
+    ok = plan.report()
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()